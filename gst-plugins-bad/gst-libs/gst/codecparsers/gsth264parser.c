@@ -196,6 +196,9 @@ ceil_log2 (guint32 v)
 
 /****** Nal parser ******/
 
+/* The reader keeps up to 64 bits of the RBSP, with the emulation prevention
+ * bytes removed, in a cache. The next bit to read is the MSB of the cache
+ * and the unused low bits are always zero. */
 typedef struct
 {
   const guint8 *data;
@@ -203,11 +206,27 @@ typedef struct
 
   guint n_epb;                  /* Number of emulation prevention bytes */
   guint byte;                   /* Byte position */
-  guint bits_in_cache;          /* bitpos in the cache of next bit */
-  guint8 first_byte;
-  guint64 cache;                /* cached bytes */
+  guint bits_in_cache;          /* Number of valid bits in the cache */
+  guint zeros;                  /* Consecutive zero bytes before byte */
+  guint64 cache;                /* cached bits, next bit is the MSB */
 } NalReader;
 
+#if defined(__GNUC__) && (__GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 4))
+#define nal_reader_clz64(x) ((guint) __builtin_clzll (x))
+#else
+static inline guint
+nal_reader_clz64 (guint64 x)
+{
+  guint n = 0;
+
+  while (!(x & G_GUINT64_CONSTANT (0x8000000000000000))) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+}
+#endif
+
 static void
 nal_reader_init (NalReader * nr, const guint8 * data, guint size)
 {
@@ -217,54 +236,114 @@ nal_reader_init (NalReader * nr, const guint8 * data, guint size)
 
   nr->byte = 0;
   nr->bits_in_cache = 0;
-  /* fill with something other than 0 to detect emulation prevention bytes */
-  nr->first_byte = 0xff;
-  nr->cache = 0xff;
+  nr->zeros = 0;
+  nr->cache = 0;
 }
 
-static inline gboolean
-nal_reader_read (NalReader * nr, guint nbits)
+/* fill the cache with as many whole bytes as fit */
+static inline void
+nal_reader_refill (NalReader * nr)
 {
-  if (G_UNLIKELY (nr->byte * 8 + (nbits - nr->bits_in_cache) > nr->size * 8)) {
-    GST_DEBUG ("Can not read %u bits, bits in cache %u, Byte * 8 %u, size in "
-        "bits %u", nbits, nr->bits_in_cache, nr->byte * 8, nr->size * 8);
-    return FALSE;
+  guint n;
+
+  n = (64 - nr->bits_in_cache) / 8;
+  if (n == 0)
+    return;
+
+  /* fast path: load 8 bytes at once, if none of the bytes that fit in the
+   * cache is 0x03 there can't be an emulation prevention byte among them */
+  if (G_LIKELY (nr->byte + 8 <= nr->size)) {
+    guint64 word, x, mask;
+
+    word = GST_READ_UINT64_BE (nr->data + nr->byte);
+    mask = n == 8 ? G_MAXUINT64 : ~(G_MAXUINT64 >> (n * 8));
+
+    /* high bit set in every byte of x that was 0x03 in word, with possible
+     * false positives which only make us take the slow path */
+    x = word ^ G_GUINT64_CONSTANT (0x0303030303030303);
+    x = (x - G_GUINT64_CONSTANT (0x0101010101010101)) & ~x &
+        G_GUINT64_CONSTANT (0x8080808080808080);
+
+    if ((x & mask) == 0) {
+      word &= mask;
+      nr->cache |= word >> nr->bits_in_cache;
+      nr->bits_in_cache += n * 8;
+      nr->byte += n;
+
+      /* count the trailing zero bytes of what we loaded */
+      if (word == 0) {
+        nr->zeros += n;
+      } else {
+        guint64 low = word >> ((8 - n) * 8);
+        guint z = 0;
+
+        while ((low & 0xff) == 0) {
+          low >>= 8;
+          z++;
+        }
+        nr->zeros = z;
+      }
+      return;
+    }
   }
 
-  while (nr->bits_in_cache < nbits) {
-    guint8 byte;
-    gboolean check_three_byte;
-
-    check_three_byte = TRUE;
-  next_byte:
-    if (G_UNLIKELY (nr->byte >= nr->size))
-      return FALSE;
-
-    byte = nr->data[nr->byte++];
+  while (nr->bits_in_cache <= 56 && nr->byte < nr->size) {
+    guint8 byte = nr->data[nr->byte++];
 
     /* check if the byte is a emulation_prevention_three_byte */
-    if (check_three_byte && byte == 0x03 && nr->first_byte == 0x00 &&
-        ((nr->cache & 0xff) == 0)) {
-      /* next byte goes unconditionally to the cache, even if it's 0x03 */
-      check_three_byte = FALSE;
+    if (G_UNLIKELY (byte == 0x03 && nr->zeros >= 2)) {
       nr->n_epb++;
-      goto next_byte;
+      nr->zeros = 0;
+      continue;
     }
-    nr->cache = (nr->cache << 8) | nr->first_byte;
-    nr->first_byte = byte;
+    nr->cache |= (guint64) byte << (56 - nr->bits_in_cache);
     nr->bits_in_cache += 8;
+    nr->zeros = byte == 0x00 ? nr->zeros + 1 : 0;
+  }
+}
+
+static inline gboolean
+nal_reader_read (NalReader * nr, guint nbits)
+{
+  if (G_UNLIKELY (nr->bits_in_cache < nbits)) {
+    nal_reader_refill (nr);
+
+    if (G_UNLIKELY (nr->bits_in_cache < nbits)) {
+      GST_DEBUG ("Can not read %u bits, bits in cache %u, Byte * 8 %u, size in "
+          "bits %u", nbits, nr->bits_in_cache, nr->byte * 8, nr->size * 8);
+      return FALSE;
+    }
   }
 
   return TRUE;
 }
 
+/* consume nbits bits from the cache, 0 < nbits <= bits_in_cache and the
+ * value must fit in 32 bits */
+static inline guint32
+nal_reader_consume (NalReader * nr, guint nbits)
+{
+  guint32 val;
+
+  val = (guint32) (nr->cache >> (64 - nbits));
+  nr->cache <<= nbits;
+  nr->bits_in_cache -= nbits;
+
+  return val;
+}
+
 static inline gboolean
 nal_reader_skip (NalReader * nr, guint nbits)
 {
-  if (G_UNLIKELY (!nal_reader_read (nr, nbits)))
-    return FALSE;
+  while (nbits > 0) {
+    guint n = MIN (nbits, 32);
 
-  nr->bits_in_cache -= nbits;
+    if (G_UNLIKELY (!nal_reader_read (nr, n)))
+      return FALSE;
+
+    nal_reader_consume (nr, n);
+    nbits -= n;
+  }
 
   return TRUE;
 }
@@ -272,22 +351,57 @@ nal_reader_skip (NalReader * nr, guint nbits)
 static inline gboolean
 nal_reader_skip_to_byte (NalReader * nr)
 {
-  if (nr->bits_in_cache == 0) {
-    if (G_LIKELY ((nr->size - nr->byte) > 0))
-      nr->byte++;
-    else
-      return FALSE;
-  }
+  guint n = nr->bits_in_cache % 8;
 
-  nr->bits_in_cache = 0;
+  /* the cache always ends on a byte boundary */
+  if (n > 0)
+    nal_reader_consume (nr, n);
 
   return TRUE;
 }
 
+/* get the position in the raw data and the number of emulation prevention
+ * bytes before it. The cache can contain bytes that come after emulation
+ * prevention bytes that are not reached yet, so in that case walk the data
+ * again to find them */
+static guint
+nal_reader_get_raw_pos (const NalReader * nr, guint * n_epb)
+{
+  guint bits, n_bytes, n, byte, zeros, epb;
+
+  /* number of RBSP bits that were read */
+  bits = (nr->byte - nr->n_epb) * 8 - nr->bits_in_cache;
+
+  if (G_LIKELY (nr->n_epb == 0)) {
+    *n_epb = 0;
+    return bits;
+  }
+
+  /* find the end of the last RBSP byte we read from */
+  n_bytes = (bits + 7) / 8;
+  byte = zeros = epb = 0;
+  for (n = n_bytes; n > 0; byte++) {
+    guint8 b = nr->data[byte];
+
+    if (b == 0x03 && zeros >= 2) {
+      epb++;
+      zeros = 0;
+      continue;
+    }
+    zeros = b == 0x00 ? zeros + 1 : 0;
+    n--;
+  }
+
+  *n_epb = epb;
+  return byte * 8 - (n_bytes * 8 - bits);
+}
+
 static inline guint
 nal_reader_get_pos (const NalReader * nr)
 {
-  return nr->byte * 8 - nr->bits_in_cache;
+  guint n_epb;
+
+  return nal_reader_get_raw_pos (nr, &n_epb);
 }
 
 static inline guint
@@ -299,28 +413,26 @@ nal_reader_get_remaining (const NalReader * nr)
 static inline guint
 nal_reader_get_epb_count (const NalReader * nr)
 {
-  return nr->n_epb;
+  guint n_epb;
+
+  nal_reader_get_raw_pos (nr, &n_epb);
+
+  return n_epb;
 }
 
 #define GST_NAL_READER_READ_BITS(bits) \
 static gboolean \
 nal_reader_get_bits_uint##bits (NalReader *nr, guint##bits *val, guint nbits) \
 { \
-  guint shift; \
+  if (G_UNLIKELY (nbits == 0)) { \
+    *val = 0; \
+    return TRUE; \
+  } \
   \
   if (!nal_reader_read (nr, nbits)) \
     return FALSE; \
   \
-  /* bring the required bits down and truncate */ \
-  shift = nr->bits_in_cache - nbits; \
-  *val = nr->first_byte >> shift; \
-  \
-  *val |= nr->cache << (8 - shift); \
-  /* mask out required bits */ \
-  if (nbits < bits) \
-    *val &= ((guint##bits)1 << nbits) - 1; \
-  \
-  nr->bits_in_cache = shift; \
+  *val = nal_reader_consume (nr, nbits); \
   \
   return TRUE; \
 } \
@@ -344,21 +456,33 @@ GST_NAL_READER_PEAK_BITS (8);
 static gboolean
 nal_reader_get_ue (NalReader * nr, guint32 * val)
 {
-  guint i = 0;
-  guint8 bit;
+  guint i;
   guint32 value;
 
-  if (G_UNLIKELY (!nal_reader_get_bits_uint8 (nr, &bit, 1))) {
+  if (nr->bits_in_cache < 32)
+    nal_reader_refill (nr);
 
-    return FALSE;
+  /* fast path: the whole code is in the cache, its 2 * i + 1 leading bits
+   * are 2^i + value */
+  if (G_LIKELY (nr->cache != 0)) {
+    i = nal_reader_clz64 (nr->cache);
+    if (G_LIKELY (2 * i + 1 <= nr->bits_in_cache)) {
+      *val = nal_reader_consume (nr, 2 * i + 1) - 1;
+      return TRUE;
+    }
   }
 
-  while (bit == 0) {
+  /* slow path, the code is longer than the cache or truncated */
+  i = 0;
+  do {
+    guint8 bit;
+
+    if (G_UNLIKELY (!nal_reader_get_bits_uint8 (nr, &bit, 1)))
+      return FALSE;
+    if (bit)
+      break;
     i++;
-    if G_UNLIKELY
-      ((!nal_reader_get_bits_uint8 (nr, &bit, 1)))
-          return FALSE;
-  }
+  } while (TRUE);
 
   if (G_UNLIKELY (i > 32))
     return FALSE;
@@ -366,7 +490,7 @@ nal_reader_get_ue (NalReader * nr, guint32 * val)
   if (G_UNLIKELY (!nal_reader_get_bits_uint32 (nr, &value, i)))
     return FALSE;
 
-  *val = (1 << i) - 1 + value;
+  *val = (guint32) (((guint64) 1 << i) - 1 + value);
 
   return TRUE;
 }
@@ -374,15 +498,14 @@ nal_reader_get_ue (NalReader * nr, guint32 * val)
 static inline gboolean
 nal_reader_get_se (NalReader * nr, gint32 * val)
 {
-  guint32 value;
+  guint32 value, sign;
 
   if (G_UNLIKELY (!nal_reader_get_ue (nr, &value)))
     return FALSE;
 
-  if (value % 2)
-    *val = (value / 2) + 1;
-  else
-    *val = -(value / 2);
+  /* odd values are positive, even values negative */
+  sign = (value & 1) - 1;
+  *val = (gint32) ((((value >> 1) + (value & 1)) ^ sign) - sign);
 
   return TRUE;
 }
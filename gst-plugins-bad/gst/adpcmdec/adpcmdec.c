@@ -325,53 +325,28 @@ adpcmdec_decode_ima_block (ADPCMDec * dec, int n_samples, const guint8 * data,
   return TRUE;
 }
 
-static GstBuffer *
-adpcmdec_decode_block (ADPCMDec * dec, const guint8 * data, int blocksize)
+/* Returns the number of 16 bit samples in a block of 'blocksize' bytes, or 0
+   if the block is too small */
+static int
+adpcmdec_block_samples (ADPCMDec * dec, int blocksize)
 {
-  gboolean res = FALSE;
-  GstBuffer *outbuf = NULL;
-  int outsize;
-  int samples;
-  GstMapInfo omap;
-
   if (dec->layout == LAYOUT_ADPCM_MICROSOFT) {
     /* Each block has a 3 byte header per channel, plus 4 bytes per channel to
        give two initial sample values per channel. Then the remainder gives
        two samples per byte */
     if (blocksize < 7 * dec->channels)
-      goto exit;
-    samples = (blocksize - 7 * dec->channels) * 2 + 2 * dec->channels;
-    outsize = 2 * samples;
-    outbuf = gst_buffer_new_and_alloc (outsize);
-
-    gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
-    res = adpcmdec_decode_ms_block (dec, samples, data, (gint16 *) omap.data);
-    gst_buffer_unmap (outbuf, &omap);
+      return 0;
+    return (blocksize - 7 * dec->channels) * 2 + 2 * dec->channels;
   } else if (dec->layout == LAYOUT_ADPCM_DVI) {
     /* Each block has a 4 byte header per channel, include an initial sample.
        Then the remainder gives two samples per byte */
     if (blocksize < 4 * dec->channels)
-      goto exit;
-    samples = (blocksize - 4 * dec->channels) * 2 + dec->channels;
-    outsize = 2 * samples;
-    outbuf = gst_buffer_new_and_alloc (outsize);
-
-    gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
-    res = adpcmdec_decode_ima_block (dec, samples, data, (gint16 *) omap.data);
-    gst_buffer_unmap (outbuf, &omap);
+      return 0;
+    return (blocksize - 4 * dec->channels) * 2 + dec->channels;
   } else {
     GST_WARNING_OBJECT (dec, "Unknown layout");
+    return 0;
   }
-
-  if (!res) {
-    if (outbuf)
-      gst_buffer_unref (outbuf);
-    outbuf = NULL;
-    GST_WARNING_OBJECT (dec, "Decode of block failed");
-  }
-
-exit:
-  return outbuf;
 }
 
 static GstFlowReturn
@@ -405,8 +380,8 @@ adpcmdec_handle_frame (GstAudioDecoder * bdec, GstBuffer * buffer)
 {
   ADPCMDec *dec = (ADPCMDec *) (bdec);
   GstFlowReturn ret = GST_FLOW_OK;
-  GstMapInfo map;
-  GstBuffer *outbuf = NULL;
+  GstBuffer *outbuf;
+  int samples;
 
   /* no fancy draining */
   if (G_UNLIKELY (!buffer))
@@ -415,19 +390,50 @@ adpcmdec_handle_frame (GstAudioDecoder * bdec, GstBuffer * buffer)
   if (!dec->blocksize)
     return GST_FLOW_NOT_NEGOTIATED;
 
-  gst_buffer_map (buffer, &map, GST_MAP_READ);
-  outbuf = adpcmdec_decode_block (dec, map.data, dec->blocksize);
-  gst_buffer_unmap (buffer, &map);
-
-  if (outbuf == NULL) {
+  samples = adpcmdec_block_samples (dec, gst_buffer_get_size (buffer));
+  if (samples == 0) {
     GST_AUDIO_DECODER_ERROR (bdec, 1, STREAM, DECODE, (NULL),
         ("frame decode failed"), ret);
+    if (ret == GST_FLOW_OK)
+      ret = gst_audio_decoder_finish_frame (bdec, NULL, 1);
+    return ret;
   }
 
-  if (ret == GST_FLOW_OK)
-    ret = gst_audio_decoder_finish_frame (bdec, outbuf, 1);
+  /* the blocks are decoded independently, possibly on other threads */
+  outbuf = gst_audio_decoder_allocate_output_buffer (bdec, 2 * samples);
+
+  return gst_audio_decoder_submit_frame (bdec, buffer, outbuf);
+}
+
+static GstFlowReturn
+adpcmdec_decode_frame (GstAudioDecoder * bdec, GstBuffer * buffer,
+    GstBuffer * outbuf)
+{
+  ADPCMDec *dec = (ADPCMDec *) (bdec);
+  gboolean res = FALSE;
+  GstMapInfo map, omap;
+  int samples;
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
+
+  samples = omap.size / 2;
+  if (dec->layout == LAYOUT_ADPCM_MICROSOFT)
+    res = adpcmdec_decode_ms_block (dec, samples, map.data,
+        (gint16 *) omap.data);
+  else if (dec->layout == LAYOUT_ADPCM_DVI)
+    res = adpcmdec_decode_ima_block (dec, samples, map.data,
+        (gint16 *) omap.data);
 
-  return ret;
+  gst_buffer_unmap (outbuf, &omap);
+  gst_buffer_unmap (buffer, &map);
+
+  if (!res) {
+    GST_WARNING_OBJECT (dec, "Decode of block failed");
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
 }
 
 static gboolean
@@ -477,6 +483,7 @@ adpcmdec_class_init (ADPCMDecClass * klass)
   base_class->set_format = GST_DEBUG_FUNCPTR (adpcmdec_set_format);
   base_class->parse = GST_DEBUG_FUNCPTR (adpcmdec_parse);
   base_class->handle_frame = GST_DEBUG_FUNCPTR (adpcmdec_handle_frame);
+  base_class->decode_frame = GST_DEBUG_FUNCPTR (adpcmdec_decode_frame);
 }
 
 static gboolean
@@ -150,6 +150,68 @@ GST_START_TEST (test_h264_parse_slice_dpa)
 
 GST_END_TEST;
 
+/* baseline SPS/PPS with 16 bit frame_num and pic_order_cnt_lsb, followed by
+ * an IDR slice with an emulation prevention byte in the header and another
+ * one right after it in the slice data */
+static guint8 stream_idr[] = {
+  0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1e, 0x8d, 0x8d, 0x40, 0xa0,
+  0xfc, 0x80,
+  0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x3c, 0x80,
+  0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x80, 0x00, 0x01, 0x00, 0x00, 0x03,
+  0x00, 0xa0, 0x00, 0x00, 0x03, 0x01, 0xff,
+  0x00, 0x00, 0x01, 0x0b
+};
+
+GST_START_TEST (test_h264_parse_slice_hdr)
+{
+  GstH264ParserResult res;
+  GstH264NalUnit nalu;
+  GstH264SPS sps;
+  GstH264PPS pps;
+  GstH264SliceHdr slice;
+  GstH264NalParser *parser = gst_h264_nal_parser_new ();
+
+  res = gst_h264_parser_identify_nalu (parser, stream_idr, 0,
+      sizeof (stream_idr), &nalu);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (nalu.type, GST_H264_NAL_SPS);
+  res = gst_h264_parser_parse_sps (parser, &nalu, &sps, TRUE);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (sps.log2_max_frame_num_minus4, 12);
+  assert_equals_int (sps.log2_max_pic_order_cnt_lsb_minus4, 12);
+  assert_equals_int (sps.width, 320);
+  assert_equals_int (sps.height, 240);
+
+  res = gst_h264_parser_identify_nalu (parser, stream_idr,
+      nalu.offset + nalu.size, sizeof (stream_idr), &nalu);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (nalu.type, GST_H264_NAL_PPS);
+  res = gst_h264_parser_parse_pps (parser, &nalu, &pps);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (pps.deblocking_filter_control_present_flag, 1);
+
+  res = gst_h264_parser_identify_nalu (parser, stream_idr,
+      nalu.offset + nalu.size, sizeof (stream_idr), &nalu);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (nalu.type, GST_H264_NAL_SLICE_IDR);
+  res = gst_h264_parser_parse_slice_hdr (parser, &nalu, &slice, TRUE, TRUE);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (slice.first_mb_in_slice, 0);
+  assert_equals_int (slice.type, 7);
+  assert_equals_int (slice.frame_num, 0);
+  assert_equals_int (slice.idr_pic_id, 63);
+  assert_equals_int (slice.pic_order_cnt_lsb, 0);
+  assert_equals_int (slice.slice_qp_delta, 0);
+  assert_equals_int (slice.disable_deblocking_filter_idc, 1);
+  /* 60 bits of header plus the emulation prevention byte */
+  assert_equals_int (slice.header_size, 68);
+  assert_equals_int (slice.n_emulation_prevention_bytes, 1);
+
+  gst_h264_nal_parser_free (parser);
+}
+
+GST_END_TEST;
+
 static Suite *
 h264parser_suite (void)
 {
@@ -159,6 +221,7 @@ h264parser_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_h264_parse_slice_dpa);
+  tcase_add_test (tc_chain, test_h264_parse_slice_hdr);
 
   return s;
 }
@@ -0,0 +1,233 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures how many slice headers per second gst_h264_parser_parse_slice_hdr()
+ * can parse. Without arguments a synthetic byte-stream is used, otherwise
+ * the given H.264 byte-stream files are parsed.
+ *
+ * usage: h264-slice-bench [byte-stream files...]
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <gst/gst.h>
+#include <gst/codecparsers/gsth264parser.h>
+
+#define N_SLICES 20000
+#define N_RUNS 10
+
+/* baseline SPS and PPS for 320x240 with 16 bit frame_num and
+ * pic_order_cnt_lsb */
+static const guint8 sps_pps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x1e, 0x8d, 0x8d, 0x40, 0xa0,
+  0xfc, 0x80,
+  0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x3c, 0x80
+};
+
+typedef struct
+{
+  GByteArray *rbsp;
+  guint8 acc;
+  guint n_bits;
+} BitWriter;
+
+static void
+put_bits (BitWriter * bw, guint32 val, guint nbits)
+{
+  while (nbits > 0) {
+    nbits--;
+    bw->acc = (bw->acc << 1) | ((val >> nbits) & 1);
+    if (++bw->n_bits == 8) {
+      g_byte_array_append (bw->rbsp, &bw->acc, 1);
+      bw->acc = 0;
+      bw->n_bits = 0;
+    }
+  }
+}
+
+static void
+put_ue (BitWriter * bw, guint32 val)
+{
+  guint n = g_bit_storage (val + 1);
+
+  put_bits (bw, 0, n - 1);
+  put_bits (bw, val + 1, n);
+}
+
+static void
+put_se (BitWriter * bw, gint32 val)
+{
+  put_ue (bw, val > 0 ? 2 * val - 1 : -2 * val);
+}
+
+/* append the RBSP as NAL unit, inserting emulation prevention bytes */
+static void
+append_nal (GByteArray * out, guint8 header, GByteArray * rbsp)
+{
+  static const guint8 start_code[] = { 0x00, 0x00, 0x00, 0x01 };
+  static const guint8 epb = 0x03;
+  guint i, zeros = 0;
+
+  g_byte_array_append (out, start_code, sizeof (start_code));
+  g_byte_array_append (out, &header, 1);
+  for (i = 0; i < rbsp->len; i++) {
+    if (zeros >= 2 && rbsp->data[i] <= 0x03) {
+      g_byte_array_append (out, &epb, 1);
+      zeros = 0;
+    }
+    g_byte_array_append (out, &rbsp->data[i], 1);
+    zeros = rbsp->data[i] == 0x00 ? zeros + 1 : 0;
+  }
+}
+
+/* IDR I slices with random header values followed by a bit of slice data
+ * that is biased towards zero */
+static GByteArray *
+make_stream (guint n_slices)
+{
+  GByteArray *out;
+  BitWriter bw;
+  guint i, j;
+
+  out = g_byte_array_new ();
+  g_byte_array_append (out, sps_pps, sizeof (sps_pps));
+
+  bw.rbsp = g_byte_array_new ();
+  for (i = 0; i < n_slices; i++) {
+    g_byte_array_set_size (bw.rbsp, 0);
+    bw.acc = 0;
+    bw.n_bits = 0;
+
+    put_ue (&bw, g_random_int_range (0, 300));  /* first_mb_in_slice */
+    put_ue (&bw, 7);            /* slice_type */
+    put_ue (&bw, 0);            /* pic_parameter_set_id */
+    put_bits (&bw, g_random_int_range (0, 4), 16);      /* frame_num */
+    put_ue (&bw, g_random_int_range (0, 65536));        /* idr_pic_id */
+    put_bits (&bw, g_random_int_range (0, 4), 16);      /* pic_order_cnt_lsb */
+    put_bits (&bw, 0, 2);       /* dec_ref_pic_marking */
+    put_se (&bw, g_random_int_range (-26, 26)); /* slice_qp_delta */
+    put_ue (&bw, g_random_int_range (0, 3));    /* disable_deblocking_... */
+    put_se (&bw, g_random_int_range (-6, 7));   /* slice_alpha_c0_offset */
+    put_se (&bw, g_random_int_range (-6, 7));   /* slice_beta_offset */
+
+    for (j = 0; j < 64; j++)
+      put_bits (&bw, g_random_int_range (0, 4) ? 0 :
+          g_random_int_range (0, 256), 8);
+    /* rbsp_trailing_bits */
+    put_bits (&bw, 1, 1);
+    if (bw.n_bits > 0)
+      put_bits (&bw, 0, 8 - bw.n_bits);
+
+    append_nal (out, 0x65, bw.rbsp);
+  }
+  g_byte_array_free (bw.rbsp, TRUE);
+
+  return out;
+}
+
+static guint
+parse_stream (const guint8 * data, gsize size)
+{
+  GstH264NalParser *parser;
+  GstH264NalUnit nalu;
+  GstH264ParserResult res;
+  GstH264SliceHdr slice;
+  GstH264SPS sps;
+  GstH264PPS pps;
+  guint offset = 0, n_slices = 0;
+
+  parser = gst_h264_nal_parser_new ();
+  while (TRUE) {
+    res = gst_h264_parser_identify_nalu (parser, data, offset, size, &nalu);
+    /* the last NAL unit of the stream has no end */
+    if (res != GST_H264_PARSER_OK && res != GST_H264_PARSER_NO_NAL_END)
+      break;
+
+    switch (nalu.type) {
+      case GST_H264_NAL_SPS:
+        gst_h264_parser_parse_sps (parser, &nalu, &sps, TRUE);
+        break;
+      case GST_H264_NAL_PPS:
+        gst_h264_parser_parse_pps (parser, &nalu, &pps);
+        break;
+      case GST_H264_NAL_SLICE:
+      case GST_H264_NAL_SLICE_IDR:
+        if (gst_h264_parser_parse_slice_hdr (parser, &nalu, &slice, TRUE,
+                TRUE) == GST_H264_PARSER_OK)
+          n_slices++;
+        break;
+      default:
+        break;
+    }
+
+    if (res == GST_H264_PARSER_NO_NAL_END)
+      break;
+    offset = nalu.offset + nalu.size;
+  }
+  gst_h264_nal_parser_free (parser);
+
+  return n_slices;
+}
+
+static void
+run_benchmark (const gchar * name, const guint8 * data, gsize size)
+{
+  GstClockTime start, elapsed;
+  guint i, n_slices = 0;
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < N_RUNS; i++)
+    n_slices = parse_stream (data, size);
+  elapsed = (gst_util_get_timestamp () - start) / N_RUNS;
+
+  g_print ("%-16s %8" G_GSIZE_FORMAT " kB, %6u slices in %" GST_TIME_FORMAT
+      ": %.0f slices/s\n", name, size / 1024, n_slices, GST_TIME_ARGS (elapsed),
+      (gdouble) n_slices * GST_SECOND / MAX (elapsed, 1));
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  GByteArray *stream;
+  gint i;
+
+  gst_init (&argc, &argv);
+
+  if (argc < 2) {
+    stream = make_stream (N_SLICES);
+    run_benchmark ("synthetic", stream->data, stream->len);
+    g_byte_array_free (stream, TRUE);
+  }
+
+  for (i = 1; i < argc; i++) {
+    gchar *contents;
+    gsize size;
+    GError *err = NULL;
+
+    if (!g_file_get_contents (argv[i], &contents, &size, &err)) {
+      g_print ("could not read %s: %s\n", argv[i], err->message);
+      g_clear_error (&err);
+      continue;
+    }
+    run_benchmark (argv[i], (const guint8 *) contents, size);
+    g_free (contents);
+  }
+
+  return 0;
+}
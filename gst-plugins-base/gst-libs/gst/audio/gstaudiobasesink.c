@@ -71,6 +71,14 @@ struct _GstAudioBaseSinkPrivate
 
   /* number of nanoseconds to wait until creating a discontinuity */
   GstClockTime discont_wait;
+
+  /* output of the interpolating slave method */
+  guint8 *interp_data;
+  gsize interp_size;
+  /* last frame of the previous buffer, we interpolate from it to the first
+   * frame of the next buffer */
+  guint8 *interp_last;
+  gboolean interp_have_last;
 };
 
 /* BaseAudioSink signals and args */
@@ -126,6 +134,8 @@ gst_audio_base_sink_slave_method_get_type (void)
         "resample"},
     {GST_AUDIO_BASE_SINK_SLAVE_SKEW, "GST_AUDIO_BASE_SINK_SLAVE_SKEW", "skew"},
     {GST_AUDIO_BASE_SINK_SLAVE_NONE, "GST_AUDIO_BASE_SINK_SLAVE_NONE", "none"},
+    {GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE,
+        "GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE", "interpolate"},
     {0, NULL, NULL},
   };
 
@@ -343,6 +353,12 @@ gst_audio_base_sink_dispose (GObject * object)
     sink->ringbuffer = NULL;
   }
 
+  g_free (sink->priv->interp_data);
+  sink->priv->interp_data = NULL;
+  sink->priv->interp_size = 0;
+  g_free (sink->priv->interp_last);
+  sink->priv->interp_last = NULL;
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -1353,6 +1369,7 @@ gst_audio_base_sink_handle_slaving (GstAudioBaseSink * sink,
 {
   switch (sink->priv->slave_method) {
     case GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE:
+    case GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE:
       gst_audio_base_sink_resample_slaving (sink, render_start, render_stop,
           srender_start, srender_stop);
       break;
@@ -1470,6 +1487,7 @@ gst_audio_base_sink_sync_latency (GstBaseSink * bsink, GstMiniObject * obj)
 
   switch (sink->priv->slave_method) {
     case GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE:
+    case GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE:
       /* only set as master when we are resampling */
       GST_DEBUG_OBJECT (sink, "Setting clock as master");
       gst_clock_set_master (sink->provided_clock, clock);
@@ -1584,6 +1602,113 @@ gst_audio_base_sink_get_alignment (GstAudioBaseSink * sink,
   return align;
 }
 
+/* Output frame i is placed at input position (i + 1) * in / out - 1, so that
+ * the last output frame is the last input frame and the first ones lie
+ * between the last frame of the previous buffer (position -1) and the first
+ * input frame. Without a previous frame the first input frame is used. */
+#define INTERPOLATE_LINEAR(type,round)                                    \
+G_STMT_START {                                                            \
+  const type *s = (const type *) src;                                     \
+  const type *l = (const type *) last;                                    \
+  type *d = (type *) dest;                                                \
+  gint i, c;                                                              \
+                                                                          \
+  for (i = 0; i < out_samples; i++) {                                     \
+    gint64 num = (gint64) (i + 1) * in_samples - out_samples;             \
+    gint64 idx = (num < 0) ? -1 : num / out_samples;                      \
+    gint64 rem = num - idx * out_samples;                                 \
+    const type *a = (idx < 0) ? l : s + idx * channels;                   \
+    const type *b = s + (idx + 1) * channels;                             \
+                                                                          \
+    if (rem == 0) {                                                       \
+      for (c = 0; c < channels; c++)                                      \
+        d[c] = a[c];                                                      \
+    } else {                                                              \
+      gdouble frac = (gdouble) rem / out_samples;                         \
+                                                                          \
+      for (c = 0; c < channels; c++)                                      \
+        d[c] = round (a[c] + (b[c] - (gdouble) a[c]) * frac);             \
+    }                                                                     \
+    d += channels;                                                        \
+  }                                                                       \
+} G_STMT_END
+
+#define INTERPOLATE_ROUND_INT(v) ((v) < 0 ? (v) - 0.5 : (v) + 0.5)
+#define INTERPOLATE_ROUND_FLOAT(v) (v)
+
+/* linearly interpolates @in_samples frames from @src to @out_samples frames.
+ * Returns the interpolated data, @src when the number of frames is the same,
+ * or NULL when the format can't be interpolated. */
+static guint8 *
+gst_audio_base_sink_interpolate (GstAudioBaseSink * sink, const guint8 * src,
+    gint in_samples, gint out_samples, gboolean resync)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  GstAudioInfo *info = &sink->ringbuffer->spec.info;
+  gint bpf = GST_AUDIO_INFO_BPF (info);
+  gint channels = GST_AUDIO_INFO_CHANNELS (info);
+  const guint8 *last;
+  guint8 *dest;
+  gsize size;
+
+  switch (GST_AUDIO_INFO_FORMAT (info)) {
+    case GST_AUDIO_FORMAT_S16:
+    case GST_AUDIO_FORMAT_S32:
+    case GST_AUDIO_FORMAT_F32:
+    case GST_AUDIO_FORMAT_F64:
+      break;
+    default:
+      return NULL;
+  }
+
+  if (in_samples == out_samples) {
+    /* nothing to convert, only remember the last frame so that the next
+     * buffer continues from it */
+    priv->interp_last = g_realloc (priv->interp_last, bpf);
+    memcpy (priv->interp_last, src + (gsize) (in_samples - 1) * bpf, bpf);
+    priv->interp_have_last = TRUE;
+
+    return (guint8 *) src;
+  }
+
+  size = (gsize) out_samples * bpf;
+  if (priv->interp_size < size) {
+    priv->interp_data = g_realloc (priv->interp_data, size);
+    priv->interp_size = size;
+  }
+  dest = priv->interp_data;
+
+  if (resync || !priv->interp_have_last) {
+    priv->interp_last = g_realloc (priv->interp_last, bpf);
+    last = src;
+  } else {
+    last = priv->interp_last;
+  }
+
+  switch (GST_AUDIO_INFO_FORMAT (info)) {
+    case GST_AUDIO_FORMAT_S16:
+      INTERPOLATE_LINEAR (gint16, INTERPOLATE_ROUND_INT);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      INTERPOLATE_LINEAR (gint32, INTERPOLATE_ROUND_INT);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      INTERPOLATE_LINEAR (gfloat, INTERPOLATE_ROUND_FLOAT);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      INTERPOLATE_LINEAR (gdouble, INTERPOLATE_ROUND_FLOAT);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+
+  memcpy (priv->interp_last, src + (gsize) (in_samples - 1) * bpf, bpf);
+  priv->interp_have_last = TRUE;
+
+  return dest;
+}
+
 static GstFlowReturn
 gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
@@ -1609,6 +1734,7 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   GstSegment clip_seg;
   gint64 time_offset;
   GstBuffer *out = NULL;
+  guint8 *data, *interp = NULL;
 
   sink = GST_AUDIO_BASE_SINK (bsink);
   bclass = GST_AUDIO_BASE_SINK_GET_CLASS (sink);
@@ -1665,6 +1791,7 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
       GST_TIME_ARGS (bsink->segment.start), samples);
 
   offset = 0;
+  slaved = FALSE;
 
   /* if not valid timestamp or we can't clip or sync, try to play
    * sample ASAP */
@@ -1866,7 +1993,9 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 
   /* only align stop if we are not slaved to resample */
   if (G_UNLIKELY (slaved
-          && sink->priv->slave_method == GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE)) {
+          && (sink->priv->slave_method == GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE
+              || sink->priv->slave_method ==
+              GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE))) {
     GST_DEBUG_OBJECT (sink, "no stop time align needed: we are slaved");
     goto no_align;
   }
@@ -1889,10 +2018,32 @@ no_align:
   accum = 0;
   align_next = TRUE;
   gst_buffer_map (buf, &info, GST_MAP_READ);
+  data = info.data;
+
+  /* when resampling with interpolation, convert the samples here so that the
+   * ringbuffer only has to copy them. Buffers that need no conversion still
+   * go through here to keep their last frame for the next one. */
+  if (G_UNLIKELY (sink->priv->slave_method ==
+          GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE && slaved && samples > 0
+          && out_samples > 0)) {
+    interp = gst_audio_base_sink_interpolate (sink, data + offset, samples,
+        out_samples, GST_BUFFER_FLAG_IS_SET (buf, GST_BUFFER_FLAG_DISCONT)
+        || sink->next_sample == -1);
+    if (interp) {
+      GST_DEBUG_OBJECT (sink, "interpolated %u to %d samples", samples,
+          out_samples);
+      data = interp;
+      offset = 0;
+      samples = out_samples;
+    }
+  }
+  if (!interp)
+    sink->priv->interp_have_last = FALSE;
+
   do {
     written =
         gst_audio_ring_buffer_commit (ringbuf, &sample_offset,
-        info.data + offset, samples, out_samples, &accum);
+        data + offset, samples, out_samples, &accum);
 
     GST_DEBUG_OBJECT (sink, "wrote %u of %u", written, samples);
     /* if we wrote all, we're done */
@@ -84,6 +84,11 @@ G_BEGIN_DECLS
  * @GST_AUDIO_BASE_SINK_SLAVE_SKEW: Adjust playout pointer when master clock
  * drifts too much.
  * @GST_AUDIO_BASE_SINK_SLAVE_NONE: No adjustment is done.
+ * @GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE: Resample to match the master clock
+ * using linear interpolation between samples instead of dropping or
+ * duplicating them. Only native endian S16, S32, F32 and F64 samples are
+ * interpolated, other formats are handled like
+ * @GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE. Since: 1.2
  *
  * Different possible clock slaving algorithms used when the internal audio
  * clock is not selected as the pipeline master clock.
@@ -92,7 +97,8 @@ typedef enum
 {
   GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE,
   GST_AUDIO_BASE_SINK_SLAVE_SKEW,
-  GST_AUDIO_BASE_SINK_SLAVE_NONE
+  GST_AUDIO_BASE_SINK_SLAVE_NONE,
+  GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE
 } GstAudioBaseSinkSlaveMethod;
 
 #define GST_TYPE_AUDIO_BASE_SINK_SLAVE_METHOD (gst_audio_base_sink_slave_method_get_type ())
@@ -74,6 +74,14 @@
  *       downstream.
  *     </para></listitem>
  *     <listitem><para>
+ *       Decoders of frames that do not depend on other frames, like PCM
+ *       companding or block based ADPCM codecs, can instead allocate the
+ *       output buffer in @handle_frame and pass both to
+ *       @gst_audio_decoder_submit_frame.  The base class then calls
+ *       @decode_frame on up to #GstAudioDecoder:n-threads threads at the
+ *       same time and finishes the frames in the order they were submitted.
+ *     </para></listitem>
+ *     <listitem><para>
  *       Just prior to actually pushing a buffer downstream,
  *       it is passed to @pre_push.  Subclass should either use this callback
  *       to arrange for additional downstream pushing or otherwise ensure such
@@ -150,6 +158,7 @@
 
 #include "gstaudiodecoder.h"
 #include <gst/pbutils/descriptions.h>
+#include "gst/gstframejobs-private.h"
 
 #include <string.h>
 
@@ -170,12 +179,14 @@ enum
   PROP_0,
   PROP_LATENCY,
   PROP_TOLERANCE,
-  PROP_PLC
+  PROP_PLC,
+  PROP_N_THREADS
 };
 
 #define DEFAULT_LATENCY    0
 #define DEFAULT_TOLERANCE  0
 #define DEFAULT_PLC        FALSE
+#define DEFAULT_N_THREADS  1
 #define DEFAULT_DRAINABLE  TRUE
 #define DEFAULT_NEEDS_FORMAT  FALSE
 
@@ -274,8 +285,24 @@ struct _GstAudioDecoderPrivate
 
   /* pending serialized sink events, will be sent from finish_frame() */
   GList *pending_events;
+
+  /* frame threading */
+  guint n_threads;              /* OBJECT_LOCK */
+  GstFrameJobs decode_jobs;     /* STREAM_LOCK */
+  guint decode_pool_threads;    /* OBJECT_LOCK and STREAM_LOCK */
+  /* longest decoded frame, for the latency of decoding on the pool */
+  GstClockTime decode_frame_duration;   /* OBJECT_LOCK */
 };
 
+/* a frame that was passed to gst_audio_decoder_submit_frame() */
+typedef struct
+{
+  GstFrameJob job;
+
+  GstBuffer *buffer;
+  GstBuffer *outbuf;
+} DecodeJob;
+
 
 static void gst_audio_decoder_finalize (GObject * object);
 static void gst_audio_decoder_set_property (GObject * object,
@@ -312,6 +339,13 @@ static gboolean gst_audio_decoder_decide_allocation_default (GstAudioDecoder *
 static gboolean gst_audio_decoder_propose_allocation_default (GstAudioDecoder *
     dec, GstQuery * query);
 static gboolean gst_audio_decoder_negotiate_default (GstAudioDecoder * dec);
+static GstFlowReturn gst_audio_decoder_finish_frame_internal (GstAudioDecoder *
+    dec, GstBuffer * buf, gint frames);
+static GstFlowReturn gst_audio_decoder_decode_job (GstFrameJob * job,
+    gpointer user_data);
+static GstFlowReturn gst_audio_decoder_finish_job (GstFrameJob * job,
+    gpointer user_data);
+static void gst_audio_decoder_free_job (GstFrameJob * job, gpointer user_data);
 
 static GstElementClass *parent_class = NULL;
 
@@ -389,6 +423,21 @@ gst_audio_decoder_class_init (GstAudioDecoderClass * klass)
           "Perform packet loss concealment (if supported)",
           DEFAULT_PLC, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioDecoder:n-threads:
+   *
+   * The maximum number of frames that are decoded at the same time, 0 uses
+   * one thread per CPU. This only has an effect on decoders that implement
+   * the decode_frame method. Decoding on N threads adds up to N - 1 frames
+   * of latency.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   audiodecoder_class->sink_event =
       GST_DEBUG_FUNCPTR (gst_audio_decoder_sink_eventfunc);
   audiodecoder_class->src_event =
@@ -452,6 +501,10 @@ gst_audio_decoder_init (GstAudioDecoder * dec, GstAudioDecoderClass * klass)
   dec->priv->drainable = DEFAULT_DRAINABLE;
   dec->priv->needs_format = DEFAULT_NEEDS_FORMAT;
 
+  dec->priv->n_threads = DEFAULT_N_THREADS;
+  gst_frame_jobs_init (&dec->priv->decode_jobs, gst_audio_decoder_decode_job,
+      gst_audio_decoder_finish_job, gst_audio_decoder_free_job, dec);
+
   /* init state */
   gst_audio_decoder_reset (dec, TRUE);
   GST_DEBUG_OBJECT (dec, "init ok");
@@ -494,6 +547,10 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
     dec->priv->ctx.allocator = NULL;
 
     gst_caps_replace (&dec->priv->ctx.input_caps, NULL);
+
+    GST_OBJECT_LOCK (dec);
+    dec->priv->decode_frame_duration = GST_CLOCK_TIME_NONE;
+    GST_OBJECT_UNLOCK (dec);
   }
 
   g_queue_foreach (&dec->priv->frames, (GFunc) gst_buffer_unref, NULL);
@@ -530,6 +587,8 @@ gst_audio_decoder_finalize (GObject * object)
 
   g_rec_mutex_clear (&dec->stream_lock);
 
+  gst_frame_jobs_clear (&dec->priv->decode_jobs);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -699,6 +758,10 @@ gst_audio_decoder_set_output_format (GstAudioDecoder * dec,
 
   GST_AUDIO_DECODER_STREAM_LOCK (dec);
 
+  /* frames that are still being decoded belong to the old format, a failure
+   * to push them is returned from the next finish_frame() */
+  gst_frame_jobs_finish_deferred (&dec->priv->decode_jobs);
+
   /* If the audio info can't be converted to caps,
    * it was invalid */
   caps = gst_audio_info_to_caps (info);
@@ -773,6 +836,10 @@ gst_audio_decoder_sink_setcaps (GstAudioDecoder * dec, GstCaps * caps)
   dec->priv->taglist_changed = TRUE;
 #endif
 
+  /* the subclass state is shared with the frames that are still being
+   * decoded, a failure to push them is returned from the next frame */
+  gst_frame_jobs_finish_deferred (&dec->priv->decode_jobs);
+
   if (klass->set_format)
     res = klass->set_format (dec, caps);
 
@@ -1000,6 +1067,26 @@ send_pending_events (GstAudioDecoder * dec)
 GstFlowReturn
 gst_audio_decoder_finish_frame (GstAudioDecoder * dec, GstBuffer * buf,
     gint frames)
+{
+  GstFlowReturn ret;
+
+  g_return_val_if_fail (GST_IS_AUDIO_DECODER (dec), GST_FLOW_ERROR);
+
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+  /* submitted frames precede this one */
+  ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
+  if (ret == GST_FLOW_OK)
+    ret = gst_audio_decoder_finish_frame_internal (dec, buf, frames);
+  else if (buf)
+    gst_buffer_unref (buf);
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
+  return ret;
+}
+
+static GstFlowReturn
+gst_audio_decoder_finish_frame_internal (GstAudioDecoder * dec,
+    GstBuffer * buf, gint frames)
 {
   GstAudioDecoderPrivate *priv;
   GstAudioDecoderContext *ctx;
@@ -1176,6 +1263,183 @@ overflow:
   }
 }
 
+static GstFlowReturn
+gst_audio_decoder_decode_job (GstFrameJob * job, gpointer user_data)
+{
+  GstAudioDecoder *dec = user_data;
+  GstAudioDecoderClass *klass = GST_AUDIO_DECODER_GET_CLASS (dec);
+  DecodeJob *djob = (DecodeJob *) job;
+
+  return klass->decode_frame (dec, djob->buffer, djob->outbuf);
+}
+
+static void
+gst_audio_decoder_free_job (GstFrameJob * job, gpointer user_data)
+{
+  DecodeJob *djob = (DecodeJob *) job;
+
+  GST_LOG_OBJECT (user_data, "discarding frame %p", djob->buffer);
+
+  gst_buffer_unref (djob->buffer);
+  if (djob->outbuf)
+    gst_buffer_unref (djob->outbuf);
+  g_slice_free (DecodeJob, djob);
+}
+
+/* With stream lock, frees @job */
+static GstFlowReturn
+gst_audio_decoder_finish_job (GstFrameJob * job, gpointer user_data)
+{
+  GstAudioDecoder *dec = user_data;
+  GstAudioDecoderPrivate *priv = dec->priv;
+  DecodeJob *djob = (DecodeJob *) job;
+  GstFlowReturn ret = job->ret;
+  GstBuffer *outbuf;
+
+  outbuf = djob->outbuf;
+  djob->outbuf = NULL;
+
+  if (ret == GST_FLOW_OK) {
+    GstClockTime duration = GST_CLOCK_TIME_NONE;
+    gboolean post_latency = FALSE;
+
+    if (priv->ctx.info.bpf && priv->ctx.info.rate)
+      duration = GST_FRAMES_TO_CLOCK_TIME (gst_buffer_get_size (outbuf) /
+          priv->ctx.info.bpf, priv->ctx.info.rate);
+
+    /* the latency depends on the longest frame */
+    GST_OBJECT_LOCK (dec);
+    if (GST_CLOCK_TIME_IS_VALID (duration) &&
+        (!GST_CLOCK_TIME_IS_VALID (priv->decode_frame_duration) ||
+            duration > priv->decode_frame_duration)) {
+      priv->decode_frame_duration = duration;
+      post_latency = priv->decode_pool_threads > 1;
+    }
+    GST_OBJECT_UNLOCK (dec);
+
+    if (post_latency)
+      gst_element_post_message (GST_ELEMENT_CAST (dec),
+          gst_message_new_latency (GST_OBJECT_CAST (dec)));
+
+    ret = gst_audio_decoder_finish_frame_internal (dec, outbuf, 1);
+  } else {
+    GST_DEBUG_OBJECT (dec, "decoding frame %p failed: %s", djob->buffer,
+        gst_flow_get_name (ret));
+    gst_buffer_unref (outbuf);
+
+    /* counted like GST_AUDIO_DECODER_ERROR(), which can't be used here as
+     * it declares its own dec variable */
+    if (ret == GST_FLOW_ERROR)
+      ret = _gst_audio_decoder_error (dec, 1, GST_STREAM_ERROR,
+          GST_STREAM_ERROR_DECODE, NULL, g_strdup ("failed to decode frame"),
+          __FILE__, GST_FUNCTION, __LINE__);
+    /* other success values only drop the frame */
+    else if (ret > GST_FLOW_OK)
+      ret = GST_FLOW_OK;
+
+    if (ret == GST_FLOW_OK)
+      ret = gst_audio_decoder_finish_frame_internal (dec, NULL, 1);
+  }
+  gst_buffer_unref (djob->buffer);
+  g_slice_free (DecodeJob, djob);
+
+  return ret;
+}
+
+/* With stream lock. Makes the thread pool match the n-threads property */
+static GstFlowReturn
+gst_audio_decoder_update_decode_pool (GstAudioDecoder * dec)
+{
+  GstAudioDecoderPrivate *priv = dec->priv;
+  GstFlowReturn ret;
+  guint n_threads, old_threads;
+
+  GST_OBJECT_LOCK (dec);
+  n_threads = priv->n_threads;
+  GST_OBJECT_UNLOCK (dec);
+
+  /* the frames of the old pool are output first */
+  ret = gst_frame_jobs_set_n_threads (&priv->decode_jobs, &n_threads);
+
+  GST_OBJECT_LOCK (dec);
+  old_threads = priv->decode_pool_threads;
+  priv->decode_pool_threads = n_threads;
+  GST_OBJECT_UNLOCK (dec);
+
+  if (old_threads != n_threads) {
+    GST_DEBUG_OBJECT (dec, "decoding frames on %u threads", n_threads);
+    if (old_threads > 1 || n_threads > 1)
+      gst_element_post_message (GST_ELEMENT_CAST (dec),
+          gst_message_new_latency (GST_OBJECT_CAST (dec)));
+  }
+
+  return ret;
+}
+
+/**
+ * gst_audio_decoder_submit_frame:
+ * @dec: a #GstAudioDecoder
+ * @buffer: the input frame that was passed to @handle_frame
+ * @outbuf: (transfer full): the buffer to decode @buffer into
+ *
+ * Decodes @buffer into @outbuf with the @decode_frame method of the
+ * subclass, possibly on another thread while the next frames are handled.
+ * This can be called from @handle_frame instead of decoding the frame and
+ * calling gst_audio_decoder_finish_frame(). The output format should be set
+ * and @outbuf should have the size of the decoded frame.
+ *
+ * The frames are finished or dropped in the order they were submitted, as
+ * soon as they are decoded and the streaming thread submits a new frame or
+ * drains. At most #GstAudioDecoder:n-threads frames are decoded at the
+ * same time.
+ *
+ * Returns: a #GstFlowReturn resulting from decoding or pushing the previous
+ *     frames downstream.
+ *
+ * Since: 1.2
+ */
+GstFlowReturn
+gst_audio_decoder_submit_frame (GstAudioDecoder * dec, GstBuffer * buffer,
+    GstBuffer * outbuf)
+{
+  GstAudioDecoderClass *klass;
+  GstAudioDecoderPrivate *priv;
+  GstFlowReturn ret;
+  DecodeJob *job;
+
+  g_return_val_if_fail (GST_IS_AUDIO_DECODER (dec), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
+  g_return_val_if_fail (GST_IS_BUFFER (outbuf), GST_FLOW_ERROR);
+
+  klass = GST_AUDIO_DECODER_GET_CLASS (dec);
+  priv = dec->priv;
+
+  g_return_val_if_fail (klass->decode_frame != NULL, GST_FLOW_ERROR);
+
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+
+  ret = gst_audio_decoder_update_decode_pool (dec);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (outbuf);
+    goto done;
+  }
+
+  job = g_slice_new0 (DecodeJob);
+  job->buffer = gst_buffer_ref (buffer);
+  job->outbuf = outbuf;
+
+  GST_LOG_OBJECT (dec, "submitting frame %p", buffer);
+
+  /* reverse playback decodes whole chunks of frames at once anyway */
+  ret = gst_frame_jobs_submit (&priv->decode_jobs, (GstFrameJob *) job,
+      dec->input_segment.rate < 0.0);
+
+done:
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_audio_decoder_handle_frame (GstAudioDecoder * dec,
     GstAudioDecoderClass * klass, GstBuffer * buffer)
@@ -1190,6 +1454,13 @@ gst_audio_decoder_handle_frame (GstAudioDecoder * dec,
     dec->priv->ctx.delay = dec->priv->frames.length;
     dec->priv->bytes_in += size;
   } else {
+    GstFlowReturn ret;
+
+    /* output the frames that are still being decoded before the subclass
+     * drains */
+    ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
+    if (ret != GST_FLOW_OK)
+      return ret;
     GST_LOG_OBJECT (dec, "providing subclass with NULL frame");
   }
 
@@ -1317,7 +1588,7 @@ parse_failed:
 static GstFlowReturn
 gst_audio_decoder_drain (GstAudioDecoder * dec)
 {
-  GstFlowReturn ret;
+  GstFlowReturn ret, jobs_ret;
 
   if (dec->priv->drained && !dec->priv->gather)
     return GST_FLOW_OK;
@@ -1329,8 +1600,12 @@ gst_audio_decoder_drain (GstAudioDecoder * dec)
       gst_audio_decoder_chain_reverse (dec, NULL);
     /* have subclass give all it can */
     ret = gst_audio_decoder_push_buffers (dec, TRUE);
+    /* including the frames that are still being decoded */
+    jobs_ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
     /* ensure all output sent */
     ret = gst_audio_decoder_output (dec, NULL);
+    if (ret == GST_FLOW_OK)
+      ret = jobs_ret;
     /* everything should be away now */
     if (dec->priv->frames.length) {
       /* not fatal/impossible though if subclass/codec eats stuff */
@@ -1360,6 +1635,7 @@ gst_audio_decoder_flush (GstAudioDecoder * dec, gboolean hard)
   if (!hard) {
     ret = gst_audio_decoder_drain (dec);
   } else {
+    gst_frame_jobs_discard (&dec->priv->decode_jobs);
     gst_audio_decoder_clear_queues (dec);
     gst_segment_init (&dec->input_segment, GST_FORMAT_TIME);
     gst_segment_init (&dec->output_segment, GST_FORMAT_TIME);
@@ -2317,6 +2593,18 @@ gst_audio_decoder_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
           min_latency += dec->priv->ctx.min_latency;
         if (max_latency != -1)
           max_latency += dec->priv->ctx.max_latency;
+        /* submitted frames are output up to n - 1 frames later when
+         * decoding on n threads */
+        if (dec->priv->decode_pool_threads > 1
+            && GST_CLOCK_TIME_IS_VALID (dec->priv->decode_frame_duration)) {
+          GstClockTime frames_latency = (dec->priv->decode_pool_threads - 1) *
+              dec->priv->decode_frame_duration;
+
+          if (min_latency != -1)
+            min_latency += frames_latency;
+          if (max_latency != -1)
+            max_latency += frames_latency;
+        }
         GST_OBJECT_UNLOCK (dec);
 
         gst_query_set_latency (query, live, min_latency, max_latency);
@@ -2341,6 +2629,11 @@ gst_audio_decoder_stop (GstAudioDecoder * dec)
 
   klass = GST_AUDIO_DECODER_GET_CLASS (dec);
 
+  /* the subclass can free its decoding state once all frames are decoded */
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+  gst_frame_jobs_discard (&dec->priv->decode_jobs);
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
   if (klass->stop) {
     ret = klass->stop (dec);
   }
@@ -2395,6 +2688,11 @@ gst_audio_decoder_get_property (GObject * object, guint prop_id,
     case PROP_PLC:
       g_value_set_boolean (value, dec->priv->plc);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (dec);
+      g_value_set_uint (value, dec->priv->n_threads);
+      GST_OBJECT_UNLOCK (dec);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2419,6 +2717,11 @@ gst_audio_decoder_set_property (GObject * object, guint prop_id,
     case PROP_PLC:
       dec->priv->plc = g_value_get_boolean (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (dec);
+      dec->priv->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (dec);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -227,6 +227,16 @@ struct _GstAudioDecoder
  *                      Propose buffer allocation parameters for upstream elements.
  *                      Subclasses should chain up to the parent implementation to
  *                      invoke the default handler.
+ * @decode_frame:   Optional.
+ *                  Decodes a frame that was passed to
+ *                  gst_audio_decoder_submit_frame() into its output buffer.
+ *                  Can be called from multiple threads at the same time for
+ *                  different frames, so it should only read the state of the
+ *                  decoder. Returning %GST_FLOW_OK finishes the frame with the
+ *                  output buffer and other success values drop it.
+ *                  %GST_FLOW_ERROR is counted as a decoding error of the frame
+ *                  like GST_AUDIO_DECODER_ERROR() does, so this method should
+ *                  not post errors itself. Since: 1.2
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame (and likely @set_format) needs to be
@@ -274,8 +284,12 @@ struct _GstAudioDecoderClass
   gboolean      (*propose_allocation) (GstAudioDecoder *dec,
                                        GstQuery * query);
 
+  GstFlowReturn (*decode_frame)       (GstAudioDecoder *dec,
+                                       GstBuffer *buffer,
+                                       GstBuffer *outbuf);
+
   /*< private >*/
-  gpointer       _gst_reserved[GST_PADDING_LARGE];
+  gpointer       _gst_reserved[GST_PADDING_LARGE - 1];
 };
 
 GType             gst_audio_decoder_get_type (void);
@@ -288,6 +302,10 @@ gboolean          gst_audio_decoder_negotiate (GstAudioDecoder * dec);
 GstFlowReturn     gst_audio_decoder_finish_frame (GstAudioDecoder * dec,
                                                   GstBuffer * buf, gint frames);
 
+GstFlowReturn     gst_audio_decoder_submit_frame (GstAudioDecoder * dec,
+                                                  GstBuffer * buffer,
+                                                  GstBuffer * outbuf);
+
 GstBuffer *       gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec,
                                                             gsize              size);
 
@@ -1442,6 +1442,74 @@ G_STMT_START {					\
   GST_DEBUG ("rev_down end %d/%d",*accum,*toprocess);	\
 } G_STMT_END
 
+/* Commits @in_samples samples without rate conversion. Instead of going
+ * segment by segment, everything that fits between the write position and
+ * the read pointer is copied in one go, which takes at most two copies when
+ * wrapping around the end of the memory. Samples the reader already went
+ * past are dropped. */
+static guint
+default_commit_fwd (GstAudioRingBuffer * buf, guint64 * sample,
+    guint8 * data, gint in_samples)
+{
+  gint channels, bps, bpf, sps;
+  gint *reorder_map;
+  gint64 total;
+  gint done = 0;
+
+  channels = buf->spec.info.channels;
+  bpf = buf->spec.info.bpf;
+  bps = bpf / channels;
+  sps = buf->samples_per_seg;
+  reorder_map = buf->channel_reorder_map;
+  total = (gint64) buf->spec.segtotal * sps;
+
+  while (done < in_samples) {
+    gint64 readpos, writepos, towrite;
+
+    writepos = *sample;
+    readpos = (gint64) (g_atomic_int_get (&buf->segdone) - buf->segbase) * sps;
+
+    GST_DEBUG_OBJECT (buf, "pointer at %" G_GINT64_FORMAT ", write to %"
+        G_GINT64_FORMAT ", total %" G_GINT64_FORMAT, readpos, writepos, total);
+
+    if (G_UNLIKELY (writepos < readpos)) {
+      /* writer too slow, drop what the reader already went past */
+      towrite = MIN (in_samples - done, readpos - writepos);
+      GST_DEBUG_OBJECT (buf, "drop %" G_GINT64_FORMAT " samples", towrite);
+    } else if (writepos < readpos + total) {
+      guint8 *s = data + (gsize) done * bpf;
+      guint8 *d = buf->memory + (writepos % total) * bpf;
+      gint64 len;
+
+      towrite = MIN (in_samples - done, readpos + total - writepos);
+      len = MIN (towrite, total - (writepos % total));
+
+      if (buf->need_reorder) {
+        REORDER_SAMPLES (d, s, len * bpf);
+        if (len < towrite)
+          REORDER_SAMPLES (buf->memory, s + len * bpf, (towrite - len) * bpf);
+      } else {
+        memcpy (d, s, len * bpf);
+        if (len < towrite)
+          memcpy (buf->memory, s + len * bpf, (towrite - len) * bpf);
+      }
+      GST_DEBUG_OBJECT (buf, "copy %" G_GINT64_FORMAT " samples", towrite);
+    } else {
+      /* ringbuffer full, wait for the reader to free a segment */
+      if (!wait_segment (buf)) {
+        GST_DEBUG_OBJECT (buf, "stopped processing");
+        break;
+      }
+      continue;
+    }
+
+    done += towrite;
+    *sample += towrite;
+  }
+
+  return done;
+}
+
 static guint
 default_commit (GstAudioRingBuffer * buf, guint64 * sample,
     guint8 * data, gint in_samples, gint out_samples, gint * accum)
@@ -1490,6 +1558,10 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
 
   GST_DEBUG_OBJECT (buf, "write %d : %d", in_samples, out_samples);
 
+  /* without rate conversion we don't need to look at each segment */
+  if (G_LIKELY (inr == outr && !reverse && segsize == sps * bpf))
+    return default_commit_fwd (buf, sample, data, in_samples);
+
   /* write out all samples */
   while (*toprocess > 0) {
     gint avail;
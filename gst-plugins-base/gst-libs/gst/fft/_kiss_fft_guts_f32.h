@@ -42,6 +42,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 struct kiss_fft_f32_state{
     int nfft;
     int inverse;
+    int use_avx;
     int factors[2*MAXFACTORS];
     kiss_fft_f32_cpx twiddles[1];
 };
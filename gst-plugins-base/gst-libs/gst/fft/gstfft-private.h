@@ -0,0 +1,46 @@
+/* GStreamer
+ * Copyright (C) <2013> GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_FFT_PRIVATE_H__
+#define __GST_FFT_PRIVATE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum
+{
+  GST_FFT_PLAN_S16,
+  GST_FFT_PLAN_S32,
+  GST_FFT_PLAN_F32,
+  GST_FFT_PLAN_F64
+} GstFFTPlanType;
+
+typedef gpointer (*GstFFTPlanAllocFunc) (gint len, gboolean inverse);
+
+G_GNUC_INTERNAL
+gpointer gst_fft_plan_ref   (GstFFTPlanType type, gint len, gboolean inverse,
+                             GstFFTPlanAllocFunc alloc_func);
+
+G_GNUC_INTERNAL
+void     gst_fft_plan_unref (GstFFTPlanType type, gint len, gboolean inverse);
+
+G_END_DECLS
+
+#endif /* __GST_FFT_PRIVATE_H__ */
@@ -31,8 +31,75 @@
 #include <glib.h>
 
 #include "gstfft.h"
+#include "gstfft-private.h"
 #include "kiss_fft_s16.h"
 
+/* The twiddle factors of a FFT only depend on its type, length and direction
+ * and are read-only during the transform. They are shared between all
+ * instances with the same parameters and freed together with the last one,
+ * every instance only has its own scratch memory. */
+typedef struct
+{
+  gint64 key;
+  gint refcount;
+  gpointer plan;
+} GstFFTPlan;
+
+G_LOCK_DEFINE_STATIC (plans);
+static GHashTable *plans = NULL;
+
+#define GST_FFT_PLAN_KEY(type, len, inverse) \
+  ((((gint64) (type)) << 33) | (((gint64) ((inverse) ? 1 : 0)) << 32) | \
+   ((gint64) (guint32) (len)))
+
+/* Returns the plan for @type, @len and @inverse, which is allocated with
+ * @alloc_func if no instance uses it yet. Must be released with
+ * gst_fft_plan_unref(). */
+gpointer
+gst_fft_plan_ref (GstFFTPlanType type, gint len, gboolean inverse,
+    GstFFTPlanAllocFunc alloc_func)
+{
+  gint64 key = GST_FFT_PLAN_KEY (type, len, inverse);
+  GstFFTPlan *plan;
+  gpointer ret;
+
+  G_LOCK (plans);
+  if (plans == NULL)
+    plans = g_hash_table_new (g_int64_hash, g_int64_equal);
+
+  plan = g_hash_table_lookup (plans, &key);
+  if (plan == NULL) {
+    plan = g_slice_new (GstFFTPlan);
+    plan->key = key;
+    plan->refcount = 0;
+    plan->plan = alloc_func (len, inverse);
+    g_hash_table_insert (plans, &plan->key, plan);
+  }
+  plan->refcount++;
+  ret = plan->plan;
+  G_UNLOCK (plans);
+
+  return ret;
+}
+
+void
+gst_fft_plan_unref (GstFFTPlanType type, gint len, gboolean inverse)
+{
+  gint64 key = GST_FFT_PLAN_KEY (type, len, inverse);
+  GstFFTPlan *plan;
+
+  G_LOCK (plans);
+  plan = plans ? g_hash_table_lookup (plans, &key) : NULL;
+  g_assert (plan != NULL);
+
+  if (--plan->refcount == 0) {
+    g_hash_table_remove (plans, &key);
+    g_free (plan->plan);
+    g_slice_free (GstFFTPlan, plan);
+  }
+  G_UNLOCK (plans);
+}
+
 /**
  * gst_fft_next_fast_length:
  * @n: Number for which the next fast length should be returned
@@ -27,6 +27,7 @@
 #include "_kiss_fft_guts_f64.h"
 #include "kiss_fftr_f64.h"
 #include "gstfft.h"
+#include "gstfft-private.h"
 #include "gstfftf64.h"
 
 /**
@@ -68,13 +69,21 @@ struct _GstFFTF64
   gint len;
 };
 
+static gpointer
+gst_fft_f64_plan_new (gint len, gboolean inverse)
+{
+  return kiss_fftr_f64_alloc (len, (inverse) ? 1 : 0, NULL, NULL);
+}
+
 /**
  * gst_fft_f64_new:
  * @len: Length of the FFT in the time domain
  * @inverse: %TRUE if the #GstFFTF64 instance should be used for the inverse FFT
  *
  * This returns a new #GstFFTF64 instance with the given parameters. It makes
- * sense to keep one instance for several calls for speed reasons.
+ * sense to keep one instance for several calls for speed reasons. The
+ * twiddle factors are shared between all instances with the same @len and
+ * @inverse, so creating several of them is cheap.
  *
  * @len must be even and to get the best performance a product of
  * 2, 3 and 5. To get the next number with this characteristics use
@@ -86,18 +95,22 @@ GstFFTF64 *
 gst_fft_f64_new (gint len, gboolean inverse)
 {
   GstFFTF64 *self;
+  kiss_fftr_f64_cfg plan;
   gsize subsize = 0, memneeded;
 
   g_return_val_if_fail (len > 0, NULL);
   g_return_val_if_fail (len % 2 == 0, NULL);
 
-  kiss_fftr_f64_alloc (len, (inverse) ? 1 : 0, NULL, &subsize);
+  plan = gst_fft_plan_ref (GST_FFT_PLAN_F64, len, inverse,
+      gst_fft_f64_plan_new);
+
+  kiss_fftr_f64_alloc_shared (plan, NULL, &subsize);
   memneeded = ALIGN_STRUCT (sizeof (GstFFTF64)) + subsize;
 
   self = (GstFFTF64 *) g_malloc0 (memneeded);
 
   self->cfg = (((guint8 *) self) + ALIGN_STRUCT (sizeof (GstFFTF64)));
-  self->cfg = kiss_fftr_f64_alloc (len, (inverse) ? 1 : 0, self->cfg, &subsize);
+  self->cfg = kiss_fftr_f64_alloc_shared (plan, self->cfg, &subsize);
   g_assert (self->cfg);
 
   self->inverse = inverse;
@@ -169,6 +182,10 @@ gst_fft_f64_inverse_fft (GstFFTF64 * self, const GstFFTF64Complex * freqdata,
 void
 gst_fft_f64_free (GstFFTF64 * self)
 {
+  if (self == NULL)
+    return;
+
+  gst_fft_plan_unref (GST_FFT_PLAN_F64, self->len, self->inverse);
   g_free (self);
 }
 
@@ -27,6 +27,7 @@
 #include "_kiss_fft_guts_s32.h"
 #include "kiss_fftr_s32.h"
 #include "gstfft.h"
+#include "gstfft-private.h"
 #include "gstffts32.h"
 
 /**
@@ -67,13 +68,21 @@ struct _GstFFTS32
   gint len;
 };
 
+static gpointer
+gst_fft_s32_plan_new (gint len, gboolean inverse)
+{
+  return kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, NULL, NULL);
+}
+
 /**
  * gst_fft_s32_new:
  * @len: Length of the FFT in the time domain
  * @inverse: %TRUE if the #GstFFTS32 instance should be used for the inverse FFT
  *
  * This returns a new #GstFFTS32 instance with the given parameters. It makes
- * sense to keep one instance for several calls for speed reasons.
+ * sense to keep one instance for several calls for speed reasons. The
+ * twiddle factors are shared between all instances with the same @len and
+ * @inverse, so creating several of them is cheap.
  *
  * @len must be even and to get the best performance a product of
  * 2, 3 and 5. To get the next number with this characteristics use
@@ -85,18 +94,22 @@ GstFFTS32 *
 gst_fft_s32_new (gint len, gboolean inverse)
 {
   GstFFTS32 *self;
+  kiss_fftr_s32_cfg plan;
   gsize subsize = 0, memneeded;
 
   g_return_val_if_fail (len > 0, NULL);
   g_return_val_if_fail (len % 2 == 0, NULL);
 
-  kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, NULL, &subsize);
+  plan = gst_fft_plan_ref (GST_FFT_PLAN_S32, len, inverse,
+      gst_fft_s32_plan_new);
+
+  kiss_fftr_s32_alloc_shared (plan, NULL, &subsize);
   memneeded = ALIGN_STRUCT (sizeof (GstFFTS32)) + subsize;
 
   self = (GstFFTS32 *) g_malloc0 (memneeded);
 
   self->cfg = (((guint8 *) self) + ALIGN_STRUCT (sizeof (GstFFTS32)));
-  self->cfg = kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, self->cfg, &subsize);
+  self->cfg = kiss_fftr_s32_alloc_shared (plan, self->cfg, &subsize);
   g_assert (self->cfg);
 
   self->inverse = inverse;
@@ -168,6 +181,10 @@ gst_fft_s32_inverse_fft (GstFFTS32 * self, const GstFFTS32Complex * freqdata,
 void
 gst_fft_s32_free (GstFFTS32 * self)
 {
+  if (self == NULL)
+    return;
+
+  gst_fft_plan_unref (GST_FFT_PLAN_S32, self->len, self->inverse);
   g_free (self);
 }
 
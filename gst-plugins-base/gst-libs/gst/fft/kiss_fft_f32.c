@@ -20,8 +20,13 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  fixed or floating point complex numbers.  It also delares the kf_ internal functions.
  */
 
-static kiss_fft_f32_cpx *scratchbuf = NULL;
-static size_t nscratchbuf = 0;
+/* The AVX butterflies are built with function level target attributes, so
+ * they only need a compiler that supports those and are selected at runtime */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define KISS_FFT_USE_AVX 1
+#endif
+
 static kiss_fft_f32_cpx *tmpbuf = NULL;
 static size_t ntmpbuf = 0;
 
@@ -219,6 +224,10 @@ kf_bfly5 (kiss_fft_f32_cpx * Fout,
   }
 }
 
+#ifdef KISS_FFT_USE_AVX
+#include "kiss_fft_f32_avx.h"
+#endif
+
 /* perform the butterfly for one stage of a mixed radix FFT */
 static void
 kf_bfly_generic (kiss_fft_f32_cpx * Fout,
@@ -228,8 +237,12 @@ kf_bfly_generic (kiss_fft_f32_cpx * Fout,
   kiss_fft_f32_cpx *twiddles = st->twiddles;
   kiss_fft_f32_cpx t;
   int Norig = st->nfft;
+  /* local so that several FFTs can run in parallel */
+  kiss_fft_f32_cpx stackbuf[32];
+  kiss_fft_f32_cpx *scratchbuf = stackbuf;
 
-  CHECKBUF (scratchbuf, nscratchbuf, p);
+  if (p > 32)
+    scratchbuf = g_new (kiss_fft_f32_cpx, p);
 
   for (u = 0; u < m; ++u) {
     k = u;
@@ -254,6 +267,44 @@ kf_bfly_generic (kiss_fft_f32_cpx * Fout,
       k += m;
     }
   }
+
+  if (scratchbuf != stackbuf)
+    g_free (scratchbuf);
+}
+
+static void
+kf_bfly (kiss_fft_f32_cpx * Fout,
+    const size_t fstride, const kiss_fft_f32_cfg st, int m, int p)
+{
+  switch (p) {
+    case 2:
+#ifdef KISS_FFT_USE_AVX
+      if (st->use_avx && m >= 4) {
+        kf_bfly2_avx (Fout, fstride, st, m);
+        break;
+      }
+#endif
+      kf_bfly2 (Fout, fstride, st, m);
+      break;
+    case 3:
+      kf_bfly3 (Fout, fstride, st, m);
+      break;
+    case 4:
+#ifdef KISS_FFT_USE_AVX
+      if (st->use_avx && m >= 4) {
+        kf_bfly4_avx (Fout, fstride, st, m);
+        break;
+      }
+#endif
+      kf_bfly4 (Fout, fstride, st, m);
+      break;
+    case 5:
+      kf_bfly5 (Fout, fstride, st, m);
+      break;
+    default:
+      kf_bfly_generic (Fout, fstride, st, m, p);
+      break;
+  }
 }
 
 static void
@@ -280,23 +331,7 @@ kf_work (kiss_fft_f32_cpx * Fout,
           in_stride, factors, st);
     // all threads have joined by this point
 
-    switch (p) {
-      case 2:
-        kf_bfly2 (Fout, fstride, st, m);
-        break;
-      case 3:
-        kf_bfly3 (Fout, fstride, st, m);
-        break;
-      case 4:
-        kf_bfly4 (Fout, fstride, st, m);
-        break;
-      case 5:
-        kf_bfly5 (Fout, fstride, st, m);
-        break;
-      default:
-        kf_bfly_generic (Fout, fstride, st, m, p);
-        break;
-    }
+    kf_bfly (Fout, fstride, st, m, p);
     return;
   }
 #endif
@@ -320,23 +355,7 @@ kf_work (kiss_fft_f32_cpx * Fout,
   Fout = Fout_beg;
 
   // recombine the p smaller DFTs 
-  switch (p) {
-    case 2:
-      kf_bfly2 (Fout, fstride, st, m);
-      break;
-    case 3:
-      kf_bfly3 (Fout, fstride, st, m);
-      break;
-    case 4:
-      kf_bfly4 (Fout, fstride, st, m);
-      break;
-    case 5:
-      kf_bfly5 (Fout, fstride, st, m);
-      break;
-    default:
-      kf_bfly_generic (Fout, fstride, st, m, p);
-      break;
-  }
+  kf_bfly (Fout, fstride, st, m, p);
 }
 
 /*  facbuf is populated by p1,m1,p2,m2, ...
@@ -400,6 +419,12 @@ kiss_fft_f32_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
 
     st->nfft = nfft;
     st->inverse = inverse_fft;
+#ifdef KISS_FFT_USE_AVX
+    __builtin_cpu_init ();
+    st->use_avx = __builtin_cpu_supports ("avx") ? 1 : 0;
+#else
+    st->use_avx = 0;
+#endif
 
     for (i = 0; i < nfft; ++i) {
       const double pi =
@@ -446,9 +471,6 @@ kiss_fft_f32 (kiss_fft_f32_cfg cfg, const kiss_fft_f32_cpx * fin,
 void
 kiss_fft_f32_cleanup (void)
 {
-  free (scratchbuf);
-  scratchbuf = NULL;
-  nscratchbuf = 0;
   free (tmpbuf);
   tmpbuf = NULL;
   ntmpbuf = 0;
@@ -0,0 +1,162 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Radix-2 and radix-4 butterflies for kiss_fft_f32 that process four complex
+ * values per AVX register. They are compiled for AVX independent of the
+ * compiler flags and are only called after checking at runtime that the CPU
+ * supports it, see kiss_fft_f32_alloc().
+ *
+ * The complex multiplication is done with separate multiplies and an
+ * addsub instead of FMA so that the results are bit-exact with the scalar
+ * butterflies. Leftover values when m is not a multiple of 4 are handled
+ * with the scalar code. */
+
+#include <immintrin.h>
+
+#define KISS_FFT_AVX __attribute__ ((target ("avx")))
+
+/* loads the twiddles tw[0], tw[stride], tw[2 * stride] and tw[3 * stride] */
+static inline __m256 KISS_FFT_AVX
+kf_load_twiddles_avx (const kiss_fft_f32_cpx * tw, size_t stride)
+{
+  __m128 lo, hi;
+
+  if (stride == 1)
+    return _mm256_loadu_ps ((const float *) tw);
+
+  lo = _mm_castpd_ps (_mm_load_sd ((const double *) tw));
+  lo = _mm_loadh_pi (lo, (const __m64 *) (tw + stride));
+  hi = _mm_castpd_ps (_mm_load_sd ((const double *) (tw + 2 * stride)));
+  hi = _mm_loadh_pi (hi, (const __m64 *) (tw + 3 * stride));
+
+  return _mm256_insertf128_ps (_mm256_castps128_ps256 (lo), hi, 1);
+}
+
+/* (a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r) for four complex values */
+static inline __m256 KISS_FFT_AVX
+kf_cmul_avx (__m256 a, __m256 b)
+{
+  __m256 b_r = _mm256_moveldup_ps (b);
+  __m256 b_i = _mm256_movehdup_ps (b);
+  __m256 a_swap = _mm256_permute_ps (a, _MM_SHUFFLE (2, 3, 0, 1));
+
+  return _mm256_addsub_ps (_mm256_mul_ps (a, b_r),
+      _mm256_mul_ps (a_swap, b_i));
+}
+
+static void KISS_FFT_AVX
+kf_bfly2_avx (kiss_fft_f32_cpx * Fout,
+    const size_t fstride, const kiss_fft_f32_cfg st, int m)
+{
+  kiss_fft_f32_cpx *Fout2 = Fout + m;
+  const kiss_fft_f32_cpx *tw = st->twiddles;
+  kiss_fft_f32_cpx t;
+  int k;
+
+  for (k = 0; k + 4 <= m; k += 4) {
+    __m256 a = _mm256_loadu_ps ((float *) (Fout + k));
+    __m256 b = _mm256_loadu_ps ((float *) (Fout2 + k));
+    __m256 w = kf_load_twiddles_avx (tw + k * fstride, fstride);
+
+    b = kf_cmul_avx (b, w);
+    _mm256_storeu_ps ((float *) (Fout2 + k), _mm256_sub_ps (a, b));
+    _mm256_storeu_ps ((float *) (Fout + k), _mm256_add_ps (a, b));
+  }
+
+  for (; k < m; k++) {
+    C_MUL (t, Fout2[k], tw[k * fstride]);
+    C_SUB (Fout2[k], Fout[k], t);
+    C_ADDTO (Fout[k], t);
+  }
+}
+
+static void KISS_FFT_AVX
+kf_bfly4_avx (kiss_fft_f32_cpx * Fout,
+    const size_t fstride, const kiss_fft_f32_cfg st, const size_t m)
+{
+  const kiss_fft_f32_cpx *tw = st->twiddles;
+  const size_t m2 = 2 * m;
+  const size_t m3 = 3 * m;
+  /* negates the imaginary parts */
+  const __m256 sign = _mm256_castsi256_ps (_mm256_set1_epi64x
+      (G_GINT64_CONSTANT (0x8000000000000000)));
+  kiss_fft_f32_cpx scratch[6];
+  size_t k;
+
+  for (k = 0; k + 4 <= m; k += 4) {
+    __m256 f0 = _mm256_loadu_ps ((float *) (Fout + k));
+    __m256 f1 = _mm256_loadu_ps ((float *) (Fout + k + m));
+    __m256 f2 = _mm256_loadu_ps ((float *) (Fout + k + m2));
+    __m256 f3 = _mm256_loadu_ps ((float *) (Fout + k + m3));
+    __m256 s0, s1, s2, s3, s4, s5;
+
+    s0 = kf_cmul_avx (f1, kf_load_twiddles_avx (tw + k * fstride, fstride));
+    s1 = kf_cmul_avx (f2, kf_load_twiddles_avx (tw + 2 * k * fstride,
+            2 * fstride));
+    s2 = kf_cmul_avx (f3, kf_load_twiddles_avx (tw + 3 * k * fstride,
+            3 * fstride));
+
+    s5 = _mm256_sub_ps (f0, s1);
+    f0 = _mm256_add_ps (f0, s1);
+    s3 = _mm256_add_ps (s0, s2);
+    s4 = _mm256_sub_ps (s0, s2);
+
+    _mm256_storeu_ps ((float *) (Fout + k + m2), _mm256_sub_ps (f0, s3));
+    _mm256_storeu_ps ((float *) (Fout + k), _mm256_add_ps (f0, s3));
+
+    /* (s4.i, -s4.r) */
+    s4 = _mm256_xor_ps (_mm256_permute_ps (s4, _MM_SHUFFLE (2, 3, 0, 1)),
+        sign);
+
+    if (st->inverse) {
+      _mm256_storeu_ps ((float *) (Fout + k + m), _mm256_sub_ps (s5, s4));
+      _mm256_storeu_ps ((float *) (Fout + k + m3), _mm256_add_ps (s5, s4));
+    } else {
+      _mm256_storeu_ps ((float *) (Fout + k + m), _mm256_add_ps (s5, s4));
+      _mm256_storeu_ps ((float *) (Fout + k + m3), _mm256_sub_ps (s5, s4));
+    }
+  }
+
+  for (; k < m; k++) {
+    kiss_fft_f32_cpx *F = Fout + k;
+
+    C_MUL (scratch[0], F[m], tw[k * fstride]);
+    C_MUL (scratch[1], F[m2], tw[2 * k * fstride]);
+    C_MUL (scratch[2], F[m3], tw[3 * k * fstride]);
+
+    C_SUB (scratch[5], *F, scratch[1]);
+    C_ADDTO (*F, scratch[1]);
+    C_ADD (scratch[3], scratch[0], scratch[2]);
+    C_SUB (scratch[4], scratch[0], scratch[2]);
+    C_SUB (F[m2], *F, scratch[3]);
+    C_ADDTO (*F, scratch[3]);
+
+    if (st->inverse) {
+      F[m].r = scratch[5].r - scratch[4].i;
+      F[m].i = scratch[5].i + scratch[4].r;
+      F[m3].r = scratch[5].r + scratch[4].i;
+      F[m3].i = scratch[5].i - scratch[4].r;
+    } else {
+      F[m].r = scratch[5].r + scratch[4].i;
+      F[m].i = scratch[5].i - scratch[4].r;
+      F[m3].r = scratch[5].r - scratch[4].i;
+      F[m3].i = scratch[5].i + scratch[4].r;
+    }
+  }
+}
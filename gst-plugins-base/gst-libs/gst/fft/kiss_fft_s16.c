@@ -20,8 +20,6 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  fixed or floating point complex numbers.  It also delares the kf_ internal functions.
  */
 
-static kiss_fft_s16_cpx *scratchbuf = NULL;
-static size_t nscratchbuf = 0;
 static kiss_fft_s16_cpx *tmpbuf = NULL;
 static size_t ntmpbuf = 0;
 
@@ -228,8 +226,12 @@ kf_bfly_generic (kiss_fft_s16_cpx * Fout,
   kiss_fft_s16_cpx *twiddles = st->twiddles;
   kiss_fft_s16_cpx t;
   int Norig = st->nfft;
+  /* local so that several FFTs can run in parallel */
+  kiss_fft_s16_cpx stackbuf[32];
+  kiss_fft_s16_cpx *scratchbuf = stackbuf;
 
-  CHECKBUF (scratchbuf, nscratchbuf, p);
+  if (p > 32)
+    scratchbuf = g_new (kiss_fft_s16_cpx, p);
 
   for (u = 0; u < m; ++u) {
     k = u;
@@ -254,6 +256,9 @@ kf_bfly_generic (kiss_fft_s16_cpx * Fout,
       k += m;
     }
   }
+
+  if (scratchbuf != stackbuf)
+    g_free (scratchbuf);
 }
 
 static void
@@ -446,9 +451,6 @@ kiss_fft_s16 (kiss_fft_s16_cfg cfg, const kiss_fft_s16_cpx * fin,
 void
 kiss_fft_s16_cleanup (void)
 {
-  free (scratchbuf);
-  scratchbuf = NULL;
-  nscratchbuf = 0;
   free (tmpbuf);
   tmpbuf = NULL;
   ntmpbuf = 0;
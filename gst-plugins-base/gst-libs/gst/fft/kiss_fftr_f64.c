@@ -73,6 +73,34 @@ kiss_fftr_f64_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
   return st;
 }
 
+kiss_fftr_f64_cfg
+kiss_fftr_f64_alloc_shared (kiss_fftr_f64_cfg plan, void *mem,
+    size_t * lenmem)
+{
+  kiss_fftr_f64_cfg st = NULL;
+  size_t memneeded;
+
+  memneeded = ALIGN_STRUCT (sizeof (struct kiss_fftr_f64_state))
+      + sizeof (kiss_fft_f64_cpx) * plan->substate->nfft;
+
+  if (lenmem == NULL) {
+    st = (kiss_fftr_f64_cfg) KISS_FFT_F64_MALLOC (memneeded);
+  } else {
+    if (*lenmem >= memneeded)
+      st = (kiss_fftr_f64_cfg) mem;
+    *lenmem = memneeded;
+  }
+  if (!st)
+    return NULL;
+
+  st->substate = plan->substate;
+  st->tmpbuf = (kiss_fft_f64_cpx *) (((char *) st) +
+      ALIGN_STRUCT (sizeof (struct kiss_fftr_f64_state)));
+  st->super_twiddles = plan->super_twiddles;
+
+  return st;
+}
+
 void
 kiss_fftr_f64 (kiss_fftr_f64_cfg st, const kiss_fft_f64_scalar * timedata,
     kiss_fft_f64_cpx * freqdata)
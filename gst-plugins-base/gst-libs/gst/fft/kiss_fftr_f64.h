@@ -26,6 +26,13 @@ kiss_fftr_f64_cfg kiss_fftr_f64_alloc(int nfft,int inverse_fft,void * mem, size_
 */
 
 
+kiss_fftr_f64_cfg kiss_fftr_f64_alloc_shared(kiss_fftr_f64_cfg plan,void * mem, size_t * lenmem);
+/*
+ Allocates a configuration that shares the twiddle factors of plan but has its
+ own scratch buffer, so that several of them can be used in parallel. plan must
+ stay valid until the returned configuration is freed.
+*/
+
 void kiss_fftr_f64(kiss_fftr_f64_cfg cfg,const kiss_fft_f64_scalar *timedata,kiss_fft_f64_cpx *freqdata);
 /*
  input timedata has nfft scalar points
@@ -0,0 +1,291 @@
+/* GStreamer
+ * Copyright (C) 2013 Collabora Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Processes the frames of a codec base class on a thread pool and finishes
+ * them in the order they were submitted. Used by the audio decoder and the
+ * video decoder and encoder, the video slice runner only shares
+ * gst_frame_jobs_get_n_processors(). Everything is static so that every
+ * library gets its own copy without exporting any symbols. */
+
+#ifndef __GST_FRAME_JOBS_PRIVATE_H__
+#define __GST_FRAME_JOBS_PRIVATE_H__
+
+#include <gst/gst.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+G_BEGIN_DECLS
+
+typedef struct _GstFrameJob GstFrameJob;
+typedef struct _GstFrameJobs GstFrameJobs;
+
+/* processes @job, called on a thread of the pool or, without pool, on the
+ * streaming thread */
+typedef GstFlowReturn (*GstFrameJobProcessFunc) (GstFrameJob * job,
+    gpointer user_data);
+/* outputs the result of @job and frees it, called with the stream lock */
+typedef GstFlowReturn (*GstFrameJobFinishFunc) (GstFrameJob * job,
+    gpointer user_data);
+/* releases @job without output, called with the stream lock */
+typedef void (*GstFrameJobDiscardFunc) (GstFrameJob * job,
+    gpointer user_data);
+
+/* the first member of the job structures of the base classes */
+struct _GstFrameJob
+{
+  GstFlowReturn ret;
+  gboolean done;
+};
+
+struct _GstFrameJobs
+{
+  GThreadPool *pool;
+  guint n_threads;
+
+  /* submitted jobs in submission order, only the streaming thread adds and
+   * removes jobs */
+  GQueue queue;
+  /* protects the done and ret fields of the jobs */
+  GMutex lock;
+  GCond cond;
+  /* failure of finishing the jobs from a place that could not return it */
+  GstFlowReturn deferred_ret;
+
+  GstFrameJobProcessFunc process;
+  GstFrameJobFinishFunc finish;
+  GstFrameJobDiscardFunc discard;
+  gpointer user_data;
+};
+
+static inline guint
+gst_frame_jobs_get_n_processors (void)
+{
+#if GLIB_CHECK_VERSION (2, 36, 0)
+  return g_get_num_processors ();
+#elif defined (HAVE_UNISTD_H) && defined (_SC_NPROCESSORS_ONLN)
+  glong n = sysconf (_SC_NPROCESSORS_ONLN);
+
+  return n > 0 ? n : 1;
+#else
+  return 1;
+#endif
+}
+
+static inline void
+gst_frame_jobs_init (GstFrameJobs * jobs, GstFrameJobProcessFunc process,
+    GstFrameJobFinishFunc finish, GstFrameJobDiscardFunc discard,
+    gpointer user_data)
+{
+  jobs->pool = NULL;
+  jobs->n_threads = 1;
+  g_queue_init (&jobs->queue);
+  g_mutex_init (&jobs->lock);
+  g_cond_init (&jobs->cond);
+  jobs->deferred_ret = GST_FLOW_OK;
+  jobs->process = process;
+  jobs->finish = finish;
+  jobs->discard = discard;
+  jobs->user_data = user_data;
+}
+
+static inline void
+gst_frame_jobs_func (gpointer data, gpointer user_data)
+{
+  GstFrameJobs *jobs = user_data;
+  GstFrameJob *job = data;
+  GstFlowReturn ret;
+
+  ret = jobs->process (job, jobs->user_data);
+
+  g_mutex_lock (&jobs->lock);
+  job->ret = ret;
+  job->done = TRUE;
+  g_cond_broadcast (&jobs->cond);
+  g_mutex_unlock (&jobs->lock);
+}
+
+/* With stream lock. Returns and clears the result of the last
+ * gst_frame_jobs_finish_deferred() that failed */
+static inline GstFlowReturn
+gst_frame_jobs_take_deferred_ret (GstFrameJobs * jobs)
+{
+  GstFlowReturn ret = jobs->deferred_ret;
+
+  jobs->deferred_ret = GST_FLOW_OK;
+
+  return ret;
+}
+
+/* With stream lock. Waits for all submitted jobs and releases them */
+static inline void
+gst_frame_jobs_discard (GstFrameJobs * jobs)
+{
+  GstFrameJob *job;
+
+  jobs->deferred_ret = GST_FLOW_OK;
+
+  g_mutex_lock (&jobs->lock);
+  while ((job = g_queue_pop_head (&jobs->queue))) {
+    while (!job->done)
+      g_cond_wait (&jobs->cond, &jobs->lock);
+    g_mutex_unlock (&jobs->lock);
+
+    jobs->discard (job, jobs->user_data);
+
+    g_mutex_lock (&jobs->lock);
+  }
+  g_mutex_unlock (&jobs->lock);
+}
+
+/* With stream lock. Finishes the processed jobs in the order they were
+ * submitted until at most @max_pending jobs are left, waiting for jobs that
+ * are still being processed if needed. With @max_pending 0 no job is left
+ * when this returns, the jobs after a failed one are discarded. A deferred
+ * failure is returned first. */
+static inline GstFlowReturn
+gst_frame_jobs_finish (GstFrameJobs * jobs, guint max_pending)
+{
+  GstFlowReturn ret;
+  GstFrameJob *job;
+
+  ret = gst_frame_jobs_take_deferred_ret (jobs);
+  if (ret != GST_FLOW_OK) {
+    if (max_pending == 0)
+      gst_frame_jobs_discard (jobs);
+    return ret;
+  }
+
+  g_mutex_lock (&jobs->lock);
+  while ((job = g_queue_peek_head (&jobs->queue))) {
+    if (!job->done) {
+      if (g_queue_get_length (&jobs->queue) <= max_pending)
+        break;
+      g_cond_wait (&jobs->cond, &jobs->lock);
+      continue;
+    }
+    g_queue_pop_head (&jobs->queue);
+    g_mutex_unlock (&jobs->lock);
+
+    ret = jobs->finish (job, jobs->user_data);
+
+    g_mutex_lock (&jobs->lock);
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+  g_mutex_unlock (&jobs->lock);
+
+  if (ret != GST_FLOW_OK && max_pending == 0)
+    gst_frame_jobs_discard (jobs);
+
+  return ret;
+}
+
+/* With stream lock. Finishes all jobs from a place that can't return a
+ * #GstFlowReturn, a failure is returned by the next gst_frame_jobs_finish()
+ * or gst_frame_jobs_take_deferred_ret() instead. */
+static inline void
+gst_frame_jobs_finish_deferred (GstFrameJobs * jobs)
+{
+  GstFlowReturn ret;
+
+  ret = gst_frame_jobs_finish (jobs, 0);
+  if (ret != GST_FLOW_OK)
+    jobs->deferred_ret = ret;
+}
+
+/* With stream lock. Processes @job on the pool, or right away when there is
+ * no pool or when @serial is set, and finishes the jobs that are done. All
+ * threads are kept busy with at most n_threads pending jobs. */
+static inline GstFlowReturn
+gst_frame_jobs_submit (GstFrameJobs * jobs, GstFrameJob * job,
+    gboolean serial)
+{
+  GstFlowReturn ret;
+
+  if (jobs->pool == NULL || serial) {
+    ret = gst_frame_jobs_finish (jobs, 0);
+    if (ret != GST_FLOW_OK) {
+      jobs->discard (job, jobs->user_data);
+      return ret;
+    }
+    job->ret = jobs->process (job, jobs->user_data);
+    job->done = TRUE;
+
+    return jobs->finish (job, jobs->user_data);
+  }
+
+  g_mutex_lock (&jobs->lock);
+  g_queue_push_tail (&jobs->queue, job);
+  g_mutex_unlock (&jobs->lock);
+  g_thread_pool_push (jobs->pool, job, NULL);
+
+  /* wait for the oldest job when all threads are busy */
+  return gst_frame_jobs_finish (jobs, jobs->n_threads - 1);
+}
+
+/* With stream lock. Processes the jobs on @n_threads threads, 0 meaning one
+ * per CPU. The pending jobs are finished first and the result of that is
+ * returned. @n_threads is updated to the number of threads that are used. */
+static inline GstFlowReturn
+gst_frame_jobs_set_n_threads (GstFrameJobs * jobs, guint * n_threads)
+{
+  GstFlowReturn ret;
+
+  if (*n_threads == 0)
+    *n_threads = gst_frame_jobs_get_n_processors ();
+
+  if (*n_threads == jobs->n_threads)
+    return GST_FLOW_OK;
+
+  ret = gst_frame_jobs_finish (jobs, 0);
+
+  if (jobs->pool) {
+    g_thread_pool_free (jobs->pool, FALSE, TRUE);
+    jobs->pool = NULL;
+  }
+  if (*n_threads > 1) {
+    jobs->pool = g_thread_pool_new (gst_frame_jobs_func, jobs, *n_threads,
+        FALSE, NULL);
+    if (jobs->pool == NULL)
+      *n_threads = 1;
+  }
+  jobs->n_threads = *n_threads;
+
+  return ret;
+}
+
+/* Discards the pending jobs and frees the pool */
+static inline void
+gst_frame_jobs_clear (GstFrameJobs * jobs)
+{
+  gst_frame_jobs_discard (jobs);
+  if (jobs->pool) {
+    g_thread_pool_free (jobs->pool, FALSE, TRUE);
+    jobs->pool = NULL;
+  }
+  jobs->n_threads = 1;
+  g_mutex_clear (&jobs->lock);
+  g_cond_clear (&jobs->cond);
+}
+
+G_END_DECLS
+
+#endif /* __GST_FRAME_JOBS_PRIVATE_H__ */
@@ -72,6 +72,14 @@
  *       allow the base class to do timestamp and offset tracking, and possibly to
  *       requeue the frame for a later attempt in the case of reverse playback.
  *     </para></listitem>
+ *     <listitem><para>
+ *       Decoders of frames that do not depend on other frames, like image
+ *       decoders, can instead negotiate and allocate the output buffer in
+ *       @handle_frame and pass the frame to @gst_video_decoder_submit_frame.
+ *       The base class then calls @decode_frame on up to
+ *       #GstVideoDecoder:n-threads threads at the same time and finishes the
+ *       frames in the order they were submitted.
+ *     </para></listitem>
  *   </itemizedlist>
  * </listitem>
  * <listitem>
@@ -302,6 +310,8 @@
 #include <gst/video/gstvideometa.h>
 #include <string.h>
 
+#include "gst/gstframejobs-private.h"
+
 GST_DEBUG_CATEGORY (videodecoder_debug);
 #define GST_CAT_DEFAULT videodecoder_debug
 
@@ -405,6 +415,27 @@ struct _GstVideoDecoderPrivate
 
   GstTagList *tags;
   gboolean tags_changed;
+
+  /* frame threading */
+  guint n_threads;              /* OBJECT_LOCK */
+  GstFrameJobs decode_jobs;     /* STREAM_LOCK */
+  guint decode_pool_threads;    /* OBJECT_LOCK and STREAM_LOCK */
+};
+
+/* a frame that was passed to gst_video_decoder_submit_frame() */
+typedef struct
+{
+  GstFrameJob job;
+
+  GstVideoCodecFrame *frame;
+} DecodeJob;
+
+#define DEFAULT_N_THREADS 1
+
+enum
+{
+  PROP_0,
+  PROP_N_THREADS
 };
 
 static GstElementClass *parent_class = NULL;
@@ -413,6 +444,10 @@ static void gst_video_decoder_init (GstVideoDecoder * dec,
     GstVideoDecoderClass * klass);
 
 static void gst_video_decoder_finalize (GObject * object);
+static void gst_video_decoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_video_decoder_setcaps (GstVideoDecoder * dec,
     GstCaps * caps);
@@ -455,6 +490,12 @@ static gboolean gst_video_decoder_decide_allocation_default (GstVideoDecoder *
 static gboolean gst_video_decoder_propose_allocation_default (GstVideoDecoder *
     decoder, GstQuery * query);
 static gboolean gst_video_decoder_negotiate_default (GstVideoDecoder * decoder);
+static GstFlowReturn gst_video_decoder_decode_job (GstFrameJob * job,
+    gpointer user_data);
+static GstFlowReturn gst_video_decoder_finish_job (GstFrameJob * job,
+    gpointer user_data);
+static void gst_video_decoder_discard_job (GstFrameJob * job,
+    gpointer user_data);
 static GstFlowReturn gst_video_decoder_parse_available (GstVideoDecoder * dec,
     gboolean at_eos, gboolean new_buffer);
 
@@ -502,6 +543,23 @@ gst_video_decoder_class_init (GstVideoDecoderClass * klass)
   g_type_class_add_private (klass, sizeof (GstVideoDecoderPrivate));
 
   gobject_class->finalize = gst_video_decoder_finalize;
+  gobject_class->set_property = gst_video_decoder_set_property;
+  gobject_class->get_property = gst_video_decoder_get_property;
+
+  /**
+   * GstVideoDecoder:n-threads:
+   *
+   * The maximum number of frames that are decoded at the same time, 0 uses
+   * one thread per CPU. This only has an effect on decoders that implement
+   * the decode_frame method. Decoding on N threads adds up to N - 1 frames
+   * of latency.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_decoder_change_state);
@@ -558,6 +616,11 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
   decoder->priv->output_adapter = gst_adapter_new ();
   decoder->priv->packetized = TRUE;
 
+  decoder->priv->n_threads = DEFAULT_N_THREADS;
+  gst_frame_jobs_init (&decoder->priv->decode_jobs,
+      gst_video_decoder_decode_job, gst_video_decoder_finish_job,
+      gst_video_decoder_discard_job, decoder);
+
   gst_video_decoder_reset (decoder, TRUE);
 }
 
@@ -822,6 +885,8 @@ gst_video_decoder_finalize (GObject * object)
 
   g_rec_mutex_clear (&decoder->stream_lock);
 
+  gst_frame_jobs_clear (&decoder->priv->decode_jobs);
+
   if (decoder->priv->input_adapter) {
     g_object_unref (decoder->priv->input_adapter);
     decoder->priv->input_adapter = NULL;
@@ -849,6 +914,42 @@ gst_video_decoder_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static void
+gst_video_decoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (decoder);
+      decoder->priv->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (decoder);
+      g_value_set_uint (value, decoder->priv->n_threads);
+      GST_OBJECT_UNLOCK (decoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 /* hard == FLUSH, otherwise discont */
 static GstFlowReturn
 gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
@@ -861,6 +962,13 @@ gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
 
   GST_LOG_OBJECT (dec, "flush hard %d", hard);
 
+  /* frames that are still being decoded are discarded on a FLUSH and output
+   * otherwise */
+  if (hard)
+    gst_frame_jobs_discard (&dec->priv->decode_jobs);
+  else
+    ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
+
   /* Inform subclass */
   if (klass->reset)
     klass->reset (dec, hard);
@@ -968,9 +1076,16 @@ gst_video_decoder_drain_out (GstVideoDecoder * dec, gboolean at_eos)
     ret = gst_video_decoder_flush_parse (dec, TRUE);
   }
 
+  /* output the frames that are still being decoded before the subclass
+   * drains */
+  if (ret == GST_FLOW_OK)
+    ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
+
   if (at_eos) {
     if (decoder_class->finish)
       ret = decoder_class->finish (dec);
+    if (ret == GST_FLOW_OK)
+      ret = gst_frame_jobs_finish (&dec->priv->decode_jobs, 0);
   }
 
   GST_VIDEO_DECODER_STREAM_UNLOCK (dec);
@@ -1486,6 +1601,16 @@ gst_video_decoder_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
         } else if (max_latency != GST_CLOCK_TIME_NONE) {
           max_latency += dec->priv->max_latency;
         }
+        /* submitted frames are output up to n - 1 frames later when
+         * decoding on n threads */
+        if (dec->priv->decode_pool_threads > 1) {
+          GstClockTime frames_latency = (dec->priv->decode_pool_threads - 1) *
+              dec->priv->qos_frame_duration;
+
+          min_latency += frames_latency;
+          if (max_latency != GST_CLOCK_TIME_NONE)
+            max_latency += frames_latency;
+        }
         GST_OBJECT_UNLOCK (dec);
 
         gst_query_set_latency (query, live, min_latency, max_latency);
@@ -2004,6 +2129,9 @@ gst_video_decoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   else
     ret = gst_video_decoder_chain_reverse (decoder, buf);
 
+  if (ret == GST_FLOW_OK)
+    ret = gst_frame_jobs_take_deferred_ret (&decoder->priv->decode_jobs);
+
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
   return ret;
 
@@ -2046,6 +2174,12 @@ gst_video_decoder_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* the subclass can free its decoding state once all frames are
+       * decoded */
+      GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+      gst_frame_jobs_discard (&decoder->priv->decode_jobs);
+      GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
       if (decoder_class->stop && !decoder_class->stop (decoder))
         goto stop_failed;
 
@@ -2487,11 +2621,148 @@ gst_video_decoder_finish_frame (GstVideoDecoder * decoder,
 done:
   if (frame)
     gst_video_decoder_release_frame (decoder, frame);
+  /* a failure of set_output_state() to push the previous frames */
+  if (ret == GST_FLOW_OK)
+    ret = gst_frame_jobs_take_deferred_ret (&priv->decode_jobs);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
   return ret;
 }
 
 
+static GstFlowReturn
+gst_video_decoder_decode_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoDecoder *decoder = user_data;
+  GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+
+  return decoder_class->decode_frame (decoder, ((DecodeJob *) job)->frame);
+}
+
+/* With stream lock, frees @job */
+static GstFlowReturn
+gst_video_decoder_finish_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoDecoder *decoder = user_data;
+  GstVideoCodecFrame *frame = ((DecodeJob *) job)->frame;
+  GstFlowReturn ret = job->ret;
+
+  if (ret == GST_FLOW_OK) {
+    ret = gst_video_decoder_finish_frame (decoder, frame);
+  } else {
+    GST_DEBUG_OBJECT (decoder, "decoding frame %p failed: %s", frame,
+        gst_flow_get_name (ret));
+    gst_video_decoder_drop_frame (decoder, frame);
+    /* other success values only drop the frame */
+    if (ret > GST_FLOW_OK)
+      ret = GST_FLOW_OK;
+  }
+  g_slice_free (DecodeJob, (DecodeJob *) job);
+
+  return ret;
+}
+
+/* With stream lock, frees @job */
+static void
+gst_video_decoder_discard_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoDecoder *decoder = user_data;
+  GstVideoCodecFrame *frame = ((DecodeJob *) job)->frame;
+
+  GST_LOG_OBJECT (decoder, "discarding frame %p", frame);
+  gst_video_decoder_release_frame (decoder, frame);
+  g_slice_free (DecodeJob, (DecodeJob *) job);
+}
+
+/* With stream lock. Makes the thread pool match the n-threads property */
+static GstFlowReturn
+gst_video_decoder_update_decode_pool (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstFlowReturn ret;
+  guint n_threads, old_threads;
+
+  GST_OBJECT_LOCK (decoder);
+  n_threads = priv->n_threads;
+  GST_OBJECT_UNLOCK (decoder);
+
+  /* the frames of the old pool are output first */
+  ret = gst_frame_jobs_set_n_threads (&priv->decode_jobs, &n_threads);
+
+  GST_OBJECT_LOCK (decoder);
+  old_threads = priv->decode_pool_threads;
+  priv->decode_pool_threads = n_threads;
+  GST_OBJECT_UNLOCK (decoder);
+
+  if (old_threads != n_threads) {
+    GST_DEBUG_OBJECT (decoder, "decoding frames on %u threads", n_threads);
+    if (old_threads > 1 || n_threads > 1)
+      gst_element_post_message (GST_ELEMENT_CAST (decoder),
+          gst_message_new_latency (GST_OBJECT_CAST (decoder)));
+  }
+
+  return ret;
+}
+
+/**
+ * gst_video_decoder_submit_frame:
+ * @decoder: a #GstVideoDecoder
+ * @frame: (transfer full): the #GstVideoCodecFrame to decode
+ *
+ * Decodes @frame with the @decode_frame method of the subclass, possibly on
+ * another thread while the next frames are handled. This can be called from
+ * @handle_frame instead of decoding the frame directly. The output state
+ * should be set and the output buffer of @frame allocated before.
+ *
+ * The frames are finished or dropped in the order they were submitted, as
+ * soon as they are decoded and the streaming thread submits a new frame or
+ * drains. At most #GstVideoDecoder:n-threads frames are decoded at the
+ * same time.
+ *
+ * Returns: a #GstFlowReturn resulting from decoding or pushing the previous
+ *     frames downstream.
+ *
+ * Since: 1.2
+ */
+GstFlowReturn
+gst_video_decoder_submit_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoDecoderClass *decoder_class;
+  GstVideoDecoderPrivate *priv;
+  GstFlowReturn ret;
+  DecodeJob *job;
+
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder), GST_FLOW_ERROR);
+  g_return_val_if_fail (frame != NULL, GST_FLOW_ERROR);
+
+  decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
+  priv = decoder->priv;
+
+  g_return_val_if_fail (decoder_class->decode_frame != NULL, GST_FLOW_ERROR);
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+
+  ret = gst_video_decoder_update_decode_pool (decoder);
+  if (ret != GST_FLOW_OK) {
+    gst_video_decoder_release_frame (decoder, frame);
+    goto done;
+  }
+
+  job = g_slice_new0 (DecodeJob);
+  job->frame = frame;
+
+  GST_LOG_OBJECT (decoder, "submitting frame %p", frame);
+
+  /* reverse playback collects the output of a whole GOP anyway */
+  ret = gst_frame_jobs_submit (&priv->decode_jobs, (GstFrameJob *) job,
+      decoder->input_segment.rate < 0.0);
+
+done:
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
+  return ret;
+}
+
 /* With stream lock, takes the frame reference */
 static GstFlowReturn
 gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
@@ -2813,6 +3084,10 @@ gst_video_decoder_set_output_state (GstVideoDecoder * decoder,
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
 
+  /* frames that are still being decoded belong to the old state, a failure
+   * to push them is returned from the next finish_frame() or chain */
+  gst_frame_jobs_finish_deferred (&decoder->priv->decode_jobs);
+
   GST_OBJECT_LOCK (decoder);
   /* Replace existing output state by new one */
   if (priv->output_state)
@@ -3140,6 +3415,33 @@ gst_video_decoder_negotiate (GstVideoDecoder * decoder)
   return ret;
 }
 
+/* With stream lock. Submitted frames hold buffers of the pool until they are
+ * finished, so never block on the pool while one of them can be output */
+static GstFlowReturn
+gst_video_decoder_acquire_buffer (GstVideoDecoder * decoder,
+    GstBuffer ** buffer)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstBufferPoolAcquireParams params = { 0, };
+  GstFlowReturn ret;
+  guint pending;
+
+  params.flags = GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT;
+
+  while ((pending = g_queue_get_length (&priv->decode_jobs.queue)) > 0) {
+    ret = gst_buffer_pool_acquire_buffer (priv->pool, buffer, &params);
+    if (ret != GST_FLOW_EOS)
+      return ret;
+
+    GST_DEBUG_OBJECT (decoder, "pool is empty, finishing oldest frame");
+    ret = gst_frame_jobs_finish (&priv->decode_jobs, pending - 1);
+    if (ret != GST_FLOW_OK)
+      return ret;
+  }
+
+  return gst_buffer_pool_acquire_buffer (priv->pool, buffer, NULL);
+}
+
 /**
  * gst_video_decoder_allocate_output_buffer:
  * @decoder: a #GstVideoDecoder
@@ -3172,7 +3474,7 @@ gst_video_decoder_allocate_output_buffer (GstVideoDecoder * decoder)
     }
   }
 
-  flow = gst_buffer_pool_acquire_buffer (decoder->priv->pool, &buffer, NULL);
+  flow = gst_video_decoder_acquire_buffer (decoder, &buffer);
 
   if (flow != GST_FLOW_OK) {
     GST_INFO_OBJECT (decoder, "couldn't allocate output buffer, flow %s",
@@ -3237,8 +3539,7 @@ gst_video_decoder_allocate_output_frame (GstVideoDecoder *
 
   GST_LOG_OBJECT (decoder, "alloc buffer size %d", num_bytes);
 
-  flow_ret = gst_buffer_pool_acquire_buffer (decoder->priv->pool,
-      &frame->output_buffer, NULL);
+  flow_ret = gst_video_decoder_acquire_buffer (decoder, &frame->output_buffer);
 
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
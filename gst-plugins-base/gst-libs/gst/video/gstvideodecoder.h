@@ -241,6 +241,14 @@ struct _GstVideoDecoder
  *                      Propose buffer allocation parameters for upstream elements.
  *                      Subclasses should chain up to the parent implementation to
  *                      invoke the default handler.
+ * @decode_frame:   Optional.
+ *                  Decodes a frame that was passed to
+ *                  gst_video_decoder_submit_frame(). Can be called from
+ *                  multiple threads at the same time for different frames.
+ *                  Should decode into the output buffer of the frame and
+ *                  return %GST_FLOW_OK, after which the base class finishes
+ *                  the frame. Other success values drop the frame, errors
+ *                  drop it and are returned upstream. Since: 1.2
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -289,8 +297,11 @@ struct _GstVideoDecoderClass
 
   gboolean      (*propose_allocation) (GstVideoDecoder *decoder, GstQuery * query);
 
+  GstFlowReturn (*decode_frame)   (GstVideoDecoder *decoder,
+				   GstVideoCodecFrame *frame);
+
   /*< private >*/
-  void         *padding[GST_PADDING_LARGE];
+  void         *padding[GST_PADDING_LARGE - 1];
 };
 
 GType    gst_video_decoder_get_type (void);
@@ -361,6 +372,9 @@ GstFlowReturn    gst_video_decoder_finish_frame (GstVideoDecoder *decoder,
 GstFlowReturn    gst_video_decoder_drop_frame (GstVideoDecoder *dec,
 					       GstVideoCodecFrame *frame);
 
+GstFlowReturn    gst_video_decoder_submit_frame (GstVideoDecoder *decoder,
+						 GstVideoCodecFrame *frame);
+
 void             gst_video_decoder_merge_tags (GstVideoDecoder *dec,
                                                const GstTagList *tags,
                                                GstTagMergeMode mode);
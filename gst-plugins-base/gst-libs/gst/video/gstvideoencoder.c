@@ -64,6 +64,13 @@
  *       downstream.
  *     </para></listitem>
  *     <listitem><para>
+ *       Encoders of frames that do not depend on other frames, like image
+ *       encoders, can instead pass the frame from @handle_frame to
+ *       @gst_video_encoder_submit_frame. The base class then calls
+ *       @encode_frame on up to #GstVideoEncoder:n-threads threads at the
+ *       same time and finishes the frames in the order they were submitted.
+ *     </para></listitem>
+ *     <listitem><para>
  *       If implemented, baseclass calls subclass @pre_push just prior to
  *       pushing to allow subclasses to modify some metadata on the buffer.
  *       If it returns GST_FLOW_OK, the buffer is pushed downstream.
@@ -123,6 +130,8 @@
 
 #include <string.h>
 
+#include "gst/gstframejobs-private.h"
+
 GST_DEBUG_CATEGORY (videoencoder_debug);
 #define GST_CAT_DEFAULT videoencoder_debug
 
@@ -165,6 +174,27 @@ struct _GstVideoEncoderPrivate
 
   GstTagList *tags;
   gboolean tags_changed;
+
+  /* frame threading */
+  guint n_threads;              /* OBJECT_LOCK */
+  GstFrameJobs encode_jobs;     /* STREAM_LOCK */
+  guint encode_pool_threads;    /* OBJECT_LOCK and STREAM_LOCK */
+};
+
+/* a frame that was passed to gst_video_encoder_submit_frame() */
+typedef struct
+{
+  GstFrameJob job;
+
+  GstVideoCodecFrame *frame;
+} EncodeJob;
+
+#define DEFAULT_N_THREADS 1
+
+enum
+{
+  PROP_0,
+  PROP_N_THREADS
 };
 
 typedef struct _ForcedKeyUnitEvent ForcedKeyUnitEvent;
@@ -201,6 +231,10 @@ static void gst_video_encoder_init (GstVideoEncoder * enc,
     GstVideoEncoderClass * klass);
 
 static void gst_video_encoder_finalize (GObject * object);
+static void gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_video_encoder_setcaps (GstVideoEncoder * enc,
     GstCaps * caps);
@@ -232,6 +266,13 @@ static gboolean gst_video_encoder_propose_allocation_default (GstVideoEncoder *
     encoder, GstQuery * query);
 static gboolean gst_video_encoder_negotiate_default (GstVideoEncoder * encoder);
 
+static GstFlowReturn gst_video_encoder_encode_job (GstFrameJob * job,
+    gpointer user_data);
+static GstFlowReturn gst_video_encoder_finish_job (GstFrameJob * job,
+    gpointer user_data);
+static void gst_video_encoder_discard_job (GstFrameJob * job,
+    gpointer user_data);
+
 /* we can't use G_DEFINE_ABSTRACT_TYPE because we need the klass in the _init
  * method to get to the padtemplates */
 GType
@@ -284,6 +325,23 @@ gst_video_encoder_class_init (GstVideoEncoderClass * klass)
   g_type_class_add_private (klass, sizeof (GstVideoEncoderPrivate));
 
   gobject_class->finalize = gst_video_encoder_finalize;
+  gobject_class->set_property = gst_video_encoder_set_property;
+  gobject_class->get_property = gst_video_encoder_get_property;
+
+  /**
+   * GstVideoEncoder:n-threads:
+   *
+   * The maximum number of frames that are encoded at the same time, 0 uses
+   * one thread per CPU. This only has an effect on encoders that implement
+   * the encode_frame method. Encoding on N threads adds up to N - 1 frames
+   * of latency.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_encoder_change_state);
@@ -359,6 +417,10 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
 
   priv = encoder->priv = GST_VIDEO_ENCODER_GET_PRIVATE (encoder);
 
+  priv->n_threads = DEFAULT_N_THREADS;
+  gst_frame_jobs_init (&priv->encode_jobs, gst_video_encoder_encode_job,
+      gst_video_encoder_finish_job, gst_video_encoder_discard_job, encoder);
+
   pad_template =
       gst_element_class_get_pad_template (GST_ELEMENT_CLASS (klass), "sink");
   g_return_if_fail (pad_template != NULL);
@@ -490,6 +552,11 @@ gst_video_encoder_drain (GstVideoEncoder * enc)
     return TRUE;
   }
 
+  /* submitted frames are finished before the subclass drains and may free
+   * the state they use. None is left running when this fails, a failure to
+   * push them is returned from the next frame. */
+  gst_frame_jobs_finish_deferred (&enc->priv->encode_jobs);
+
   if (enc_class->reset) {
     GST_DEBUG_OBJECT (enc, "requesting subclass to finish");
     ret = enc_class->reset (enc, TRUE);
@@ -872,9 +939,47 @@ gst_video_encoder_finalize (GObject * object)
     encoder->priv->allocator = NULL;
   }
 
+  gst_frame_jobs_clear (&encoder->priv->encode_jobs);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static void
+gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (encoder);
+      encoder->priv->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (encoder);
+      g_value_set_uint (value, encoder->priv->n_threads);
+      GST_OBJECT_UNLOCK (encoder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 static gboolean
 gst_video_encoder_push_event (GstVideoEncoder * encoder, GstEvent * event)
 {
@@ -927,6 +1032,14 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
       event = NULL;
       break;
     }
+    case GST_EVENT_FLUSH_STOP:
+    {
+      /* frames that are still being encoded are not pushed anymore */
+      GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+      gst_frame_jobs_discard (&encoder->priv->encode_jobs);
+      GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
+      break;
+    }
     case GST_EVENT_EOS:
     {
       GstFlowReturn flow_ret;
@@ -934,11 +1047,10 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
       GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
       encoder->priv->at_eos = TRUE;
 
-      if (encoder_class->finish) {
+      flow_ret = gst_frame_jobs_finish (&encoder->priv->encode_jobs, 0);
+
+      if (flow_ret == GST_FLOW_OK && encoder_class->finish)
         flow_ret = encoder_class->finish (encoder);
-      } else {
-        flow_ret = GST_FLOW_OK;
-      }
 
       ret = (flow_ret == GST_FLOW_OK);
       GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
@@ -1180,6 +1292,21 @@ gst_video_encoder_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
             GST_TIME_FORMAT " max %" GST_TIME_FORMAT, live,
             GST_TIME_ARGS (min_latency), GST_TIME_ARGS (max_latency));
 
+        /* submitted frames are output up to n - 1 frames later when
+         * encoding on n threads */
+        GST_VIDEO_ENCODER_STREAM_LOCK (enc);
+        if (priv->encode_pool_threads > 1 && priv->input_state
+            && priv->input_state->info.fps_n > 0) {
+          GstClockTime frames_latency = (priv->encode_pool_threads - 1) *
+              gst_util_uint64_scale (GST_SECOND,
+              priv->input_state->info.fps_d, priv->input_state->info.fps_n);
+
+          min_latency += frames_latency;
+          if (max_latency != GST_CLOCK_TIME_NONE)
+            max_latency += frames_latency;
+        }
+        GST_VIDEO_ENCODER_STREAM_UNLOCK (enc);
+
         GST_OBJECT_LOCK (enc);
         min_latency += priv->min_latency;
         if (enc->priv->max_latency == GST_CLOCK_TIME_NONE) {
@@ -1230,6 +1357,9 @@ gst_video_encoder_new_frame (GstVideoEncoder * encoder, GstBuffer * buf,
   frame->duration = duration;
   frame->abidata.ABI.ts = pts;
 
+  if (gst_buffer_get_video_repeat_meta (buf))
+    GST_VIDEO_CODEC_FRAME_FLAG_SET (frame, GST_VIDEO_CODEC_FRAME_FLAG_REPEAT);
+
   return frame;
 }
 
@@ -1351,6 +1481,9 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   ret = klass->handle_frame (encoder, frame);
 
+  if (ret == GST_FLOW_OK)
+    ret = gst_frame_jobs_take_deferred_ret (&priv->encode_jobs);
+
 done:
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -1395,6 +1528,9 @@ gst_video_encoder_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+      gst_frame_jobs_discard (&encoder->priv->encode_jobs);
+      GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
       gst_video_encoder_reset (encoder);
       if (encoder_class->stop && !encoder_class->stop (encoder))
         goto stop_failed;
@@ -1943,6 +2079,9 @@ done:
   if (frame)
     gst_video_encoder_release_frame (encoder, frame);
 
+  if (ret == GST_FLOW_OK)
+    ret = gst_frame_jobs_take_deferred_ret (&priv->encode_jobs);
+
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return ret;
@@ -1956,6 +2095,143 @@ no_output_state:
   }
 }
 
+static GstFlowReturn
+gst_video_encoder_encode_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoEncoder *encoder = user_data;
+  GstVideoEncoderClass *encoder_class = GST_VIDEO_ENCODER_GET_CLASS (encoder);
+
+  return encoder_class->encode_frame (encoder, ((EncodeJob *) job)->frame);
+}
+
+/* With stream lock, frees @job */
+static GstFlowReturn
+gst_video_encoder_finish_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoEncoder *encoder = user_data;
+  GstVideoCodecFrame *frame = ((EncodeJob *) job)->frame;
+  GstFlowReturn ret = job->ret;
+
+  if (ret == GST_FLOW_OK) {
+    ret = gst_video_encoder_finish_frame (encoder, frame);
+  } else {
+    GstFlowReturn finish_ret;
+
+    GST_DEBUG_OBJECT (encoder, "encoding frame %p failed: %s", frame,
+        gst_flow_get_name (ret));
+    /* finishing without output buffer drops the frame but still pushes
+     * its events */
+    gst_buffer_replace (&frame->output_buffer, NULL);
+    finish_ret = gst_video_encoder_finish_frame (encoder, frame);
+    /* other success values only drop the frame */
+    if (ret > GST_FLOW_OK)
+      ret = finish_ret;
+  }
+  g_slice_free (EncodeJob, (EncodeJob *) job);
+
+  return ret;
+}
+
+/* With stream lock, frees @job */
+static void
+gst_video_encoder_discard_job (GstFrameJob * job, gpointer user_data)
+{
+  GstVideoEncoder *encoder = user_data;
+  GstVideoCodecFrame *frame = ((EncodeJob *) job)->frame;
+
+  GST_LOG_OBJECT (encoder, "discarding frame %p", frame);
+  gst_video_encoder_release_frame (encoder, frame);
+  g_slice_free (EncodeJob, (EncodeJob *) job);
+}
+
+/* With stream lock. Makes the thread pool match the n-threads property */
+static GstFlowReturn
+gst_video_encoder_update_encode_pool (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstFlowReturn ret;
+  guint n_threads, old_threads;
+
+  GST_OBJECT_LOCK (encoder);
+  n_threads = priv->n_threads;
+  GST_OBJECT_UNLOCK (encoder);
+
+  /* the frames of the old pool are output first */
+  ret = gst_frame_jobs_set_n_threads (&priv->encode_jobs, &n_threads);
+
+  GST_OBJECT_LOCK (encoder);
+  old_threads = priv->encode_pool_threads;
+  priv->encode_pool_threads = n_threads;
+  GST_OBJECT_UNLOCK (encoder);
+
+  if (old_threads != n_threads) {
+    GST_DEBUG_OBJECT (encoder, "encoding frames on %u threads", n_threads);
+    if (old_threads > 1 || n_threads > 1)
+      gst_element_post_message (GST_ELEMENT_CAST (encoder),
+          gst_message_new_latency (GST_OBJECT_CAST (encoder)));
+  }
+
+  return ret;
+}
+
+/**
+ * gst_video_encoder_submit_frame:
+ * @encoder: a #GstVideoEncoder
+ * @frame: (transfer full): the #GstVideoCodecFrame to encode
+ *
+ * Encodes @frame with the @encode_frame method of the subclass, possibly on
+ * another thread while the next frames are handled. This can be called from
+ * @handle_frame instead of encoding the frame directly. The output state
+ * should be set before.
+ *
+ * The frames are finished in the order they were submitted, as soon as they
+ * are encoded and the streaming thread submits a new frame or drains. At
+ * most #GstVideoEncoder:n-threads frames are encoded at the same time.
+ *
+ * Returns: a #GstFlowReturn resulting from encoding or pushing the previous
+ *     frames downstream.
+ *
+ * Since: 1.2
+ */
+GstFlowReturn
+gst_video_encoder_submit_frame (GstVideoEncoder * encoder,
+    GstVideoCodecFrame * frame)
+{
+  GstVideoEncoderClass *encoder_class;
+  GstVideoEncoderPrivate *priv;
+  GstFlowReturn ret;
+  EncodeJob *job;
+
+  g_return_val_if_fail (GST_IS_VIDEO_ENCODER (encoder), GST_FLOW_ERROR);
+  g_return_val_if_fail (frame != NULL, GST_FLOW_ERROR);
+
+  encoder_class = GST_VIDEO_ENCODER_GET_CLASS (encoder);
+  priv = encoder->priv;
+
+  g_return_val_if_fail (encoder_class->encode_frame != NULL, GST_FLOW_ERROR);
+
+  GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+
+  ret = gst_video_encoder_update_encode_pool (encoder);
+  if (ret != GST_FLOW_OK) {
+    gst_video_encoder_release_frame (encoder, frame);
+    goto done;
+  }
+
+  job = g_slice_new0 (EncodeJob);
+  job->frame = frame;
+
+  GST_LOG_OBJECT (encoder, "submitting frame %p", frame);
+
+  ret = gst_frame_jobs_submit (&priv->encode_jobs, (GstFrameJob *) job,
+      FALSE);
+
+done:
+  GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
+
+  return ret;
+}
+
 /**
  * gst_video_encoder_get_output_state:
  * @encoder: a #GstVideoEncoder
@@ -2015,6 +2291,11 @@ gst_video_encoder_set_output_state (GstVideoEncoder * encoder, GstCaps * caps,
   state = _new_output_state (caps, reference);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
+
+  /* frames that are still being encoded belong to the old state, a failure
+   * to push them is returned from the next frame */
+  gst_frame_jobs_finish_deferred (&encoder->priv->encode_jobs);
+
   if (priv->output_state)
     gst_video_codec_state_unref (priv->output_state);
   priv->output_state = gst_video_codec_state_ref (state);
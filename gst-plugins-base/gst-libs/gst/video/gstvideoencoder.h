@@ -210,6 +210,14 @@ struct _GstVideoEncoder
  *                      Propose buffer allocation parameters for upstream elements.
  *                      Subclasses should chain up to the parent implementation to
  *                      invoke the default handler.
+ * @encode_frame:   Optional.
+ *                  Encodes a frame that was passed to
+ *                  gst_video_encoder_submit_frame(). Can be called from
+ *                  multiple threads at the same time for different frames.
+ *                  Should set the output buffer of the frame and return
+ *                  %GST_FLOW_OK, after which the base class finishes the
+ *                  frame. Other success values drop the frame, errors drop
+ *                  it and are returned upstream. Since: 1.2
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At minimum @handle_frame needs to be overridden, and @set_format
@@ -260,8 +268,11 @@ struct _GstVideoEncoderClass
   gboolean      (*propose_allocation) (GstVideoEncoder * encoder,
                                        GstQuery * query);
 
+  GstFlowReturn (*encode_frame) (GstVideoEncoder *encoder,
+				 GstVideoCodecFrame *frame);
+
   /*< private >*/
-  gpointer       _gst_reserved[GST_PADDING_LARGE];
+  gpointer       _gst_reserved[GST_PADDING_LARGE - 1];
 };
 
 GType                gst_video_encoder_get_type (void);
@@ -290,6 +301,9 @@ GstFlowReturn        gst_video_encoder_allocate_output_frame  (GstVideoEncoder *
 GstFlowReturn        gst_video_encoder_finish_frame (GstVideoEncoder *encoder,
 						     GstVideoCodecFrame *frame);
 
+GstFlowReturn        gst_video_encoder_submit_frame (GstVideoEncoder *encoder,
+						     GstVideoCodecFrame *frame);
+
 GstCaps *            gst_video_encoder_proxy_getcaps (GstVideoEncoder * enc,
 						      GstCaps         * caps,
                                                       GstCaps         * filter);
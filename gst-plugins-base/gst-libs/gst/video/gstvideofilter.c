@@ -30,6 +30,12 @@
  * The videofilter will by default enable QoS on the parent GstBaseTransform
  * to implement frame dropping.
  * </para>
+ * <para>
+ * Subclasses that implement the transform_frame_slice or
+ * transform_frame_ip_slice methods can process a frame in horizontal bands
+ * on multiple threads. The number of threads is configured with the
+ * #GstVideoFilter:n-threads property.
+ * </para>
  * </refsect2>
  */
 
@@ -42,10 +48,42 @@
 #include <gst/video/video.h>
 #include <gst/video/gstvideometa.h>
 #include <gst/video/gstvideopool.h>
+#include <gst/video/video-slice.h>
 
 GST_DEBUG_CATEGORY_STATIC (gst_video_filter_debug);
 #define GST_CAT_DEFAULT gst_video_filter_debug
 
+#define GST_VIDEO_FILTER_GET_PRIVATE(obj)  \
+   (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_VIDEO_FILTER, GstVideoFilterPrivate))
+
+#define DEFAULT_N_THREADS 1
+
+enum
+{
+  PROP_0,
+  PROP_N_THREADS
+};
+
+struct _GstVideoFilterPrivate
+{
+  /* with LOCK */
+  guint n_threads;
+
+  /* only used from the streaming thread */
+  GstVideoSliceRunner *runner;
+  guint runner_threads;
+};
+
+typedef struct
+{
+  GstVideoFilter *filter;
+  GstVideoFilterClass *fclass;
+  GstVideoFrame *in_frame;
+  /* NULL when transforming in place */
+  GstVideoFrame *out_frame;
+  volatile gint ret;
+} GstVideoFilterSlices;
+
 #define gst_video_filter_parent_class parent_class
 G_DEFINE_ABSTRACT_TYPE (GstVideoFilter, gst_video_filter,
     GST_TYPE_BASE_TRANSFORM);
@@ -227,9 +265,10 @@ gst_video_filter_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   if (res) {
     filter->in_info = in_info;
     filter->out_info = out_info;
-    if (fclass->transform_frame == NULL)
+    if (fclass->transform_frame == NULL && fclass->transform_frame_slice == NULL)
       gst_base_transform_set_in_place (trans, TRUE);
-    if (fclass->transform_frame_ip == NULL)
+    if (fclass->transform_frame_ip == NULL
+        && fclass->transform_frame_ip_slice == NULL)
       GST_BASE_TRANSFORM_CLASS (fclass)->transform_ip_on_passthrough = FALSE;
   }
   filter->negotiated = res;
@@ -245,6 +284,81 @@ invalid_caps:
   }
 }
 
+/* called with the streaming lock */
+static GstVideoSliceRunner *
+gst_video_filter_get_runner (GstVideoFilter * filter)
+{
+  GstVideoFilterPrivate *priv = filter->priv;
+  guint n_threads;
+
+  GST_OBJECT_LOCK (filter);
+  n_threads = priv->n_threads;
+  GST_OBJECT_UNLOCK (filter);
+
+  if (priv->runner == NULL || priv->runner_threads != n_threads) {
+    if (priv->runner)
+      gst_video_slice_runner_free (priv->runner);
+    priv->runner = gst_video_slice_runner_new (n_threads);
+    priv->runner_threads = n_threads;
+
+    GST_DEBUG_OBJECT (filter, "processing slices with %u threads",
+        gst_video_slice_runner_get_n_threads (priv->runner));
+  }
+  return priv->runner;
+}
+
+static void
+gst_video_filter_slice_func (gpointer user_data, guint slice, guint n_slices)
+{
+  GstVideoFilterSlices *slices = user_data;
+  GstFlowReturn res;
+  guint y, height;
+
+  /* split on the lines we produce */
+  if (slices->out_frame)
+    gst_video_slice_get_lines (&slices->out_frame->info, slice, n_slices, &y,
+        &height);
+  else
+    gst_video_slice_get_lines (&slices->in_frame->info, slice, n_slices, &y,
+        &height);
+
+  if (height == 0)
+    return;
+
+  if (slices->out_frame)
+    res = slices->fclass->transform_frame_slice (slices->filter,
+        slices->in_frame, slices->out_frame, y, height);
+  else
+    res = slices->fclass->transform_frame_ip_slice (slices->filter,
+        slices->in_frame, y, height);
+
+  /* keep the first error */
+  if (G_UNLIKELY (res != GST_FLOW_OK))
+    g_atomic_int_compare_and_exchange (&slices->ret, GST_FLOW_OK, res);
+}
+
+static GstFlowReturn
+gst_video_filter_transform_slices (GstVideoFilter * filter,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame)
+{
+  GstVideoSliceRunner *runner;
+  GstVideoFilterSlices slices;
+
+  runner = gst_video_filter_get_runner (filter);
+
+  slices.filter = filter;
+  slices.fclass = GST_VIDEO_FILTER_GET_CLASS (filter);
+  slices.in_frame = in_frame;
+  slices.out_frame = out_frame;
+  slices.ret = GST_FLOW_OK;
+
+  gst_video_slice_runner_run (runner,
+      gst_video_slice_runner_get_n_threads (runner),
+      gst_video_filter_slice_func, &slices);
+
+  return slices.ret;
+}
+
 static GstFlowReturn
 gst_video_filter_transform (GstBaseTransform * trans, GstBuffer * inbuf,
     GstBuffer * outbuf)
@@ -257,7 +371,7 @@ gst_video_filter_transform (GstBaseTransform * trans, GstBuffer * inbuf,
     goto unknown_format;
 
   fclass = GST_VIDEO_FILTER_GET_CLASS (filter);
-  if (fclass->transform_frame) {
+  if (fclass->transform_frame || fclass->transform_frame_slice) {
     GstVideoFrame in_frame, out_frame;
 
     if (!gst_video_frame_map (&in_frame, &filter->in_info, inbuf, GST_MAP_READ))
@@ -267,7 +381,10 @@ gst_video_filter_transform (GstBaseTransform * trans, GstBuffer * inbuf,
             GST_MAP_WRITE))
       goto invalid_buffer;
 
-    res = fclass->transform_frame (filter, &in_frame, &out_frame);
+    if (fclass->transform_frame_slice)
+      res = gst_video_filter_transform_slices (filter, &in_frame, &out_frame);
+    else
+      res = fclass->transform_frame (filter, &in_frame, &out_frame);
 
     gst_video_frame_unmap (&out_frame);
     gst_video_frame_unmap (&in_frame);
@@ -304,19 +421,29 @@ gst_video_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
     goto unknown_format;
 
   fclass = GST_VIDEO_FILTER_GET_CLASS (filter);
-  if (fclass->transform_frame_ip) {
+  if (fclass->transform_frame_ip || fclass->transform_frame_ip_slice) {
     GstVideoFrame frame;
     GstMapFlags flags;
 
     flags = GST_MAP_READ;
 
-    if (!gst_base_transform_is_passthrough (trans))
+    if (!gst_base_transform_is_passthrough (trans)) {
+      GstVideoRepeatMeta *meta;
+
       flags |= GST_MAP_WRITE;
 
+      /* the image is changed, it might not repeat the previous one anymore */
+      if ((meta = gst_buffer_get_video_repeat_meta (buf)))
+        gst_buffer_remove_meta (buf, (GstMeta *) meta);
+    }
+
     if (!gst_video_frame_map (&frame, &filter->in_info, buf, flags))
       goto invalid_buffer;
 
-    res = fclass->transform_frame_ip (filter, &frame);
+    if (fclass->transform_frame_ip_slice)
+      res = gst_video_filter_transform_slices (filter, &frame, NULL);
+    else
+      res = fclass->transform_frame_ip (filter, &frame);
 
     gst_video_frame_unmap (&frame);
   } else {
@@ -341,15 +468,84 @@ invalid_buffer:
   }
 }
 
+static void
+gst_video_filter_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (filter);
+      filter->priv->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (filter);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_filter_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER (object);
+
+  switch (prop_id) {
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (filter);
+      g_value_set_uint (value, filter->priv->n_threads);
+      GST_OBJECT_UNLOCK (filter);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_filter_finalize (GObject * object)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER (object);
+
+  if (filter->priv->runner)
+    gst_video_slice_runner_free (filter->priv->runner);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_video_filter_class_init (GstVideoFilterClass * g_class)
 {
+  GObjectClass *gobject_class;
   GstBaseTransformClass *trans_class;
   GstVideoFilterClass *klass;
 
   klass = (GstVideoFilterClass *) g_class;
+  gobject_class = (GObjectClass *) klass;
   trans_class = (GstBaseTransformClass *) klass;
 
+  g_type_class_add_private (klass, sizeof (GstVideoFilterPrivate));
+
+  gobject_class->set_property = gst_video_filter_set_property;
+  gobject_class->get_property = gst_video_filter_get_property;
+  gobject_class->finalize = gst_video_filter_finalize;
+
+  /**
+   * GstVideoFilter:n-threads:
+   *
+   * The maximum number of threads used to process a frame, 0 uses one thread
+   * per CPU. This only has an effect on filters that implement the slice
+   * transform methods.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   trans_class->set_caps = GST_DEBUG_FUNCPTR (gst_video_filter_set_caps);
   trans_class->propose_allocation =
       GST_DEBUG_FUNCPTR (gst_video_filter_propose_allocation);
@@ -373,6 +569,9 @@ gst_video_filter_init (GstVideoFilter * instance)
 
   GST_DEBUG_OBJECT (videofilter, "gst_video_filter_init");
 
+  videofilter->priv = GST_VIDEO_FILTER_GET_PRIVATE (videofilter);
+  videofilter->priv->n_threads = DEFAULT_N_THREADS;
+
   videofilter->negotiated = FALSE;
   /* enable QoS */
   gst_base_transform_set_qos_enabled (GST_BASE_TRANSFORM (videofilter), TRUE);
@@ -28,6 +28,7 @@ G_BEGIN_DECLS
 
 typedef struct _GstVideoFilter GstVideoFilter;
 typedef struct _GstVideoFilterClass GstVideoFilterClass;
+typedef struct _GstVideoFilterPrivate GstVideoFilterPrivate;
 
 #define GST_TYPE_VIDEO_FILTER \
   (gst_video_filter_get_type())
@@ -51,7 +52,9 @@ struct _GstVideoFilter {
   GstVideoInfo out_info;
 
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING];
+  GstVideoFilterPrivate *priv;
+
+  gpointer _gst_reserved[GST_PADDING - 1];
 };
 
 /**
@@ -60,8 +63,22 @@ struct _GstVideoFilter {
  * @set_info: function to be called with the negotiated caps and video infos
  * @transform_frame: transform a video frame
  * @transform_frame_ip: transform a video frame in place
+ * @transform_frame_slice: transform the lines @y to @y + @height of a video
+ *   frame. Called concurrently from multiple threads with disjoint line
+ *   ranges when the filter is configured with more than one thread, no locks
+ *   are held. Since 1.2
+ * @transform_frame_ip_slice: transform the lines @y to @y + @height of a video
+ *   frame in place. Called concurrently from multiple threads with disjoint
+ *   line ranges when the filter is configured with more than one thread, no
+ *   locks are held. Since 1.2
  *
  * The video filter class structure.
+ *
+ * Subclasses that can process independent horizontal bands of a frame
+ * should implement @transform_frame_slice and @transform_frame_ip_slice
+ * instead of @transform_frame and @transform_frame_ip. The bands are aligned
+ * to the vertical chroma subsampling of the format. The number of threads is
+ * configured with the #GstVideoFilter:n-threads property.
  */
 struct _GstVideoFilterClass {
   GstBaseTransformClass parent_class;
@@ -75,8 +92,15 @@ struct _GstVideoFilterClass {
                                        GstVideoFrame *inframe, GstVideoFrame *outframe);
   GstFlowReturn (*transform_frame_ip) (GstVideoFilter *trans, GstVideoFrame *frame);
 
+  /* transform a band of lines, called from multiple threads */
+  GstFlowReturn (*transform_frame_slice)    (GstVideoFilter *filter,
+                                             GstVideoFrame *inframe, GstVideoFrame *outframe,
+                                             guint y, guint height);
+  GstFlowReturn (*transform_frame_ip_slice) (GstVideoFilter *trans, GstVideoFrame *frame,
+                                             guint y, guint height);
+
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING];
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 GType gst_video_filter_get_type (void);
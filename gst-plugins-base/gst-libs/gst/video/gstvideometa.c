@@ -370,6 +370,83 @@ gst_video_crop_meta_get_info (void)
   return video_crop_meta_info;
 }
 
+static gboolean
+gst_video_repeat_meta_transform (GstBuffer * dest, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  GstVideoRepeatMeta *smeta = (GstVideoRepeatMeta *) meta;
+
+  /* a scaled or otherwise transformed repeat still repeats the previous
+   * buffer when it is transformed in the same way */
+  GST_DEBUG ("copy repeat metadata");
+  gst_buffer_add_video_repeat_meta (dest, smeta->repeat_of, smeta->count);
+
+  return TRUE;
+}
+
+GType
+gst_video_repeat_meta_api_get_type (void)
+{
+  static volatile GType type = 0;
+  static const gchar *tags[] = { "size", "orientation", NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type = gst_meta_api_type_register ("GstVideoRepeatMetaAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+const GstMetaInfo *
+gst_video_repeat_meta_get_info (void)
+{
+  static const GstMetaInfo *video_repeat_meta_info = NULL;
+
+  if (g_once_init_enter (&video_repeat_meta_info)) {
+    const GstMetaInfo *meta =
+        gst_meta_register (GST_VIDEO_REPEAT_META_API_TYPE,
+        "GstVideoRepeatMeta", sizeof (GstVideoRepeatMeta),
+        (GstMetaInitFunction) NULL, (GstMetaFreeFunction) NULL,
+        gst_video_repeat_meta_transform);
+    g_once_init_leave (&video_repeat_meta_info, meta);
+  }
+  return video_repeat_meta_info;
+}
+
+/**
+ * gst_buffer_add_video_repeat_meta:
+ * @buffer: a #GstBuffer
+ * @repeat_of: the offset of the buffer that is repeated
+ * @count: how many times that buffer has been repeated, including @buffer
+ *
+ * Marks @buffer as a repeat of the image of the buffer with offset
+ * @repeat_of by attaching a #GstVideoRepeatMeta. An existing
+ * #GstVideoRepeatMeta on @buffer is updated instead.
+ *
+ * Returns: (transfer none): the #GstVideoRepeatMeta on @buffer.
+ *
+ * Since: 1.2
+ */
+GstVideoRepeatMeta *
+gst_buffer_add_video_repeat_meta (GstBuffer * buffer, guint64 repeat_of,
+    guint count)
+{
+  GstVideoRepeatMeta *meta;
+
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (count > 0, NULL);
+
+  meta = gst_buffer_get_video_repeat_meta (buffer);
+  if (meta == NULL)
+    meta = (GstVideoRepeatMeta *) gst_buffer_add_meta (buffer,
+        GST_VIDEO_REPEAT_META_INFO, NULL);
+
+  meta->repeat_of = repeat_of;
+  meta->count = count;
+
+  return meta;
+}
+
 /**
  * gst_video_meta_transform_scale_get_quark:
  *
@@ -117,6 +117,42 @@ const GstMetaInfo * gst_video_crop_meta_get_info (void);
 #define gst_buffer_get_video_crop_meta(b) ((GstVideoCropMeta*)gst_buffer_get_meta((b),GST_VIDEO_CROP_META_API_TYPE))
 #define gst_buffer_add_video_crop_meta(b) ((GstVideoCropMeta*)gst_buffer_add_meta((b),GST_VIDEO_CROP_META_INFO, NULL))
 
+#define GST_VIDEO_REPEAT_META_API_TYPE  (gst_video_repeat_meta_api_get_type())
+#define GST_VIDEO_REPEAT_META_INFO  (gst_video_repeat_meta_get_info())
+typedef struct _GstVideoRepeatMeta GstVideoRepeatMeta;
+
+/**
+ * GstVideoRepeatMeta:
+ * @meta: parent #GstMeta
+ * @repeat_of: the offset of the buffer that is repeated
+ * @count: how many times that buffer has been repeated so far, including
+ *     this buffer
+ *
+ * Extra buffer metadata marking a buffer whose image is identical to the
+ * buffer preceding it in the stream, which had the offset @repeat_of or was
+ * itself a repeat of it. Encoders and sinks can skip the work for such a
+ * buffer.
+ *
+ * Elements that change the image differently for each buffer have to remove
+ * this metadata. #GstVideoFilter removes it from the buffers it modifies in
+ * place.
+ *
+ * Since: 1.2
+ */
+struct _GstVideoRepeatMeta {
+  GstMeta       meta;
+
+  guint64       repeat_of;
+  guint         count;
+};
+
+GType gst_video_repeat_meta_api_get_type (void);
+const GstMetaInfo * gst_video_repeat_meta_get_info (void);
+
+#define gst_buffer_get_video_repeat_meta(b) ((GstVideoRepeatMeta*)gst_buffer_get_meta((b),GST_VIDEO_REPEAT_META_API_TYPE))
+GstVideoRepeatMeta * gst_buffer_add_video_repeat_meta (GstBuffer * buffer,
+                                                       guint64 repeat_of, guint count);
+
 /* video metadata transforms */
 
 GQuark gst_video_meta_transform_scale_get_quark (void);
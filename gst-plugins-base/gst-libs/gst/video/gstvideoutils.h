@@ -74,6 +74,8 @@ struct _GstVideoCodecState
  * @GST_VIDEO_CODEC_FRAME_FLAG_SYNC_POINT: is the frame a synchronization point (keyframe)
  * @GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME: should the output frame be made a keyframe
  * @GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME_HEADERS: should the encoder output stream headers
+ * @GST_VIDEO_CODEC_FRAME_FLAG_REPEAT: the input image repeats the previous
+ *     frame's image (Since: 1.2)
  *
  * Flags for #GstVideoCodecFrame
  */
@@ -82,7 +84,8 @@ typedef enum
   GST_VIDEO_CODEC_FRAME_FLAG_DECODE_ONLY            = (1<<0),
   GST_VIDEO_CODEC_FRAME_FLAG_SYNC_POINT             = (1<<1),
   GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME         = (1<<2),
-  GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME_HEADERS = (1<<3)
+  GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME_HEADERS = (1<<3),
+  GST_VIDEO_CODEC_FRAME_FLAG_REPEAT                 = (1<<4)
 } GstVideoCodecFrameFlags;
 
 /**
@@ -191,6 +194,22 @@ typedef enum
 #define GST_VIDEO_CODEC_FRAME_SET_FORCE_KEYFRAME_HEADERS(frame)     (GST_VIDEO_CODEC_FRAME_FLAG_SET(frame, GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME_HEADERS))
 #define GST_VIDEO_CODEC_FRAME_UNSET_FORCE_KEYFRAME_HEADERS(frame)   (GST_VIDEO_CODEC_FRAME_FLAG_UNSET(frame, GST_VIDEO_CODEC_FRAME_FLAG_FORCE_KEYFRAME_HEADERS))
 
+/**
+ * GST_VIDEO_CODEC_FRAME_IS_REPEAT:
+ * @frame: a #GstVideoCodecFrame
+ *
+ * Tests if the input buffer carries a #GstVideoRepeatMeta, i.e. its image is
+ * the same as the one of the frame before it. Encoders can encode such a
+ * frame as a skipped frame or repeat the previous output, unless a keyframe
+ * is forced.
+ *
+ * Applies only to frames provided to encoders. Decoders can safely
+ * ignore this field.
+ *
+ * Since: 1.2
+ */
+#define GST_VIDEO_CODEC_FRAME_IS_REPEAT(frame)          (GST_VIDEO_CODEC_FRAME_FLAG_IS_SET(frame, GST_VIDEO_CODEC_FRAME_FLAG_REPEAT))
+
 /**
  * GstVideoCodecFrame:
  * @pts: Presentation timestamp
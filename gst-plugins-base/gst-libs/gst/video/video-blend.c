@@ -333,11 +333,20 @@ gst_video_blend (GstVideoFrame * dest,
   /* Mainloop doing the needed conversions, and blending */
   for (i = y; i < y + src_height; i++) {
 
-    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
-        0, i, dest_width);
     sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
         xoff, i - y, src_width - xoff);
 
+    /* nothing to blend on fully transparent lines */
+    for (j = 0; j < src_width * 4; j += 4) {
+      if (tmpsrcline[j] != 0)
+        break;
+    }
+    if (j == src_width * 4)
+      continue;
+
+    dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data, dest->info.stride,
+        0, i, dest_width);
+
     matrix (tmpsrcline, src_width);
 
     tmpdestline += 4 * x;
@@ -144,11 +144,19 @@ struct _GstVideoOverlayRectangle
   GMutex lock;
 
   GList *scaled_rectangles;
+
+  /* pixels prepared for gst_video_overlay_composition_blend(), per unpack
+   * format */
+  GList *blend_caches;
 };
 
 #define GST_RECTANGLE_LOCK(rect)   g_mutex_lock(&rect->lock)
 #define GST_RECTANGLE_UNLOCK(rect) g_mutex_unlock(&rect->lock)
 
+static GstBuffer *gst_video_overlay_rectangle_get_pixels_raw_internal
+    (GstVideoOverlayRectangle * rectangle, GstVideoOverlayFormatFlags flags,
+    gboolean unscaled, GstVideoFormat wanted_format);
+
 /* --------------------------- utility functions --------------------------- */
 
 #ifndef GST_DISABLE_GST_DEBUG
@@ -429,6 +437,284 @@ gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
       GST_VIDEO_INFO_HEIGHT (&r->info) != r->render_height);
 }
 
+/* Pixels of a rectangle prepared for blending onto video frames that unpack
+ * to @format (AYUV or ARGB): scaled to the render size, with the global alpha
+ * applied and the color components premultiplied with the alpha. Kept in the
+ * rectangle until its pixels, global alpha or render size change, blending
+ * holds a reference so it can be replaced meanwhile. */
+typedef struct
+{
+  volatile gint refcount;
+
+  GstVideoFormat format;
+  guint width, height;
+  guint seq_num;
+
+  /* per pixel 255 - alpha and the three premultiplied components */
+  guint16 *pixels;
+  /* per line the first and last + 1 non-transparent pixel */
+  guint *spans;
+} GstVideoOverlayRectangleCache;
+
+static GstVideoOverlayRectangleCache *
+gst_video_overlay_rectangle_cache_ref (GstVideoOverlayRectangleCache * cache)
+{
+  g_atomic_int_inc (&cache->refcount);
+
+  return cache;
+}
+
+static void
+gst_video_overlay_rectangle_cache_unref (GstVideoOverlayRectangleCache * cache)
+{
+  if (!g_atomic_int_dec_and_test (&cache->refcount))
+    return;
+
+  g_free (cache->pixels);
+  g_free (cache->spans);
+  g_slice_free (GstVideoOverlayRectangleCache, cache);
+}
+
+static GstVideoOverlayRectangleCache *
+gst_video_overlay_rectangle_cache_new (GstVideoOverlayRectangle * rect,
+    GstVideoFormat format)
+{
+  GstVideoOverlayRectangleCache *cache;
+  GstVideoFormat pixel_format;
+  GstVideoInfo info;
+  GstVideoFrame frame;
+  GstBuffer *pixels;
+  guint i, j, width, height, stride;
+  guint8 *data;
+
+  if (format == GST_VIDEO_FORMAT_ARGB)
+    pixel_format = GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB;
+  else
+    pixel_format = GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV;
+
+  /* scaled and converted, with straight alpha and the global alpha applied,
+   * these are cached in the rectangle as well */
+  pixels = gst_video_overlay_rectangle_get_pixels_raw_internal (rect,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE, FALSE, pixel_format);
+
+  width = rect->render_width;
+  height = rect->render_height;
+
+  gst_video_info_init (&info);
+  gst_video_info_set_format (&info, pixel_format, width, height);
+  if (!gst_video_frame_map (&frame, &info, pixels, GST_MAP_READ))
+    return NULL;
+
+  cache = g_slice_new (GstVideoOverlayRectangleCache);
+  cache->refcount = 1;
+  cache->format = format;
+  cache->width = width;
+  cache->height = height;
+  cache->seq_num = rect->seq_num;
+  cache->pixels = g_new (guint16, width * height * 4);
+  cache->spans = g_new (guint, height * 2);
+
+  data = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0);
+  stride = GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0);
+
+  for (i = 0; i < height; i++) {
+    const guint8 *src = data + i * stride;
+    guint16 *dest = cache->pixels + i * width * 4;
+    guint first = width, last = 0;
+
+    for (j = 0; j < width; j++) {
+      guint32 p;
+      guint a;
+
+      if (pixel_format == GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_YUV)
+        p = GST_READ_UINT32_BE (src + j * 4);
+      else
+        /* native endian ARGB */
+        p = *(const guint32 *) (src + j * 4);
+
+      a = p >> 24;
+      dest[j * 4 + 0] = 255 - a;
+      dest[j * 4 + 1] = ((p >> 16) & 0xff) * a;
+      dest[j * 4 + 2] = ((p >> 8) & 0xff) * a;
+      dest[j * 4 + 3] = (p & 0xff) * a;
+
+      if (a != 0) {
+        if (first == width)
+          first = j;
+        last = j + 1;
+      }
+    }
+    if (first == width)
+      first = last = 0;
+    cache->spans[i * 2 + 0] = first;
+    cache->spans[i * 2 + 1] = last;
+  }
+  gst_video_frame_unmap (&frame);
+
+  GST_LOG ("prepared rectangle %p for blending: %ux%u, format %s", rect,
+      width, height, gst_video_format_to_string (format));
+
+  return cache;
+}
+
+static gboolean
+gst_video_overlay_rectangle_cache_is_valid (GstVideoOverlayRectangleCache *
+    cache, GstVideoOverlayRectangle * rect)
+{
+  return cache->seq_num == rect->seq_num &&
+      cache->width == rect->render_width &&
+      cache->height == rect->render_height;
+}
+
+/* Returns the pixels of @rect prepared for blending onto frames that unpack to
+ * @format, creating them on first use. The caller owns a reference to the
+ * returned cache. */
+static GstVideoOverlayRectangleCache *
+gst_video_overlay_rectangle_get_cache (GstVideoOverlayRectangle * rect,
+    GstVideoFormat format)
+{
+  GstVideoOverlayRectangleCache *cache = NULL, *new_cache;
+  GList *l;
+
+  GST_RECTANGLE_LOCK (rect);
+  for (l = rect->blend_caches; l != NULL; l = l->next) {
+    GstVideoOverlayRectangleCache *c = l->data;
+
+    if (c->format == format && gst_video_overlay_rectangle_cache_is_valid (c,
+            rect)) {
+      cache = c;
+      break;
+    }
+  }
+  if (cache != NULL)
+    gst_video_overlay_rectangle_cache_ref (cache);
+  GST_RECTANGLE_UNLOCK (rect);
+
+  if (cache != NULL)
+    return cache;
+
+  /* create it without holding the lock, getting the pixels takes it */
+  new_cache = gst_video_overlay_rectangle_cache_new (rect, format);
+  if (new_cache == NULL)
+    return NULL;
+
+  GST_RECTANGLE_LOCK (rect);
+  l = rect->blend_caches;
+  while (l != NULL) {
+    GstVideoOverlayRectangleCache *c = l->data;
+    GList *next = l->next;
+
+    if (c->format == format) {
+      if (cache == NULL && gst_video_overlay_rectangle_cache_is_valid (c, rect)) {
+        /* someone else was faster */
+        cache = c;
+      } else if (!gst_video_overlay_rectangle_cache_is_valid (c, rect)) {
+        gst_video_overlay_rectangle_cache_unref (c);
+        rect->blend_caches = g_list_delete_link (rect->blend_caches, l);
+      }
+    }
+    l = next;
+  }
+  if (cache == NULL) {
+    rect->blend_caches = g_list_prepend (rect->blend_caches, new_cache);
+    cache = new_cache;
+    new_cache = NULL;
+  }
+  gst_video_overlay_rectangle_cache_ref (cache);
+  GST_RECTANGLE_UNLOCK (rect);
+
+  if (new_cache)
+    gst_video_overlay_rectangle_cache_unref (new_cache);
+
+  return cache;
+}
+
+/* Points @data to the planes of @frame starting at pixel @x, which is a
+ * multiple of 8 so that it starts a whole group of (subsampled) pixels.
+ * Returns FALSE for formats whose pixels cannot be addressed like that. */
+static gboolean
+gst_video_overlay_get_plane_data_at (GstVideoFrame * frame, gint x,
+    gpointer data[GST_VIDEO_MAX_PLANES])
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  gint i, n_comps;
+
+  for (i = 0; i < GST_VIDEO_MAX_PLANES; i++)
+    data[i] = frame->data[i];
+
+  if (x == 0)
+    return TRUE;
+  if (GST_VIDEO_FORMAT_INFO_IS_COMPLEX (finfo))
+    return FALSE;
+
+  /* the other components of palette formats refer to the palette */
+  n_comps = GST_VIDEO_FORMAT_INFO_HAS_PALETTE (finfo) ? 1 :
+      GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo);
+  for (i = 0; i < n_comps; i++) {
+    gint plane = GST_VIDEO_FORMAT_INFO_PLANE (finfo, i);
+    gint pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, i);
+
+    if (pstride == 0)
+      return FALSE;
+    data[plane] = (guint8 *) frame->data[plane] +
+        GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (finfo, i, x) * pstride;
+  }
+  return TRUE;
+}
+
+/* Blends the prepared pixels in @cache onto @dest at @x, @y. Only the lines
+ * and the parts of the lines with non-transparent pixels are unpacked, blended
+ * and packed again. @tmpline must have room for a line of @dest in the unpack
+ * format. */
+static void
+gst_video_overlay_rectangle_cache_blend (GstVideoOverlayRectangleCache * cache,
+    GstVideoFrame * dest, gint x, gint y, guint8 * tmpline)
+{
+  const GstVideoFormatInfo *dinfo = dest->info.finfo;
+  gpointer data[GST_VIDEO_MAX_PLANES];
+  gint dest_width, dest_height, i, j;
+
+  dest_width = GST_VIDEO_FRAME_WIDTH (dest);
+  dest_height = GST_VIDEO_FRAME_HEIGHT (dest);
+
+  for (i = MAX (y, 0); i < MIN (y + (gint) cache->height, dest_height); i++) {
+    const guint *span = &cache->spans[(i - y) * 2];
+    const guint16 *src;
+    guint8 *d;
+    gint x0, x1, start, end;
+
+    x0 = MAX (x + (gint) span[0], 0);
+    x1 = MIN (x + (gint) span[1], dest_width);
+    if (x0 >= x1)
+      continue;
+
+    /* unpack and pack whole groups of (subsampled) pixels around the
+     * visible part of the line */
+    start = GST_ROUND_DOWN_8 (x0);
+    end = MIN (GST_ROUND_UP_8 (x1), dest_width);
+    if (!gst_video_overlay_get_plane_data_at (dest, start, data)) {
+      start = 0;
+      gst_video_overlay_get_plane_data_at (dest, 0, data);
+    }
+
+    dinfo->unpack_func (dinfo, 0, tmpline, data, dest->info.stride, 0, i,
+        end - start);
+
+    src = cache->pixels + ((i - y) * cache->width + (x0 - x)) * 4;
+    d = tmpline + (x0 - start) * 4;
+    for (j = 0; j < (x1 - x0) * 4; j += 4) {
+      guint inv_alpha = src[j];
+
+      d[j + 1] = (src[j + 1] + d[j + 1] * inv_alpha) / 255;
+      d[j + 2] = (src[j + 2] + d[j + 2] * inv_alpha) / 255;
+      d[j + 3] = (src[j + 3] + d[j + 3] * inv_alpha) / 255;
+    }
+
+    dinfo->pack_func (dinfo, 0, tmpline, end - start, data,
+        dest->info.stride, dest->info.chroma_site, i, end - start);
+  }
+}
+
 /**
  * gst_video_overlay_composition_blend:
  * @comp: a #GstVideoOverlayComposition
@@ -437,6 +723,10 @@ gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
  * Blends the overlay rectangles in @comp on top of the raw video data
  * contained in @video_buf. The data in @video_buf must be writable and
  * mapped appropriately.
+ *
+ * The rectangles keep their pixels prepared for blending onto the format of
+ * @video_buf, so blending rectangles that did not change since the last call
+ * only needs to touch the non-transparent parts of the video.
  */
 /* FIXME: formats with more than 8 bit per component which get unpacked into
  * ARGB64 or AYUV64 (such as v210, v216, UYVP, GRAY16_LE and GRAY16_BE)
@@ -454,6 +744,9 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   gboolean ret = TRUE;
   guint n, num;
   int w, h;
+  const GstVideoFormatInfo *unpackinfo;
+  GstVideoFormat cache_format = GST_VIDEO_FORMAT_UNKNOWN;
+  guint8 *tmpline = NULL;
 
   g_return_val_if_fail (GST_IS_VIDEO_OVERLAY_COMPOSITION (comp), FALSE);
   g_return_val_if_fail (video_buf != NULL, FALSE);
@@ -466,8 +759,21 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   GST_LOG ("Blending composition %p with %u rectangles onto video buffer %p "
       "(%ux%u, format %u)", comp, num, video_buf, w, h, fmt);
 
+  /* the prepared pixels can be used for all formats that unpack to 8 bit
+   * AYUV or ARGB, others go through gst_video_blend() */
+  unpackinfo = gst_video_format_get_info (video_buf->info.finfo->unpack_format);
+  if (unpackinfo != NULL && !(GST_VIDEO_INFO_FLAGS (&video_buf->info) &
+          GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA)) {
+    if (GST_VIDEO_FORMAT_INFO_FORMAT (unpackinfo) == GST_VIDEO_FORMAT_AYUV ||
+        GST_VIDEO_FORMAT_INFO_FORMAT (unpackinfo) == GST_VIDEO_FORMAT_ARGB) {
+      cache_format = GST_VIDEO_FORMAT_INFO_FORMAT (unpackinfo);
+      tmpline = g_malloc ((w + 8) * 4);
+    }
+  }
+
   for (n = 0; n < num; ++n) {
     GstVideoOverlayRectangle *rect;
+    GstVideoOverlayRectangleCache *cache = NULL;
     gboolean needs_scaling;
 
     rect = comp->rectangles[n];
@@ -476,6 +782,15 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
         GST_VIDEO_INFO_WIDTH (&rect->info), GST_VIDEO_INFO_HEIGHT (&rect->info),
         GST_VIDEO_INFO_FORMAT (&rect->info));
 
+    if (cache_format != GST_VIDEO_FORMAT_UNKNOWN)
+      cache = gst_video_overlay_rectangle_get_cache (rect, cache_format);
+    if (cache != NULL) {
+      gst_video_overlay_rectangle_cache_blend (cache, video_buf, rect->x,
+          rect->y, tmpline);
+      gst_video_overlay_rectangle_cache_unref (cache);
+      continue;
+    }
+
     needs_scaling = gst_video_overlay_rectangle_needs_scaling (rect);
     if (needs_scaling) {
       gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
@@ -495,10 +810,11 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
       GST_WARNING ("Could not blend overlay rectangle onto video buffer");
     }
 
-    /* FIXME: should cache scaled pixels in the rectangle struct */
     gst_buffer_unref (pixels);
   }
 
+  g_free (tmpline);
+
   return ret;
 }
 
@@ -618,6 +934,9 @@ gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
         g_list_delete_link (rect->scaled_rectangles, rect->scaled_rectangles);
   }
 
+  g_list_free_full (rect->blend_caches,
+      (GDestroyNotify) gst_video_overlay_rectangle_cache_unref);
+
   g_free (rect->initial_alpha);
   g_mutex_clear (&rect->lock);
 
@@ -709,6 +1028,7 @@ gst_video_overlay_rectangle_new_raw (GstBuffer * pixels,
 
   rect->pixels = gst_buffer_ref (pixels);
   rect->scaled_rectangles = NULL;
+  rect->blend_caches = NULL;
 
   gst_video_info_init (&rect->info);
   gst_video_info_set_format (&rect->info, format, width, height);
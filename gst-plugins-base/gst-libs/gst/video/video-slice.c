@@ -0,0 +1,261 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:gstvideoslice
+ * @short_description: Process video frames in slices on multiple threads
+ *
+ * A #GstVideoSliceRunner splits the processing of a frame into independent
+ * slices that are executed concurrently. The threads are taken from the
+ * shared GLib thread pool so that many elements can use a runner without
+ * each of them keeping its own set of threads alive.
+ *
+ * gst_video_slice_get_lines() can be used to split a frame into horizontal
+ * bands that respect the vertical chroma subsampling of the format.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-slice.h"
+#include "gst/gstframejobs-private.h"
+
+struct _GstVideoSliceRunner
+{
+  guint n_threads;
+  GThreadPool *pool;
+};
+
+typedef struct
+{
+  GstVideoSliceFunc func;
+  gpointer user_data;
+  guint n_slices;
+
+  /* next slice to process */
+  volatile gint next;
+
+  /* workers that did not finish yet, protected with lock */
+  GMutex lock;
+  GCond cond;
+  guint pending;
+} SliceJob;
+
+static void
+slice_job_process (SliceJob * job)
+{
+  gint slice;
+
+  while ((slice = g_atomic_int_add (&job->next, 1)) < (gint) job->n_slices)
+    job->func (job->user_data, slice, job->n_slices);
+}
+
+static void
+slice_worker_func (gpointer data, gpointer user_data)
+{
+  SliceJob *job = data;
+
+  slice_job_process (job);
+
+  g_mutex_lock (&job->lock);
+  if (--job->pending == 0)
+    g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * gst_video_slice_runner_new:
+ * @n_threads: the maximum number of threads to use or 0 to use one thread
+ *     per CPU
+ *
+ * Create a new runner that executes slices on at most @n_threads threads,
+ * including the calling thread.
+ *
+ * Returns: a new #GstVideoSliceRunner that should be freed with
+ *     gst_video_slice_runner_free() after usage.
+ *
+ * Since: 1.2
+ */
+GstVideoSliceRunner *
+gst_video_slice_runner_new (guint n_threads)
+{
+  GstVideoSliceRunner *runner;
+
+  if (n_threads == 0)
+    n_threads = gst_frame_jobs_get_n_processors ();
+
+  runner = g_slice_new0 (GstVideoSliceRunner);
+  runner->n_threads = n_threads;
+
+  /* the calling thread processes slices as well */
+  if (n_threads > 1) {
+    runner->pool = g_thread_pool_new (slice_worker_func, NULL,
+        n_threads - 1, FALSE, NULL);
+    if (runner->pool == NULL)
+      runner->n_threads = 1;
+  }
+
+  return runner;
+}
+
+/**
+ * gst_video_slice_runner_free:
+ * @runner: a #GstVideoSliceRunner
+ *
+ * Free @runner. This waits for the threads of @runner to finish.
+ *
+ * Since: 1.2
+ */
+void
+gst_video_slice_runner_free (GstVideoSliceRunner * runner)
+{
+  g_return_if_fail (runner != NULL);
+
+  if (runner->pool)
+    g_thread_pool_free (runner->pool, FALSE, TRUE);
+  g_slice_free (GstVideoSliceRunner, runner);
+}
+
+/**
+ * gst_video_slice_runner_get_n_threads:
+ * @runner: a #GstVideoSliceRunner
+ *
+ * Get the maximum number of threads that @runner uses, including the calling
+ * thread. This is also the number of slices that makes optimal use of
+ * @runner.
+ *
+ * Returns: the number of threads used by @runner.
+ *
+ * Since: 1.2
+ */
+guint
+gst_video_slice_runner_get_n_threads (GstVideoSliceRunner * runner)
+{
+  g_return_val_if_fail (runner != NULL, 1);
+
+  return runner->n_threads;
+}
+
+/**
+ * gst_video_slice_runner_run:
+ * @runner: a #GstVideoSliceRunner
+ * @n_slices: the number of slices
+ * @func: the function to call for each slice
+ * @user_data: user data passed to @func
+ *
+ * Call @func for each of the @n_slices slices. The slices are processed
+ * concurrently on the threads of @runner and the calling thread. This
+ * function returns when all slices have been processed.
+ *
+ * Since: 1.2
+ */
+void
+gst_video_slice_runner_run (GstVideoSliceRunner * runner, guint n_slices,
+    GstVideoSliceFunc func, gpointer user_data)
+{
+  SliceJob job;
+  guint i, n_workers;
+
+  g_return_if_fail (runner != NULL);
+  g_return_if_fail (func != NULL);
+
+  if (n_slices == 0)
+    return;
+
+  /* fast path, process everything in the calling thread */
+  if (runner->pool == NULL || n_slices == 1) {
+    for (i = 0; i < n_slices; i++)
+      func (user_data, i, n_slices);
+    return;
+  }
+
+  job.func = func;
+  job.user_data = user_data;
+  job.n_slices = n_slices;
+  job.next = 0;
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+
+  n_workers = MIN (runner->n_threads - 1, n_slices - 1);
+  job.pending = n_workers;
+
+  for (i = 0; i < n_workers; i++) {
+    if (!g_thread_pool_push (runner->pool, &job, NULL)) {
+      g_mutex_lock (&job.lock);
+      job.pending--;
+      g_mutex_unlock (&job.lock);
+    }
+  }
+
+  /* help out and then wait for the workers */
+  slice_job_process (&job);
+
+  g_mutex_lock (&job.lock);
+  while (job.pending > 0)
+    g_cond_wait (&job.cond, &job.lock);
+  g_mutex_unlock (&job.lock);
+
+  g_cond_clear (&job.cond);
+  g_mutex_clear (&job.lock);
+}
+
+/**
+ * gst_video_slice_get_lines:
+ * @info: a #GstVideoInfo
+ * @slice: the slice
+ * @n_slices: the total number of slices
+ * @y: (out): the first line of @slice
+ * @height: (out): the number of lines in @slice
+ *
+ * Split the frame described by @info into @n_slices horizontal bands of
+ * roughly equal size and get the lines of band @slice. The bands are aligned
+ * to the vertical chroma subsampling of the format and, for interlaced
+ * content, to field pairs so that every band can be processed independently.
+ * Some bands can be empty when there are more slices than lines.
+ *
+ * Since: 1.2
+ */
+void
+gst_video_slice_get_lines (const GstVideoInfo * info, guint slice,
+    guint n_slices, guint * y, guint * height)
+{
+  guint i, align, total, units, start, end;
+
+  g_return_if_fail (info != NULL);
+  g_return_if_fail (slice < n_slices);
+
+  align = 0;
+  for (i = 0; i < GST_VIDEO_INFO_N_COMPONENTS (info); i++)
+    align = MAX (align, GST_VIDEO_FORMAT_INFO_H_SUB (info->finfo, i));
+  align = 1 << align;
+  if (GST_VIDEO_INFO_IS_INTERLACED (info))
+    align *= 2;
+
+  total = GST_VIDEO_INFO_HEIGHT (info);
+  units = (total + align - 1) / align;
+
+  start = MIN (total, (units * slice / n_slices) * align);
+  end = MIN (total, (units * (slice + 1) / n_slices) * align);
+
+  if (y)
+    *y = start;
+  if (height)
+    *height = end - start;
+}
@@ -0,0 +1,62 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_VIDEO_SLICE_H__
+#define __GST_VIDEO_SLICE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video-info.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GstVideoSliceFunc:
+ * @user_data: the user data passed to gst_video_slice_runner_run()
+ * @slice: the slice to process
+ * @n_slices: the total number of slices
+ *
+ * Function that processes slice @slice of @n_slices. The function is called
+ * concurrently from multiple threads, once for each slice.
+ */
+typedef void (*GstVideoSliceFunc) (gpointer user_data, guint slice, guint n_slices);
+
+/**
+ * GstVideoSliceRunner:
+ *
+ * Opaque object that executes slices of work on a set of threads.
+ */
+typedef struct _GstVideoSliceRunner GstVideoSliceRunner;
+
+GstVideoSliceRunner * gst_video_slice_runner_new           (guint n_threads);
+void                  gst_video_slice_runner_free          (GstVideoSliceRunner *runner);
+
+guint                 gst_video_slice_runner_get_n_threads (GstVideoSliceRunner *runner);
+
+void                  gst_video_slice_runner_run           (GstVideoSliceRunner *runner,
+                                                            guint n_slices,
+                                                            GstVideoSliceFunc func,
+                                                            gpointer user_data);
+
+void                  gst_video_slice_get_lines            (const GstVideoInfo *info,
+                                                            guint slice, guint n_slices,
+                                                            guint *y, guint *height);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_SLICE_H__ */
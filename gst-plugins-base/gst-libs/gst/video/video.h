@@ -28,6 +28,7 @@ typedef struct _GstVideoAlignment GstVideoAlignment;
 #include <gst/video/video-color.h>
 #include <gst/video/video-info.h>
 #include <gst/video/video-frame.h>
+#include <gst/video/video-slice.h>
 #include <gst/video/video-enumtypes.h>
 
 G_BEGIN_DECLS
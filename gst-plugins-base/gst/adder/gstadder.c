@@ -29,6 +29,13 @@
  * The adder currently mixes all data received on the sinkpads as soon as
  * possible without trying to synchronize the streams.
  *
+ * With the #GstAdder:live property set, the adder instead mixes on the
+ * pipeline clock. Every #GstAdder:output-buffer-duration it waits for the
+ * latency of upstream plus #GstAdder:latency and mixes whatever arrived for
+ * that time on each sinkpad. Inputs that have no data in time are filled with
+ * silence, so a stalled source does not hold up the other ones, and data
+ * that arrives after its output was pushed is clipped.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -68,6 +75,21 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 #define VOLUME_UNITY_INT32           134217728  /* internal int for unity 2^(32-5) */
 #define VOLUME_UNITY_INT32_BIT_SHIFT 27
 
+/* size of the blocks of output that all inputs are added to in turn, small
+ * enough to stay in the L1 cache */
+#define MIX_CHUNK_SIZE 4096
+
+/* an input of the current mix with the volume of its pad at that time */
+typedef struct
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  gdouble volume;
+  gint volume_i32;
+  gint volume_i16;
+  gint volume_i8;
+} GstAdderInput;
+
 enum
 {
   PROP_PAD_0,
@@ -122,6 +144,16 @@ gst_adder_pad_set_property (GObject * object, guint prop_id,
   }
 }
 
+static void
+gst_adder_pad_finalize (GObject * object)
+{
+  GstAdderPad *pad = GST_ADDER_PAD (object);
+
+  g_object_unref (pad->jitter);
+
+  G_OBJECT_CLASS (gst_adder_pad_parent_class)->finalize (object);
+}
+
 static void
 gst_adder_pad_class_init (GstAdderPadClass * klass)
 {
@@ -129,6 +161,7 @@ gst_adder_pad_class_init (GstAdderPadClass * klass)
 
   gobject_class->set_property = gst_adder_pad_set_property;
   gobject_class->get_property = gst_adder_pad_get_property;
+  gobject_class->finalize = gst_adder_pad_finalize;
 
   g_object_class_install_property (gobject_class, PROP_PAD_VOLUME,
       g_param_spec_double ("volume", "Volume", "Volume of this pad",
@@ -145,12 +178,26 @@ gst_adder_pad_init (GstAdderPad * pad)
 {
   pad->volume = DEFAULT_PAD_VOLUME;
   pad->mute = DEFAULT_PAD_MUTE;
+
+  pad->jitter = gst_adapter_new ();
+  pad->jitter_offset = -1;
 }
 
+#define DEFAULT_LIVE                    FALSE
+#define DEFAULT_LATENCY                 0
+#define DEFAULT_OUTPUT_BUFFER_DURATION  (10 * GST_MSECOND)
+
+/* timestamp jitter that is tolerated on live inputs before a discontinuity
+ * is assumed */
+#define LIVE_ALIGNMENT_THRESHOLD        (40 * GST_MSECOND)
+
 enum
 {
   PROP_0,
-  PROP_FILTER_CAPS
+  PROP_FILTER_CAPS,
+  PROP_LIVE,
+  PROP_LATENCY,
+  PROP_OUTPUT_BUFFER_DURATION
 };
 
 /* elementfactory information */
@@ -186,6 +233,7 @@ G_DEFINE_TYPE_WITH_CODE (GstAdder, gst_adder, GST_TYPE_ELEMENT,
     G_IMPLEMENT_INTERFACE (GST_TYPE_CHILD_PROXY, gst_adder_child_proxy_init));
 
 static void gst_adder_dispose (GObject * object);
+static void gst_adder_finalize (GObject * object);
 static void gst_adder_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_adder_get_property (GObject * object, guint prop_id,
@@ -215,6 +263,8 @@ static GstFlowReturn gst_adder_do_clip (GstCollectPads * pads,
 static GstFlowReturn gst_adder_collected (GstCollectPads * pads,
     gpointer user_data);
 
+static void gst_adder_pad_clear_jitter (GstAdderPad * pad);
+
 /* we can only accept caps that we and downstream can handle.
  * if we have filtercaps set, use those to constrain the target caps.
  */
@@ -528,6 +578,20 @@ gst_adder_query_latency (GstAdder * adder, GstQuery * query)
   gst_iterator_free (it);
 
   if (res) {
+    GST_OBJECT_LOCK (adder);
+    if (adder->live_active) {
+      GstClockTime own;
+
+      /* in live mode output is pushed a buffer duration plus the configured
+       * latency after the running time it starts at */
+      own = adder->latency + adder->output_buffer_duration;
+      live = TRUE;
+      min += own;
+      if (max != GST_CLOCK_TIME_NONE)
+        max += own;
+    }
+    GST_OBJECT_UNLOCK (adder);
+
     /* store the results */
     GST_DEBUG_OBJECT (adder, "Calculated total latency: live %s, min %"
         GST_TIME_FORMAT ", max %" GST_TIME_FORMAT,
@@ -856,6 +920,12 @@ gst_adder_sink_event (GstCollectPads * pads, GstCollectData * pad,
         GST_DEBUG_OBJECT (pad->pad, "eating flush stop");
       }
       GST_COLLECT_PADS_STREAM_UNLOCK (adder->collect);
+      if (adder->live_active) {
+        gst_adder_pad_clear_jitter (GST_ADDER_PAD (pad->pad));
+        GST_OBJECT_LOCK (adder);
+        adder->live_eos = FALSE;
+        GST_OBJECT_UNLOCK (adder);
+      }
       /* Clear pending tags */
       if (adder->pending_events) {
         g_list_foreach (adder->pending_events, (GFunc) gst_event_unref, NULL);
@@ -901,6 +971,7 @@ gst_adder_class_init (GstAdderClass * klass)
   gobject_class->set_property = gst_adder_set_property;
   gobject_class->get_property = gst_adder_get_property;
   gobject_class->dispose = gst_adder_dispose;
+  gobject_class->finalize = gst_adder_finalize;
 
   g_object_class_install_property (gobject_class, PROP_FILTER_CAPS,
       g_param_spec_boxed ("caps", "Target caps",
@@ -909,6 +980,50 @@ gst_adder_class_init (GstAdderClass * klass)
           "object.", GST_TYPE_CAPS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAdder:live:
+   *
+   * Mix on the pipeline clock instead of waiting for data on all sinkpads.
+   * Every #GstAdder:output-buffer-duration a buffer is mixed from what
+   * arrived in time on each sinkpad; inputs that stall are filled with
+   * silence and data that arrives after its output was produced is
+   * clipped. Changes only take effect when going from READY to PAUSED.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_LIVE,
+      g_param_spec_boolean ("live", "Live",
+          "Mix live inputs on the pipeline clock, filling in silence for "
+          "inputs that have no data in time", DEFAULT_LIVE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAdder:latency:
+   *
+   * Additional time to wait for late inputs in live mode, on top of the
+   * latency reported by upstream.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_LATENCY,
+      g_param_spec_uint64 ("latency", "Latency",
+          "Additional latency in live mode to allow inputs to arrive late "
+          "(in nanoseconds)", 0, G_MAXUINT64, DEFAULT_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAdder:output-buffer-duration:
+   *
+   * Duration of the buffers that are mixed and pushed in live mode.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_BUFFER_DURATION,
+      g_param_spec_uint64 ("output-buffer-duration", "Output Buffer Duration",
+          "Output block size in live mode (in nanoseconds)", GST_MSECOND,
+          G_MAXUINT64, DEFAULT_OUTPUT_BUFFER_DURATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_adder_src_template));
   gst_element_class_add_pad_template (gstelement_class,
@@ -946,6 +1061,14 @@ gst_adder_init (GstAdder * adder)
 
   adder->filter_caps = NULL;
 
+  adder->inputs = g_array_new (FALSE, FALSE, sizeof (GstAdderInput));
+
+  adder->live = DEFAULT_LIVE;
+  adder->latency = DEFAULT_LATENCY;
+  adder->output_buffer_duration = DEFAULT_OUTPUT_BUFFER_DURATION;
+  g_cond_init (&adder->live_cond);
+  adder->live_offset = -1;
+
   /* keep track of the sinkpads requested */
   adder->collect = gst_collect_pads_new ();
   gst_collect_pads_set_function (adder->collect,
@@ -979,6 +1102,17 @@ gst_adder_dispose (GObject * object)
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
+static void
+gst_adder_finalize (GObject * object)
+{
+  GstAdder *adder = GST_ADDER (object);
+
+  g_array_free (adder->inputs, TRUE);
+  g_cond_clear (&adder->live_cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_adder_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -1007,6 +1141,25 @@ gst_adder_set_property (GObject * object, guint prop_id,
       GST_DEBUG_OBJECT (adder, "set new caps %" GST_PTR_FORMAT, new_caps);
       break;
     }
+    case PROP_LIVE:
+      GST_OBJECT_LOCK (adder);
+      adder->live = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (adder);
+      break;
+    case PROP_LATENCY:
+      GST_OBJECT_LOCK (adder);
+      adder->latency = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (adder);
+      gst_element_post_message (GST_ELEMENT_CAST (adder),
+          gst_message_new_latency (GST_OBJECT_CAST (adder)));
+      break;
+    case PROP_OUTPUT_BUFFER_DURATION:
+      GST_OBJECT_LOCK (adder);
+      adder->output_buffer_duration = g_value_get_uint64 (value);
+      GST_OBJECT_UNLOCK (adder);
+      gst_element_post_message (GST_ELEMENT_CAST (adder),
+          gst_message_new_latency (GST_OBJECT_CAST (adder)));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1025,6 +1178,21 @@ gst_adder_get_property (GObject * object, guint prop_id, GValue * value,
       gst_value_set_caps (value, adder->filter_caps);
       GST_OBJECT_UNLOCK (adder);
       break;
+    case PROP_LIVE:
+      GST_OBJECT_LOCK (adder);
+      g_value_set_boolean (value, adder->live);
+      GST_OBJECT_UNLOCK (adder);
+      break;
+    case PROP_LATENCY:
+      GST_OBJECT_LOCK (adder);
+      g_value_set_uint64 (value, adder->latency);
+      GST_OBJECT_UNLOCK (adder);
+      break;
+    case PROP_OUTPUT_BUFFER_DURATION:
+      GST_OBJECT_LOCK (adder);
+      g_value_set_uint64 (value, adder->output_buffer_duration);
+      GST_OBJECT_UNLOCK (adder);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1058,6 +1226,11 @@ gst_adder_request_new_pad (GstElement * element, GstPadTemplate * templ,
   gst_collect_pads_add_pad (adder->collect, newpad, sizeof (GstCollectData),
       NULL, TRUE);
 
+  /* the new pad is not EOS, keep on mixing */
+  GST_OBJECT_LOCK (adder);
+  adder->live_eos = FALSE;
+  GST_OBJECT_UNLOCK (adder);
+
   /* takes ownership of the pad */
   if (!gst_element_add_pad (GST_ELEMENT (adder), newpad))
     goto could_not_add;
@@ -1098,6 +1271,776 @@ gst_adder_release_pad (GstElement * element, GstPad * pad)
   gst_element_remove_pad (element, pad);
 }
 
+static void
+gst_adder_volume (GstAdder * adder, guint8 * data, const GstAdderInput * input,
+    gint samples)
+{
+  switch (adder->info.finfo->format) {
+    case GST_AUDIO_FORMAT_U8:
+      adder_orc_volume_u8 ((gpointer) data, input->volume_i8, samples);
+      break;
+    case GST_AUDIO_FORMAT_S8:
+      adder_orc_volume_s8 ((gpointer) data, input->volume_i8, samples);
+      break;
+    case GST_AUDIO_FORMAT_U16:
+      adder_orc_volume_u16 ((gpointer) data, input->volume_i16, samples);
+      break;
+    case GST_AUDIO_FORMAT_S16:
+      adder_orc_volume_s16 ((gpointer) data, input->volume_i16, samples);
+      break;
+    case GST_AUDIO_FORMAT_U32:
+      adder_orc_volume_u32 ((gpointer) data, input->volume_i32, samples);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      adder_orc_volume_s32 ((gpointer) data, input->volume_i32, samples);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      adder_orc_volume_f32 ((gpointer) data, input->volume, samples);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      adder_orc_volume_f64 ((gpointer) data, input->volume, samples);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+static void
+gst_adder_add (GstAdder * adder, guint8 * out, const guint8 * in,
+    const GstAdderInput * input, gint samples)
+{
+  if (input->volume == 1.0) {
+    switch (adder->info.finfo->format) {
+      case GST_AUDIO_FORMAT_U8:
+        adder_orc_add_u8 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_S8:
+        adder_orc_add_s8 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_U16:
+        adder_orc_add_u16 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_S16:
+        adder_orc_add_s16 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_U32:
+        adder_orc_add_u32 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_S32:
+        adder_orc_add_s32 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_F32:
+        adder_orc_add_f32 ((gpointer) out, (gpointer) in, samples);
+        break;
+      case GST_AUDIO_FORMAT_F64:
+        adder_orc_add_f64 ((gpointer) out, (gpointer) in, samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  } else {
+    switch (adder->info.finfo->format) {
+      case GST_AUDIO_FORMAT_U8:
+        adder_orc_add_volume_u8 ((gpointer) out, (gpointer) in,
+            input->volume_i8, samples);
+        break;
+      case GST_AUDIO_FORMAT_S8:
+        adder_orc_add_volume_s8 ((gpointer) out, (gpointer) in,
+            input->volume_i8, samples);
+        break;
+      case GST_AUDIO_FORMAT_U16:
+        adder_orc_add_volume_u16 ((gpointer) out, (gpointer) in,
+            input->volume_i16, samples);
+        break;
+      case GST_AUDIO_FORMAT_S16:
+        adder_orc_add_volume_s16 ((gpointer) out, (gpointer) in,
+            input->volume_i16, samples);
+        break;
+      case GST_AUDIO_FORMAT_U32:
+        adder_orc_add_volume_u32 ((gpointer) out, (gpointer) in,
+            input->volume_i32, samples);
+        break;
+      case GST_AUDIO_FORMAT_S32:
+        adder_orc_add_volume_s32 ((gpointer) out, (gpointer) in,
+            input->volume_i32, samples);
+        break;
+      case GST_AUDIO_FORMAT_F32:
+        adder_orc_add_volume_f32 ((gpointer) out, (gpointer) in,
+            input->volume, samples);
+        break;
+      case GST_AUDIO_FORMAT_F64:
+        adder_orc_add_volume_f64 ((gpointer) out, (gpointer) in,
+            input->volume, samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  }
+}
+
+/* adds two inputs without volume in one pass over @out. Saturates after
+ * every input like two calls of gst_adder_add() so the result is the same */
+static void
+gst_adder_add2 (GstAdder * adder, guint8 * out, const guint8 * in1,
+    const guint8 * in2, gint samples)
+{
+  switch (adder->info.finfo->format) {
+    case GST_AUDIO_FORMAT_U8:
+      adder_orc_add2_u8 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_S8:
+      adder_orc_add2_s8 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_U16:
+      adder_orc_add2_u16 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_S16:
+      adder_orc_add2_s16 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_U32:
+      adder_orc_add2_u32 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      adder_orc_add2_s32 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      adder_orc_add2_f32 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      adder_orc_add2_f64 ((gpointer) out, (gpointer) in1, (gpointer) in2,
+          samples);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/* adds @buffer to the inputs of the next mix with the current volume of
+ * @pad. Must be called with the object lock of @pad. */
+static void
+gst_adder_add_input (GstAdder * adder, GstAdderPad * pad, GstBuffer * buffer)
+{
+  GstAdderInput input;
+
+  input.buffer = buffer;
+  input.volume = pad->volume;
+  input.volume_i32 = pad->volume_i32;
+  input.volume_i16 = pad->volume_i16;
+  input.volume_i8 = pad->volume_i8;
+  g_array_append_val (adder->inputs, input);
+}
+
+/* mixes all inputs that were added with gst_adder_add_input() and returns
+ * the result, which is the buffer of the first input made writable.
+ *
+ * Instead of making one pass over the output for every input, the output
+ * is processed in chunks of MIX_CHUNK_SIZE bytes and all inputs are added
+ * to a chunk while it is in the cache. With many inputs this saves most of
+ * the memory traffic of the mix. Inputs without volume are added two at a
+ * time, which halves the loads and stores of the chunk. */
+static GstBuffer *
+gst_adder_mix (GstAdder * adder)
+{
+  GstAdderInput *inputs = (GstAdderInput *) adder->inputs->data;
+  guint i, n_inputs = adder->inputs->len;
+  GstBuffer *outbuf;
+  guint8 *out;
+  gsize pos, len, size;
+  gint bps;
+
+  g_assert (n_inputs > 0);
+
+  bps = GST_AUDIO_INFO_BPS (&adder->info);
+
+  /* make data and metadata writable, can simply return the inbuf when we
+   * are the only one referencing this buffer */
+  inputs[0].buffer = gst_buffer_make_writable (inputs[0].buffer);
+  gst_buffer_map (inputs[0].buffer, &inputs[0].map, GST_MAP_READWRITE);
+  out = inputs[0].map.data;
+  size = inputs[0].map.size;
+
+  for (i = 1; i < n_inputs; i++) {
+    gst_buffer_map (inputs[i].buffer, &inputs[i].map, GST_MAP_READ);
+    /* all buffers should have the same size, there are no short buffers
+     * because we asked for the max size */
+    g_assert (inputs[i].map.size == size);
+  }
+
+  GST_LOG_OBJECT (adder, "mixing %u inputs of %" G_GSIZE_FORMAT " bytes",
+      n_inputs, size);
+
+  for (pos = 0; pos < size; pos += len) {
+    len = MIN (MIX_CHUNK_SIZE, size - pos);
+
+    if (inputs[0].volume != 1.0)
+      gst_adder_volume (adder, out + pos, &inputs[0], len / bps);
+
+    for (i = 1; i < n_inputs; i++) {
+      if (i + 1 < n_inputs && inputs[i].volume == 1.0
+          && inputs[i + 1].volume == 1.0) {
+        gst_adder_add2 (adder, out + pos, inputs[i].map.data + pos,
+            inputs[i + 1].map.data + pos, len / bps);
+        i++;
+      } else {
+        gst_adder_add (adder, out + pos, inputs[i].map.data + pos,
+            &inputs[i], len / bps);
+      }
+    }
+  }
+
+  gst_buffer_unmap (inputs[0].buffer, &inputs[0].map);
+  outbuf = inputs[0].buffer;
+  for (i = 1; i < n_inputs; i++) {
+    gst_buffer_unmap (inputs[i].buffer, &inputs[i].map);
+    gst_buffer_unref (inputs[i].buffer);
+  }
+  g_array_set_size (adder->inputs, 0);
+
+  return outbuf;
+}
+
+static void
+gst_adder_send_pending_events (GstAdder * adder)
+{
+  if (adder->flush_stop_pending == TRUE) {
+    GST_INFO_OBJECT (adder->srcpad, "send pending flush stop event");
+    if (!gst_pad_push_event (adder->srcpad, gst_event_new_flush_stop (TRUE))) {
+      GST_WARNING_OBJECT (adder->srcpad, "Sending flush stop event failed");
+    }
+
+    adder->flush_stop_pending = FALSE;
+  }
+
+  if (adder->send_stream_start) {
+    gchar s_id[32];
+
+    GST_INFO_OBJECT (adder->srcpad, "send pending stream start event");
+    /* stream-start (FIXME: create id based on input ids) */
+    g_snprintf (s_id, sizeof (s_id), "adder-%08x", g_random_int ());
+    if (!gst_pad_push_event (adder->srcpad, gst_event_new_stream_start (s_id))) {
+      GST_WARNING_OBJECT (adder->srcpad, "Sending stream start event failed");
+    }
+    adder->send_stream_start = FALSE;
+  }
+
+  if (adder->send_caps) {
+    GstEvent *caps_event;
+
+    caps_event = gst_event_new_caps (adder->current_caps);
+    GST_INFO_OBJECT (adder->srcpad, "send pending caps event %" GST_PTR_FORMAT,
+        caps_event);
+    if (!gst_pad_push_event (adder->srcpad, caps_event)) {
+      GST_WARNING_OBJECT (adder->srcpad, "Sending caps event failed");
+    }
+    adder->send_caps = FALSE;
+  }
+}
+
+static void
+gst_adder_send_pending_segment (GstAdder * adder)
+{
+  if (g_atomic_int_compare_and_exchange (&adder->new_segment_pending, TRUE,
+          FALSE)) {
+    GstEvent *event;
+
+    /* 
+     * When seeking we set the start and stop positions as given in the seek
+     * event. We also adjust offset & timestamp accordingly.
+     * This basically ignores all newsegments sent by upstream.
+     */
+    event = gst_event_new_segment (&adder->segment);
+    if (adder->segment.rate > 0.0) {
+      adder->segment.position = adder->segment.start;
+    } else {
+      adder->segment.position = adder->segment.stop;
+    }
+    adder->offset = gst_util_uint64_scale (adder->segment.position,
+        GST_AUDIO_INFO_RATE (&adder->info), GST_SECOND);
+
+    GST_INFO_OBJECT (adder->srcpad, "sending pending new segment event %"
+        GST_SEGMENT_FORMAT, &adder->segment);
+    if (event) {
+      if (!gst_pad_push_event (adder->srcpad, event)) {
+        GST_WARNING_OBJECT (adder->srcpad, "Sending new segment event failed");
+      }
+    } else {
+      GST_WARNING_OBJECT (adder->srcpad, "Creating new segment event for "
+          "start:%" G_GINT64_FORMAT "  end:%" G_GINT64_FORMAT " failed",
+          adder->segment.start, adder->segment.stop);
+    }
+  }
+
+  if (G_UNLIKELY (adder->pending_events)) {
+    GList *tmp = adder->pending_events;
+
+    while (tmp) {
+      GstEvent *ev = (GstEvent *) tmp->data;
+
+      gst_pad_push_event (adder->srcpad, ev);
+      tmp = g_list_next (tmp);
+    }
+    g_list_free (adder->pending_events);
+    adder->pending_events = NULL;
+  }
+}
+
+/* live mixing: input buffers do not go through the collectpads but are
+ * queued in a jitter buffer per pad, in output sample offsets, by the clip
+ * function. A task on the srcpad then waits on the clock until the running
+ * time of the end of each output buffer plus the latency and mixes what is
+ * in the jitter buffers for it. */
+
+static GstBuffer *
+gst_adder_trim_head (GstBuffer * buffer, gsize bytes)
+{
+  GstBuffer *trimmed;
+
+  trimmed = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_ALL, bytes, -1);
+  gst_buffer_unref (buffer);
+
+  return trimmed;
+}
+
+/* queues @buffer in the jitter buffer of @pad, takes ownership of @buffer.
+ *
+ * Small timestamp jitter is ignored, small gaps are filled with silence and
+ * data that overlaps with what is queued already is dropped. Data for
+ * output that was already pushed is clipped. */
+static void
+gst_adder_live_queue (GstAdder * adder, GstAdderPad * pad,
+    GstSegment * segment, GstBuffer * buffer)
+{
+  const GstAudioFormatInfo *finfo;
+  GstClockTime running_time;
+  guint64 start, end, next_offset, max_samples, threshold;
+  guint64 samples, avail, skip;
+  gint rate, bpf;
+
+  GST_OBJECT_LOCK (adder);
+  finfo = adder->info.finfo;
+  rate = GST_AUDIO_INFO_RATE (&adder->info);
+  bpf = GST_AUDIO_INFO_BPF (&adder->info);
+  next_offset = adder->live_offset;
+  /* never queue more than twice what we wait for */
+  max_samples = gst_util_uint64_scale (2 * adder->live_latency +
+      LIVE_ALIGNMENT_THRESHOLD, rate, GST_SECOND);
+  GST_OBJECT_UNLOCK (adder);
+
+  if (G_UNLIKELY (rate == 0 || bpf == 0))
+    goto not_negotiated;
+
+  buffer = gst_audio_buffer_clip (buffer, segment, rate, bpf);
+  if (buffer == NULL)
+    return;
+
+  samples = gst_buffer_get_size (buffer) / bpf;
+  running_time = gst_segment_to_running_time (segment, GST_FORMAT_TIME,
+      GST_BUFFER_TIMESTAMP (buffer));
+  threshold = gst_util_uint64_scale (LIVE_ALIGNMENT_THRESHOLD, rate,
+      GST_SECOND);
+
+  GST_OBJECT_LOCK (pad);
+  avail = gst_adapter_available (pad->jitter) / bpf;
+  end = pad->jitter_offset + avail;
+
+  if (GST_CLOCK_TIME_IS_VALID (running_time))
+    start = gst_util_uint64_scale_round (running_time, rate, GST_SECOND);
+  else if (pad->jitter_offset != -1)
+    start = end;
+  else
+    goto no_timestamp;
+
+  if (pad->jitter_offset != -1 && start != end) {
+    if (start + threshold >= end && start <= end + threshold) {
+      /* timestamp jitter, continue after the previous data */
+      start = end;
+    } else if (start < end) {
+      /* we already have data for the start of the buffer */
+      skip = end - start;
+      if (skip >= samples)
+        goto overlap;
+      GST_DEBUG_OBJECT (pad, "dropping %" G_GUINT64_FORMAT " overlapping "
+          "samples", skip);
+      buffer = gst_adder_trim_head (buffer, skip * bpf);
+      samples -= skip;
+      start = end;
+    } else if (avail > 0 && start - end <= max_samples) {
+      GstBuffer *silence;
+      GstMapInfo map;
+
+      GST_DEBUG_OBJECT (pad, "filling gap of %" G_GUINT64_FORMAT " samples",
+          start - end);
+      silence = gst_buffer_new_allocate (NULL, (start - end) * bpf, NULL);
+      gst_buffer_map (silence, &map, GST_MAP_WRITE);
+      gst_audio_format_fill_silence (finfo, map.data, map.size);
+      gst_buffer_unmap (silence, &map);
+      gst_adapter_push (pad->jitter, silence);
+      avail = start - pad->jitter_offset;
+    }
+  }
+
+  /* clip what the previous output buffers were already mixed from */
+  if (next_offset != -1 && start < next_offset) {
+    skip = next_offset - start;
+    if (skip >= samples)
+      goto late;
+    GST_DEBUG_OBJECT (pad, "clipping %" G_GUINT64_FORMAT " late samples",
+        skip);
+    buffer = gst_adder_trim_head (buffer, skip * bpf);
+    samples -= skip;
+    start = next_offset;
+  }
+
+  /* restart the jitter buffer when the data does not continue what is
+   * queued */
+  if (avail == 0 || start != pad->jitter_offset + avail) {
+    gst_adapter_clear (pad->jitter);
+    pad->jitter_offset = start;
+  }
+  gst_adapter_push (pad->jitter, buffer);
+
+  avail = gst_adapter_available (pad->jitter) / bpf;
+  if (avail > max_samples) {
+    GST_DEBUG_OBJECT (pad, "jitter buffer full, dropping %" G_GUINT64_FORMAT
+        " samples", avail - max_samples);
+    gst_adapter_flush (pad->jitter, (avail - max_samples) * bpf);
+    pad->jitter_offset += avail - max_samples;
+  }
+  GST_OBJECT_UNLOCK (pad);
+
+  return;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    GST_DEBUG_OBJECT (pad, "dropping buffer, not negotiated");
+    gst_buffer_unref (buffer);
+    return;
+  }
+no_timestamp:
+  {
+    GST_OBJECT_UNLOCK (pad);
+    GST_DEBUG_OBJECT (pad, "dropping buffer without timestamp");
+    gst_buffer_unref (buffer);
+    return;
+  }
+overlap:
+  {
+    GST_OBJECT_UNLOCK (pad);
+    GST_DEBUG_OBJECT (pad, "dropping buffer, already have its data");
+    gst_buffer_unref (buffer);
+    return;
+  }
+late:
+  {
+    GST_OBJECT_UNLOCK (pad);
+    GST_DEBUG_OBJECT (pad, "dropping late buffer");
+    gst_buffer_unref (buffer);
+    return;
+  }
+}
+
+/* takes the data for the output samples [start, start + samples) out of the
+ * jitter buffer of @pad, filled up with silence where the pad has no data.
+ * Returns NULL if the pad has no data for any of them. Must be called with
+ * the object lock of @pad. */
+static GstBuffer *
+gst_adder_live_take (GstAdder * adder, GstAdderPad * pad,
+    const GstAudioInfo * info, guint64 start, guint64 samples)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  guint64 avail, lead, n;
+  gint bpf;
+
+  if (pad->jitter_offset == -1)
+    return NULL;
+
+  bpf = GST_AUDIO_INFO_BPF (info);
+  avail = gst_adapter_available (pad->jitter) / bpf;
+
+  /* drop what arrived too late for the previous output buffers */
+  if (pad->jitter_offset < start) {
+    n = MIN (start - pad->jitter_offset, avail);
+    gst_adapter_flush (pad->jitter, n * bpf);
+    pad->jitter_offset += n;
+    avail -= n;
+  }
+
+  if (avail == 0 || pad->jitter_offset >= start + samples)
+    return NULL;
+
+  lead = pad->jitter_offset - start;
+  n = MIN (samples - lead, avail);
+
+  if (lead == 0 && n == samples) {
+    buffer = gst_adapter_take_buffer (pad->jitter, n * bpf);
+  } else {
+    GST_LOG_OBJECT (pad, "filling up %" G_GUINT64_FORMAT " samples with "
+        "silence", samples - n);
+    buffer = gst_buffer_new_allocate (NULL, samples * bpf, NULL);
+    gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (info->finfo, map.data, map.size);
+    gst_adapter_copy (pad->jitter, map.data + lead * bpf, 0, n * bpf);
+    gst_buffer_unmap (buffer, &map);
+    gst_adapter_flush (pad->jitter, n * bpf);
+  }
+  pad->jitter_offset += n;
+
+  return buffer;
+}
+
+static void
+gst_adder_pad_clear_jitter (GstAdderPad * pad)
+{
+  GST_OBJECT_LOCK (pad);
+  gst_adapter_clear (pad->jitter);
+  pad->jitter_offset = -1;
+  GST_OBJECT_UNLOCK (pad);
+}
+
+static GstClockReturn
+gst_adder_live_wait (GstAdder * adder, GstClock * clock, GstClockTime time)
+{
+  GstClockReturn ret;
+  GstClockID id;
+
+  GST_OBJECT_LOCK (adder);
+  if (!adder->live_running || adder->live_flushing) {
+    GST_OBJECT_UNLOCK (adder);
+    return GST_CLOCK_UNSCHEDULED;
+  }
+  id = adder->clock_id = gst_clock_new_single_shot_id (clock, time);
+  GST_OBJECT_UNLOCK (adder);
+
+  ret = gst_clock_id_wait (id, NULL);
+
+  GST_OBJECT_LOCK (adder);
+  adder->clock_id = NULL;
+  gst_clock_id_unref (id);
+  GST_OBJECT_UNLOCK (adder);
+
+  return ret;
+}
+
+static void
+gst_adder_live_unschedule (GstAdder * adder)
+{
+  if (adder->clock_id)
+    gst_clock_id_unschedule (adder->clock_id);
+  g_cond_broadcast (&adder->live_cond);
+}
+
+static void
+gst_adder_live_loop (GstAdder * adder)
+{
+  GstClock *clock;
+  GstClockTime base_time, start_time, end_time, latency;
+  GstAudioInfo info;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+  GList *l;
+  guint64 start, samples;
+  gboolean resync, discont, queued, eos;
+  gint rate;
+
+  GST_OBJECT_LOCK (adder);
+  while (!adder->live_running && !adder->live_flushing)
+    g_cond_wait (&adder->live_cond, GST_OBJECT_GET_LOCK (adder));
+  if (adder->live_flushing)
+    goto flushing;
+  if ((clock = GST_ELEMENT_CLOCK (adder)) == NULL)
+    goto no_clock;
+  gst_object_ref (clock);
+  base_time = GST_ELEMENT_CAST (adder)->base_time;
+  info = adder->info;
+  GST_OBJECT_UNLOCK (adder);
+
+  if (info.finfo->format == GST_AUDIO_FORMAT_UNKNOWN) {
+    /* not negotiated yet, check again in a buffer duration */
+    GST_LOG_OBJECT (adder, "waiting for caps");
+    gst_adder_live_wait (adder, clock,
+        gst_clock_get_time (clock) + adder->output_buffer_duration);
+    goto done;
+  }
+  rate = GST_AUDIO_INFO_RATE (&info);
+
+  GST_OBJECT_LOCK (adder);
+  resync = adder->live_resync;
+  adder->live_resync = FALSE;
+  GST_OBJECT_UNLOCK (adder);
+
+  if (G_UNLIKELY (resync)) {
+    GstQuery *query;
+    GstClockTime min;
+    gboolean live;
+
+    /* wait for the latency of upstream, the configured latency and the
+     * buffer duration, which is what we report */
+    query = gst_query_new_latency ();
+    if (gst_adder_query_latency (adder, query)) {
+      gst_query_parse_latency (query, &live, &min, NULL);
+    } else {
+      min = adder->latency + adder->output_buffer_duration;
+    }
+    gst_query_unref (query);
+
+    GST_OBJECT_LOCK (adder);
+    adder->live_latency = min;
+    GST_OBJECT_UNLOCK (adder);
+    GST_DEBUG_OBJECT (adder, "live mixing with latency %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (min));
+  }
+
+  GST_OBJECT_LOCK (adder);
+  if (G_UNLIKELY (resync || adder->live_offset == -1)) {
+    GstClockTime now;
+    guint64 offset;
+
+    /* start or continue at the current running time */
+    now = gst_clock_get_time (clock);
+    now = now > base_time ? now - base_time : 0;
+    offset = gst_util_uint64_scale (now, rate, GST_SECOND);
+    if (adder->live_offset == -1 || offset > adder->live_offset) {
+      adder->live_offset = offset;
+      adder->live_discont = TRUE;
+    }
+  }
+  start = adder->live_offset;
+  samples = gst_util_uint64_scale (adder->output_buffer_duration, rate,
+      GST_SECOND);
+  samples = MAX (samples, 1);
+  latency = adder->live_latency;
+  GST_OBJECT_UNLOCK (adder);
+
+  start_time = gst_util_uint64_scale (start, GST_SECOND, rate);
+  end_time = gst_util_uint64_scale (start + samples, GST_SECOND, rate);
+
+  GST_LOG_OBJECT (adder, "waiting to mix %" GST_TIME_FORMAT " - %"
+      GST_TIME_FORMAT, GST_TIME_ARGS (start_time), GST_TIME_ARGS (end_time));
+
+  if (gst_adder_live_wait (adder, clock,
+          base_time + start_time + latency) == GST_CLOCK_UNSCHEDULED)
+    goto done;
+
+  /* take what arrived in time on every pad */
+  queued = FALSE;
+  GST_OBJECT_LOCK (adder);
+  for (l = GST_ELEMENT_CAST (adder)->sinkpads; l; l = l->next) {
+    GstAdderPad *pad = l->data;
+    GstBuffer *inbuf;
+
+    gst_object_sync_values (GST_OBJECT (pad), start_time);
+
+    GST_OBJECT_LOCK (pad);
+    inbuf = gst_adder_live_take (adder, pad, &info, start, samples);
+    if (inbuf) {
+      if (pad->mute || pad->volume < G_MINDOUBLE)
+        gst_buffer_unref (inbuf);
+      else
+        gst_adder_add_input (adder, pad, inbuf);
+    }
+    queued |= gst_adapter_available (pad->jitter) > 0;
+    GST_OBJECT_UNLOCK (pad);
+  }
+  adder->live_offset = start + samples;
+  discont = adder->live_discont;
+  adder->live_discont = FALSE;
+  eos = adder->live_eos && adder->inputs->len == 0 && !queued;
+  GST_OBJECT_UNLOCK (adder);
+
+  GST_COLLECT_PADS_STREAM_LOCK (adder->collect);
+  gst_adder_send_pending_events (adder);
+  if (eos) {
+    GST_COLLECT_PADS_STREAM_UNLOCK (adder->collect);
+    GST_DEBUG_OBJECT (adder, "all pads are EOS and drained");
+    gst_pad_push_event (adder->srcpad, gst_event_new_eos ());
+    ret = GST_FLOW_EOS;
+    goto pause;
+  }
+
+  if (adder->inputs->len > 0) {
+    outbuf = gst_adder_mix (adder);
+  } else {
+    GstMapInfo map;
+
+    /* no input has data, push silence */
+    outbuf = gst_buffer_new_allocate (NULL, samples * info.bpf, NULL);
+    gst_buffer_map (outbuf, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (info.finfo, map.data, map.size);
+    gst_buffer_unmap (outbuf, &map);
+    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+  }
+  gst_adder_send_pending_segment (adder);
+  adder->offset = start + samples;
+  adder->segment.position = end_time;
+  GST_COLLECT_PADS_STREAM_UNLOCK (adder->collect);
+
+  GST_BUFFER_TIMESTAMP (outbuf) = start_time;
+  GST_BUFFER_DURATION (outbuf) = end_time - start_time;
+  GST_BUFFER_OFFSET (outbuf) = start;
+  GST_BUFFER_OFFSET_END (outbuf) = start + samples;
+  if (discont)
+    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_DISCONT);
+  else
+    GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_DISCONT);
+
+  GST_LOG_OBJECT (adder, "pushing outbuf %p, timestamp %" GST_TIME_FORMAT
+      " offset %" G_GUINT64_FORMAT, outbuf, GST_TIME_ARGS (start_time), start);
+  ret = gst_pad_push (adder->srcpad, outbuf);
+
+  /* keep mixing while flushing, the task is stopped when going to READY */
+  if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
+    goto pause;
+
+done:
+  gst_object_unref (clock);
+  return;
+
+  /* special cases */
+flushing:
+  {
+    GST_DEBUG_OBJECT (adder, "stopping, pausing task");
+    GST_OBJECT_UNLOCK (adder);
+    gst_pad_pause_task (adder->srcpad);
+    return;
+  }
+no_clock:
+  {
+    GST_OBJECT_UNLOCK (adder);
+    GST_ELEMENT_ERROR (adder, CORE, CLOCK, (NULL),
+        ("live mixing needs a clock"));
+    gst_pad_pause_task (adder->srcpad);
+    return;
+  }
+pause:
+  {
+    GST_DEBUG_OBJECT (adder, "pausing task, reason %s",
+        gst_flow_get_name (ret));
+    gst_pad_pause_task (adder->srcpad);
+    if (ret == GST_FLOW_NOT_LINKED || ret < GST_FLOW_EOS) {
+      GST_ELEMENT_ERROR (adder, STREAM, FAILED,
+          ("Internal data flow error."),
+          ("streaming task paused, reason %s (%d)", gst_flow_get_name (ret),
+              ret));
+      gst_pad_push_event (adder->srcpad, gst_event_new_eos ());
+    }
+    gst_object_unref (clock);
+    return;
+  }
+}
+
 static GstFlowReturn
 gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
     GstBuffer * buffer, GstBuffer ** out, gpointer user_data)
@@ -1105,6 +2048,15 @@ gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
   GstAdder *adder = GST_ADDER (user_data);
   gint rate, bpf;
 
+  if (adder->live_active) {
+    /* queue in the jitter buffer instead of the collectpads, the live mixing
+     * task takes it from there */
+    gst_adder_live_queue (adder, GST_ADDER_PAD (data->pad), &data->segment,
+        buffer);
+    *out = NULL;
+    return GST_FLOW_OK;
+  }
+
   rate = GST_AUDIO_INFO_RATE (&adder->info);
   bpf = GST_AUDIO_INFO_BPF (&adder->info);
 
@@ -1123,8 +2075,9 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
    * - this function is called when all pads have a buffer
    * - get available bytes on all pads.
    * - repeat for each input pad :
-   *   - read available bytes, copy or add to target buffer
+   *   - read available bytes, keep non-GAP buffers as inputs of the mix
    *   - if there's an EOS event, remove the input channel
+   * - add all inputs into the first one
    * - push out the output buffer
    *
    * todo:
@@ -1137,7 +2090,6 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   GSList *collected, *next = NULL;
   GstFlowReturn ret;
   GstBuffer *outbuf = NULL, *gapbuf = NULL;
-  GstMapInfo outmap = { NULL };
   guint outsize;
   gint64 next_offset;
   gint64 next_timestamp;
@@ -1146,42 +2098,22 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 
   adder = GST_ADDER (user_data);
 
+  if (adder->live_active) {
+    /* buffers never end up in the collectpads in live mode, so we only get
+     * here when all pads are EOS. The mixing task pushes EOS once it has
+     * drained the jitter buffers. */
+    GST_DEBUG_OBJECT (adder, "all pads are EOS");
+    GST_OBJECT_LOCK (adder);
+    adder->live_eos = TRUE;
+    GST_OBJECT_UNLOCK (adder);
+    return GST_FLOW_OK;
+  }
+
   /* this is fatal */
   if (G_UNLIKELY (adder->info.finfo->format == GST_AUDIO_FORMAT_UNKNOWN))
     goto not_negotiated;
 
-  if (adder->flush_stop_pending == TRUE) {
-    GST_INFO_OBJECT (adder->srcpad, "send pending flush stop event");
-    if (!gst_pad_push_event (adder->srcpad, gst_event_new_flush_stop (TRUE))) {
-      GST_WARNING_OBJECT (adder->srcpad, "Sending flush stop event failed");
-    }
-
-    adder->flush_stop_pending = FALSE;
-  }
-
-  if (adder->send_stream_start) {
-    gchar s_id[32];
-
-    GST_INFO_OBJECT (adder->srcpad, "send pending stream start event");
-    /* stream-start (FIXME: create id based on input ids) */
-    g_snprintf (s_id, sizeof (s_id), "adder-%08x", g_random_int ());
-    if (!gst_pad_push_event (adder->srcpad, gst_event_new_stream_start (s_id))) {
-      GST_WARNING_OBJECT (adder->srcpad, "Sending stream start event failed");
-    }
-    adder->send_stream_start = FALSE;
-  }
-
-  if (adder->send_caps) {
-    GstEvent *caps_event;
-
-    caps_event = gst_event_new_caps (adder->current_caps);
-    GST_INFO_OBJECT (adder->srcpad, "send pending caps event %" GST_PTR_FORMAT,
-        caps_event);
-    if (!gst_pad_push_event (adder->srcpad, caps_event)) {
-      GST_WARNING_OBJECT (adder->srcpad, "Sending caps event failed");
-    }
-    adder->send_caps = FALSE;
-  }
+  gst_adder_send_pending_events (adder);
 
   /* get available bytes for reading, this can be 0 which could mean empty
    * buffers or EOS, which we will catch when we loop over the pads. */
@@ -1201,7 +2133,6 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   for (collected = pads->data; collected; collected = next) {
     GstCollectData *collect_data;
     GstBuffer *inbuf;
-    gboolean is_gap;
     GstAdderPad *pad;
     GstClockTime timestamp, stream_time;
 
@@ -1239,243 +2170,48 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       continue;
     }
 
-    is_gap = GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP);
-
-    /* Try to make an output buffer */
-    if (outbuf == NULL) {
-      /* if this is a gap buffer but we have some more pads to check, skip it.
-       * If we are at the last buffer, take it, regardless if it is a GAP
-       * buffer or not. */
-      if (is_gap && next) {
-        GST_DEBUG_OBJECT (adder, "skipping, non-last GAP buffer");
-        /* we keep the GAP buffer, if we don't have anymore buffers (all pads
-         * EOS, we can use this one as the output buffer. */
-        if (gapbuf == NULL)
-          gapbuf = inbuf;
-        else
-          gst_buffer_unref (inbuf);
-        GST_OBJECT_UNLOCK (pad);
-        continue;
-      }
-
-      GST_LOG_OBJECT (adder, "channel %p: preparing output buffer of %d bytes",
-          collect_data, outsize);
-
-      /* make data and metadata writable, can simply return the inbuf when we
-       * are the only one referencing this buffer. If this is the last (and
-       * only) GAP buffer, it will automatically copy the GAP flag. */
-      outbuf = gst_buffer_make_writable (inbuf);
-      gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
-
-      if (pad->volume != 1.0) {
-        switch (adder->info.finfo->format) {
-          case GST_AUDIO_FORMAT_U8:
-            adder_orc_volume_u8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S8:
-            adder_orc_volume_s8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U16:
-            adder_orc_volume_u16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S16:
-            adder_orc_volume_s16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U32:
-            adder_orc_volume_u32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S32:
-            adder_orc_volume_s32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F32:
-            adder_orc_volume_f32 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F64:
-            adder_orc_volume_f64 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          default:
-            g_assert_not_reached ();
-            break;
-        }
-      }
-    } else {
-      if (!is_gap) {
-        /* we had a previous output buffer, mix this non-GAP buffer */
-        GstMapInfo inmap;
-
-        gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
-
-        /* all buffers should have outsize, there are no short buffers because we
-         * asked for the max size above */
-        g_assert (inmap.size == outmap.size);
-
-        GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
-            " from data %p", collect_data, inmap.size, inmap.data);
-
-        /* further buffers, need to add them */
-        if (pad->volume == 1.0) {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        } else {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_volume_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_volume_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_volume_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_volume_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_volume_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_volume_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_volume_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_volume_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        }
-        gst_buffer_unmap (inbuf, &inmap);
-      } else {
-        /* skip gap buffer */
-        GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
-      }
-      gst_buffer_unref (inbuf);
+    if (GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)) {
+      GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
+      /* we keep the GAP buffer, if we don't have anymore buffers (all pads
+       * EOS or GAP), we can use this one as the output buffer. */
+      if (gapbuf == NULL)
+        gapbuf = inbuf;
+      else
+        gst_buffer_unref (inbuf);
+      GST_OBJECT_UNLOCK (pad);
+      continue;
     }
+
+    GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes",
+        collect_data, gst_buffer_get_size (inbuf));
+    gst_adder_add_input (adder, pad, inbuf);
     GST_OBJECT_UNLOCK (pad);
   }
-  if (outbuf)
-    gst_buffer_unmap (outbuf, &outmap);
-
-  if (outbuf == NULL) {
-    /* no output buffer, reuse one of the GAP buffers then if we have one */
-    if (gapbuf) {
-      GST_LOG_OBJECT (adder, "reusing GAP buffer %p", gapbuf);
-      outbuf = gapbuf;
-    } else if (had_mute) {
-      GstMapInfo map;
 
-      /* Means we had all pads muted, create some silence */
-      outbuf = gst_buffer_new_allocate (NULL, outsize, NULL);
-      gst_buffer_map (outbuf, &map, GST_MAP_WRITE);
-      gst_audio_format_fill_silence (adder->info.finfo, map.data, outsize);
-      gst_buffer_unmap (outbuf, &map);
-      GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
-    } else {
-      /* assume EOS otherwise, this should not happen, really */
-      goto eos;
-    }
-  } else if (gapbuf) {
+  if (adder->inputs->len > 0) {
+    outbuf = gst_adder_mix (adder);
     /* we had an output buffer, unref the gapbuffer we kept */
-    gst_buffer_unref (gapbuf);
-  }
-
-  if (g_atomic_int_compare_and_exchange (&adder->new_segment_pending, TRUE,
-          FALSE)) {
-    GstEvent *event;
-
-    /* 
-     * When seeking we set the start and stop positions as given in the seek
-     * event. We also adjust offset & timestamp accordingly.
-     * This basically ignores all newsegments sent by upstream.
-     */
-    event = gst_event_new_segment (&adder->segment);
-    if (adder->segment.rate > 0.0) {
-      adder->segment.position = adder->segment.start;
-    } else {
-      adder->segment.position = adder->segment.stop;
-    }
-    adder->offset = gst_util_uint64_scale (adder->segment.position,
-        rate, GST_SECOND);
-
-    GST_INFO_OBJECT (adder->srcpad, "sending pending new segment event %"
-        GST_SEGMENT_FORMAT, &adder->segment);
-    if (event) {
-      if (!gst_pad_push_event (adder->srcpad, event)) {
-        GST_WARNING_OBJECT (adder->srcpad, "Sending new segment event failed");
-      }
-    } else {
-      GST_WARNING_OBJECT (adder->srcpad, "Creating new segment event for "
-          "start:%" G_GINT64_FORMAT "  end:%" G_GINT64_FORMAT " failed",
-          adder->segment.start, adder->segment.stop);
-    }
+    if (gapbuf)
+      gst_buffer_unref (gapbuf);
+  } else if (gapbuf) {
+    /* no output buffer, reuse one of the GAP buffers then */
+    GST_LOG_OBJECT (adder, "reusing GAP buffer %p", gapbuf);
+    outbuf = gapbuf;
+  } else if (had_mute) {
+    GstMapInfo map;
+
+    /* Means we had all pads muted, create some silence */
+    outbuf = gst_buffer_new_allocate (NULL, outsize, NULL);
+    gst_buffer_map (outbuf, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (adder->info.finfo, map.data, outsize);
+    gst_buffer_unmap (outbuf, &map);
+    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+  } else {
+    /* assume EOS otherwise, this should not happen, really */
+    goto eos;
   }
 
-  if (G_UNLIKELY (adder->pending_events)) {
-    GList *tmp = adder->pending_events;
-
-    while (tmp) {
-      GstEvent *ev = (GstEvent *) tmp->data;
-
-      gst_pad_push_event (adder->srcpad, ev);
-      tmp = g_list_next (tmp);
-    }
-    g_list_free (adder->pending_events);
-    adder->pending_events = NULL;
-  }
+  gst_adder_send_pending_segment (adder);
 
   /* for the next timestamp, use the sample counter, which will
    * never accumulate rounding errors */
@@ -1534,6 +2270,7 @@ gst_adder_change_state (GstElement * element, GstStateChange transition)
 {
   GstAdder *adder;
   GstStateChangeReturn ret;
+  gboolean live;
 
   adder = GST_ADDER (element);
 
@@ -1548,11 +2285,42 @@ gst_adder_change_state (GstElement * element, GstStateChange transition)
       adder->send_caps = TRUE;
       gst_caps_replace (&adder->current_caps, NULL);
       gst_segment_init (&adder->segment, GST_FORMAT_TIME);
+      GST_OBJECT_LOCK (adder);
+      adder->live_active = adder->live;
+      adder->live_running = FALSE;
+      adder->live_flushing = FALSE;
+      adder->live_eos = FALSE;
+      adder->live_offset = -1;
+      adder->live_latency = adder->latency + adder->output_buffer_duration;
+      GST_OBJECT_UNLOCK (adder);
       gst_collect_pads_start (adder->collect);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
+      GST_OBJECT_LOCK (adder);
+      live = adder->live_active;
+      if (live) {
+        adder->live_running = TRUE;
+        adder->live_resync = TRUE;
+        g_cond_broadcast (&adder->live_cond);
+      }
+      GST_OBJECT_UNLOCK (adder);
+      /* (re)start the mixing task, it might have paused itself */
+      if (live)
+        gst_pad_start_task (adder->srcpad,
+            (GstTaskFunction) gst_adder_live_loop, adder, NULL);
+      break;
+    case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+      /* the task waits until we go to PLAYING again */
+      GST_OBJECT_LOCK (adder);
+      adder->live_running = FALSE;
+      gst_adder_live_unschedule (adder);
+      GST_OBJECT_UNLOCK (adder);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      GST_OBJECT_LOCK (adder);
+      adder->live_flushing = TRUE;
+      gst_adder_live_unschedule (adder);
+      GST_OBJECT_UNLOCK (adder);
       /* need to unblock the collectpads before calling the
        * parent change_state so that streaming can finish */
       gst_collect_pads_stop (adder->collect);
@@ -1562,8 +2330,28 @@ gst_adder_change_state (GstElement * element, GstStateChange transition)
   }
 
   ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
 
   switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+    case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
+      /* like a live source, no output is produced in PAUSED */
+      GST_OBJECT_LOCK (adder);
+      if (adder->live_active)
+        ret = GST_STATE_CHANGE_NO_PREROLL;
+      GST_OBJECT_UNLOCK (adder);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:{
+      GList *l;
+
+      gst_pad_stop_task (adder->srcpad);
+      GST_OBJECT_LOCK (adder);
+      for (l = element->sinkpads; l; l = l->next)
+        gst_adder_pad_clear_jitter (GST_ADDER_PAD (l->data));
+      GST_OBJECT_UNLOCK (adder);
+      break;
+    }
     default:
       break;
   }
@@ -25,6 +25,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstcollectpads.h>
+#include <gst/base/gstadapter.h>
 #include <gst/audio/audio.h>
 
 G_BEGIN_DECLS
@@ -77,6 +78,30 @@ struct _GstAdder {
   
   gboolean send_stream_start;
   gboolean send_caps;
+
+  /* inputs of the current mix, see gst_adder_mix_inputs() */
+  GArray *inputs;
+
+  /* live mixing properties */
+  gboolean live;
+  GstClockTime latency;
+  GstClockTime output_buffer_duration;
+
+  /* live mixing state, protected by the object lock. When live mixing is
+   * active, input buffers are queued in the jitter buffer of their pad and
+   * a task on the srcpad mixes them on the pipeline clock */
+  gboolean live_active;
+  gboolean live_running;
+  gboolean live_flushing;
+  gboolean live_resync;
+  gboolean live_eos;
+  gboolean live_discont;
+  GCond live_cond;
+  GstClockID clock_id;
+  /* output sample offset of the next buffer, -1 if unknown */
+  guint64 live_offset;
+  /* total latency, the output is pushed this long after its running time */
+  GstClockTime live_latency;
 };
 
 struct _GstAdderClass {
@@ -100,6 +125,12 @@ struct _GstAdderPad {
   gint volume_i16;
   gint volume_i8;
   gboolean mute;
+
+  /* jitter buffer for live mixing, protected by the object lock.
+   * jitter_offset is the output sample offset of the first sample in the
+   * adapter, -1 when it is empty */
+  GstAdapter *jitter;
+  guint64 jitter_offset;
 };
 
 struct _GstAdderPadClass {
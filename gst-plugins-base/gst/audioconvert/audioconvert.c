@@ -555,6 +555,60 @@ static AudioConvertPack pack_funcs[] = {
   (AudioConvertPack) MAKE_PACK_FUNC_NAME (s32_be_float),
 };
 
+/***
+ * direct conversion between the common formats in native endianness. These
+ * give the same results as going through the separate stages via the
+ * 32 bit integer intermediate format without dithering.
+ */
+static inline gint32
+audio_convert_float_to_s32 (gfloat f)
+{
+  gfloat tmp = f * 2147483648.0f + 0.5f;
+
+  if (tmp >= 2147483648.0f)
+    return G_MAXINT32;
+  if (!(tmp >= -2147483648.0f))
+    return G_MININT32;
+  return (gint32) tmp;
+}
+
+static void
+audio_convert_direct_s16_float (gint16 * src, gfloat * dst, gint count)
+{
+  for (; count; count--)
+    *dst++ = *src++ * (1.0f / 32768.0f);
+}
+
+static void
+audio_convert_direct_float_s16 (gfloat * src, gint16 * dst, gint count)
+{
+  gint32 tmp;
+
+  for (; count; count--) {
+    tmp = audio_convert_float_to_s32 (*src++);
+    /* round like the quantizer does */
+    if (tmp > 0 && G_MAXINT32 - tmp <= (1 << 15))
+      tmp = G_MAXINT32;
+    else
+      tmp += (1 << 15);
+    *dst++ = (gint16) (tmp >> 16);
+  }
+}
+
+static void
+audio_convert_direct_s32_float (gint32 * src, gfloat * dst, gint count)
+{
+  for (; count; count--)
+    *dst++ = *src++ * (1.0f / 2147483648.0f);
+}
+
+static void
+audio_convert_direct_float_s32 (gfloat * src, gint32 * dst, gint count)
+{
+  for (; count; count--)
+    *dst++ = audio_convert_float_to_s32 (*src++);
+}
+
 #define DOUBLE_INTERMEDIATE_FORMAT(ctx)                   \
     ((!GST_AUDIO_FORMAT_INFO_IS_INTEGER (ctx->in.finfo) &&    \
       !GST_AUDIO_FORMAT_INFO_IS_INTEGER (ctx->out.finfo)) ||  \
@@ -679,6 +733,26 @@ audio_convert_prepare_context (AudioConvertCtx * ctx, GstAudioInfo * in,
 
   gst_audio_quantize_setup (ctx);
 
+  /* pure sample format conversions that can skip the intermediate format */
+  ctx->direct = NULL;
+  if (ctx->mix_passthrough && !DOUBLE_INTERMEDIATE_FORMAT (ctx)) {
+    GstAudioFormat in_format = GST_AUDIO_INFO_FORMAT (in);
+    GstAudioFormat out_format = GST_AUDIO_INFO_FORMAT (out);
+
+    if (in_format == GST_AUDIO_FORMAT_S16 && out_format == GST_AUDIO_FORMAT_F32)
+      ctx->direct = (AudioConvertDirect) audio_convert_direct_s16_float;
+    else if (in_format == GST_AUDIO_FORMAT_F32
+        && out_format == GST_AUDIO_FORMAT_S16 && ctx->dither == DITHER_NONE)
+      ctx->direct = (AudioConvertDirect) audio_convert_direct_float_s16;
+    else if (in_format == GST_AUDIO_FORMAT_S32
+        && out_format == GST_AUDIO_FORMAT_F32)
+      ctx->direct = (AudioConvertDirect) audio_convert_direct_s32_float;
+    else if (in_format == GST_AUDIO_FORMAT_F32
+        && out_format == GST_AUDIO_FORMAT_S32)
+      ctx->direct = (AudioConvertDirect) audio_convert_direct_float_s32;
+  }
+  GST_INFO ("direct conversion %d", ctx->direct != NULL);
+
   return TRUE;
 
   /* ERRORS */
@@ -720,14 +794,18 @@ audio_convert_get_sizes (AudioConvertCtx * ctx, gint samples, gint * srcsize,
   return TRUE;
 }
 
+/* size of the intermediate buffer. The samples go through all stages in
+ * blocks that fit into it, so that the intermediate data stays in the cache
+ * from one stage to the next */
+#define BLOCK_SIZE (16 * 1024)
+
 gboolean
 audio_convert_convert (AudioConvertCtx * ctx, gpointer src,
-    gpointer dst, gint samples, gboolean src_writable)
+    gpointer dst, gint samples)
 {
-  guint insize, outsize, size;
-  gpointer outbuf, tmpbuf;
-  guint intemp = 0, outtemp = 0, biggest;
-  gint in_width, out_width;
+  gint size, channels, block, len;
+  guint8 *in, *out;
+  gpointer buf, outbuf;
 
   g_return_val_if_fail (ctx != NULL, FALSE);
   g_return_val_if_fail (src != NULL, FALSE);
@@ -737,74 +815,60 @@ audio_convert_convert (AudioConvertCtx * ctx, gpointer src,
   if (samples == 0)
     return TRUE;
 
-  insize = ctx->in.bpf * samples;
-  outsize = ctx->out.bpf * samples;
-
-  in_width = GST_AUDIO_FORMAT_INFO_WIDTH (ctx->in.finfo);
-  out_width = GST_AUDIO_FORMAT_INFO_WIDTH (ctx->out.finfo);
+  if (ctx->direct) {
+    ctx->direct (src, dst, samples * ctx->in.channels);
+    return TRUE;
+  }
 
-  /* find biggest temp buffer size */
+  /* find the number of samples per block */
   size = (DOUBLE_INTERMEDIATE_FORMAT (ctx)) ? sizeof (gdouble)
       : sizeof (gint32);
+  channels = MAX (ctx->in.channels, ctx->out.channels);
+  block = MAX (BLOCK_SIZE / (size * channels), 1);
 
-  if (!ctx->in_default)
-    intemp = gst_util_uint64_scale (insize, size * 8, in_width);
-  if (!ctx->mix_passthrough || !ctx->out_default)
-    outtemp = gst_util_uint64_scale (outsize, size * 8, out_width);
-  biggest = MAX (intemp, outtemp);
-
-  /* see if one of the buffers can be used as temp */
-  if ((outsize >= biggest) && (ctx->out.bpf <= size))
-    tmpbuf = dst;
-  else if ((insize >= biggest) && src_writable && (ctx->in.bpf >= size))
-    tmpbuf = src;
-  else {
-    if (biggest > ctx->tmpbufsize) {
-      ctx->tmpbuf = g_realloc (ctx->tmpbuf, biggest);
-      ctx->tmpbufsize = biggest;
-    }
-    tmpbuf = ctx->tmpbuf;
+  if (block * size * channels > ctx->tmpbufsize) {
+    ctx->tmpbufsize = block * size * channels;
+    ctx->tmpbuf = g_realloc (ctx->tmpbuf, ctx->tmpbufsize);
   }
 
-  /* start conversion */
-  if (!ctx->in_default) {
-    /* check if final conversion */
-    if (!(ctx->out_default && ctx->mix_passthrough))
-      outbuf = tmpbuf;
-    else
-      outbuf = dst;
+  in = src;
+  out = dst;
+  while (samples > 0) {
+    len = MIN (samples, block);
+    buf = in;
 
     /* unpack to default format */
-    ctx->unpack (src, outbuf, ctx->in_scale, samples * ctx->in.channels);
-
-    src = outbuf;
-  }
-
-  if (!ctx->mix_passthrough) {
-    /* check if final conversion */
-    if (!ctx->out_default)
-      outbuf = tmpbuf;
-    else
-      outbuf = dst;
-
-    /* convert channels */
-    ctx->channel_mix (ctx, src, outbuf, samples);
+    if (!ctx->in_default) {
+      ctx->unpack (buf, ctx->tmpbuf, ctx->in_scale, len * ctx->in.channels);
+      buf = ctx->tmpbuf;
+    }
 
-    src = outbuf;
-  }
+    /* convert channels, directly into dst if that is the last stage */
+    if (!ctx->mix_passthrough) {
+      if (ctx->out_default && !ctx->quantize)
+        outbuf = out;
+      else
+        outbuf = ctx->tmpbuf;
+      ctx->channel_mix (ctx, buf, outbuf, len);
+      buf = outbuf;
+    }
 
-  /* we only need to quantize if output format is int */
-  if (GST_AUDIO_FORMAT_INFO_IS_INTEGER (ctx->out.finfo)) {
-    if (ctx->out_default)
-      outbuf = dst;
-    else
-      outbuf = tmpbuf;
-    ctx->quantize (ctx, src, outbuf, samples);
-  }
+    /* we only need to quantize if output format is int */
+    if (ctx->quantize) {
+      outbuf = ctx->out_default ? out : ctx->tmpbuf;
+      ctx->quantize (ctx, buf, outbuf, len);
+      buf = outbuf;
+    }
 
-  if (!ctx->out_default) {
     /* pack default format into dst */
-    ctx->pack (src, dst, ctx->out_scale, samples * ctx->out.channels);
+    if (!ctx->out_default)
+      ctx->pack (buf, out, ctx->out_scale, len * ctx->out.channels);
+    else if (buf != out)
+      memcpy (out, buf, len * ctx->out.bpf);
+
+    in += len * ctx->in.bpf;
+    out += len * ctx->out.bpf;
+    samples -= len;
   }
 
   return TRUE;
@@ -92,6 +92,8 @@ typedef void (*AudioConvertUnpack) (gpointer src, gpointer dst, gint scale,
 typedef void (*AudioConvertPack) (gpointer src, gpointer dst, gint scale,
     gint count);
 
+typedef void (*AudioConvertDirect) (gpointer src, gpointer dst, gint count);
+
 typedef void (*AudioConvertMix) (AudioConvertCtx *, gpointer, gpointer, gint);
 typedef void (*AudioConvertQuantize) (AudioConvertCtx * ctx, gpointer src,
     gpointer dst, gint count);
@@ -103,12 +105,24 @@ struct _AudioConvertCtx
 
   AudioConvertUnpack unpack;
   AudioConvertPack pack;
+  /* converts from the input to the output format in one go, bypassing all
+   * other stages, if set */
+  AudioConvertDirect direct;
 
   /* channel conversion matrix, m[in_channels][out_channels].
    * If identity matrix, passthrough applies. */
   gfloat **matrix;
   /* temp storage for channelmix */
   gpointer tmp;
+  /* channelmix kernel selected for the matrix and its coefficients: the
+   * dense matrix as m[in_channels * out_channels] and the non-zero
+   * coefficients per output channel, see gstchannelmix.c */
+  gint mix_kernel;
+  gdouble *mix_coeffs;
+  gint *mix_terms;
+  gint *mix_index;
+  gdouble *mix_values;
+  gdouble *mix_acc;
 
   gboolean in_default;
   gboolean mix_passthrough;
@@ -122,6 +136,7 @@ struct _AudioConvertCtx
 
   AudioConvertMix channel_mix;
 
+  /* NULL if quantizing is not needed */
   AudioConvertQuantize quantize;
 
   GstAudioConvertDithering dither;
@@ -141,6 +156,6 @@ gboolean audio_convert_get_sizes (AudioConvertCtx * ctx, gint samples,
 gboolean audio_convert_clean_context (AudioConvertCtx * ctx);
 
 gboolean audio_convert_convert (AudioConvertCtx * ctx, gpointer src,
-    gpointer dst, gint samples, gboolean src_writable);
+    gpointer dst, gint samples);
 
 #endif /* __AUDIO_CONVERT_H__ */
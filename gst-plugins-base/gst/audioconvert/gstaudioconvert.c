@@ -799,7 +799,7 @@ gst_audio_convert_transform (GstBaseTransform * base, GstBuffer * inbuf,
   /* and convert the samples */
   if (!GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)) {
     if (!audio_convert_convert (&this->ctx, srcmap.data, dstmap.data,
-            samples, gst_buffer_is_writable (inbuf)))
+            samples))
       goto convert_error;
   } else {
     /* Create silence buffer */
@@ -474,6 +474,13 @@ gst_audio_quantize_setup_quantize_func (AudioConvertCtx * ctx)
     return;
   }
 
+  /* 32 bit integer output with integer intermediate format, nothing to
+   * quantize */
+  if (ctx->out_scale == 0 && ctx->ns == NOISE_SHAPING_NONE) {
+    ctx->quantize = NULL;
+    return;
+  }
+
   if (ctx->ns == NOISE_SHAPING_NONE) {
     index += ctx->dither;
     index += GST_AUDIO_FORMAT_INFO_IS_SIGNED (ctx->out.finfo) ? 0 : 4;
@@ -29,6 +29,24 @@
 
 #include "gstchannelmix.h"
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_CHANNEL_MIX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* number of frames mixed at once into the temp storage for in-place mixing */
+#define MIX_BLOCK_FRAMES 64
+
+enum
+{
+  MIX_KERNEL_DENSE = 0,
+  MIX_KERNEL_SPARSE,
+  MIX_KERNEL_GATHER,
+  MIX_KERNEL_1_2,
+  MIX_KERNEL_2_1,
+  MIX_KERNEL_6_2
+};
+
 /*
  * Channel matrix functions.
  */
@@ -50,6 +68,17 @@ gst_channel_mix_unset_matrix (AudioConvertCtx * this)
   this->matrix = NULL;
   g_free (this->tmp);
   this->tmp = NULL;
+
+  g_free (this->mix_coeffs);
+  this->mix_coeffs = NULL;
+  g_free (this->mix_terms);
+  this->mix_terms = NULL;
+  g_free (this->mix_index);
+  this->mix_index = NULL;
+  g_free (this->mix_values);
+  this->mix_values = NULL;
+  g_free (this->mix_acc);
+  this->mix_acc = NULL;
 }
 
 /*
@@ -590,6 +619,74 @@ gst_channel_mix_fill_matrix (AudioConvertCtx * this)
   }
 }
 
+/*
+ * Pick the mixing kernel for the matrix and precompute its coefficients.
+ */
+
+static void
+gst_channel_mix_setup_kernel (AudioConvertCtx * this)
+{
+  gint ic = this->in.channels;
+  gint oc = this->out.channels;
+  gint i, o, t, nonzero = 0, uniform = 0;
+  gboolean gather = TRUE;
+
+  this->mix_coeffs = g_new (gdouble, ic * oc);
+  this->mix_terms = g_new (gint, oc);
+  this->mix_index = g_new (gint, ic * oc);
+  this->mix_values = g_new (gdouble, ic * oc);
+  this->mix_acc = g_new (gdouble, oc);
+
+  for (i = 0; i < ic; i++)
+    for (o = 0; o < oc; o++)
+      this->mix_coeffs[i * oc + o] = this->matrix[i][o];
+
+  /* collect the non-zero coefficients of every output channel */
+  for (o = 0; o < oc; o++) {
+    gint *index = &this->mix_index[o * ic];
+    gdouble *values = &this->mix_values[o * ic];
+
+    for (i = 0, t = 0; i < ic; i++) {
+      if (this->matrix[i][o] != 0.0) {
+        index[t] = i;
+        values[t] = this->matrix[i][o];
+        t++;
+      }
+    }
+    nonzero += t;
+
+    if (t > 1 || (t == 1 && values[0] != 1.0))
+      gather = FALSE;
+
+    /* all input channels with the same weight, sum them up and multiply
+     * only once */
+    if (t == ic && t >= 4) {
+      for (i = 1; i < t && values[i] == values[0]; i++);
+      if (i == t) {
+        t = -1;
+        uniform++;
+      }
+    }
+    this->mix_terms[o] = t;
+  }
+
+  if (gather)
+    this->mix_kernel = MIX_KERNEL_GATHER;
+  else if (uniform > 0 || 2 * nonzero < ic * oc)
+    this->mix_kernel = MIX_KERNEL_SPARSE;
+  else if (ic == 1 && oc == 2)
+    this->mix_kernel = MIX_KERNEL_1_2;
+  else if (ic == 2 && oc == 1)
+    this->mix_kernel = MIX_KERNEL_2_1;
+  else if (ic == 6 && oc == 2)
+    this->mix_kernel = MIX_KERNEL_6_2;
+  else
+    this->mix_kernel = MIX_KERNEL_DENSE;
+
+  GST_DEBUG ("using mix kernel %d, %d of %d coefficients non-zero",
+      this->mix_kernel, nonzero, ic * oc);
+}
+
 /* only call after this->out and this->in are filled in */
 void
 gst_channel_mix_setup_matrix (AudioConvertCtx * this)
@@ -599,13 +696,8 @@ gst_channel_mix_setup_matrix (AudioConvertCtx * this)
   /* don't lose memory */
   gst_channel_mix_unset_matrix (this);
 
-  /* temp storage */
-  if (GST_AUDIO_FORMAT_INFO_IS_INTEGER (this->in.finfo) ||
-      GST_AUDIO_FORMAT_INFO_IS_INTEGER (this->out.finfo)) {
-    this->tmp = (gpointer) g_new (gint32, this->out.channels);
-  } else {
-    this->tmp = (gpointer) g_new (gdouble, this->out.channels);
-  }
+  /* temp storage for in-place mixing, big enough for gint32 and gdouble */
+  this->tmp = (gpointer) g_new (gdouble, MIX_BLOCK_FRAMES * this->out.channels);
 
   /* allocate */
   this->matrix = g_new0 (gfloat *, this->in.channels);
@@ -642,6 +734,8 @@ gst_channel_mix_setup_matrix (AudioConvertCtx * this)
     g_string_free (s, TRUE);
   }
 #endif
+
+  gst_channel_mix_setup_kernel (this);
 }
 
 gboolean
@@ -664,82 +758,253 @@ gst_channel_mix_passthrough (AudioConvertCtx * this)
   return in_mask == out_mask;
 }
 
-/* IMPORTANT: out_data == in_data is possible, make sure to not overwrite data
- * you might need later on! */
+/*
+ * Mixing kernels. They mix frames from in to out, which never overlap, and
+ * accumulate in double precision for both the int and the float path.
+ */
+
+/* acc[o] += x * row[o] */
+static inline void
+mix_accumulate_row (gdouble * acc, const gdouble * row, gdouble x, gint n)
+{
+  gint o = 0;
+
+#ifdef HAVE_CHANNEL_MIX_SSE2
+  __m128d vx = _mm_set1_pd (x);
+
+  for (; o + 4 <= n; o += 4) {
+    _mm_storeu_pd (acc + o, _mm_add_pd (_mm_loadu_pd (acc + o),
+            _mm_mul_pd (vx, _mm_loadu_pd (row + o))));
+    _mm_storeu_pd (acc + o + 2, _mm_add_pd (_mm_loadu_pd (acc + o + 2),
+            _mm_mul_pd (vx, _mm_loadu_pd (row + o + 2))));
+  }
+#endif
+  for (; o < n; o++)
+    acc[o] += x * row[o];
+}
+
+static inline gdouble
+mix_sum_int (const gint32 * in, gint n)
+{
+  gint64 sum = 0;
+  gint i;
+
+  for (i = 0; i < n; i++)
+    sum += in[i];
+
+  return sum;
+}
+
+static inline gdouble
+mix_sum_float (const gdouble * in, gint n)
+{
+  gint i = 0;
+#ifdef HAVE_CHANNEL_MIX_SSE2
+  __m128d s0 = _mm_setzero_pd (), s1 = _mm_setzero_pd ();
+  gdouble sum[2];
+
+  for (; i + 4 <= n; i += 4) {
+    s0 = _mm_add_pd (s0, _mm_loadu_pd (in + i));
+    s1 = _mm_add_pd (s1, _mm_loadu_pd (in + i + 2));
+  }
+  _mm_storeu_pd (sum, _mm_add_pd (s0, s1));
+  sum[0] += sum[1];
+#else
+  gdouble sum[1] = { 0.0 };
+#endif
+
+  for (; i < n; i++)
+    sum[0] += in[i];
+
+  return sum[0];
+}
+
+#define CLIP_INT(res) \
+  ((res) < G_MININT32 ? G_MININT32 : \
+      ((res) > G_MAXINT32 ? G_MAXINT32 : (gint32) (res)))
+#define CLIP_FLOAT(res) \
+  ((res) < -1.0 ? -1.0 : ((res) > 1.0 ? 1.0 : (res)))
+#define COPY_INT(res) (res)
+#define COPY_FLOAT(res) CLIP_FLOAT (res)
+
+/* generic matrix, vectorized over the output channels */
+#define MAKE_MIX_DENSE_FUNC(name, type, CLIP)                                 \
+static void                                                                   \
+mix_dense_##name (AudioConvertCtx * this, const type * in, type * out,       \
+    gint frames)                                                              \
+{                                                                             \
+  const gint ic = this->in.channels, oc = this->out.channels;                 \
+  const gdouble *m = this->mix_coeffs;                                        \
+  gdouble *acc = this->mix_acc;                                               \
+  gint n, i, o;                                                               \
+                                                                              \
+  for (n = 0; n < frames; n++) {                                              \
+    memset (acc, 0, sizeof (gdouble) * oc);                                   \
+    for (i = 0; i < ic; i++)                                                  \
+      mix_accumulate_row (acc, &m[i * oc], in[i], oc);                        \
+    for (o = 0; o < oc; o++)                                                  \
+      out[o] = CLIP (acc[o]);                                                 \
+    in += ic;                                                                 \
+    out += oc;                                                                \
+  }                                                                           \
+}
+
+/* only the non-zero coefficients of every output channel */
+#define MAKE_MIX_SPARSE_FUNC(name, type, CLIP)                                \
+static void                                                                   \
+mix_sparse_##name (AudioConvertCtx * this, const type * in, type * out,      \
+    gint frames)                                                              \
+{                                                                             \
+  const gint ic = this->in.channels, oc = this->out.channels;                 \
+  const gint *terms = this->mix_terms;                                        \
+  gint n, o, k;                                                               \
+  gdouble res;                                                                \
+                                                                              \
+  for (n = 0; n < frames; n++) {                                              \
+    for (o = 0; o < oc; o++) {                                                \
+      const gint *index = &this->mix_index[o * ic];                           \
+      const gdouble *values = &this->mix_values[o * ic];                      \
+                                                                              \
+      if (terms[o] < 0) {                                                     \
+        res = values[0] * mix_sum_##name (in, ic);                            \
+      } else {                                                                \
+        res = 0.0;                                                            \
+        for (k = 0; k < terms[o]; k++)                                        \
+          res += in[index[k]] * values[k];                                    \
+      }                                                                       \
+      out[o] = CLIP (res);                                                    \
+    }                                                                         \
+    in += ic;                                                                 \
+    out += oc;                                                                \
+  }                                                                           \
+}
+
+/* every output channel is a copy of at most one input channel */
+#define MAKE_MIX_GATHER_FUNC(name, type, COPY)                                \
+static void                                                                   \
+mix_gather_##name (AudioConvertCtx * this, const type * in, type * out,      \
+    gint frames)                                                              \
+{                                                                             \
+  const gint ic = this->in.channels, oc = this->out.channels;                 \
+  const gint *terms = this->mix_terms;                                        \
+  const gint *index = this->mix_index;                                        \
+  gint n, o;                                                                  \
+                                                                              \
+  for (n = 0; n < frames; n++) {                                              \
+    for (o = 0; o < oc; o++)                                                  \
+      out[o] = terms[o] ? COPY (in[index[o * ic]]) : 0;                       \
+    in += ic;                                                                 \
+    out += oc;                                                                \
+  }                                                                           \
+}
+
+/* common layouts with the channel counts known at compile time so that the
+ * loops get unrolled and the coefficients stay in registers */
+#define MAKE_MIX_FIXED_FUNC(name, type, CLIP, ic, oc)                         \
+static void                                                                   \
+mix_##ic##_##oc##_##name (AudioConvertCtx * this, const type * in,           \
+    type * out, gint frames)                                                  \
+{                                                                             \
+  gdouble m[ic * oc], acc[oc];                                                \
+  gint n, i, o;                                                               \
+                                                                              \
+  memcpy (m, this->mix_coeffs, sizeof (m));                                   \
+  for (n = 0; n < frames; n++) {                                              \
+    for (o = 0; o < oc; o++)                                                  \
+      acc[o] = 0.0;                                                           \
+    for (i = 0; i < ic; i++)                                                  \
+      for (o = 0; o < oc; o++)                                                \
+        acc[o] += in[i] * m[i * oc + o];                                      \
+    for (o = 0; o < oc; o++)                                                  \
+      out[o] = CLIP (acc[o]);                                                 \
+    in += ic;                                                                 \
+    out += oc;                                                                \
+  }                                                                           \
+}
+
+#define MAKE_MIX_FUNCS(name, type, CLIP, COPY)                                \
+  MAKE_MIX_DENSE_FUNC (name, type, CLIP)                                      \
+  MAKE_MIX_SPARSE_FUNC (name, type, CLIP)                                     \
+  MAKE_MIX_GATHER_FUNC (name, type, COPY)                                     \
+  MAKE_MIX_FIXED_FUNC (name, type, CLIP, 1, 2)                                \
+  MAKE_MIX_FIXED_FUNC (name, type, CLIP, 2, 1)                                \
+  MAKE_MIX_FIXED_FUNC (name, type, CLIP, 6, 2)
+
+MAKE_MIX_FUNCS (int, gint32, CLIP_INT, COPY_INT);
+MAKE_MIX_FUNCS (float, gdouble, CLIP_FLOAT, COPY_FLOAT);
+
+typedef void (*ChannelMixFunc) (AudioConvertCtx *, gconstpointer, gpointer,
+    gint);
+
+/* indexed by MIX_KERNEL_* */
+static const ChannelMixFunc mix_int_funcs[] = {
+  (ChannelMixFunc) mix_dense_int,
+  (ChannelMixFunc) mix_sparse_int,
+  (ChannelMixFunc) mix_gather_int,
+  (ChannelMixFunc) mix_1_2_int,
+  (ChannelMixFunc) mix_2_1_int,
+  (ChannelMixFunc) mix_6_2_int
+};
+
+static const ChannelMixFunc mix_float_funcs[] = {
+  (ChannelMixFunc) mix_dense_float,
+  (ChannelMixFunc) mix_sparse_float,
+  (ChannelMixFunc) mix_gather_float,
+  (ChannelMixFunc) mix_1_2_float,
+  (ChannelMixFunc) mix_2_1_float,
+  (ChannelMixFunc) mix_6_2_float
+};
+
+/* IMPORTANT: out_data == in_data is possible. In that case mix blocks of
+ * frames into the temp storage and copy them over, going backwards when
+ * there are more output than input channels so that no input frame is
+ * overwritten before it was read. */
+static void
+gst_channel_mix_run (AudioConvertCtx * this, ChannelMixFunc func,
+    guint8 * in_data, guint8 * out_data, gint samples, gsize width)
+{
+  gsize in_bpf = this->in.channels * width;
+  gsize out_bpf = this->out.channels * width;
+  gint n, len;
+
+  if (in_data != out_data) {
+    func (this, in_data, out_data, samples);
+    return;
+  }
+
+  if (this->out.channels > this->in.channels) {
+    for (n = samples; n > 0; n -= len) {
+      len = MIN (n, MIX_BLOCK_FRAMES);
+      func (this, in_data + (n - len) * in_bpf, this->tmp, len);
+      memcpy (out_data + (n - len) * out_bpf, this->tmp, len * out_bpf);
+    }
+  } else {
+    for (n = 0; n < samples; n += len) {
+      len = MIN (samples - n, MIX_BLOCK_FRAMES);
+      func (this, in_data + n * in_bpf, this->tmp, len);
+      memcpy (out_data + n * out_bpf, this->tmp, len * out_bpf);
+    }
+  }
+}
+
 void
 gst_channel_mix_mix_int (AudioConvertCtx * this,
     gint32 * in_data, gint32 * out_data, gint samples)
 {
-  gint in, out, n;
-  gint64 res;
-  gboolean backwards;
-  gint inchannels, outchannels;
-  gint32 *tmp = (gint32 *) this->tmp;
-
   g_return_if_fail (this->matrix != NULL);
   g_return_if_fail (this->tmp != NULL);
 
-  inchannels = this->in.channels;
-  outchannels = this->out.channels;
-  backwards = outchannels > inchannels;
-
-  /* FIXME: use orc here? */
-  for (n = (backwards ? samples - 1 : 0); n < samples && n >= 0;
-      backwards ? n-- : n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++) {
-        res += in_data[n * inchannels + in] * this->matrix[in][out];
-      }
-
-      /* clip (shouldn't we use doubles instead as intermediate format?) */
-      if (res < G_MININT32)
-        res = G_MININT32;
-      else if (res > G_MAXINT32)
-        res = G_MAXINT32;
-      tmp[out] = res;
-    }
-    memcpy (&out_data[n * outchannels], this->tmp,
-        sizeof (gint32) * outchannels);
-  }
+  gst_channel_mix_run (this, mix_int_funcs[this->mix_kernel],
+      (guint8 *) in_data, (guint8 *) out_data, samples, sizeof (gint32));
 }
 
 void
 gst_channel_mix_mix_float (AudioConvertCtx * this,
     gdouble * in_data, gdouble * out_data, gint samples)
 {
-  gint in, out, n;
-  gdouble res;
-  gboolean backwards;
-  gint inchannels, outchannels;
-  gdouble *tmp = (gdouble *) this->tmp;
-
   g_return_if_fail (this->matrix != NULL);
   g_return_if_fail (this->tmp != NULL);
 
-  inchannels = this->in.channels;
-  outchannels = this->out.channels;
-  backwards = outchannels > inchannels;
-
-  /* FIXME: use liboil here? */
-  for (n = (backwards ? samples - 1 : 0); n < samples && n >= 0;
-      backwards ? n-- : n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++) {
-        res += in_data[n * inchannels + in] * this->matrix[in][out];
-      }
-
-      /* clip (shouldn't we use doubles instead as intermediate format?) */
-      if (res < -1.0)
-        res = -1.0;
-      else if (res > 1.0)
-        res = 1.0;
-      tmp[out] = res;
-    }
-    memcpy (&out_data[n * outchannels], this->tmp,
-        sizeof (gdouble) * outchannels);
-  }
+  gst_channel_mix_run (this, mix_float_funcs[this->mix_kernel],
+      (guint8 *) in_data, (guint8 *) out_data, samples, sizeof (gdouble));
 }
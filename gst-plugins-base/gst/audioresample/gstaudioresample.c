@@ -42,10 +42,6 @@
  * </refsect2>
  */
 
-/* TODO:
- *  - Enable SSE/ARM optimizations and select at runtime
- */
-
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
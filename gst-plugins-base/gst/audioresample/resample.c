@@ -94,6 +94,15 @@
 #endif
 #endif
 
+/* The AVX kernels are built with function level target attributes, so they
+ * only need a compiler that supports those and are selected at runtime */
+#ifdef _USE_AVX
+#if !defined(__GNUC__) || !(defined(__x86_64__) || defined(__i386__)) || \
+    !(__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#undef _USE_AVX
+#endif
+#endif
+
 static inline void *
 speex_alloc (int size)
 {
@@ -144,6 +153,10 @@ speex_free (void *ptr)
 #include "resample_neon.h"
 #endif
 
+#ifdef _USE_AVX
+#include "resample_avx.h"
+#endif
+
 /* Numer of elements to allocate on the stack */
 #ifdef VAR_ARRAYS
 #define FIXED_STACK_ALLOC 8192
@@ -182,6 +195,16 @@ speex_free (void *ptr)
 #define NEON_FALLBACK(macro)
 #endif
 
+#ifdef _USE_AVX
+#define AVX_FALLBACK(macro) \
+  if (st->use_avx) goto avx_##macro##_avx; {
+#define AVX_IMPLEMENTATION(macro) \
+  goto avx_##macro##_end; } avx_##macro##_avx: {
+#define AVX_END(macro) avx_##macro##_end:; }
+#else
+#define AVX_FALLBACK(macro)
+#endif
+
 
 typedef int (*resampler_basic_func) (SpeexResamplerState *, spx_uint32_t,
     const spx_word16_t *, spx_uint32_t *, spx_word16_t *, spx_uint32_t *);
@@ -222,6 +245,7 @@ struct SpeexResamplerState_
   int use_sse:1;
   int use_sse2:1;
   int use_neon:1;
+  int use_avx:1;
 };
 
 static double kaiser12_table[68] = {
@@ -477,6 +501,7 @@ resampler_basic_direct_single (SpeexResamplerState * st,
     const spx_word16_t *sinc = &sinc_table[samp_frac_num * N];
     const spx_word16_t *iptr = &in[last_sample];
 
+    AVX_FALLBACK (INNER_PRODUCT_SINGLE)
     SSE_FALLBACK (INNER_PRODUCT_SINGLE)
     NEON_FALLBACK (INNER_PRODUCT_SINGLE)
         sum = 0;
@@ -503,6 +528,11 @@ resampler_basic_direct_single (SpeexResamplerState * st,
     SSE_IMPLEMENTATION (INNER_PRODUCT_SINGLE)
         sum = inner_product_single (sinc, iptr, N);
     SSE_END (INNER_PRODUCT_SINGLE)
+#endif
+#if defined(OVERRIDE_INNER_PRODUCT_SINGLE_AVX) && defined(_USE_AVX)
+    AVX_IMPLEMENTATION (INNER_PRODUCT_SINGLE)
+        sum = inner_product_single_avx (sinc, iptr, N);
+    AVX_END (INNER_PRODUCT_SINGLE)
 #endif
     out[out_stride * out_sample++] = SATURATE32PSHR(sum, 15, 32767);
     last_sample += int_advance;
@@ -544,6 +574,7 @@ resampler_basic_direct_double (SpeexResamplerState * st,
     const spx_word16_t *sinc = &sinc_table[samp_frac_num * N];
     const spx_word16_t *iptr = &in[last_sample];
 
+    AVX_FALLBACK (INNER_PRODUCT_DOUBLE)
     SSE2_FALLBACK (INNER_PRODUCT_DOUBLE)
     double accum[4] = { 0, 0, 0, 0 };
 
@@ -558,6 +589,11 @@ resampler_basic_direct_double (SpeexResamplerState * st,
     SSE2_IMPLEMENTATION (INNER_PRODUCT_DOUBLE)
         sum = inner_product_double (sinc, iptr, N);
     SSE2_END (INNER_PRODUCT_DOUBLE)
+#endif
+#if defined(OVERRIDE_INNER_PRODUCT_DOUBLE_AVX) && defined(_USE_AVX)
+    AVX_IMPLEMENTATION (INNER_PRODUCT_DOUBLE)
+        sum = inner_product_double_avx (sinc, iptr, N);
+    AVX_END (INNER_PRODUCT_DOUBLE)
 #endif
         out[out_stride * out_sample++] = PSHR32 (sum, 15);
     last_sample += int_advance;
@@ -1032,6 +1068,16 @@ speex_resampler_init_frac (spx_uint32_t nb_channels, spx_uint32_t ratio_num,
 
   st->use_sse = st->use_sse2 = 0;
   st->use_neon = 0;
+  st->use_avx = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  /* always available on this architecture, no need to ask Orc */
+#ifdef _USE_SSE
+  st->use_sse = 1;
+#endif
+#ifdef _USE_SSE2
+  st->use_sse2 = 1;
+#endif
+#endif
 #if defined HAVE_ORC && !defined DISABLE_ORC
   orc_init ();
   {
@@ -1046,6 +1092,15 @@ speex_resampler_init_frac (spx_uint32_t nb_channels, spx_uint32_t ratio_num,
       }
     }
   }
+#endif
+#ifdef _USE_AVX
+  __builtin_cpu_init ();
+#ifdef FIXED_POINT
+  st->use_avx = __builtin_cpu_supports ("avx2") ? 1 : 0;
+#else
+  st->use_avx = (__builtin_cpu_supports ("avx")
+      && __builtin_cpu_supports ("fma")) ? 1 : 0;
+#endif
 #endif
 
   /* Per channel data */
@@ -0,0 +1,159 @@
+/* Copyright (C) 2013 GStreamer developers
+ */
+/**
+   @file resample_avx.h
+   @brief Resampler functions (AVX/FMA and AVX2 versions)
+*/
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+   
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+   
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+   
+   - Neither the name of the Xiph.org Foundation nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE FOUNDATION OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* The functions in here are compiled for AVX, FMA and AVX2 independent of the
+   compiler flags and are only called after checking at runtime that the CPU
+   supports them. Filter lengths are always a multiple of 4. */
+
+#include <immintrin.h>
+
+#ifdef FIXED_POINT
+#define OVERRIDE_INNER_PRODUCT_SINGLE_AVX
+static spx_word32_t __attribute__ ((target ("avx2")))
+inner_product_single_avx (const spx_int16_t *a, const spx_int16_t *b, unsigned int len)
+{
+   unsigned int i = 0;
+   __m256i sum = _mm256_setzero_si256();
+   __m128i s;
+
+   for (; i + 16 <= len; i += 16)
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(
+          _mm256_loadu_si256((const __m256i *) (a + i)),
+          _mm256_loadu_si256((const __m256i *) (b + i))));
+   s = _mm_add_epi32(_mm256_castsi256_si128(sum),
+       _mm256_extracti128_si256(sum, 1));
+   for (; i + 8 <= len; i += 8)
+      s = _mm_add_epi32(s, _mm_madd_epi16(
+          _mm_loadu_si128((const __m128i *) (a + i)),
+          _mm_loadu_si128((const __m128i *) (b + i))));
+   if (i < len)
+      s = _mm_add_epi32(s, _mm_madd_epi16(
+          _mm_loadl_epi64((const __m128i *) (a + i)),
+          _mm_loadl_epi64((const __m128i *) (b + i))));
+   s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+   s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+   return _mm_cvtsi128_si32(s);
+}
+#else /* FIXED_POINT */
+
+#ifndef DOUBLE_PRECISION
+#define OVERRIDE_INNER_PRODUCT_SINGLE_AVX
+static float __attribute__ ((target ("avx,fma")))
+inner_product_single_avx (const float *a, const float *b, unsigned int len)
+{
+   unsigned int i = 0;
+   float ret;
+   __m256 sum0 = _mm256_setzero_ps();
+   __m256 sum1 = _mm256_setzero_ps();
+   __m128 s;
+
+   for (; i + 16 <= len; i += 16)
+   {
+      sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i), sum0);
+      sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a+i+8), _mm256_loadu_ps(b+i+8), sum1);
+   }
+   if (i + 8 <= len)
+   {
+      sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a+i), _mm256_loadu_ps(b+i), sum0);
+      i += 8;
+   }
+   sum0 = _mm256_add_ps(sum0, sum1);
+   s = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+   if (i < len)
+      s = _mm_fmadd_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i), s);
+   s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+   s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+   _mm_store_ss(&ret, s);
+   _mm256_zeroupper();
+   return ret;
+}
+#endif
+
+#define OVERRIDE_INNER_PRODUCT_DOUBLE_AVX
+#ifdef DOUBLE_PRECISION
+static double __attribute__ ((target ("avx,fma")))
+inner_product_double_avx (const double *a, const double *b, unsigned int len)
+{
+   unsigned int i;
+   double ret;
+   __m256d sum0 = _mm256_setzero_pd();
+   __m256d sum1 = _mm256_setzero_pd();
+   __m128d s;
+
+   for (i = 0; i + 8 <= len; i += 8)
+   {
+      sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i), sum0);
+      sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i+4), _mm256_loadu_pd(b+i+4), sum1);
+   }
+   if (i < len)
+      sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(a+i), _mm256_loadu_pd(b+i), sum0);
+   sum0 = _mm256_add_pd(sum0, sum1);
+   s = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+   s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+   _mm_store_sd(&ret, s);
+   _mm256_zeroupper();
+   return ret;
+}
+#else
+/* single precision products accumulated in double precision like the C
+   version, so no FMA */
+static double __attribute__ ((target ("avx")))
+inner_product_double_avx (const float *a, const float *b, unsigned int len)
+{
+   unsigned int i;
+   double ret;
+   __m256d sum0 = _mm256_setzero_pd();
+   __m256d sum1 = _mm256_setzero_pd();
+   __m128d s;
+   __m128 t;
+
+   for (i = 0; i < len; i += 4)
+   {
+      t = _mm_mul_ps(_mm_loadu_ps(a+i), _mm_loadu_ps(b+i));
+      if (i & 4)
+         sum1 = _mm256_add_pd(sum1, _mm256_cvtps_pd(t));
+      else
+         sum0 = _mm256_add_pd(sum0, _mm256_cvtps_pd(t));
+   }
+   sum0 = _mm256_add_pd(sum0, sum1);
+   s = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+   s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+   _mm_store_sd(&ret, s);
+   _mm256_zeroupper();
+   return ret;
+}
+#endif
+
+#endif /* FIXED_POINT */
@@ -20,6 +20,7 @@
 #define _USE_SSE2
 #define FLOATING_POINT
 #define DOUBLE_PRECISION
+#define _USE_AVX
 #define OUTSIDE_SPEEX
 #define RANDOM_PREFIX resample_double
 
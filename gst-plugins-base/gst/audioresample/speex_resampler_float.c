@@ -20,6 +20,7 @@
 #define _USE_SSE
 #define _USE_SSE2
 #define _USE_NEON
+#define _USE_AVX
 #define FLOATING_POINT
 #define OUTSIDE_SPEEX
 #define RANDOM_PREFIX resample_float
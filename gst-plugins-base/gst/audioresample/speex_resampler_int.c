@@ -20,6 +20,7 @@
 #define FIXED_POINT 1
 #define OUTSIDE_SPEEX 1
 #define _USE_NEON
+#define _USE_AVX
 #define RANDOM_PREFIX resample_int
 
 #include "resample.c"
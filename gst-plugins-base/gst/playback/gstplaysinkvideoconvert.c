@@ -55,22 +55,31 @@ gst_play_sink_video_convert_add_conversion_elements (GstPlaySinkVideoConvert *
       self->use_converters, self->use_balance);
 
   if (self->use_converters) {
-    el = gst_play_sink_convert_bin_add_conversion_element_factory (cbin,
-        COLORSPACE, "conv");
-    if (el)
-      prev = el;
-
-    el = gst_play_sink_convert_bin_add_conversion_element_factory (cbin,
-        "videoscale", "scale");
+    /* prefer converting and scaling in one pass */
+    el = gst_element_factory_make ("videoconvertscale", "convscale");
     if (el) {
+      gst_play_sink_convert_bin_add_conversion_element (cbin, el);
       /* Add black borders if necessary to keep the DAR */
       g_object_set (el, "add-borders", TRUE, NULL);
-      if (prev) {
-        if (!gst_element_link_pads_full (prev, "src", el, "sink",
-                GST_PAD_LINK_CHECK_TEMPLATE_CAPS))
-          goto link_failed;
-      }
       prev = el;
+    } else {
+      el = gst_play_sink_convert_bin_add_conversion_element_factory (cbin,
+          COLORSPACE, "conv");
+      if (el)
+        prev = el;
+
+      el = gst_play_sink_convert_bin_add_conversion_element_factory (cbin,
+          "videoscale", "scale");
+      if (el) {
+        /* Add black borders if necessary to keep the DAR */
+        g_object_set (el, "add-borders", TRUE, NULL);
+        if (prev) {
+          if (!gst_element_link_pads_full (prev, "src", el, "sink",
+                  GST_PAD_LINK_CHECK_TEMPLATE_CAPS))
+            goto link_failed;
+        }
+        prev = el;
+      }
     }
   }
 
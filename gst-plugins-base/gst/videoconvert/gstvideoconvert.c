@@ -25,6 +25,9 @@
  *
  * Convert video frames between a great variety of video formats.
  *
+ * Frames can be converted in bands of lines on multiple threads with the
+ * #GstVideoFilter:n-threads property.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
@@ -87,8 +90,11 @@ static void gst_video_convert_get_property (GObject * object,
 static gboolean gst_video_convert_set_info (GstVideoFilter * filter,
     GstCaps * incaps, GstVideoInfo * in_info, GstCaps * outcaps,
     GstVideoInfo * out_info);
-static GstFlowReturn gst_video_convert_transform_frame (GstVideoFilter * filter,
-    GstVideoFrame * in_frame, GstVideoFrame * out_frame);
+static void gst_video_convert_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer);
+static GstFlowReturn gst_video_convert_transform_frame_slice (GstVideoFilter *
+    filter, GstVideoFrame * in_frame, GstVideoFrame * out_frame, guint y,
+    guint height);
 
 static GType
 dither_method_get_type (void)
@@ -451,13 +457,15 @@ gst_video_convert_class_init (GstVideoConvertClass * klass)
       GST_DEBUG_FUNCPTR (gst_video_convert_filter_meta);
   gstbasetransform_class->transform_meta =
       GST_DEBUG_FUNCPTR (gst_video_convert_transform_meta);
+  gstbasetransform_class->before_transform =
+      GST_DEBUG_FUNCPTR (gst_video_convert_before_transform);
 
   gstbasetransform_class->passthrough_on_same_caps = TRUE;
 
   gstvideofilter_class->set_info =
       GST_DEBUG_FUNCPTR (gst_video_convert_set_info);
-  gstvideofilter_class->transform_frame =
-      GST_DEBUG_FUNCPTR (gst_video_convert_transform_frame);
+  gstvideofilter_class->transform_frame_slice =
+      GST_DEBUG_FUNCPTR (gst_video_convert_transform_frame_slice);
 
   g_object_class_install_property (gobject_class, PROP_DITHER,
       g_param_spec_enum ("dither", "Dither", "Apply dithering while converting",
@@ -506,22 +514,37 @@ gst_video_convert_get_property (GObject * object, guint property_id,
   }
 }
 
+/* the dither method is only changed between frames, never while the slices
+ * of a frame are being converted */
+static void
+gst_video_convert_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer)
+{
+  GstVideoConvert *space;
+
+  space = GST_VIDEO_CONVERT_CAST (trans);
+
+  if (space->convert)
+    videoconvert_convert_set_dither (space->convert, space->dither);
+}
+
+/* called concurrently for different lines */
 static GstFlowReturn
-gst_video_convert_transform_frame (GstVideoFilter * filter,
-    GstVideoFrame * in_frame, GstVideoFrame * out_frame)
+gst_video_convert_transform_frame_slice (GstVideoFilter * filter,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame, guint y,
+    guint height)
 {
   GstVideoConvert *space;
 
   space = GST_VIDEO_CONVERT_CAST (filter);
 
   GST_CAT_DEBUG_OBJECT (GST_CAT_PERFORMANCE, filter,
-      "doing colorspace conversion from %s -> to %s",
+      "doing colorspace conversion from %s -> to %s, lines %u-%u",
       GST_VIDEO_INFO_NAME (&filter->in_info),
-      GST_VIDEO_INFO_NAME (&filter->out_info));
-
-  videoconvert_convert_set_dither (space->convert, space->dither);
+      GST_VIDEO_INFO_NAME (&filter->out_info), y, y + height);
 
-  videoconvert_convert_convert (space->convert, out_frame, in_frame);
+  videoconvert_convert_convert_lines (space->convert, out_frame, in_frame, y,
+      height);
 
   return GST_FLOW_OK;
 }
@@ -33,6 +33,8 @@
 
 static void videoconvert_convert_generic (VideoConvert * convert,
     GstVideoFrame * dest, const GstVideoFrame * src);
+static void videoconvert_convert_generic_scaled (VideoConvert * convert,
+    GstVideoFrame * dest, const GstVideoFrame * src);
 static void videoconvert_convert_matrix8 (VideoConvert * convert,
     gpointer pixels);
 static void videoconvert_convert_matrix16 (VideoConvert * convert,
@@ -40,11 +42,27 @@ static void videoconvert_convert_matrix16 (VideoConvert * convert,
 static gboolean videoconvert_convert_lookup_fastpath (VideoConvert * convert);
 static gboolean videoconvert_convert_compute_matrix (VideoConvert * convert);
 static gboolean videoconvert_convert_compute_resample (VideoConvert * convert);
+static gpointer *videoconvert_convert_alloc_tmplines (VideoConvert * convert);
 static void videoconvert_dither_verterr (VideoConvert * convert,
     guint16 * pixels, int j);
 static void videoconvert_dither_halftone (VideoConvert * convert,
     guint16 * pixels, int j);
 
+/* number of lines that the generic converter processes before and after a
+ * band so that the chroma resamplers see the same lines as when converting
+ * the complete frame, this is larger than the reach of all resamplers and a
+ * multiple of every band alignment */
+#define BAND_OVERLAP 8
+
+/* the largest ring of scaled input lines, for 4 taps and upsampling 4 lines
+ * at a time from the fields of interlaced frames */
+#define MAX_RING 16
+
+typedef struct
+{
+  gpointer *tmplines;
+  guint16 *errline;
+} VideoConvertScratch;
 
 VideoConvert *
 videoconvert_convert_new (GstVideoInfo * in_info, GstVideoInfo * out_info)
@@ -60,6 +78,11 @@ videoconvert_convert_new (GstVideoInfo * in_info, GstVideoInfo * out_info)
 
   convert->width = GST_VIDEO_INFO_WIDTH (in_info);
   convert->height = GST_VIDEO_INFO_HEIGHT (in_info);
+  convert->out_width = convert->width;
+  convert->out_height = convert->height;
+  convert->tmpline_width = convert->width;
+
+  width = convert->width;
 
   if (!videoconvert_convert_lookup_fastpath (convert)) {
     convert->convert = videoconvert_convert_generic;
@@ -68,13 +91,122 @@ videoconvert_convert_new (GstVideoInfo * in_info, GstVideoInfo * out_info)
 
     if (!videoconvert_convert_compute_resample (convert))
       goto no_convert;
+  } else {
+    /* the fastpaths use one temp line to convert the last line of frames
+     * with an odd height */
+    convert->n_tmplines = 1;
   }
-
-  width = convert->width;
+  convert->tmplines = videoconvert_convert_alloc_tmplines (convert);
 
   convert->lines = out_info->finfo->pack_lines;
   convert->errline = g_malloc0 (sizeof (guint16) * width * 4);
 
+  convert->band_align = 1 << MAX (in_info->finfo->h_sub[2],
+      out_info->finfo->h_sub[2]);
+  if (GST_VIDEO_INFO_IS_INTERLACED (in_info))
+    convert->band_align *= 2;
+  convert->scratch = g_async_queue_new ();
+  convert->pack_start = 0;
+  convert->pack_end = convert->height;
+  convert->line_offset = 0;
+
+  return convert;
+
+  /* ERRORS */
+no_convert:
+  {
+    videoconvert_convert_free (convert);
+    return NULL;
+  }
+}
+
+/* Creates a converter that also scales the input to the @width x @height
+ * rectangle at @x, @y of the output with the kernels of @scaler. Every
+ * output line is made from the scaled input lines that it needs, so the
+ * input is unpacked, converted and scaled horizontally once per line and
+ * only into a few temp lines. For interlaced frames @y must be even and
+ * the fields are scaled separately. */
+VideoConvert *
+videoconvert_convert_new_scaled (GstVideoInfo * in_info,
+    GstVideoInfo * out_info, const VideoConvertScaler * scaler, gint x,
+    gint y, gint width, gint height)
+{
+  VideoConvert *convert;
+  const GstVideoFormatInfo *wfinfo;
+  gint offset[4], scale[4];
+
+  g_return_val_if_fail (scaler->n_taps >= 1 && scaler->n_taps <= 4, NULL);
+  g_return_val_if_fail (x >= 0 && width > 0
+      && x + width <= GST_VIDEO_INFO_WIDTH (out_info), NULL);
+  g_return_val_if_fail (y >= 0 && height > 0
+      && y + height <= GST_VIDEO_INFO_HEIGHT (out_info), NULL);
+
+  convert = g_malloc0 (sizeof (VideoConvert));
+
+  convert->in_info = *in_info;
+  convert->out_info = *out_info;
+  convert->dither16 = NULL;
+
+  convert->width = GST_VIDEO_INFO_WIDTH (in_info);
+  convert->height = GST_VIDEO_INFO_HEIGHT (in_info);
+  convert->out_width = GST_VIDEO_INFO_WIDTH (out_info);
+  convert->out_height = GST_VIDEO_INFO_HEIGHT (out_info);
+  convert->tmpline_width = MAX (convert->width, convert->out_width);
+
+  convert->scaler = *scaler;
+  convert->scale_x = x;
+  convert->scale_y = y;
+  convert->scale_width = width;
+  convert->scale_height = height;
+
+  convert->convert = videoconvert_convert_generic_scaled;
+  if (!videoconvert_convert_compute_matrix (convert))
+    goto no_convert;
+  if (!videoconvert_convert_compute_resample (convert))
+    goto no_convert;
+
+  /* the lines are scaled with the depth of the matrix */
+  if (convert->in_bits == 16 || convert->out_bits == 16)
+    convert->scale_bits = 16;
+  else
+    convert->scale_bits = 8;
+
+  convert->n_ring = scaler->n_taps + convert->up_n_lines;
+  if (GST_VIDEO_INFO_IS_INTERLACED (in_info))
+    convert->n_ring *= 2;
+  g_assert (convert->n_ring <= MAX_RING);
+
+  /* the temp lines are the input lines for the upsampler, the ring of
+   * scaled lines and the output lines for the downsampler */
+  convert->n_tmplines = convert->up_n_lines + convert->n_ring +
+      convert->down_n_lines;
+  convert->tmplines = videoconvert_convert_alloc_tmplines (convert);
+
+  /* black in the range of the output */
+  if (GST_VIDEO_INFO_IS_RGB (out_info))
+    wfinfo = gst_video_format_get_info (convert->scale_bits == 16 ?
+        GST_VIDEO_FORMAT_ARGB64 : GST_VIDEO_FORMAT_ARGB);
+  else
+    wfinfo = gst_video_format_get_info (convert->scale_bits == 16 ?
+        GST_VIDEO_FORMAT_AYUV64 : GST_VIDEO_FORMAT_AYUV);
+  gst_video_color_range_offsets (out_info->colorimetry.range, wfinfo, offset,
+      scale);
+  convert->border[0] = (1 << convert->scale_bits) - 1;
+  convert->border[1] = offset[0];
+  convert->border[2] = offset[1];
+  convert->border[3] = offset[2];
+
+  convert->lines = out_info->finfo->pack_lines;
+  convert->errline = g_malloc0 (sizeof (guint16) * convert->out_width * 4);
+
+  convert->band_align = 1 << out_info->finfo->h_sub[2];
+  if (GST_VIDEO_INFO_IS_INTERLACED (out_info))
+    convert->band_align *= 2;
+  convert->scratch = g_async_queue_new ();
+  convert->pack_start = 0;
+  convert->pack_end = convert->out_height;
+  convert->line_offset = 0;
+
   return convert;
 
   /* ERRORS */
@@ -100,6 +232,19 @@ videoconvert_convert_free (VideoConvert * convert)
   g_free (convert->tmplines);
   g_free (convert->errline);
 
+  if (convert->scratch) {
+    VideoConvertScratch *scratch;
+
+    while ((scratch = g_async_queue_try_pop (convert->scratch))) {
+      for (i = 0; i < convert->n_tmplines; i++)
+        g_free (scratch->tmplines[i]);
+      g_free (scratch->tmplines);
+      g_free (scratch->errline);
+      g_slice_free (VideoConvertScratch, scratch);
+    }
+    g_async_queue_unref (convert->scratch);
+  }
+
   g_free (convert);
 }
 
@@ -127,6 +272,124 @@ videoconvert_convert_convert (VideoConvert * convert,
   convert->convert (convert, dest, src);
 }
 
+static gpointer *
+videoconvert_convert_alloc_tmplines (VideoConvert * convert)
+{
+  gpointer *tmplines;
+  gint i;
+
+  tmplines = g_malloc (convert->n_tmplines * sizeof (gpointer));
+  for (i = 0; i < convert->n_tmplines; i++)
+    tmplines[i] =
+        g_malloc (sizeof (guint16) * (convert->tmpline_width + 8) * 4);
+
+  return tmplines;
+}
+
+static VideoConvertScratch *
+videoconvert_convert_scratch_new (VideoConvert * convert)
+{
+  VideoConvertScratch *scratch;
+
+  scratch = g_slice_new (VideoConvertScratch);
+  scratch->tmplines = videoconvert_convert_alloc_tmplines (convert);
+  scratch->errline = g_malloc0 (sizeof (guint16) * convert->out_width * 4);
+
+  return scratch;
+}
+
+/* move the start of all planes of @frame to line @y and make it @height lines
+ * high, @y must be aligned to the vertical subsampling of the format */
+static void
+videoconvert_frame_band (GstVideoFrame * band, const GstVideoFrame * frame,
+    gint y, gint height)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint i, plane;
+
+  *band = *frame;
+  band->info.height = height;
+
+  /* palettes are not a component and are left alone */
+  for (i = 0; i < GST_VIDEO_FRAME_N_COMPONENTS (frame); i++) {
+    plane = GST_VIDEO_FORMAT_INFO_PLANE (finfo, i);
+    band->data[plane] = (guint8 *) frame->data[plane] +
+        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, i, y) *
+        GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+  }
+}
+
+static gint
+videoconvert_convert_align_line (VideoConvert * convert, gint line)
+{
+  if (line >= convert->out_height)
+    return convert->out_height;
+
+  return (line / convert->band_align) * convert->band_align;
+}
+
+/* Convert the lines @y to @y + @height of @src to @dest. This can be called
+ * concurrently for different lines of the same frames. The band boundaries
+ * are moved to the chroma subsampling of both formats so that the bands of a
+ * frame still cover every line exactly once. When scaling, @y and @height
+ * are output lines. */
+void
+videoconvert_convert_convert_lines (VideoConvert * convert,
+    GstVideoFrame * dest, const GstVideoFrame * src, gint y, gint height)
+{
+  VideoConvert band;
+  VideoConvertScratch *scratch;
+  GstVideoFrame band_dest, band_src;
+  gint start, end, band_start, band_end;
+
+  if (y == 0 && height >= convert->out_height) {
+    convert->convert (convert, dest, src);
+    return;
+  }
+
+  start = videoconvert_convert_align_line (convert, y);
+  end = videoconvert_convert_align_line (convert, y + height);
+  if (start >= end)
+    return;
+
+  scratch = g_async_queue_try_pop (convert->scratch);
+  if (scratch == NULL)
+    scratch = videoconvert_convert_scratch_new (convert);
+
+  band = *convert;
+  band.tmplines = scratch->tmplines;
+  band.errline = scratch->errline;
+
+  /* the scaler reads the input lines that it needs from the complete frame */
+  if (convert->convert == videoconvert_convert_generic_scaled) {
+    band.pack_start = start;
+    band.pack_end = end;
+    band.convert (&band, dest, src);
+    g_async_queue_push (convert->scratch, scratch);
+    return;
+  }
+
+  band_start = start;
+  band_end = end;
+  /* the resamplers of the generic converter need the neighbouring lines */
+  if (convert->convert == videoconvert_convert_generic) {
+    band_start = MAX (0, start - BAND_OVERLAP);
+    band_end = MIN (convert->height, end + BAND_OVERLAP);
+  }
+
+  band.height = band_end - band_start;
+  band.pack_start = start - band_start;
+  band.pack_end = end - band_start;
+  band.line_offset = band_start;
+
+  videoconvert_frame_band (&band_dest, dest, band_start, band.height);
+  videoconvert_frame_band (&band_src, src, band_start, band.height);
+
+  band.convert (&band, &band_dest, &band_src);
+
+  g_async_queue_push (convert->scratch, scratch);
+}
+
 #define SCALE    (8)
 #define SCALE_F  ((float) (1 << SCALE))
 
@@ -345,7 +608,7 @@ videoconvert_dither_verterr (VideoConvert * convert, guint16 * pixels, int j)
   guint16 *errline = convert->errline;
   unsigned int mask = 0xff;
 
-  for (i = 0; i < 4 * convert->width; i++) {
+  for (i = 0; i < 4 * convert->out_width; i++) {
     int x = pixels[i] + errline[i];
     if (x > 65535)
       x = 65535;
@@ -369,7 +632,7 @@ videoconvert_dither_halftone (VideoConvert * convert, guint16 * pixels, int j)
     {252, 142, 220, 92, 244, 116, 212, 84}
   };
 
-  for (i = 0; i < convert->width * 4; i++) {
+  for (i = 0; i < convert->out_width * 4; i++) {
     int x;
     x = pixels[i] + halftone[(i >> 2) & 7][j & 7];
     if (x > 65535)
@@ -383,8 +646,6 @@ videoconvert_convert_compute_resample (VideoConvert * convert)
 {
   GstVideoInfo *in_info, *out_info;
   const GstVideoFormatInfo *sfinfo, *dfinfo;
-  gint lines, i;
-  gint width;
 
   in_info = &convert->in_info;
   out_info = &convert->out_info;
@@ -392,8 +653,6 @@ videoconvert_convert_compute_resample (VideoConvert * convert)
   sfinfo = in_info->finfo;
   dfinfo = out_info->finfo;
 
-  width = convert->width;
-
   convert->upsample = gst_video_chroma_resample_new (0,
       in_info->chroma_site, 0, sfinfo->unpack_format, sfinfo->w_sub[2],
       sfinfo->h_sub[2]);
@@ -421,12 +680,7 @@ videoconvert_convert_compute_resample (VideoConvert * convert)
   GST_DEBUG ("downsample: %p, offset %d, n_lines %d", convert->downsample,
       convert->down_offset, convert->down_n_lines);
 
-  lines = MAX (convert->down_n_lines, convert->up_n_lines);
-
-  convert->n_tmplines = lines;
-  convert->tmplines = g_malloc (lines * sizeof (gpointer));
-  for (i = 0; i < lines; i++)
-    convert->tmplines[i] = g_malloc (sizeof (guint16) * (width + 8) * 4);
+  convert->n_tmplines = MAX (convert->down_n_lines, convert->up_n_lines);
 
   return TRUE;
 }
@@ -561,7 +815,8 @@ videoconvert_convert_generic (VideoConvert * convert, GstVideoFrame * dest,
         if (convert->matrix)
           convert->matrix (convert, in_tmplines[k]);
         if (convert->dither16)
-          convert->dither16 (convert, in_tmplines[k], down_line);
+          convert->dither16 (convert, in_tmplines[k],
+              down_line + convert->line_offset);
 
         if (out_bits == 8)
           convert_to8 (in_tmplines[k], width);
@@ -581,7 +836,7 @@ videoconvert_convert_generic (VideoConvert * convert, GstVideoFrame * dest,
       for (j = 0; j < down_n_lines; j += lines) {
         idx = down_offset + j;
 
-        if (idx >= 0 && idx < height) {
+        if (idx >= convert->pack_start && idx < convert->pack_end) {
           GST_DEBUG ("packing line %d %d %d", j + start, down_offset, idx);
           /* FIXME, not correct if lines > 1 */
           PACK_FRAME (dest, out_tmplines[j + start], idx, width);
@@ -600,6 +855,189 @@ videoconvert_convert_generic (VideoConvert * convert, GstVideoFrame * dest,
   }
 }
 
+/* fills @width pixels from @x of @line with the border color */
+static void
+videoconvert_fill_border (VideoConvert * convert, gpointer line, gint x,
+    gint width)
+{
+  gint i;
+
+  if (convert->scale_bits == 16) {
+    guint16 *p = (guint16 *) line + x * 4;
+
+    for (i = 0; i < width; i++) {
+      p[i * 4 + 0] = convert->border[0];
+      p[i * 4 + 1] = convert->border[1];
+      p[i * 4 + 2] = convert->border[2];
+      p[i * 4 + 3] = convert->border[3];
+    }
+  } else {
+    guint8 *p = (guint8 *) line + x * 4;
+
+    for (i = 0; i < width; i++) {
+      p[i * 4 + 0] = convert->border[0];
+      p[i * 4 + 1] = convert->border[1];
+      p[i * 4 + 2] = convert->border[2];
+      p[i * 4 + 3] = convert->border[3];
+    }
+  }
+}
+
+/* Returns the temp line with line @line of field @field of the input,
+ * converted and scaled horizontally. The input is upsampled in groups of
+ * lines, all lines of the group that are in the frame are scaled into the
+ * ring and @ring_line keeps track of the input line in each slot. */
+static gpointer
+videoconvert_scale_get_line (VideoConvert * convert, const GstVideoFrame * src,
+    gint * ring_line, gint line, gint field, gint step, gint height)
+{
+  gpointer *in_lines, *ring;
+  gint up_n_lines, start, k, l, slot;
+
+  up_n_lines = convert->up_n_lines;
+  in_lines = convert->tmplines;
+  ring = convert->tmplines + up_n_lines;
+
+  slot = (line * step + field) % convert->n_ring;
+  if (ring_line[slot] == line * step + field)
+    return ring[slot];
+
+  start = line - (line - convert->up_offset) % up_n_lines;
+
+  /* lines outside of the frame repeat the edge for the upsampler */
+  for (k = 0; k < up_n_lines; k++) {
+    l = CLAMP (start + k, 0, height - 1);
+    UNPACK_FRAME (src, in_lines[k], l * step + field, convert->width);
+  }
+
+  if (convert->upsample)
+    gst_video_chroma_resample (convert->upsample, in_lines, convert->width);
+
+  for (k = 0; k < up_n_lines; k++) {
+    l = start + k;
+    if (l < 0 || l >= height)
+      continue;
+
+    if (convert->scale_bits == 16 && convert->in_bits == 8)
+      convert_to16 (in_lines[k], convert->width);
+    if (convert->matrix)
+      convert->matrix (convert, in_lines[k]);
+
+    l = l * step + field;
+    slot = l % convert->n_ring;
+    convert->scaler.hscale (&convert->scaler, ring[slot], in_lines[k],
+        convert->width, convert->scale_width, convert->scale_bits);
+    ring_line[slot] = l;
+  }
+
+  return ring[(line * step + field) % convert->n_ring];
+}
+
+/* makes output line @y in @dest from the scaled input lines */
+static void
+videoconvert_scale_line (VideoConvert * convert, const GstVideoFrame * src,
+    gint * ring_line, gpointer dest, gint y)
+{
+  const VideoConvertScaler *scaler = &convert->scaler;
+  gpointer lines[4];
+  gint r, field, step, line, in_height, out_height, first, k;
+  gint64 increment, pos;
+
+  r = y - convert->scale_y;
+  if (r < 0 || r >= convert->scale_height) {
+    videoconvert_fill_border (convert, dest, 0, convert->out_width);
+    return;
+  }
+
+  if (convert->scale_x > 0)
+    videoconvert_fill_border (convert, dest, 0, convert->scale_x);
+  k = convert->scale_x + convert->scale_width;
+  if (k < convert->out_width)
+    videoconvert_fill_border (convert, dest, k, convert->out_width - k);
+
+  if (GST_VIDEO_INFO_IS_INTERLACED (&convert->in_info)) {
+    field = r & 1;
+    step = 2;
+    line = r >> 1;
+    in_height = (convert->height + 1 - field) / 2;
+    out_height = (convert->scale_height + 1 - field) / 2;
+  } else {
+    field = 0;
+    step = 1;
+    line = r;
+    in_height = convert->height;
+    out_height = convert->scale_height;
+  }
+
+  /* the position of the output line in the input in 16.16 */
+  if (out_height > 1)
+    increment = MAX (0, ((in_height - 1) << 16) / (out_height - 1) +
+        scaler->increment_bias);
+  else
+    increment = 0;
+  pos = line * increment;
+  first = (pos >> 16) - (scaler->n_taps - 1) / 2;
+
+  for (k = 0; k < scaler->n_taps; k++)
+    lines[k] = videoconvert_scale_get_line (convert, src, ring_line,
+        CLAMP (first + k, 0, in_height - 1), field, step, in_height);
+
+  scaler->vscale (scaler,
+      (guint8 *) dest + convert->scale_x * convert->scale_bits / 2, lines,
+      pos & 0xffff, convert->scale_width, convert->scale_bits);
+}
+
+/* Converts and scales the output lines from pack_start to pack_end. The
+ * lines are made in groups for the downsampler, a group at the end of the
+ * frame repeats the last line. */
+static void
+videoconvert_convert_generic_scaled (VideoConvert * convert,
+    GstVideoFrame * dest, const GstVideoFrame * src)
+{
+  gint ring_line[MAX_RING];
+  gpointer *out_lines;
+  gint down_n_lines, y, k, line;
+  gconstpointer pal;
+  gsize palsize;
+
+  for (k = 0; k < MAX_RING; k++)
+    ring_line[k] = -1;
+
+  down_n_lines = convert->down_n_lines;
+  out_lines = convert->tmplines + convert->up_n_lines + convert->n_ring;
+
+  for (y = convert->pack_start; y < convert->pack_end; y += down_n_lines) {
+    for (k = 0; k < down_n_lines; k++) {
+      line = MIN (y + k, convert->out_height - 1);
+
+      videoconvert_scale_line (convert, src, ring_line, out_lines[k], line);
+
+      if (convert->scale_bits == 16) {
+        if (convert->dither16)
+          convert->dither16 (convert, out_lines[k], line);
+        if (convert->out_bits == 8)
+          convert_to8 (out_lines[k], convert->out_width);
+      }
+    }
+
+    if (convert->downsample)
+      gst_video_chroma_resample (convert->downsample, out_lines,
+          convert->out_width);
+
+    for (k = 0; k < down_n_lines && y + k < convert->out_height;
+        k += convert->lines) {
+      /* FIXME, not correct if lines > 1 */
+      PACK_FRAME (dest, out_lines[k], y + k, convert->out_width);
+    }
+  }
+
+  if ((pal =
+          gst_video_format_get_palette (GST_VIDEO_FRAME_FORMAT (dest),
+              &palsize))) {
+    memcpy (GST_VIDEO_FRAME_PLANE_DATA (dest, 1), pal, palsize);
+  }
+}
+
 #define FRAME_GET_PLANE_STRIDE(frame, plane) \
   GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane)
 #define FRAME_GET_PLANE_LINE(frame, plane, line) \
@@ -876,6 +1314,58 @@ convert_UYVY_I420 (VideoConvert * convert, GstVideoFrame * dest,
   }
 }
 
+static void
+convert_YUY2_NV12 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  int i;
+  gint width = convert->width;
+  gint height = convert->height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+  gint l1, l2;
+
+  for (i = 0; i < GST_ROUND_DOWN_2 (height); i += 2) {
+    GET_LINE_OFFSETS (interlaced, i, l1, l2);
+
+    video_convert_orc_convert_YUY2_NV12 (FRAME_GET_PLANE_LINE (dest, 0, l1),
+        FRAME_GET_PLANE_LINE (dest, 0, l2),
+        FRAME_GET_PLANE_LINE (dest, 1, i >> 1),
+        FRAME_GET_LINE (src, l1), FRAME_GET_LINE (src, l2), (width + 1) / 2);
+  }
+
+  /* now handle last line */
+  if (height & 1) {
+    UNPACK_FRAME (src, convert->tmplines[0], height - 1, width);
+    PACK_FRAME (dest, convert->tmplines[0], height - 1, width);
+  }
+}
+
+static void
+convert_UYVY_NV12 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  int i;
+  gint width = convert->width;
+  gint height = convert->height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+  gint l1, l2;
+
+  for (i = 0; i < GST_ROUND_DOWN_2 (height); i += 2) {
+    GET_LINE_OFFSETS (interlaced, i, l1, l2);
+
+    video_convert_orc_convert_UYVY_NV12 (FRAME_GET_PLANE_LINE (dest, 0, l1),
+        FRAME_GET_PLANE_LINE (dest, 0, l2),
+        FRAME_GET_PLANE_LINE (dest, 1, i >> 1),
+        FRAME_GET_LINE (src, l1), FRAME_GET_LINE (src, l2), (width + 1) / 2);
+  }
+
+  /* now handle last line */
+  if (height & 1) {
+    UNPACK_FRAME (src, convert->tmplines[0], height - 1, width);
+    PACK_FRAME (dest, convert->tmplines[0], height - 1, width);
+  }
+}
+
 static void
 convert_UYVY_AYUV (VideoConvert * convert, GstVideoFrame * dest,
     const GstVideoFrame * src)
@@ -935,6 +1425,77 @@ convert_UYVY_Y444 (VideoConvert * convert, GstVideoFrame * dest,
       FRAME_GET_STRIDE (src), (width + 1) / 2, height);
 }
 
+/* NV12 and NV21 to any planar 4:2:0 format, the chroma planes are only
+ * deinterleaved so interlaced content does not need special care */
+static void
+convert_NV12_I420 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  gint width = convert->width;
+  gint height = convert->height;
+
+  video_convert_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0),
+      FRAME_GET_Y_STRIDE (dest), FRAME_GET_Y_LINE (src, 0),
+      FRAME_GET_Y_STRIDE (src), width, height);
+
+  video_convert_orc_convert_NV12_I420 (FRAME_GET_U_LINE (dest, 0),
+      FRAME_GET_U_STRIDE (dest), FRAME_GET_V_LINE (dest, 0),
+      FRAME_GET_V_STRIDE (dest), FRAME_GET_PLANE_LINE (src, 1, 0),
+      FRAME_GET_PLANE_STRIDE (src, 1), (width + 1) / 2, (height + 1) / 2);
+}
+
+static void
+convert_NV21_I420 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  gint width = convert->width;
+  gint height = convert->height;
+
+  video_convert_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0),
+      FRAME_GET_Y_STRIDE (dest), FRAME_GET_Y_LINE (src, 0),
+      FRAME_GET_Y_STRIDE (src), width, height);
+
+  video_convert_orc_convert_NV12_I420 (FRAME_GET_V_LINE (dest, 0),
+      FRAME_GET_V_STRIDE (dest), FRAME_GET_U_LINE (dest, 0),
+      FRAME_GET_U_STRIDE (dest), FRAME_GET_PLANE_LINE (src, 1, 0),
+      FRAME_GET_PLANE_STRIDE (src, 1), (width + 1) / 2, (height + 1) / 2);
+}
+
+/* any planar 4:2:0 format to NV12 and NV21 */
+static void
+convert_I420_NV12 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  gint width = convert->width;
+  gint height = convert->height;
+
+  video_convert_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0),
+      FRAME_GET_Y_STRIDE (dest), FRAME_GET_Y_LINE (src, 0),
+      FRAME_GET_Y_STRIDE (src), width, height);
+
+  video_convert_orc_convert_I420_NV12 (FRAME_GET_PLANE_LINE (dest, 1, 0),
+      FRAME_GET_PLANE_STRIDE (dest, 1), FRAME_GET_U_LINE (src, 0),
+      FRAME_GET_U_STRIDE (src), FRAME_GET_V_LINE (src, 0),
+      FRAME_GET_V_STRIDE (src), (width + 1) / 2, (height + 1) / 2);
+}
+
+static void
+convert_I420_NV21 (VideoConvert * convert, GstVideoFrame * dest,
+    const GstVideoFrame * src)
+{
+  gint width = convert->width;
+  gint height = convert->height;
+
+  video_convert_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0),
+      FRAME_GET_Y_STRIDE (dest), FRAME_GET_Y_LINE (src, 0),
+      FRAME_GET_Y_STRIDE (src), width, height);
+
+  video_convert_orc_convert_I420_NV12 (FRAME_GET_PLANE_LINE (dest, 1, 0),
+      FRAME_GET_PLANE_STRIDE (dest, 1), FRAME_GET_V_LINE (src, 0),
+      FRAME_GET_V_STRIDE (src), FRAME_GET_U_LINE (src, 0),
+      FRAME_GET_U_STRIDE (src), (width + 1) / 2, (height + 1) / 2);
+}
+
 static void
 convert_AYUV_I420 (VideoConvert * convert, GstVideoFrame * dest,
     const GstVideoFrame * src)
@@ -1325,6 +1886,28 @@ static const VideoTransform transforms[] = {
   {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_Y444,
       GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_UYVY_Y444},
 
+  {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_YUY2_NV12},
+  {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_UYVY_NV12},
+
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_I420,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_YV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV21, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_I420,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_NV21_I420},
+  {GST_VIDEO_FORMAT_NV21, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_YV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_NV21_I420},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV12,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV21,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_I420_NV21},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_NV21,
+      GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, TRUE, convert_I420_NV21},
+
   {GST_VIDEO_FORMAT_AYUV, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_I420,
       GST_VIDEO_COLOR_MATRIX_UNKNOWN, TRUE, FALSE, convert_AYUV_I420},
   {GST_VIDEO_FORMAT_AYUV, GST_VIDEO_COLOR_MATRIX_UNKNOWN, GST_VIDEO_FORMAT_YUY2,
@@ -1378,6 +1961,8 @@ static const VideoTransform transforms[] = {
 
   {GST_VIDEO_FORMAT_I420, GST_VIDEO_COLOR_MATRIX_BT601, GST_VIDEO_FORMAT_BGRA,
       GST_VIDEO_COLOR_MATRIX_RGB, FALSE, FALSE, convert_I420_BGRA},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_COLOR_MATRIX_BT601, GST_VIDEO_FORMAT_BGRx,
+      GST_VIDEO_COLOR_MATRIX_RGB, FALSE, FALSE, convert_I420_BGRA},     /* alias */
 #endif
 };
 
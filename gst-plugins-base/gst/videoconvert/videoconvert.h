@@ -26,6 +26,7 @@
 G_BEGIN_DECLS
 
 typedef struct _VideoConvert VideoConvert;
+typedef struct _VideoConvertScaler VideoConvertScaler;
 
 typedef enum {
   DITHER_NONE,
@@ -33,12 +34,32 @@ typedef enum {
   DITHER_HALFTONE
 } ColorSpaceDitherMethod;
 
+/* Scanline kernels for the generic converter when it also scales. The lines
+ * are AYUV with @bits 8 and AYUV64 with @bits 16. vscale combines the
+ * @n_taps input lines around the 16.16 position of an output line, the
+ * first one is (position >> 16) - (n_taps - 1) / 2 and @phase is the
+ * fraction of the position. @increment_bias is added to the 16.16
+ * increment between output lines. */
+struct _VideoConvertScaler {
+  guint n_taps;
+  gint increment_bias;
+
+  void (*hscale)       (const VideoConvertScaler *scaler, gpointer dest,
+                        gpointer src, gint src_width, gint dest_width,
+                        guint bits);
+  void (*vscale)       (const VideoConvertScaler *scaler, gpointer dest,
+                        gpointer lines[], gint phase, gint width, guint bits);
+};
+
 struct _VideoConvert {
   GstVideoInfo in_info;
   GstVideoInfo out_info;
 
   gint width;
   gint height;
+  /* size of the output frame */
+  gint out_width;
+  gint out_height;
 
   gint in_bits;
   gint out_bits;
@@ -50,8 +71,19 @@ struct _VideoConvert {
 
   guint n_tmplines;
   gpointer *tmplines;
+  gint tmpline_width;
   guint16 *errline;
 
+  /* bands of lines are aligned to this, the temp lines of bands that are
+   * converted concurrently come from the scratch queue */
+  gint band_align;
+  GAsyncQueue *scratch;
+  /* lines of the frame that are stored by the generic converter and the line
+   * of the full frame that corresponds to line 0 */
+  guint pack_start;
+  guint pack_end;
+  gint line_offset;
+
   GstVideoChromaResample *upsample;
   guint up_n_lines;
   gint up_offset;
@@ -59,6 +91,19 @@ struct _VideoConvert {
   guint down_n_lines;
   gint down_offset;
 
+  /* when scaling, the input is scaled to the rectangle at scale_x, scale_y
+   * of the output and the rest of the output is filled with the border
+   * color. Lines are scaled in scale_bits and the scaled input lines are
+   * kept in a ring of n_ring temp lines. */
+  VideoConvertScaler scaler;
+  gint scale_x;
+  gint scale_y;
+  gint scale_width;
+  gint scale_height;
+  guint scale_bits;
+  guint n_ring;
+  guint16 border[4];
+
   void (*convert)      (VideoConvert *convert, GstVideoFrame *dest, const GstVideoFrame *src);
   void (*matrix)       (VideoConvert *convert, gpointer pixels);
   void (*dither16)     (VideoConvert *convert, guint16 * pixels, int j);
@@ -67,12 +112,20 @@ struct _VideoConvert {
 
 VideoConvert *   videoconvert_convert_new            (GstVideoInfo *in_info,
                                                       GstVideoInfo *out_info);
+VideoConvert *   videoconvert_convert_new_scaled     (GstVideoInfo *in_info,
+                                                      GstVideoInfo *out_info,
+                                                      const VideoConvertScaler *scaler,
+                                                      gint x, gint y,
+                                                      gint width, gint height);
 void             videoconvert_convert_free           (VideoConvert * convert);
 
 void             videoconvert_convert_set_dither     (VideoConvert * convert, int type);
 
 void             videoconvert_convert_convert        (VideoConvert * convert,
                                                       GstVideoFrame *dest, const GstVideoFrame *src);
+void             videoconvert_convert_convert_lines  (VideoConvert * convert,
+                                                      GstVideoFrame *dest, const GstVideoFrame *src,
+                                                      gint y, gint height);
 
 
 G_END_DECLS
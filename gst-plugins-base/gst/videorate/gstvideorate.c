@@ -89,6 +89,7 @@ enum
 #define DEFAULT_DROP_ONLY       FALSE
 #define DEFAULT_AVERAGE_PERIOD  0
 #define DEFAULT_MAX_RATE        G_MAXINT
+#define DEFAULT_REPEAT_META     FALSE
 
 enum
 {
@@ -102,7 +103,8 @@ enum
   PROP_SKIP_TO_FIRST,
   PROP_DROP_ONLY,
   PROP_AVERAGE_PERIOD,
-  PROP_MAX_RATE
+  PROP_MAX_RATE,
+  PROP_REPEAT_META
 };
 
 static GstStaticPadTemplate gst_video_rate_src_template =
@@ -249,6 +251,20 @@ gst_video_rate_class_init (GstVideoRateClass * klass)
           1, G_MAXINT, DEFAULT_MAX_RATE,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstVideoRate:repeat-meta:
+   *
+   * Mark duplicated frames with a #GstVideoRepeatMeta that refers to the
+   * offset of the frame they repeat, so that downstream encoders and sinks
+   * can skip them.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (object_class, PROP_REPEAT_META,
+      g_param_spec_boolean ("repeat-meta", "Repeat Meta",
+          "Mark duplicated frames with a repeat meta",
+          DEFAULT_REPEAT_META, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "Video rate adjuster", "Filter/Effect/Video",
       "Drops/duplicates/adjusts timestamps on video frames to make a perfect stream",
@@ -567,6 +583,7 @@ gst_video_rate_init (GstVideoRate * videorate)
   videorate->average_period = DEFAULT_AVERAGE_PERIOD;
   videorate->average_period_set = DEFAULT_AVERAGE_PERIOD;
   videorate->max_rate = DEFAULT_MAX_RATE;
+  videorate->repeat_meta = DEFAULT_REPEAT_META;
 
   videorate->from_rate_numerator = 0;
   videorate->from_rate_denominator = 0;
@@ -599,10 +616,18 @@ gst_video_rate_flush_prev (GstVideoRate * videorate, gboolean duplicate)
   } else
     GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_DISCONT);
 
-  if (duplicate)
+  if (duplicate) {
     GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
-  else
+    videorate->repeat_count++;
+    /* the copy shares the memory of prevbuf, only the meta is added */
+    if (videorate->repeat_meta)
+      gst_buffer_add_video_repeat_meta (outbuf, videorate->repeat_of,
+          videorate->repeat_count);
+  } else {
     GST_BUFFER_FLAG_UNSET (outbuf, GST_BUFFER_FLAG_GAP);
+    videorate->repeat_of = videorate->out;
+    videorate->repeat_count = 0;
+  }
 
   /* this is the timestamp we put on the buffer */
   push_ts = videorate->next_ts;
@@ -1160,6 +1185,9 @@ gst_video_rate_set_property (GObject * object,
       g_atomic_int_set (&videorate->max_rate, g_value_get_int (value));
       goto reconfigure;
       break;
+    case PROP_REPEAT_META:
+      videorate->repeat_meta = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1210,6 +1238,9 @@ gst_video_rate_get_property (GObject * object,
     case PROP_MAX_RATE:
       g_value_set_int (value, g_atomic_int_get (&videorate->max_rate));
       break;
+    case PROP_REPEAT_META:
+      g_value_set_boolean (value, videorate->repeat_meta);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -22,6 +22,7 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstbasetransform.h>
+#include <gst/video/gstvideometa.h>
 
 G_BEGIN_DECLS
 
@@ -61,6 +62,9 @@ struct _GstVideoRate
                                  * frame rate caps change */
   gboolean discont;
   guint64 last_ts;              /* Timestamp of last input buffer */
+  guint64 repeat_of;            /* offset of the last frame that was not a
+                                 * duplicate */
+  guint repeat_count;           /* duplicates of it pushed so far */
 
   guint64 average_period;
   GstClockTimeDiff wanted_diff; /* target average diff */
@@ -76,6 +80,7 @@ struct _GstVideoRate
   gboolean skip_to_first;
   gboolean drop_only;
   guint64 average_period_set;
+  gboolean repeat_meta;
 
   volatile int max_rate;
 };
@@ -0,0 +1,564 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-videoconvertscale
+ * @see_also: videoscale, videoconvert
+ *
+ * This element converts and resizes video frames in one pass. It does the
+ * same as videoconvert ! videoscale but every output line is made directly
+ * from the input lines that it needs: the input lines are unpacked,
+ * converted and scaled horizontally into a few temp lines, which are then
+ * scaled vertically, subsampled and packed into the output. The frames are
+ * never stored at the intermediate size and format.
+ *
+ * When the formats on both sides are the same, the frames are scaled like
+ * videoscale does. When converting, the Lanczos method uses the 4-tap filter.
+ *
+ * <refsect2>
+ * <title>Example pipelines</title>
+ * |[
+ * gst-launch -v videotestsrc ! video/x-raw,format=I420,width=1920,height=1080 ! videoconvertscale ! video/x-raw,format=BGRx,width=640,height=360 ! ximagesink
+ * ]| Convert to BGRx and scale down in one step.
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstvideoconvertscale.h"
+#include "gstvideoscaleorc.h"
+#include "vs_scanline.h"
+#include "vs_4tap.h"
+
+#define CSP_VIDEO_CAPS GST_VIDEO_CAPS_MAKE (GST_VIDEO_FORMATS_ALL) ";" \
+    GST_VIDEO_CAPS_MAKE_WITH_FEATURES ("ANY", GST_VIDEO_FORMATS_ALL)
+
+static GstStaticPadTemplate gst_video_convert_scale_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CSP_VIDEO_CAPS)
+    );
+
+static GstStaticPadTemplate gst_video_convert_scale_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CSP_VIDEO_CAPS)
+    );
+
+static void gst_video_convert_scale_finalize (GObject * object);
+static GstCaps *gst_video_convert_scale_transform_caps (GstBaseTransform *
+    trans, GstPadDirection direction, GstCaps * caps, GstCaps * filter);
+static GstCaps *gst_video_convert_scale_fixate_caps (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, GstCaps * othercaps);
+static void gst_video_convert_scale_before_transform (GstBaseTransform *
+    trans, GstBuffer * buffer);
+static gboolean gst_video_convert_scale_set_info (GstVideoFilter * filter,
+    GstCaps * in, GstVideoInfo * in_info, GstCaps * out,
+    GstVideoInfo * out_info);
+static GstFlowReturn gst_video_convert_scale_transform_frame_slice
+    (GstVideoFilter * filter, GstVideoFrame * in_frame,
+    GstVideoFrame * out_frame, guint y, guint height);
+
+#define gst_video_convert_scale_parent_class parent_class
+G_DEFINE_TYPE (GstVideoConvertScale, gst_video_convert_scale,
+    GST_TYPE_VIDEO_SCALE);
+
+/* the scanline kernels of videoscale on the AYUV and AYUV64 lines of the
+ * converter, the increments are the same as in vs_image.c */
+static gint
+get_increment (gint src_size, gint dest_size, gint bias)
+{
+  if (dest_size == 1)
+    return 0;
+
+  return MAX (0, ((src_size - 1) << 16) / (dest_size - 1) + bias);
+}
+
+static void
+hscale_nearest (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer src, gint src_width, gint dest_width, guint bits)
+{
+  gint acc = 0, increment = get_increment (src_width, dest_width, 0);
+
+  if (bits == 16)
+    vs_scanline_resample_nearest_AYUV64 (dest, src, src_width, dest_width,
+        &acc, increment);
+  else
+    vs_scanline_resample_nearest_RGBA (dest, src, src_width, dest_width, &acc,
+        increment);
+}
+
+static void
+vscale_nearest (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer lines[], gint phase, gint width, guint bits)
+{
+  memcpy (dest, lines[0], width * bits / 2);
+}
+
+static void
+hscale_linear (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer src, gint src_width, gint dest_width, guint bits)
+{
+  gint acc = 0, increment = get_increment (src_width, dest_width, -1);
+
+  if (bits == 16)
+    vs_scanline_resample_linear_AYUV64 (dest, src, src_width, dest_width,
+        &acc, increment);
+  else
+    vs_scanline_resample_linear_RGBA (dest, src, src_width, dest_width, &acc,
+        increment);
+}
+
+static void
+vscale_linear (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer lines[], gint phase, gint width, guint bits)
+{
+  if (bits == 16)
+    video_scale_orc_merge_linear_u16 (dest, lines[0], lines[1],
+        65536 - phase, phase, width * 4);
+  else
+    vs_scanline_merge_linear_RGBA (dest, lines[0], lines[1], width, phase);
+}
+
+static void
+hscale_4tap (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer src, gint src_width, gint dest_width, guint bits)
+{
+  gint acc = 0, increment = get_increment (src_width, dest_width, 0);
+
+  if (bits == 16)
+    vs_scanline_resample_4tap_AYUV64 (dest, src, dest_width, src_width, &acc,
+        increment);
+  else
+    vs_scanline_resample_4tap_RGBA (dest, src, dest_width, src_width, &acc,
+        increment);
+}
+
+static void
+vscale_4tap (const VideoConvertScaler * scaler, gpointer dest,
+    gpointer lines[], gint phase, gint width, guint bits)
+{
+  if (bits == 16)
+    vs_scanline_merge_4tap_AYUV64 (dest, lines[0], lines[1], lines[2],
+        lines[3], width, phase);
+  else
+    vs_scanline_merge_4tap_RGBA (dest, lines[0], lines[1], lines[2],
+        lines[3], width, phase);
+}
+
+static const VideoConvertScaler scalers[] = {
+  {1, 0, hscale_nearest, vscale_nearest},
+  {2, -1, hscale_linear, vscale_linear},
+  {4, 0, hscale_4tap, vscale_4tap}
+};
+
+static void
+gst_video_convert_scale_class_init (GstVideoConvertScaleClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+  GstBaseTransformClass *trans_class = (GstBaseTransformClass *) klass;
+  GstVideoFilterClass *filter_class = (GstVideoFilterClass *) klass;
+
+  gobject_class->finalize = gst_video_convert_scale_finalize;
+
+  gst_element_class_set_static_metadata (element_class,
+      "Video converter and scaler", "Filter/Converter/Video/Scaler",
+      "Converts video from one colorspace to another and resizes it",
+      "GStreamer developers <gstreamer-devel@lists.freedesktop.org>");
+
+  /* these replace the templates of videoscale */
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_video_convert_scale_src_template));
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_video_convert_scale_sink_template));
+
+  trans_class->transform_caps =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_transform_caps);
+  trans_class->fixate_caps =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_fixate_caps);
+  trans_class->before_transform =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_before_transform);
+
+  filter_class->set_info = GST_DEBUG_FUNCPTR (gst_video_convert_scale_set_info);
+  filter_class->transform_frame_slice =
+      GST_DEBUG_FUNCPTR (gst_video_convert_scale_transform_frame_slice);
+}
+
+static void
+gst_video_convert_scale_init (GstVideoConvertScale * self)
+{
+  self->convert = NULL;
+}
+
+static void
+gst_video_convert_scale_finalize (GObject * object)
+{
+  GstVideoConvertScale *self = GST_VIDEO_CONVERT_SCALE (object);
+
+  if (self->convert)
+    videoconvert_convert_free (self->convert);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/* removes the format info and the size of the system memory structures */
+static GstCaps *
+gst_video_convert_scale_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter)
+{
+  GstCaps *ret;
+  GstStructure *structure;
+  GstCapsFeatures *features;
+  gint i, n;
+
+  ret = gst_caps_new_empty ();
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; i++) {
+    structure = gst_caps_get_structure (caps, i);
+    features = gst_caps_get_features (caps, i);
+
+    /* If this is already expressed by the existing caps
+     * skip this structure */
+    if (i > 0 && gst_caps_is_subset_structure_full (ret, structure, features))
+      continue;
+
+    structure = gst_structure_copy (structure);
+
+    /* other memory can only be passed through */
+    if (!gst_caps_features_is_any (features)
+        && gst_caps_features_is_equal (features,
+            GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY)) {
+      gst_structure_set (structure, "width", GST_TYPE_INT_RANGE, 1, G_MAXINT,
+          "height", GST_TYPE_INT_RANGE, 1, G_MAXINT, NULL);
+
+      if (gst_structure_has_field (structure, "pixel-aspect-ratio")) {
+        gst_structure_set (structure, "pixel-aspect-ratio",
+            GST_TYPE_FRACTION_RANGE, 1, G_MAXINT, G_MAXINT, 1, NULL);
+      }
+      gst_structure_remove_fields (structure, "format", "colorimetry",
+          "chroma-site", NULL);
+    }
+
+    gst_caps_append_structure_full (ret, structure,
+        gst_caps_features_copy (features));
+  }
+
+  if (filter) {
+    GstCaps *intersection;
+
+    intersection =
+        gst_caps_intersect_full (filter, ret, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref (ret);
+    ret = intersection;
+  }
+
+  GST_DEBUG_OBJECT (trans, "transformed %" GST_PTR_FORMAT " into %"
+      GST_PTR_FORMAT, caps, ret);
+
+  return ret;
+}
+
+#define SCORE_PALETTE_LOSS        1
+#define SCORE_COLOR_LOSS          2
+#define SCORE_ALPHA_LOSS          4
+#define SCORE_CHROMA_W_LOSS       8
+#define SCORE_CHROMA_H_LOSS      16
+#define SCORE_DEPTH_LOSS         32
+
+#define COLOR_MASK   (GST_VIDEO_FORMAT_FLAG_YUV | \
+                      GST_VIDEO_FORMAT_FLAG_RGB | GST_VIDEO_FORMAT_FLAG_GRAY)
+#define ALPHA_MASK   (GST_VIDEO_FORMAT_FLAG_ALPHA)
+#define PALETTE_MASK (GST_VIDEO_FORMAT_FLAG_PALETTE)
+
+/* calculate how much loss a conversion would be, like videoconvert */
+static void
+score_value (GstBaseTransform * base, const GstVideoFormatInfo * in_info,
+    const GValue * val, gint * min_loss, const GstVideoFormatInfo ** out_info)
+{
+  const gchar *fname;
+  const GstVideoFormatInfo *t_info;
+  GstVideoFormatFlags in_flags, t_flags;
+  gint loss;
+
+  fname = g_value_get_string (val);
+  t_info = gst_video_format_get_info (gst_video_format_from_string (fname));
+  if (!t_info)
+    return;
+
+  /* accept input format immediately without loss */
+  if (in_info == t_info) {
+    *min_loss = 0;
+    *out_info = t_info;
+    return;
+  }
+
+  loss = 1;
+
+  in_flags = GST_VIDEO_FORMAT_INFO_FLAGS (in_info);
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_LE;
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_COMPLEX;
+  in_flags &= ~GST_VIDEO_FORMAT_FLAG_UNPACK;
+
+  t_flags = GST_VIDEO_FORMAT_INFO_FLAGS (t_info);
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_LE;
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_COMPLEX;
+  t_flags &= ~GST_VIDEO_FORMAT_FLAG_UNPACK;
+
+  if ((t_flags & PALETTE_MASK) != (in_flags & PALETTE_MASK))
+    loss += SCORE_PALETTE_LOSS;
+
+  if ((t_flags & COLOR_MASK) != (in_flags & COLOR_MASK))
+    loss += SCORE_COLOR_LOSS;
+
+  if ((t_flags & ALPHA_MASK) != (in_flags & ALPHA_MASK))
+    loss += SCORE_ALPHA_LOSS;
+
+  if ((in_info->h_sub[1]) < (t_info->h_sub[1]))
+    loss += SCORE_CHROMA_H_LOSS;
+  if ((in_info->w_sub[1]) < (t_info->w_sub[1]))
+    loss += SCORE_CHROMA_W_LOSS;
+
+  if ((in_info->bits) > (t_info->bits))
+    loss += SCORE_DEPTH_LOSS;
+
+  GST_DEBUG_OBJECT (base, "score %s -> %s = %d",
+      GST_VIDEO_FORMAT_INFO_NAME (in_info),
+      GST_VIDEO_FORMAT_INFO_NAME (t_info), loss);
+
+  if (loss < *min_loss) {
+    GST_DEBUG_OBJECT (base, "found new best %d", loss);
+    *out_info = t_info;
+    *min_loss = loss;
+  }
+}
+
+static void
+gst_video_convert_scale_fixate_format (GstBaseTransform * base,
+    GstCaps * caps, GstCaps * result)
+{
+  GstStructure *ins, *outs;
+  const gchar *in_format;
+  const GstVideoFormatInfo *in_info, *out_info = NULL;
+  gint min_loss = G_MAXINT;
+  guint i, capslen;
+
+  ins = gst_caps_get_structure (caps, 0);
+  in_format = gst_structure_get_string (ins, "format");
+  if (!in_format)
+    return;
+
+  in_info =
+      gst_video_format_get_info (gst_video_format_from_string (in_format));
+  if (!in_info)
+    return;
+
+  outs = gst_caps_get_structure (result, 0);
+
+  capslen = gst_caps_get_size (result);
+  for (i = 0; i < capslen && min_loss > 0; i++) {
+    GstStructure *tests;
+    const GValue *format;
+
+    tests = gst_caps_get_structure (result, i);
+    format = gst_structure_get_value (tests, "format");
+    if (format == NULL)
+      continue;
+
+    if (GST_VALUE_HOLDS_LIST (format)) {
+      gint j, len;
+
+      len = gst_value_list_get_size (format);
+      for (j = 0; j < len && min_loss > 0; j++) {
+        const GValue *val;
+
+        val = gst_value_list_get_value (format, j);
+        if (G_VALUE_HOLDS_STRING (val))
+          score_value (base, in_info, val, &min_loss, &out_info);
+      }
+    } else if (G_VALUE_HOLDS_STRING (format)) {
+      score_value (base, in_info, format, &min_loss, &out_info);
+    }
+  }
+  if (out_info)
+    gst_structure_set (outs, "format", G_TYPE_STRING,
+        GST_VIDEO_FORMAT_INFO_NAME (out_info), NULL);
+}
+
+/* picks the format like videoconvert and then the size like videoscale */
+static GstCaps *
+gst_video_convert_scale_fixate_caps (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, GstCaps * othercaps)
+{
+  GST_DEBUG_OBJECT (base, "trying to fixate othercaps %" GST_PTR_FORMAT
+      " based on caps %" GST_PTR_FORMAT, othercaps, caps);
+
+  othercaps = gst_caps_make_writable (othercaps);
+  gst_video_convert_scale_fixate_format (base, caps, othercaps);
+
+  othercaps = GST_BASE_TRANSFORM_CLASS (parent_class)->fixate_caps (base,
+      direction, caps, othercaps);
+
+  /* fixate remaining fields */
+  othercaps = gst_caps_fixate (othercaps);
+
+  GST_DEBUG_OBJECT (base, "fixated othercaps to %" GST_PTR_FORMAT, othercaps);
+
+  return othercaps;
+}
+
+/* Makes the converter for the current method, frames in the same format
+ * that videoscale supports are only scaled. */
+static gboolean
+gst_video_convert_scale_setup (GstVideoConvertScale * self,
+    GstVideoInfo * in_info, GstVideoInfo * out_info)
+{
+  GstVideoScale *videoscale = GST_VIDEO_SCALE (self);
+  GstVideoScaleMethod method;
+  const VideoConvertScaler *scaler;
+  gint x, y, width, height;
+
+  if (self->convert) {
+    videoconvert_convert_free (self->convert);
+    self->convert = NULL;
+  }
+
+  GST_OBJECT_LOCK (self);
+  method = videoscale->method;
+  GST_OBJECT_UNLOCK (self);
+  self->convert_method = method;
+
+  if (GST_VIDEO_INFO_FORMAT (in_info) == GST_VIDEO_INFO_FORMAT (out_info) &&
+      gst_video_scale_supports_format (method,
+          GST_VIDEO_INFO_FORMAT (in_info))) {
+    GST_DEBUG_OBJECT (self, "only scaling");
+    return TRUE;
+  }
+
+  if (GST_VIDEO_INFO_INTERLACE_MODE (in_info) !=
+      GST_VIDEO_INFO_INTERLACE_MODE (out_info))
+    goto interlace_mismatch;
+
+  gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (self), FALSE);
+
+  width = GST_VIDEO_INFO_WIDTH (out_info) - videoscale->borders_w;
+  height = GST_VIDEO_INFO_HEIGHT (out_info) - videoscale->borders_h;
+  x = videoscale->borders_w / 2;
+  y = videoscale->borders_h / 2;
+  /* keep the fields of interlaced frames apart */
+  if (GST_VIDEO_INFO_IS_INTERLACED (out_info))
+    y &= ~1;
+
+  if (width == GST_VIDEO_INFO_WIDTH (in_info) &&
+      height == GST_VIDEO_INFO_HEIGHT (in_info) &&
+      videoscale->borders_w == 0 && videoscale->borders_h == 0) {
+    GST_DEBUG_OBJECT (self, "only converting");
+    self->convert = videoconvert_convert_new (in_info, out_info);
+  } else {
+    if (GST_VIDEO_INFO_WIDTH (in_info) == 1)
+      method = GST_VIDEO_SCALE_NEAREST;
+    if (method >= GST_VIDEO_SCALE_4TAP &&
+        (GST_VIDEO_INFO_WIDTH (in_info) < 4 ||
+            GST_VIDEO_INFO_HEIGHT (in_info) < 4))
+      method = GST_VIDEO_SCALE_BILINEAR;
+    /* Lanczos works on the planes of the frame, not on lines */
+    if (method == GST_VIDEO_SCALE_LANCZOS)
+      method = GST_VIDEO_SCALE_4TAP;
+    scaler = &scalers[method];
+
+    GST_DEBUG_OBJECT (self, "converting and scaling to %dx%d at %d,%d with "
+        "%u taps", width, height, x, y, scaler->n_taps);
+    self->convert = videoconvert_convert_new_scaled (in_info, out_info,
+        scaler, x, y, width, height);
+  }
+  if (self->convert == NULL)
+    goto no_convert;
+
+  return TRUE;
+
+  /* ERRORS */
+interlace_mismatch:
+  {
+    GST_ERROR_OBJECT (self, "input and output interlace modes differ");
+    return FALSE;
+  }
+no_convert:
+  {
+    GST_ERROR_OBJECT (self, "could not create converter");
+    return FALSE;
+  }
+}
+
+static gboolean
+gst_video_convert_scale_set_info (GstVideoFilter * filter, GstCaps * in,
+    GstVideoInfo * in_info, GstCaps * out, GstVideoInfo * out_info)
+{
+  GstVideoConvertScale *self = GST_VIDEO_CONVERT_SCALE (filter);
+
+  /* this calculates the borders */
+  if (!GST_VIDEO_FILTER_CLASS (parent_class)->set_info (filter, in, in_info,
+          out, out_info))
+    return FALSE;
+
+  return gst_video_convert_scale_setup (self, in_info, out_info);
+}
+
+/* a new method is picked up between frames */
+static void
+gst_video_convert_scale_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer)
+{
+  GstVideoConvertScale *self = GST_VIDEO_CONVERT_SCALE (trans);
+  GstVideoFilter *filter = GST_VIDEO_FILTER (trans);
+  GstVideoScaleMethod method;
+
+  GST_BASE_TRANSFORM_CLASS (parent_class)->before_transform (trans, buffer);
+
+  if (!filter->negotiated)
+    return;
+
+  GST_OBJECT_LOCK (self);
+  method = GST_VIDEO_SCALE (self)->method;
+  GST_OBJECT_UNLOCK (self);
+
+  if (method != self->convert_method)
+    gst_video_convert_scale_setup (self, &filter->in_info, &filter->out_info);
+}
+
+static GstFlowReturn
+gst_video_convert_scale_transform_frame_slice (GstVideoFilter * filter,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame, guint y, guint height)
+{
+  GstVideoConvertScale *self = GST_VIDEO_CONVERT_SCALE (filter);
+
+  if (self->convert == NULL)
+    return GST_VIDEO_FILTER_CLASS (parent_class)->transform_frame_slice
+        (filter, in_frame, out_frame, y, height);
+
+  videoconvert_convert_convert_lines (self->convert, out_frame, in_frame, y,
+      height);
+
+  return GST_FLOW_OK;
+}
@@ -0,0 +1,70 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_VIDEO_CONVERT_SCALE_H__
+#define __GST_VIDEO_CONVERT_SCALE_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#include "gstvideoscale.h"
+#include "videoconvert.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_VIDEO_CONVERT_SCALE \
+  (gst_video_convert_scale_get_type())
+#define GST_VIDEO_CONVERT_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VIDEO_CONVERT_SCALE,GstVideoConvertScale))
+#define GST_VIDEO_CONVERT_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_VIDEO_CONVERT_SCALE,GstVideoConvertScaleClass))
+#define GST_IS_VIDEO_CONVERT_SCALE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_VIDEO_CONVERT_SCALE))
+#define GST_IS_VIDEO_CONVERT_SCALE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_VIDEO_CONVERT_SCALE))
+#define GST_VIDEO_CONVERT_SCALE_CAST(obj)       ((GstVideoConvertScale *)(obj))
+
+typedef struct _GstVideoConvertScale GstVideoConvertScale;
+typedef struct _GstVideoConvertScaleClass GstVideoConvertScaleClass;
+
+/**
+ * GstVideoConvertScale:
+ *
+ * Opaque data structure
+ */
+struct _GstVideoConvertScale {
+  GstVideoScale element;
+
+  /*< private >*/
+  /* converts and scales when the formats differ, NULL when the frames are
+   * only scaled by videoscale */
+  VideoConvert *convert;
+  /* the method that convert was made for */
+  GstVideoScaleMethod convert_method;
+};
+
+struct _GstVideoConvertScaleClass {
+  GstVideoScaleClass parent_class;
+};
+
+G_GNUC_INTERNAL GType gst_video_convert_scale_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_CONVERT_SCALE_H__ */
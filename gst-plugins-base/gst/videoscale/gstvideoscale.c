@@ -31,6 +31,9 @@
  * RGB formats and is therefore generally able to operate anywhere in a
  * pipeline.
  *
+ * Frames can be scaled in bands of lines on multiple threads with the
+ * #GstVideoFilter:n-threads property.
+ *
  * <refsect2>
  * <title>Example pipelines</title>
  * |[
@@ -80,6 +83,9 @@
 #include <gst/video/gstvideopool.h>
 
 #include "gstvideoscale.h"
+#ifdef HAVE_VIDEOCONVERTSCALE
+#include "gstvideoconvertscale.h"
+#endif
 #include "gstvideoscaleorc.h"
 #include "vs_image.h"
 #include "vs_4tap.h"
@@ -144,7 +150,7 @@ gst_video_scale_method_get_type (void)
     {GST_VIDEO_SCALE_NEAREST, "Nearest Neighbour", "nearest-neighbour"},
     {GST_VIDEO_SCALE_BILINEAR, "Bilinear", "bilinear"},
     {GST_VIDEO_SCALE_4TAP, "4-tap", "4-tap"},
-    {GST_VIDEO_SCALE_LANCZOS, "Lanczos (experimental/unstable)", "lanczos"},
+    {GST_VIDEO_SCALE_LANCZOS, "Lanczos", "lanczos"},
     {0, NULL, NULL},
   };
 
@@ -193,11 +199,13 @@ static GstCaps *gst_video_scale_transform_caps (GstBaseTransform * trans,
 static GstCaps *gst_video_scale_fixate_caps (GstBaseTransform * base,
     GstPadDirection direction, GstCaps * caps, GstCaps * othercaps);
 
+static void gst_video_scale_before_transform (GstBaseTransform * trans,
+    GstBuffer * buffer);
 static gboolean gst_video_scale_set_info (GstVideoFilter * filter,
     GstCaps * in, GstVideoInfo * in_info, GstCaps * out,
     GstVideoInfo * out_info);
-static GstFlowReturn gst_video_scale_transform_frame (GstVideoFilter * filter,
-    GstVideoFrame * in, GstVideoFrame * out);
+static GstFlowReturn gst_video_scale_transform_frame_slice (GstVideoFilter *
+    filter, GstVideoFrame * in, GstVideoFrame * out, guint y, guint height);
 
 static void gst_video_scale_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -205,7 +213,8 @@ static void gst_video_scale_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
 static GstFlowReturn do_scale (GstVideoFilter * filter, VSImage dest[4],
-    VSImage src[4]);
+    VSImage src[4], guint8 * tmp_buf, gboolean interlaced,
+    gboolean fill_borders);
 
 #define gst_video_scale_parent_class parent_class
 G_DEFINE_TYPE (GstVideoScale, gst_video_scale, GST_TYPE_VIDEO_FILTER);
@@ -276,16 +285,19 @@ gst_video_scale_class_init (GstVideoScaleClass * klass)
       GST_DEBUG_FUNCPTR (gst_video_scale_transform_caps);
   trans_class->fixate_caps = GST_DEBUG_FUNCPTR (gst_video_scale_fixate_caps);
   trans_class->src_event = GST_DEBUG_FUNCPTR (gst_video_scale_src_event);
+  trans_class->before_transform =
+      GST_DEBUG_FUNCPTR (gst_video_scale_before_transform);
 
   filter_class->set_info = GST_DEBUG_FUNCPTR (gst_video_scale_set_info);
-  filter_class->transform_frame =
-      GST_DEBUG_FUNCPTR (gst_video_scale_transform_frame);
+  filter_class->transform_frame_slice =
+      GST_DEBUG_FUNCPTR (gst_video_scale_transform_frame_slice);
 }
 
 static void
 gst_video_scale_init (GstVideoScale * videoscale)
 {
   videoscale->tmp_buf = NULL;
+  videoscale->tmp_bufs = g_async_queue_new_full (g_free);
   videoscale->method = DEFAULT_PROP_METHOD;
   videoscale->add_borders = DEFAULT_PROP_ADD_BORDERS;
   videoscale->submethod = DEFAULT_PROP_SUBMETHOD;
@@ -293,6 +305,26 @@ gst_video_scale_init (GstVideoScale * videoscale)
   videoscale->sharpen = DEFAULT_PROP_SHARPEN;
   videoscale->dither = DEFAULT_PROP_DITHER;
   videoscale->envelope = DEFAULT_PROP_ENVELOPE;
+  videoscale->lanczos_sharpness = DEFAULT_PROP_SHARPNESS;
+  videoscale->lanczos_sharpen = DEFAULT_PROP_SHARPEN;
+  videoscale->lanczos_envelope = DEFAULT_PROP_ENVELOPE;
+  videoscale->lanczos_dither = DEFAULT_PROP_DITHER;
+  videoscale->lanczos_submethod = DEFAULT_PROP_SUBMETHOD;
+}
+
+static void
+gst_video_scale_clear_lanczos (GstVideoScale * videoscale)
+{
+  gint i, j;
+
+  for (i = 0; i < 2; i++) {
+    for (j = 0; j < 4; j++) {
+      if (videoscale->lanczos[i][j]) {
+        vs_lanczos_free (videoscale->lanczos[i][j]);
+        videoscale->lanczos[i][j] = NULL;
+      }
+    }
+  }
 }
 
 static void
@@ -300,6 +332,8 @@ gst_video_scale_finalize (GstVideoScale * videoscale)
 {
   if (videoscale->tmp_buf)
     g_free (videoscale->tmp_buf);
+  g_async_queue_unref (videoscale->tmp_bufs);
+  gst_video_scale_clear_lanczos (videoscale);
 
   G_OBJECT_CLASS (parent_class)->finalize (G_OBJECT (videoscale));
 }
@@ -416,7 +450,7 @@ get_formats_filter (GstVideoScaleMethod method)
           "ARGB, BGRA, ABGR, AYUV, ARGB64, AYUV64, "
           "RGB, BGR, v308, YUY2, YVYU, UYVY, "
           "GRAY8, GRAY16_LE, GRAY16_BE, I420, YV12, "
-          "Y444, Y42B, Y41B, RGB16, RGB15 }");
+          "Y444, Y42B, Y41B, NV12, RGB16, RGB15 }");
       return gst_static_caps_get (&fourtap_filter);
     }
     case GST_VIDEO_SCALE_LANCZOS:
@@ -425,7 +459,8 @@ get_formats_filter (GstVideoScaleMethod method)
           GST_STATIC_CAPS ("video/x-raw(ANY),"
           "format = (string) { RGBx, xRGB, BGRx, xBGR, RGBA, "
           "ARGB, BGRA, ABGR, AYUV, ARGB64, AYUV64, "
-          "I420, YV12, Y444, Y42B, Y41B }");
+          "RGB, BGR, v308, YUY2, YVYU, UYVY, GRAY8, "
+          "I420, YV12, Y444, Y42B, Y41B, NV12 }");
       return gst_static_caps_get (&lanczos_filter);
     }
     default:
@@ -435,6 +470,27 @@ get_formats_filter (GstVideoScaleMethod method)
   return NULL;
 }
 
+/* checks if frames of @format can be scaled with @method */
+gboolean
+gst_video_scale_supports_format (GstVideoScaleMethod method,
+    GstVideoFormat format)
+{
+  GstCaps *caps, *mfilter;
+  gboolean ret;
+
+  caps = gst_caps_new_simple ("video/x-raw", "format", G_TYPE_STRING,
+      gst_video_format_to_string (format), NULL);
+
+  ret = gst_caps_can_intersect (caps, gst_video_scale_get_capslist ());
+  if (ret && (mfilter = get_formats_filter (method))) {
+    ret = gst_caps_can_intersect (caps, mfilter);
+    gst_caps_unref (mfilter);
+  }
+  gst_caps_unref (caps);
+
+  return ret;
+}
+
 static GstCaps *
 gst_video_scale_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter)
@@ -517,6 +573,7 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
 {
   GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
   gint from_dar_n, from_dar_d, to_dar_n, to_dar_d;
+  guint8 *tmp_buf;
 
   if (!gst_util_fraction_multiply (in_info->width,
           in_info->height, in_info->par_n, in_info->par_d, &from_dar_n,
@@ -559,6 +616,10 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
   if (videoscale->tmp_buf)
     g_free (videoscale->tmp_buf);
   videoscale->tmp_buf = g_malloc (out_info->width * sizeof (guint64) * 4);
+  /* the temp buffers of the other bands have the old size */
+  while ((tmp_buf = g_async_queue_try_pop (videoscale->tmp_bufs)))
+    g_free (tmp_buf);
+  gst_video_scale_clear_lanczos (videoscale);
 
   if (in_info->width == out_info->width && in_info->height == out_info->height
       && videoscale->borders_w == 0 && videoscale->borders_h == 0) {
@@ -1069,6 +1130,37 @@ gst_video_scale_setup_vs_image (VSImage * image, GstVideoFrame * frame,
       image->real_pixels + image->border_top * image->stride +
       image->border_left * GST_VIDEO_FRAME_COMP_PSTRIDE (frame, component);
 
+  image->y_start = 0;
+  image->y_end = image->height;
+}
+
+/* only produce the lines of @image that are in the lines @y to @y + @height
+ * of the frame, @y is aligned to the chroma subsampling and, for interlaced
+ * frames, to field pairs */
+static void
+gst_video_scale_setup_vs_band (VSImage * image, GstVideoFrame * frame,
+    gint component, gboolean interlaced, guint y, guint height)
+{
+  gint start, end;
+
+  start = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (frame->info.finfo, component, y);
+  end = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (frame->info.finfo, component,
+      y + height);
+
+  if (interlaced) {
+    start /= 2;
+    end /= 2;
+  }
+
+  start = CLAMP (start - image->border_top, 0, image->height);
+  end = CLAMP (end - image->border_top, 0, image->height);
+
+  /* the band is completely inside the borders */
+  if (start >= end)
+    start = end = 0;
+
+  image->y_start = start;
+  image->y_end = end;
 }
 
 static const guint8 *
@@ -1131,40 +1223,114 @@ _get_black_for_format (GstVideoFormat format)
   }
 }
 
+/* The Lanczos parameters are only changed between frames, the taps that were
+ * calculated for the old values are freed before any band is scaled. The
+ * borders of the frame still have to be filled by one of its bands. */
+static void
+gst_video_scale_before_transform (GstBaseTransform * trans, GstBuffer * buffer)
+{
+  GstVideoScale *videoscale = GST_VIDEO_SCALE (trans);
+
+  GST_OBJECT_LOCK (videoscale);
+  if (videoscale->sharpness != videoscale->lanczos_sharpness ||
+      videoscale->sharpen != videoscale->lanczos_sharpen ||
+      videoscale->envelope != videoscale->lanczos_envelope) {
+    gst_video_scale_clear_lanczos (videoscale);
+    videoscale->lanczos_sharpness = videoscale->sharpness;
+    videoscale->lanczos_sharpen = videoscale->sharpen;
+    videoscale->lanczos_envelope = videoscale->envelope;
+  }
+  videoscale->lanczos_dither = videoscale->dither;
+  videoscale->lanczos_submethod = videoscale->submethod;
+  GST_OBJECT_UNLOCK (videoscale);
+
+  g_atomic_int_set (&videoscale->borders_pending, TRUE);
+}
+
+/* Scales one plane with the cached taps, the band that runs first
+ * calculates them. */
+static void
+gst_video_scale_lanczos (GstVideoScale * videoscale, gint plane,
+    VSLanczosLayout layout, const VSImage * dest, const VSImage * src,
+    gboolean interlaced)
+{
+  VSLanczos *lanczos;
+
+  GST_OBJECT_LOCK (videoscale);
+  lanczos = videoscale->lanczos[interlaced ? 1 : 0][plane];
+  if (lanczos == NULL) {
+    lanczos = vs_lanczos_new (layout, src->width, src->height, dest->width,
+        dest->height, videoscale->lanczos_sharpness,
+        videoscale->lanczos_sharpen, videoscale->lanczos_envelope);
+    videoscale->lanczos[interlaced ? 1 : 0][plane] = lanczos;
+  }
+  GST_OBJECT_UNLOCK (videoscale);
+
+  vs_image_scale_lanczos_fixed (dest, src, lanczos,
+      videoscale->lanczos_dither);
+}
+
+/* Called concurrently for different bands of output lines. Every output line
+ * is computed from the complete input frame so the bands don't depend on each
+ * other and the result is the same as when scaling the frame at once. */
 static GstFlowReturn
-gst_video_scale_transform_frame (GstVideoFilter * filter,
-    GstVideoFrame * in_frame, GstVideoFrame * out_frame)
+gst_video_scale_transform_frame_slice (GstVideoFilter * filter,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame, guint y, guint height)
 {
   GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
   GstFlowReturn ret = GST_FLOW_OK;
   VSImage dest[4] = { {NULL,}, };
   VSImage src[4] = { {NULL,}, };
   gint i;
-  gboolean interlaced;
+  gboolean interlaced, first;
+  guint8 *tmp_buf;
 
   interlaced = GST_VIDEO_FRAME_IS_INTERLACED (in_frame);
 
+  /* the band that runs first fills the borders and uses our own temp buffer,
+   * the other bands take one from the pool. Empty bands are never scaled so
+   * this can't be tied to the position of the band. */
+  first = g_atomic_int_compare_and_exchange (&videoscale->borders_pending,
+      TRUE, FALSE);
+  if (first) {
+    tmp_buf = videoscale->tmp_buf;
+  } else {
+    tmp_buf = g_async_queue_try_pop (videoscale->tmp_bufs);
+    if (tmp_buf == NULL)
+      tmp_buf = g_malloc (GST_VIDEO_INFO_WIDTH (&filter->out_info) *
+          sizeof (guint64) * 4);
+  }
+
   for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (in_frame); i++) {
     gst_video_scale_setup_vs_image (&src[i], in_frame, i, 0, 0, interlaced, 0);
     gst_video_scale_setup_vs_image (&dest[i], out_frame, i,
         videoscale->borders_w, videoscale->borders_h, interlaced, 0);
+    gst_video_scale_setup_vs_band (&dest[i], out_frame, i, interlaced, y,
+        height);
   }
-  ret = do_scale (filter, dest, src);
+  ret = do_scale (filter, dest, src, tmp_buf, interlaced, first);
 
-  if (interlaced) {
+  if (interlaced && ret == GST_FLOW_OK) {
     for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (in_frame); i++) {
       gst_video_scale_setup_vs_image (&src[i], in_frame, i, 0, 0, interlaced,
           1);
       gst_video_scale_setup_vs_image (&dest[i], out_frame, i,
           videoscale->borders_w, videoscale->borders_h, interlaced, 1);
+      gst_video_scale_setup_vs_band (&dest[i], out_frame, i, interlaced, y,
+          height);
     }
-    ret = do_scale (filter, dest, src);
+    ret = do_scale (filter, dest, src, tmp_buf, interlaced, first);
   }
+
+  if (!first)
+    g_async_queue_push (videoscale->tmp_bufs, tmp_buf);
+
   return ret;
 }
 
 static GstFlowReturn
-do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
+do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4],
+    guint8 * tmp_buf, gboolean interlaced, gboolean fill_borders)
 {
   GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
   GstFlowReturn ret = GST_FLOW_OK;
@@ -1172,6 +1338,7 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
   const guint8 *black;
   GstVideoFormat format;
   gboolean add_borders;
+  gint i;
 
   GST_OBJECT_LOCK (videoscale);
   method = videoscale->method;
@@ -1202,22 +1369,28 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
     case GST_VIDEO_FORMAT_BGRA:
     case GST_VIDEO_FORMAT_ABGR:
     case GST_VIDEO_FORMAT_AYUV:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_RGBA (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_RGBA (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_RGBA (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_RGBA (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_RGBA (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_RGBA (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_RGBA (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_LANCZOS:
-          vs_image_scale_lanczos_AYUV (&dest[0], &src[0], videoscale->tmp_buf,
-              videoscale->sharpness, videoscale->dither, videoscale->submethod,
-              videoscale->envelope, videoscale->sharpen);
+          /* the floating point submethods are only kept as a reference */
+          if (videoscale->lanczos_submethod >= 2)
+            vs_image_scale_lanczos_AYUV (&dest[0], &src[0], tmp_buf,
+                videoscale->lanczos_sharpness, videoscale->lanczos_dither,
+                videoscale->lanczos_submethod, videoscale->lanczos_envelope,
+                videoscale->lanczos_sharpen);
+          else
+            gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_RGBA, &dest[0],
+                &src[0], interlaced);
           break;
         default:
           goto unknown_mode;
@@ -1225,23 +1398,23 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
       break;
     case GST_VIDEO_FORMAT_ARGB64:
     case GST_VIDEO_FORMAT_AYUV64:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_AYUV64 (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_AYUV64 (&dest[0], &src[0],
-              videoscale->tmp_buf);
+          vs_image_scale_nearest_AYUV64 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_AYUV64 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_AYUV64 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_AYUV64 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_AYUV64 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_LANCZOS:
-          vs_image_scale_lanczos_AYUV64 (&dest[0], &src[0], videoscale->tmp_buf,
-              videoscale->sharpness, videoscale->dither, videoscale->submethod,
-              videoscale->envelope, videoscale->sharpen);
+          vs_image_scale_lanczos_AYUV64 (&dest[0], &src[0], tmp_buf,
+              videoscale->lanczos_sharpness, videoscale->lanczos_dither,
+              videoscale->lanczos_submethod, videoscale->lanczos_envelope,
+              videoscale->lanczos_sharpen);
           break;
         default:
           goto unknown_mode;
@@ -1250,17 +1423,21 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
     case GST_VIDEO_FORMAT_RGB:
     case GST_VIDEO_FORMAT_BGR:
     case GST_VIDEO_FORMAT_v308:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_RGB (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_RGB (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_RGB (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_RGB (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_RGB (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_RGB (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_RGB (&dest[0], &src[0], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_LANCZOS:
+          gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_RGB, &dest[0],
+              &src[0], interlaced);
           break;
         default:
           goto unknown_mode;
@@ -1268,51 +1445,63 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
       break;
     case GST_VIDEO_FORMAT_YUY2:
     case GST_VIDEO_FORMAT_YVYU:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_YUYV (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_YUYV (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_YUYV (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_YUYV (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_YUYV (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_YUYV (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_YUYV (&dest[0], &src[0], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_LANCZOS:
+          gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_YUYV, &dest[0],
+              &src[0], interlaced);
           break;
         default:
           goto unknown_mode;
       }
       break;
     case GST_VIDEO_FORMAT_UYVY:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_UYVY (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_UYVY (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_UYVY (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_UYVY (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_UYVY (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_UYVY (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_UYVY (&dest[0], &src[0], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_LANCZOS:
+          gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_UYVY, &dest[0],
+              &src[0], interlaced);
           break;
         default:
           goto unknown_mode;
       }
       break;
     case GST_VIDEO_FORMAT_GRAY8:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_Y (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_Y (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_Y (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_Y (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_Y (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_Y (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_Y (&dest[0], &src[0], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_LANCZOS:
+          gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_Y, &dest[0],
+              &src[0], interlaced);
           break;
         default:
           goto unknown_mode;
@@ -1320,17 +1509,17 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
       break;
     case GST_VIDEO_FORMAT_GRAY16_LE:
     case GST_VIDEO_FORMAT_GRAY16_BE:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_Y16 (&dest[0], 0);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_Y16 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_nearest_Y16 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_Y16 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_Y16 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_Y16 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_Y16 (&dest[0], &src[0], tmp_buf);
           break;
         default:
           goto unknown_mode;
@@ -1341,37 +1530,39 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
     case GST_VIDEO_FORMAT_Y444:
     case GST_VIDEO_FORMAT_Y42B:
     case GST_VIDEO_FORMAT_Y41B:
-      if (add_borders) {
+      if (add_borders && fill_borders) {
         vs_fill_borders_Y (&dest[0], black);
         vs_fill_borders_Y (&dest[1], black + 1);
         vs_fill_borders_Y (&dest[2], black + 2);
       }
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_Y (&dest[0], &src[0], videoscale->tmp_buf);
-          vs_image_scale_nearest_Y (&dest[1], &src[1], videoscale->tmp_buf);
-          vs_image_scale_nearest_Y (&dest[2], &src[2], videoscale->tmp_buf);
+          vs_image_scale_nearest_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_nearest_Y (&dest[1], &src[1], tmp_buf);
+          vs_image_scale_nearest_Y (&dest[2], &src[2], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_Y (&dest[0], &src[0], videoscale->tmp_buf);
-          vs_image_scale_linear_Y (&dest[1], &src[1], videoscale->tmp_buf);
-          vs_image_scale_linear_Y (&dest[2], &src[2], videoscale->tmp_buf);
+          vs_image_scale_linear_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_linear_Y (&dest[1], &src[1], tmp_buf);
+          vs_image_scale_linear_Y (&dest[2], &src[2], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_Y (&dest[0], &src[0], videoscale->tmp_buf);
-          vs_image_scale_4tap_Y (&dest[1], &src[1], videoscale->tmp_buf);
-          vs_image_scale_4tap_Y (&dest[2], &src[2], videoscale->tmp_buf);
+          vs_image_scale_4tap_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_4tap_Y (&dest[1], &src[1], tmp_buf);
+          vs_image_scale_4tap_Y (&dest[2], &src[2], tmp_buf);
           break;
         case GST_VIDEO_SCALE_LANCZOS:
-          vs_image_scale_lanczos_Y (&dest[0], &src[0], videoscale->tmp_buf,
-              videoscale->sharpness, videoscale->dither, videoscale->submethod,
-              videoscale->envelope, videoscale->sharpen);
-          vs_image_scale_lanczos_Y (&dest[1], &src[1], videoscale->tmp_buf,
-              videoscale->sharpness, videoscale->dither, videoscale->submethod,
-              videoscale->envelope, videoscale->sharpen);
-          vs_image_scale_lanczos_Y (&dest[2], &src[2], videoscale->tmp_buf,
-              videoscale->sharpness, videoscale->dither, videoscale->submethod,
-              videoscale->envelope, videoscale->sharpen);
+          if (videoscale->lanczos_submethod >= 2) {
+            for (i = 0; i < 3; i++)
+              vs_image_scale_lanczos_Y (&dest[i], &src[i], tmp_buf,
+                  videoscale->lanczos_sharpness, videoscale->lanczos_dither,
+                  videoscale->lanczos_submethod, videoscale->lanczos_envelope,
+                  videoscale->lanczos_sharpen);
+          } else {
+            for (i = 0; i < 3; i++)
+              gst_video_scale_lanczos (videoscale, i, VS_LANCZOS_Y, &dest[i],
+                  &src[i], interlaced);
+          }
           break;
         default:
           goto unknown_mode;
@@ -1380,48 +1571,56 @@ do_scale (GstVideoFilter * filter, VSImage dest[4], VSImage src[4])
     case GST_VIDEO_FORMAT_NV12:
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_Y (&dest[0], &src[0], videoscale->tmp_buf);
-          vs_image_scale_nearest_NV12 (&dest[1], &src[1], videoscale->tmp_buf);
+          vs_image_scale_nearest_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_nearest_NV12 (&dest[1], &src[1], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_Y (&dest[0], &src[0], videoscale->tmp_buf);
-          vs_image_scale_linear_NV12 (&dest[1], &src[1], videoscale->tmp_buf);
+          vs_image_scale_linear_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_linear_NV12 (&dest[1], &src[1], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_4TAP:
+          vs_image_scale_4tap_Y (&dest[0], &src[0], tmp_buf);
+          vs_image_scale_4tap_NV12 (&dest[1], &src[1], tmp_buf);
+          break;
+        case GST_VIDEO_SCALE_LANCZOS:
+          gst_video_scale_lanczos (videoscale, 0, VS_LANCZOS_Y, &dest[0],
+              &src[0], interlaced);
+          gst_video_scale_lanczos (videoscale, 1, VS_LANCZOS_NV12, &dest[1],
+              &src[1], interlaced);
           break;
         default:
           goto unknown_mode;
       }
       break;
     case GST_VIDEO_FORMAT_RGB16:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_RGB565 (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_RGB565 (&dest[0], &src[0],
-              videoscale->tmp_buf);
+          vs_image_scale_nearest_RGB565 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_RGB565 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_RGB565 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_RGB565 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_RGB565 (&dest[0], &src[0], tmp_buf);
           break;
         default:
           goto unknown_mode;
       }
       break;
     case GST_VIDEO_FORMAT_RGB15:
-      if (add_borders)
+      if (add_borders && fill_borders)
         vs_fill_borders_RGB555 (&dest[0], black);
       switch (method) {
         case GST_VIDEO_SCALE_NEAREST:
-          vs_image_scale_nearest_RGB555 (&dest[0], &src[0],
-              videoscale->tmp_buf);
+          vs_image_scale_nearest_RGB555 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_BILINEAR:
-          vs_image_scale_linear_RGB555 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_linear_RGB555 (&dest[0], &src[0], tmp_buf);
           break;
         case GST_VIDEO_SCALE_4TAP:
-          vs_image_scale_4tap_RGB555 (&dest[0], &src[0], videoscale->tmp_buf);
+          vs_image_scale_4tap_RGB555 (&dest[0], &src[0], tmp_buf);
           break;
         default:
           goto unknown_mode;
@@ -1493,6 +1692,11 @@ plugin_init (GstPlugin * plugin)
   if (!gst_element_register (plugin, "videoscale", GST_RANK_NONE,
           GST_TYPE_VIDEO_SCALE))
     return FALSE;
+#ifdef HAVE_VIDEOCONVERTSCALE
+  if (!gst_element_register (plugin, "videoconvertscale", GST_RANK_NONE,
+          GST_TYPE_VIDEO_CONVERT_SCALE))
+    return FALSE;
+#endif
 
   GST_DEBUG_CATEGORY_INIT (video_scale_debug, "videoscale", 0,
       "videoscale element");
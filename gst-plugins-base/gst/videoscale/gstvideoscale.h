@@ -85,6 +85,19 @@ struct _GstVideoScale {
 
   /*< private >*/
   guint8 *tmp_buf;
+  /* temp buffers of the bands that are scaled concurrently */
+  GAsyncQueue *tmp_bufs;
+  /* set for every frame, cleared by the band that fills the borders */
+  volatile gint borders_pending;
+
+  /* Lanczos taps of each plane, for frames and for fields */
+  VSLanczos *lanczos[2][4];
+  /* Lanczos parameters of the current frame */
+  double lanczos_sharpness;
+  double lanczos_sharpen;
+  double lanczos_envelope;
+  gboolean lanczos_dither;
+  int lanczos_submethod;
 };
 
 struct _GstVideoScaleClass {
@@ -93,6 +106,9 @@ struct _GstVideoScaleClass {
 
 G_GNUC_INTERNAL GType gst_video_scale_get_type (void);
 
+G_GNUC_INTERNAL gboolean gst_video_scale_supports_format (GstVideoScaleMethod method,
+                                                          GstVideoFormat format);
+
 G_END_DECLS
 
 #endif /* __GST_VIDEO_SCALE_H__ */
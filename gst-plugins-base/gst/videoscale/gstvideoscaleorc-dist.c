@@ -128,6 +128,26 @@ void video_scale_orc_merge_bicubic_u8 (guint8 * ORC_RESTRICT d1,
     const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
     const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int p1,
     int p2, int p3, int p4, int n);
+void video_scale_orc_merge_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n);
+void video_scale_orc_resample_vert_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n);
+void video_scale_orc_resample_vert_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n);
+void video_scale_orc_resample_vert_acc_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n);
+void video_scale_orc_resample_vert_acc_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n);
 
 
 /* begin Orc C target preamble */
@@ -2559,3 +2579,1397 @@ video_scale_orc_merge_bicubic_u8 (guint8 * ORC_RESTRICT d1,
   func (ex);
 }
 #endif
+
+
+/* video_scale_orc_merge_4tap_u8 */
+#ifdef DISABLE_ORC
+void
+video_scale_orc_merge_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  orc_int8 var34;
+  orc_union16 var35;
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_int8 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_int8 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_int8 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union32 var51;
+  orc_union32 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var53;
+#else
+  orc_union32 var53;
+#endif
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union16 var56;
+  orc_int8 var57;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_int8 *) s1;
+  ptr5 = (orc_int8 *) s2;
+  ptr6 = (orc_int8 *) s3;
+  ptr7 = (orc_int8 *) s4;
+
+  /* 2: loadpw */
+  var36.i = p1;
+  /* 6: loadpw */
+  var40.i = p2;
+  /* 11: loadpw */
+  var45.i = p3;
+  /* 16: loadpw */
+  var50.i = p4;
+  /* 19: loadpl */
+  var53.i = (int) 0x00000200;   /* 512 or 2.52962e-321f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr4[i];
+    /* 1: convubw */
+    var35.i = (orc_uint8) var34;
+    /* 3: mulswl */
+    var37.i = var35.i * var36.i;
+    /* 4: loadb */
+    var38 = ptr5[i];
+    /* 5: convubw */
+    var39.i = (orc_uint8) var38;
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var37.i + var41.i;
+    /* 9: loadb */
+    var43 = ptr6[i];
+    /* 10: convubw */
+    var44.i = (orc_uint8) var43;
+    /* 12: mulswl */
+    var46.i = var44.i * var45.i;
+    /* 13: addl */
+    var47.i = var42.i + var46.i;
+    /* 14: loadb */
+    var48 = ptr7[i];
+    /* 15: convubw */
+    var49.i = (orc_uint8) var48;
+    /* 17: mulswl */
+    var51.i = var49.i * var50.i;
+    /* 18: addl */
+    var52.i = var47.i + var51.i;
+    /* 20: addl */
+    var54.i = var52.i + var53.i;
+    /* 21: shrsl */
+    var55.i = var54.i >> 10;
+    /* 22: convssslw */
+    var56.i = ORC_CLAMP_SW (var55.i);
+    /* 23: convsuswb */
+    var57 = ORC_CLAMP_UB (var56.i);
+    /* 24: storeb */
+    ptr0[i] = var57;
+  }
+
+}
+
+#else
+static void
+_backup_video_scale_orc_merge_4tap_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  const orc_int8 *ORC_RESTRICT ptr6;
+  const orc_int8 *ORC_RESTRICT ptr7;
+  orc_int8 var34;
+  orc_union16 var35;
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_int8 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_int8 var43;
+  orc_union16 var44;
+  orc_union16 var45;
+  orc_union32 var46;
+  orc_union32 var47;
+  orc_int8 var48;
+  orc_union16 var49;
+  orc_union16 var50;
+  orc_union32 var51;
+  orc_union32 var52;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var53;
+#else
+  orc_union32 var53;
+#endif
+  orc_union32 var54;
+  orc_union32 var55;
+  orc_union16 var56;
+  orc_int8 var57;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+  ptr6 = (orc_int8 *) ex->arrays[6];
+  ptr7 = (orc_int8 *) ex->arrays[7];
+
+  /* 2: loadpw */
+  var36.i = ex->params[24];
+  /* 6: loadpw */
+  var40.i = ex->params[25];
+  /* 11: loadpw */
+  var45.i = ex->params[26];
+  /* 16: loadpw */
+  var50.i = ex->params[27];
+  /* 19: loadpl */
+  var53.i = (int) 0x00000200;   /* 512 or 2.52962e-321f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr4[i];
+    /* 1: convubw */
+    var35.i = (orc_uint8) var34;
+    /* 3: mulswl */
+    var37.i = var35.i * var36.i;
+    /* 4: loadb */
+    var38 = ptr5[i];
+    /* 5: convubw */
+    var39.i = (orc_uint8) var38;
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var37.i + var41.i;
+    /* 9: loadb */
+    var43 = ptr6[i];
+    /* 10: convubw */
+    var44.i = (orc_uint8) var43;
+    /* 12: mulswl */
+    var46.i = var44.i * var45.i;
+    /* 13: addl */
+    var47.i = var42.i + var46.i;
+    /* 14: loadb */
+    var48 = ptr7[i];
+    /* 15: convubw */
+    var49.i = (orc_uint8) var48;
+    /* 17: mulswl */
+    var51.i = var49.i * var50.i;
+    /* 18: addl */
+    var52.i = var47.i + var51.i;
+    /* 20: addl */
+    var54.i = var52.i + var53.i;
+    /* 21: shrsl */
+    var55.i = var54.i >> 10;
+    /* 22: convssslw */
+    var56.i = ORC_CLAMP_SW (var55.i);
+    /* 23: convsuswb */
+    var57 = ORC_CLAMP_UB (var56.i);
+    /* 24: storeb */
+    ptr0[i] = var57;
+  }
+
+}
+
+void
+video_scale_orc_merge_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2,
+    const guint8 * ORC_RESTRICT s3, const guint8 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 29, 118, 105, 100, 101, 111, 95, 115, 99, 97, 108, 101, 95, 111,
+        114, 99, 95, 109, 101, 114, 103, 101, 95, 52, 116, 97, 112, 95, 117, 56,
+        11, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 12, 1, 1, 14,
+        4, 0, 2, 0, 0, 14, 4, 10, 0, 0, 0, 16, 2, 16, 2, 16,
+        2, 16, 2, 20, 2, 20, 4, 20, 4, 150, 32, 4, 176, 33, 32, 24,
+        150, 32, 5, 176, 34, 32, 25, 103, 33, 33, 34, 150, 32, 6, 176, 34,
+        32, 26, 103, 33, 33, 34, 150, 32, 7, 176, 34, 32, 27, 103, 33, 33,
+        34, 103, 33, 33, 16, 125, 33, 33, 17, 165, 32, 33, 160, 0, 32, 2,
+        0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_merge_4tap_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_scale_orc_merge_4tap_u8");
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_merge_4tap_u8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_source (p, 1, "s3");
+      orc_program_add_source (p, 1, "s4");
+      orc_program_add_constant (p, 4, 0x00000200, "c1");
+      orc_program_add_constant (p, 4, 0x0000000a, "c2");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_parameter (p, 2, "p4");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S3, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convubw", 0, ORC_VAR_T1, ORC_VAR_S4, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T3, ORC_VAR_T1, ORC_VAR_P4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+  ex->params[ORC_VAR_P4] = p4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_scale_orc_resample_vert_4tap_u8 */
+#ifdef DISABLE_ORC
+void
+video_scale_orc_resample_vert_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_int8 var53;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union16 *) s1;
+  ptr5 = (orc_union16 *) s2;
+  ptr6 = (orc_union16 *) s3;
+  ptr7 = (orc_union16 *) s4;
+
+  /* 1: loadpw */
+  var35.i = p1;
+  /* 4: loadpw */
+  var38.i = p2;
+  /* 8: loadpw */
+  var42.i = p3;
+  /* 12: loadpw */
+  var46.i = p4;
+  /* 15: loadpl */
+  var49.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadw */
+    var37 = ptr5[i];
+    /* 5: mulswl */
+    var39.i = var37.i * var38.i;
+    /* 6: addl */
+    var40.i = var36.i + var39.i;
+    /* 7: loadw */
+    var41 = ptr6[i];
+    /* 9: mulswl */
+    var43.i = var41.i * var42.i;
+    /* 10: addl */
+    var44.i = var40.i + var43.i;
+    /* 11: loadw */
+    var45 = ptr7[i];
+    /* 13: mulswl */
+    var47.i = var45.i * var46.i;
+    /* 14: addl */
+    var48.i = var44.i + var47.i;
+    /* 16: addl */
+    var50.i = var48.i + var49.i;
+    /* 17: shrsl */
+    var51.i = var50.i >> 16;
+    /* 18: convssslw */
+    var52.i = ORC_CLAMP_SW (var51.i);
+    /* 19: convsuswb */
+    var53 = ORC_CLAMP_UB (var52.i);
+    /* 20: storeb */
+    ptr0[i] = var53;
+  }
+
+}
+
+#else
+static void
+_backup_video_scale_orc_resample_vert_4tap_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var49;
+#else
+  orc_union32 var49;
+#endif
+  orc_union32 var50;
+  orc_union32 var51;
+  orc_union16 var52;
+  orc_int8 var53;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+  ptr6 = (orc_union16 *) ex->arrays[6];
+  ptr7 = (orc_union16 *) ex->arrays[7];
+
+  /* 1: loadpw */
+  var35.i = ex->params[24];
+  /* 4: loadpw */
+  var38.i = ex->params[25];
+  /* 8: loadpw */
+  var42.i = ex->params[26];
+  /* 12: loadpw */
+  var46.i = ex->params[27];
+  /* 15: loadpl */
+  var49.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadw */
+    var37 = ptr5[i];
+    /* 5: mulswl */
+    var39.i = var37.i * var38.i;
+    /* 6: addl */
+    var40.i = var36.i + var39.i;
+    /* 7: loadw */
+    var41 = ptr6[i];
+    /* 9: mulswl */
+    var43.i = var41.i * var42.i;
+    /* 10: addl */
+    var44.i = var40.i + var43.i;
+    /* 11: loadw */
+    var45 = ptr7[i];
+    /* 13: mulswl */
+    var47.i = var45.i * var46.i;
+    /* 14: addl */
+    var48.i = var44.i + var47.i;
+    /* 16: addl */
+    var50.i = var48.i + var49.i;
+    /* 17: shrsl */
+    var51.i = var50.i >> 16;
+    /* 18: convssslw */
+    var52.i = ORC_CLAMP_SW (var51.i);
+    /* 19: convsuswb */
+    var53 = ORC_CLAMP_UB (var52.i);
+    /* 20: storeb */
+    ptr0[i] = var53;
+  }
+
+}
+
+void
+video_scale_orc_resample_vert_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 37, 118, 105, 100, 101, 111, 95, 115, 99, 97, 108, 101, 95, 111,
+        114, 99, 95, 114, 101, 115, 97, 109, 112, 108, 101, 95, 118, 101, 114, 116,
+        95, 52, 116, 97, 112, 95, 117, 56, 11, 1, 1, 12, 2, 2, 12, 2,
+        2, 12, 2, 2, 12, 2, 2, 14, 4, 0, 128, 0, 0, 14, 4, 16,
+        0, 0, 0, 16, 2, 16, 2, 16, 2, 16, 2, 20, 4, 20, 4, 20,
+        2, 176, 32, 4, 24, 176, 33, 5, 25, 103, 32, 32, 33, 176, 33, 6,
+        26, 103, 32, 32, 33, 176, 33, 7, 27, 103, 32, 32, 33, 103, 32, 32,
+        16, 125, 32, 32, 17, 165, 34, 32, 160, 0, 34, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_4tap_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_scale_orc_resample_vert_4tap_u8");
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_4tap_u8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 2, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_source (p, 2, "s3");
+      orc_program_add_source (p, 2, "s4");
+      orc_program_add_constant (p, 4, 0x00008000, "c1");
+      orc_program_add_constant (p, 4, 0x00000010, "c2");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_parameter (p, 2, "p4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S4, ORC_VAR_P4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T3, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+  ex->params[ORC_VAR_P4] = p4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_scale_orc_resample_vert_4tap_s32 */
+#ifdef DISABLE_ORC
+void
+video_scale_orc_resample_vert_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union16 *) s1;
+  ptr5 = (orc_union16 *) s2;
+  ptr6 = (orc_union16 *) s3;
+  ptr7 = (orc_union16 *) s4;
+
+  /* 1: loadpw */
+  var35.i = p1;
+  /* 4: loadpw */
+  var38.i = p2;
+  /* 8: loadpw */
+  var42.i = p3;
+  /* 12: loadpw */
+  var46.i = p4;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadw */
+    var37 = ptr5[i];
+    /* 5: mulswl */
+    var39.i = var37.i * var38.i;
+    /* 6: addl */
+    var40.i = var36.i + var39.i;
+    /* 7: loadw */
+    var41 = ptr6[i];
+    /* 9: mulswl */
+    var43.i = var41.i * var42.i;
+    /* 10: addl */
+    var44.i = var40.i + var43.i;
+    /* 11: loadw */
+    var45 = ptr7[i];
+    /* 13: mulswl */
+    var47.i = var45.i * var46.i;
+    /* 14: addl */
+    var48.i = var44.i + var47.i;
+    /* 15: storel */
+    ptr0[i] = var48;
+  }
+
+}
+
+#else
+static void
+_backup_video_scale_orc_resample_vert_4tap_s32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union16 var37;
+  orc_union16 var38;
+  orc_union32 var39;
+  orc_union32 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_union16 var46;
+  orc_union32 var47;
+  orc_union32 var48;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+  ptr6 = (orc_union16 *) ex->arrays[6];
+  ptr7 = (orc_union16 *) ex->arrays[7];
+
+  /* 1: loadpw */
+  var35.i = ex->params[24];
+  /* 4: loadpw */
+  var38.i = ex->params[25];
+  /* 8: loadpw */
+  var42.i = ex->params[26];
+  /* 12: loadpw */
+  var46.i = ex->params[27];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadw */
+    var37 = ptr5[i];
+    /* 5: mulswl */
+    var39.i = var37.i * var38.i;
+    /* 6: addl */
+    var40.i = var36.i + var39.i;
+    /* 7: loadw */
+    var41 = ptr6[i];
+    /* 9: mulswl */
+    var43.i = var41.i * var42.i;
+    /* 10: addl */
+    var44.i = var40.i + var43.i;
+    /* 11: loadw */
+    var45 = ptr7[i];
+    /* 13: mulswl */
+    var47.i = var45.i * var46.i;
+    /* 14: addl */
+    var48.i = var44.i + var47.i;
+    /* 15: storel */
+    ptr0[i] = var48;
+  }
+
+}
+
+void
+video_scale_orc_resample_vert_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4, int p1,
+    int p2, int p3, int p4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 38, 118, 105, 100, 101, 111, 95, 115, 99, 97, 108, 101, 95, 111,
+        114, 99, 95, 114, 101, 115, 97, 109, 112, 108, 101, 95, 118, 101, 114, 116,
+        95, 52, 116, 97, 112, 95, 115, 51, 50, 11, 4, 4, 12, 2, 2, 12,
+        2, 2, 12, 2, 2, 12, 2, 2, 16, 2, 16, 2, 16, 2, 16, 2,
+        20, 4, 20, 4, 176, 32, 4, 24, 176, 33, 5, 25, 103, 32, 32, 33,
+        176, 33, 6, 26, 103, 32, 32, 33, 176, 33, 7, 27, 103, 0, 32, 33,
+        2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_4tap_s32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_scale_orc_resample_vert_4tap_s32");
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_4tap_s32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 2, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_source (p, 2, "s3");
+      orc_program_add_source (p, 2, "s4");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_parameter (p, 2, "p4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S4, ORC_VAR_P4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+  ex->params[ORC_VAR_P4] = p4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_scale_orc_resample_vert_acc_4tap_s32 */
+#ifdef DISABLE_ORC
+void
+video_scale_orc_resample_vert_acc_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  const orc_union16 *ORC_RESTRICT ptr8;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union16 *) s2;
+  ptr6 = (orc_union16 *) s3;
+  ptr7 = (orc_union16 *) s4;
+  ptr8 = (orc_union16 *) s5;
+
+  /* 1: loadpw */
+  var35.i = p1;
+  /* 6: loadpw */
+  var40.i = p2;
+  /* 10: loadpw */
+  var44.i = p3;
+  /* 14: loadpw */
+  var48.i = p4;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadl */
+    var37 = ptr4[i];
+    /* 4: addl */
+    var38.i = var37.i + var36.i;
+    /* 5: loadw */
+    var39 = ptr6[i];
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var38.i + var41.i;
+    /* 9: loadw */
+    var43 = ptr7[i];
+    /* 11: mulswl */
+    var45.i = var43.i * var44.i;
+    /* 12: addl */
+    var46.i = var42.i + var45.i;
+    /* 13: loadw */
+    var47 = ptr8[i];
+    /* 15: mulswl */
+    var49.i = var47.i * var48.i;
+    /* 16: addl */
+    var50.i = var46.i + var49.i;
+    /* 17: storel */
+    ptr0[i] = var50;
+  }
+
+}
+
+#else
+static void
+_backup_video_scale_orc_resample_vert_acc_4tap_s32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  const orc_union16 *ORC_RESTRICT ptr8;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+  ptr6 = (orc_union16 *) ex->arrays[6];
+  ptr7 = (orc_union16 *) ex->arrays[7];
+  ptr8 = (orc_union16 *) ex->arrays[8];
+
+  /* 1: loadpw */
+  var35.i = ex->params[24];
+  /* 6: loadpw */
+  var40.i = ex->params[25];
+  /* 10: loadpw */
+  var44.i = ex->params[26];
+  /* 14: loadpw */
+  var48.i = ex->params[27];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadl */
+    var37 = ptr4[i];
+    /* 4: addl */
+    var38.i = var37.i + var36.i;
+    /* 5: loadw */
+    var39 = ptr6[i];
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var38.i + var41.i;
+    /* 9: loadw */
+    var43 = ptr7[i];
+    /* 11: mulswl */
+    var45.i = var43.i * var44.i;
+    /* 12: addl */
+    var46.i = var42.i + var45.i;
+    /* 13: loadw */
+    var47 = ptr8[i];
+    /* 15: mulswl */
+    var49.i = var47.i * var48.i;
+    /* 16: addl */
+    var50.i = var46.i + var49.i;
+    /* 17: storel */
+    ptr0[i] = var50;
+  }
+
+}
+
+void
+video_scale_orc_resample_vert_acc_4tap_s32 (gint32 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 42, 118, 105, 100, 101, 111, 95, 115, 99, 97, 108, 101, 95, 111,
+        114, 99, 95, 114, 101, 115, 97, 109, 112, 108, 101, 95, 118, 101, 114, 116,
+        95, 97, 99, 99, 95, 52, 116, 97, 112, 95, 115, 51, 50, 11, 4, 4,
+        12, 4, 4, 12, 2, 2, 12, 2, 2, 12, 2, 2, 12, 2, 2, 16,
+        2, 16, 2, 16, 2, 16, 2, 20, 4, 20, 4, 176, 33, 5, 24, 103,
+        32, 4, 33, 176, 33, 6, 25, 103, 32, 32, 33, 176, 33, 7, 26, 103,
+        32, 32, 33, 176, 33, 8, 27, 103, 0, 32, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_acc_4tap_s32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_scale_orc_resample_vert_acc_4tap_s32");
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_acc_4tap_s32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_source (p, 2, "s3");
+      orc_program_add_source (p, 2, "s4");
+      orc_program_add_source (p, 2, "s5");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_parameter (p, 2, "p4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S4, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S5, ORC_VAR_P4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+  ex->params[ORC_VAR_P4] = p4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* video_scale_orc_resample_vert_acc_4tap_u8 */
+#ifdef DISABLE_ORC
+void
+video_scale_orc_resample_vert_acc_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  const orc_union16 *ORC_RESTRICT ptr8;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var51;
+#else
+  orc_union32 var51;
+#endif
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union16 var54;
+  orc_int8 var55;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union16 *) s2;
+  ptr6 = (orc_union16 *) s3;
+  ptr7 = (orc_union16 *) s4;
+  ptr8 = (orc_union16 *) s5;
+
+  /* 1: loadpw */
+  var35.i = p1;
+  /* 6: loadpw */
+  var40.i = p2;
+  /* 10: loadpw */
+  var44.i = p3;
+  /* 14: loadpw */
+  var48.i = p4;
+  /* 17: loadpl */
+  var51.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadl */
+    var37 = ptr4[i];
+    /* 4: addl */
+    var38.i = var37.i + var36.i;
+    /* 5: loadw */
+    var39 = ptr6[i];
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var38.i + var41.i;
+    /* 9: loadw */
+    var43 = ptr7[i];
+    /* 11: mulswl */
+    var45.i = var43.i * var44.i;
+    /* 12: addl */
+    var46.i = var42.i + var45.i;
+    /* 13: loadw */
+    var47 = ptr8[i];
+    /* 15: mulswl */
+    var49.i = var47.i * var48.i;
+    /* 16: addl */
+    var50.i = var46.i + var49.i;
+    /* 18: addl */
+    var52.i = var50.i + var51.i;
+    /* 19: shrsl */
+    var53.i = var52.i >> 16;
+    /* 20: convssslw */
+    var54.i = ORC_CLAMP_SW (var53.i);
+    /* 21: convsuswb */
+    var55 = ORC_CLAMP_UB (var54.i);
+    /* 22: storeb */
+    ptr0[i] = var55;
+  }
+
+}
+
+#else
+static void
+_backup_video_scale_orc_resample_vert_acc_4tap_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  const orc_union16 *ORC_RESTRICT ptr6;
+  const orc_union16 *ORC_RESTRICT ptr7;
+  const orc_union16 *ORC_RESTRICT ptr8;
+  orc_union16 var34;
+  orc_union16 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union16 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+  orc_union16 var44;
+  orc_union32 var45;
+  orc_union32 var46;
+  orc_union16 var47;
+  orc_union16 var48;
+  orc_union32 var49;
+  orc_union32 var50;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var51;
+#else
+  orc_union32 var51;
+#endif
+  orc_union32 var52;
+  orc_union32 var53;
+  orc_union16 var54;
+  orc_int8 var55;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+  ptr6 = (orc_union16 *) ex->arrays[6];
+  ptr7 = (orc_union16 *) ex->arrays[7];
+  ptr8 = (orc_union16 *) ex->arrays[8];
+
+  /* 1: loadpw */
+  var35.i = ex->params[24];
+  /* 6: loadpw */
+  var40.i = ex->params[25];
+  /* 10: loadpw */
+  var44.i = ex->params[26];
+  /* 14: loadpw */
+  var48.i = ex->params[27];
+  /* 17: loadpl */
+  var51.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: mulswl */
+    var36.i = var34.i * var35.i;
+    /* 3: loadl */
+    var37 = ptr4[i];
+    /* 4: addl */
+    var38.i = var37.i + var36.i;
+    /* 5: loadw */
+    var39 = ptr6[i];
+    /* 7: mulswl */
+    var41.i = var39.i * var40.i;
+    /* 8: addl */
+    var42.i = var38.i + var41.i;
+    /* 9: loadw */
+    var43 = ptr7[i];
+    /* 11: mulswl */
+    var45.i = var43.i * var44.i;
+    /* 12: addl */
+    var46.i = var42.i + var45.i;
+    /* 13: loadw */
+    var47 = ptr8[i];
+    /* 15: mulswl */
+    var49.i = var47.i * var48.i;
+    /* 16: addl */
+    var50.i = var46.i + var49.i;
+    /* 18: addl */
+    var52.i = var50.i + var51.i;
+    /* 19: shrsl */
+    var53.i = var52.i >> 16;
+    /* 20: convssslw */
+    var54.i = ORC_CLAMP_SW (var53.i);
+    /* 21: convsuswb */
+    var55 = ORC_CLAMP_UB (var54.i);
+    /* 22: storeb */
+    ptr0[i] = var55;
+  }
+
+}
+
+void
+video_scale_orc_resample_vert_acc_4tap_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2,
+    const gint16 * ORC_RESTRICT s3, const gint16 * ORC_RESTRICT s4,
+    const gint16 * ORC_RESTRICT s5, int p1, int p2, int p3, int p4, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 41, 118, 105, 100, 101, 111, 95, 115, 99, 97, 108, 101, 95, 111,
+        114, 99, 95, 114, 101, 115, 97, 109, 112, 108, 101, 95, 118, 101, 114, 116,
+        95, 97, 99, 99, 95, 52, 116, 97, 112, 95, 117, 56, 11, 1, 1, 12,
+        4, 4, 12, 2, 2, 12, 2, 2, 12, 2, 2, 12, 2, 2, 14, 4,
+        0, 128, 0, 0, 14, 4, 16, 0, 0, 0, 16, 2, 16, 2, 16, 2,
+        16, 2, 20, 4, 20, 4, 20, 2, 176, 33, 5, 24, 103, 32, 4, 33,
+        176, 33, 6, 25, 103, 32, 32, 33, 176, 33, 7, 26, 103, 32, 32, 33,
+        176, 33, 8, 27, 103, 32, 32, 33, 103, 32, 32, 16, 125, 32, 32, 17,
+        165, 34, 32, 160, 0, 34, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_acc_4tap_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "video_scale_orc_resample_vert_acc_4tap_u8");
+      orc_program_set_backup_function (p,
+          _backup_video_scale_orc_resample_vert_acc_4tap_u8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_source (p, 2, "s3");
+      orc_program_add_source (p, 2, "s4");
+      orc_program_add_source (p, 2, "s5");
+      orc_program_add_constant (p, 4, 0x00008000, "c1");
+      orc_program_add_constant (p, 4, 0x00000010, "c2");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_parameter (p, 2, "p2");
+      orc_program_add_parameter (p, 2, "p3");
+      orc_program_add_parameter (p, 2, "p4");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+      orc_program_add_temporary (p, 2, "t3");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S3, ORC_VAR_P2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S4, ORC_VAR_P3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_S5, ORC_VAR_P4,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T3, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convsuswb", 0, ORC_VAR_D1, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->arrays[ORC_VAR_S3] = (void *) s3;
+  ex->arrays[ORC_VAR_S4] = (void *) s4;
+  ex->arrays[ORC_VAR_S5] = (void *) s5;
+  ex->params[ORC_VAR_P1] = p1;
+  ex->params[ORC_VAR_P2] = p2;
+  ex->params[ORC_VAR_P3] = p3;
+  ex->params[ORC_VAR_P4] = p4;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
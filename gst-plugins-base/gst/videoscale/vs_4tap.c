@@ -33,6 +33,7 @@
 #include "vs_scanline.h"
 
 #include "vs_4tap.h"
+#include "gstvideoscaleorc.h"
 
 #include <gst/math-compat.h>
 
@@ -46,16 +47,14 @@ static void vs_scanline_resample_4tap_Y (uint8_t * dest, uint8_t * src,
 static void vs_scanline_merge_4tap_Y (uint8_t * dest, uint8_t * src1,
     uint8_t * src2, uint8_t * src3, uint8_t * src4, int n, int acc);
 
-static void vs_scanline_resample_4tap_RGBA (uint8_t * dest, uint8_t * src,
-    int n, int src_width, int *xacc, int increment);
-static void vs_scanline_merge_4tap_RGBA (uint8_t * dest, uint8_t * src1,
-    uint8_t * src2, uint8_t * src3, uint8_t * src4, int n, int acc);
-
 static void vs_scanline_resample_4tap_RGB (uint8_t * dest, uint8_t * src,
     int n, int src_width, int *xacc, int increment);
 static void vs_scanline_merge_4tap_RGB (uint8_t * dest, uint8_t * src1,
     uint8_t * src2, uint8_t * src3, uint8_t * src4, int n, int acc);
 
+static void vs_scanline_resample_4tap_NV12 (uint8_t * dest, uint8_t * src,
+    int n, int src_width, int *xacc, int increment);
+
 static void vs_scanline_resample_4tap_YUYV (uint8_t * dest, uint8_t * src,
     int n, int src_width, int *xacc, int increment);
 static void vs_scanline_merge_4tap_YUYV (uint8_t * dest, uint8_t * src1,
@@ -81,10 +80,18 @@ static void vs_scanline_resample_4tap_Y16 (uint8_t * dest, uint8_t * src,
 static void vs_scanline_merge_4tap_Y16 (uint8_t * dest, uint8_t * src1,
     uint8_t * src2, uint8_t * src3, uint8_t * src4, int n, int acc);
 
-static void vs_scanline_resample_4tap_AYUV64 (uint16_t * dest, uint16_t * src,
-    int n, int src_width, int *xacc, int increment);
-static void vs_scanline_merge_4tap_AYUV64 (uint16_t * dest, uint16_t * src1,
-    uint16_t * src2, uint16_t * src3, uint16_t * src4, int n, int acc);
+/* the line of the source that is in the ring buffer slot of @line after
+ * all lines up to @line have been loaded, lines past the end of the image
+ * are never loaded */
+static int
+vs_4tap_get_line (int line, int height)
+{
+  while (line >= height)
+    line -= 4;
+  if (line < 0)
+    line = height - 1;
+  return line;
+}
 
 static double
 vs_4tap_func (double x)
@@ -168,23 +175,10 @@ void
 vs_scanline_merge_4tap_Y (uint8_t * dest, uint8_t * src1, uint8_t * src2,
     uint8_t * src3, uint8_t * src4, int n, int acc)
 {
-  int i;
-  int y;
-  int a, b, c, d;
-
   acc = (acc >> 8) & 0xff;
-  a = vs_4tap_taps[acc][0];
-  b = vs_4tap_taps[acc][1];
-  c = vs_4tap_taps[acc][2];
-  d = vs_4tap_taps[acc][3];
-  for (i = 0; i < n; i++) {
-    y = a * src1[i];
-    y += b * src2[i];
-    y += c * src3[i];
-    y += d * src4[i];
-    y += (1 << (SHIFT - 1));
-    dest[i] = CLAMP (y >> SHIFT, 0, 255);
-  }
+  video_scale_orc_merge_4tap_u8 (dest, src1, src2, src3, src4,
+      vs_4tap_taps[acc][0], vs_4tap_taps[acc][1], vs_4tap_taps[acc][2],
+      vs_4tap_taps[acc][3], n);
 }
 
 
@@ -210,16 +204,16 @@ vs_image_scale_4tap_Y (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_Y (tmpbuf + i * dest->width,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_Y (tmpbuf + ((k + i) & 3) * dest->width,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -327,16 +321,16 @@ vs_image_scale_4tap_Y16 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_Y16 (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_Y16 (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -406,26 +400,10 @@ void
 vs_scanline_merge_4tap_RGBA (uint8_t * dest, uint8_t * src1, uint8_t * src2,
     uint8_t * src3, uint8_t * src4, int n, int acc)
 {
-  int i;
-  int y;
-  int off;
-  int a, b, c, d;
-
   acc = (acc >> 8) & 0xff;
-  a = vs_4tap_taps[acc][0];
-  b = vs_4tap_taps[acc][1];
-  c = vs_4tap_taps[acc][2];
-  d = vs_4tap_taps[acc][3];
-  for (i = 0; i < n; i++) {
-    for (off = 0; off < 4; off++) {
-      y = a * src1[i * 4 + off];
-      y += b * src2[i * 4 + off];
-      y += c * src3[i * 4 + off];
-      y += d * src4[i * 4 + off];
-      y += (1 << (SHIFT - 1));
-      dest[i * 4 + off] = CLAMP (y >> SHIFT, 0, 255);
-    }
-  }
+  video_scale_orc_merge_4tap_u8 (dest, src1, src2, src3, src4,
+      vs_4tap_taps[acc][0], vs_4tap_taps[acc][1], vs_4tap_taps[acc][2],
+      vs_4tap_taps[acc][3], n * 4);
 }
 
 void
@@ -450,16 +428,16 @@ vs_image_scale_4tap_RGBA (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_RGBA (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height) * src->stride,
+    vs_scanline_resample_4tap_RGBA (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
         dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -528,31 +506,113 @@ vs_scanline_resample_4tap_RGB (uint8_t * dest, uint8_t * src,
 void
 vs_scanline_merge_4tap_RGB (uint8_t * dest, uint8_t * src1, uint8_t * src2,
     uint8_t * src3, uint8_t * src4, int n, int acc)
+{
+  acc = (acc >> 8) & 0xff;
+  video_scale_orc_merge_4tap_u8 (dest, src1, src2, src3, src4,
+      vs_4tap_taps[acc][0], vs_4tap_taps[acc][1], vs_4tap_taps[acc][2],
+      vs_4tap_taps[acc][3], n * 3);
+}
+
+void
+vs_image_scale_4tap_RGB (const VSImage * dest, const VSImage * src,
+    uint8_t * tmpbuf)
+{
+  int yacc;
+  int y_increment;
+  int x_increment;
+  int i;
+  int j;
+  int xacc;
+  int k;
+
+  if (dest->height == 1)
+    y_increment = 0;
+  else
+    y_increment = ((src->height - 1) << 16) / (dest->height - 1);
+
+  if (dest->width == 1)
+    x_increment = 0;
+  else
+    x_increment = ((src->width - 1) << 16) / (dest->width - 1);
+
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
+  for (i = 0; i < 4; i++) {
+    xacc = 0;
+    vs_scanline_resample_4tap_RGB (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
+  }
+
+  for (i = dest->y_start; i < dest->y_end; i++) {
+    uint8_t *t0, *t1, *t2, *t3;
+
+    j = yacc >> 16;
+
+    while (j > k) {
+      k++;
+      if (k + 3 < src->height) {
+        xacc = 0;
+        vs_scanline_resample_4tap_RGB (tmpbuf + ((k + 3) & 3) * dest->stride,
+            src->pixels + (k + 3) * src->stride,
+            dest->width, src->width, &xacc, x_increment);
+      }
+    }
+
+    t0 = tmpbuf + (CLAMP (j - 1, 0, src->height - 1) & 3) * dest->stride;
+    t1 = tmpbuf + (CLAMP (j, 0, src->height - 1) & 3) * dest->stride;
+    t2 = tmpbuf + (CLAMP (j + 1, 0, src->height - 1) & 3) * dest->stride;
+    t3 = tmpbuf + (CLAMP (j + 2, 0, src->height - 1) & 3) * dest->stride;
+    vs_scanline_merge_4tap_RGB (dest->pixels + i * dest->stride,
+        t0, t1, t2, t3, dest->width, yacc & 0xffff);
+
+    yacc += y_increment;
+  }
+}
+
+void
+vs_scanline_resample_4tap_NV12 (uint8_t * dest, uint8_t * src,
+    int n, int src_width, int *xacc, int increment)
 {
   int i;
+  int j;
+  int acc;
+  int x;
   int y;
   int off;
-  int a, b, c, d;
 
-  acc = (acc >> 8) & 0xff;
-  a = vs_4tap_taps[acc][0];
-  b = vs_4tap_taps[acc][1];
-  c = vs_4tap_taps[acc][2];
-  d = vs_4tap_taps[acc][3];
+  acc = *xacc;
   for (i = 0; i < n; i++) {
-    for (off = 0; off < 3; off++) {
-      y = a * src1[i * 3 + off];
-      y += b * src2[i * 3 + off];
-      y += c * src3[i * 3 + off];
-      y += d * src4[i * 3 + off];
+    j = acc >> 16;
+    x = (acc & 0xffff) >> 8;
+
+    for (off = 0; off < 2; off++) {
+      if (j - 1 >= 0 && j + 2 < src_width) {
+        y = vs_4tap_taps[x][0] * src[(j - 1) * 2 + off];
+        y += vs_4tap_taps[x][1] * src[j * 2 + off];
+        y += vs_4tap_taps[x][2] * src[(j + 1) * 2 + off];
+        y += vs_4tap_taps[x][3] * src[(j + 2) * 2 + off];
+      } else {
+        y = vs_4tap_taps[x][0] *
+            src[CLAMP (j - 1, 0, src_width - 1) * 2 + off];
+        y += vs_4tap_taps[x][1] * src[CLAMP (j, 0, src_width - 1) * 2 + off];
+        y += vs_4tap_taps[x][2] *
+            src[CLAMP (j + 1, 0, src_width - 1) * 2 + off];
+        y += vs_4tap_taps[x][3] *
+            src[CLAMP (j + 2, 0, src_width - 1) * 2 + off];
+      }
       y += (1 << (SHIFT - 1));
-      dest[i * 3 + off] = CLAMP (y >> SHIFT, 0, 255);
+      dest[i * 2 + off] = CLAMP (y >> SHIFT, 0, 255);
     }
+    acc += increment;
   }
+  *xacc = acc;
 }
 
+/* the interleaved UV plane of NV12, the lines are merged with the same
+ * function as Y since there is no difference between the components */
 void
-vs_image_scale_4tap_RGB (const VSImage * dest, const VSImage * src,
+vs_image_scale_4tap_NV12 (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf)
 {
   int yacc;
@@ -573,16 +633,16 @@ vs_image_scale_4tap_RGB (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_RGB (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_NV12 (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -591,7 +651,7 @@ vs_image_scale_4tap_RGB (const VSImage * dest, const VSImage * src,
       k++;
       if (k + 3 < src->height) {
         xacc = 0;
-        vs_scanline_resample_4tap_RGB (tmpbuf + ((k + 3) & 3) * dest->stride,
+        vs_scanline_resample_4tap_NV12 (tmpbuf + ((k + 3) & 3) * dest->stride,
             src->pixels + (k + 3) * src->stride,
             dest->width, src->width, &xacc, x_increment);
       }
@@ -601,8 +661,8 @@ vs_image_scale_4tap_RGB (const VSImage * dest, const VSImage * src,
     t1 = tmpbuf + (CLAMP (j, 0, src->height - 1) & 3) * dest->stride;
     t2 = tmpbuf + (CLAMP (j + 1, 0, src->height - 1) & 3) * dest->stride;
     t3 = tmpbuf + (CLAMP (j + 2, 0, src->height - 1) & 3) * dest->stride;
-    vs_scanline_merge_4tap_RGB (dest->pixels + i * dest->stride,
-        t0, t1, t2, t3, dest->width, yacc & 0xffff);
+    vs_scanline_merge_4tap_Y (dest->pixels + i * dest->stride,
+        t0, t1, t2, t3, dest->width * 2, yacc & 0xffff);
 
     yacc += y_increment;
   }
@@ -706,47 +766,10 @@ void
 vs_scanline_merge_4tap_YUYV (uint8_t * dest, uint8_t * src1, uint8_t * src2,
     uint8_t * src3, uint8_t * src4, int n, int acc)
 {
-  int i;
-  int y;
-  int a, b, c, d;
-  int quads = (n + 1) / 2;
-
   acc = (acc >> 8) & 0xff;
-  a = vs_4tap_taps[acc][0];
-  b = vs_4tap_taps[acc][1];
-  c = vs_4tap_taps[acc][2];
-  d = vs_4tap_taps[acc][3];
-  for (i = 0; i < quads; i++) {
-    y = a * src1[i * 4 + 0];
-    y += b * src2[i * 4 + 0];
-    y += c * src3[i * 4 + 0];
-    y += d * src4[i * 4 + 0];
-    y += (1 << (SHIFT - 1));
-    dest[i * 4 + 0] = CLAMP (y >> SHIFT, 0, 255);
-
-    y = a * src1[i * 4 + 1];
-    y += b * src2[i * 4 + 1];
-    y += c * src3[i * 4 + 1];
-    y += d * src4[i * 4 + 1];
-    y += (1 << (SHIFT - 1));
-    dest[i * 4 + 1] = CLAMP (y >> SHIFT, 0, 255);
-
-    if (2 * i + 1 < n) {
-      y = a * src1[i * 4 + 2];
-      y += b * src2[i * 4 + 2];
-      y += c * src3[i * 4 + 2];
-      y += d * src4[i * 4 + 2];
-      y += (1 << (SHIFT - 1));
-      dest[i * 4 + 2] = CLAMP (y >> SHIFT, 0, 255);
-
-      y = a * src1[i * 4 + 3];
-      y += b * src2[i * 4 + 3];
-      y += c * src3[i * 4 + 3];
-      y += d * src4[i * 4 + 3];
-      y += (1 << (SHIFT - 1));
-      dest[i * 4 + 3] = CLAMP (y >> SHIFT, 0, 255);
-    }
-  }
+  video_scale_orc_merge_4tap_u8 (dest, src1, src2, src3, src4,
+      vs_4tap_taps[acc][0], vs_4tap_taps[acc][1], vs_4tap_taps[acc][2],
+      vs_4tap_taps[acc][3], n * 2);
 }
 
 void
@@ -771,16 +794,16 @@ vs_image_scale_4tap_YUYV (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_YUYV (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_YUYV (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -904,47 +927,10 @@ void
 vs_scanline_merge_4tap_UYVY (uint8_t * dest, uint8_t * src1, uint8_t * src2,
     uint8_t * src3, uint8_t * src4, int n, int acc)
 {
-  int i;
-  int y;
-  int a, b, c, d;
-  int quads = (n + 1) / 2;
-
   acc = (acc >> 8) & 0xff;
-  a = vs_4tap_taps[acc][0];
-  b = vs_4tap_taps[acc][1];
-  c = vs_4tap_taps[acc][2];
-  d = vs_4tap_taps[acc][3];
-  for (i = 0; i < quads; i++) {
-    y = a * src1[i * 4 + 0];
-    y += b * src2[i * 4 + 0];
-    y += c * src3[i * 4 + 0];
-    y += d * src4[i * 4 + 0];
-    y += (1 << (SHIFT - 1));
-    dest[i * 4 + 0] = CLAMP (y >> SHIFT, 0, 255);
-
-    y = a * src1[i * 4 + 1];
-    y += b * src2[i * 4 + 1];
-    y += c * src3[i * 4 + 1];
-    y += d * src4[i * 4 + 1];
-    y += (1 << (SHIFT - 1));
-    dest[i * 4 + 1] = CLAMP (y >> SHIFT, 0, 255);
-
-    if (2 * i + 1 < n) {
-      y = a * src1[i * 4 + 2];
-      y += b * src2[i * 4 + 2];
-      y += c * src3[i * 4 + 2];
-      y += d * src4[i * 4 + 2];
-      y += (1 << (SHIFT - 1));
-      dest[i * 4 + 2] = CLAMP (y >> SHIFT, 0, 255);
-
-      y = a * src1[i * 4 + 3];
-      y += b * src2[i * 4 + 3];
-      y += c * src3[i * 4 + 3];
-      y += d * src4[i * 4 + 3];
-      y += (1 << (SHIFT - 1));
-      dest[i * 4 + 3] = CLAMP (y >> SHIFT, 0, 255);
-    }
-  }
+  video_scale_orc_merge_4tap_u8 (dest, src1, src2, src3, src4,
+      vs_4tap_taps[acc][0], vs_4tap_taps[acc][1], vs_4tap_taps[acc][2],
+      vs_4tap_taps[acc][3], n * 2);
 }
 
 void
@@ -969,16 +955,16 @@ vs_image_scale_4tap_UYVY (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_UYVY (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_UYVY (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -1154,16 +1140,16 @@ vs_image_scale_4tap_RGB565 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_RGB565 (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_RGB565 (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -1339,16 +1325,16 @@ vs_image_scale_4tap_RGB555 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_RGB555 (tmpbuf + i * dest->stride,
-        src->pixels + CLAMP (i, 0, src->height - 1) * src->stride, dest->width,
-        src->width, &xacc, x_increment);
+    vs_scanline_resample_4tap_RGB555 (tmpbuf + ((k + i) & 3) * dest->stride,
+        src->pixels + vs_4tap_get_line (k + i, src->height) * src->stride,
+        dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint8_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
@@ -1407,7 +1393,7 @@ vs_scanline_resample_4tap_AYUV64 (uint16_t * dest, uint16_t * src,
                 4 * (src_width - 1) + off)];
       }
       y += (1 << (SHIFT - 1));
-      dest[i * 4 + off] = CLAMP (y >> SHIFT, 0, 255);
+      dest[i * 4 + off] = CLAMP (y >> SHIFT, 0, 65535);
     }
     acc += increment;
   }
@@ -1465,16 +1451,17 @@ vs_image_scale_4tap_AYUV64 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  k = 0;
+  yacc = dest->y_start * y_increment;
+  k = yacc >> 16;
   for (i = 0; i < 4; i++) {
     xacc = 0;
-    vs_scanline_resample_4tap_AYUV64 (tmpbuf + i * dest_pixstride,
-        (guint16 *) (src->pixels + CLAMP (i, 0, src->height - 1) * src->stride),
+    vs_scanline_resample_4tap_AYUV64 (tmpbuf + ((k + i) & 3) * dest_pixstride,
+        (guint16 *) (src->pixels +
+            vs_4tap_get_line (k + i, src->height) * src->stride),
         dest->width, src->width, &xacc, x_increment);
   }
 
-  yacc = 0;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     uint16_t *t0, *t1, *t2, *t3;
 
     j = yacc >> 16;
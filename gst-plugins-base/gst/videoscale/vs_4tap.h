@@ -32,6 +32,30 @@
 
 G_GNUC_INTERNAL void vs_4tap_init (void);
 
+G_GNUC_INTERNAL void vs_scanline_resample_4tap_RGBA   (uint8_t * dest,
+                                                       uint8_t * src,
+                                                       int n, int src_width,
+                                                       int *xacc,
+                                                       int increment);
+G_GNUC_INTERNAL void vs_scanline_merge_4tap_RGBA      (uint8_t * dest,
+                                                       uint8_t * src1,
+                                                       uint8_t * src2,
+                                                       uint8_t * src3,
+                                                       uint8_t * src4,
+                                                       int n, int acc);
+
+G_GNUC_INTERNAL void vs_scanline_resample_4tap_AYUV64 (uint16_t * dest,
+                                                       uint16_t * src,
+                                                       int n, int src_width,
+                                                       int *xacc,
+                                                       int increment);
+G_GNUC_INTERNAL void vs_scanline_merge_4tap_AYUV64    (uint16_t * dest,
+                                                       uint16_t * src1,
+                                                       uint16_t * src2,
+                                                       uint16_t * src3,
+                                                       uint16_t * src4,
+                                                       int n, int acc);
+
 G_GNUC_INTERNAL void vs_image_scale_4tap_Y      (const VSImage * dest,
                                                  const VSImage * src,
                                                  uint8_t       * tmpbuf);
@@ -44,6 +68,10 @@ G_GNUC_INTERNAL void vs_image_scale_4tap_RGB    (const VSImage * dest,
                                                  const VSImage * src,
                                                  uint8_t       * tmpbuf);
 
+G_GNUC_INTERNAL void vs_image_scale_4tap_NV12   (const VSImage * dest,
+                                                 const VSImage * src,
+                                                 uint8_t       * tmpbuf);
+
 G_GNUC_INTERNAL void vs_image_scale_4tap_YUYV   (const VSImage * dest,
                                                  const VSImage * src,
                                                  uint8_t       * tmpbuf);
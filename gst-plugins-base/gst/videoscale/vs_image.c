@@ -62,9 +62,9 @@ vs_image_scale_nearest_RGBA (const VSImage * dest, const VSImage * src,
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
   prev_j = -1;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     if (j == prev_j) {
@@ -107,11 +107,12 @@ vs_image_scale_linear_RGBA (const VSImage * dest, const VSImage * src,
 
 #define LINE(x) ((tmpbuf) + (dest_size)*((x)&1))
 
-  acc = 0;
-  video_scale_orc_resample_bilinear_u32 (LINE (0), src->pixels,
-      0, x_increment, dest->width);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
+  video_scale_orc_resample_bilinear_u32 (LINE (j),
+      src->pixels + j * src->stride, 0, x_increment, dest->width);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -158,8 +159,8 @@ vs_image_scale_nearest_RGB (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -203,13 +204,14 @@ vs_image_scale_linear_RGB (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_RGB (tmp1, src->pixels, src->width, dest->width,
-      &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_RGB (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -288,8 +290,8 @@ vs_image_scale_nearest_YUYV (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -333,13 +335,14 @@ vs_image_scale_linear_YUYV (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_YUYV (tmp1, src->pixels, src->width, dest->width,
-      &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_YUYV (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -418,8 +421,8 @@ vs_image_scale_nearest_UYVY (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -463,13 +466,14 @@ vs_image_scale_linear_UYVY (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_UYVY (tmp1, src->pixels, src->width, dest->width,
-      &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_UYVY (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -548,8 +552,8 @@ vs_image_scale_nearest_NV12 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -593,13 +597,14 @@ vs_image_scale_linear_NV12 (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_NV12 (tmp1, src->pixels, src->width, dest->width,
-      &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_NV12 (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -677,8 +682,8 @@ vs_image_scale_nearest_Y (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     video_scale_orc_resample_nearest_u8 (dest->pixels + i * dest->stride,
@@ -718,12 +723,13 @@ vs_image_scale_linear_Y (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   y2 = -1;
-  video_scale_orc_resample_bilinear_u8 (tmp1, src->pixels,
-      0, x_increment, dest->width);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  video_scale_orc_resample_bilinear_u8 (tmp1, src->pixels + j * src->stride, 0,
+      x_increment, dest->width);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -804,8 +810,8 @@ vs_image_scale_nearest_Y16 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -849,13 +855,14 @@ vs_image_scale_linear_Y16 (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_Y16 (tmp1, src->pixels, src->width, dest->width,
-      &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_Y16 (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -934,8 +941,8 @@ vs_image_scale_nearest_RGB565 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -979,13 +986,14 @@ vs_image_scale_linear_RGB565 (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_RGB565 (tmp1, src->pixels, src->width,
-      dest->width, &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_RGB565 (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -1064,8 +1072,8 @@ vs_image_scale_nearest_RGB555 (const VSImage * dest, const VSImage * src,
   else
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
-  acc = 0;
-  for (i = 0; i < dest->height; i++) {
+  acc = dest->y_start * y_increment;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     xacc = 0;
@@ -1109,13 +1117,14 @@ vs_image_scale_linear_RGB555 (const VSImage * dest, const VSImage * src,
   tmp1 = tmpbuf;
   tmp2 = tmpbuf + dest_size;
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
   y2 = -1;
-  vs_scanline_resample_linear_RGB555 (tmp1, src->pixels, src->width,
-      dest->width, &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_RGB555 (tmp1, src->pixels + j * src->stride,
+      src->width, dest->width, &xacc, x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
@@ -1193,9 +1202,9 @@ vs_image_scale_nearest_AYUV64 (const VSImage * dest, const VSImage * src,
     x_increment = ((src->width - 1) << 16) / (dest->width - 1);
 
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
   prev_j = -1;
-  for (i = 0; i < dest->height; i++) {
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
 
     if (j == prev_j) {
@@ -1242,12 +1251,14 @@ vs_image_scale_linear_AYUV64 (const VSImage * dest, const VSImage * src,
 #undef LINE
 #define LINE(x) ((guint16 *)((tmpbuf) + (dest_size)*((x)&1)))
 
-  acc = 0;
+  acc = dest->y_start * y_increment;
+  j = acc >> 16;
   xacc = 0;
-  vs_scanline_resample_linear_AYUV64 ((guint8 *) LINE (0),
-      src->pixels, src->width, dest->width, &xacc, x_increment);
-  y1 = 0;
-  for (i = 0; i < dest->height; i++) {
+  vs_scanline_resample_linear_AYUV64 ((guint8 *) LINE (j),
+      src->pixels + j * src->stride, src->width, dest->width, &xacc,
+      x_increment);
+  y1 = j;
+  for (i = dest->y_start; i < dest->y_end; i++) {
     j = acc >> 16;
     x = acc & 0xffff;
 
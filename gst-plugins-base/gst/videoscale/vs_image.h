@@ -43,8 +43,24 @@ struct _VSImage {
   int width;
   int height;
   int stride;
+  /* lines of pixels to produce in a destination image, the scaling is still
+   * done for the full height so that bands can be scaled independently */
+  int y_start;
+  int y_end;
 };
 
+/* the planar and packed 4:4:4 layouts have layout + 1 components */
+typedef enum {
+  VS_LANCZOS_Y,
+  VS_LANCZOS_NV12,
+  VS_LANCZOS_RGB,
+  VS_LANCZOS_RGBA,
+  VS_LANCZOS_YUYV,
+  VS_LANCZOS_UYVY
+} VSLanczosLayout;
+
+typedef struct _VSLanczos VSLanczos;
+
 G_GNUC_INTERNAL void vs_image_scale_nearest_RGBA   (const VSImage * dest,
                                                     const VSImage * src,
                                                     uint8_t       * tmpbuf);
@@ -125,6 +141,22 @@ G_GNUC_INTERNAL void vs_image_scale_lanczos_Y      (const VSImage * dest,
                                                     double          a,
                                                     double          sharpen);
 
+G_GNUC_INTERNAL VSLanczos * vs_lanczos_new         (VSLanczosLayout layout,
+                                                    int             src_width,
+                                                    int             src_height,
+                                                    int             dest_width,
+                                                    int             dest_height,
+                                                    double          sharpness,
+                                                    double          sharpen,
+                                                    double          a);
+
+G_GNUC_INTERNAL void vs_lanczos_free               (VSLanczos     * lanczos);
+
+G_GNUC_INTERNAL void vs_image_scale_lanczos_fixed  (const VSImage * dest,
+                                                    const VSImage * src,
+                                                    const VSLanczos * lanczos,
+                                                    gboolean        dither);
+
 
 G_GNUC_INTERNAL void vs_image_scale_nearest_RGB565 (const VSImage * dest,
                                                     const VSImage * src,
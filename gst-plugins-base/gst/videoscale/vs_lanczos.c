@@ -135,12 +135,8 @@
 
 #define SRC_LINE(i) (scale->src->pixels + scale->src->stride * (i))
 
-#define TMP_LINE_S16(i) ((gint16 *)scale->tmpdata + (i)*(scale->dest->width))
-#define TMP_LINE_S32(i) ((gint32 *)scale->tmpdata + (i)*(scale->dest->width))
 #define TMP_LINE_FLOAT(i) ((float *)scale->tmpdata + (i)*(scale->dest->width))
 #define TMP_LINE_DOUBLE(i) ((double *)scale->tmpdata + (i)*(scale->dest->width))
-#define TMP_LINE_S16_AYUV(i) ((gint16 *)scale->tmpdata + (i)*4*(scale->dest->width))
-#define TMP_LINE_S32_AYUV(i) ((gint32 *)scale->tmpdata + (i)*4*(scale->dest->width))
 #define TMP_LINE_FLOAT_AYUV(i) ((float *)scale->tmpdata + (i)*4*(scale->dest->width))
 #define TMP_LINE_DOUBLE_AYUV(i) ((double *)scale->tmpdata + (i)*4*(scale->dest->width))
 
@@ -182,26 +178,12 @@ struct _Scale
   Scale1D y_scale1d;
 };
 
-static void
-vs_image_scale_lanczos_Y_int16 (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen);
-static void vs_image_scale_lanczos_Y_int32 (const VSImage * dest,
-    const VSImage * src, uint8_t * tmpbuf, double sharpness, gboolean dither,
-    double a, double sharpen);
 static void vs_image_scale_lanczos_Y_float (const VSImage * dest,
     const VSImage * src, uint8_t * tmpbuf, double sharpness, gboolean dither,
     double a, double sharpen);
 static void vs_image_scale_lanczos_Y_double (const VSImage * dest,
     const VSImage * src, uint8_t * tmpbuf, double sharpness, gboolean dither,
     double a, double sharpen);
-static void
-vs_image_scale_lanczos_AYUV_int16 (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen);
-static void vs_image_scale_lanczos_AYUV_int32 (const VSImage * dest,
-    const VSImage * src, uint8_t * tmpbuf, double sharpness, gboolean dither,
-    double a, double sharpen);
 static void vs_image_scale_lanczos_AYUV_float (const VSImage * dest,
     const VSImage * src, uint8_t * tmpbuf, double sharpness, gboolean dither,
     double a, double sharpen);
@@ -381,190 +363,25 @@ scale1d_calculate_taps_float (Scale1D * scale, int src_size, int dest_size,
   scale->taps = taps_f;
 }
 
-/*
- * Calculates a set of taps for each destination element in gint32
- * format.  Each set of taps sums to (very nearly) (1<<shift).  A
- * typical value for shift is 10 to 15, so that applying the taps to
- * uint8 values and summing will fit in a (signed) int32.
- */
-static void
-scale1d_calculate_taps_int32 (Scale1D * scale, int src_size, int dest_size,
-    int n_taps, double a, double sharpness, double sharpen, int shift)
-{
-  double *taps_d;
-  gint32 *taps_i;
-  int i;
-  int j;
-  double multiplier;
-
-  scale1d_calculate_taps (scale, src_size, dest_size, n_taps, a, sharpness,
-      sharpen);
-
-  taps_d = scale->taps;
-  taps_i = g_malloc (sizeof (gint32) * scale->n_taps * dest_size);
-
-  multiplier = (1 << shift);
-
-  for (j = 0; j < dest_size; j++) {
-    for (i = 0; i < n_taps; i++) {
-      taps_i[j * n_taps + i] =
-          floor (0.5 + taps_d[j * n_taps + i] * multiplier);
-    }
-  }
-
-  g_free (taps_d);
-  scale->taps = taps_i;
-}
-
-/*
- * Calculates a set of taps for each destination element in gint16
- * format.  Each set of taps sums to (1<<shift).  A typical value
- * for shift is 7, so that applying the taps to uint8 values and
- * summing will fit in a (signed) int16.
- */
-static void
-scale1d_calculate_taps_int16 (Scale1D * scale, int src_size, int dest_size,
-    int n_taps, double a, double sharpness, double sharpen, int shift)
-{
-  double *taps_d;
-  gint16 *taps_i;
-  int i;
-  int j;
-  double multiplier;
-
-  scale1d_calculate_taps (scale, src_size, dest_size, n_taps, a, sharpness,
-      sharpen);
-
-  taps_d = scale->taps;
-  taps_i = g_malloc (sizeof (gint16) * scale->n_taps * dest_size);
-
-  multiplier = (1 << shift);
-
-  /* Various methods for converting floating point taps to integer.
-   * The dB values are the SSIM value between scaling an image via
-   * the floating point pathway vs. the integer pathway using the
-   * given code to generate the taps.  Only one image was tested,
-   * scaling from 1920x1080 to 640x360.  Several variations of the
-   * methods were also tested, with nothing appearing useful.  */
-#if 0
-  /* Standard round to integer.  This causes bad DC errors. */
-  /* 44.588 dB */
-  for (j = 0; j < dest_size; j++) {
-    for (i = 0; i < n_taps; i++) {
-      taps_i[j * n_taps + i] =
-          floor (0.5 + taps_d[j * n_taps + i] * multiplier);
-    }
-  }
-#endif
-#if 0
-  /* Dithering via error propogation.  Works pretty well, but
-   * really we want to propogate errors across rows, which would
-   * mean having several sets of tap arrays.  Possible, but more work,
-   * and it may not even be better. */
-  /* 57.0961 dB */
-  {
-    double err = 0;
-    for (j = 0; j < dest_size; j++) {
-      for (i = 0; i < n_taps; i++) {
-        err += taps_d[j * n_taps + i] * multiplier;
-        taps_i[j * n_taps + i] = floor (err);
-        err -= floor (err);
-      }
-    }
-  }
-#endif
-#if 1
-  /* Round to integer, but with an adjustable bias that we use to
-   * eliminate the DC error.  This search method is a bit crude, and
-   * could perhaps be improved somewhat. */
-  /* 60.4851 dB */
-  for (j = 0; j < dest_size; j++) {
-    int k;
-    for (k = 0; k < 100; k++) {
-      int sum = 0;
-      double offset;
-
-      offset = k * 0.01;
-      for (i = 0; i < n_taps; i++) {
-        taps_i[j * n_taps + i] =
-            floor (offset + taps_d[j * n_taps + i] * multiplier);
-        sum += taps_i[j * n_taps + i];
-      }
-
-      if (sum >= (1 << shift))
-        break;
-    }
-  }
-#endif
-#if 0
-  /* Round to integer, but adjust the multiplier.  The search method is
-   * wrong a lot, but was sufficient enough to calculate dB error. */
-  /* 58.6517 dB */
-  for (j = 0; j < dest_size; j++) {
-    int k;
-    int sum = 0;
-    for (k = 0; k < 200; k++) {
-      sum = 0;
-
-      multiplier = (1 << shift) - 1.0 + k * 0.01;
-      for (i = 0; i < n_taps; i++) {
-        taps_i[j * n_taps + i] =
-            floor (0.5 + taps_d[j * n_taps + i] * multiplier);
-        sum += taps_i[j * n_taps + i];
-      }
-
-      if (sum >= (1 << shift))
-        break;
-    }
-    if (sum != (1 << shift)) {
-      GST_ERROR ("%g %d", multiplier, sum);
-    }
-  }
-#endif
-#if 0
-  /* Round to integer, but subtract the error from the largest tap */
-  /* 58.3677 dB */
-  for (j = 0; j < dest_size; j++) {
-    int err = -multiplier;
-    for (i = 0; i < n_taps; i++) {
-      taps_i[j * n_taps + i] =
-          floor (0.5 + taps_d[j * n_taps + i] * multiplier);
-      err += taps_i[j * n_taps + i];
-    }
-    if (taps_i[j * n_taps + (n_taps / 2 - 1)] >
-        taps_i[j * n_taps + (n_taps / 2)]) {
-      taps_i[j * n_taps + (n_taps / 2 - 1)] -= err;
-    } else {
-      taps_i[j * n_taps + (n_taps / 2)] -= err;
-    }
-  }
-#endif
-
-  g_free (taps_d);
-  scale->taps = taps_i;
-}
-
 
+/* The floating point implementations are kept as a reference for
+ * vs_image_scale_lanczos_fixed(), submethod 2 selects float and all
+ * other values double. */
 void
 vs_image_scale_lanczos_Y (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, int submethod,
     double a, double sharpen)
 {
+  /* nothing to do for an empty band */
+  if (dest->y_start >= dest->y_end)
+    return;
+
   switch (submethod) {
-    case 0:
-    default:
-      vs_image_scale_lanczos_Y_int16 (dest, src, tmpbuf, sharpness, dither, a,
-          sharpen);
-      break;
-    case 1:
-      vs_image_scale_lanczos_Y_int32 (dest, src, tmpbuf, sharpness, dither, a,
-          sharpen);
-      break;
     case 2:
       vs_image_scale_lanczos_Y_float (dest, src, tmpbuf, sharpness, dither, a,
           sharpen);
       break;
-    case 3:
+    default:
       vs_image_scale_lanczos_Y_double (dest, src, tmpbuf, sharpness, dither, a,
           sharpen);
       break;
@@ -576,21 +393,15 @@ vs_image_scale_lanczos_AYUV (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, int submethod,
     double a, double sharpen)
 {
+  if (dest->y_start >= dest->y_end)
+    return;
+
   switch (submethod) {
-    case 0:
-    default:
-      vs_image_scale_lanczos_AYUV_int16 (dest, src, tmpbuf, sharpness, dither,
-          a, sharpen);
-      break;
-    case 1:
-      vs_image_scale_lanczos_AYUV_int32 (dest, src, tmpbuf, sharpness, dither,
-          a, sharpen);
-      break;
     case 2:
       vs_image_scale_lanczos_AYUV_float (dest, src, tmpbuf, sharpness, dither,
           a, sharpen);
       break;
-    case 3:
+    default:
       vs_image_scale_lanczos_AYUV_double (dest, src, tmpbuf, sharpness, dither,
           a, sharpen);
       break;
@@ -602,6 +413,9 @@ vs_image_scale_lanczos_AYUV64 (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, int submethod,
     double a, double sharpen)
 {
+  if (dest->y_start >= dest->y_end)
+    return;
+
   vs_image_scale_lanczos_AYUV64_double (dest, src, tmpbuf, sharpness, dither,
       a, sharpen);
 }
@@ -629,30 +443,6 @@ function (dest_type *dest, const gint32 *offsets, \
   } \
 }
 
-#define RESAMPLE_HORIZ(function, dest_type, tap_type, src_type, _n_taps, _shift) \
-static void \
-function (dest_type *dest, const gint32 *offsets, \
-    const tap_type *taps, const src_type *src, int n_taps, int shift, int n) \
-{ \
-  int i; \
-  int k; \
-  dest_type sum; \
-  const src_type *srcline; \
-  const tap_type *tapsline; \
-  int offset; \
-  if (_shift > 0) offset = (1<<_shift)>>1; \
-  else offset = 0; \
-  for (i = 0; i < n; i++) { \
-    srcline = src + offsets[i]; \
-    tapsline = taps + i * _n_taps; \
-    sum = 0; \
-    for (k = 0; k < _n_taps; k++) { \
-      sum += srcline[k] * tapsline[k]; \
-    } \
-    dest[i] = (sum + offset) >> _shift; \
-  } \
-}
-
 #define RESAMPLE_HORIZ_AYUV_FLOAT(function, dest_type, tap_type, src_type, _n_taps) \
 static void \
 function (dest_type *dest, const gint32 *offsets, \
@@ -686,42 +476,6 @@ function (dest_type *dest, const gint32 *offsets, \
   } \
 }
 
-#define RESAMPLE_HORIZ_AYUV(function, dest_type, tap_type, src_type, _n_taps, _shift) \
-static void \
-function (dest_type *dest, const gint32 *offsets, \
-    const tap_type *taps, const src_type *src, int n_taps, int shift, int n) \
-{ \
-  int i; \
-  int k; \
-  dest_type sum1; \
-  dest_type sum2; \
-  dest_type sum3; \
-  dest_type sum4; \
-  const src_type *srcline; \
-  const tap_type *tapsline; \
-  int offset; \
-  if (_shift > 0) offset = (1<<_shift)>>1; \
-  else offset = 0; \
-  for (i = 0; i < n; i++) { \
-    srcline = src + 4*offsets[i]; \
-    tapsline = taps + i * _n_taps; \
-    sum1 = 0; \
-    sum2 = 0; \
-    sum3 = 0; \
-    sum4 = 0; \
-    for (k = 0; k < _n_taps; k++) { \
-      sum1 += srcline[k*4+0] * tapsline[k]; \
-      sum2 += srcline[k*4+1] * tapsline[k]; \
-      sum3 += srcline[k*4+2] * tapsline[k]; \
-      sum4 += srcline[k*4+3] * tapsline[k]; \
-    } \
-    dest[i*4+0] = (sum1 + offset) >> _shift; \
-    dest[i*4+1] = (sum2 + offset) >> _shift; \
-    dest[i*4+2] = (sum3 + offset) >> _shift; \
-    dest[i*4+3] = (sum4 + offset) >> _shift; \
-  } \
-}
-
 /* *INDENT-OFF* */
 RESAMPLE_HORIZ_FLOAT (resample_horiz_double_u8_generic, double, double,
     guint8, n_taps)
@@ -734,102 +488,6 @@ RESAMPLE_HORIZ_AYUV_FLOAT (resample_horiz_float_ayuv_generic, float, float,
 
 RESAMPLE_HORIZ_AYUV_FLOAT (resample_horiz_double_ayuv_generic_s16, double, double,
     guint16, n_taps)
-
-RESAMPLE_HORIZ (resample_horiz_int32_int32_u8_generic, gint32, gint32,
-    guint8, n_taps, shift)
-RESAMPLE_HORIZ (resample_horiz_int16_int16_u8_generic, gint16, gint16,
-    guint8, n_taps, shift)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int32_int32_ayuv_generic, gint32, gint32,
-    guint8, n_taps, shift)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int16_int16_ayuv_generic, gint16, gint16,
-    guint8, n_taps, shift)
-
-/* Candidates for orcification */
-RESAMPLE_HORIZ (resample_horiz_int32_int32_u8_taps16_shift0, gint32, gint32,
-    guint8, 16, 0)
-RESAMPLE_HORIZ (resample_horiz_int32_int32_u8_taps12_shift0, gint32, gint32,
-    guint8, 12, 0)
-RESAMPLE_HORIZ (resample_horiz_int32_int32_u8_taps8_shift0, gint32, gint32,
-    guint8, 8, 0)
-RESAMPLE_HORIZ (resample_horiz_int32_int32_u8_taps4_shift0, gint32, gint32,
-    guint8, 4, 0)
-RESAMPLE_HORIZ (resample_horiz_int16_int16_u8_taps16_shift0, gint16, gint16,
-    guint8, 16, 0)
-RESAMPLE_HORIZ (resample_horiz_int16_int16_u8_taps12_shift0, gint16, gint16,
-    guint8, 12, 0)
-RESAMPLE_HORIZ (resample_horiz_int16_int16_u8_taps8_shift0, gint16, gint16,
-    guint8, 8, 0)
-RESAMPLE_HORIZ (resample_horiz_int16_int16_u8_taps4_shift0, gint16, gint16,
-    guint8, 4, 0)
-
-RESAMPLE_HORIZ_AYUV (resample_horiz_int32_int32_ayuv_taps16_shift0, gint32, gint32,
-    guint8, 16, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int32_int32_ayuv_taps12_shift0, gint32, gint32,
-    guint8, 12, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int32_int32_ayuv_taps8_shift0, gint32, gint32,
-    guint8, 8, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int32_int32_ayuv_taps4_shift0, gint32, gint32,
-    guint8, 4, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int16_int16_ayuv_taps16_shift0, gint16, gint16,
-    guint8, 16, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int16_int16_ayuv_taps12_shift0, gint16, gint16,
-    guint8, 12, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int16_int16_ayuv_taps8_shift0, gint16, gint16,
-    guint8, 8, 0)
-RESAMPLE_HORIZ_AYUV (resample_horiz_int16_int16_ayuv_taps4_shift0, gint16, gint16,
-    guint8, 4, 0)
-/* *INDENT-ON* */
-
-#define RESAMPLE_VERT(function, tap_type, src_type, _n_taps, _shift) \
-static void \
-function (guint8 *dest, \
-    const tap_type *taps, const src_type *src, int stride, int n_taps, \
-    int shift, int n) \
-{ \
-  int i; \
-  int l; \
-  gint32 sum_y; \
-  gint32 offset = (1<<_shift) >> 1; \
-  for (i = 0; i < n; i++) { \
-    sum_y = 0; \
-    for (l = 0; l < n_taps; l++) { \
-      const src_type *line = PTR_OFFSET(src, stride * l); \
-      sum_y += line[i] * taps[l]; \
-    } \
-    dest[i] = CLAMP ((sum_y + offset) >> _shift, 0, 255); \
-  } \
-}
-
-#define RESAMPLE_VERT_DITHER(function, tap_type, src_type, _n_taps, _shift) \
-static void \
-function (guint8 *dest, \
-    const tap_type *taps, const src_type *src, int stride, int n_taps, \
-    int shift, int n) \
-{ \
-  int i; \
-  int l; \
-  gint32 sum_y; \
-  gint32 err_y = 0; \
-  gint32 mask = (1<<_shift) - 1; \
-  for (i = 0; i < n; i++) { \
-    sum_y = 0; \
-    for (l = 0; l < n_taps; l++) { \
-      const src_type *line = PTR_OFFSET(src, stride * l); \
-      sum_y += line[i] * taps[l]; \
-    } \
-    err_y += sum_y; \
-    dest[i] = CLAMP (err_y >> _shift, 0, 255); \
-    err_y &= mask; \
-  } \
-}
-
-/* *INDENT-OFF* */
-RESAMPLE_VERT (resample_vert_int32_generic, gint32, gint32, n_taps, shift)
-RESAMPLE_VERT_DITHER (resample_vert_dither_int32_generic, gint32, gint32,
-    n_taps, shift)
-RESAMPLE_VERT (resample_vert_int16_generic, gint16, gint16, n_taps, shift);
-RESAMPLE_VERT_DITHER (resample_vert_dither_int16_generic, gint16, gint16,
-    n_taps, shift)
 /* *INDENT-ON* */
 
 #define RESAMPLE_VERT_FLOAT(function, dest_type, clamp, tap_type, src_type, _n_taps, _shift) \
@@ -889,52 +547,47 @@ RESAMPLE_VERT_FLOAT_DITHER (resample_vert_dither_float_generic, guint8, 255, flo
     n_taps, shift)
 /* *INDENT-ON* */
 
-#define S16_SHIFT1 7
-#define S16_SHIFT2 7
-#define S16_MIDSHIFT 0
-#define S16_POSTSHIFT (S16_SHIFT1+S16_SHIFT2-S16_MIDSHIFT)
-
 static void
-vs_scale_lanczos_Y_int16 (Scale * scale)
+vs_scale_lanczos_Y_double (Scale * scale)
 {
   int j;
   int yi;
   int tmp_yi;
 
-  tmp_yi = 0;
+  tmp_yi = MAX (0, scale->y_scale1d.offsets[scale->dest->y_start]);
 
-  for (j = 0; j < scale->dest->height; j++) {
+  for (j = scale->dest->y_start; j < scale->dest->y_end; j++) {
     guint8 *destline;
-    gint16 *taps;
+    double *taps;
 
     destline = scale->dest->pixels + scale->dest->stride * j;
 
     yi = scale->y_scale1d.offsets[j];
 
     while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_S16 (tmp_yi),
+      scale->horiz_resample_func (TMP_LINE_DOUBLE (tmp_yi),
           scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, S16_MIDSHIFT, scale->dest->width);
+          scale->x_scale1d.n_taps, 0, scale->dest->width);
       tmp_yi++;
     }
 
-    taps = (gint16 *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
+    taps = (double *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
     if (scale->dither) {
-      resample_vert_dither_int16_generic (destline,
-          taps, TMP_LINE_S16 (scale->y_scale1d.offsets[j]),
-          sizeof (gint16) * scale->dest->width, scale->y_scale1d.n_taps,
-          S16_POSTSHIFT, scale->dest->width);
+      resample_vert_dither_double_generic (destline,
+          taps, TMP_LINE_DOUBLE (scale->y_scale1d.offsets[j]),
+          sizeof (double) * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width);
     } else {
-      resample_vert_int16_generic (destline,
-          taps, TMP_LINE_S16 (scale->y_scale1d.offsets[j]),
-          sizeof (gint16) * scale->dest->width, scale->y_scale1d.n_taps,
-          S16_POSTSHIFT, scale->dest->width);
+      resample_vert_double_generic (destline,
+          taps, TMP_LINE_DOUBLE (scale->y_scale1d.offsets[j]),
+          sizeof (double) * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width);
     }
   }
 }
 
 void
-vs_image_scale_lanczos_Y_int16 (const VSImage * dest, const VSImage * src,
+vs_image_scale_lanczos_Y_double (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
     double sharpen)
 {
@@ -946,96 +599,69 @@ vs_image_scale_lanczos_Y_int16 (const VSImage * dest, const VSImage * src,
   scale->src = src;
 
   n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  n_taps = ROUND_UP_4 (n_taps);
-  scale1d_calculate_taps_int16 (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen, S16_SHIFT1);
+  scale1d_calculate_taps (&scale->x_scale1d,
+      src->width, dest->width, n_taps, a, sharpness, sharpen);
 
   n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps_int16 (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen, S16_SHIFT2);
+  scale1d_calculate_taps (&scale->y_scale1d,
+      src->height, dest->height, n_taps, a, sharpness, sharpen);
 
   scale->dither = dither;
 
-  switch (scale->x_scale1d.n_taps) {
-    case 4:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_u8_taps4_shift0;
-      break;
-    case 8:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_u8_taps8_shift0;
-      break;
-    case 12:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_u8_taps12_shift0;
-      break;
-    case 16:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_u8_taps16_shift0;
-      break;
-    default:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_u8_generic;
-      break;
-  }
+  scale->horiz_resample_func =
+      (HorizResampleFunc) resample_horiz_double_u8_generic;
 
   scale->tmpdata =
-      g_malloc (sizeof (gint16) * scale->dest->width * scale->src->height);
+      g_malloc (sizeof (double) * scale->dest->width * scale->src->height);
 
-  vs_scale_lanczos_Y_int16 (scale);
+  vs_scale_lanczos_Y_double (scale);
 
   scale1d_cleanup (&scale->x_scale1d);
   scale1d_cleanup (&scale->y_scale1d);
   g_free (scale->tmpdata);
 }
 
-
-#define S32_SHIFT1 11
-#define S32_SHIFT2 11
-#define S32_MIDSHIFT 0
-#define S32_POSTSHIFT (S32_SHIFT1+S32_SHIFT2-S32_MIDSHIFT)
-
 static void
-vs_scale_lanczos_Y_int32 (Scale * scale)
+vs_scale_lanczos_Y_float (Scale * scale)
 {
   int j;
   int yi;
   int tmp_yi;
 
-  tmp_yi = 0;
+  tmp_yi = MAX (0, scale->y_scale1d.offsets[scale->dest->y_start]);
 
-  for (j = 0; j < scale->dest->height; j++) {
+  for (j = scale->dest->y_start; j < scale->dest->y_end; j++) {
     guint8 *destline;
-    gint32 *taps;
+    float *taps;
 
     destline = scale->dest->pixels + scale->dest->stride * j;
 
     yi = scale->y_scale1d.offsets[j];
 
     while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_S32 (tmp_yi),
+      scale->horiz_resample_func (TMP_LINE_FLOAT (tmp_yi),
           scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, S32_MIDSHIFT, scale->dest->width);
+          scale->x_scale1d.n_taps, 0, scale->dest->width);
       tmp_yi++;
     }
 
-    taps = (gint32 *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
+    taps = (float *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
     if (scale->dither) {
-      resample_vert_dither_int32_generic (destline,
-          taps, TMP_LINE_S32 (scale->y_scale1d.offsets[j]),
-          sizeof (gint32) * scale->dest->width,
-          scale->y_scale1d.n_taps, S32_POSTSHIFT, scale->dest->width);
+      resample_vert_dither_float_generic (destline,
+          taps, TMP_LINE_FLOAT (scale->y_scale1d.offsets[j]),
+          sizeof (float) * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width);
     } else {
-      resample_vert_int32_generic (destline,
-          taps, TMP_LINE_S32 (scale->y_scale1d.offsets[j]),
-          sizeof (gint32) * scale->dest->width,
-          scale->y_scale1d.n_taps, S32_POSTSHIFT, scale->dest->width);
+      resample_vert_float_generic (destline,
+          taps, TMP_LINE_FLOAT (scale->y_scale1d.offsets[j]),
+          sizeof (float) * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width);
     }
   }
 }
 
 void
-vs_image_scale_lanczos_Y_int32 (const VSImage * dest, const VSImage * src,
+vs_image_scale_lanczos_Y_float (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
     double sharpen)
 {
@@ -1047,59 +673,42 @@ vs_image_scale_lanczos_Y_int32 (const VSImage * dest, const VSImage * src,
   scale->src = src;
 
   n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  n_taps = ROUND_UP_4 (n_taps);
-  scale1d_calculate_taps_int32 (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen, S32_SHIFT1);
+  scale1d_calculate_taps_float (&scale->x_scale1d,
+      src->width, dest->width, n_taps, a, sharpness, sharpen);
 
   n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps_int32 (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen, S32_SHIFT2);
+  scale1d_calculate_taps_float (&scale->y_scale1d,
+      src->height, dest->height, n_taps, a, sharpness, sharpen);
 
   scale->dither = dither;
 
-  switch (scale->x_scale1d.n_taps) {
-    case 4:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_u8_taps4_shift0;
-      break;
-    case 8:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_u8_taps8_shift0;
-      break;
-    case 12:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_u8_taps12_shift0;
-      break;
-    case 16:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_u8_taps16_shift0;
-      break;
-    default:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_u8_generic;
-      break;
-  }
+  scale->horiz_resample_func =
+      (HorizResampleFunc) resample_horiz_float_u8_generic;
 
   scale->tmpdata =
-      g_malloc (sizeof (int32_t) * scale->dest->width * scale->src->height);
+      g_malloc (sizeof (float) * scale->dest->width * scale->src->height);
 
-  vs_scale_lanczos_Y_int32 (scale);
+  vs_scale_lanczos_Y_float (scale);
 
   scale1d_cleanup (&scale->x_scale1d);
   scale1d_cleanup (&scale->y_scale1d);
   g_free (scale->tmpdata);
 }
 
+
+
+
+
 static void
-vs_scale_lanczos_Y_double (Scale * scale)
+vs_scale_lanczos_AYUV_double (Scale * scale)
 {
   int j;
   int yi;
   int tmp_yi;
 
-  tmp_yi = 0;
+  tmp_yi = MAX (0, scale->y_scale1d.offsets[scale->dest->y_start]);
 
-  for (j = 0; j < scale->dest->height; j++) {
+  for (j = scale->dest->y_start; j < scale->dest->y_end; j++) {
     guint8 *destline;
     double *taps;
 
@@ -1108,7 +717,7 @@ vs_scale_lanczos_Y_double (Scale * scale)
     yi = scale->y_scale1d.offsets[j];
 
     while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_DOUBLE (tmp_yi),
+      scale->horiz_resample_func (TMP_LINE_DOUBLE_AYUV (tmp_yi),
           scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
           scale->x_scale1d.n_taps, 0, scale->dest->width);
       tmp_yi++;
@@ -1117,20 +726,20 @@ vs_scale_lanczos_Y_double (Scale * scale)
     taps = (double *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
     if (scale->dither) {
       resample_vert_dither_double_generic (destline,
-          taps, TMP_LINE_DOUBLE (scale->y_scale1d.offsets[j]),
-          sizeof (double) * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width);
+          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (double) * 4 * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
     } else {
       resample_vert_double_generic (destline,
-          taps, TMP_LINE_DOUBLE (scale->y_scale1d.offsets[j]),
-          sizeof (double) * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width);
+          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (double) * 4 * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
     }
   }
 }
 
 void
-vs_image_scale_lanczos_Y_double (const VSImage * dest, const VSImage * src,
+vs_image_scale_lanczos_AYUV_double (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
     double sharpen)
 {
@@ -1152,12 +761,12 @@ vs_image_scale_lanczos_Y_double (const VSImage * dest, const VSImage * src,
   scale->dither = dither;
 
   scale->horiz_resample_func =
-      (HorizResampleFunc) resample_horiz_double_u8_generic;
+      (HorizResampleFunc) resample_horiz_double_ayuv_generic;
 
   scale->tmpdata =
-      g_malloc (sizeof (double) * scale->dest->width * scale->src->height);
+      g_malloc (sizeof (double) * scale->dest->width * scale->src->height * 4);
 
-  vs_scale_lanczos_Y_double (scale);
+  vs_scale_lanczos_AYUV_double (scale);
 
   scale1d_cleanup (&scale->x_scale1d);
   scale1d_cleanup (&scale->y_scale1d);
@@ -1165,15 +774,15 @@ vs_image_scale_lanczos_Y_double (const VSImage * dest, const VSImage * src,
 }
 
 static void
-vs_scale_lanczos_Y_float (Scale * scale)
+vs_scale_lanczos_AYUV_float (Scale * scale)
 {
   int j;
   int yi;
   int tmp_yi;
 
-  tmp_yi = 0;
+  tmp_yi = MAX (0, scale->y_scale1d.offsets[scale->dest->y_start]);
 
-  for (j = 0; j < scale->dest->height; j++) {
+  for (j = scale->dest->y_start; j < scale->dest->y_end; j++) {
     guint8 *destline;
     float *taps;
 
@@ -1182,7 +791,7 @@ vs_scale_lanczos_Y_float (Scale * scale)
     yi = scale->y_scale1d.offsets[j];
 
     while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_FLOAT (tmp_yi),
+      scale->horiz_resample_func (TMP_LINE_FLOAT_AYUV (tmp_yi),
           scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
           scale->x_scale1d.n_taps, 0, scale->dest->width);
       tmp_yi++;
@@ -1191,20 +800,20 @@ vs_scale_lanczos_Y_float (Scale * scale)
     taps = (float *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
     if (scale->dither) {
       resample_vert_dither_float_generic (destline,
-          taps, TMP_LINE_FLOAT (scale->y_scale1d.offsets[j]),
-          sizeof (float) * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width);
+          taps, TMP_LINE_FLOAT_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (float) * 4 * scale->dest->width, scale->y_scale1d.n_taps, 0,
+          scale->dest->width * 4);
     } else {
       resample_vert_float_generic (destline,
-          taps, TMP_LINE_FLOAT (scale->y_scale1d.offsets[j]),
-          sizeof (float) * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width);
+          taps, TMP_LINE_FLOAT_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (float) * 4 * scale->dest->width, scale->y_scale1d.n_taps, 0,
+          scale->dest->width * 4);
     }
   }
 }
 
 void
-vs_image_scale_lanczos_Y_float (const VSImage * dest, const VSImage * src,
+vs_image_scale_lanczos_AYUV_float (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
     double sharpen)
 {
@@ -1226,63 +835,59 @@ vs_image_scale_lanczos_Y_float (const VSImage * dest, const VSImage * src,
   scale->dither = dither;
 
   scale->horiz_resample_func =
-      (HorizResampleFunc) resample_horiz_float_u8_generic;
+      (HorizResampleFunc) resample_horiz_float_ayuv_generic;
 
   scale->tmpdata =
-      g_malloc (sizeof (float) * scale->dest->width * scale->src->height);
+      g_malloc (sizeof (float) * scale->dest->width * scale->src->height * 4);
 
-  vs_scale_lanczos_Y_float (scale);
+  vs_scale_lanczos_AYUV_float (scale);
 
   scale1d_cleanup (&scale->x_scale1d);
   scale1d_cleanup (&scale->y_scale1d);
   g_free (scale->tmpdata);
 }
 
-
-
-
-
 static void
-vs_scale_lanczos_AYUV_int16 (Scale * scale)
+vs_scale_lanczos_AYUV64_double (Scale * scale)
 {
   int j;
   int yi;
   int tmp_yi;
 
-  tmp_yi = 0;
+  tmp_yi = MAX (0, scale->y_scale1d.offsets[scale->dest->y_start]);
 
-  for (j = 0; j < scale->dest->height; j++) {
-    guint8 *destline;
-    gint16 *taps;
+  for (j = scale->dest->y_start; j < scale->dest->y_end; j++) {
+    guint16 *destline;
+    double *taps;
 
-    destline = scale->dest->pixels + scale->dest->stride * j;
+    destline = (guint16 *) (scale->dest->pixels + scale->dest->stride * j);
 
     yi = scale->y_scale1d.offsets[j];
 
     while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_S16_AYUV (tmp_yi),
+      scale->horiz_resample_func (TMP_LINE_DOUBLE_AYUV (tmp_yi),
           scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, S16_MIDSHIFT, scale->dest->width);
+          scale->x_scale1d.n_taps, 0, scale->dest->width);
       tmp_yi++;
     }
 
-    taps = (gint16 *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
+    taps = (double *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
     if (scale->dither) {
-      resample_vert_dither_int16_generic (destline,
-          taps, TMP_LINE_S16_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (gint16) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, S16_POSTSHIFT, scale->dest->width * 4);
+      resample_vert_dither_double_generic_u16 (destline,
+          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (double) * 4 * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
     } else {
-      resample_vert_int16_generic (destline,
-          taps, TMP_LINE_S16_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (gint16) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, S16_POSTSHIFT, scale->dest->width * 4);
+      resample_vert_double_generic_u16 (destline,
+          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
+          sizeof (double) * 4 * scale->dest->width,
+          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
     }
   }
 }
 
 void
-vs_image_scale_lanczos_AYUV_int16 (const VSImage * dest, const VSImage * src,
+vs_image_scale_lanczos_AYUV64_double (const VSImage * dest, const VSImage * src,
     uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
     double sharpen)
 {
@@ -1294,363 +899,536 @@ vs_image_scale_lanczos_AYUV_int16 (const VSImage * dest, const VSImage * src,
   scale->src = src;
 
   n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  n_taps = ROUND_UP_4 (n_taps);
-  scale1d_calculate_taps_int16 (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen, S16_SHIFT1);
+  scale1d_calculate_taps (&scale->x_scale1d,
+      src->width, dest->width, n_taps, a, sharpness, sharpen);
 
   n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps_int16 (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen, S16_SHIFT2);
+  scale1d_calculate_taps (&scale->y_scale1d,
+      src->height, dest->height, n_taps, a, sharpness, sharpen);
 
   scale->dither = dither;
 
-  switch (scale->x_scale1d.n_taps) {
-    case 4:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_ayuv_taps4_shift0;
-      break;
-    case 8:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_ayuv_taps8_shift0;
-      break;
-    case 12:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_ayuv_taps12_shift0;
-      break;
-    case 16:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_ayuv_taps16_shift0;
-      break;
-    default:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int16_int16_ayuv_generic;
-      break;
-  }
+  scale->horiz_resample_func =
+      (HorizResampleFunc) resample_horiz_double_ayuv_generic_s16;
 
   scale->tmpdata =
-      g_malloc (sizeof (gint16) * scale->dest->width * scale->src->height * 4);
+      g_malloc (sizeof (double) * scale->dest->width * scale->src->height * 4);
 
-  vs_scale_lanczos_AYUV_int16 (scale);
+  vs_scale_lanczos_AYUV64_double (scale);
 
   scale1d_cleanup (&scale->x_scale1d);
   scale1d_cleanup (&scale->y_scale1d);
   g_free (scale->tmpdata);
 }
 
+/*
+ * Fixed point scaler with cached filter banks
+ * ===========================================
+ *
+ * The taps of both directions are calculated once for a geometry and
+ * kept in a VSLanczos.  They are stored as int16 with FIXED_TAP_SHIFT
+ * bits of fraction and padded to a multiple of 4.  Taps that fall
+ * outside of the source are folded onto the edge pixels, so that the
+ * window of every destination pixel is completely inside the source and
+ * the inner loops don't need to clamp.
+ *
+ * The horizontal pass filters a source line into a line of int16 values
+ * with FIXED_MID_SHIFT bits of fraction, in the layout of the destination.
+ * These lines are kept in a ring buffer with one line per vertical tap, so
+ * that a band only filters the source lines it needs.  The vertical pass
+ * combines the lines in groups of 4 taps with Orc, accumulating in int32.
+ */
 
-static void
-vs_scale_lanczos_AYUV_int32 (Scale * scale)
-{
-  int j;
-  int yi;
-  int tmp_yi;
-
-  tmp_yi = 0;
-
-  for (j = 0; j < scale->dest->height; j++) {
-    guint8 *destline;
-    gint32 *taps;
-
-    destline = scale->dest->pixels + scale->dest->stride * j;
-
-    yi = scale->y_scale1d.offsets[j];
+#define FIXED_TAP_SHIFT 12
+#define FIXED_MID_SHIFT 4
+#define FIXED_HORIZ_SHIFT (FIXED_TAP_SHIFT - FIXED_MID_SHIFT)
+#define FIXED_VERT_SHIFT (FIXED_TAP_SHIFT + FIXED_MID_SHIFT)
 
-    while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_S32_AYUV (tmp_yi),
-          scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, S32_MIDSHIFT, scale->dest->width);
-      tmp_yi++;
-    }
+/* limit of the sum of the absolute tap values, the intermediate values
+ * fit in int16 and the vertical sums in int32 below this */
+#define FIXED_MAX_GAIN 7.5
 
-    taps = (gint32 *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
-    if (scale->dither) {
-      resample_vert_dither_int32_generic (destline,
-          taps, TMP_LINE_S32_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (gint32) * 4 * scale->dest->width, scale->y_scale1d.n_taps,
-          S32_POSTSHIFT, scale->dest->width * 4);
-    } else {
-      resample_vert_int32_generic (destline,
-          taps, TMP_LINE_S32_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (gint32) * 4 * scale->dest->width, scale->y_scale1d.n_taps,
-          S32_POSTSHIFT, scale->dest->width * 4);
-    }
-  }
-}
-
-void
-vs_image_scale_lanczos_AYUV_int32 (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen)
+typedef struct _VSLanczosBank VSLanczosBank;
+struct _VSLanczosBank
 {
-  Scale s = { 0 };
-  Scale *scale = &s;
   int n_taps;
+  gint32 *offsets;
+  gint16 *taps;
+};
 
-  scale->dest = dest;
-  scale->src = src;
-
-  n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  n_taps = ROUND_UP_4 (n_taps);
-  scale1d_calculate_taps_int32 (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen, S32_SHIFT1);
-
-  n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps_int32 (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen, S32_SHIFT2);
+struct _VSLanczos
+{
+  VSLanczosLayout layout;
+  int src_width;
+  int src_height;
+  int dest_width;
+  int dest_height;
+
+  VSLanczosBank x_bank;
+  /* horizontal taps of the chroma of packed 4:2:2 */
+  VSLanczosBank x_chroma_bank;
+  VSLanczosBank y_bank;
+
+  /* values per pixel, 2 for packed 4:2:2 */
+  int n_comps;
+  /* values in a filtered line and values written to the destination */
+  int line_size;
+  int dest_size;
+  /* bytes of a source line and the size of the zero padded copy that is
+   * used when the source is narrower than the filter window */
+  int src_size;
+  int pad_size;
+};
 
-  scale->dither = dither;
+typedef void (*FixedHorizFunc) (gint16 * dest, const gint32 * offsets,
+    const gint16 * taps, const guint8 * src, int n_taps, int n);
 
-  switch (scale->x_scale1d.n_taps) {
-    case 4:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_ayuv_taps4_shift0;
-      break;
-    case 8:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_ayuv_taps8_shift0;
-      break;
-    case 12:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_ayuv_taps12_shift0;
-      break;
-    case 16:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_ayuv_taps16_shift0;
-      break;
-    default:
-      scale->horiz_resample_func =
-          (HorizResampleFunc) resample_horiz_int32_int32_ayuv_generic;
-      break;
+/* Calculates the normalized taps of the n_taps pixels starting at start
+ * and returns the sum of their absolute values.  Taps outside of the
+ * source are folded onto the edge pixels. */
+static double
+vs_lanczos_calculate_taps (double *taps, int n_taps, int start, int xi,
+    int dx, double x, double fx, double ex, double sharpen, int src_size)
+{
+  double weight;
+  double gain;
+  int l;
+
+  for (l = 0; l < n_taps; l++)
+    taps[l] = 0;
+
+  weight = 0;
+  for (l = 0; l < 2 * dx; l++) {
+    int xl = xi + l;
+    double t;
+
+    t = sinc ((x - xl) * fx) * envelope ((x - xl) * ex);
+    t -= sharpen * envelope ((x - xl) * ex);
+    taps[CLAMP (xl, 0, src_size - 1) - start] += t;
+    weight += t;
   }
 
-  scale->tmpdata =
-      g_malloc (sizeof (int32_t) * scale->dest->width * scale->src->height * 4);
-
-  vs_scale_lanczos_AYUV_int32 (scale);
+  gain = 0;
+  for (l = 0; l < n_taps; l++) {
+    taps[l] /= weight;
+    gain += fabs (taps[l]);
+  }
 
-  scale1d_cleanup (&scale->x_scale1d);
-  scale1d_cleanup (&scale->y_scale1d);
-  g_free (scale->tmpdata);
+  return gain;
 }
 
 static void
-vs_scale_lanczos_AYUV_double (Scale * scale)
+vs_lanczos_bank_init (VSLanczosBank * bank, int src_size, int dest_size,
+    double a, double sharpness, double sharpen)
 {
+  double scale;
+  double offset;
+  double fx;
+  double ex;
+  double *taps_d;
+  int dx;
   int j;
-  int yi;
-  int tmp_yi;
-
-  tmp_yi = 0;
+  int l;
 
-  for (j = 0; j < scale->dest->height; j++) {
-    guint8 *destline;
-    double *taps;
+  scale = src_size / (double) dest_size;
+  offset = scale / 2 - 0.5;
+  if (scale > 1.0) {
+    fx = (1.0 / scale) * sharpness;
+  } else {
+    fx = (1.0) * sharpness;
+  }
+  ex = fx / a;
+  dx = ceil (a / fx);
 
-    destline = scale->dest->pixels + scale->dest->stride * j;
+  bank->n_taps = ROUND_UP_4 (2 * dx);
+  bank->offsets = g_malloc (sizeof (gint32) * dest_size);
+  bank->taps = g_malloc (sizeof (gint16) * bank->n_taps * dest_size);
+  taps_d = g_malloc (sizeof (double) * bank->n_taps);
 
-    yi = scale->y_scale1d.offsets[j];
+  for (j = 0; j < dest_size; j++) {
+    gint16 *taps;
+    double x;
+    double gain;
+    int xi;
+    int start;
+    int sum;
+    int max;
 
-    while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_DOUBLE_AYUV (tmp_yi),
-          scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, 0, scale->dest->width);
-      tmp_yi++;
-    }
+    x = offset + scale * j;
+    x = CLAMP (x, 0, src_size);
+    xi = ceil (x) - dx;
 
-    taps = (double *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
-    if (scale->dither) {
-      resample_vert_dither_double_generic (destline,
-          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (double) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
-    } else {
-      resample_vert_double_generic (destline,
-          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (double) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
+    /* the window of n_taps pixels, moved inside the source */
+    start = CLAMP (xi, 0, MAX (0, src_size - bank->n_taps));
+    bank->offsets[j] = start;
+
+    gain = vs_lanczos_calculate_taps (taps_d, bank->n_taps, start, xi, dx, x,
+        fx, ex, sharpen, src_size);
+    /* a strong sharpen value with a wide envelope makes the sum of the taps
+     * approach 0 before normalizing, the floating point path produces
+     * garbage then.  Fall back to the plain filter instead. */
+    if (gain > FIXED_MAX_GAIN)
+      vs_lanczos_calculate_taps (taps_d, bank->n_taps, start, xi, dx, x, fx,
+          ex, 0.0, src_size);
+
+    /* round and add the remaining error to the largest tap so that a flat
+     * input stays flat */
+    taps = bank->taps + j * bank->n_taps;
+    sum = 0;
+    max = 0;
+    for (l = 0; l < bank->n_taps; l++) {
+      taps[l] = floor (0.5 + taps_d[l] * (1 << FIXED_TAP_SHIFT));
+      sum += taps[l];
+      if (taps[l] > taps[max])
+        max = l;
     }
+    taps[max] += (1 << FIXED_TAP_SHIFT) - sum;
   }
+
+  g_free (taps_d);
 }
 
-void
-vs_image_scale_lanczos_AYUV_double (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen)
+static void
+vs_lanczos_bank_clear (VSLanczosBank * bank)
 {
-  Scale s = { 0 };
-  Scale *scale = &s;
-  int n_taps;
+  g_free (bank->offsets);
+  g_free (bank->taps);
+}
 
-  scale->dest = dest;
-  scale->src = src;
+/*
+ * Calculates the taps for scaling images of the given layout and sizes
+ * with vs_image_scale_lanczos_fixed().  The result is only read while
+ * scaling, so it can be shared by all bands of a destination.
+ */
+VSLanczos *
+vs_lanczos_new (VSLanczosLayout layout, int src_width, int src_height,
+    int dest_width, int dest_height, double sharpness, double sharpen,
+    double a)
+{
+  VSLanczos *lanczos;
+  int window;
+
+  lanczos = g_slice_new0 (VSLanczos);
+  lanczos->layout = layout;
+  lanczos->src_width = src_width;
+  lanczos->src_height = src_height;
+  lanczos->dest_width = dest_width;
+  lanczos->dest_height = dest_height;
+
+  vs_lanczos_bank_init (&lanczos->x_bank, src_width, dest_width, a,
+      sharpness, sharpen);
+  vs_lanczos_bank_init (&lanczos->y_bank, src_height, dest_height, a,
+      sharpness, sharpen);
+
+  switch (layout) {
+    case VS_LANCZOS_YUYV:
+    case VS_LANCZOS_UYVY:
+      vs_lanczos_bank_init (&lanczos->x_chroma_bank, (src_width + 1) / 2,
+          (dest_width + 1) / 2, a, sharpness, sharpen);
+      lanczos->n_comps = 2;
+      /* complete macropixels, the luma of odd widths is padded with 0 */
+      lanczos->line_size = ROUND_UP_2 (dest_width) * 2;
+      lanczos->dest_size = lanczos->line_size;
+      lanczos->src_size = ROUND_UP_2 (src_width) * 2;
+      window = MAX (2 * lanczos->x_bank.n_taps,
+          4 * lanczos->x_chroma_bank.n_taps);
+      break;
+    default:
+      lanczos->n_comps = layout + 1;
+      lanczos->line_size = dest_width * lanczos->n_comps;
+      lanczos->dest_size = lanczos->line_size;
+      lanczos->src_size = src_width * lanczos->n_comps;
+      window = lanczos->x_bank.n_taps * lanczos->n_comps;
+      break;
+  }
 
-  n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  scale1d_calculate_taps (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen);
+  if (lanczos->src_size < window)
+    lanczos->pad_size = window;
 
-  n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen);
+  return lanczos;
+}
 
-  scale->dither = dither;
+void
+vs_lanczos_free (VSLanczos * lanczos)
+{
+  vs_lanczos_bank_clear (&lanczos->x_bank);
+  if (lanczos->layout == VS_LANCZOS_YUYV || lanczos->layout == VS_LANCZOS_UYVY)
+    vs_lanczos_bank_clear (&lanczos->x_chroma_bank);
+  vs_lanczos_bank_clear (&lanczos->y_bank);
+  g_slice_free (VSLanczos, lanczos);
+}
 
-  scale->horiz_resample_func =
-      (HorizResampleFunc) resample_horiz_double_ayuv_generic;
+#define FIXED_HORIZ_STORE(dest, sum) \
+  (dest) = CLAMP (((sum) + (1 << (FIXED_HORIZ_SHIFT - 1))) >> \
+      FIXED_HORIZ_SHIFT, G_MININT16, G_MAXINT16)
 
-  scale->tmpdata =
-      g_malloc (sizeof (double) * scale->dest->width * scale->src->height * 4);
+/* the unused sums are optimized away for _n_comps < 4 */
+#define RESAMPLE_HORIZ_FIXED(function, _n_comps, _n_taps) \
+static void \
+function (gint16 *dest, const gint32 *offsets, \
+    const gint16 *taps, const guint8 *src, int n_taps, int n) \
+{ \
+  int i; \
+  int k; \
+  gint32 sum0, sum1, sum2, sum3; \
+  const guint8 *srcline; \
+  const gint16 *tapsline; \
+  for (i = 0; i < n; i++) { \
+    srcline = src + _n_comps * offsets[i]; \
+    tapsline = taps + i * _n_taps; \
+    sum0 = sum1 = sum2 = sum3 = 0; \
+    for (k = 0; k < _n_taps; k++) { \
+      sum0 += srcline[k * _n_comps + 0] * tapsline[k]; \
+      if (_n_comps > 1) \
+        sum1 += srcline[k * _n_comps + 1] * tapsline[k]; \
+      if (_n_comps > 2) \
+        sum2 += srcline[k * _n_comps + 2] * tapsline[k]; \
+      if (_n_comps > 3) \
+        sum3 += srcline[k * _n_comps + 3] * tapsline[k]; \
+    } \
+    FIXED_HORIZ_STORE (dest[i * _n_comps + 0], sum0); \
+    if (_n_comps > 1) \
+      FIXED_HORIZ_STORE (dest[i * _n_comps + 1], sum1); \
+    if (_n_comps > 2) \
+      FIXED_HORIZ_STORE (dest[i * _n_comps + 2], sum2); \
+    if (_n_comps > 3) \
+      FIXED_HORIZ_STORE (dest[i * _n_comps + 3], sum3); \
+  } \
+}
 
-  vs_scale_lanczos_AYUV_double (scale);
+/* *INDENT-OFF* */
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_1_taps4, 1, 4)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_1_taps8, 1, 8)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_1_taps12, 1, 12)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_1_taps16, 1, 16)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_1_generic, 1, n_taps)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_2_taps4, 2, 4)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_2_taps8, 2, 8)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_2_taps12, 2, 12)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_2_taps16, 2, 16)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_2_generic, 2, n_taps)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_3_taps4, 3, 4)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_3_taps8, 3, 8)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_3_taps12, 3, 12)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_3_taps16, 3, 16)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_3_generic, 3, n_taps)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_4_taps4, 4, 4)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_4_taps8, 4, 8)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_4_taps12, 4, 12)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_4_taps16, 4, 16)
+RESAMPLE_HORIZ_FIXED (resample_horiz_fixed_4_generic, 4, n_taps)
+/* *INDENT-ON* */
 
-  scale1d_cleanup (&scale->x_scale1d);
-  scale1d_cleanup (&scale->y_scale1d);
-  g_free (scale->tmpdata);
-}
+/* the common tap counts are unrolled by the compiler */
+static const FixedHorizFunc resample_horiz_fixed_funcs[4][5] = {
+  {resample_horiz_fixed_1_taps4, resample_horiz_fixed_1_taps8,
+      resample_horiz_fixed_1_taps12, resample_horiz_fixed_1_taps16,
+      resample_horiz_fixed_1_generic},
+  {resample_horiz_fixed_2_taps4, resample_horiz_fixed_2_taps8,
+      resample_horiz_fixed_2_taps12, resample_horiz_fixed_2_taps16,
+      resample_horiz_fixed_2_generic},
+  {resample_horiz_fixed_3_taps4, resample_horiz_fixed_3_taps8,
+      resample_horiz_fixed_3_taps12, resample_horiz_fixed_3_taps16,
+      resample_horiz_fixed_3_generic},
+  {resample_horiz_fixed_4_taps4, resample_horiz_fixed_4_taps8,
+      resample_horiz_fixed_4_taps12, resample_horiz_fixed_4_taps16,
+      resample_horiz_fixed_4_generic}
+};
 
+/* one component of packed 4:2:2, @src and @dest point to the first
+ * value of the component, @src_pstride and @dest_pstride are the
+ * distances between the values */
 static void
-vs_scale_lanczos_AYUV_float (Scale * scale)
+resample_horiz_fixed_strided (gint16 * dest, int dest_pstride,
+    const gint32 * offsets, const gint16 * taps, const guint8 * src,
+    int src_pstride, int n_taps, int n)
 {
-  int j;
-  int yi;
-  int tmp_yi;
-
-  tmp_yi = 0;
-
-  for (j = 0; j < scale->dest->height; j++) {
-    guint8 *destline;
-    float *taps;
+  int i;
+  int k;
+  gint32 sum;
+  const guint8 *srcline;
+  const gint16 *tapsline;
+
+  for (i = 0; i < n; i++) {
+    srcline = src + src_pstride * offsets[i];
+    tapsline = taps + i * n_taps;
+    sum = 0;
+    for (k = 0; k < n_taps; k++) {
+      sum += srcline[k * src_pstride] * tapsline[k];
+    }
+    sum = (sum + (1 << (FIXED_HORIZ_SHIFT - 1))) >> FIXED_HORIZ_SHIFT;
+    dest[i * dest_pstride] = CLAMP (sum, G_MININT16, G_MAXINT16);
+  }
+}
 
-    destline = scale->dest->pixels + scale->dest->stride * j;
+static void
+vs_lanczos_filter_line (const VSLanczos * lanczos, gint16 * dest,
+    const guint8 * src, guint8 * pad)
+{
+  const VSLanczosBank *x_bank = &lanczos->x_bank;
 
-    yi = scale->y_scale1d.offsets[j];
+  if (pad) {
+    memcpy (pad, src, lanczos->src_size);
+    src = pad;
+  }
 
-    while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_FLOAT_AYUV (tmp_yi),
-          scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, 0, scale->dest->width);
-      tmp_yi++;
+  switch (lanczos->layout) {
+    case VS_LANCZOS_YUYV:
+    case VS_LANCZOS_UYVY:
+    {
+      const VSLanczosBank *c_bank = &lanczos->x_chroma_bank;
+      int y_off, c_off;
+      int n_chroma = (lanczos->dest_width + 1) / 2;
+
+      y_off = (lanczos->layout == VS_LANCZOS_YUYV) ? 0 : 1;
+      c_off = 1 - y_off;
+
+      resample_horiz_fixed_strided (dest + y_off, 2, x_bank->offsets,
+          x_bank->taps, src + y_off, 2, x_bank->n_taps, lanczos->dest_width);
+      resample_horiz_fixed_strided (dest + c_off, 4, c_bank->offsets,
+          c_bank->taps, src + c_off, 4, c_bank->n_taps, n_chroma);
+      resample_horiz_fixed_strided (dest + c_off + 2, 4, c_bank->offsets,
+          c_bank->taps, src + c_off + 2, 4, c_bank->n_taps, n_chroma);
+      break;
     }
+    default:
+    {
+      FixedHorizFunc func;
 
-    taps = (float *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
-    if (scale->dither) {
-      resample_vert_dither_float_generic (destline,
-          taps, TMP_LINE_FLOAT_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (float) * 4 * scale->dest->width, scale->y_scale1d.n_taps, 0,
-          scale->dest->width * 4);
-    } else {
-      resample_vert_float_generic (destline,
-          taps, TMP_LINE_FLOAT_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (float) * 4 * scale->dest->width, scale->y_scale1d.n_taps, 0,
-          scale->dest->width * 4);
+      func = resample_horiz_fixed_funcs[lanczos->n_comps - 1]
+          [MIN (x_bank->n_taps / 4, 5) - 1];
+      func (dest, x_bank->offsets, x_bank->taps, src, x_bank->n_taps,
+          lanczos->dest_width);
+      break;
     }
   }
 }
 
-void
-vs_image_scale_lanczos_AYUV_float (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen)
+static void
+resample_vert_fixed (guint8 * dest, const gint16 ** lines,
+    const gint16 * taps, int n_taps, gint32 * acc1, gint32 * acc2, int n)
 {
-  Scale s = { 0 };
-  Scale *scale = &s;
-  int n_taps;
-
-  scale->dest = dest;
-  scale->src = src;
-
-  n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  scale1d_calculate_taps_float (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen);
-
-  n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps_float (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen);
-
-  scale->dither = dither;
-
-  scale->horiz_resample_func =
-      (HorizResampleFunc) resample_horiz_float_ayuv_generic;
+  gint32 *tmp;
+  int l;
 
-  scale->tmpdata =
-      g_malloc (sizeof (float) * scale->dest->width * scale->src->height * 4);
-
-  vs_scale_lanczos_AYUV_float (scale);
+  if (n_taps == 4) {
+    video_scale_orc_resample_vert_4tap_u8 (dest, lines[0], lines[1],
+        lines[2], lines[3], taps[0], taps[1], taps[2], taps[3], n);
+    return;
+  }
 
-  scale1d_cleanup (&scale->x_scale1d);
-  scale1d_cleanup (&scale->y_scale1d);
-  g_free (scale->tmpdata);
+  video_scale_orc_resample_vert_4tap_s32 (acc1, lines[0], lines[1],
+      lines[2], lines[3], taps[0], taps[1], taps[2], taps[3], n);
+  for (l = 4; l < n_taps - 4; l += 4) {
+    video_scale_orc_resample_vert_acc_4tap_s32 (acc2, acc1, lines[l],
+        lines[l + 1], lines[l + 2], lines[l + 3], taps[l], taps[l + 1],
+        taps[l + 2], taps[l + 3], n);
+    tmp = acc1;
+    acc1 = acc2;
+    acc2 = tmp;
+  }
+  video_scale_orc_resample_vert_acc_4tap_u8 (dest, acc1, lines[l],
+      lines[l + 1], lines[l + 2], lines[l + 3], taps[l], taps[l + 1],
+      taps[l + 2], taps[l + 3], n);
 }
 
+/* the error is propagated separately for each of the @period interleaved
+ * components */
 static void
-vs_scale_lanczos_AYUV64_double (Scale * scale)
+resample_vert_dither_fixed (guint8 * dest, const gint16 ** lines,
+    const gint16 * taps, int n_taps, int period, int n)
 {
-  int j;
-  int yi;
-  int tmp_yi;
-
-  tmp_yi = 0;
-
-  for (j = 0; j < scale->dest->height; j++) {
-    guint16 *destline;
-    double *taps;
-
-    destline = (guint16 *) (scale->dest->pixels + scale->dest->stride * j);
+  int i;
+  int l;
+  gint32 sum;
+  gint32 err[4] = { 0, 0, 0, 0 };
+  gint32 mask = (1 << FIXED_VERT_SHIFT) - 1;
 
-    yi = scale->y_scale1d.offsets[j];
+  for (i = 0; i < n; i++) {
+    gint32 *e = &err[i % period];
 
-    while (tmp_yi < yi + scale->y_scale1d.n_taps) {
-      scale->horiz_resample_func (TMP_LINE_DOUBLE_AYUV (tmp_yi),
-          scale->x_scale1d.offsets, scale->x_scale1d.taps, SRC_LINE (tmp_yi),
-          scale->x_scale1d.n_taps, 0, scale->dest->width);
-      tmp_yi++;
-    }
-
-    taps = (double *) scale->y_scale1d.taps + j * scale->y_scale1d.n_taps;
-    if (scale->dither) {
-      resample_vert_dither_double_generic_u16 (destline,
-          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (double) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
-    } else {
-      resample_vert_double_generic_u16 (destline,
-          taps, TMP_LINE_DOUBLE_AYUV (scale->y_scale1d.offsets[j]),
-          sizeof (double) * 4 * scale->dest->width,
-          scale->y_scale1d.n_taps, 0, scale->dest->width * 4);
+    sum = 0;
+    for (l = 0; l < n_taps; l++) {
+      sum += lines[l][i] * taps[l];
     }
+    *e += sum;
+    dest[i] = CLAMP (*e >> FIXED_VERT_SHIFT, 0, 255);
+    *e &= mask;
   }
 }
 
+/*
+ * Scales the lines between y_start and y_end of dest.  Only the source
+ * lines that contribute to them are filtered horizontally.
+ */
 void
-vs_image_scale_lanczos_AYUV64_double (const VSImage * dest, const VSImage * src,
-    uint8_t * tmpbuf, double sharpness, gboolean dither, double a,
-    double sharpen)
+vs_image_scale_lanczos_fixed (const VSImage * dest, const VSImage * src,
+    const VSLanczos * lanczos, gboolean dither)
 {
-  Scale s = { 0 };
-  Scale *scale = &s;
+  const VSLanczosBank *y_bank = &lanczos->y_bank;
+  const gint16 **lines;
+  gint16 *ring;
+  gint32 *acc;
+  guint8 *pad;
   int n_taps;
+  int next;
+  int period;
+  int j;
+  int l;
+
+  if (dest->y_start >= dest->y_end)
+    return;
+
+  g_return_if_fail (lanczos->src_width == src->width &&
+      lanczos->src_height == src->height &&
+      lanczos->dest_width == dest->width &&
+      lanczos->dest_height == dest->height);
+
+  n_taps = y_bank->n_taps;
+  lines = g_malloc (sizeof (gint16 *) * n_taps);
+  ring = g_malloc0 (sizeof (gint16) * lanczos->line_size * n_taps);
+  acc = g_malloc (sizeof (gint32) * lanczos->dest_size * 2);
+  pad = lanczos->pad_size ? g_malloc0 (lanczos->pad_size) : NULL;
+
+  if (lanczos->layout == VS_LANCZOS_YUYV || lanczos->layout == VS_LANCZOS_UYVY)
+    period = 4;
+  else
+    period = lanczos->n_comps;
+
+#define RING_LINE(i) (ring + ((i) % n_taps) * lanczos->line_size)
+
+  /* the offsets only increase, so the ring buffer always contains the
+   * filtered lines from next - n_taps up to next */
+  next = y_bank->offsets[dest->y_start];
+  for (j = dest->y_start; j < dest->y_end; j++) {
+    int yi = y_bank->offsets[j];
+    int last = MIN (yi + n_taps, src->height);
+
+    next = MAX (next, yi);
+    for (; next < last; next++) {
+      vs_lanczos_filter_line (lanczos, RING_LINE (next),
+          src->pixels + next * src->stride, pad);
+    }
 
-  scale->dest = dest;
-  scale->src = src;
-
-  n_taps = scale1d_get_n_taps (src->width, dest->width, a, sharpness);
-  scale1d_calculate_taps (&scale->x_scale1d,
-      src->width, dest->width, n_taps, a, sharpness, sharpen);
-
-  n_taps = scale1d_get_n_taps (src->height, dest->height, a, sharpness);
-  scale1d_calculate_taps (&scale->y_scale1d,
-      src->height, dest->height, n_taps, a, sharpness, sharpen);
-
-  scale->dither = dither;
-
-  scale->horiz_resample_func =
-      (HorizResampleFunc) resample_horiz_double_ayuv_generic_s16;
+    /* when the source is smaller than the window, the taps of the lines
+     * past the end are 0 */
+    for (l = 0; l < n_taps; l++)
+      lines[l] = RING_LINE (MIN (yi + l, src->height - 1));
 
-  scale->tmpdata =
-      g_malloc (sizeof (double) * scale->dest->width * scale->src->height * 4);
+    if (dither) {
+      resample_vert_dither_fixed (dest->pixels + j * dest->stride, lines,
+          y_bank->taps + j * n_taps, n_taps, period, lanczos->dest_size);
+    } else {
+      resample_vert_fixed (dest->pixels + j * dest->stride, lines,
+          y_bank->taps + j * n_taps, n_taps, acc, acc + lanczos->dest_size,
+          lanczos->dest_size);
+    }
+  }
 
-  vs_scale_lanczos_AYUV64_double (scale);
+#undef RING_LINE
 
-  scale1d_cleanup (&scale->x_scale1d);
-  scale1d_cleanup (&scale->y_scale1d);
-  g_free (scale->tmpdata);
+  g_free (pad);
+  g_free (acc);
+  g_free (ring);
+  g_free (lines);
 }
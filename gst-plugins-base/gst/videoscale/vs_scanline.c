@@ -841,7 +841,7 @@ vs_scanline_resample_linear_AYUV64 (uint8_t * dest8, uint8_t * src8,
 
     if (j + 1 < src_width) {
       dest[i * 4 + 0] =
-          (src[j * 3 + 0] * (32768 - x) + src[j * 4 + 4] * x) >> 15;
+          (src[j * 4 + 0] * (32768 - x) + src[j * 4 + 4] * x) >> 15;
       dest[i * 4 + 1] =
           (src[j * 4 + 1] * (32768 - x) + src[j * 4 + 5] * x) >> 15;
       dest[i * 4 + 2] =
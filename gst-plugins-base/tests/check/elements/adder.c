@@ -29,9 +29,11 @@
 #endif
 
 #include <unistd.h>
+#include <string.h>
 
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstconsistencychecker.h>
+#include <gst/check/gsttestclock.h>
 #include <gst/base/gstbasesrc.h>
 
 static GMainLoop *main_loop;
@@ -1247,6 +1249,410 @@ GST_START_TEST (test_flush_start_flush_stop)
 
 GST_END_TEST;
 
+static GMutex live_lock;
+static GCond live_cond;
+static gint live_buffers;
+static GstClockTime live_next_ts;
+static gboolean live_contiguous;
+
+static void
+live_handoff_cb (GstElement * fakesink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  g_mutex_lock (&live_lock);
+  if (live_buffers > 0 && GST_BUFFER_TIMESTAMP (buffer) != live_next_ts)
+    live_contiguous = FALSE;
+  live_next_ts = GST_BUFFER_TIMESTAMP (buffer) + GST_BUFFER_DURATION (buffer);
+  live_buffers++;
+  g_cond_signal (&live_cond);
+  g_mutex_unlock (&live_lock);
+}
+
+/* check that in live mode a sinkpad that never gets data does not block the
+ * output and that the output is contiguous */
+GST_START_TEST (test_live_stalled_input)
+{
+  GstElement *pipeline, *src, *adder, *sink;
+  GstStateChangeReturn state_res;
+  GstPad *stalled;
+  GstQuery *query;
+  gboolean live;
+  GstClockTime min;
+
+  pipeline = gst_pipeline_new ("pipeline");
+  src = gst_element_factory_make ("audiotestsrc", "src");
+  g_object_set (src, "wave", 4, "is-live", TRUE, NULL);
+  adder = gst_element_factory_make ("adder", "adder");
+  g_object_set (adder, "live", TRUE, "latency", 20 * GST_MSECOND,
+      "output-buffer-duration", 10 * GST_MSECOND, NULL);
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) live_handoff_cb, NULL);
+  gst_bin_add_many (GST_BIN (pipeline), src, adder, sink, NULL);
+  fail_unless (gst_element_link_many (src, adder, sink, NULL));
+
+  /* a second input that never produces anything */
+  stalled = gst_element_get_request_pad (adder, "sink_%u");
+  fail_if (stalled == NULL);
+
+  live_buffers = 0;
+  live_contiguous = TRUE;
+
+  state_res = gst_element_set_state (pipeline, GST_STATE_PLAYING);
+  ck_assert_int_ne (state_res, GST_STATE_CHANGE_FAILURE);
+
+  g_mutex_lock (&live_lock);
+  while (live_buffers < 10)
+    g_cond_wait (&live_cond, &live_lock);
+  fail_unless (live_contiguous);
+  g_mutex_unlock (&live_lock);
+
+  /* the latency includes our own latency and the buffer duration */
+  query = gst_query_new_latency ();
+  fail_unless (gst_element_query (adder, query));
+  gst_query_parse_latency (query, &live, &min, NULL);
+  fail_unless (live);
+  fail_unless (min >= 30 * GST_MSECOND);
+  gst_query_unref (query);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_element_release_request_pad (adder, stalled);
+  gst_object_unref (stalled);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+/* live mixing of up to three inputs on a test clock, 10 samples per output
+ * buffer */
+#define LIVE_RATE 1000
+#define LIVE_MAX_INPUTS 3
+
+static GstStaticPadTemplate live_srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS ("audio/x-raw"));
+static GstStaticPadTemplate live_sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS ("audio/x-raw"));
+
+static GstElement *live_adder;
+static GstClock *live_clock;
+static GstPad *live_srcpads[LIVE_MAX_INPUTS], *live_sinkpads[LIVE_MAX_INPUTS];
+static GstPad *live_outpad;
+static gint live_n_inputs;
+
+static void
+setup_live_adder (gint n_inputs)
+{
+  GstSegment segment;
+  GstCaps *caps;
+  gint i;
+
+  fail_unless (n_inputs <= LIVE_MAX_INPUTS);
+  live_n_inputs = n_inputs;
+
+  live_adder = gst_check_setup_element ("adder");
+  g_object_set (live_adder, "live", TRUE, "latency", 20 * GST_MSECOND,
+      "output-buffer-duration", 10 * GST_MSECOND, NULL);
+  live_clock = gst_test_clock_new ();
+  gst_element_set_clock (live_adder, live_clock);
+  gst_element_set_base_time (live_adder, 0);
+
+  live_outpad = gst_check_setup_sink_pad (live_adder, &live_sinktemplate);
+  gst_pad_set_active (live_outpad, TRUE);
+
+  /* a live mixer does not preroll */
+  fail_unless_equals_int (gst_element_set_state (live_adder,
+          GST_STATE_PAUSED), GST_STATE_CHANGE_NO_PREROLL);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+#if G_BYTE_ORDER == G_BIG_ENDIAN
+      "format", G_TYPE_STRING, "S16BE",
+#else
+      "format", G_TYPE_STRING, "S16LE",
+#endif
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, LIVE_RATE, "channels", G_TYPE_INT, 1, NULL);
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+
+  for (i = 0; i < live_n_inputs; i++) {
+    gchar *stream_id = g_strdup_printf ("live-%d", i);
+
+    live_srcpads[i] = gst_pad_new_from_static_template (&live_srctemplate,
+        "src");
+    live_sinkpads[i] = gst_element_get_request_pad (live_adder, "sink_%u");
+    fail_unless (live_sinkpads[i] != NULL);
+    fail_unless (gst_pad_link (live_srcpads[i],
+            live_sinkpads[i]) == GST_PAD_LINK_OK);
+    gst_pad_set_active (live_srcpads[i], TRUE);
+
+    fail_unless (gst_pad_push_event (live_srcpads[i],
+            gst_event_new_stream_start (stream_id)));
+    fail_unless (gst_pad_push_event (live_srcpads[i],
+            gst_event_new_caps (caps)));
+    fail_unless (gst_pad_push_event (live_srcpads[i],
+            gst_event_new_segment (&segment)));
+    g_free (stream_id);
+  }
+  gst_caps_unref (caps);
+}
+
+static void
+cleanup_live_adder (void)
+{
+  gint i;
+
+  /* going back to PAUSED does not preroll either */
+  fail_unless_equals_int (gst_element_set_state (live_adder,
+          GST_STATE_PAUSED), GST_STATE_CHANGE_NO_PREROLL);
+  fail_unless_equals_int (gst_element_set_state (live_adder,
+          GST_STATE_NULL), GST_STATE_CHANGE_SUCCESS);
+
+  for (i = 0; i < live_n_inputs; i++) {
+    gst_pad_set_active (live_srcpads[i], FALSE);
+    gst_pad_unlink (live_srcpads[i], live_sinkpads[i]);
+    gst_element_release_request_pad (live_adder, live_sinkpads[i]);
+    gst_object_unref (live_sinkpads[i]);
+    gst_object_unref (live_srcpads[i]);
+  }
+  gst_check_drop_buffers ();
+
+  gst_pad_set_active (live_outpad, FALSE);
+  gst_check_teardown_sink_pad (live_adder);
+  gst_check_teardown_element (live_adder);
+  gst_object_unref (live_clock);
+}
+
+/* pushes @n samples of @value starting at sample @offset on input @i */
+static void
+live_push (gint i, guint64 offset, guint n, gint16 value)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint k;
+
+  buf = gst_buffer_new_allocate (NULL, n * sizeof (gint16), NULL);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (k = 0; k < n; k++)
+    ((gint16 *) map.data)[k] = value;
+  gst_buffer_unmap (buf, &map);
+
+  GST_BUFFER_TIMESTAMP (buf) =
+      gst_util_uint64_scale (offset, GST_SECOND, LIVE_RATE);
+  GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (n, GST_SECOND, LIVE_RATE);
+
+  fail_unless_equals_int (gst_pad_push (live_srcpads[i], buf), GST_FLOW_OK);
+}
+
+/* releases the clock wait of the mixing task @n times, then waits until the
+ * task waits again so that all output was pushed */
+static void
+live_crank (guint n)
+{
+  GstTestClock *test_clock = GST_TEST_CLOCK (live_clock);
+  GstClockID id, processed;
+
+  while (n--) {
+    gst_test_clock_wait_for_next_pending_id (test_clock, &id);
+    gst_test_clock_set_time (test_clock, gst_clock_id_get_time (id));
+    processed = gst_test_clock_process_next_clock_id (test_clock);
+    fail_unless (processed == id);
+    gst_clock_id_unref (processed);
+    gst_clock_id_unref (id);
+  }
+  gst_test_clock_wait_for_next_pending_id (test_clock, NULL);
+}
+
+/* copies the samples of all output buffers to @samples, checking that the
+ * buffers are contiguous from sample 0 on, and returns their number */
+static guint
+live_get_output (gint16 * samples, guint max)
+{
+  GList *l;
+  guint n = 0;
+
+  for (l = buffers; l; l = l->next) {
+    GstBuffer *buf = l->data;
+    GstMapInfo map;
+
+    fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buf), n);
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    fail_unless (n + map.size / sizeof (gint16) <= max);
+    memcpy (samples + n, map.data, map.size);
+    n += map.size / sizeof (gint16);
+    gst_buffer_unmap (buf, &map);
+  }
+
+  return n;
+}
+
+static void
+live_check_samples (const gint16 * samples, guint start, guint end,
+    gint16 value)
+{
+  guint i;
+
+  for (i = start; i < end; i++)
+    fail_unless (samples[i] == value, "sample %u is %d instead of %d", i,
+        samples[i], value);
+}
+
+/* the samples of both inputs are added and clamped */
+GST_START_TEST (test_live_mix)
+{
+  gint16 samples[64];
+
+  setup_live_adder (2);
+
+  live_push (0, 0, 30, 1000);
+  live_push (1, 0, 30, 234);
+  live_push (0, 30, 10, 30000);
+  live_push (1, 30, 10, 10000);
+  live_push (0, 40, 10, -30000);
+  live_push (1, 40, 10, -10000);
+
+  fail_if (gst_element_set_state (live_adder,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  live_crank (5);
+
+  fail_unless_equals_int (live_get_output (samples, G_N_ELEMENTS (samples)),
+      50);
+  live_check_samples (samples, 0, 30, 1234);
+  live_check_samples (samples, 30, 40, G_MAXINT16);
+  live_check_samples (samples, 40, 50, G_MININT16);
+
+  cleanup_live_adder ();
+}
+
+GST_END_TEST;
+
+/* inputs are added in pad order and clamped after each of them, also when
+ * two of them are added in one pass */
+GST_START_TEST (test_live_mix_clamp_order)
+{
+  gint16 samples[64];
+
+  setup_live_adder (3);
+
+  live_push (0, 0, 10, 30000);
+  live_push (1, 0, 10, 30000);
+  live_push (2, 0, 10, -30000);
+  live_push (0, 10, 10, -30000);
+  live_push (1, 10, 10, -10000);
+  live_push (2, 10, 10, 20000);
+  live_push (0, 20, 10, 100);
+  live_push (1, 20, 10, 20);
+  live_push (2, 20, 10, 3);
+
+  fail_if (gst_element_set_state (live_adder,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  live_crank (3);
+
+  fail_unless_equals_int (live_get_output (samples, G_N_ELEMENTS (samples)),
+      30);
+  live_check_samples (samples, 0, 10, G_MAXINT16 - 30000);
+  live_check_samples (samples, 10, 20, G_MININT16 + 20000);
+  live_check_samples (samples, 20, 30, 123);
+
+  cleanup_live_adder ();
+}
+
+GST_END_TEST;
+
+/* a gap in an input is filled with silence while the other keeps playing */
+GST_START_TEST (test_live_gap)
+{
+  gint16 samples[96];
+
+  setup_live_adder (2);
+
+  live_push (0, 0, 10, 100);
+  live_push (0, 55, 10, 100);
+  live_push (1, 0, 70, 10);
+
+  fail_if (gst_element_set_state (live_adder,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  live_crank (7);
+
+  fail_unless_equals_int (live_get_output (samples, G_N_ELEMENTS (samples)),
+      70);
+  live_check_samples (samples, 0, 10, 110);
+  live_check_samples (samples, 10, 55, 10);
+  live_check_samples (samples, 55, 65, 110);
+  live_check_samples (samples, 65, 70, 10);
+
+  cleanup_live_adder ();
+}
+
+GST_END_TEST;
+
+/* overlapping data is trimmed, data that arrives after its output was mixed
+ * is dropped or clipped to what is still to be mixed */
+GST_START_TEST (test_live_clip)
+{
+  gint16 samples[96];
+
+  setup_live_adder (2);
+
+  live_push (0, 0, 60, 1);
+  live_push (0, 10, 60, 2);
+
+  fail_if (gst_element_set_state (live_adder,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  live_crank (3);
+
+  /* samples up to 30 are mixed, the first buffer is completely late */
+  live_push (1, 0, 10, 7);
+  live_push (1, 20, 20, 5);
+  live_crank (4);
+
+  fail_unless_equals_int (live_get_output (samples, G_N_ELEMENTS (samples)),
+      70);
+  live_check_samples (samples, 0, 30, 1);
+  live_check_samples (samples, 30, 40, 6);
+  live_check_samples (samples, 40, 60, 1);
+  live_check_samples (samples, 60, 70, 2);
+
+  cleanup_live_adder ();
+}
+
+GST_END_TEST;
+
+/* after EOS on all inputs the queued data is mixed before EOS is pushed */
+GST_START_TEST (test_live_eos_drain)
+{
+  GstTestClock *test_clock;
+  GstClockID id;
+  gint16 samples[64];
+
+  setup_live_adder (2);
+  test_clock = GST_TEST_CLOCK (live_clock);
+
+  live_push (0, 0, 25, 3);
+  fail_unless (gst_pad_push_event (live_srcpads[0], gst_event_new_eos ()));
+  fail_unless (gst_pad_push_event (live_srcpads[1], gst_event_new_eos ()));
+
+  fail_if (gst_element_set_state (live_adder,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+  live_crank (3);
+  fail_if (GST_PAD_IS_EOS (live_outpad));
+
+  /* the next block has no data left and ends the stream */
+  gst_test_clock_wait_for_next_pending_id (test_clock, &id);
+  gst_test_clock_set_time (test_clock, gst_clock_id_get_time (id));
+  gst_clock_id_unref (gst_test_clock_process_next_clock_id (test_clock));
+  gst_clock_id_unref (id);
+  while (!GST_PAD_IS_EOS (live_outpad))
+    g_usleep (1000);
+
+  fail_unless_equals_int (live_get_output (samples, G_N_ELEMENTS (samples)),
+      30);
+  live_check_samples (samples, 0, 25, 3);
+  live_check_samples (samples, 25, 30, 0);
+
+  cleanup_live_adder ();
+}
+
+GST_END_TEST;
+
 
 static Suite *
 adder_suite (void)
@@ -1268,6 +1674,12 @@ adder_suite (void)
   tcase_add_test (tc_chain, test_duration_unknown_overrides);
   tcase_add_test (tc_chain, test_loop);
   tcase_add_test (tc_chain, test_flush_start_flush_stop);
+  tcase_add_test (tc_chain, test_live_stalled_input);
+  tcase_add_test (tc_chain, test_live_mix);
+  tcase_add_test (tc_chain, test_live_mix_clamp_order);
+  tcase_add_test (tc_chain, test_live_gap);
+  tcase_add_test (tc_chain, test_live_clip);
+  tcase_add_test (tc_chain, test_live_eos_drain);
 
   /* Use a longer timeout */
 #ifdef HAVE_VALGRIND
@@ -26,6 +26,11 @@
 #include <gst/check/gstcheck.h>
 #include <gst/audio/audio.h>
 
+/* for testing the channel mixing kernels directly */
+#include "../../gst/audioconvert/gstchannelmix.c"
+
+GST_DEBUG_CATEGORY (audio_convert_debug);
+
 /* For ease of programming we use globals to keep refs for our floating
  * src and sink pads we create; otherwise we always have to do get_pad,
  * get_peer, and then remove references in every test function */
@@ -1025,6 +1030,258 @@ GST_START_TEST (test_multichannel_conversion)
 
 GST_END_TEST;
 
+GST_START_TEST (test_multichannel_blocks)
+{
+  /* more frames than the channel mixer converts at once when mixing in
+   * place, and with more output than input channels the other way round */
+  {
+    gint16 mono[200], stereo[400];
+    gint i;
+
+    for (i = 0; i < 200; i++) {
+      mono[i] = i * 300 - 30000;
+      stereo[2 * i] = stereo[2 * i + 1] = mono[i];
+    }
+
+    RUN_CONVERSION ("1 channel to 2 in blocks", mono,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE), stereo,
+        get_int_caps (2, G_BYTE_ORDER, 16, 16, TRUE));
+    RUN_CONVERSION ("2 channels to 1 in blocks", stereo,
+        get_int_caps (2, G_BYTE_ORDER, 16, 16, TRUE), mono,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE));
+  }
+
+  {
+    gfloat mono[200], stereo[400];
+    gint i;
+
+    for (i = 0; i < 200; i++) {
+      mono[i] = (i - 100) / 128.0;
+      stereo[2 * i] = stereo[2 * i + 1] = mono[i];
+    }
+
+    RUN_CONVERSION ("float 1 channel to 2 in blocks", mono,
+        get_float_caps (1, G_BYTE_ORDER, 32), stereo,
+        get_float_caps (2, G_BYTE_ORDER, 32));
+    RUN_CONVERSION ("float 2 channels to 1 in blocks", stereo,
+        get_float_caps (2, G_BYTE_ORDER, 32), mono,
+        get_float_caps (1, G_BYTE_ORDER, 32));
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_convert_blocks)
+{
+  /* more samples than fit into the intermediate buffer at once, going
+   * through all stages */
+  {
+    static gint16 mono[10000], stereo[20000];
+    gint i;
+
+    for (i = 0; i < 10000; i++) {
+      mono[i] = (i % 600) * 100 - 30000;
+      stereo[2 * i] = stereo[2 * i + 1] = mono[i];
+    }
+
+    RUN_CONVERSION ("int16 1 channel to 2 in blocks", mono,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE), stereo,
+        get_int_caps (2, G_BYTE_ORDER, 16, 16, TRUE));
+    RUN_CONVERSION ("int16 2 channels to 1 in blocks", stereo,
+        get_int_caps (2, G_BYTE_ORDER, 16, 16, TRUE), mono,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE));
+  }
+
+  /* and the direct conversions */
+  {
+    static gint16 in[10000];
+    static gfloat out[10000];
+    gint i;
+
+    for (i = 0; i < 10000; i++) {
+      in[i] = (i % 600) * 100 - 30000;
+      out[i] = in[i] / 32768.0;
+    }
+
+    RUN_CONVERSION ("int16 to float32 in blocks", in,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE), out,
+        get_float_caps (1, G_BYTE_ORDER, 32));
+    RUN_CONVERSION ("float32 to int16 in blocks", out,
+        get_float_caps (1, G_BYTE_ORDER, 32), in,
+        get_int_caps (1, G_BYTE_ORDER, 16, 16, TRUE));
+  }
+}
+
+GST_END_TEST;
+
+#define MIX_TEST_FRAMES 150
+
+/* sets up the channel mixer of @ctx for the @ic x @oc matrix @coeffs,
+ * bypassing the automatic matrix, and checks that @kernel is used for it */
+static void
+setup_channel_mix (AudioConvertCtx * ctx, gint ic, gint oc,
+    const gfloat * coeffs, gint kernel)
+{
+  gint i, o;
+
+  memset (ctx, 0, sizeof (AudioConvertCtx));
+  ctx->in.channels = ic;
+  ctx->out.channels = oc;
+
+  ctx->tmp = (gpointer) g_new (gdouble, MIX_BLOCK_FRAMES * oc);
+  ctx->matrix = g_new0 (gfloat *, ic);
+  for (i = 0; i < ic; i++) {
+    ctx->matrix[i] = g_new (gfloat, oc);
+    for (o = 0; o < oc; o++)
+      ctx->matrix[i][o] = coeffs[i * oc + o];
+  }
+
+  gst_channel_mix_setup_kernel (ctx);
+  fail_unless_equals_int (ctx->mix_kernel, kernel);
+}
+
+/* mixes with the plain matrix multiplication */
+static void
+mix_reference (AudioConvertCtx * ctx, const gdouble * in, gdouble * out,
+    gint frames, gboolean is_int)
+{
+  gint n, i, o;
+
+  for (n = 0; n < frames; n++) {
+    for (o = 0; o < ctx->out.channels; o++) {
+      gdouble res = 0.0;
+
+      for (i = 0; i < ctx->in.channels; i++)
+        res += in[n * ctx->in.channels + i] * ctx->matrix[i][o];
+
+      if (is_int)
+        out[n * ctx->out.channels + o] =
+            (gint32) CLAMP (res, G_MININT32, G_MAXINT32);
+      else
+        out[n * ctx->out.channels + o] = CLAMP (res, -1.0, 1.0);
+    }
+  }
+}
+
+/* compares the int and float output of the selected kernel with the
+ * reference, mixing into a separate buffer and in place. All coefficients
+ * and samples are binary fractions so that every sum is exact. */
+static void
+check_channel_mix (AudioConvertCtx * ctx)
+{
+  gint ic = ctx->in.channels, oc = ctx->out.channels;
+  gint size = MIX_TEST_FRAMES * MAX (ic, oc);
+  gdouble *in, *ref, *fout;
+  gint32 *iin, *iout;
+  gint n, i;
+
+  in = g_new (gdouble, size);
+  ref = g_new (gdouble, size);
+  fout = g_new (gdouble, size);
+  iin = g_new (gint32, size);
+  iout = g_new (gint32, size);
+
+  /* int, the first frame clips */
+  for (n = 0; n < MIX_TEST_FRAMES * ic; n++)
+    in[n] = n < ic ? G_MAXINT32 : ((n * 7919) % 65536 - 32768) * 256;
+  for (n = 0; n < MIX_TEST_FRAMES * ic; n++)
+    iin[n] = in[n];
+  mix_reference (ctx, in, ref, MIX_TEST_FRAMES, TRUE);
+
+  gst_channel_mix_mix_int (ctx, iin, iout, MIX_TEST_FRAMES);
+  for (i = 0; i < MIX_TEST_FRAMES * oc; i++)
+    fail_unless_equals_int (iout[i], (gint32) ref[i]);
+
+  gst_channel_mix_mix_int (ctx, iin, iin, MIX_TEST_FRAMES);
+  for (i = 0; i < MIX_TEST_FRAMES * oc; i++)
+    fail_unless_equals_int (iin[i], (gint32) ref[i]);
+
+  /* float, the first frame clips */
+  for (n = 0; n < MIX_TEST_FRAMES * ic; n++)
+    in[n] = n < ic ? 1.0 : ((n * 7919) % 512 - 256) / 256.0;
+  mix_reference (ctx, in, ref, MIX_TEST_FRAMES, FALSE);
+
+  gst_channel_mix_mix_float (ctx, in, fout, MIX_TEST_FRAMES);
+  for (i = 0; i < MIX_TEST_FRAMES * oc; i++)
+    fail_unless (fout[i] == ref[i], "sample %d is %f instead of %f", i,
+        fout[i], ref[i]);
+
+  gst_channel_mix_mix_float (ctx, in, in, MIX_TEST_FRAMES);
+  for (i = 0; i < MIX_TEST_FRAMES * oc; i++)
+    fail_unless (in[i] == ref[i], "sample %d is %f instead of %f", i,
+        in[i], ref[i]);
+
+  g_free (in);
+  g_free (ref);
+  g_free (fout);
+  g_free (iin);
+  g_free (iout);
+
+  gst_channel_mix_unset_matrix (ctx);
+}
+
+GST_START_TEST (test_channel_mix_kernels)
+{
+  AudioConvertCtx ctx;
+  gfloat coeffs[64];
+  gint i, o;
+
+  /* dense, with more output channels than fit in one SSE2 register pair
+   * and a remainder */
+  for (i = 0; i < 3; i++)
+    for (o = 0; o < 5; o++)
+      coeffs[i * 5 + o] = ((i * 5 + o) % 7 + 1) / 8.0;
+  setup_channel_mix (&ctx, 3, 5, coeffs, MIX_KERNEL_DENSE);
+  check_channel_mix (&ctx);
+
+  for (i = 0; i < 4; i++)
+    for (o = 0; o < 9; o++)
+      coeffs[i * 9 + o] = ((i * 9 + o) % 11 - 5) / 16.0;
+  setup_channel_mix (&ctx, 4, 9, coeffs, MIX_KERNEL_DENSE);
+  check_channel_mix (&ctx);
+
+  /* sparse: two terms, all inputs with the same weight and one term */
+  memset (coeffs, 0, sizeof (coeffs));
+  for (i = 0; i < 8; i++)
+    coeffs[i * 3 + 1] = 0.125;
+  coeffs[0 * 3 + 0] = 0.5;
+  coeffs[3 * 3 + 0] = 0.25;
+  coeffs[7 * 3 + 2] = -0.75;
+  setup_channel_mix (&ctx, 8, 3, coeffs, MIX_KERNEL_SPARSE);
+  check_channel_mix (&ctx);
+
+  /* 5.1 to stereo */
+  for (i = 0; i < 6; i++)
+    for (o = 0; o < 2; o++)
+      coeffs[i * 2 + o] = ((i + 2 * o) % 5 + 1) / 8.0;
+  setup_channel_mix (&ctx, 6, 2, coeffs, MIX_KERNEL_6_2);
+  check_channel_mix (&ctx);
+}
+
+GST_END_TEST;
+
+/* the int path accumulates in double precision and truncates the sum
+ * towards zero, instead of truncating after every term */
+GST_START_TEST (test_channel_mix_int_rounding)
+{
+  static const gfloat coeffs[] = { 0.5, 0.5 };
+  static const gint32 in[] = { 3, 3, 1, 2, -1, -2, -3, -3,
+    G_MAXINT32, G_MAXINT32, G_MININT32, G_MININT32
+  };
+  static const gint32 expected[] = { 3, 1, -1, -3, G_MAXINT32, G_MININT32 };
+  AudioConvertCtx ctx;
+  gint32 out[G_N_ELEMENTS (expected)];
+  gint i;
+
+  setup_channel_mix (&ctx, 2, 1, coeffs, MIX_KERNEL_2_1);
+  gst_channel_mix_mix_int (&ctx, (gint32 *) in, out, G_N_ELEMENTS (out));
+  for (i = 0; i < G_N_ELEMENTS (out); i++)
+    fail_unless_equals_int (out[i], expected[i]);
+  gst_channel_mix_unset_matrix (&ctx);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_caps_negotiation)
 {
   GstElement *src, *ac1, *ac2, *ac3, *sink;
@@ -1510,12 +1767,19 @@ audioconvert_suite (void)
   Suite *s = suite_create ("audioconvert");
   TCase *tc_chain = tcase_create ("general");
 
+  GST_DEBUG_CATEGORY_INIT (audio_convert_debug, "audioconvert", 0,
+      "audio conversion element");
+
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_int16);
   tcase_add_test (tc_chain, test_float32);
   tcase_add_test (tc_chain, test_int_conversion);
   tcase_add_test (tc_chain, test_float_conversion);
   tcase_add_test (tc_chain, test_multichannel_conversion);
+  tcase_add_test (tc_chain, test_multichannel_blocks);
+  tcase_add_test (tc_chain, test_channel_mix_kernels);
+  tcase_add_test (tc_chain, test_channel_mix_int_rounding);
+  tcase_add_test (tc_chain, test_convert_blocks);
   tcase_add_test (tc_chain, test_caps_negotiation);
   tcase_add_test (tc_chain, test_convert_undefined_multichannel);
   tcase_add_test (tc_chain, test_preserve_width);
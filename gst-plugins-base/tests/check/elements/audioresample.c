@@ -22,6 +22,8 @@
  */
 
 #include <unistd.h>
+#include <math.h>
+#include <float.h>
 
 #include <gst/check/gstcheck.h>
 
@@ -33,6 +35,33 @@
 #include <gst/fft/gstfftf32.h>
 #include <gst/fft/gstfftf64.h>
 
+/* The AVX kernels of the three resamplers, renamed so that they can be
+ * included next to each other and compared with the C code. Like in
+ * resample.c they need a compiler that supports target attributes. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define HAVE_RESAMPLE_AVX
+
+typedef gint16 spx_int16_t;
+typedef gint32 spx_word32_t;
+
+#define FIXED_POINT
+#define inner_product_single_avx inner_product_int_avx2
+#include "../../../gst/audioresample/resample_avx.h"
+#undef inner_product_single_avx
+#undef FIXED_POINT
+
+#define inner_product_single_avx inner_product_float_avx
+#define inner_product_double_avx inner_product_float_double_avx
+#include "../../../gst/audioresample/resample_avx.h"
+#undef inner_product_single_avx
+#undef inner_product_double_avx
+
+#define DOUBLE_PRECISION
+#include "../../../gst/audioresample/resample_avx.h"
+#undef DOUBLE_PRECISION
+#endif
+
 /* For ease of programming we use globals to keep refs for our floating
  * src and sink pads we create; otherwise we always have to do get_pad,
  * get_peer, and then remove references in every test function */
@@ -1090,6 +1119,100 @@ GST_START_TEST (test_fft)
 
 GST_END_TEST;
 
+#ifdef HAVE_RESAMPLE_AVX
+/* filter lengths are multiples of 4, these cover all the loop tails of the
+ * kernels */
+static const guint avx_lengths[] = { 4, 8, 12, 16, 20, 24, 28, 36, 64, 100,
+  160, 256
+};
+
+/* the C versions in resample.c sum in another order and do not fuse the
+ * multiply-add, so allow a rounding error for each product */
+#define AVX_TOLERANCE(len, abs_sum, epsilon) ((len) * (abs_sum) * (epsilon))
+
+GST_START_TEST (test_avx_kernels)
+{
+  gint16 a16[256], b16[256];
+  gfloat af[256], bf[256];
+  gdouble ad[256], bd[256];
+  GRand *rand = g_rand_new_with_seed (2013);
+  guint i, j;
+
+  /* small enough for the int32 sums of the int16 products not to overflow */
+  for (i = 0; i < 256; i++) {
+    a16[i] = g_rand_int_range (rand, -128, 128);
+    b16[i] = g_rand_int_range (rand, -32768, 32768);
+    af[i] = g_rand_double_range (rand, -1.0, 1.0);
+    bf[i] = g_rand_double_range (rand, -1.0, 1.0);
+    ad[i] = g_rand_double_range (rand, -1.0, 1.0);
+    bd[i] = g_rand_double_range (rand, -1.0, 1.0);
+  }
+  g_rand_free (rand);
+
+  __builtin_cpu_init ();
+
+  for (i = 0; i < G_N_ELEMENTS (avx_lengths); i++) {
+    guint len = avx_lengths[i];
+
+    if (__builtin_cpu_supports ("avx2")) {
+      gint32 sum = 0;
+
+      for (j = 0; j < len; j++)
+        sum += a16[j] * b16[j];
+      /* integer sums are exact */
+      fail_unless_equals_int (inner_product_int_avx2 (a16, b16, len), sum);
+    }
+
+    if (__builtin_cpu_supports ("avx") && __builtin_cpu_supports ("fma")) {
+      gfloat sum = 0.0f, abs_sum = 0.0f, res;
+      gdouble accum[4] = { 0.0, 0.0, 0.0, 0.0 }, dsum, dabs_sum = 0.0, dres;
+
+      for (j = 0; j < len; j++) {
+        sum += af[j] * bf[j];
+        abs_sum += fabsf (af[j] * bf[j]);
+      }
+      res = inner_product_float_avx (af, bf, len);
+      fail_unless (fabsf (res - sum) <= AVX_TOLERANCE (len, abs_sum,
+              FLT_EPSILON), "float length %u: %g instead of %g", len, res,
+          sum);
+
+      for (j = 0; j < len; j += 4) {
+        accum[0] += af[j] * bf[j];
+        accum[1] += af[j + 1] * bf[j + 1];
+        accum[2] += af[j + 2] * bf[j + 2];
+        accum[3] += af[j + 3] * bf[j + 3];
+      }
+      dsum = accum[0] + accum[1] + accum[2] + accum[3];
+      /* the products are rounded to float like in the C version and only
+       * the sums are in double precision */
+      dres = inner_product_float_double_avx (af, bf, len);
+      fail_unless (fabs (dres - dsum) <= AVX_TOLERANCE (len, abs_sum,
+              DBL_EPSILON), "float/double length %u: %g instead of %g", len,
+          dres, dsum);
+
+      accum[0] = accum[1] = accum[2] = accum[3] = 0.0;
+      for (j = 0; j < len; j += 4) {
+        accum[0] += ad[j] * bd[j];
+        accum[1] += ad[j + 1] * bd[j + 1];
+        accum[2] += ad[j + 2] * bd[j + 2];
+        accum[3] += ad[j + 3] * bd[j + 3];
+      }
+      dsum = accum[0] + accum[1] + accum[2] + accum[3];
+      for (j = 0; j < len; j++)
+        dabs_sum += fabs (ad[j] * bd[j]);
+      dres = inner_product_double_avx (ad, bd, len);
+      fail_unless (fabs (dres - dsum) <= AVX_TOLERANCE (len, dabs_sum,
+              DBL_EPSILON), "double length %u: %g instead of %g", len, dres,
+          dsum);
+    } else {
+      GST_INFO ("no AVX and FMA support, not testing the float kernels");
+    }
+  }
+}
+
+GST_END_TEST;
+#endif
+
 static Suite *
 audioresample_suite (void)
 {
@@ -1104,6 +1227,9 @@ audioresample_suite (void)
   tcase_add_test (tc_chain, test_live_switch);
   tcase_add_test (tc_chain, test_timestamp_drift);
   tcase_add_test (tc_chain, test_fft);
+#ifdef HAVE_RESAMPLE_AVX
+  tcase_add_test (tc_chain, test_avx_kernels);
+#endif
 
 #ifndef GST_DISABLE_PARSE
   tcase_set_timeout (tc_chain, 360);
@@ -117,6 +117,234 @@ GST_START_TEST (test_template_formats)
 
 GST_END_TEST;
 
+static void
+handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    GstBuffer ** out)
+{
+  gst_buffer_replace (out, buffer);
+}
+
+/* runs @pipeline_desc until EOS and returns the last buffer of the fakesink
+ * with the given name */
+static GstBuffer *
+run_pipeline (const gchar * pipeline_desc, const gchar * sink_name,
+    GstBuffer ** other, const gchar * other_name)
+{
+  GstElement *pipeline, *sink;
+  GstBuffer *buffer = NULL;
+  GstMessage *msg;
+  GstBus *bus;
+  GError *err = NULL;
+
+  pipeline = gst_parse_launch (pipeline_desc, &err);
+  fail_unless (pipeline != NULL, "could not create pipeline: %s",
+      err ? err->message : "");
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), sink_name);
+  fail_unless (sink != NULL);
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (handoff_cb), &buffer);
+  gst_object_unref (sink);
+
+  if (other) {
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), other_name);
+    fail_unless (sink != NULL);
+    g_object_set (sink, "signal-handoffs", TRUE, NULL);
+    g_signal_connect (sink, "handoff", G_CALLBACK (handoff_cb), other);
+    gst_object_unref (sink);
+  }
+
+  fail_if (gst_element_set_state (pipeline, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  fail_unless (buffer != NULL);
+
+  return buffer;
+}
+
+/* compares the visible pixels of two frames, the padding is undefined */
+static void
+compare_frames (GstBuffer * buf1, GstBuffer * buf2, GstVideoInfo * info)
+{
+  GstVideoFrame frame1, frame2;
+  guint c, l, x, bytes;
+
+  fail_unless (gst_video_frame_map (&frame1, info, buf1, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&frame2, info, buf2, GST_MAP_READ));
+
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (&frame1); c++) {
+    bytes = GST_VIDEO_FRAME_COMP_DEPTH (&frame1, c) > 8 ? 2 : 1;
+
+    for (l = 0; l < GST_VIDEO_FRAME_COMP_HEIGHT (&frame1, c); l++) {
+      const guint8 *p1, *p2;
+
+      p1 = GST_VIDEO_FRAME_COMP_DATA (&frame1, c);
+      p1 += l * GST_VIDEO_FRAME_COMP_STRIDE (&frame1, c);
+      p2 = GST_VIDEO_FRAME_COMP_DATA (&frame2, c);
+      p2 += l * GST_VIDEO_FRAME_COMP_STRIDE (&frame2, c);
+
+      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&frame1, c); x++) {
+        guint o = x * GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, c);
+
+        fail_unless (memcmp (p1 + o, p2 + o, bytes) == 0,
+            "component %u differs at %u,%u", c, x, l);
+      }
+    }
+  }
+  gst_video_frame_unmap (&frame1);
+  gst_video_frame_unmap (&frame2);
+}
+
+static const gchar *fastpath_pairs[][2] = {
+  {"YUY2", "I420"},
+  {"UYVY", "I420"},
+  {"YUY2", "NV12"},
+  {"UYVY", "NV12"},
+  {"NV12", "I420"},
+  {"NV12", "YV12"},
+  {"NV21", "I420"},
+  {"I420", "NV12"},
+  {"YV12", "NV21"},
+  {"I420", "BGRx"},
+};
+
+static const gint fastpath_sizes[][2] = {
+  {320, 240},
+  {322, 242},
+  {319, 241},
+  {17, 9},
+};
+
+GST_START_TEST (test_fastpath_sizes)
+{
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (fastpath_pairs); i++) {
+    for (j = 0; j < G_N_ELEMENTS (fastpath_sizes); j++) {
+      GstVideoInfo info;
+      GstBuffer *buffer;
+      gchar *desc;
+
+      GST_DEBUG ("converting %s to %s at %dx%d", fastpath_pairs[i][0],
+          fastpath_pairs[i][1], fastpath_sizes[j][0], fastpath_sizes[j][1]);
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=2 ! "
+          "video/x-raw,format=%s,width=%d,height=%d,"
+          "colorimetry=bt601 ! videoconvert ! "
+          "video/x-raw,format=%s ! fakesink name=sink",
+          fastpath_pairs[i][0], fastpath_sizes[j][0], fastpath_sizes[j][1],
+          fastpath_pairs[i][1]);
+      buffer = run_pipeline (desc, "sink", NULL, NULL);
+      g_free (desc);
+
+      gst_video_info_init (&info);
+      gst_video_info_set_format (&info,
+          gst_video_format_from_string (fastpath_pairs[i][1]),
+          fastpath_sizes[j][0], fastpath_sizes[j][1]);
+      fail_unless_equals_int (gst_buffer_get_size (buffer), info.size);
+      gst_buffer_unref (buffer);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* the planar <-> semi-planar conversions only move bytes around, so a round
+ * trip must give back the original frame */
+GST_START_TEST (test_fastpath_nv12_roundtrip)
+{
+  const gchar *formats[] = { "NV12", "NV21" };
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (fastpath_sizes); j++) {
+      GstBuffer *orig = NULL, *result;
+      GstVideoInfo info;
+      gchar *desc;
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 pattern=snow ! "
+          "video/x-raw,format=I420,width=%d,height=%d ! tee name=t ! "
+          "queue ! fakesink name=orig t. ! queue ! videoconvert ! "
+          "video/x-raw,format=%s ! videoconvert ! video/x-raw,format=I420 ! "
+          "fakesink name=result", fastpath_sizes[j][0], fastpath_sizes[j][1],
+          formats[i]);
+      result = run_pipeline (desc, "result", &orig, "orig");
+      g_free (desc);
+
+      fail_unless (orig != NULL);
+      gst_video_info_init (&info);
+      gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420,
+          fastpath_sizes[j][0], fastpath_sizes[j][1]);
+      compare_frames (orig, result, &info);
+
+      gst_buffer_unref (orig);
+      gst_buffer_unref (result);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* converting in bands must give the same result as converting the complete
+ * frame, this covers fast paths and the generic path with chroma resampling */
+static const gchar *threads_pairs[][3] = {
+  {"YUY2", "I420", "none"},
+  {"I420", "NV12", "none"},
+  {"I420", "AYUV", "none"},
+  {"AYUV", "I420", "none"},
+  {"Y41B", "YUY2", "none"},
+  {"AYUV64", "RGB", "halftone"},
+};
+
+GST_START_TEST (test_n_threads)
+{
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (threads_pairs); i++) {
+    for (j = 0; j < G_N_ELEMENTS (fastpath_sizes); j++) {
+      GstBuffer *single = NULL, *multi;
+      GstVideoInfo info;
+      gchar *desc;
+
+      GST_DEBUG ("converting %s to %s at %dx%d", threads_pairs[i][0],
+          threads_pairs[i][1], fastpath_sizes[j][0], fastpath_sizes[j][1]);
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+          "video/x-raw,format=%s,width=%d,height=%d ! tee name=t ! "
+          "queue ! videoconvert dither=%s n-threads=1 ! "
+          "video/x-raw,format=%s ! fakesink name=single t. ! queue ! "
+          "videoconvert dither=%s n-threads=4 ! video/x-raw,format=%s ! "
+          "fakesink name=multi", threads_pairs[i][0], fastpath_sizes[j][0],
+          fastpath_sizes[j][1], threads_pairs[i][2], threads_pairs[i][1],
+          threads_pairs[i][2], threads_pairs[i][1]);
+      multi = run_pipeline (desc, "multi", &single, "single");
+      g_free (desc);
+
+      fail_unless (single != NULL);
+      gst_video_info_init (&info);
+      gst_video_info_set_format (&info,
+          gst_video_format_from_string (threads_pairs[i][1]),
+          fastpath_sizes[j][0], fastpath_sizes[j][1]);
+      compare_frames (single, multi, &info);
+
+      gst_buffer_unref (single);
+      gst_buffer_unref (multi);
+    }
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 videoconvert_suite (void)
 {
@@ -126,6 +354,9 @@ videoconvert_suite (void)
   suite_add_tcase (s, tc_chain);
 
   tcase_add_test (tc_chain, test_template_formats);
+  tcase_add_test (tc_chain, test_fastpath_sizes);
+  tcase_add_test (tc_chain, test_fastpath_nv12_roundtrip);
+  tcase_add_test (tc_chain, test_n_threads);
 
   return s;
 }
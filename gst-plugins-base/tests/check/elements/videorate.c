@@ -23,6 +23,7 @@
 #include <unistd.h>
 
 #include <gst/check/gstcheck.h>
+#include <gst/video/gstvideometa.h>
 
 /* For ease of programming we use globals to keep refs for our floating
  * src and sink pads we create; otherwise we always have to do get_pad,
@@ -307,6 +308,77 @@ GST_START_TEST (test_more)
 
 GST_END_TEST;
 
+/* duplicates share the memory of the frame they repeat and are marked with
+ * a repeat meta pointing at its offset */
+GST_START_TEST (test_repeat_meta)
+{
+  GstElement *videorate;
+  GstBuffer *first, *second, *third;
+  GstVideoRepeatMeta *meta;
+  GstCaps *caps;
+  GList *l;
+
+  videorate = setup_videorate ();
+  g_object_set (videorate, "repeat-meta", TRUE, NULL);
+  fail_unless (gst_element_set_state (videorate,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VIDEO_CAPS_STRING);
+  gst_check_setup_events (mysrcpad, videorate, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  first = gst_buffer_new_and_alloc (4);
+  GST_BUFFER_TIMESTAMP (first) = 0;
+  gst_buffer_memset (first, 0, 1, 4);
+  fail_unless (gst_pad_push (mysrcpad, first) == GST_FLOW_OK);
+
+  second = gst_buffer_new_and_alloc (4);
+  GST_BUFFER_TIMESTAMP (second) = GST_SECOND * 3 / 50;
+  gst_buffer_memset (second, 0, 2, 4);
+  fail_unless (gst_pad_push (mysrcpad, second) == GST_FLOW_OK);
+
+  third = gst_buffer_new_and_alloc (4);
+  GST_BUFFER_TIMESTAMP (third) = GST_SECOND * 12 / 50;
+  gst_buffer_memset (third, 0, 3, 4);
+  fail_unless (gst_pad_push (mysrcpad, third) == GST_FLOW_OK);
+
+  assert_videorate_stats (videorate, "third buffer", 3, 4, 0, 2);
+  fail_unless_equals_int (g_list_length (buffers), 4);
+
+  l = buffers;
+  fail_unless (gst_buffer_get_video_repeat_meta (l->data) == NULL);
+
+  l = g_list_next (l);
+  fail_unless_equals_uint64 (GST_BUFFER_OFFSET (l->data), 1);
+  fail_unless (gst_buffer_get_video_repeat_meta (l->data) == NULL);
+
+  l = g_list_next (l);
+  meta = gst_buffer_get_video_repeat_meta (l->data);
+  fail_unless (meta != NULL);
+  fail_unless_equals_uint64 (meta->repeat_of, 1);
+  fail_unless_equals_int (meta->count, 1);
+  fail_unless (gst_buffer_peek_memory (l->data, 0) ==
+      gst_buffer_peek_memory (l->prev->data, 0));
+
+  l = g_list_next (l);
+  meta = gst_buffer_get_video_repeat_meta (l->data);
+  fail_unless (meta != NULL);
+  fail_unless_equals_uint64 (meta->repeat_of, 1);
+  fail_unless_equals_int (meta->count, 2);
+  fail_unless (gst_buffer_peek_memory (l->data, 0) ==
+      gst_buffer_peek_memory (l->prev->data, 0));
+
+  /* a repeat stays a repeat after a colorspace conversion, so videoconvert
+   * keeps the meta */
+  fail_if (gst_meta_api_type_has_tag (GST_VIDEO_REPEAT_META_API_TYPE,
+          g_quark_from_static_string ("colorspace")));
+
+  cleanup_videorate (videorate);
+}
+
+GST_END_TEST;
+
 /* frames at 1, 0, 2 -> second one should be ignored */
 GST_START_TEST (test_wrong_order_from_zero)
 {
@@ -1045,6 +1117,7 @@ videorate_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_one);
   tcase_add_test (tc_chain, test_more);
+  tcase_add_test (tc_chain, test_repeat_meta);
   tcase_add_test (tc_chain, test_wrong_order_from_zero);
   tcase_add_test (tc_chain, test_wrong_order);
   tcase_add_test (tc_chain, test_no_framerate);
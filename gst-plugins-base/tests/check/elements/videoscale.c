@@ -481,6 +481,347 @@ CREATE_TEST (test_upscale_1x240_640x480_method_1, 1, 1, 240, 640, 480);
 CREATE_TEST (test_upscale_1x240_640x480_method_2, 2, 1, 240, 640, 480);
 CREATE_TEST (test_upscale_1x240_640x480_method_3, 3, 1, 240, 640, 480);
 
+static void
+on_sink_handoff_last (GstElement * element, GstBuffer * buffer, GstPad * pad,
+    GstBuffer ** last)
+{
+  gst_buffer_replace (last, buffer);
+}
+
+/* scaling in bands of lines on multiple threads must give the same result as
+ * scaling the complete frame */
+static const struct
+{
+  const gchar *format;
+  gint method;
+} threads_formats[] = {
+  {"I420", 0}, {"I420", 1}, {"I420", 2}, {"I420", 3},
+  {"YUY2", 1}, {"YUY2", 2}, {"YUY2", 3},
+  {"UYVY", 3},
+  {"AYUV", 1}, {"AYUV", 2}, {"AYUV", 3},
+  {"RGB", 2}, {"RGB", 3},
+  {"GRAY8", 3},
+  {"NV12", 1}, {"NV12", 2}, {"NV12", 3},
+  {"GRAY16_LE", 2},
+};
+
+static const gint threads_sizes[][4] = {
+  {320, 241, 111, 97},
+  {111, 30, 641, 481},
+  {64, 64, 64, 7},
+};
+
+GST_START_TEST (test_n_threads)
+{
+  guint i, j, c, l;
+
+  for (i = 0; i < G_N_ELEMENTS (threads_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (threads_sizes); j++) {
+      GstElement *pipeline, *sink;
+      GstBuffer *single = NULL, *multi = NULL;
+      GstVideoFrame frame1, frame2;
+      GstVideoInfo info;
+      GstMessage *msg;
+      GstBus *bus;
+      gchar *desc;
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+          "video/x-raw,format=%s,width=%d,height=%d ! tee name=t ! queue ! "
+          "videoscale method=%d n-threads=1 ! video/x-raw,width=%d,height=%d ! "
+          "fakesink name=single signal-handoffs=true t. ! queue ! "
+          "videoscale method=%d n-threads=4 ! video/x-raw,width=%d,height=%d ! "
+          "fakesink name=multi signal-handoffs=true",
+          threads_formats[i].format, threads_sizes[j][0], threads_sizes[j][1],
+          threads_formats[i].method, threads_sizes[j][2], threads_sizes[j][3],
+          threads_formats[i].method, threads_sizes[j][2], threads_sizes[j][3]);
+      pipeline = gst_parse_launch (desc, NULL);
+      fail_unless (pipeline != NULL);
+      g_free (desc);
+
+      sink = gst_bin_get_by_name (GST_BIN (pipeline), "single");
+      g_signal_connect (sink, "handoff", G_CALLBACK (on_sink_handoff_last),
+          &single);
+      gst_object_unref (sink);
+      sink = gst_bin_get_by_name (GST_BIN (pipeline), "multi");
+      g_signal_connect (sink, "handoff", G_CALLBACK (on_sink_handoff_last),
+          &multi);
+      gst_object_unref (sink);
+
+      fail_unless (gst_element_set_state (pipeline,
+              GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+      bus = gst_element_get_bus (pipeline);
+      msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+          GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+      fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+      gst_message_unref (msg);
+      gst_object_unref (bus);
+      fail_unless (gst_element_set_state (pipeline,
+              GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS);
+      gst_object_unref (pipeline);
+
+      fail_unless (single != NULL && multi != NULL);
+      gst_video_info_init (&info);
+      gst_video_info_set_format (&info,
+          gst_video_format_from_string (threads_formats[i].format),
+          threads_sizes[j][2], threads_sizes[j][3]);
+      fail_unless (gst_video_frame_map (&frame1, &info, single, GST_MAP_READ));
+      fail_unless (gst_video_frame_map (&frame2, &info, multi, GST_MAP_READ));
+
+      /* compare the visible lines only, the padding is undefined */
+      for (c = 0; c < GST_VIDEO_FRAME_N_PLANES (&frame1); c++) {
+        for (l = 0; l < GST_VIDEO_FRAME_COMP_HEIGHT (&frame1, c); l++) {
+          const guint8 *p1, *p2;
+
+          p1 = GST_VIDEO_FRAME_PLANE_DATA (&frame1, c);
+          p1 += l * GST_VIDEO_FRAME_PLANE_STRIDE (&frame1, c);
+          p2 = GST_VIDEO_FRAME_PLANE_DATA (&frame2, c);
+          p2 += l * GST_VIDEO_FRAME_PLANE_STRIDE (&frame2, c);
+          fail_unless (memcmp (p1, p2, GST_VIDEO_FRAME_COMP_WIDTH (&frame1,
+                      c) * GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, c)) == 0,
+              "%s method %d differs in plane %u line %u",
+              threads_formats[i].format, threads_formats[i].method, c, l);
+        }
+      }
+      gst_video_frame_unmap (&frame1);
+      gst_video_frame_unmap (&frame2);
+
+      gst_buffer_unref (single);
+      gst_buffer_unref (multi);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* runs @desc and returns the last buffers of the fakesinks s1 and, if @buf2
+ * is not NULL, s2 */
+static void
+run_convert_scale_pipeline (const gchar * desc, GstBuffer ** buf1,
+    GstBuffer ** buf2)
+{
+  GstElement *pipeline, *sink;
+  GstMessage *msg;
+  GstBus *bus;
+
+  pipeline = gst_parse_launch (desc, NULL);
+  fail_unless (pipeline != NULL, "could not create %s", desc);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "s1");
+  g_signal_connect (sink, "handoff", G_CALLBACK (on_sink_handoff_last), buf1);
+  gst_object_unref (sink);
+  if (buf2) {
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), "s2");
+    g_signal_connect (sink, "handoff", G_CALLBACK (on_sink_handoff_last),
+        buf2);
+    gst_object_unref (sink);
+  }
+
+  fail_unless (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+  fail_unless (gst_element_set_state (pipeline,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (pipeline);
+
+  fail_unless (*buf1 != NULL && (buf2 == NULL || *buf2 != NULL));
+}
+
+/* returns the average difference of the visible bytes of two frames and
+ * checks if they are equal */
+static gdouble
+compare_frames (GstBuffer * buf1, GstBuffer * buf2, const gchar * format,
+    gint width, gint height, gboolean * equal)
+{
+  GstVideoFrame frame1, frame2;
+  GstVideoInfo info;
+  guint64 sum = 0, count = 0;
+  guint c, l, i;
+
+  gst_video_info_init (&info);
+  gst_video_info_set_format (&info, gst_video_format_from_string (format),
+      width, height);
+  fail_unless (gst_video_frame_map (&frame1, &info, buf1, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&frame2, &info, buf2, GST_MAP_READ));
+
+  *equal = TRUE;
+  for (c = 0; c < GST_VIDEO_FRAME_N_PLANES (&frame1); c++) {
+    for (l = 0; l < GST_VIDEO_FRAME_COMP_HEIGHT (&frame1, c); l++) {
+      const guint8 *p1, *p2;
+      guint size;
+
+      p1 = GST_VIDEO_FRAME_PLANE_DATA (&frame1, c);
+      p1 += l * GST_VIDEO_FRAME_PLANE_STRIDE (&frame1, c);
+      p2 = GST_VIDEO_FRAME_PLANE_DATA (&frame2, c);
+      p2 += l * GST_VIDEO_FRAME_PLANE_STRIDE (&frame2, c);
+      size = GST_VIDEO_FRAME_COMP_WIDTH (&frame1, c) *
+          GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, c);
+      /* v210 packs 6 pixels in 16 bytes */
+      if (size == 0)
+        size = (width + 5) / 6 * 16;
+
+      for (i = 0; i < size; i++) {
+        if (p1[i] != p2[i])
+          *equal = FALSE;
+        sum += ABS (p1[i] - p2[i]);
+      }
+      count += size;
+    }
+  }
+  gst_video_frame_unmap (&frame1);
+  gst_video_frame_unmap (&frame2);
+
+  return (gdouble) sum / count;
+}
+
+/* converting and scaling in one pass must give the same result on multiple
+ * threads and about the same result as videoconvert ! videoscale */
+static const struct
+{
+  const gchar *in_format;
+  const gchar *out_format;
+  gint method;
+} convert_scale_formats[] = {
+  {"I420", "BGRx", 1}, {"I420", "BGRx", 2}, {"I420", "YUY2", 1},
+  {"YUY2", "I420", 1}, {"NV12", "AYUV", 0}, {"AYUV", "RGB", 3},
+  {"BGRx", "I420", 2}, {"I420", "v210", 1}, {"v210", "I420", 1},
+};
+
+/* output sizes for 320x240 input with another aspect ratio, adding borders
+ * on the left and right and on the top and bottom */
+static const gint convert_scale_borders_sizes[][2] = {
+  {320, 120}, {160, 200},
+};
+
+GST_START_TEST (test_convert_scale)
+{
+  guint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (convert_scale_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (threads_sizes); j++) {
+      GstBuffer *buf1 = NULL, *buf2 = NULL;
+      const gchar *out_format = convert_scale_formats[i].out_format;
+      gint out_width = threads_sizes[j][2], out_height = threads_sizes[j][3];
+      gboolean equal;
+      gdouble diff;
+      gchar *desc;
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+          "video/x-raw,format=%s,width=%d,height=%d ! tee name=t ! queue ! "
+          "videoconvertscale method=%d n-threads=1 ! "
+          "video/x-raw,format=%s,width=%d,height=%d ! "
+          "fakesink name=s1 signal-handoffs=true t. ! queue ! "
+          "videoconvertscale method=%d n-threads=4 ! "
+          "video/x-raw,format=%s,width=%d,height=%d ! "
+          "fakesink name=s2 signal-handoffs=true",
+          convert_scale_formats[i].in_format, threads_sizes[j][0],
+          threads_sizes[j][1], convert_scale_formats[i].method, out_format,
+          out_width, out_height, convert_scale_formats[i].method, out_format,
+          out_width, out_height);
+      run_convert_scale_pipeline (desc, &buf1, &buf2);
+      g_free (desc);
+
+      compare_frames (buf1, buf2, out_format, out_width, out_height, &equal);
+      fail_unless (equal, "%s -> %s method %d differs on multiple threads",
+          convert_scale_formats[i].in_format, out_format,
+          convert_scale_formats[i].method);
+      gst_buffer_replace (&buf2, NULL);
+
+      /* videoscale does not handle v210 */
+      if (strcmp (out_format, "v210") != 0 &&
+          strcmp (convert_scale_formats[i].in_format, "v210") != 0) {
+        desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+            "video/x-raw,format=%s,width=%d,height=%d ! "
+            "videoconvert ! video/x-raw,format=%s ! videoscale method=%d ! "
+            "video/x-raw,width=%d,height=%d ! "
+            "fakesink name=s1 signal-handoffs=true",
+            convert_scale_formats[i].in_format, threads_sizes[j][0],
+            threads_sizes[j][1], out_format, convert_scale_formats[i].method,
+            out_width, out_height);
+        run_convert_scale_pipeline (desc, &buf2, NULL);
+        g_free (desc);
+
+        diff = compare_frames (buf1, buf2, out_format, out_width, out_height,
+            &equal);
+        fail_unless (diff < 6.0, "%s -> %s method %d differs from "
+            "videoconvert ! videoscale by %f",
+            convert_scale_formats[i].in_format, out_format,
+            convert_scale_formats[i].method, diff);
+        gst_buffer_unref (buf2);
+      }
+
+      gst_buffer_unref (buf1);
+    }
+  }
+
+  /* with add-borders the borders are filled in the same pass, check both
+   * letterboxing and pillarboxing */
+  for (i = 0; i < G_N_ELEMENTS (convert_scale_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (convert_scale_borders_sizes); j++) {
+      GstBuffer *buf1 = NULL, *buf2 = NULL;
+      const gchar *out_format = convert_scale_formats[i].out_format;
+      gint out_width = convert_scale_borders_sizes[j][0];
+      gint out_height = convert_scale_borders_sizes[j][1];
+      gboolean equal;
+      gdouble diff;
+      gchar *desc;
+
+      /* videoscale does not handle v210 */
+      if (strcmp (out_format, "v210") == 0 ||
+          strcmp (convert_scale_formats[i].in_format, "v210") == 0)
+        continue;
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+          "video/x-raw,format=%s,width=320,height=240,"
+          "pixel-aspect-ratio=1/1 ! tee name=t ! queue ! "
+          "videoconvertscale method=%d add-borders=true n-threads=1 ! "
+          "video/x-raw,format=%s,width=%d,height=%d,pixel-aspect-ratio=1/1 ! "
+          "fakesink name=s1 signal-handoffs=true t. ! queue ! "
+          "videoconvertscale method=%d add-borders=true n-threads=4 ! "
+          "video/x-raw,format=%s,width=%d,height=%d,pixel-aspect-ratio=1/1 ! "
+          "fakesink name=s2 signal-handoffs=true",
+          convert_scale_formats[i].in_format,
+          convert_scale_formats[i].method, out_format, out_width, out_height,
+          convert_scale_formats[i].method, out_format, out_width, out_height);
+      run_convert_scale_pipeline (desc, &buf1, &buf2);
+      g_free (desc);
+
+      compare_frames (buf1, buf2, out_format, out_width, out_height, &equal);
+      fail_unless (equal, "%s -> %s %dx%d with borders differs on multiple "
+          "threads", convert_scale_formats[i].in_format, out_format,
+          out_width, out_height);
+      gst_buffer_replace (&buf2, NULL);
+
+      desc = g_strdup_printf ("videotestsrc num-buffers=1 ! "
+          "video/x-raw,format=%s,width=320,height=240,"
+          "pixel-aspect-ratio=1/1 ! "
+          "videoconvert ! video/x-raw,format=%s ! "
+          "videoscale method=%d add-borders=true ! "
+          "video/x-raw,width=%d,height=%d,pixel-aspect-ratio=1/1 ! "
+          "fakesink name=s1 signal-handoffs=true",
+          convert_scale_formats[i].in_format, out_format,
+          convert_scale_formats[i].method, out_width, out_height);
+      run_convert_scale_pipeline (desc, &buf2, NULL);
+      g_free (desc);
+
+      diff = compare_frames (buf1, buf2, out_format, out_width, out_height,
+          &equal);
+      fail_unless (diff < 6.0, "%s -> %s %dx%d with borders differs from "
+          "videoconvert ! videoscale by %f",
+          convert_scale_formats[i].in_format, out_format, out_width,
+          out_height, diff);
+      gst_buffer_unref (buf2);
+      gst_buffer_unref (buf1);
+    }
+  }
+}
+
+GST_END_TEST;
+
 typedef struct
 {
   gint width, height;
@@ -1032,6 +1373,8 @@ videoscale_suite (void)
   tcase_add_test (tc_chain, test_upscale_1x240_640x480_method_1);
   tcase_add_test (tc_chain, test_upscale_1x240_640x480_method_2);
   tcase_add_test (tc_chain, test_upscale_1x240_640x480_method_3);
+  tcase_add_test (tc_chain, test_n_threads);
+  tcase_add_test (tc_chain, test_convert_scale);
   tcase_add_test (tc_chain, test_negotiation);
 #if 0
   tcase_add_test (tc_chain, test_reverse_negotiation);
@@ -26,6 +26,7 @@
 #endif
 
 #include <gst/check/gstcheck.h>
+#include <gst/check/gsttestclock.h>
 
 #include <gst/audio/audio.h>
 #include <string.h>
@@ -591,6 +592,333 @@ GST_START_TEST (test_audio_info)
 
 GST_END_TEST;
 
+/* a ringbuffer without a device, segments are only consumed when the test
+ * advances the read pointer */
+typedef GstAudioRingBuffer GstTestRingBuffer;
+typedef GstAudioRingBufferClass GstTestRingBufferClass;
+
+static GType gst_test_ring_buffer_get_type (void);
+G_DEFINE_TYPE (GstTestRingBuffer, gst_test_ring_buffer,
+    GST_TYPE_AUDIO_RING_BUFFER);
+
+static gboolean
+gst_test_ring_buffer_acquire (GstAudioRingBuffer * buf,
+    GstAudioRingBufferSpec * spec)
+{
+  spec->segsize = 4 * GST_AUDIO_INFO_BPF (&spec->info);
+  spec->segtotal = 4;
+
+  buf->size = spec->segtotal * spec->segsize;
+  buf->memory = g_malloc0 (buf->size);
+
+  return TRUE;
+}
+
+static gboolean
+gst_test_ring_buffer_release (GstAudioRingBuffer * buf)
+{
+  g_free (buf->memory);
+  buf->memory = NULL;
+
+  return TRUE;
+}
+
+static gboolean
+gst_test_ring_buffer_true (GstAudioRingBuffer * buf)
+{
+  return TRUE;
+}
+
+static void
+gst_test_ring_buffer_class_init (GstTestRingBufferClass * klass)
+{
+  klass->open_device = gst_test_ring_buffer_true;
+  klass->close_device = gst_test_ring_buffer_true;
+  klass->acquire = gst_test_ring_buffer_acquire;
+  klass->release = gst_test_ring_buffer_release;
+  klass->start = gst_test_ring_buffer_true;
+  klass->pause = gst_test_ring_buffer_true;
+  klass->stop = gst_test_ring_buffer_true;
+}
+
+static void
+gst_test_ring_buffer_init (GstTestRingBuffer * buf)
+{
+}
+
+GST_START_TEST (test_ring_buffer_commit)
+{
+  GstAudioRingBuffer *buf;
+  GstCaps *caps;
+  gint16 in[2 * 24], *mem;
+  guint64 sample;
+  gint i, accum = 0;
+
+  for (i = 0; i < G_N_ELEMENTS (in); i++)
+    in[i] = i;
+
+  buf = g_object_new (gst_test_ring_buffer_get_type (), NULL);
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (S16),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 8000, "channels", G_TYPE_INT, 2, NULL);
+  buf->spec.buffer_time = 2000;
+  buf->spec.latency_time = 500;
+  fail_unless (gst_audio_ring_buffer_parse_caps (&buf->spec, caps));
+  gst_caps_unref (caps);
+  fail_unless (gst_audio_ring_buffer_open_device (buf));
+  fail_unless (gst_audio_ring_buffer_acquire (buf, &buf->spec));
+  fail_unless_equals_int (buf->samples_per_seg, 4);
+  mem = (gint16 *) buf->memory;
+
+  /* the ringbuffer holds 16 samples and nobody reads, so only those get
+   * written, after that we are not allowed to start and wait */
+  sample = 0;
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) in, 20, 20, &accum), 16);
+  fail_unless_equals_int (sample, 16);
+  fail_unless (memcmp (mem, in, 16 * 4) == 0);
+
+  /* the reader consumed two segments, the rest wraps around to the start */
+  gst_audio_ring_buffer_advance (buf, 2);
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) (in + 2 * 16), 8, 8, &accum), 8);
+  fail_unless_equals_int (sample, 24);
+  fail_unless (memcmp (mem, in + 2 * 16, 8 * 4) == 0);
+  fail_unless (memcmp (mem + 2 * 8, in + 2 * 8, 8 * 4) == 0);
+
+  /* samples the reader already went past are dropped */
+  gst_audio_ring_buffer_advance (buf, 4);
+  sample = 20;
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) in, 8, 8, &accum), 8);
+  fail_unless_equals_int (sample, 28);
+  fail_unless (memcmp (mem + 2 * 8, in + 2 * 4, 4 * 4) == 0);
+  fail_unless (memcmp (mem, in + 2 * 16, 8 * 4) == 0);
+
+  fail_unless (gst_audio_ring_buffer_release (buf));
+  fail_unless (gst_audio_ring_buffer_close_device (buf));
+  gst_object_unref (buf);
+}
+
+GST_END_TEST;
+
+/* an audio sink without a device that captures what it plays. The device
+ * only consumes as much as the test allows, so that it never plays past the
+ * samples that were rendered */
+typedef GstAudioSink GstCaptureAudioSink;
+typedef GstAudioSinkClass GstCaptureAudioSinkClass;
+
+static GType gst_capture_audio_sink_get_type (void);
+G_DEFINE_TYPE (GstCaptureAudioSink, gst_capture_audio_sink,
+    GST_TYPE_AUDIO_SINK);
+
+static GstStaticPadTemplate capture_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("audio/x-raw"));
+static GstStaticPadTemplate capture_src_template =
+GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("audio/x-raw"));
+
+static GMutex capture_lock;
+static GCond capture_cond;
+static GByteArray *capture_data;
+static guint capture_allowed;
+static gboolean capture_flushing;
+static GstPad *capture_srcpad;
+
+static gboolean
+gst_capture_audio_sink_true (GstAudioSink * sink)
+{
+  return TRUE;
+}
+
+static gboolean
+gst_capture_audio_sink_prepare (GstAudioSink * sink,
+    GstAudioRingBufferSpec * spec)
+{
+  return TRUE;
+}
+
+static gint
+gst_capture_audio_sink_write (GstAudioSink * sink, gpointer data,
+    guint length)
+{
+  g_mutex_lock (&capture_lock);
+  while (!capture_flushing && capture_data->len + length > capture_allowed)
+    g_cond_wait (&capture_cond, &capture_lock);
+  if (!capture_flushing)
+    g_byte_array_append (capture_data, data, length);
+  g_cond_broadcast (&capture_cond);
+  g_mutex_unlock (&capture_lock);
+
+  return length;
+}
+
+static guint
+gst_capture_audio_sink_delay (GstAudioSink * sink)
+{
+  return 0;
+}
+
+static void
+gst_capture_audio_sink_reset (GstAudioSink * sink)
+{
+  g_mutex_lock (&capture_lock);
+  capture_flushing = TRUE;
+  g_cond_broadcast (&capture_cond);
+  g_mutex_unlock (&capture_lock);
+}
+
+static void
+gst_capture_audio_sink_class_init (GstCaptureAudioSinkClass * klass)
+{
+  gst_element_class_add_pad_template (GST_ELEMENT_CLASS (klass),
+      gst_static_pad_template_get (&capture_sink_template));
+
+  klass->open = gst_capture_audio_sink_true;
+  klass->prepare = gst_capture_audio_sink_prepare;
+  klass->unprepare = gst_capture_audio_sink_true;
+  klass->close = gst_capture_audio_sink_true;
+  klass->write = gst_capture_audio_sink_write;
+  klass->delay = gst_capture_audio_sink_delay;
+  klass->reset = gst_capture_audio_sink_reset;
+}
+
+static void
+gst_capture_audio_sink_init (GstCaptureAudioSink * sink)
+{
+}
+
+/* pushes 100 buffers of 10 ms with a ramp that rises by 1000 per sample and
+ * lets the device play everything that was rendered */
+static gpointer
+push_ramp_buffers (GstAudioBaseSink * sink)
+{
+  gint32 data[80];
+  guint i, k;
+
+  for (k = 0; k < 100; k++) {
+    GstBuffer *buffer;
+
+    for (i = 0; i < 80; i++)
+      data[i] = (k * 80 + i) * 1000;
+
+    buffer = gst_buffer_new_wrapped (g_memdup (data, sizeof (data)),
+        sizeof (data));
+    GST_BUFFER_TIMESTAMP (buffer) = k * 10 * GST_MSECOND;
+    GST_BUFFER_DURATION (buffer) = 10 * GST_MSECOND;
+    fail_unless_equals_int (gst_pad_push (capture_srcpad, buffer),
+        GST_FLOW_OK);
+
+    g_mutex_lock (&capture_lock);
+    capture_allowed = sink->next_sample * sizeof (gint32);
+    g_cond_broadcast (&capture_cond);
+    g_mutex_unlock (&capture_lock);
+  }
+
+  return NULL;
+}
+
+/* plays the ramp on a sink that is slaved to a master clock running at
+ * @rate_num / @rate_denom of the speed of the sink */
+static void
+check_interpolate_skew (GstClockTime rate_num, GstClockTime rate_denom)
+{
+  GstElement *sink;
+  GstClock *clock;
+  GstClockID id;
+  GstCaps *caps;
+  GThread *thread;
+  const gint32 *out;
+  guint i, n, expected, segsize;
+
+  capture_data = g_byte_array_new ();
+  capture_allowed = 0;
+  capture_flushing = FALSE;
+
+  sink = g_object_new (gst_capture_audio_sink_get_type (),
+      "slave-method", GST_AUDIO_BASE_SINK_SLAVE_INTERPOLATE,
+      "buffer-time", (gint64) 1000000, "latency-time", (gint64) 10000, NULL);
+  clock = gst_test_clock_new ();
+  gst_element_set_clock (sink, clock);
+
+  capture_srcpad = gst_check_setup_src_pad (sink, &capture_src_template);
+  gst_pad_set_active (capture_srcpad, TRUE);
+  fail_unless_equals_int (gst_element_set_state (sink, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (S32),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 8000, "channels", G_TYPE_INT, 1, NULL);
+  gst_check_setup_events (capture_srcpad, sink, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  /* the sink keeps this rate when it calibrates after the latency wait */
+  gst_clock_set_calibration (GST_AUDIO_BASE_SINK (sink)->provided_clock, 0, 0,
+      rate_num, rate_denom);
+
+  thread = g_thread_new ("push", (GThreadFunc) push_ramp_buffers, sink);
+
+  /* the first buffer in PLAYING waits for the latency on the master clock */
+  gst_test_clock_wait_for_next_pending_id (GST_TEST_CLOCK (clock), &id);
+  gst_clock_id_unref (gst_test_clock_process_next_clock_id (GST_TEST_CLOCK
+          (clock)));
+  gst_clock_id_unref (id);
+
+  g_thread_join (thread);
+
+  /* wait until the device played all complete segments */
+  segsize = GST_AUDIO_BASE_SINK (sink)->ringbuffer->spec.segsize;
+  g_mutex_lock (&capture_lock);
+  while (capture_data->len < capture_allowed / segsize * segsize)
+    g_cond_wait (&capture_cond, &capture_lock);
+  g_mutex_unlock (&capture_lock);
+
+  /* the samples were stretched or compressed to the rate of the master */
+  expected = gst_util_uint64_scale (100 * 80, rate_denom, rate_num);
+  fail_unless (ABS ((gint64) GST_AUDIO_BASE_SINK (sink)->next_sample -
+          (gint64) expected) <= 2, "rendered %" G_GUINT64_FORMAT
+      " samples instead of %u", GST_AUDIO_BASE_SINK (sink)->next_sample,
+      expected);
+
+  /* and played without gaps, drops or repeats: the ramp continues with
+   * steps that only differ by the interpolation from one input sample */
+  out = (const gint32 *) capture_data->data;
+  n = capture_data->len / sizeof (gint32);
+  fail_unless (n >= expected - 2 * 80);
+  fail_unless_equals_int (out[0], 0);
+  for (i = 1; i < n; i++) {
+    gint32 step = out[i] - out[i - 1];
+
+    fail_unless (step >= 970 && step <= 1030, "step of %d at sample %u",
+        step, i);
+  }
+
+  g_mutex_lock (&capture_lock);
+  capture_flushing = TRUE;
+  g_cond_broadcast (&capture_cond);
+  g_mutex_unlock (&capture_lock);
+
+  fail_unless_equals_int (gst_element_set_state (sink, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_pad_set_active (capture_srcpad, FALSE);
+  gst_check_teardown_src_pad (sink);
+  gst_object_unref (sink);
+  gst_object_unref (clock);
+  g_byte_array_free (capture_data, TRUE);
+}
+
+GST_START_TEST (test_slave_interpolate)
+{
+  /* master clock faster and slower than the sink */
+  check_interpolate_skew (101, 100);
+  check_interpolate_skew (99, 100);
+}
+
+GST_END_TEST;
+
 static Suite *
 audio_suite (void)
 {
@@ -604,6 +932,8 @@ audio_suite (void)
   tcase_add_test (tc_chain, test_buffer_clipping_samples);
   tcase_add_test (tc_chain, test_multichannel_checks);
   tcase_add_test (tc_chain, test_multichannel_reorder);
+  tcase_add_test (tc_chain, test_ring_buffer_commit);
+  tcase_add_test (tc_chain, test_slave_interpolate);
 
   return s;
 }
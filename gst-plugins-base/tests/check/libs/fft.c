@@ -32,6 +32,9 @@
 #include <gst/fft/gstfftf32.h>
 #include <gst/fft/gstfftf64.h>
 
+/* for comparing the AVX and the scalar butterflies of the same plan */
+#include "../../../gst-libs/gst/fft/kiss_fft_f32.c"
+
 GST_START_TEST (test_next_fast_length)
 {
   fail_unless_equals_int (gst_fft_next_fast_length (13), 16);
@@ -401,6 +404,104 @@ GST_START_TEST (test_f32_22050hz)
 
 GST_END_TEST;
 
+GST_START_TEST (test_f32_shared_plan)
+{
+  gint i;
+  gfloat *in1, *in2;
+  GstFFTF32Complex *out1, *out2, *ref;
+  GstFFTF32 *ctx1, *ctx2;
+
+  in1 = g_new (gfloat, 1536);
+  in2 = g_new (gfloat, 1536);
+  out1 = g_new (GstFFTF32Complex, 769);
+  out2 = g_new (GstFFTF32Complex, 769);
+  ref = g_new (GstFFTF32Complex, 769);
+
+  for (i = 0; i < 1536; i++) {
+    in1[i] = sin (2.0 * G_PI * i / 48.0);
+    in2[i] = cos (2.0 * G_PI * i / 20.0) + 0.25;
+  }
+
+  /* both instances share the twiddle factors but have their own scratch
+   * memory, so interleaving them must not make a difference */
+  ctx1 = gst_fft_f32_new (1536, FALSE);
+  ctx2 = gst_fft_f32_new (1536, FALSE);
+  gst_fft_f32_fft (ctx1, in1, out1);
+  gst_fft_f32_fft (ctx2, in2, out2);
+  gst_fft_f32_fft (ctx1, in1, ref);
+  fail_unless (memcmp (out1, ref, 769 * sizeof (GstFFTF32Complex)) == 0);
+
+  /* the plan stays valid as long as one instance uses it */
+  gst_fft_f32_free (ctx1);
+  gst_fft_f32_fft (ctx2, in2, ref);
+  fail_unless (memcmp (out2, ref, 769 * sizeof (GstFFTF32Complex)) == 0);
+  gst_fft_f32_free (ctx2);
+
+  /* and is recreated identically afterwards */
+  ctx1 = gst_fft_f32_new (1536, FALSE);
+  gst_fft_f32_fft (ctx1, in1, ref);
+  fail_unless (memcmp (out1, ref, 769 * sizeof (GstFFTF32Complex)) == 0);
+  gst_fft_f32_free (ctx1);
+
+  g_free (in1);
+  g_free (in2);
+  g_free (out1);
+  g_free (out2);
+  g_free (ref);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_f32_avx)
+{
+  /* radix-4 and radix-2 stages with and without a leftover of the four
+   * values per AVX register, mixed with other radices */
+  static const gint lengths[] = { 4096, 2048, 1536, 480, 40, 24 };
+  kiss_fft_f32_cpx *in, *out, *ref;
+  kiss_fft_f32_cfg cfg;
+  gint i, j, inverse;
+  GRand *rand = g_rand_new_with_seed (2013);
+
+  in = g_new (kiss_fft_f32_cpx, 4096);
+  out = g_new (kiss_fft_f32_cpx, 4096);
+  ref = g_new (kiss_fft_f32_cpx, 4096);
+
+  for (i = 0; i < 4096; i++) {
+    in[i].r = sin (2.0 * G_PI * i / 48.0) + g_rand_double_range (rand, -0.5,
+        0.5);
+    in[i].i = cos (2.0 * G_PI * i / 20.0) + g_rand_double_range (rand, -0.5,
+        0.5);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (lengths); i++) {
+    for (inverse = 0; inverse < 2; inverse++) {
+      cfg = kiss_fft_f32_alloc (lengths[i], inverse, NULL, NULL);
+      if (!cfg->use_avx)
+        GST_INFO ("no AVX support, comparing the scalar code with itself");
+
+      kiss_fft_f32 (cfg, in, out);
+      cfg->use_avx = 0;
+      kiss_fft_f32 (cfg, in, ref);
+
+      /* the AVX code does not use FMA and must be bit-exact */
+      for (j = 0; j < lengths[i]; j++) {
+        fail_unless (out[j].r == ref[j].r && out[j].i == ref[j].i,
+            "length %d, inverse %d: bin %d is (%f, %f) instead of (%f, %f)",
+            lengths[i], inverse, j, out[j].r, out[j].i, ref[j].r, ref[j].i);
+      }
+
+      g_free (cfg);
+    }
+  }
+
+  g_free (in);
+  g_free (out);
+  g_free (ref);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_f64_0hz)
 {
   gint i;
@@ -538,6 +639,8 @@ fft_suite (void)
   tcase_add_test (tc_chain, test_f32_0hz);
   tcase_add_test (tc_chain, test_f32_11025hz);
   tcase_add_test (tc_chain, test_f32_22050hz);
+  tcase_add_test (tc_chain, test_f32_shared_plan);
+  tcase_add_test (tc_chain, test_f32_avx);
   tcase_add_test (tc_chain, test_f64_0hz);
   tcase_add_test (tc_chain, test_f64_11025hz);
   tcase_add_test (tc_chain, test_f64_22050hz);
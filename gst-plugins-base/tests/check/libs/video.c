@@ -1656,6 +1656,128 @@ GST_START_TEST (test_overlay_composition_global_alpha)
 
 GST_END_TEST;
 
+#define N_SLICES 7
+
+static void
+count_slice (gpointer user_data, guint slice, guint n_slices)
+{
+  gint *counts = user_data;
+
+  fail_unless_equals_int (n_slices, N_SLICES);
+  g_atomic_int_inc (&counts[slice]);
+}
+
+/* blends a 16x8 white rectangle with the upper half transparent at @x, 2
+ * onto a 32x16 frame twice, the second time with the prepared pixels of the
+ * first */
+static void
+check_overlay_composition_blend (GstVideoFormat format, gint x)
+{
+  GstVideoOverlayComposition *comp;
+  GstVideoOverlayRectangle *rect;
+  GstVideoInfo info;
+  GstVideoFrame frame1, frame2;
+  GstBuffer *pix, *buf1, *buf2;
+  GstMapInfo map1, map2;
+  guint8 *ydata;
+  gint i, j, stride, pstride;
+
+  pix = gst_buffer_new_and_alloc (16 * sizeof (guint32) * 8);
+  gst_buffer_memset (pix, 0, 0x00, 16 * sizeof (guint32) * 4);
+  gst_buffer_memset (pix, 16 * sizeof (guint32) * 4, 0xff,
+      16 * sizeof (guint32) * 4);
+  gst_buffer_add_video_meta (pix, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 16, 8);
+  rect = gst_video_overlay_rectangle_new_raw (pix, x, 2, 16, 8,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  gst_buffer_unref (pix);
+  comp = gst_video_overlay_composition_new (rect);
+  gst_video_overlay_rectangle_unref (rect);
+
+  gst_video_info_init (&info);
+  gst_video_info_set_format (&info, format, 32, 16);
+  buf1 = gst_buffer_new_and_alloc (GST_VIDEO_INFO_SIZE (&info));
+  gst_buffer_memset (buf1, 0, 0x10, GST_VIDEO_INFO_SIZE (&info));
+  buf2 = gst_buffer_copy (buf1);
+
+  fail_unless (gst_video_frame_map (&frame1, &info, buf1, GST_MAP_READWRITE));
+  fail_unless (gst_video_overlay_composition_blend (comp, &frame1));
+  ydata = GST_VIDEO_FRAME_COMP_DATA (&frame1, 0);
+  stride = GST_VIDEO_FRAME_COMP_STRIDE (&frame1, 0);
+  pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (&frame1, 0);
+  for (i = 0; i < 16; i++) {
+    for (j = 0; j < 32; j++) {
+      if (i >= 6 && i < 10 && j >= x && j < x + 16)
+        fail_unless_equals_int (ydata[i * stride + j * pstride], 235);
+      else
+        fail_unless_equals_int (ydata[i * stride + j * pstride], 0x10);
+    }
+  }
+  gst_video_frame_unmap (&frame1);
+
+  fail_unless (gst_video_frame_map (&frame2, &info, buf2, GST_MAP_READWRITE));
+  fail_unless (gst_video_overlay_composition_blend (comp, &frame2));
+  gst_video_frame_unmap (&frame2);
+
+  gst_buffer_map (buf1, &map1, GST_MAP_READ);
+  gst_buffer_map (buf2, &map2, GST_MAP_READ);
+  fail_unless (memcmp (map1.data, map2.data, map1.size) == 0);
+  gst_buffer_unmap (buf2, &map2);
+  gst_buffer_unmap (buf1, &map1);
+
+  gst_buffer_unref (buf2);
+  gst_buffer_unref (buf1);
+  gst_video_overlay_composition_unref (comp);
+}
+
+GST_START_TEST (test_overlay_composition_blend)
+{
+  check_overlay_composition_blend (GST_VIDEO_FORMAT_I420, 4);
+  /* lines that are unpacked from the middle, also clipped on the right */
+  check_overlay_composition_blend (GST_VIDEO_FORMAT_I420, 12);
+  check_overlay_composition_blend (GST_VIDEO_FORMAT_I420, 21);
+  check_overlay_composition_blend (GST_VIDEO_FORMAT_YUY2, 12);
+  check_overlay_composition_blend (GST_VIDEO_FORMAT_NV12, 12);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_slices)
+{
+  GstVideoSliceRunner *runner;
+  GstVideoInfo info;
+  gint counts[N_SLICES] = { 0, };
+  guint i, y, height, next;
+
+  /* all slices are processed exactly once */
+  runner = gst_video_slice_runner_new (4);
+  fail_unless_equals_int (gst_video_slice_runner_get_n_threads (runner), 4);
+  gst_video_slice_runner_run (runner, N_SLICES, count_slice, counts);
+  for (i = 0; i < N_SLICES; i++)
+    fail_unless_equals_int (counts[i], 1);
+  gst_video_slice_runner_free (runner);
+
+  /* the bands cover the frame and are aligned to the chroma lines */
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 320, 241);
+  next = 0;
+  for (i = 0; i < N_SLICES; i++) {
+    gst_video_slice_get_lines (&info, i, N_SLICES, &y, &height);
+    fail_unless_equals_int (y, next);
+    fail_unless (y % 2 == 0);
+    next = y + height;
+  }
+  fail_unless_equals_int (next, 241);
+
+  /* more slices than lines gives empty bands */
+  gst_video_info_set_format (&info, GST_VIDEO_FORMAT_I420, 16, 4);
+  gst_video_slice_get_lines (&info, N_SLICES - 1, N_SLICES, &y, &height);
+  fail_unless_equals_int (y + height, 4);
+  gst_video_slice_get_lines (&info, 0, N_SLICES, &y, &height);
+  fail_unless_equals_int (height, 0);
+}
+
+GST_END_TEST;
+
 static Suite *
 video_suite (void)
 {
@@ -1676,6 +1798,8 @@ video_suite (void)
   tcase_add_test (tc_chain, test_overlay_composition);
   tcase_add_test (tc_chain, test_overlay_composition_premultiplied_alpha);
   tcase_add_test (tc_chain, test_overlay_composition_global_alpha);
+  tcase_add_test (tc_chain, test_overlay_composition_blend);
+  tcase_add_test (tc_chain, test_video_slices);
 
   return s;
 }
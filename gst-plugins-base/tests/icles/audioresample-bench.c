@@ -0,0 +1,158 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of audioresample for the common sample formats
+ * and channel counts when converting 48kHz to 44.1kHz. The time spent in
+ * audiotestsrc is measured separately and subtracted.
+ *
+ * usage: audioresample-bench [seconds [FORMAT:CHANNELS...]]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gst/gst.h>
+
+#define DEFAULT_SECONDS 60
+#define IN_RATE 48000
+#define OUT_RATE 44100
+#define SAMPLES_PER_BUFFER 4800
+
+static const gchar *default_configs[] = {
+  "S16LE:1",
+  "S16LE:2",
+  "S16LE:8",
+  "F32LE:1",
+  "F32LE:2",
+  "F32LE:8",
+  "F64LE:2",
+};
+
+static GstClockTime
+run_pipeline (const gchar * desc)
+{
+  GstElement *pipeline;
+  GstClockTime start, stop;
+  GstMessage *msg;
+  GstBus *bus;
+  GError *err = NULL;
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (pipeline == NULL) {
+    g_print ("could not create pipeline: %s\n", err->message);
+    exit (-1);
+  }
+
+  /* preroll first so that negotiation is not measured */
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  gst_element_get_state (pipeline, NULL, NULL, GST_CLOCK_TIME_NONE);
+
+  start = gst_util_get_timestamp ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  stop = gst_util_get_timestamp ();
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &err, NULL);
+    g_print ("error running '%s': %s\n", desc, err->message);
+    exit (-1);
+  }
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return stop - start;
+}
+
+static void
+run_benchmark (const gchar * config, gint seconds)
+{
+  gchar **fields, *desc;
+  GstClockTime src_time, total_time, time;
+  gint channels, buffers;
+
+  fields = g_strsplit (config, ":", 2);
+  if (fields[0] == NULL || fields[1] == NULL || atoi (fields[1]) <= 0) {
+    g_print ("invalid config '%s', use FORMAT:CHANNELS\n", config);
+    g_strfreev (fields);
+    return;
+  }
+  channels = atoi (fields[1]);
+  buffers = seconds * IN_RATE / SAMPLES_PER_BUFFER;
+
+  desc = g_strdup_printf ("audiotestsrc num-buffers=%d samplesperbuffer=%d "
+      "wave=white-noise ! audio/x-raw,format=%s,rate=%d,channels=%d ! "
+      "fakesink sync=false", buffers, SAMPLES_PER_BUFFER, fields[0], IN_RATE,
+      channels);
+  src_time = run_pipeline (desc);
+  g_free (desc);
+
+  desc = g_strdup_printf ("audiotestsrc num-buffers=%d samplesperbuffer=%d "
+      "wave=white-noise ! audio/x-raw,format=%s,rate=%d,channels=%d ! "
+      "audioresample ! audio/x-raw,rate=%d ! fakesink sync=false",
+      buffers, SAMPLES_PER_BUFFER, fields[0], IN_RATE, channels, OUT_RATE);
+  total_time = run_pipeline (desc);
+  g_free (desc);
+
+  time = total_time > src_time ? total_time - src_time : 1;
+
+  g_print ("%-5s %d channels: %" GST_TIME_FORMAT ", %8.1fx realtime, "
+      "%7.1f Msamples/s\n", fields[0], channels, GST_TIME_ARGS (time),
+      (gdouble) seconds * GST_SECOND / time,
+      (gdouble) buffers * SAMPLES_PER_BUFFER * channels * 1000 / time);
+
+  g_strfreev (fields);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  gint seconds, i;
+
+  gst_init (&argc, &argv);
+
+  seconds = DEFAULT_SECONDS;
+  if (argc > 1)
+    seconds = atoi (argv[1]);
+
+  if (seconds <= 0) {
+    g_print ("usage: %s [seconds [FORMAT:CHANNELS...]]\n", argv[0]);
+    exit (-1);
+  }
+
+  g_print ("%d Hz -> %d Hz, %d seconds\n", IN_RATE, OUT_RATE, seconds);
+
+  if (argc > 2) {
+    for (i = 2; i < argc; i++)
+      run_benchmark (argv[i], seconds);
+  } else {
+    for (i = 0; i < (gint) G_N_ELEMENTS (default_configs); i++)
+      run_benchmark (default_configs[i], seconds);
+  }
+
+  return 0;
+}
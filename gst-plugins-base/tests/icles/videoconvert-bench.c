@@ -0,0 +1,162 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the throughput of videoconvert for the common format pairs. The
+ * time spent in videotestsrc is measured separately and subtracted.
+ *
+ * usage: videoconvert-bench [width height [frames [IN:OUT...]]]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gst/gst.h>
+
+#define DEFAULT_WIDTH 1920
+#define DEFAULT_HEIGHT 1080
+#define DEFAULT_FRAMES 200
+
+static const gchar *default_pairs[] = {
+  "YUY2:I420",
+  "UYVY:I420",
+  "NV12:I420",
+  "NV21:I420",
+  "I420:NV12",
+  "YUY2:NV12",
+  "UYVY:NV12",
+  "I420:BGRx",
+  "I420:BGRA",
+  "AYUV:ARGB",
+};
+
+static GstClockTime
+run_pipeline (const gchar * desc)
+{
+  GstElement *pipeline;
+  GstClockTime start, stop;
+  GstMessage *msg;
+  GstBus *bus;
+  GError *err = NULL;
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (pipeline == NULL) {
+    g_print ("could not create pipeline: %s\n", err->message);
+    exit (-1);
+  }
+
+  /* preroll first so that negotiation is not measured */
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  gst_element_get_state (pipeline, NULL, NULL, GST_CLOCK_TIME_NONE);
+
+  start = gst_util_get_timestamp ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  stop = gst_util_get_timestamp ();
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &err, NULL);
+    g_print ("error running '%s': %s\n", desc, err->message);
+    exit (-1);
+  }
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return stop - start;
+}
+
+static void
+run_benchmark (const gchar * pair, gint width, gint height, gint frames)
+{
+  gchar **formats, *desc;
+  GstClockTime src_time, total_time, time;
+
+  formats = g_strsplit (pair, ":", 2);
+  if (formats[0] == NULL || formats[1] == NULL) {
+    g_print ("invalid format pair '%s', use IN:OUT\n", pair);
+    g_strfreev (formats);
+    return;
+  }
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d ! "
+      "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+      "fakesink sync=false", frames, formats[0], width, height);
+  src_time = run_pipeline (desc);
+  g_free (desc);
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d ! "
+      "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+      "videoconvert ! video/x-raw,format=%s ! fakesink sync=false",
+      frames, formats[0], width, height, formats[1]);
+  total_time = run_pipeline (desc);
+  g_free (desc);
+
+  time = total_time > src_time ? total_time - src_time : 1;
+
+  g_print ("%-4s -> %-4s %" GST_TIME_FORMAT " per frame, %8.1f frames/s, "
+      "%7.1f Mpixels/s\n", formats[0], formats[1],
+      GST_TIME_ARGS (time / frames), (gdouble) frames * GST_SECOND / time,
+      (gdouble) width * height * frames * 1000 / time);
+
+  g_strfreev (formats);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  gint width, height, frames, i;
+
+  gst_init (&argc, &argv);
+
+  width = DEFAULT_WIDTH;
+  height = DEFAULT_HEIGHT;
+  frames = DEFAULT_FRAMES;
+
+  if (argc > 2) {
+    width = atoi (argv[1]);
+    height = atoi (argv[2]);
+  }
+  if (argc > 3)
+    frames = atoi (argv[3]);
+
+  if (width <= 0 || height <= 0 || frames <= 0) {
+    g_print ("usage: %s [width height [frames [IN:OUT...]]]\n", argv[0]);
+    exit (-1);
+  }
+
+  g_print ("%dx%d, %d frames\n", width, height, frames);
+
+  if (argc > 4) {
+    for (i = 4; i < argc; i++)
+      run_benchmark (argv[i], width, height, frames);
+  } else {
+    for (i = 0; i < (gint) G_N_ELEMENTS (default_pairs); i++)
+      run_benchmark (default_pairs[i], width, height, frames);
+  }
+
+  return 0;
+}
@@ -0,0 +1,322 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Compares the videoscale methods.  For every format and method the
+ * throughput of scaling down to 2/3 of the size is measured, with the time
+ * spent in videotestsrc subtracted.  The quality is measured as the PSNR of
+ * a zone plate that is scaled down and back up again with the same method,
+ * compared to the original.
+ *
+ * usage: videoscale-bench [width height [frames [FORMAT...]]]
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define DEFAULT_WIDTH 1920
+#define DEFAULT_HEIGHT 1080
+#define DEFAULT_FRAMES 100
+
+#define TEST_PATTERN "pattern=zone-plate kx2=20 ky2=20 kt=1"
+
+static const gchar *default_formats[] = {
+  "I420",
+  "NV12",
+  "YUY2",
+  "UYVY",
+  "AYUV",
+  "BGRx",
+  "RGB",
+  "GRAY8",
+};
+
+static const gchar *methods[] = {
+  "nearest-neighbour",
+  "bilinear",
+  "4-tap",
+  "lanczos",
+};
+
+static GstClockTime
+run_pipeline (const gchar * desc)
+{
+  GstElement *pipeline;
+  GstClockTime start, stop;
+  GstMessage *msg;
+  GstBus *bus;
+  GError *err = NULL;
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (pipeline == NULL) {
+    g_print ("could not create pipeline: %s\n", err->message);
+    exit (-1);
+  }
+
+  /* preroll first so that negotiation is not measured */
+  gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  gst_element_get_state (pipeline, NULL, NULL, GST_CLOCK_TIME_NONE);
+
+  start = gst_util_get_timestamp ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  stop = gst_util_get_timestamp ();
+
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &err, NULL);
+    g_print ("error running '%s': %s\n", desc, err->message);
+    exit (-1);
+  }
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return stop - start;
+}
+
+static void
+handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  g_object_set_data_full (G_OBJECT (sink), "last-buffer",
+      gst_buffer_ref (buffer), (GDestroyNotify) gst_buffer_unref);
+}
+
+/* runs a pipeline with a fakesink named sink and returns the last buffer
+ * and its caps */
+static GstBuffer *
+grab_frame (const gchar * desc, GstCaps ** caps)
+{
+  GstElement *pipeline, *sink;
+  GstBuffer *buffer;
+  GstMessage *msg;
+  GstBus *bus;
+  GstPad *pad;
+  GError *err = NULL;
+
+  pipeline = gst_parse_launch (desc, &err);
+  if (pipeline == NULL) {
+    g_print ("could not create pipeline: %s\n", err->message);
+    exit (-1);
+  }
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (handoff_cb), NULL);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    gst_message_parse_error (msg, &err, NULL);
+    g_print ("error running '%s': %s\n", desc, err->message);
+    exit (-1);
+  }
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  pad = gst_element_get_static_pad (sink, "sink");
+  *caps = gst_pad_get_current_caps (pad);
+  gst_object_unref (pad);
+
+  buffer = g_object_get_data (G_OBJECT (sink), "last-buffer");
+  if (buffer)
+    gst_buffer_ref (buffer);
+  gst_object_unref (sink);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  return buffer;
+}
+
+/* PSNR over all components of two frames with 8 bit components */
+static gdouble
+compute_psnr (GstBuffer * ref, GstBuffer * buf, GstCaps * caps)
+{
+  GstVideoInfo info;
+  GstVideoFrame ref_frame, frame;
+  gdouble sum = 0.0;
+  guint64 count = 0;
+  gint c, x, y;
+
+  if (!gst_video_info_from_caps (&info, caps))
+    return 0.0;
+
+  if (!gst_video_frame_map (&ref_frame, &info, ref, GST_MAP_READ))
+    return 0.0;
+  if (!gst_video_frame_map (&frame, &info, buf, GST_MAP_READ)) {
+    gst_video_frame_unmap (&ref_frame);
+    return 0.0;
+  }
+
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (&frame); c++) {
+    const guint8 *r, *d;
+    gint pstride, stride, width, height;
+
+    if (GST_VIDEO_FRAME_COMP_DEPTH (&frame, c) != 8)
+      continue;
+
+    width = GST_VIDEO_FRAME_COMP_WIDTH (&frame, c);
+    height = GST_VIDEO_FRAME_COMP_HEIGHT (&frame, c);
+    pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (&frame, c);
+    stride = GST_VIDEO_FRAME_COMP_STRIDE (&frame, c);
+
+    for (y = 0; y < height; y++) {
+      r = (const guint8 *) GST_VIDEO_FRAME_COMP_DATA (&ref_frame, c) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&ref_frame, c);
+      d = (const guint8 *) GST_VIDEO_FRAME_COMP_DATA (&frame, c) + y * stride;
+      for (x = 0; x < width; x++) {
+        gint diff = r[x * pstride] - d[x * pstride];
+
+        sum += diff * diff;
+      }
+      count += width;
+    }
+  }
+
+  gst_video_frame_unmap (&frame);
+  gst_video_frame_unmap (&ref_frame);
+
+  if (count == 0)
+    return 0.0;
+  if (sum == 0.0)
+    return 99.0;
+
+  return 10.0 * log10 (255.0 * 255.0 * count / sum);
+}
+
+static void
+run_benchmark (const gchar * format, gint width, gint height, gint frames)
+{
+  GstClockTime src_time, total_time, time;
+  GstBuffer *ref;
+  GstCaps *caps;
+  gchar *desc;
+  gint small_w, small_h;
+  guint i;
+
+  small_w = GST_ROUND_UP_2 (width * 2 / 3);
+  small_h = GST_ROUND_UP_2 (height * 2 / 3);
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=%d ! "
+      "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+      "fakesink sync=false", frames, format, width, height);
+  src_time = run_pipeline (desc);
+  g_free (desc);
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=1 " TEST_PATTERN " ! "
+      "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+      "fakesink name=sink", format, width, height);
+  ref = grab_frame (desc, &caps);
+  g_free (desc);
+
+  for (i = 0; i < G_N_ELEMENTS (methods); i++) {
+    GstBuffer *buf;
+    GstCaps *out_caps;
+    gdouble psnr = 0.0;
+
+    desc = g_strdup_printf ("videotestsrc num-buffers=%d ! "
+        "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+        "videoscale method=%s ! video/x-raw,width=%d,height=%d ! "
+        "fakesink sync=false", frames, format, width, height, methods[i],
+        small_w, small_h);
+    total_time = run_pipeline (desc);
+    g_free (desc);
+
+    desc = g_strdup_printf ("videotestsrc num-buffers=1 " TEST_PATTERN " ! "
+        "video/x-raw,format=%s,width=%d,height=%d,framerate=0/1 ! "
+        "videoscale method=%s ! video/x-raw,width=%d,height=%d ! "
+        "videoscale method=%s ! video/x-raw,width=%d,height=%d ! "
+        "fakesink name=sink", format, width, height, methods[i], small_w,
+        small_h, methods[i], width, height);
+    buf = grab_frame (desc, &out_caps);
+    g_free (desc);
+
+    if (ref && buf && caps)
+      psnr = compute_psnr (ref, buf, caps);
+
+    time = total_time > src_time ? total_time - src_time : 1;
+
+    g_print ("%-5s %-17s %" GST_TIME_FORMAT " per frame, %8.1f frames/s, "
+        "%7.1f Mpixels/s, PSNR %5.2f dB\n", format, methods[i],
+        GST_TIME_ARGS (time / frames), (gdouble) frames * GST_SECOND / time,
+        (gdouble) width * height * frames * 1000 / time, psnr);
+
+    if (buf)
+      gst_buffer_unref (buf);
+    if (out_caps)
+      gst_caps_unref (out_caps);
+  }
+
+  if (ref)
+    gst_buffer_unref (ref);
+  if (caps)
+    gst_caps_unref (caps);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  gint width, height, frames, i;
+
+  gst_init (&argc, &argv);
+
+  width = DEFAULT_WIDTH;
+  height = DEFAULT_HEIGHT;
+  frames = DEFAULT_FRAMES;
+
+  if (argc > 2) {
+    width = atoi (argv[1]);
+    height = atoi (argv[2]);
+  }
+  if (argc > 3)
+    frames = atoi (argv[3]);
+
+  if (width <= 0 || height <= 0 || frames <= 0) {
+    g_print ("usage: %s [width height [frames [FORMAT...]]]\n", argv[0]);
+    exit (-1);
+  }
+
+  g_print ("%dx%d -> %dx%d, %d frames\n", width, height,
+      GST_ROUND_UP_2 (width * 2 / 3), GST_ROUND_UP_2 (height * 2 / 3), frames);
+
+  if (argc > 4) {
+    for (i = 4; i < argc; i++)
+      run_benchmark (argv[i], width, height, frames);
+  } else {
+    for (i = 0; i < (gint) G_N_ELEMENTS (default_formats); i++)
+      run_benchmark (default_formats[i], width, height, frames);
+  }
+
+  return 0;
+}
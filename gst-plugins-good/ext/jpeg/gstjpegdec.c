@@ -105,9 +105,13 @@ static GstFlowReturn gst_jpeg_dec_parse (GstVideoDecoder * bdec,
     GstVideoCodecFrame * frame, GstAdapter * adapter, gboolean at_eos);
 static GstFlowReturn gst_jpeg_dec_handle_frame (GstVideoDecoder * bdec,
     GstVideoCodecFrame * frame);
+static GstFlowReturn gst_jpeg_dec_decode_frame (GstVideoDecoder * bdec,
+    GstVideoCodecFrame * frame);
 static gboolean gst_jpeg_dec_decide_allocation (GstVideoDecoder * bdec,
     GstQuery * query);
 
+static void gst_jpeg_dec_free_contexts (GstJpegDec * dec);
+
 #define gst_jpeg_dec_parent_class parent_class
 G_DEFINE_TYPE (GstJpegDec, gst_jpeg_dec, GST_TYPE_VIDEO_DECODER);
 
@@ -116,7 +120,8 @@ gst_jpeg_dec_finalize (GObject * object)
 {
   GstJpegDec *dec = GST_JPEG_DEC (object);
 
-  jpeg_destroy_decompress (&dec->cinfo);
+  gst_jpeg_dec_free_contexts (dec);
+  g_mutex_clear (&dec->lock);
   if (dec->input_state)
     gst_video_codec_state_unref (dec->input_state);
 
@@ -175,6 +180,7 @@ gst_jpeg_dec_class_init (GstJpegDecClass * klass)
   vdec_class->parse = gst_jpeg_dec_parse;
   vdec_class->set_format = gst_jpeg_dec_set_format;
   vdec_class->handle_frame = gst_jpeg_dec_handle_frame;
+  vdec_class->decode_frame = gst_jpeg_dec_decode_frame;
   vdec_class->decide_allocation = gst_jpeg_dec_decide_allocation;
 
   GST_DEBUG_CATEGORY_INIT (jpeg_dec_debug, "jpegdec", 0, "JPEG decoder");
@@ -182,51 +188,57 @@ gst_jpeg_dec_class_init (GstJpegDecClass * klass)
 }
 
 static void
-gst_jpeg_dec_clear_error (GstJpegDec * dec)
+gst_jpeg_dec_clear_error (GstJpegDecContext * ctx)
 {
-  g_free (dec->error_msg);
-  dec->error_msg = NULL;
-  dec->error_line = 0;
-  dec->error_func = NULL;
+  g_free (ctx->error_msg);
+  ctx->error_msg = NULL;
+  ctx->error_line = 0;
+  ctx->error_func = NULL;
 }
 
 static void
-gst_jpeg_dec_set_error_va (GstJpegDec * dec, const gchar * func, gint line,
-    const gchar * debug_msg_format, va_list args)
+gst_jpeg_dec_set_error_va (GstJpegDec * dec, GstJpegDecContext * ctx,
+    const gchar * func, gint line, const gchar * debug_msg_format,
+    va_list args)
 {
 #ifndef GST_DISABLE_GST_DEBUG
+  va_list args2;
+
+  G_VA_COPY (args2, args);
   gst_debug_log_valist (GST_CAT_DEFAULT, GST_LEVEL_WARNING, __FILE__, func,
-      line, (GObject *) dec, debug_msg_format, args);
+      line, (GObject *) dec, debug_msg_format, args2);
+  va_end (args2);
 #endif
 
-  g_free (dec->error_msg);
+  g_free (ctx->error_msg);
   if (debug_msg_format)
-    dec->error_msg = g_strdup_vprintf (debug_msg_format, args);
+    ctx->error_msg = g_strdup_vprintf (debug_msg_format, args);
   else
-    dec->error_msg = NULL;
+    ctx->error_msg = NULL;
 
-  dec->error_line = line;
-  dec->error_func = func;
+  ctx->error_line = line;
+  ctx->error_func = func;
 }
 
 static void
-gst_jpeg_dec_set_error (GstJpegDec * dec, const gchar * func, gint line,
-    const gchar * debug_msg_format, ...)
+gst_jpeg_dec_set_error (GstJpegDec * dec, GstJpegDecContext * ctx,
+    const gchar * func, gint line, const gchar * debug_msg_format, ...)
 {
   va_list va;
 
   va_start (va, debug_msg_format);
-  gst_jpeg_dec_set_error_va (dec, func, line, debug_msg_format, va);
+  gst_jpeg_dec_set_error_va (dec, ctx, func, line, debug_msg_format, va);
   va_end (va);
 }
 
+/* posts the error set on @ctx, can be called from any thread */
 static GstFlowReturn
-gst_jpeg_dec_post_error_or_warning (GstJpegDec * dec)
+gst_jpeg_dec_post_error_or_warning (GstJpegDec * dec, GstJpegDecContext * ctx)
 {
   GstFlowReturn ret;
-  int max_errors;
+  int max_errors, error_count;
 
-  ++dec->error_count;
+  error_count = g_atomic_int_add (&dec->error_count, 1) + 1;
   max_errors = g_atomic_int_get (&dec->max_errors);
 
   if (max_errors < 0) {
@@ -234,40 +246,38 @@ gst_jpeg_dec_post_error_or_warning (GstJpegDec * dec)
   } else if (max_errors == 0) {
     /* FIXME: do something more clever in "automatic mode" */
     if (gst_video_decoder_get_packetized (GST_VIDEO_DECODER (dec))) {
-      ret = (dec->error_count < 3) ? GST_FLOW_OK : GST_FLOW_ERROR;
+      ret = (error_count < 3) ? GST_FLOW_OK : GST_FLOW_ERROR;
     } else {
       ret = GST_FLOW_ERROR;
     }
   } else {
-    ret = (dec->error_count < max_errors) ? GST_FLOW_OK : GST_FLOW_ERROR;
+    ret = (error_count < max_errors) ? GST_FLOW_OK : GST_FLOW_ERROR;
   }
 
-  GST_INFO_OBJECT (dec, "decoding error %d/%d (%s)", dec->error_count,
+  GST_INFO_OBJECT (dec, "decoding error %d/%d (%s)", error_count,
       max_errors, (ret == GST_FLOW_OK) ? "ignoring error" : "erroring out");
 
   gst_element_message_full (GST_ELEMENT (dec),
       (ret == GST_FLOW_OK) ? GST_MESSAGE_WARNING : GST_MESSAGE_ERROR,
       GST_STREAM_ERROR, GST_STREAM_ERROR_DECODE,
-      g_strdup (_("Failed to decode JPEG image")), dec->error_msg,
-      __FILE__, dec->error_func, dec->error_line);
+      g_strdup (_("Failed to decode JPEG image")), ctx->error_msg,
+      __FILE__, ctx->error_func, ctx->error_line);
 
-  dec->error_msg = NULL;
-  gst_jpeg_dec_clear_error (dec);
+  ctx->error_msg = NULL;
+  gst_jpeg_dec_clear_error (ctx);
   return ret;
 }
 
 static boolean
 gst_jpeg_dec_fill_input_buffer (j_decompress_ptr cinfo)
 {
-  GstJpegDec *dec;
+  struct GstJpegDecSourceMgr *src = (struct GstJpegDecSourceMgr *) cinfo->src;
 
-  dec = CINFO_GET_JPEGDEC (cinfo);
-  g_return_val_if_fail (dec != NULL, FALSE);
-  g_return_val_if_fail (dec->current_frame != NULL, FALSE);
-  g_return_val_if_fail (dec->current_frame_map.data != NULL, FALSE);
+  g_return_val_if_fail (src->dec != NULL, FALSE);
+  g_return_val_if_fail (src->data != NULL, FALSE);
 
-  cinfo->src->next_input_byte = dec->current_frame_map.data;
-  cinfo->src->bytes_in_buffer = dec->current_frame_map.size;
+  cinfo->src->next_input_byte = src->data;
+  cinfo->src->bytes_in_buffer = src->size;
 
   return TRUE;
 }
@@ -328,28 +338,88 @@ METHODDEF (void)
   longjmp (err_mgr->setjmp_buffer, 1);
 }
 
+static void gst_jpeg_dec_free_buffers (GstJpegDecContext * ctx);
+
+static GstJpegDecContext *
+gst_jpeg_dec_context_new (GstJpegDec * dec)
+{
+  GstJpegDecContext *ctx;
+
+  ctx = g_slice_new0 (GstJpegDecContext);
+
+  /* setup jpeglib */
+  ctx->cinfo.err = jpeg_std_error (&ctx->jerr.pub);
+  ctx->jerr.pub.output_message = gst_jpeg_dec_my_output_message;
+  ctx->jerr.pub.emit_message = gst_jpeg_dec_my_emit_message;
+  ctx->jerr.pub.error_exit = gst_jpeg_dec_my_error_exit;
+
+  jpeg_create_decompress (&ctx->cinfo);
+
+  ctx->cinfo.src = (struct jpeg_source_mgr *) &ctx->jsrc;
+  ctx->cinfo.src->init_source = gst_jpeg_dec_init_source;
+  ctx->cinfo.src->fill_input_buffer = gst_jpeg_dec_fill_input_buffer;
+  ctx->cinfo.src->skip_input_data = gst_jpeg_dec_skip_input_data;
+  ctx->cinfo.src->resync_to_restart = gst_jpeg_dec_resync_to_restart;
+  ctx->cinfo.src->term_source = gst_jpeg_dec_term_source;
+  ctx->jsrc.dec = dec;
+
+  return ctx;
+}
+
+static void
+gst_jpeg_dec_context_free (GstJpegDecContext * ctx)
+{
+  jpeg_destroy_decompress (&ctx->cinfo);
+  gst_jpeg_dec_free_buffers (ctx);
+  gst_jpeg_dec_clear_error (ctx);
+
+  g_slice_free (GstJpegDecContext, ctx);
+}
+
+/* takes an unused context or creates a new one when all are in use */
+static GstJpegDecContext *
+gst_jpeg_dec_get_context (GstJpegDec * dec)
+{
+  GstJpegDecContext *ctx = NULL;
+
+  g_mutex_lock (&dec->lock);
+  if (dec->contexts) {
+    ctx = dec->contexts->data;
+    dec->contexts = g_slist_delete_link (dec->contexts, dec->contexts);
+  }
+  g_mutex_unlock (&dec->lock);
+
+  if (ctx == NULL) {
+    GST_DEBUG_OBJECT (dec, "creating new decoding context");
+    ctx = gst_jpeg_dec_context_new (dec);
+  }
+
+  return ctx;
+}
+
+static void
+gst_jpeg_dec_release_context (GstJpegDec * dec, GstJpegDecContext * ctx)
+{
+  g_mutex_lock (&dec->lock);
+  dec->contexts = g_slist_prepend (dec->contexts, ctx);
+  g_mutex_unlock (&dec->lock);
+}
+
+static void
+gst_jpeg_dec_free_contexts (GstJpegDec * dec)
+{
+  g_mutex_lock (&dec->lock);
+  g_slist_free_full (dec->contexts, (GDestroyNotify) gst_jpeg_dec_context_free);
+  dec->contexts = NULL;
+  g_mutex_unlock (&dec->lock);
+}
+
 static void
 gst_jpeg_dec_init (GstJpegDec * dec)
 {
   GST_DEBUG ("initializing");
 
-  /* setup jpeglib */
-  memset (&dec->cinfo, 0, sizeof (dec->cinfo));
-  memset (&dec->jerr, 0, sizeof (dec->jerr));
-  dec->cinfo.err = jpeg_std_error (&dec->jerr.pub);
-  dec->jerr.pub.output_message = gst_jpeg_dec_my_output_message;
-  dec->jerr.pub.emit_message = gst_jpeg_dec_my_emit_message;
-  dec->jerr.pub.error_exit = gst_jpeg_dec_my_error_exit;
-
-  jpeg_create_decompress (&dec->cinfo);
-
-  dec->cinfo.src = (struct jpeg_source_mgr *) &dec->jsrc;
-  dec->cinfo.src->init_source = gst_jpeg_dec_init_source;
-  dec->cinfo.src->fill_input_buffer = gst_jpeg_dec_fill_input_buffer;
-  dec->cinfo.src->skip_input_data = gst_jpeg_dec_skip_input_data;
-  dec->cinfo.src->resync_to_restart = gst_jpeg_dec_resync_to_restart;
-  dec->cinfo.src->term_source = gst_jpeg_dec_term_source;
-  dec->jsrc.dec = dec;
+  g_mutex_init (&dec->lock);
 
   /* init properties */
   dec->idct_method = JPEG_DEFAULT_IDCT_METHOD;
@@ -703,49 +773,51 @@ hresamplecpy1 (guint8 * dest, const guint8 * src, guint len)
 }
 
 static void
-gst_jpeg_dec_free_buffers (GstJpegDec * dec)
+gst_jpeg_dec_free_buffers (GstJpegDecContext * ctx)
 {
   gint i;
 
   for (i = 0; i < 16; i++) {
-    g_free (dec->idr_y[i]);
-    g_free (dec->idr_u[i]);
-    g_free (dec->idr_v[i]);
-    dec->idr_y[i] = NULL;
-    dec->idr_u[i] = NULL;
-    dec->idr_v[i] = NULL;
+    g_free (ctx->idr_y[i]);
+    g_free (ctx->idr_u[i]);
+    g_free (ctx->idr_v[i]);
+    ctx->idr_y[i] = NULL;
+    ctx->idr_u[i] = NULL;
+    ctx->idr_v[i] = NULL;
   }
 
-  dec->idr_width_allocated = 0;
+  ctx->idr_width_allocated = 0;
 }
 
 static inline gboolean
-gst_jpeg_dec_ensure_buffers (GstJpegDec * dec, guint maxrowbytes)
+gst_jpeg_dec_ensure_buffers (GstJpegDec * dec, GstJpegDecContext * ctx,
+    guint maxrowbytes)
 {
   gint i;
 
-  if (G_LIKELY (dec->idr_width_allocated == maxrowbytes))
+  if (G_LIKELY (ctx->idr_width_allocated == maxrowbytes))
     return TRUE;
 
   /* FIXME: maybe just alloc one or three blocks altogether? */
   for (i = 0; i < 16; i++) {
-    dec->idr_y[i] = g_try_realloc (dec->idr_y[i], maxrowbytes);
-    dec->idr_u[i] = g_try_realloc (dec->idr_u[i], maxrowbytes);
-    dec->idr_v[i] = g_try_realloc (dec->idr_v[i], maxrowbytes);
+    ctx->idr_y[i] = g_try_realloc (ctx->idr_y[i], maxrowbytes);
+    ctx->idr_u[i] = g_try_realloc (ctx->idr_u[i], maxrowbytes);
+    ctx->idr_v[i] = g_try_realloc (ctx->idr_v[i], maxrowbytes);
 
-    if (G_UNLIKELY (!dec->idr_y[i] || !dec->idr_u[i] || !dec->idr_v[i])) {
+    if (G_UNLIKELY (!ctx->idr_y[i] || !ctx->idr_u[i] || !ctx->idr_v[i])) {
       GST_WARNING_OBJECT (dec, "out of memory, i=%d, bytes=%u", i, maxrowbytes);
       return FALSE;
     }
   }
 
-  dec->idr_width_allocated = maxrowbytes;
+  ctx->idr_width_allocated = maxrowbytes;
   GST_LOG_OBJECT (dec, "allocated temp memory, %u bytes/row", maxrowbytes);
   return TRUE;
 }
 
 static void
-gst_jpeg_dec_decode_grayscale (GstJpegDec * dec, GstVideoFrame * frame)
+gst_jpeg_dec_decode_grayscale (GstJpegDec * dec, GstJpegDecContext * ctx,
+    GstVideoFrame * frame)
 {
   guchar *rows[16];
   guchar **scanarray[1] = { rows };
@@ -760,18 +832,19 @@ gst_jpeg_dec_decode_grayscale (GstJpegDec * dec, GstVideoFrame * frame)
   width = GST_VIDEO_FRAME_WIDTH (frame);
   height = GST_VIDEO_FRAME_HEIGHT (frame);
 
-  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, GST_ROUND_UP_32 (width))))
+  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, ctx,
+              GST_ROUND_UP_32 (width))))
     return;
 
   base[0] = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
   pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0);
   rstride = GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
 
-  memcpy (rows, dec->idr_y, 16 * sizeof (gpointer));
+  memcpy (rows, ctx->idr_y, 16 * sizeof (gpointer));
 
   i = 0;
   while (i < height) {
-    lines = jpeg_read_raw_data (&dec->cinfo, scanarray, DCTSIZE);
+    lines = jpeg_read_raw_data (&ctx->cinfo, scanarray, DCTSIZE);
     if (G_LIKELY (lines > 0)) {
       for (j = 0; (j < DCTSIZE) && (i < height); j++, i++) {
         gint p;
@@ -790,7 +863,8 @@ gst_jpeg_dec_decode_grayscale (GstJpegDec * dec, GstVideoFrame * frame)
 }
 
 static void
-gst_jpeg_dec_decode_rgb (GstJpegDec * dec, GstVideoFrame * frame)
+gst_jpeg_dec_decode_rgb (GstJpegDec * dec, GstJpegDecContext * ctx,
+    GstVideoFrame * frame)
 {
   guchar *r_rows[16], *g_rows[16], *b_rows[16];
   guchar **scanarray[3] = { r_rows, g_rows, b_rows };
@@ -805,7 +879,8 @@ gst_jpeg_dec_decode_rgb (GstJpegDec * dec, GstVideoFrame * frame)
   width = GST_VIDEO_FRAME_WIDTH (frame);
   height = GST_VIDEO_FRAME_HEIGHT (frame);
 
-  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, GST_ROUND_UP_32 (width))))
+  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, ctx,
+              GST_ROUND_UP_32 (width))))
     return;
 
   for (i = 0; i < 3; i++)
@@ -814,13 +889,13 @@ gst_jpeg_dec_decode_rgb (GstJpegDec * dec, GstVideoFrame * frame)
   pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0);
   rstride = GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
 
-  memcpy (r_rows, dec->idr_y, 16 * sizeof (gpointer));
-  memcpy (g_rows, dec->idr_u, 16 * sizeof (gpointer));
-  memcpy (b_rows, dec->idr_v, 16 * sizeof (gpointer));
+  memcpy (r_rows, ctx->idr_y, 16 * sizeof (gpointer));
+  memcpy (g_rows, ctx->idr_u, 16 * sizeof (gpointer));
+  memcpy (b_rows, ctx->idr_v, 16 * sizeof (gpointer));
 
   i = 0;
   while (i < height) {
-    lines = jpeg_read_raw_data (&dec->cinfo, scanarray, DCTSIZE);
+    lines = jpeg_read_raw_data (&ctx->cinfo, scanarray, DCTSIZE);
     if (G_LIKELY (lines > 0)) {
       for (j = 0; (j < DCTSIZE) && (i < height); j++, i++) {
         gint p;
@@ -843,8 +918,8 @@ gst_jpeg_dec_decode_rgb (GstJpegDec * dec, GstVideoFrame * frame)
 }
 
 static void
-gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstVideoFrame * frame, gint r_v,
-    gint r_h, gint comp)
+gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstJpegDecContext * ctx,
+    GstVideoFrame * frame, gint r_v, gint r_h, gint comp)
 {
   guchar *y_rows[16], *u_rows[16], *v_rows[16];
   guchar **scanarray[3] = { y_rows, u_rows, v_rows };
@@ -860,7 +935,8 @@ gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstVideoFrame * frame, gint r_v,
   width = GST_VIDEO_FRAME_WIDTH (frame);
   height = GST_VIDEO_FRAME_HEIGHT (frame);
 
-  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, GST_ROUND_UP_32 (width))))
+  if (G_UNLIKELY (!gst_jpeg_dec_ensure_buffers (dec, ctx,
+              GST_ROUND_UP_32 (width))))
     return;
 
   for (i = 0; i < 3; i++) {
@@ -872,9 +948,9 @@ gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstVideoFrame * frame, gint r_v,
         (GST_VIDEO_FRAME_COMP_HEIGHT (frame, i) - 1));
   }
 
-  memcpy (y_rows, dec->idr_y, 16 * sizeof (gpointer));
-  memcpy (u_rows, dec->idr_u, 16 * sizeof (gpointer));
-  memcpy (v_rows, dec->idr_v, 16 * sizeof (gpointer));
+  memcpy (y_rows, ctx->idr_y, 16 * sizeof (gpointer));
+  memcpy (u_rows, ctx->idr_u, 16 * sizeof (gpointer));
+  memcpy (v_rows, ctx->idr_v, 16 * sizeof (gpointer));
 
   /* fill chroma components for grayscale */
   if (comp == 1) {
@@ -886,7 +962,7 @@ gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstVideoFrame * frame, gint r_v,
   }
 
   for (i = 0; i < height; i += r_v * DCTSIZE) {
-    lines = jpeg_read_raw_data (&dec->cinfo, scanarray, r_v * DCTSIZE);
+    lines = jpeg_read_raw_data (&ctx->cinfo, scanarray, r_v * DCTSIZE);
     if (G_LIKELY (lines > 0)) {
       for (j = 0, k = 0; j < (r_v * DCTSIZE); j += r_v, k++) {
         if (G_LIKELY (base[0] <= last[0])) {
@@ -923,7 +999,8 @@ gst_jpeg_dec_decode_indirect (GstJpegDec * dec, GstVideoFrame * frame, gint r_v,
 }
 
 static GstFlowReturn
-gst_jpeg_dec_decode_direct (GstJpegDec * dec, GstVideoFrame * frame)
+gst_jpeg_dec_decode_direct (GstJpegDec * dec, GstJpegDecContext * ctx,
+    GstVideoFrame * frame)
 {
   guchar **line[3];             /* the jpeg line buffer         */
   guchar *y[4 * DCTSIZE] = { NULL, };   /* alloc enough for the lines   */
@@ -939,9 +1016,9 @@ gst_jpeg_dec_decode_direct (GstJpegDec * dec, GstVideoFrame * frame)
   line[1] = u;
   line[2] = v;
 
-  v_samp[0] = dec->cinfo.comp_info[0].v_samp_factor;
-  v_samp[1] = dec->cinfo.comp_info[1].v_samp_factor;
-  v_samp[2] = dec->cinfo.comp_info[2].v_samp_factor;
+  v_samp[0] = ctx->cinfo.comp_info[0].v_samp_factor;
+  v_samp[1] = ctx->cinfo.comp_info[1].v_samp_factor;
+  v_samp[2] = ctx->cinfo.comp_info[2].v_samp_factor;
 
   if (G_UNLIKELY (v_samp[0] > 2 || v_samp[1] > 2 || v_samp[2] > 2))
     goto format_not_supported;
@@ -984,7 +1061,7 @@ gst_jpeg_dec_decode_direct (GstJpegDec * dec, GstVideoFrame * frame)
         line[2][j] = last[2];
     }
 
-    lines = jpeg_read_raw_data (&dec->cinfo, line, v_samp[0] * DCTSIZE);
+    lines = jpeg_read_raw_data (&ctx->cinfo, line, v_samp[0] * DCTSIZE);
     if (G_UNLIKELY (!lines)) {
       GST_INFO_OBJECT (dec, "jpeg_read_raw_data() returned 0");
     }
@@ -993,7 +1070,7 @@ gst_jpeg_dec_decode_direct (GstJpegDec * dec, GstVideoFrame * frame)
 
 format_not_supported:
   {
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
         "Unsupported subsampling schema: v_samp factors: %u %u %u",
         v_samp[0], v_samp[1], v_samp[2]);
     return GST_FLOW_ERROR;
@@ -1052,106 +1129,101 @@ gst_jpeg_dec_negotiate (GstJpegDec * dec, gint width, gint height, gint clrspc)
   gst_video_codec_state_unref (outstate);
 
   gst_video_decoder_negotiate (GST_VIDEO_DECODER (dec));
-
-  GST_DEBUG_OBJECT (dec, "max_v_samp_factor=%d", dec->cinfo.max_v_samp_factor);
-  GST_DEBUG_OBJECT (dec, "max_h_samp_factor=%d", dec->cinfo.max_h_samp_factor);
 }
 
+/* Reads the header of the image in @data and prepares @ctx for raw output.
+ * The header is read again by the thread that decodes the image */
 static GstFlowReturn
-gst_jpeg_dec_handle_frame (GstVideoDecoder * bdec, GstVideoCodecFrame * frame)
+gst_jpeg_dec_read_header (GstJpegDec * dec, GstJpegDecContext * ctx,
+    const guint8 * data, gsize size)
 {
-  GstFlowReturn ret = GST_FLOW_OK;
-  GstJpegDec *dec = (GstJpegDec *) bdec;
-  GstVideoFrame vframe;
   gint width, height;
   gint r_h, r_v;
   guint code, hdr_ok;
-  gboolean need_unmap = TRUE;
-  GstVideoCodecState *state = NULL;
 
-  dec->current_frame = frame;
-  gst_buffer_map (frame->input_buffer, &dec->current_frame_map, GST_MAP_READ);
-  gst_jpeg_dec_fill_input_buffer (&dec->cinfo);
+  ctx->jsrc.data = data;
+  ctx->jsrc.size = size;
+  gst_jpeg_dec_fill_input_buffer (&ctx->cinfo);
 
-  if (setjmp (dec->jerr.setjmp_buffer)) {
-    code = dec->jerr.pub.msg_code;
+  if (setjmp (ctx->jerr.setjmp_buffer)) {
+    code = ctx->jerr.pub.msg_code;
 
     if (code == JERR_INPUT_EOF) {
       GST_DEBUG ("jpeg input EOF error, we probably need more data");
-      goto need_more_data;
+      return GST_VIDEO_DECODER_FLOW_NEED_DATA;
     }
     goto decode_error;
   }
 
   /* read header */
-  hdr_ok = jpeg_read_header (&dec->cinfo, TRUE);
+  hdr_ok = jpeg_read_header (&ctx->cinfo, TRUE);
   if (G_UNLIKELY (hdr_ok != JPEG_HEADER_OK)) {
     GST_WARNING_OBJECT (dec, "reading the header failed, %d", hdr_ok);
   }
 
-  GST_LOG_OBJECT (dec, "num_components=%d", dec->cinfo.num_components);
-  GST_LOG_OBJECT (dec, "jpeg_color_space=%d", dec->cinfo.jpeg_color_space);
+  GST_LOG_OBJECT (dec, "num_components=%d", ctx->cinfo.num_components);
+  GST_LOG_OBJECT (dec, "jpeg_color_space=%d", ctx->cinfo.jpeg_color_space);
 
-  if (!dec->cinfo.num_components || !dec->cinfo.comp_info)
+  if (!ctx->cinfo.num_components || !ctx->cinfo.comp_info)
     goto components_not_supported;
 
-  r_h = dec->cinfo.comp_info[0].h_samp_factor;
-  r_v = dec->cinfo.comp_info[0].v_samp_factor;
+  r_h = ctx->cinfo.comp_info[0].h_samp_factor;
+  r_v = ctx->cinfo.comp_info[0].v_samp_factor;
 
   GST_LOG_OBJECT (dec, "r_h = %d, r_v = %d", r_h, r_v);
 
-  if (dec->cinfo.num_components > 3)
+  if (ctx->cinfo.num_components > 3)
     goto components_not_supported;
 
   /* verify color space expectation to avoid going *boom* or bogus output */
-  if (dec->cinfo.jpeg_color_space != JCS_YCbCr &&
-      dec->cinfo.jpeg_color_space != JCS_GRAYSCALE &&
-      dec->cinfo.jpeg_color_space != JCS_RGB)
+  if (ctx->cinfo.jpeg_color_space != JCS_YCbCr &&
+      ctx->cinfo.jpeg_color_space != JCS_GRAYSCALE &&
+      ctx->cinfo.jpeg_color_space != JCS_RGB)
     goto unsupported_colorspace;
 
 #ifndef GST_DISABLE_GST_DEBUG
   {
     gint i;
 
-    for (i = 0; i < dec->cinfo.num_components; ++i) {
+    for (i = 0; i < ctx->cinfo.num_components; ++i) {
       GST_LOG_OBJECT (dec, "[%d] h_samp_factor=%d, v_samp_factor=%d, cid=%d",
-          i, dec->cinfo.comp_info[i].h_samp_factor,
-          dec->cinfo.comp_info[i].v_samp_factor,
-          dec->cinfo.comp_info[i].component_id);
+          i, ctx->cinfo.comp_info[i].h_samp_factor,
+          ctx->cinfo.comp_info[i].v_samp_factor,
+          ctx->cinfo.comp_info[i].component_id);
     }
   }
 #endif
 
   /* prepare for raw output */
-  dec->cinfo.do_fancy_upsampling = FALSE;
-  dec->cinfo.do_block_smoothing = FALSE;
-  dec->cinfo.out_color_space = dec->cinfo.jpeg_color_space;
-  dec->cinfo.dct_method = dec->idct_method;
-  dec->cinfo.raw_data_out = TRUE;
+  ctx->cinfo.do_fancy_upsampling = FALSE;
+  ctx->cinfo.do_block_smoothing = FALSE;
+  ctx->cinfo.out_color_space = ctx->cinfo.jpeg_color_space;
+  ctx->cinfo.dct_method = g_atomic_int_get (&dec->idct_method);
+  ctx->cinfo.raw_data_out = TRUE;
 
-  GST_LOG_OBJECT (dec, "starting decompress");
-  guarantee_huff_tables (&dec->cinfo);
-  if (!jpeg_start_decompress (&dec->cinfo)) {
-    GST_WARNING_OBJECT (dec, "failed to start decompression cycle");
-  }
+  guarantee_huff_tables (&ctx->cinfo);
+  jpeg_calc_output_dimensions (&ctx->cinfo);
+
+  GST_LOG_OBJECT (dec, "max_v_samp_factor=%d", ctx->cinfo.max_v_samp_factor);
+  GST_LOG_OBJECT (dec, "max_h_samp_factor=%d", ctx->cinfo.max_h_samp_factor);
 
   /* sanity checks to get safe and reasonable output */
-  switch (dec->cinfo.jpeg_color_space) {
+  switch (ctx->cinfo.jpeg_color_space) {
     case JCS_GRAYSCALE:
-      if (dec->cinfo.num_components != 1)
+      if (ctx->cinfo.num_components != 1)
         goto invalid_yuvrgbgrayscale;
       break;
     case JCS_RGB:
-      if (dec->cinfo.num_components != 3 || dec->cinfo.max_v_samp_factor > 1 ||
-          dec->cinfo.max_h_samp_factor > 1)
+      if (ctx->cinfo.num_components != 3 || ctx->cinfo.max_v_samp_factor > 1 ||
+          ctx->cinfo.max_h_samp_factor > 1)
         goto invalid_yuvrgbgrayscale;
       break;
     case JCS_YCbCr:
-      if (dec->cinfo.num_components != 3 ||
-          r_v > 2 || r_v < dec->cinfo.comp_info[0].v_samp_factor ||
-          r_v < dec->cinfo.comp_info[1].v_samp_factor ||
-          r_h < dec->cinfo.comp_info[0].h_samp_factor ||
-          r_h < dec->cinfo.comp_info[1].h_samp_factor)
+      if (ctx->cinfo.num_components != 3 ||
+          r_v > 2 || r_v < ctx->cinfo.comp_info[0].v_samp_factor ||
+          r_v < ctx->cinfo.comp_info[1].v_samp_factor ||
+          r_h < ctx->cinfo.comp_info[0].h_samp_factor ||
+          r_h < ctx->cinfo.comp_info[1].h_samp_factor)
         goto invalid_yuvrgbgrayscale;
       break;
     default:
@@ -1159,121 +1231,166 @@ gst_jpeg_dec_handle_frame (GstVideoDecoder * bdec, GstVideoCodecFrame * frame)
       break;
   }
 
-  width = dec->cinfo.output_width;
-  height = dec->cinfo.output_height;
+  width = ctx->cinfo.output_width;
+  height = ctx->cinfo.output_height;
 
   if (G_UNLIKELY (width < MIN_WIDTH || width > MAX_WIDTH ||
           height < MIN_HEIGHT || height > MAX_HEIGHT))
     goto wrong_size;
 
-  gst_jpeg_dec_negotiate (dec, width, height, dec->cinfo.jpeg_color_space);
+  return GST_FLOW_OK;
+
+  /* ERRORS */
+wrong_size:
+  {
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Picture is too small or too big (%ux%u)", width, height);
+    return GST_FLOW_ERROR;
+  }
+decode_error:
+  {
+    gchar err_msg[JMSG_LENGTH_MAX];
 
-  state = gst_video_decoder_get_output_state (bdec);
-  ret = gst_video_decoder_allocate_output_frame (bdec, frame);
-  if (G_UNLIKELY (ret != GST_FLOW_OK))
-    goto alloc_failed;
+    ctx->jerr.pub.format_message ((j_common_ptr) (&ctx->cinfo), err_msg);
 
-  if (!gst_video_frame_map (&vframe, &state->info, frame->output_buffer,
-          GST_MAP_READWRITE))
-    goto alloc_failed;
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Decode error #%u: %s", code, err_msg);
+    return GST_FLOW_ERROR;
+  }
+components_not_supported:
+  {
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "number of components not supported: %d (max 3)",
+        ctx->cinfo.num_components);
+    return GST_FLOW_ERROR;
+  }
+unsupported_colorspace:
+  {
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Picture has unknown or unsupported colourspace");
+    return GST_FLOW_ERROR;
+  }
+invalid_yuvrgbgrayscale:
+  {
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Picture is corrupt or unhandled YUV/RGB/grayscale layout");
+    return GST_FLOW_ERROR;
+  }
+}
 
-  GST_LOG_OBJECT (dec, "width %d, height %d", width, height);
+/* Decodes the image of which the header was read into @ctx */
+static GstFlowReturn
+gst_jpeg_dec_decode (GstJpegDec * dec, GstJpegDecContext * ctx,
+    GstVideoFrame * vframe)
+{
+  gint width;
+  gint r_h, r_v;
+  guint code;
+
+  if (setjmp (ctx->jerr.setjmp_buffer)) {
+    gchar err_msg[JMSG_LENGTH_MAX];
+
+    code = ctx->jerr.pub.msg_code;
+    ctx->jerr.pub.format_message ((j_common_ptr) (&ctx->cinfo), err_msg);
+
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Decode error #%u: %s", code, err_msg);
+    return GST_FLOW_ERROR;
+  }
+
+  GST_LOG_OBJECT (dec, "starting decompress");
+  if (!jpeg_start_decompress (&ctx->cinfo)) {
+    GST_WARNING_OBJECT (dec, "failed to start decompression cycle");
+  }
 
-  if (dec->cinfo.jpeg_color_space == JCS_RGB) {
-    gst_jpeg_dec_decode_rgb (dec, &vframe);
-  } else if (dec->cinfo.jpeg_color_space == JCS_GRAYSCALE) {
-    gst_jpeg_dec_decode_grayscale (dec, &vframe);
+  width = GST_VIDEO_FRAME_WIDTH (vframe);
+  r_h = ctx->cinfo.comp_info[0].h_samp_factor;
+  r_v = ctx->cinfo.comp_info[0].v_samp_factor;
+
+  if (ctx->cinfo.jpeg_color_space == JCS_RGB) {
+    gst_jpeg_dec_decode_rgb (dec, ctx, vframe);
+  } else if (ctx->cinfo.jpeg_color_space == JCS_GRAYSCALE) {
+    gst_jpeg_dec_decode_grayscale (dec, ctx, vframe);
   } else {
     GST_LOG_OBJECT (dec, "decompressing (reqired scanline buffer height = %u)",
-        dec->cinfo.rec_outbuf_height);
+        ctx->cinfo.rec_outbuf_height);
 
     /* For some widths jpeglib requires more horizontal padding than I420 
      * provides. In those cases we need to decode into separate buffers and then
      * copy over the data into our final picture buffer, otherwise jpeglib might
      * write over the end of a line into the beginning of the next line,
      * resulting in blocky artifacts on the left side of the picture. */
-    if (G_UNLIKELY (width % (dec->cinfo.max_h_samp_factor * DCTSIZE) != 0
-            || dec->cinfo.comp_info[0].h_samp_factor != 2
-            || dec->cinfo.comp_info[1].h_samp_factor != 1
-            || dec->cinfo.comp_info[2].h_samp_factor != 1)) {
+    if (G_UNLIKELY (width % (ctx->cinfo.max_h_samp_factor * DCTSIZE) != 0
+            || ctx->cinfo.comp_info[0].h_samp_factor != 2
+            || ctx->cinfo.comp_info[1].h_samp_factor != 1
+            || ctx->cinfo.comp_info[2].h_samp_factor != 1)) {
       GST_CAT_LOG_OBJECT (GST_CAT_PERFORMANCE, dec,
           "indirect decoding using extra buffer copy");
-      gst_jpeg_dec_decode_indirect (dec, &vframe, r_v, r_h,
-          dec->cinfo.num_components);
-    } else {
-      ret = gst_jpeg_dec_decode_direct (dec, &vframe);
-
-      if (G_UNLIKELY (ret != GST_FLOW_OK))
-        goto decode_direct_failed;
+      gst_jpeg_dec_decode_indirect (dec, ctx, vframe, r_v, r_h,
+          ctx->cinfo.num_components);
+    } else if (gst_jpeg_dec_decode_direct (dec, ctx, vframe) != GST_FLOW_OK) {
+      /* the error was set already */
+      return GST_FLOW_ERROR;
     }
   }
 
-  gst_video_frame_unmap (&vframe);
-
   GST_LOG_OBJECT (dec, "decompressing finished");
-  jpeg_finish_decompress (&dec->cinfo);
+  jpeg_finish_decompress (&ctx->cinfo);
 
-  /* reset error count on successful decode */
-  dec->error_count = 0;
-
-  gst_buffer_unmap (frame->input_buffer, &dec->current_frame_map);
-  ret = gst_video_decoder_finish_frame (bdec, frame);
-  need_unmap = FALSE;
-
-done:
+  return GST_FLOW_OK;
+}
 
-exit:
+/* Reads the header on the streaming thread to configure the output and
+ * allocate the output buffer, the image is decoded in decode_frame() */
+static GstFlowReturn
+gst_jpeg_dec_handle_frame (GstVideoDecoder * bdec, GstVideoCodecFrame * frame)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstJpegDec *dec = (GstJpegDec *) bdec;
+  GstJpegDecContext *ctx;
+  GstMapInfo map;
+  gint width, height, clrspc;
 
-  if (G_UNLIKELY (ret == GST_FLOW_ERROR)) {
-    jpeg_abort_decompress (&dec->cinfo);
-    ret = gst_jpeg_dec_post_error_or_warning (dec);
-  }
+  ctx = gst_jpeg_dec_get_context (dec);
 
-  if (need_unmap)
-    gst_buffer_unmap (frame->input_buffer, &dec->current_frame_map);
+  gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ);
+  ret = gst_jpeg_dec_read_header (dec, ctx, map.data, map.size);
+  width = ctx->cinfo.output_width;
+  height = ctx->cinfo.output_height;
+  clrspc = ctx->cinfo.jpeg_color_space;
+  jpeg_abort_decompress (&ctx->cinfo);
+  gst_buffer_unmap (frame->input_buffer, &map);
 
-  if (state)
-    gst_video_codec_state_unref (state);
+  if (G_UNLIKELY (ret != GST_FLOW_OK))
+    goto header_failed;
 
-  return ret;
+  gst_jpeg_dec_negotiate (dec, width, height, clrspc);
 
-  /* special cases */
-need_more_data:
-  {
-    GST_LOG_OBJECT (dec, "we need more data");
-    ret = GST_FLOW_OK;
-    goto exit;
-  }
-  /* ERRORS */
-wrong_size:
-  {
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
-        "Picture is too small or too big (%ux%u)", width, height);
-    ret = GST_FLOW_ERROR;
-    goto done;
-  }
-decode_error:
-  {
-    gchar err_msg[JMSG_LENGTH_MAX];
+  ret = gst_video_decoder_allocate_output_frame (bdec, frame);
+  if (G_UNLIKELY (ret != GST_FLOW_OK))
+    goto alloc_failed;
 
-    dec->jerr.pub.format_message ((j_common_ptr) (&dec->cinfo), err_msg);
+  gst_jpeg_dec_release_context (dec, ctx);
 
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
-        "Decode error #%u: %s", code, err_msg);
+  GST_LOG_OBJECT (dec, "width %d, height %d", width, height);
 
-    gst_buffer_unmap (frame->input_buffer, &dec->current_frame_map);
-    gst_video_decoder_drop_frame (bdec, frame);
-    need_unmap = FALSE;
+  return gst_video_decoder_submit_frame (bdec, frame);
 
-    ret = GST_FLOW_ERROR;
-    goto done;
-  }
-decode_direct_failed:
+  /* special cases */
+header_failed:
   {
-    /* already posted an error message */
-    jpeg_abort_decompress (&dec->cinfo);
-    goto done;
+    if (ret == GST_VIDEO_DECODER_FLOW_NEED_DATA) {
+      /* the frame stays with the base class, like before threading */
+      GST_LOG_OBJECT (dec, "we need more data");
+      ret = GST_FLOW_OK;
+    } else {
+      gst_video_decoder_drop_frame (bdec, frame);
+      ret = gst_jpeg_dec_post_error_or_warning (dec, ctx);
+    }
+    gst_jpeg_dec_release_context (dec, ctx);
+    return ret;
   }
+  /* ERRORS */
 alloc_failed:
   {
     const gchar *reason;
@@ -1281,37 +1398,65 @@ alloc_failed:
     reason = gst_flow_get_name (ret);
 
     GST_DEBUG_OBJECT (dec, "failed to alloc buffer, reason %s", reason);
-    /* Reset for next time */
-    jpeg_abort_decompress (&dec->cinfo);
-    if (ret != GST_FLOW_EOS && ret != GST_FLOW_FLUSHING &&
-        ret != GST_FLOW_NOT_LINKED) {
-      gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
+    gst_video_decoder_drop_frame (bdec, frame);
+    if (ret == GST_FLOW_ERROR) {
+      gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
           "Buffer allocation failed, reason: %s", reason);
+      ret = gst_jpeg_dec_post_error_or_warning (dec, ctx);
     }
-    goto exit;
+    gst_jpeg_dec_release_context (dec, ctx);
+    return ret;
   }
-components_not_supported:
-  {
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
-        "number of components not supported: %d (max 3)",
-        dec->cinfo.num_components);
-    ret = GST_FLOW_ERROR;
+}
+
+/* Decodes a frame that went through handle_frame(), from any thread */
+static GstFlowReturn
+gst_jpeg_dec_decode_frame (GstVideoDecoder * bdec, GstVideoCodecFrame * frame)
+{
+  GstJpegDec *dec = (GstJpegDec *) bdec;
+  GstJpegDecContext *ctx;
+  GstVideoCodecState *state;
+  GstVideoFrame vframe;
+  GstMapInfo map;
+  GstFlowReturn ret;
+
+  state = gst_video_decoder_get_output_state (bdec);
+  ctx = gst_jpeg_dec_get_context (dec);
+
+  gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ);
+  ret = gst_jpeg_dec_read_header (dec, ctx, map.data, map.size);
+  if (G_UNLIKELY (ret != GST_FLOW_OK))
     goto done;
-  }
-unsupported_colorspace:
-  {
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
-        "Picture has unknown or unsupported colourspace");
+
+  if (!gst_video_frame_map (&vframe, &state->info, frame->output_buffer,
+          GST_MAP_READWRITE)) {
+    gst_jpeg_dec_set_error (dec, ctx, GST_FUNCTION, __LINE__,
+        "Failed to map output buffer");
     ret = GST_FLOW_ERROR;
     goto done;
   }
-invalid_yuvrgbgrayscale:
-  {
-    gst_jpeg_dec_set_error (dec, GST_FUNCTION, __LINE__,
-        "Picture is corrupt or unhandled YUV/RGB/grayscale layout");
-    ret = GST_FLOW_ERROR;
-    goto done;
+
+  ret = gst_jpeg_dec_decode (dec, ctx, &vframe);
+  gst_video_frame_unmap (&vframe);
+
+done:
+  gst_buffer_unmap (frame->input_buffer, &map);
+  gst_video_codec_state_unref (state);
+
+  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+    jpeg_abort_decompress (&ctx->cinfo);
+    ret = gst_jpeg_dec_post_error_or_warning (dec, ctx);
+    /* any other success value makes the base class drop the frame */
+    if (ret == GST_FLOW_OK)
+      ret = GST_FLOW_CUSTOM_SUCCESS;
+  } else {
+    /* reset error count on successful decode */
+    g_atomic_int_set (&dec->error_count, 0);
   }
+
+  gst_jpeg_dec_release_context (dec, ctx);
+
+  return ret;
 }
 
 static gboolean
@@ -1345,7 +1490,6 @@ gst_jpeg_dec_reset (GstVideoDecoder * bdec, gboolean hard)
 {
   GstJpegDec *dec = (GstJpegDec *) bdec;
 
-  jpeg_abort_decompress (&dec->cinfo);
   dec->parse_entropy_len = 0;
   dec->parse_resync = FALSE;
   dec->saw_header = FALSE;
@@ -1363,7 +1507,7 @@ gst_jpeg_dec_set_property (GObject * object, guint prop_id,
 
   switch (prop_id) {
     case PROP_IDCT_METHOD:
-      dec->idct_method = g_value_get_enum (value);
+      g_atomic_int_set (&dec->idct_method, g_value_get_enum (value));
       break;
     case PROP_MAX_ERRORS:
       g_atomic_int_set (&dec->max_errors, g_value_get_int (value));
@@ -1385,7 +1529,7 @@ gst_jpeg_dec_get_property (GObject * object, guint prop_id, GValue * value,
 
   switch (prop_id) {
     case PROP_IDCT_METHOD:
-      g_value_set_enum (value, dec->idct_method);
+      g_value_set_enum (value, g_atomic_int_get (&dec->idct_method));
       break;
     case PROP_MAX_ERRORS:
       g_value_set_int (value, g_atomic_int_get (&dec->max_errors));
@@ -1402,7 +1546,7 @@ gst_jpeg_dec_start (GstVideoDecoder * bdec)
 {
   GstJpegDec *dec = (GstJpegDec *) bdec;
 
-  dec->error_count = 0;
+  g_atomic_int_set (&dec->error_count, 0);
   dec->parse_entropy_len = 0;
   dec->parse_resync = FALSE;
 
@@ -1416,7 +1560,7 @@ gst_jpeg_dec_stop (GstVideoDecoder * bdec)
 {
   GstJpegDec *dec = (GstJpegDec *) bdec;
 
-  gst_jpeg_dec_free_buffers (dec);
+  gst_jpeg_dec_free_contexts (dec);
 
   return TRUE;
 }
@@ -61,6 +61,28 @@ struct GstJpegDecErrorMgr {
 struct GstJpegDecSourceMgr {
   struct jpeg_source_mgr   pub;   /* public fields */
   GstJpegDec              *dec;
+  /* the image that is being read */
+  const guint8            *data;
+  gsize                    size;
+};
+
+typedef struct _GstJpegDecContext GstJpegDecContext;
+
+/* libjpeg state to decode one image at a time, frames that are decoded at
+ * the same time each use their own context */
+struct _GstJpegDecContext {
+  struct jpeg_decompress_struct cinfo;
+  struct GstJpegDecErrorMgr     jerr;
+  struct GstJpegDecSourceMgr    jsrc;
+
+  /* current error (the message is the debug message) */
+  gchar       *error_msg;
+  int          error_line;
+  const gchar *error_func;
+
+  /* arrays for indirect decoding */
+  gboolean idr_width_allocated;
+  guchar *idr_y[16],*idr_u[16],*idr_v[16];
 };
 
 /* Can't use GstBaseTransform, because GstBaseTransform
@@ -71,8 +93,6 @@ struct _GstJpegDec {
 
   /* negotiated state */
   GstVideoCodecState *input_state;
-  GstVideoCodecFrame *current_frame;
-  GstMapInfo current_frame_map;
 
   /* parse state */
   gboolean saw_header;
@@ -80,26 +100,15 @@ struct _GstJpegDec {
   gint     parse_resync;
 
   /* properties */
-  gint     idct_method;
+  gint     idct_method; /* ATOMIC */
   gint     max_errors;  /* ATOMIC */
 
-  /* current error (the message is the debug message) */
-  gchar       *error_msg;
-  int          error_line;
-  const gchar *error_func;
-
   /* number of errors since start or last successfully decoded image */
-  guint     error_count;
+  gint     error_count; /* ATOMIC */
 
-  struct jpeg_decompress_struct cinfo;
-  struct GstJpegDecErrorMgr     jerr;
-  struct GstJpegDecSourceMgr    jsrc;
-
-  /* arrays for indirect decoding */
-  gboolean idr_width_allocated;
-  guchar *idr_y[16],*idr_u[16],*idr_v[16];
-  /* current (parsed) image size */
-  guint    rem_img_len;
+  /* unused decoding contexts, protected by lock */
+  GMutex   lock;
+  GSList  *contexts;
 };
 
 struct _GstJpegDecClass {
@@ -73,18 +73,20 @@ enum
 static void gst_jpegenc_reset (GstJpegEnc * enc);
 static void gst_jpegenc_finalize (GObject * object);
 
-static void gst_jpegenc_resync (GstJpegEnc * jpegenc);
 static void gst_jpegenc_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_jpegenc_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
-static gboolean gst_jpegenc_start (GstVideoEncoder * benc);
 static gboolean gst_jpegenc_stop (GstVideoEncoder * benc);
 static gboolean gst_jpegenc_set_format (GstVideoEncoder * encoder,
     GstVideoCodecState * state);
 static GstFlowReturn gst_jpegenc_handle_frame (GstVideoEncoder * encoder,
     GstVideoCodecFrame * frame);
+static GstFlowReturn gst_jpegenc_encode_frame (GstVideoEncoder * encoder,
+    GstVideoCodecFrame * frame);
+static GstFlowReturn gst_jpegenc_pre_push (GstVideoEncoder * encoder,
+    GstVideoCodecFrame * frame);
 static gboolean gst_jpegenc_propose_allocation (GstVideoEncoder * encoder,
     GstQuery * query);
 
@@ -159,16 +161,32 @@ gst_jpegenc_class_init (GstJpegEncClass * klass)
       "Codec/Encoder/Image",
       "Encode images in JPEG format", "Wim Taymans <wim.taymans@tvd.be>");
 
-  venc_class->start = gst_jpegenc_start;
   venc_class->stop = gst_jpegenc_stop;
   venc_class->set_format = gst_jpegenc_set_format;
   venc_class->handle_frame = gst_jpegenc_handle_frame;
+  venc_class->encode_frame = gst_jpegenc_encode_frame;
+  venc_class->pre_push = gst_jpegenc_pre_push;
   venc_class->propose_allocation = gst_jpegenc_propose_allocation;
 
   GST_DEBUG_CATEGORY_INIT (jpegenc_debug, "jpegenc", 0,
       "JPEG encoding element");
 }
 
+METHODDEF (void)
+    gst_jpegenc_my_output_message (j_common_ptr cinfo)
+{
+  return;                       /* do nothing */
+}
+
+METHODDEF (void)
+    gst_jpegenc_my_error_exit (j_common_ptr cinfo)
+{
+  struct GstJpegEncErrorMgr *err_mgr = (struct GstJpegEncErrorMgr *) cinfo->err;
+
+  (*cinfo->err->output_message) (cinfo);
+  longjmp (err_mgr->setjmp_buffer, 1);
+}
+
 static void
 gst_jpegenc_init_destination (j_compress_ptr cinfo)
 {
@@ -176,7 +194,7 @@ gst_jpegenc_init_destination (j_compress_ptr cinfo)
 }
 
 static void
-ensure_memory (GstJpegEnc * jpegenc)
+ensure_memory (GstJpegEncContext * ctx)
 {
   GstMemory *new_memory;
   GstMapInfo map;
@@ -184,9 +202,9 @@ ensure_memory (GstJpegEnc * jpegenc)
   guint8 *new_data;
   static GstAllocationParams params = { 0, 3, 0, 0, };
 
-  old_size = jpegenc->output_map.size;
+  old_size = ctx->output_map.size;
   if (old_size == 0)
-    desired_size = jpegenc->bufsize;
+    desired_size = ctx->enc->bufsize;
   else
     desired_size = old_size * 2;
 
@@ -198,30 +216,30 @@ ensure_memory (GstJpegEnc * jpegenc)
   new_size = map.size;
 
   /* copy previous data if any */
-  if (jpegenc->output_mem) {
-    memcpy (new_data, jpegenc->output_map.data, old_size);
-    gst_memory_unmap (jpegenc->output_mem, &jpegenc->output_map);
-    gst_memory_unref (jpegenc->output_mem);
+  if (ctx->output_mem) {
+    memcpy (new_data, ctx->output_map.data, old_size);
+    gst_memory_unmap (ctx->output_mem, &ctx->output_map);
+    gst_memory_unref (ctx->output_mem);
   }
 
   /* drop it into place, */
-  jpegenc->output_mem = new_memory;
-  jpegenc->output_map = map;
+  ctx->output_mem = new_memory;
+  ctx->output_map = map;
 
   /* and last, update libjpeg on where to work. */
-  jpegenc->jdest.next_output_byte = new_data + old_size;
-  jpegenc->jdest.free_in_buffer = new_size - old_size;
+  ctx->jdest.next_output_byte = new_data + old_size;
+  ctx->jdest.free_in_buffer = new_size - old_size;
 }
 
 static boolean
 gst_jpegenc_flush_destination (j_compress_ptr cinfo)
 {
-  GstJpegEnc *jpegenc = (GstJpegEnc *) (cinfo->client_data);
+  GstJpegEncContext *ctx = (GstJpegEncContext *) (cinfo->client_data);
 
-  GST_DEBUG_OBJECT (jpegenc,
+  GST_DEBUG_OBJECT (ctx->enc,
       "gst_jpegenc_chain: flush_destination: buffer too small");
 
-  ensure_memory (jpegenc);
+  ensure_memory (ctx);
 
   return TRUE;
 }
@@ -229,72 +247,169 @@ gst_jpegenc_flush_destination (j_compress_ptr cinfo)
 static void
 gst_jpegenc_term_destination (j_compress_ptr cinfo)
 {
-  GstBuffer *outbuf;
-  GstJpegEnc *jpegenc = (GstJpegEnc *) (cinfo->client_data);
-  gsize memory_size = jpegenc->output_map.size - jpegenc->jdest.free_in_buffer;
-  GstByteReader reader =
-      GST_BYTE_READER_INIT (jpegenc->output_map.data, memory_size);
-  guint16 marker;
-  gint sof_marker = -1;
-
-  GST_DEBUG_OBJECT (jpegenc, "gst_jpegenc_chain: term_source");
-
-  /* Find the SOF marker */
-  while (gst_byte_reader_get_uint16_be (&reader, &marker)) {
-    /* SOF marker */
-    if (marker >> 4 == 0x0ffc) {
-      sof_marker = marker & 0x4;
-      break;
+  GstJpegEncContext *ctx = (GstJpegEncContext *) (cinfo->client_data);
+  gsize memory_size = ctx->output_map.size - ctx->jdest.free_in_buffer;
+
+  GST_DEBUG_OBJECT (ctx->enc, "gst_jpegenc_chain: term_source");
+
+  gst_memory_unmap (ctx->output_mem, &ctx->output_map);
+  /* Trim the buffer size. we will push it in the encode function */
+  gst_memory_resize (ctx->output_mem, 0, memory_size);
+  ctx->output_map.data = NULL;
+  ctx->output_map.size = 0;
+}
+
+/* sets up the compressor of @ctx for the current input format */
+static void
+gst_jpegenc_resync (GstJpegEnc * jpegenc, GstJpegEncContext * ctx)
+{
+  GstVideoInfo *info;
+  gint width, height;
+  gint i, j;
+
+  GST_DEBUG_OBJECT (jpegenc, "resync");
+
+  if (!jpegenc->input_state)
+    return;
+
+  info = &jpegenc->input_state->info;
+
+  ctx->cinfo.image_width = width = GST_VIDEO_INFO_WIDTH (info);
+  ctx->cinfo.image_height = height = GST_VIDEO_INFO_HEIGHT (info);
+  ctx->cinfo.input_components = jpegenc->channels;
+
+  GST_DEBUG_OBJECT (jpegenc, "width %d, height %d", width, height);
+  GST_DEBUG_OBJECT (jpegenc, "format %d", GST_VIDEO_INFO_FORMAT (info));
+
+  if (GST_VIDEO_INFO_IS_RGB (info)) {
+    GST_DEBUG_OBJECT (jpegenc, "RGB");
+    ctx->cinfo.in_color_space = JCS_RGB;
+  } else if (GST_VIDEO_INFO_IS_GRAY (info)) {
+    GST_DEBUG_OBJECT (jpegenc, "gray");
+    ctx->cinfo.in_color_space = JCS_GRAYSCALE;
+  } else {
+    GST_DEBUG_OBJECT (jpegenc, "YUV");
+    ctx->cinfo.in_color_space = JCS_YCbCr;
+  }
+
+  jpeg_set_defaults (&ctx->cinfo);
+  ctx->cinfo.raw_data_in = TRUE;
+  /* duh, libjpeg maps RGB to YUV ... and don't expect some conversion */
+  if (ctx->cinfo.in_color_space == JCS_RGB)
+    jpeg_set_colorspace (&ctx->cinfo, JCS_RGB);
+
+  GST_DEBUG_OBJECT (jpegenc, "h_max_samp=%d, v_max_samp=%d",
+      jpegenc->h_max_samp, jpegenc->v_max_samp);
+  /* image dimension info */
+  for (i = 0; i < jpegenc->channels; i++) {
+    GST_DEBUG_OBJECT (jpegenc, "comp %i: h_samp=%d, v_samp=%d", i,
+        jpegenc->h_samp[i], jpegenc->v_samp[i]);
+    ctx->cinfo.comp_info[i].h_samp_factor = jpegenc->h_samp[i];
+    ctx->cinfo.comp_info[i].v_samp_factor = jpegenc->v_samp[i];
+    g_free (ctx->line[i]);
+    ctx->line[i] = g_new (guchar *, jpegenc->v_max_samp * DCTSIZE);
+    if (!jpegenc->planar) {
+      for (j = 0; j < jpegenc->v_max_samp * DCTSIZE; j++) {
+        g_free (ctx->row[i][j]);
+        ctx->row[i][j] = g_malloc (width);
+        ctx->line[i][j] = ctx->row[i][j];
+      }
     }
   }
 
-  gst_memory_unmap (jpegenc->output_mem, &jpegenc->output_map);
-  /* Trim the buffer size. we will push it in the chain function */
-  gst_memory_resize (jpegenc->output_mem, 0, memory_size);
-  jpegenc->output_map.data = NULL;
-  jpegenc->output_map.size = 0;
+  jpeg_suppress_tables (&ctx->cinfo, TRUE);
 
-  if (jpegenc->sof_marker != sof_marker) {
-    GstVideoCodecState *output;
-    output =
-        gst_video_encoder_set_output_state (GST_VIDEO_ENCODER (jpegenc),
-        gst_caps_new_simple ("image/jpeg", "sof-marker", G_TYPE_INT, sof_marker,
-            NULL), jpegenc->input_state);
-    gst_video_codec_state_unref (output);
-    jpegenc->sof_marker = sof_marker;
+  GST_DEBUG_OBJECT (jpegenc, "resync done");
+}
+
+static GstJpegEncContext *
+gst_jpegenc_context_new (GstJpegEnc * jpegenc)
+{
+  GstJpegEncContext *ctx = g_slice_new0 (GstJpegEncContext);
+
+  ctx->enc = jpegenc;
+
+  /* setup jpeglib */
+  ctx->cinfo.err = jpeg_std_error (&ctx->jerr.pub);
+  ctx->jerr.pub.output_message = gst_jpegenc_my_output_message;
+  ctx->jerr.pub.error_exit = gst_jpegenc_my_error_exit;
+  jpeg_create_compress (&ctx->cinfo);
+
+  ctx->jdest.init_destination = gst_jpegenc_init_destination;
+  ctx->jdest.empty_output_buffer = gst_jpegenc_flush_destination;
+  ctx->jdest.term_destination = gst_jpegenc_term_destination;
+  ctx->cinfo.dest = &ctx->jdest;
+  ctx->cinfo.client_data = ctx;
+
+  gst_jpegenc_resync (jpegenc, ctx);
+
+  return ctx;
+}
+
+static void
+gst_jpegenc_context_free (GstJpegEncContext * ctx)
+{
+  gint i, j;
+
+  jpeg_destroy_compress (&ctx->cinfo);
+
+  for (i = 0; i < 3; i++) {
+    g_free (ctx->line[i]);
+    for (j = 0; j < 4 * DCTSIZE; j++)
+      g_free (ctx->row[i][j]);
+  }
+  if (ctx->output_mem) {
+    if (ctx->output_map.data)
+      gst_memory_unmap (ctx->output_mem, &ctx->output_map);
+    gst_memory_unref (ctx->output_mem);
   }
 
-  outbuf = gst_buffer_new ();
-  gst_buffer_copy_into (outbuf, jpegenc->current_frame->input_buffer,
-      GST_BUFFER_COPY_METADATA, 0, -1);
-  gst_buffer_append_memory (outbuf, jpegenc->output_mem);
-  jpegenc->output_mem = NULL;
+  g_slice_free (GstJpegEncContext, ctx);
+}
 
-  jpegenc->current_frame->output_buffer = outbuf;
+static GstJpegEncContext *
+gst_jpegenc_get_context (GstJpegEnc * jpegenc)
+{
+  GstJpegEncContext *ctx = NULL;
 
-  gst_video_frame_unmap (&jpegenc->current_vframe);
+  g_mutex_lock (&jpegenc->lock);
+  if (jpegenc->contexts) {
+    ctx = jpegenc->contexts->data;
+    jpegenc->contexts =
+        g_slist_delete_link (jpegenc->contexts, jpegenc->contexts);
+  }
+  g_mutex_unlock (&jpegenc->lock);
 
-  GST_VIDEO_CODEC_FRAME_SET_SYNC_POINT (jpegenc->current_frame);
+  if (ctx == NULL) {
+    GST_DEBUG_OBJECT (jpegenc, "creating new encoding context");
+    ctx = gst_jpegenc_context_new (jpegenc);
+  }
 
-  jpegenc->res = gst_video_encoder_finish_frame (GST_VIDEO_ENCODER (jpegenc),
-      jpegenc->current_frame);
-  jpegenc->current_frame = NULL;
+  return ctx;
 }
 
 static void
-gst_jpegenc_init (GstJpegEnc * jpegenc)
+gst_jpegenc_release_context (GstJpegEnc * jpegenc, GstJpegEncContext * ctx)
 {
-  /* setup jpeglib */
-  memset (&jpegenc->cinfo, 0, sizeof (jpegenc->cinfo));
-  memset (&jpegenc->jerr, 0, sizeof (jpegenc->jerr));
-  jpegenc->cinfo.err = jpeg_std_error (&jpegenc->jerr);
-  jpeg_create_compress (&jpegenc->cinfo);
+  g_mutex_lock (&jpegenc->lock);
+  jpegenc->contexts = g_slist_prepend (jpegenc->contexts, ctx);
+  g_mutex_unlock (&jpegenc->lock);
+}
 
-  jpegenc->jdest.init_destination = gst_jpegenc_init_destination;
-  jpegenc->jdest.empty_output_buffer = gst_jpegenc_flush_destination;
-  jpegenc->jdest.term_destination = gst_jpegenc_term_destination;
-  jpegenc->cinfo.dest = &jpegenc->jdest;
-  jpegenc->cinfo.client_data = jpegenc;
+static void
+gst_jpegenc_free_contexts (GstJpegEnc * jpegenc)
+{
+  g_mutex_lock (&jpegenc->lock);
+  g_slist_free_full (jpegenc->contexts,
+      (GDestroyNotify) gst_jpegenc_context_free);
+  jpegenc->contexts = NULL;
+  g_mutex_unlock (&jpegenc->lock);
+}
+
+static void
+gst_jpegenc_init (GstJpegEnc * jpegenc)
+{
+  g_mutex_init (&jpegenc->lock);
 
   /* init properties */
   jpegenc->quality = JPEG_DEFAULT_QUALITY;
@@ -307,21 +422,12 @@ gst_jpegenc_init (GstJpegEnc * jpegenc)
 static void
 gst_jpegenc_reset (GstJpegEnc * enc)
 {
-  gint i, j;
-
-  g_free (enc->line[0]);
-  g_free (enc->line[1]);
-  g_free (enc->line[2]);
-  enc->line[0] = NULL;
-  enc->line[1] = NULL;
-  enc->line[2] = NULL;
-  for (i = 0; i < 3; i++) {
-    for (j = 0; j < 4 * DCTSIZE; j++) {
-      g_free (enc->row[i][j]);
-      enc->row[i][j] = NULL;
-    }
-  }
+  gst_jpegenc_free_contexts (enc);
   enc->sof_marker = -1;
+  if (enc->last_image) {
+    gst_memory_unref (enc->last_image);
+    enc->last_image = NULL;
+  }
 }
 
 static void
@@ -329,7 +435,11 @@ gst_jpegenc_finalize (GObject * object)
 {
   GstJpegEnc *filter = GST_JPEGENC (object);
 
-  jpeg_destroy_compress (&filter->cinfo);
+  gst_jpegenc_free_contexts (filter);
+  g_mutex_clear (&filter->lock);
+
+  if (filter->last_image)
+    gst_memory_unref (filter->last_image);
 
   if (filter->input_state)
     gst_video_codec_state_unref (filter->input_state);
@@ -381,124 +491,96 @@ gst_jpegenc_set_format (GstVideoEncoder * encoder, GstVideoCodecState * state)
   }
   enc->planar = (enc->inc[0] == 1 && enc->inc[1] == 1 && enc->inc[2] == 1);
 
-  gst_jpegenc_resync (enc);
+  /* input buffer size as max output, guard against a potential error in
+   * gst_jpegenc_term_destination which occurs iff
+   * bufsize % 4 < free_space_remaining */
+  enc->bufsize = GST_ROUND_UP_4 (GST_VIDEO_INFO_SIZE (info));
+
+  /* the base class has finished all frames, contexts and the last image
+   * for the old format are not needed anymore */
+  gst_jpegenc_free_contexts (enc);
+  if (enc->last_image) {
+    gst_memory_unref (enc->last_image);
+    enc->last_image = NULL;
+  }
 
   return TRUE;
 }
 
-static void
-gst_jpegenc_resync (GstJpegEnc * jpegenc)
+static GstFlowReturn
+gst_jpegenc_handle_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
 {
-  GstVideoInfo *info;
-  gint width, height;
-  gint i, j;
-
-  GST_DEBUG_OBJECT (jpegenc, "resync");
+  GstJpegEnc *jpegenc = GST_JPEGENC (encoder);
 
-  if (!jpegenc->input_state)
-    return;
-
-  info = &jpegenc->input_state->info;
-
-  jpegenc->cinfo.image_width = width = GST_VIDEO_INFO_WIDTH (info);
-  jpegenc->cinfo.image_height = height = GST_VIDEO_INFO_HEIGHT (info);
-  jpegenc->cinfo.input_components = jpegenc->channels;
-
-  GST_DEBUG_OBJECT (jpegenc, "width %d, height %d", width, height);
-  GST_DEBUG_OBJECT (jpegenc, "format %d", GST_VIDEO_INFO_FORMAT (info));
-
-  if (GST_VIDEO_INFO_IS_RGB (info)) {
-    GST_DEBUG_OBJECT (jpegenc, "RGB");
-    jpegenc->cinfo.in_color_space = JCS_RGB;
-  } else if (GST_VIDEO_INFO_IS_GRAY (info)) {
-    GST_DEBUG_OBJECT (jpegenc, "gray");
-    jpegenc->cinfo.in_color_space = JCS_GRAYSCALE;
-  } else {
-    GST_DEBUG_OBJECT (jpegenc, "YUV");
-    jpegenc->cinfo.in_color_space = JCS_YCbCr;
-  }
+  GST_LOG_OBJECT (jpegenc, "got new frame");
 
-  /* input buffer size as max output */
-  jpegenc->bufsize = GST_VIDEO_INFO_SIZE (info);
-  jpeg_set_defaults (&jpegenc->cinfo);
-  jpegenc->cinfo.raw_data_in = TRUE;
-  /* duh, libjpeg maps RGB to YUV ... and don't expect some conversion */
-  if (jpegenc->cinfo.in_color_space == JCS_RGB)
-    jpeg_set_colorspace (&jpegenc->cinfo, JCS_RGB);
+  /* the compressor is configured for baseline images, so the caps can be
+   * set before the frames are encoded on other threads */
+  if (jpegenc->sof_marker != 0) {
+    GstVideoCodecState *output;
 
-  GST_DEBUG_OBJECT (jpegenc, "h_max_samp=%d, v_max_samp=%d",
-      jpegenc->h_max_samp, jpegenc->v_max_samp);
-  /* image dimension info */
-  for (i = 0; i < jpegenc->channels; i++) {
-    GST_DEBUG_OBJECT (jpegenc, "comp %i: h_samp=%d, v_samp=%d", i,
-        jpegenc->h_samp[i], jpegenc->v_samp[i]);
-    jpegenc->cinfo.comp_info[i].h_samp_factor = jpegenc->h_samp[i];
-    jpegenc->cinfo.comp_info[i].v_samp_factor = jpegenc->v_samp[i];
-    g_free (jpegenc->line[i]);
-    jpegenc->line[i] = g_new (guchar *, jpegenc->v_max_samp * DCTSIZE);
-    if (!jpegenc->planar) {
-      for (j = 0; j < jpegenc->v_max_samp * DCTSIZE; j++) {
-        g_free (jpegenc->row[i][j]);
-        jpegenc->row[i][j] = g_malloc (width);
-        jpegenc->line[i][j] = jpegenc->row[i][j];
-      }
-    }
+    output = gst_video_encoder_set_output_state (encoder,
+        gst_caps_new_simple ("image/jpeg", "sof-marker", G_TYPE_INT, 0, NULL),
+        jpegenc->input_state);
+    gst_video_codec_state_unref (output);
+    jpegenc->sof_marker = 0;
   }
 
-  /* guard against a potential error in gst_jpegenc_term_destination
-     which occurs iff bufsize % 4 < free_space_remaining */
-  jpegenc->bufsize = GST_ROUND_UP_4 (jpegenc->bufsize);
-
-  jpeg_suppress_tables (&jpegenc->cinfo, TRUE);
-
-  GST_DEBUG_OBJECT (jpegenc, "resync done");
+  return gst_video_encoder_submit_frame (encoder, frame);
 }
 
+/* compresses the image of @inbuf into @mem, can be called from several
+ * threads at the same time */
 static GstFlowReturn
-gst_jpegenc_handle_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
+gst_jpegenc_compress (GstJpegEnc * jpegenc, GstBuffer * inbuf,
+    GstMemory ** mem)
 {
-  GstJpegEnc *jpegenc;
+  GstJpegEncContext *ctx;
+  GstVideoFrame vframe;
   guint height;
   guchar *base[3], *end[3];
   guint stride[3];
+  gint quality, smoothing, idct_method;
   gint i, j, k;
   static GstAllocationParams params = { 0, 0, 0, 3, };
 
-  jpegenc = GST_JPEGENC (encoder);
-
-  GST_LOG_OBJECT (jpegenc, "got new frame");
-
-  if (!gst_video_frame_map (&jpegenc->current_vframe,
-          &jpegenc->input_state->info, frame->input_buffer, GST_MAP_READ))
+  if (!gst_video_frame_map (&vframe, &jpegenc->input_state->info, inbuf,
+          GST_MAP_READ))
     goto invalid_frame;
 
-  jpegenc->current_frame = frame;
+  GST_OBJECT_LOCK (jpegenc);
+  quality = jpegenc->quality;
+  smoothing = jpegenc->smoothing;
+  idct_method = jpegenc->idct_method;
+  GST_OBJECT_UNLOCK (jpegenc);
+
+  ctx = gst_jpegenc_get_context (jpegenc);
 
   height = GST_VIDEO_INFO_HEIGHT (&jpegenc->input_state->info);
 
   for (i = 0; i < jpegenc->channels; i++) {
-    base[i] = GST_VIDEO_FRAME_COMP_DATA (&jpegenc->current_vframe, i);
-    stride[i] = GST_VIDEO_FRAME_COMP_STRIDE (&jpegenc->current_vframe, i);
-    end[i] =
-        base[i] + GST_VIDEO_FRAME_COMP_HEIGHT (&jpegenc->current_vframe,
-        i) * stride[i];
+    base[i] = GST_VIDEO_FRAME_COMP_DATA (&vframe, i);
+    stride[i] = GST_VIDEO_FRAME_COMP_STRIDE (&vframe, i);
+    end[i] = base[i] + GST_VIDEO_FRAME_COMP_HEIGHT (&vframe, i) * stride[i];
   }
 
-  jpegenc->res = GST_FLOW_OK;
-  jpegenc->output_mem = gst_allocator_alloc (NULL, jpegenc->bufsize, &params);
-  gst_memory_map (jpegenc->output_mem, &jpegenc->output_map, GST_MAP_READWRITE);
+  ctx->output_mem = gst_allocator_alloc (NULL, jpegenc->bufsize, &params);
+  gst_memory_map (ctx->output_mem, &ctx->output_map, GST_MAP_READWRITE);
 
-  jpegenc->jdest.next_output_byte = jpegenc->output_map.data;
-  jpegenc->jdest.free_in_buffer = jpegenc->output_map.size;
+  if (setjmp (ctx->jerr.setjmp_buffer))
+    goto encode_error;
+
+  ctx->jdest.next_output_byte = ctx->output_map.data;
+  ctx->jdest.free_in_buffer = ctx->output_map.size;
 
   /* prepare for raw input */
 #if JPEG_LIB_VERSION >= 70
-  jpegenc->cinfo.do_fancy_downsampling = FALSE;
+  ctx->cinfo.do_fancy_downsampling = FALSE;
 #endif
-  jpegenc->cinfo.smoothing_factor = jpegenc->smoothing;
-  jpegenc->cinfo.dct_method = jpegenc->idct_method;
-  jpeg_set_quality (&jpegenc->cinfo, jpegenc->quality, TRUE);
-  jpeg_start_compress (&jpegenc->cinfo, TRUE);
+  ctx->cinfo.smoothing_factor = smoothing;
+  ctx->cinfo.dct_method = idct_method;
+  jpeg_set_quality (&ctx->cinfo, quality, TRUE);
+  jpeg_start_compress (&ctx->cinfo, TRUE);
 
   GST_LOG_OBJECT (jpegenc, "compressing");
 
@@ -506,12 +588,12 @@ gst_jpegenc_handle_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
     for (i = 0; i < height; i += jpegenc->v_max_samp * DCTSIZE) {
       for (k = 0; k < jpegenc->channels; k++) {
         for (j = 0; j < jpegenc->v_samp[k] * DCTSIZE; j++) {
-          jpegenc->line[k][j] = base[k];
+          ctx->line[k][j] = base[k];
           if (base[k] + stride[k] < end[k])
             base[k] += stride[k];
         }
       }
-      jpeg_write_raw_data (&jpegenc->cinfo, jpegenc->line,
+      jpeg_write_raw_data (&ctx->cinfo, ctx->line,
           jpegenc->v_max_samp * DCTSIZE);
     }
   } else {
@@ -523,7 +605,7 @@ gst_jpegenc_handle_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
 
           /* ouch, copy line */
           src = base[k];
-          dst = jpegenc->line[k][j];
+          dst = ctx->line[k][j];
           for (l = jpegenc->cwidth[k]; l > 0; l--) {
             *dst = *src;
             src += jpegenc->inc[k];
@@ -533,23 +615,113 @@ gst_jpegenc_handle_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
             base[k] += stride[k];
         }
       }
-      jpeg_write_raw_data (&jpegenc->cinfo, jpegenc->line,
+      jpeg_write_raw_data (&ctx->cinfo, ctx->line,
           jpegenc->v_max_samp * DCTSIZE);
     }
   }
 
   /* This will ensure that gst_jpegenc_term_destination is called */
-  jpeg_finish_compress (&jpegenc->cinfo);
+  jpeg_finish_compress (&ctx->cinfo);
   GST_LOG_OBJECT (jpegenc, "compressing done");
 
-  return jpegenc->res;
+  gst_video_frame_unmap (&vframe);
+
+  *mem = ctx->output_mem;
+  ctx->output_mem = NULL;
+
+  gst_jpegenc_release_context (jpegenc, ctx);
+
+  return GST_FLOW_OK;
 
 invalid_frame:
   {
     GST_WARNING_OBJECT (jpegenc, "invalid frame received");
-    gst_video_encoder_finish_frame (encoder, frame);
+    /* dropped by the base class */
+    return GST_FLOW_CUSTOM_SUCCESS;
+  }
+encode_error:
+  {
+    gchar err_msg[JMSG_LENGTH_MAX];
+
+    ctx->jerr.pub.format_message ((j_common_ptr) (&ctx->cinfo), err_msg);
+    /* the base class only returns the flow error upstream */
+    GST_ELEMENT_ERROR (jpegenc, STREAM, ENCODE, (NULL),
+        ("Encode error #%u: %s", ctx->jerr.pub.msg_code, err_msg));
+
+    jpeg_abort_compress (&ctx->cinfo);
+    if (ctx->output_map.data)
+      gst_memory_unmap (ctx->output_mem, &ctx->output_map);
+    gst_memory_unref (ctx->output_mem);
+    ctx->output_mem = NULL;
+    ctx->output_map.data = NULL;
+    ctx->output_map.size = 0;
+    gst_jpegenc_release_context (jpegenc, ctx);
+
+    gst_video_frame_unmap (&vframe);
+
+    return GST_FLOW_ERROR;
+  }
+}
+
+static GstFlowReturn
+gst_jpegenc_encode_frame (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
+{
+  GstJpegEnc *jpegenc = GST_JPEGENC (encoder);
+  GstMemory *mem = NULL;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  /* a repeated image gets the output of the previous frame in pre_push,
+   * which runs in order after that frame was encoded */
+  if (GST_VIDEO_CODEC_FRAME_IS_REPEAT (frame)) {
+    GST_LOG_OBJECT (jpegenc, "repeated image, not compressing");
+  } else {
+    ret = gst_jpegenc_compress (jpegenc, frame->input_buffer, &mem);
+    if (ret != GST_FLOW_OK)
+      return ret;
+  }
+
+  outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (outbuf, frame->input_buffer,
+      GST_BUFFER_COPY_METADATA, 0, -1);
+  if (mem)
+    gst_buffer_append_memory (outbuf, mem);
+
+  frame->output_buffer = outbuf;
+  GST_VIDEO_CODEC_FRAME_SET_SYNC_POINT (frame);
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_jpegenc_pre_push (GstVideoEncoder * encoder, GstVideoCodecFrame * frame)
+{
+  GstJpegEnc *jpegenc = GST_JPEGENC (encoder);
+  GstMemory *mem;
+  GstFlowReturn ret;
+
+  if (gst_buffer_n_memory (frame->output_buffer) > 0) {
+    /* keep the image for the repeats that follow */
+    mem = gst_buffer_peek_memory (frame->output_buffer, 0);
+  } else if (jpegenc->last_image) {
+    GST_LOG_OBJECT (jpegenc, "repeating the previous image");
+    gst_buffer_append_memory (frame->output_buffer,
+        gst_memory_ref (jpegenc->last_image));
     return GST_FLOW_OK;
+  } else {
+    /* nothing to repeat, e.g. the previous frame was dropped */
+    GST_DEBUG_OBJECT (jpegenc, "no previous image, compressing repeat");
+    ret = gst_jpegenc_compress (jpegenc, frame->input_buffer, &mem);
+    if (ret != GST_FLOW_OK)
+      return ret;
+    gst_buffer_append_memory (frame->output_buffer, mem);
   }
+
+  if (jpegenc->last_image)
+    gst_memory_unref (jpegenc->last_image);
+  jpegenc->last_image = gst_memory_ref (mem);
+
+  return GST_FLOW_OK;
 }
 
 static gboolean
@@ -617,18 +789,6 @@ gst_jpegenc_get_property (GObject * object, guint prop_id, GValue * value,
   GST_OBJECT_UNLOCK (jpegenc);
 }
 
-static gboolean
-gst_jpegenc_start (GstVideoEncoder * benc)
-{
-  GstJpegEnc *enc = (GstJpegEnc *) benc;
-
-  enc->line[0] = NULL;
-  enc->line[1] = NULL;
-  enc->line[2] = NULL;
-
-  return TRUE;
-}
-
 static gboolean
 gst_jpegenc_stop (GstVideoEncoder * benc)
 {
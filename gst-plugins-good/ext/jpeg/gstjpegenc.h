@@ -24,6 +24,7 @@
 #define __GST_JPEGENC_H__
 
 
+#include <setjmp.h>
 #include <gst/gst.h>
 #include <gst/video/video.h>
 #include <gst/video/gstvideoencoder.h>
@@ -48,15 +49,37 @@ G_BEGIN_DECLS
 
 typedef struct _GstJpegEnc GstJpegEnc;
 typedef struct _GstJpegEncClass GstJpegEncClass;
+typedef struct _GstJpegEncContext GstJpegEncContext;
+
+struct GstJpegEncErrorMgr {
+  struct jpeg_error_mgr    pub;   /* public fields */
+  jmp_buf                  setjmp_buffer;
+};
+
+/* libjpeg state for compressing one frame at a time, each thread that
+ * encodes frames uses its own */
+struct _GstJpegEncContext
+{
+  GstJpegEnc *enc;
+
+  /* the jpeg line buffer */
+  guchar **line[3];
+  /* indirect encoding line buffers */
+  guchar *row[3][4 * DCTSIZE];
+
+  struct jpeg_compress_struct cinfo;
+  struct GstJpegEncErrorMgr jerr;
+  struct jpeg_destination_mgr jdest;
+
+  GstMemory *output_mem;
+  GstMapInfo output_map;
+};
 
 struct _GstJpegEnc
 {
   GstVideoEncoder encoder;
 
   GstVideoCodecState *input_state;
-  GstVideoFrame current_vframe;
-  GstVideoCodecFrame *current_frame;
-  GstFlowReturn res;
 
   guint channels;
 
@@ -71,22 +94,18 @@ struct _GstJpegEnc
   gint sof_marker;
   /* the video buffer */
   gint bufsize;
-  /* the jpeg line buffer */
-  guchar **line[3];
-  /* indirect encoding line buffers */
-  guchar *row[3][4 * DCTSIZE];
-
-  struct jpeg_compress_struct cinfo;
-  struct jpeg_error_mgr jerr;
-  struct jpeg_destination_mgr jdest;
 
   /* properties */
   gint quality;
   gint smoothing;
   gint idct_method;
 
-  GstMemory *output_mem;
-  GstMapInfo output_map;
+  /* the image of the last frame that was pushed, for repeats */
+  GstMemory *last_image;
+
+  /* unused encoding contexts, protected by lock */
+  GMutex lock;
+  GSList *contexts;
 };
 
 struct _GstJpegEncClass
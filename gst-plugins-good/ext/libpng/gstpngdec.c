@@ -41,11 +41,6 @@
 GST_DEBUG_CATEGORY_STATIC (pngdec_debug);
 #define GST_CAT_DEFAULT pngdec_debug
 
-static gboolean gst_pngdec_libpng_init (GstPngDec * pngdec);
-static gboolean gst_pngdec_reset (GstVideoDecoder * decoder, gboolean hard);
-
-static GstFlowReturn gst_pngdec_caps_create_and_set (GstPngDec * pngdec);
-
 static gboolean gst_pngdec_start (GstVideoDecoder * decoder);
 static gboolean gst_pngdec_stop (GstVideoDecoder * decoder);
 static gboolean gst_pngdec_set_format (GstVideoDecoder * Decoder,
@@ -54,6 +49,8 @@ static GstFlowReturn gst_pngdec_parse (GstVideoDecoder * decoder,
     GstVideoCodecFrame * frame, GstAdapter * adapter, gboolean at_eos);
 static GstFlowReturn gst_pngdec_handle_frame (GstVideoDecoder * decoder,
     GstVideoCodecFrame * frame);
+static GstFlowReturn gst_pngdec_decode_frame (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame);
 static gboolean gst_pngdec_decide_allocation (GstVideoDecoder * decoder,
     GstQuery * query);
 
@@ -92,10 +89,10 @@ gst_pngdec_class_init (GstPngDecClass * klass)
 
   vdec_class->start = gst_pngdec_start;
   vdec_class->stop = gst_pngdec_stop;
-  vdec_class->reset = gst_pngdec_reset;
   vdec_class->set_format = gst_pngdec_set_format;
   vdec_class->parse = gst_pngdec_parse;
   vdec_class->handle_frame = gst_pngdec_handle_frame;
+  vdec_class->decode_frame = gst_pngdec_decode_frame;
   vdec_class->decide_allocation = gst_pngdec_decide_allocation;
 
   GST_DEBUG_CATEGORY_INIT (pngdec_debug, "pngdec", 0, "PNG image decoder");
@@ -104,13 +101,6 @@ gst_pngdec_class_init (GstPngDecClass * klass)
 static void
 gst_pngdec_init (GstPngDec * pngdec)
 {
-  pngdec->png = NULL;
-  pngdec->info = NULL;
-  pngdec->endinfo = NULL;
-
-  pngdec->color_type = -1;
-
-  pngdec->image_ready = FALSE;
 }
 
 static void
@@ -125,32 +115,6 @@ user_warning_fn (png_structp png_ptr, png_const_charp warning_msg)
   GST_WARNING ("%s", warning_msg);
 }
 
-static void
-user_info_callback (png_structp png_ptr, png_infop info)
-{
-  GstPngDec *pngdec = NULL;
-  GstFlowReturn ret = GST_FLOW_OK;
-
-  GST_LOG ("info ready");
-
-  pngdec = GST_PNGDEC (png_get_io_ptr (png_ptr));
-  /* Generate the caps and configure */
-  ret = gst_pngdec_caps_create_and_set (pngdec);
-  if (ret != GST_FLOW_OK) {
-    goto beach;
-  }
-
-  /* Allocate output buffer */
-  ret =
-      gst_video_decoder_allocate_output_frame (GST_VIDEO_DECODER (pngdec),
-      pngdec->current_frame);
-  if (G_UNLIKELY (ret != GST_FLOW_OK))
-    GST_DEBUG_OBJECT (pngdec, "failed to acquire buffer");
-
-beach:
-  pngdec->ret = ret;
-}
-
 static gboolean
 gst_pngdec_set_format (GstVideoDecoder * decoder, GstVideoCodecState * state)
 {
@@ -171,85 +135,113 @@ gst_pngdec_set_format (GstVideoDecoder * decoder, GstVideoCodecState * state)
   return TRUE;
 }
 
-static void
-user_endrow_callback (png_structp png_ptr, png_bytep new_row,
-    png_uint_32 row_num, int pass)
+/* libpng state to read one complete image from memory. Every frame is read
+ * with its own state, so that frames can be decoded on multiple threads */
+typedef struct
 {
-  GstPngDec *pngdec = NULL;
-
-  pngdec = GST_PNGDEC (png_get_io_ptr (png_ptr));
+  GstPngDec *pngdec;
 
-  /* FIXME: implement interlaced pictures */
+  png_structp png;
+  png_infop info;
 
-  /* If buffer_out doesn't exist, it means buffer_alloc failed, which 
-   * will already have set the return code */
-  if (GST_IS_BUFFER (pngdec->current_frame->output_buffer)) {
-    GstVideoFrame frame;
-    GstBuffer *buffer = pngdec->current_frame->output_buffer;
-    size_t offset;
-    gint width;
-    guint8 *data;
+  const guint8 *data;
+  gsize size;
+  gsize offset;
+} GstPngDecImage;
 
-    if (!gst_video_frame_map (&frame, &pngdec->output_state->info, buffer,
-            GST_MAP_WRITE)) {
-      pngdec->ret = GST_FLOW_ERROR;
-      return;
-    }
+static void
+user_read_data (png_structp png_ptr, png_bytep data, png_size_t length)
+{
+  GstPngDecImage *image = png_get_io_ptr (png_ptr);
 
-    data = GST_VIDEO_FRAME_COMP_DATA (&frame, 0);
-    offset = row_num * GST_VIDEO_FRAME_COMP_STRIDE (&frame, 0);
-    GST_LOG ("got row %u, copying in buffer %p at offset %" G_GSIZE_FORMAT,
-        (guint) row_num, pngdec->current_frame->output_buffer, offset);
-    width = GST_ROUND_UP_4 (png_get_rowbytes (pngdec->png, pngdec->info));
-    memcpy (data + offset, new_row, width);
-    gst_video_frame_unmap (&frame);
-    pngdec->ret = GST_FLOW_OK;
+  if (G_UNLIKELY (image->size - image->offset < length)) {
+    png_error (png_ptr, "premature end of image data");
+    return;
   }
+
+  memcpy (data, image->data + image->offset, length);
+  image->offset += length;
 }
 
-static void
-user_end_callback (png_structp png_ptr, png_infop info)
+static gboolean
+gst_pngdec_image_init (GstPngDec * pngdec, GstPngDecImage * image,
+    const guint8 * data, gsize size)
 {
-  GstPngDec *pngdec = NULL;
+  GST_LOG_OBJECT (pngdec, "init libpng structures");
 
-  pngdec = GST_PNGDEC (png_get_io_ptr (png_ptr));
+  memset (image, 0, sizeof (GstPngDecImage));
+  image->pngdec = pngdec;
+  image->data = data;
+  image->size = size;
 
-  GST_LOG_OBJECT (pngdec, "and we are done reading this image");
+  /* initialize png struct stuff */
+  image->png = png_create_read_struct (PNG_LIBPNG_VER_STRING,
+      (png_voidp) NULL, user_error_fn, user_warning_fn);
+  if (image->png == NULL)
+    goto init_failed;
 
-  if (!pngdec->current_frame->output_buffer)
-    return;
+  image->info = png_create_info_struct (image->png);
+  if (image->info == NULL)
+    goto info_failed;
 
-  gst_buffer_unmap (pngdec->current_frame->input_buffer,
-      &pngdec->current_frame_map);
+  png_set_read_fn (image->png, image, user_read_data);
 
-  pngdec->ret =
-      gst_video_decoder_finish_frame (GST_VIDEO_DECODER (pngdec),
-      pngdec->current_frame);
+  return TRUE;
 
-  pngdec->image_ready = TRUE;
+  /* ERRORS */
+init_failed:
+  {
+    GST_ELEMENT_ERROR (pngdec, LIBRARY, INIT, (NULL),
+        ("Failed to initialize png structure"));
+    return FALSE;
+  }
+info_failed:
+  {
+    png_destroy_read_struct (&image->png, NULL, NULL);
+    GST_ELEMENT_ERROR (pngdec, LIBRARY, INIT, (NULL),
+        ("Failed to initialize info structure"));
+    return FALSE;
+  }
 }
 
+static void
+gst_pngdec_image_clear (GstPngDecImage * image)
+{
+  GST_LOG_OBJECT (image->pngdec, "cleaning up libpng structures");
 
-static GstFlowReturn
-gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
+  png_destroy_read_struct (&image->png, &image->info, NULL);
+  image->png = NULL;
+  image->info = NULL;
+}
+
+/* Reads the header and sets up the transformations to one of our output
+ * formats. @format is GST_VIDEO_FORMAT_UNKNOWN if the image can't be
+ * converted to any of them */
+static gboolean
+gst_pngdec_image_read_info (GstPngDecImage * image, GstVideoFormat * format,
+    png_uint_32 * width, png_uint_32 * height)
 {
-  GstFlowReturn ret = GST_FLOW_OK;
+  GstPngDec *pngdec = image->pngdec;
   gint bpc = 0, color_type;
-  png_uint_32 width, height;
-  GstVideoFormat format = GST_VIDEO_FORMAT_UNKNOWN;
 
-  g_return_val_if_fail (GST_IS_PNGDEC (pngdec), GST_FLOW_ERROR);
+  /* Let libpng come back here on error */
+  if (setjmp (png_jmpbuf (image->png))) {
+    GST_WARNING_OBJECT (pngdec, "error while reading header");
+    return FALSE;
+  }
+
+  png_read_info (image->png, image->info);
 
   /* Get bits per channel */
-  bpc = png_get_bit_depth (pngdec->png, pngdec->info);
+  bpc = png_get_bit_depth (image->png, image->info);
 
   /* Get Color type */
-  color_type = png_get_color_type (pngdec->png, pngdec->info);
+  color_type = png_get_color_type (image->png, image->info);
 
   /* Add alpha channel if 16-bit depth, but not for GRAY images */
   if ((bpc > 8) && (color_type != PNG_COLOR_TYPE_GRAY)) {
-    png_set_add_alpha (pngdec->png, 0xffff, PNG_FILLER_BEFORE);
-    png_set_swap (pngdec->png);
+    png_set_add_alpha (image->png, 0xffff, PNG_FILLER_BEFORE);
+    png_set_swap (image->png);
   }
 #if 0
   /* We used to have this HACK to reverse the outgoing bytes, but the problem
@@ -257,14 +249,14 @@ gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
    * RGBA descriptions. It doesn't seem needed now that's fixed, but might
    * still be needed on big-endian systems, I'm not sure. J.S. 6/7/2007 */
   if (color_type == PNG_COLOR_TYPE_RGB_ALPHA)
-    png_set_bgr (pngdec->png);
+    png_set_bgr (image->png);
 #endif
 
   /* Gray scale with alpha channel converted to RGB */
   if (color_type == PNG_COLOR_TYPE_GRAY_ALPHA) {
     GST_LOG_OBJECT (pngdec,
         "converting grayscale png with alpha channel to RGB");
-    png_set_gray_to_rgb (pngdec->png);
+    png_set_gray_to_rgb (image->png);
   }
 
   /* Gray scale converted to upscaled to 8 bits */
@@ -273,9 +265,9 @@ gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
     if (bpc < 8) {              /* Convert to 8 bits */
       GST_LOG_OBJECT (pngdec, "converting grayscale image to 8 bits");
 #if PNG_LIBPNG_VER < 10400
-      png_set_gray_1_2_4_to_8 (pngdec->png);
+      png_set_gray_1_2_4_to_8 (image->png);
 #else
-      png_set_expand_gray_1_2_4_to_8 (pngdec->png);
+      png_set_expand_gray_1_2_4_to_8 (image->png);
 #endif
     }
   }
@@ -283,52 +275,74 @@ gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
   /* Palette converted to RGB */
   if (color_type == PNG_COLOR_TYPE_PALETTE) {
     GST_LOG_OBJECT (pngdec, "converting palette png to RGB");
-    png_set_palette_to_rgb (pngdec->png);
+    png_set_palette_to_rgb (image->png);
   }
 
+  /* Let libpng combine the passes of interlaced images */
+  png_set_interlace_handling (image->png);
+
   /* Update the info structure */
-  png_read_update_info (pngdec->png, pngdec->info);
+  png_read_update_info (image->png, image->info);
 
   /* Get IHDR header again after transformation settings */
-  png_get_IHDR (pngdec->png, pngdec->info, &width, &height,
-      &bpc, &pngdec->color_type, NULL, NULL, NULL);
+  png_get_IHDR (image->png, image->info, width, height,
+      &bpc, &color_type, NULL, NULL, NULL);
 
-  GST_LOG_OBJECT (pngdec, "this is a %dx%d PNG image", (gint) width,
-      (gint) height);
+  GST_LOG_OBJECT (pngdec, "this is a %dx%d PNG image", (gint) * width,
+      (gint) * height);
 
-  switch (pngdec->color_type) {
+  *format = GST_VIDEO_FORMAT_UNKNOWN;
+  switch (color_type) {
     case PNG_COLOR_TYPE_RGB:
       GST_LOG_OBJECT (pngdec, "we have no alpha channel, depth is 24 bits");
       if (bpc == 8)
-        format = GST_VIDEO_FORMAT_RGB;
+        *format = GST_VIDEO_FORMAT_RGB;
       break;
     case PNG_COLOR_TYPE_RGB_ALPHA:
       GST_LOG_OBJECT (pngdec,
           "we have an alpha channel, depth is 32 or 64 bits");
       if (bpc == 8)
-        format = GST_VIDEO_FORMAT_RGBA;
+        *format = GST_VIDEO_FORMAT_RGBA;
       else if (bpc == 16)
-        format = GST_VIDEO_FORMAT_ARGB64;
+        *format = GST_VIDEO_FORMAT_ARGB64;
       break;
     case PNG_COLOR_TYPE_GRAY:
       GST_LOG_OBJECT (pngdec,
           "We have an gray image, depth is 8 or 16 (be) bits");
       if (bpc == 8)
-        format = GST_VIDEO_FORMAT_GRAY8;
+        *format = GST_VIDEO_FORMAT_GRAY8;
       else if (bpc == 16)
-        format = GST_VIDEO_FORMAT_GRAY16_BE;
+        *format = GST_VIDEO_FORMAT_GRAY16_BE;
       break;
     default:
       break;
   }
 
-  if (format == GST_VIDEO_FORMAT_UNKNOWN) {
-    GST_ELEMENT_ERROR (pngdec, STREAM, NOT_IMPLEMENTED, (NULL),
-        ("pngdec does not support this color type"));
-    ret = GST_FLOW_NOT_SUPPORTED;
-    goto beach;
+  return TRUE;
+}
+
+/* Reads the pixels of an image of which the header was read into @rows */
+static gboolean
+gst_pngdec_image_read_rows (GstPngDecImage * image, png_bytepp rows)
+{
+  /* Let libpng come back here on error */
+  if (setjmp (png_jmpbuf (image->png))) {
+    GST_WARNING_OBJECT (image->pngdec, "error during decoding");
+    return FALSE;
   }
 
+  png_read_image (image->png, rows);
+  png_read_end (image->png, NULL);
+
+  GST_LOG_OBJECT (image->pngdec, "and we are done reading this image");
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_pngdec_caps_create_and_set (GstPngDec * pngdec, GstVideoFormat format,
+    png_uint_32 width, png_uint_32 height)
+{
   /* Check if output state changed */
   if (pngdec->output_state) {
     GstVideoInfo *info = &pngdec->output_state->info;
@@ -336,7 +350,7 @@ gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
     if (width == GST_VIDEO_INFO_WIDTH (info) &&
         height == GST_VIDEO_INFO_HEIGHT (info) &&
         GST_VIDEO_INFO_FORMAT (info) == format) {
-      goto beach;
+      return GST_FLOW_OK;
     }
     gst_video_codec_state_unref (pngdec->output_state);
   }
@@ -348,59 +362,132 @@ gst_pngdec_caps_create_and_set (GstPngDec * pngdec)
   GST_DEBUG ("Final %d %d", GST_VIDEO_INFO_WIDTH (&pngdec->output_state->info),
       GST_VIDEO_INFO_HEIGHT (&pngdec->output_state->info));
 
-beach:
-  return ret;
+  return GST_FLOW_OK;
 }
 
+/* Reads the header on the streaming thread to configure the output and
+ * allocate the output buffer, the pixels are read in decode_frame() */
 static GstFlowReturn
 gst_pngdec_handle_frame (GstVideoDecoder * decoder, GstVideoCodecFrame * frame)
 {
   GstPngDec *pngdec = (GstPngDec *) decoder;
   GstFlowReturn ret = GST_FLOW_OK;
+  GstVideoFormat format = GST_VIDEO_FORMAT_UNKNOWN;
+  GstPngDecImage image;
+  png_uint_32 width = 0, height = 0;
+  GstMapInfo map;
+  gboolean res;
 
   GST_LOG_OBJECT (pngdec, "Got buffer, size=%u",
       (guint) gst_buffer_get_size (frame->input_buffer));
 
-  /* Let libpng come back here on error */
-  if (setjmp (png_jmpbuf (pngdec->png))) {
-    GST_WARNING_OBJECT (pngdec, "error during decoding");
+  if (!gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ)) {
+    GST_WARNING_OBJECT (pngdec, "Failed to map input buffer");
     ret = GST_FLOW_ERROR;
-    goto beach;
+    goto drop;
   }
 
-  pngdec->current_frame = frame;
+  res = gst_pngdec_image_init (pngdec, &image, map.data, map.size);
+  if (res) {
+    res = gst_pngdec_image_read_info (&image, &format, &width, &height);
+    gst_pngdec_image_clear (&image);
+  }
+  gst_buffer_unmap (frame->input_buffer, &map);
 
-  /* Progressive loading of the PNG image */
-  if (!gst_buffer_map (frame->input_buffer, &pngdec->current_frame_map,
-          GST_MAP_READ)) {
-    GST_WARNING_OBJECT (pngdec, "Failed to map input buffer");
+  if (!res) {
+    GST_ELEMENT_ERROR (pngdec, STREAM, DECODE, (NULL),
+        ("Failed to read PNG header"));
     ret = GST_FLOW_ERROR;
-    goto beach;
+    goto drop;
   }
 
-  png_process_data (pngdec->png, pngdec->info,
-      pngdec->current_frame_map.data, pngdec->current_frame_map.size);
-
-  if (pngdec->image_ready) {
-    if (1) {
-      /* Reset ourselves for the next frame */
-      gst_pngdec_reset (decoder, TRUE);
-      GST_LOG_OBJECT (pngdec, "setting up callbacks for next frame");
-      png_set_progressive_read_fn (pngdec->png, pngdec,
-          user_info_callback, user_endrow_callback, user_end_callback);
-    } else {
-      GST_LOG_OBJECT (pngdec, "sending EOS");
-      pngdec->ret = GST_FLOW_EOS;
-    }
-    pngdec->image_ready = FALSE;
+  if (format == GST_VIDEO_FORMAT_UNKNOWN) {
+    GST_ELEMENT_ERROR (pngdec, STREAM, NOT_IMPLEMENTED, (NULL),
+        ("pngdec does not support this color type"));
+    ret = GST_FLOW_NOT_SUPPORTED;
+    goto drop;
+  }
+
+  /* Generate the caps and configure */
+  ret = gst_pngdec_caps_create_and_set (pngdec, format, width, height);
+  if (ret != GST_FLOW_OK)
+    goto drop;
+
+  /* Allocate output buffer */
+  ret = gst_video_decoder_allocate_output_frame (decoder, frame);
+  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+    GST_DEBUG_OBJECT (pngdec, "failed to acquire buffer");
+    goto drop;
+  }
+
+  return gst_video_decoder_submit_frame (decoder, frame);
+
+drop:
+  gst_video_decoder_drop_frame (decoder, frame);
+  return ret;
+}
+
+/* Reads the pixels of a frame that went through handle_frame(), from any
+ * thread */
+static GstFlowReturn
+gst_pngdec_decode_frame (GstVideoDecoder * decoder, GstVideoCodecFrame * frame)
+{
+  GstPngDec *pngdec = (GstPngDec *) decoder;
+  GstFlowReturn ret = GST_FLOW_ERROR;
+  GstVideoCodecState *state;
+  GstVideoFormat format;
+  GstPngDecImage image;
+  GstVideoFrame vframe;
+  png_uint_32 width, height, i;
+  png_bytepp rows;
+  GstMapInfo map;
+
+  if (!gst_buffer_map (frame->input_buffer, &map, GST_MAP_READ)) {
+    GST_WARNING_OBJECT (pngdec, "Failed to map input buffer");
+    return GST_FLOW_ERROR;
+  }
+
+  state = gst_video_decoder_get_output_state (decoder);
+
+  if (!gst_pngdec_image_init (pngdec, &image, map.data, map.size))
+    goto done;
+
+  if (!gst_pngdec_image_read_info (&image, &format, &width, &height) ||
+      width != GST_VIDEO_INFO_WIDTH (&state->info) ||
+      height != GST_VIDEO_INFO_HEIGHT (&state->info)) {
+    GST_ELEMENT_ERROR (pngdec, STREAM, DECODE, (NULL),
+        ("Failed to read PNG header"));
+    goto clear;
+  }
+
+  if (!gst_video_frame_map (&vframe, &state->info, frame->output_buffer,
+          GST_MAP_WRITE)) {
+    GST_WARNING_OBJECT (pngdec, "Failed to map output buffer");
+    goto clear;
+  }
+
+  /* let libpng write the rows into the output buffer */
+  rows = g_new (png_bytep, height);
+  for (i = 0; i < height; i++) {
+    rows[i] = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (&vframe, 0) +
+        i * GST_VIDEO_FRAME_COMP_STRIDE (&vframe, 0);
+  }
+
+  if (gst_pngdec_image_read_rows (&image, rows)) {
+    ret = GST_FLOW_OK;
   } else {
-    /* An error happened and we have to unmap */
-    gst_buffer_unmap (pngdec->current_frame->input_buffer,
-        &pngdec->current_frame_map);
+    GST_ELEMENT_ERROR (pngdec, STREAM, DECODE, (NULL),
+        ("Failed to decode PNG image"));
   }
 
-  ret = pngdec->ret;
-beach:
+  g_free (rows);
+  gst_video_frame_unmap (&vframe);
+
+clear:
+  gst_pngdec_image_clear (&image);
+done:
+  gst_video_codec_state_unref (state);
+  gst_buffer_unmap (frame->input_buffer, &map);
 
   return ret;
 }
@@ -523,87 +610,12 @@ gst_pngdec_decide_allocation (GstVideoDecoder * bdec, GstQuery * query)
   return TRUE;
 }
 
-static gboolean
-gst_pngdec_libpng_init (GstPngDec * pngdec)
-{
-  g_return_val_if_fail (GST_IS_PNGDEC (pngdec), FALSE);
-
-  GST_LOG ("init libpng structures");
-
-  /* initialize png struct stuff */
-  pngdec->png = png_create_read_struct (PNG_LIBPNG_VER_STRING,
-      (png_voidp) NULL, user_error_fn, user_warning_fn);
-
-  if (pngdec->png == NULL)
-    goto init_failed;
-
-  pngdec->info = png_create_info_struct (pngdec->png);
-  if (pngdec->info == NULL)
-    goto info_failed;
-
-  pngdec->endinfo = png_create_info_struct (pngdec->png);
-  if (pngdec->endinfo == NULL)
-    goto endinfo_failed;
-
-  png_set_progressive_read_fn (pngdec->png, pngdec,
-      user_info_callback, user_endrow_callback, user_end_callback);
-
-  return TRUE;
-
-  /* ERRORS */
-init_failed:
-  {
-    GST_ELEMENT_ERROR (pngdec, LIBRARY, INIT, (NULL),
-        ("Failed to initialize png structure"));
-    return FALSE;
-  }
-info_failed:
-  {
-    GST_ELEMENT_ERROR (pngdec, LIBRARY, INIT, (NULL),
-        ("Failed to initialize info structure"));
-    return FALSE;
-  }
-endinfo_failed:
-  {
-    GST_ELEMENT_ERROR (pngdec, LIBRARY, INIT, (NULL),
-        ("Failed to initialize endinfo structure"));
-    return FALSE;
-  }
-}
-
-
-static void
-gst_pngdec_libpng_clear (GstPngDec * pngdec)
-{
-  png_infopp info = NULL, endinfo = NULL;
-
-  GST_LOG ("cleaning up libpng structures");
-
-  if (pngdec->info) {
-    info = &pngdec->info;
-  }
-
-  if (pngdec->endinfo) {
-    endinfo = &pngdec->endinfo;
-  }
-
-  if (pngdec->png) {
-    png_destroy_read_struct (&(pngdec->png), info, endinfo);
-    pngdec->png = NULL;
-    pngdec->info = NULL;
-    pngdec->endinfo = NULL;
-  }
-
-  pngdec->color_type = -1;
-}
-
 static gboolean
 gst_pngdec_start (GstVideoDecoder * decoder)
 {
   GstPngDec *pngdec = (GstPngDec *) decoder;
 
   gst_video_decoder_set_packetized (GST_VIDEO_DECODER (pngdec), FALSE);
-  gst_pngdec_libpng_init (pngdec);
 
   return TRUE;
 }
@@ -613,8 +625,6 @@ gst_pngdec_stop (GstVideoDecoder * decoder)
 {
   GstPngDec *pngdec = (GstPngDec *) decoder;
 
-  gst_pngdec_libpng_clear (pngdec);
-
   if (pngdec->input_state) {
     gst_video_codec_state_unref (pngdec->input_state);
     pngdec->input_state = NULL;
@@ -626,13 +636,3 @@ gst_pngdec_stop (GstVideoDecoder * decoder)
 
   return TRUE;
 }
-
-/* Clean up the libpng structures */
-static gboolean
-gst_pngdec_reset (GstVideoDecoder * decoder, gboolean hard)
-{
-  gst_pngdec_libpng_clear ((GstPngDec *) decoder);
-  gst_pngdec_libpng_init ((GstPngDec *) decoder);
-
-  return TRUE;
-}
@@ -44,18 +44,6 @@ struct _GstPngDec
 
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;
-  GstMapInfo current_frame_map;
-  GstVideoCodecFrame *current_frame;
-
-  GstFlowReturn ret;
-
-  png_structp png;
-  png_infop info;
-  png_infop endinfo;
-
-  gint color_type;
-
-  gboolean image_ready;
 };
 
 struct _GstPngDecClass
@@ -50,11 +50,13 @@ enum
 {
   PROP_0 = 0,
   PROP_LOW_LATENCY,
-  PROP_DRAIN_ON_CHANGES
+  PROP_DRAIN_ON_CHANGES,
+  PROP_PARTITION_LENGTH
 };
 
 #define DEFAULT_LOW_LATENCY FALSE
 #define DEFAULT_DRAIN_ON_CHANGES TRUE
+#define DEFAULT_PARTITION_LENGTH 0
 
 #define gst_audio_fx_base_fir_filter_parent_class parent_class
 G_DEFINE_TYPE (GstAudioFXBaseFIRFilter, gst_audio_fx_base_fir_filter,
@@ -362,6 +364,227 @@ DEFINE_FFT_PROCESS_FUNC_FIXED_CHANNELS (64, 2, double);
 #undef DEFINE_FFT_PROCESS_FUNC
 #undef DEFINE_FFT_PROCESS_FUNC_FIXED_CHANNELS
 
+/* Multiplies the spectra of the last @partitions input blocks with the
+ * frequency responses of the corresponding kernel partitions and sums up
+ * the results in @out. The spectrum of the current block is at position
+ * @pos of the ring buffer of @count spectra. */
+static void
+gst_audio_fx_base_fir_filter_accumulate_spectra (GstFFTF64Complex * out,
+    const GstFFTF64Complex * spectra, guint count, guint pos,
+    const GstFFTF64Complex * frequency_response, guint partitions,
+    guint length)
+{
+  const GstFFTF64Complex *x, *h;
+  guint i, p;
+
+  memset (out, 0, length * sizeof (GstFFTF64Complex));
+
+  for (p = 0; p < partitions; p++) {
+    x = spectra + ((pos + count - p) % count) * length;
+    h = frequency_response + p * length;
+
+    for (i = 0; i < length; i++) {
+      out[i].r += x[i].r * h[i].r - x[i].i * h[i].i;
+      out[i].i += x[i].r * h[i].i + x[i].i * h[i].r;
+    }
+  }
+}
+
+/* This implements uniformly partitioned FFT convolution, again with the
+ * overlap-save algorithm. The kernel is split into partitions of length L
+ * and the input is processed in blocks of the same length with FFTs of
+ * length 2*L, independent of the kernel length M:
+ *
+ *   Y_n = \sum_{p=0}^{P-1} X_{n-p} * H_p
+ *
+ * where X_n is the FFT of the last two input blocks, H_p the FFT of the
+ * zero padded kernel partition p and P = ceil (M / L). The second half of
+ * IFFT (Y_n) are the output samples of block n.
+ *
+ * The latency is only L instead of 3*M for the single block above, and the
+ * runtime complexity per sample is O (log L + M / L). As the input spectra
+ * don't depend on the kernel it can be replaced without a discontinuity:
+ * after a change the output of one block is calculated with both kernels
+ * and crossfaded.
+ */
+#define DEFINE_PARTITIONED_FFT_PROCESS_FUNC(width,ctype) \
+static guint \
+process_partitioned_fft_##width (GstAudioFXBaseFIRFilter * self, \
+    const g##ctype * src, g##ctype * dst, guint input_samples) \
+{ \
+  gint channels = GST_AUDIO_FILTER_CHANNELS (self); \
+  PARTITIONED_FFT_CONVOLUTION_BODY (channels); \
+}
+
+#define DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS(width,channels,ctype) \
+static guint \
+process_partitioned_fft_##channels##_##width (GstAudioFXBaseFIRFilter * self, \
+    const g##ctype * src, g##ctype * dst, guint input_samples) \
+{ \
+  PARTITIONED_FFT_CONVOLUTION_BODY (channels); \
+}
+
+#define PARTITIONED_FFT_CONVOLUTION_BODY(channels) G_STMT_START { \
+  gint i, j; \
+  guint pass; \
+  guint block_length = self->block_length; \
+  guint buffer_length = block_length / 2; \
+  guint buffer_fill = self->buffer_fill; \
+  guint partitions = self->partitions; \
+  guint frequency_response_length = self->frequency_response_length; \
+  GstFFTF64 *fft = self->fft; \
+  GstFFTF64 *ifft = self->ifft; \
+  GstFFTF64Complex *fft_buffer = self->fft_buffer; \
+  GstFFTF64Complex *spectra; \
+  gdouble *buffer = self->buffer; \
+  gdouble *out, *old_out; \
+  guint generated = 0; \
+  \
+  if (!fft_buffer) \
+    self->fft_buffer = fft_buffer = \
+        g_new (GstFFTF64Complex, frequency_response_length); \
+  \
+  /* Buffer contains the last two input blocks for every channel, the \
+   * current one in the second half, followed by space for the inverse \
+   * FFTs with the current and the previous kernel */ \
+  if (!buffer) { \
+    self->buffer_length = buffer_length; \
+    self->buffer = buffer = g_new0 (gdouble, block_length * (channels + 2)); \
+    self->buffer_fill = buffer_fill = 0; \
+    \
+    g_free (self->spectra); \
+    self->spectra_count = partitions; \
+    self->spectra_pos = 0; \
+    self->spectra = g_new0 (GstFFTF64Complex, \
+        channels * partitions * frequency_response_length); \
+    \
+    g_free (self->old_frequency_response); \
+    self->old_frequency_response = NULL; \
+  } \
+  \
+  g_assert (self->buffer_length == buffer_length); \
+  \
+  spectra = self->spectra; \
+  out = buffer + block_length * channels; \
+  old_out = out + block_length; \
+  \
+  while (input_samples) { \
+    pass = MIN (buffer_length - buffer_fill, input_samples); \
+    \
+    /* Deinterleave channels */ \
+    for (i = 0; i < pass; i++) { \
+      for (j = 0; j < channels; j++) { \
+        buffer[block_length * j + buffer_length + buffer_fill + i] = \
+            src[i * channels + j]; \
+      } \
+    } \
+    buffer_fill += pass; \
+    src += channels * pass; \
+    input_samples -= pass; \
+    \
+    /* If we don't have a complete block go out */ \
+    if (buffer_fill < buffer_length) \
+      break; \
+    \
+    for (j = 0; j < channels; j++) { \
+      GstFFTF64Complex *channel_spectra = \
+          spectra + j * self->spectra_count * frequency_response_length; \
+      \
+      /* Calculate FFT of the last two input blocks */ \
+      gst_fft_f64_fft (fft, buffer + block_length * j, \
+          channel_spectra + self->spectra_pos * frequency_response_length); \
+      \
+      gst_audio_fx_base_fir_filter_accumulate_spectra (fft_buffer, \
+          channel_spectra, self->spectra_count, self->spectra_pos, \
+          self->frequency_response, partitions, frequency_response_length); \
+      gst_fft_f64_inverse_fft (ifft, fft_buffer, out); \
+      \
+      if (self->old_frequency_response) { \
+        gst_audio_fx_base_fir_filter_accumulate_spectra (fft_buffer, \
+            channel_spectra, self->spectra_count, self->spectra_pos, \
+            self->old_frequency_response, self->old_partitions, \
+            frequency_response_length); \
+        gst_fft_f64_inverse_fft (ifft, fft_buffer, old_out); \
+        \
+        /* Crossfade from the previous kernel to the current one */ \
+        for (i = 0; i < buffer_length; i++) { \
+          gdouble w = (gdouble) (i + 1) / (buffer_length + 1); \
+          \
+          dst[i * channels + j] = w * out[buffer_length + i] + \
+              (1.0 - w) * old_out[buffer_length + i]; \
+        } \
+      } else { \
+        /* Copy the second half, the first one is the circular part */ \
+        for (i = 0; i < buffer_length; i++) \
+          dst[i * channels + j] = out[buffer_length + i]; \
+      } \
+      \
+      /* The current block is the previous one for the next pass */ \
+      memcpy (buffer + block_length * j, \
+          buffer + block_length * j + buffer_length, \
+          buffer_length * sizeof (gdouble)); \
+    } \
+    \
+    g_free (self->old_frequency_response); \
+    self->old_frequency_response = NULL; \
+    self->spectra_pos = (self->spectra_pos + 1) % self->spectra_count; \
+    \
+    generated += buffer_length; \
+    dst += channels * buffer_length; \
+    buffer_fill = 0; \
+  } \
+  \
+  /* Write back cached buffer_fill value */ \
+  self->buffer_fill = buffer_fill; \
+  \
+  return generated; \
+} G_STMT_END
+
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC (32, float);
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC (64, double);
+
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS (32, 1, float);
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS (64, 1, double);
+
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS (32, 2, float);
+DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS (64, 2, double);
+
+#undef PARTITIONED_FFT_CONVOLUTION_BODY
+#undef DEFINE_PARTITIONED_FFT_PROCESS_FUNC
+#undef DEFINE_PARTITIONED_FFT_PROCESS_FUNC_FIXED_CHANNELS
+
+/* Makes room for the spectra of at least @count blocks per channel in the
+ * ring buffer while keeping the ones of the previous blocks */
+static void
+gst_audio_fx_base_fir_filter_resize_spectra (GstAudioFXBaseFIRFilter * self,
+    guint count, gint channels)
+{
+  GstFFTF64Complex *spectra;
+  guint length = self->frequency_response_length;
+  guint old_count = self->spectra_count;
+  guint a, j;
+
+  if (count <= old_count)
+    return;
+
+  spectra = g_new0 (GstFFTF64Complex, channels * count * length);
+
+  /* The spectrum of the block a passes ago is at spectra_pos - a, the
+   * next one is written to position 0 of the new ring buffer */
+  for (j = 0; j < channels; j++) {
+    for (a = 1; a <= old_count; a++) {
+      memcpy (spectra + (j * count + count - a) * length,
+          self->spectra + (j * old_count + (self->spectra_pos + old_count -
+                  a) % old_count) * length, length * sizeof (GstFFTF64Complex));
+    }
+  }
+
+  g_free (self->spectra);
+  self->spectra = spectra;
+  self->spectra_count = count;
+  self->spectra_pos = 0;
+}
+
 /* Element class */
 static void
     gst_audio_fx_base_fir_filter_calculate_frequency_response
@@ -376,7 +599,53 @@ static void
   g_free (self->fft_buffer);
   self->fft_buffer = NULL;
 
+  self->partitions = 0;
+
   if (self->kernel && self->kernel_length >= FFT_THRESHOLD
+      && !self->low_latency && self->partition_length > 0) {
+    guint block_length, partition_length, i, p;
+    gdouble *kernel_tmp, *kernel = self->kernel;
+    GstFFTF64Complex *response;
+
+    /* The FFTs have twice the partition length, the partition length is
+     * rounded up to the next fast FFT length */
+    block_length = gst_fft_next_fast_length (2 * self->partition_length);
+    partition_length = block_length / 2;
+    self->block_length = block_length;
+    self->partitions =
+        (self->kernel_length + partition_length - 1) / partition_length;
+
+    self->fft = gst_fft_f64_new (block_length, FALSE);
+    self->ifft = gst_fft_f64_new (block_length, TRUE);
+    self->frequency_response_length = block_length / 2 + 1;
+    self->frequency_response =
+        g_new (GstFFTF64Complex,
+        self->partitions * self->frequency_response_length);
+
+    kernel_tmp = g_new (gdouble, block_length);
+    for (p = 0; p < self->partitions; p++) {
+      guint len = MIN (partition_length,
+          self->kernel_length - p * partition_length);
+
+      memset (kernel_tmp, 0, block_length * sizeof (gdouble));
+      memcpy (kernel_tmp, kernel + p * partition_length,
+          len * sizeof (gdouble));
+
+      response =
+          self->frequency_response + p * self->frequency_response_length;
+      gst_fft_f64_fft (self->fft, kernel_tmp, response);
+
+      /* Normalize to make sure IFFT(FFT(x)) == x */
+      for (i = 0; i < self->frequency_response_length; i++) {
+        response[i].r /= block_length;
+        response[i].i /= block_length;
+      }
+    }
+    g_free (kernel_tmp);
+
+    GST_DEBUG_OBJECT (self, "Using %u partitions of length %u",
+        self->partitions, partition_length);
+  } else if (self->kernel && self->kernel_length >= FFT_THRESHOLD
       && !self->low_latency) {
     guint block_length, i;
     gdouble *kernel_tmp, *kernel = self->kernel;
@@ -412,7 +681,20 @@ gst_audio_fx_base_fir_filter_select_process_function (GstAudioFXBaseFIRFilter *
 {
   switch (format) {
     case GST_AUDIO_FORMAT_F32:
-      if (self->fft && !self->low_latency) {
+      if (self->fft && !self->low_latency && self->partitions > 0) {
+        if (channels == 1)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_1_32;
+        else if (channels == 2)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_2_32;
+        else
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_32;
+      } else if (self->fft && !self->low_latency) {
         if (channels == 1)
           self->process = (GstAudioFXBaseFIRFilterProcessFunc) process_fft_1_32;
         else if (channels == 2)
@@ -429,7 +711,20 @@ gst_audio_fx_base_fir_filter_select_process_function (GstAudioFXBaseFIRFilter *
       }
       break;
     case GST_AUDIO_FORMAT_F64:
-      if (self->fft && !self->low_latency) {
+      if (self->fft && !self->low_latency && self->partitions > 0) {
+        if (channels == 1)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_1_64;
+        else if (channels == 2)
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_2_64;
+        else
+          self->process =
+              (GstAudioFXBaseFIRFilterProcessFunc)
+              process_partitioned_fft_64;
+      } else if (self->fft && !self->low_latency) {
         if (channels == 1)
           self->process = (GstAudioFXBaseFIRFilterProcessFunc) process_fft_1_64;
         else if (channels == 2)
@@ -462,6 +757,8 @@ gst_audio_fx_base_fir_filter_finalize (GObject * object)
   gst_fft_f64_free (self->ifft);
   g_free (self->frequency_response);
   g_free (self->fft_buffer);
+  g_free (self->spectra);
+  g_free (self->old_frequency_response);
   g_mutex_clear (&self->lock);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -502,6 +799,27 @@ gst_audio_fx_base_fir_filter_set_property (GObject * object, guint prop_id,
       g_mutex_unlock (&self->lock);
       break;
     }
+    case PROP_PARTITION_LENGTH:{
+      guint partition_length;
+
+      if (GST_STATE (self) >= GST_STATE_PAUSED) {
+        g_warning ("Changing the \"partition-length\" property "
+            "is only allowed in states < PAUSED");
+        return;
+      }
+
+      g_mutex_lock (&self->lock);
+      partition_length = g_value_get_uint (value);
+
+      if (self->partition_length != partition_length) {
+        self->partition_length = partition_length;
+        gst_audio_fx_base_fir_filter_calculate_frequency_response (self);
+        gst_audio_fx_base_fir_filter_select_process_function (self,
+            GST_AUDIO_FILTER_FORMAT (self), GST_AUDIO_FILTER_CHANNELS (self));
+      }
+      g_mutex_unlock (&self->lock);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -521,6 +839,9 @@ gst_audio_fx_base_fir_filter_get_property (GObject * object, guint prop_id,
     case PROP_DRAIN_ON_CHANGES:
       g_value_set_boolean (value, self->drain_on_changes);
       break;
+    case PROP_PARTITION_LENGTH:
+      g_value_set_uint (value, self->partition_length);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -573,6 +894,31 @@ gst_audio_fx_base_fir_filter_class_init (GstAudioFXBaseFIRFilterClass * klass)
           DEFAULT_DRAIN_ON_CHANGES,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioFXBaseFIRFilter::partition-length:
+   *
+   * Length of the kernel partitions in samples for FFT convolution, or 0 to
+   * process the whole kernel at once.
+   *
+   * With a partition length the kernel is split into partitions that are
+   * convolved separately, and the latency of the filter is only the
+   * partition length plus the pre-latency instead of 3 times the kernel
+   * length. This makes long kernels like room impulse responses usable
+   * in live pipelines, at the cost of some more CPU for short partitions.
+   * The kernel can then also be changed while playing without a
+   * discontinuity in the output. The length is rounded up to the next
+   * number that is a product of 2, 3 and 5.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_PARTITION_LENGTH,
+      g_param_spec_uint ("partition-length", "Partition length",
+          "Length of the kernel partitions in samples for FFT convolution "
+          "(0 = single partition). "
+          "Can only be changed in states < PAUSED!", 0, G_MAXUINT / 4,
+          DEFAULT_PARTITION_LENGTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   caps = gst_caps_from_string (ALLOWED_CAPS);
   gst_audio_filter_class_add_pad_templates (GST_AUDIO_FILTER_CLASS (klass),
       caps);
@@ -604,6 +950,7 @@ gst_audio_fx_base_fir_filter_init (GstAudioFXBaseFIRFilter * self)
 
   self->low_latency = DEFAULT_LOW_LATENCY;
   self->drain_on_changes = DEFAULT_DRAIN_ON_CHANGES;
+  self->partition_length = DEFAULT_PARTITION_LENGTH;
 
   g_mutex_init (&self->lock);
 }
@@ -671,7 +1018,7 @@ gst_audio_fx_base_fir_filter_push_residue (GstAudioFXBaseFIRFilter * self)
     gst_buffer_map (outbuf, &map, GST_MAP_READWRITE);
 
     while (gensamples < outsamples) {
-      guint step_insamples = self->block_length - self->buffer_fill;
+      guint step_insamples = self->buffer_length - self->buffer_fill;
       guint8 *zeroes = g_new0 (guint8, step_insamples * channels * bps);
       guint8 *out = g_new (guint8, self->block_length * channels * bps);
       guint step_gensamples;
@@ -679,8 +1026,8 @@ gst_audio_fx_base_fir_filter_push_residue (GstAudioFXBaseFIRFilter * self)
       step_gensamples = self->process (self, zeroes, out, step_insamples);
       g_free (zeroes);
 
-      memcpy (map.data + gensamples * bps, out, MIN (step_gensamples,
-              outsamples - gensamples) * bps);
+      memcpy (map.data + gensamples * channels * bps, out,
+          MIN (step_gensamples, outsamples - gensamples) * channels * bps);
       gensamples += MIN (step_gensamples, outsamples - gensamples);
 
       g_free (out);
@@ -779,7 +1126,10 @@ gst_audio_fx_base_fir_filter_transform_size (GstBaseTransform * base,
   bpf = GST_AUDIO_INFO_BPF (&info);
 
   size /= bpf;
-  blocklen = self->block_length - self->kernel_length + 1;
+  if (self->partitions > 0)
+    blocklen = self->block_length / 2;
+  else
+    blocklen = self->block_length - self->kernel_length + 1;
   *othersize = ((size + blocklen - 1) / blocklen) * blocklen;
   *othersize *= bpf;
 
@@ -974,7 +1324,9 @@ gst_audio_fx_base_fir_filter_query (GstBaseTransform * trans,
             GST_TIME_FORMAT " max %" GST_TIME_FORMAT,
             GST_TIME_ARGS (min), GST_TIME_ARGS (max));
 
-        if (self->fft && !self->low_latency)
+        if (self->fft && !self->low_latency && self->partitions > 0)
+          latency = self->block_length / 2 + self->latency;
+        else if (self->fft && !self->low_latency)
           latency = self->block_length - self->kernel_length + 1;
         else
           latency = self->latency;
@@ -1032,7 +1384,7 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
     gdouble * kernel, guint kernel_length, guint64 latency,
     const GstAudioInfo * info)
 {
-  gboolean latency_changed;
+  gboolean latency_changed, crossfade;
   GstAudioFormat format;
   gint channels;
 
@@ -1047,6 +1399,20 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
       || (!self->low_latency && self->kernel_length >= FFT_THRESHOLD
           && kernel_length < FFT_THRESHOLD));
 
+  if (info) {
+    format = GST_AUDIO_INFO_FORMAT (info);
+    channels = GST_AUDIO_INFO_CHANNELS (info);
+  } else {
+    format = GST_AUDIO_FILTER_FORMAT (self);
+    channels = GST_AUDIO_FILTER_CHANNELS (self);
+  }
+
+  /* The input spectra kept for partitioned FFT convolution don't depend on
+   * the kernel, so it can continue without draining and crossfade from the
+   * previous kernel, even if the kernel length changes */
+  crossfade = (self->buffer && self->drain_on_changes && !latency_changed
+      && self->partitions > 0 && channels == GST_AUDIO_FILTER_CHANNELS (self));
+
   /* FIXME: If the latency changes, the buffer size changes too and we
    * have to drain in any case until this is fixed in the future */
   if (self->buffer && (!self->drain_on_changes || latency_changed)) {
@@ -1059,7 +1425,8 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
   }
 
   g_free (self->kernel);
-  if (!self->drain_on_changes || latency_changed) {
+  if (!self->drain_on_changes || latency_changed || (self->partitions > 0
+          && !crossfade)) {
     g_free (self->buffer);
     self->buffer = NULL;
     self->buffer_fill = 0;
@@ -1069,17 +1436,20 @@ gst_audio_fx_base_fir_filter_set_kernel (GstAudioFXBaseFIRFilter * self,
   self->kernel = kernel;
   self->kernel_length = kernel_length;
 
-  if (info) {
-    format = GST_AUDIO_INFO_FORMAT (info);
-    channels = GST_AUDIO_INFO_CHANNELS (info);
-  } else {
-    format = GST_AUDIO_FILTER_FORMAT (self);
-    channels = GST_AUDIO_FILTER_CHANNELS (self);
+  if (crossfade) {
+    g_free (self->old_frequency_response);
+    self->old_frequency_response = self->frequency_response;
+    self->old_partitions = self->partitions;
+    self->frequency_response = NULL;
   }
 
   gst_audio_fx_base_fir_filter_calculate_frequency_response (self);
   gst_audio_fx_base_fir_filter_select_process_function (self, format, channels);
 
+  if (crossfade)
+    gst_audio_fx_base_fir_filter_resize_spectra (self, self->partitions,
+        channels);
+
   if (latency_changed) {
     self->latency = latency;
     gst_element_post_message (GST_ELEMENT (self),
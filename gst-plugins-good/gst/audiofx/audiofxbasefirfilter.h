@@ -64,6 +64,9 @@ struct _GstAudioFXBaseFIRFilter {
 
   gboolean drain_on_changes;    /* If the filter should be drained when
                                  * coeficients change */
+  guint partition_length;       /* length of the kernel partitions for
+                                 * partitioned FFT convolution, 0 to use
+                                 * a single block */
 
   /* < private > */
   GstAudioFXBaseFIRFilterProcessFunc process;
@@ -80,6 +83,15 @@ struct _GstAudioFXBaseFIRFilter {
   GstFFTF64Complex *fft_buffer;          /* FFT buffer, has the length of the frequency response */
   guint block_length;                    /* Length of the processing blocks -- time domain */
 
+  /* partitioned FFT convolution specific data, frequency_response then
+   * contains the responses of all partitions one after another */
+  guint partitions;                      /* number of kernel partitions, 0 if not partitioned */
+  GstFFTF64Complex *spectra;             /* ring buffer of the input spectra of the last blocks, per channel */
+  guint spectra_count;                   /* number of spectra in the ring buffer per channel */
+  guint spectra_pos;                     /* position of the next spectrum in the ring buffer */
+  GstFFTF64Complex *old_frequency_response; /* previous kernel to crossfade from after a kernel change */
+  guint old_partitions;                  /* number of partitions of the previous kernel */
+
   GstClockTime start_ts;        /* start timestamp after a discont */
   guint64 start_off;            /* start offset after a discont */
   guint64 nsamples_out;         /* number of output samples since last discont */
@@ -66,6 +66,7 @@ GST_DEBUG_CATEGORY_STATIC (aacparse_debug);
 
 #define ADIF_MAX_SIZE 40        /* Should be enough */
 #define ADTS_MAX_SIZE 10        /* Should be enough */
+#define ADTS_HEADER_SIZE 7      /* without CRC */
 #define LOAS_MAX_SIZE 3         /* Should be enough */
 
 
@@ -893,6 +894,92 @@ gst_aac_parse_detect_stream (GstAacParse * aacparse,
 }
 
 
+/**
+ * gst_aac_parse_index_adts_frames:
+ * @aacparse: #GstAacParse.
+ * @frame: #GstBaseParseFrame that was found at the start of @data.
+ * @data: Data available for parsing.
+ * @avail: Size of the given datablock.
+ * @framesize: Size of @frame in bytes.
+ *
+ * Adds index entries for the ADTS frames following @frame that are already
+ * available in @data, so seeking is accurate for all data that has been
+ * seen and not only for the frames that were pushed. Frame times are counted
+ * up from the first frame the same way #GstBaseParse interpolates them, so
+ * only one contiguous run of frames is indexed. Once that run reaches the end
+ * of the stream its time is the exact duration.
+ */
+static void
+gst_aac_parse_index_adts_frames (GstAacParse * aacparse,
+    GstBaseParseFrame * frame, const guint8 * data, guint avail,
+    guint framesize)
+{
+  GstBaseParse *parse = GST_BASE_PARSE (aacparse);
+  /* sync, id, layer, protection, profile, rate and channels */
+  const guint32 fixed_mask = 0xfffffdc0;
+  GstClockTime frame_duration;
+  guint32 header;
+  guint64 start, end;
+
+  if (G_UNLIKELY (aacparse->sample_rate <= 0))
+    return;
+
+  frame_duration = gst_util_uint64_scale (GST_SECOND, aacparse->frame_samples,
+      aacparse->sample_rate);
+
+  /* GstBaseParse indexes the first frame itself */
+  if (aacparse->index_offset == GST_BUFFER_OFFSET_NONE) {
+    if (!GST_BUFFER_DTS_IS_VALID (frame->buffer))
+      return;
+    aacparse->index_offset = frame->offset + framesize;
+    aacparse->index_time = GST_BUFFER_DTS (frame->buffer) + frame_duration;
+    return;
+  }
+
+  if (aacparse->upstream_size == -1) {
+    if (!gst_pad_peer_query_duration (GST_BASE_PARSE_SINK_PAD (parse),
+            GST_FORMAT_BYTES, &aacparse->upstream_size))
+      aacparse->upstream_size = 0;
+    GST_DEBUG_OBJECT (aacparse, "upstream size %" G_GINT64_FORMAT,
+        aacparse->upstream_size);
+  }
+  if (aacparse->upstream_size <= 0)
+    return;
+
+  /* not contiguous with the indexed run, e.g. after a seek */
+  if (frame->offset > aacparse->index_offset)
+    return;
+
+  header = GST_READ_UINT32_BE (data);
+  start = aacparse->index_offset;
+  end = frame->offset + avail;
+  while (aacparse->index_offset + ADTS_HEADER_SIZE <= end) {
+    const guint8 *next = data + (aacparse->index_offset - frame->offset);
+    guint next_framesize;
+
+    if ((GST_READ_UINT32_BE (next) & fixed_mask) != (header & fixed_mask))
+      break;
+
+    next_framesize = gst_aac_parse_adts_get_frame_len (next);
+    if (next_framesize < ADTS_HEADER_SIZE)
+      break;
+
+    gst_base_parse_add_index_entry (parse, aacparse->index_offset,
+        aacparse->index_time, TRUE, FALSE);
+    aacparse->index_offset += next_framesize;
+    aacparse->index_time += frame_duration;
+  }
+
+  if (aacparse->index_offset != start &&
+      aacparse->index_offset == aacparse->upstream_size) {
+    GST_DEBUG_OBJECT (aacparse, "indexed all frames, duration %"
+        GST_TIME_FORMAT, GST_TIME_ARGS (aacparse->index_time));
+    gst_base_parse_set_duration (parse, GST_FORMAT_TIME, aacparse->index_time,
+        0);
+  }
+}
+
+
 /**
  * gst_aac_parse_check_valid_frame:
  * @parse: #GstBaseParse.
@@ -1037,6 +1124,11 @@ gst_aac_parse_handle_frame (GstBaseParse * parse,
   }
 
 exit:
+  if (ret && *skipsize <= 0 && framesize <= map.size &&
+      aacparse->header_type == DSPAAC_HEADER_ADTS)
+    gst_aac_parse_index_adts_frames (aacparse, frame, map.data, map.size,
+        framesize);
+
   gst_buffer_unmap (buffer, &map);
 
   if (ret) {
@@ -1073,6 +1165,9 @@ gst_aac_parse_start (GstBaseParse * parse)
   aacparse = GST_AAC_PARSE (parse);
   GST_DEBUG ("start");
   aacparse->frame_samples = 1024;
+  aacparse->index_offset = GST_BUFFER_OFFSET_NONE;
+  aacparse->index_time = 0;
+  aacparse->upstream_size = -1;
   gst_base_parse_set_min_frame_size (GST_BASE_PARSE (aacparse), ADTS_MAX_SIZE);
   return TRUE;
 }
@@ -80,6 +80,12 @@ struct _GstAacParse {
   gint           frame_samples;
 
   GstAacHeaderType header_type;
+
+  /* index of the run of consecutive ADTS frames seen so far;
+   * offset and time of the next frame to be indexed */
+  guint64        index_offset;
+  GstClockTime   index_time;
+  gint64         upstream_size;
 };
 
 /**
@@ -643,7 +643,8 @@ gst_flac_parse_frame_is_valid (GstFlacParse * flacparse,
 {
   GstBuffer *buffer;
   GstMapInfo map;
-  guint max, remaining;
+  GstByteReader reader;
+  guint max, scan_end;
   guint i, search_start, search_end;
   FrameHeaderCheckReturn header_ret;
   guint16 block_size;
@@ -674,15 +675,28 @@ gst_flac_parse_frame_is_valid (GstFlacParse * flacparse,
     search_end = map.size;
   search_end -= 2;
 
-  remaining = map.size;
+  /* the sync code of the next frame is searched with the (vectorized) byte
+   * reader scan, which needs 4 bytes at each position, so the last position
+   * that it doesn't cover is checked directly */
+  gst_byte_reader_init (&reader, map.data, map.size);
+  scan_end = MIN (search_end + 3, map.size);
+
+  for (i = search_start; i < search_end; i++) {
+    if (i + 4 <= scan_end) {
+      gint off = gst_byte_reader_masked_scan_uint32 (&reader, 0xfffe0000,
+          0xfff80000, i, scan_end - i);
+
+      i = (off < 0) ? scan_end - 3 : off;
+      if (i >= search_end)
+        break;
+    }
 
-  for (i = search_start; i < search_end; i++, remaining--) {
     if ((GST_READ_UINT16_BE (map.data + i) & 0xfffe) == 0xfff8) {
       GST_LOG_OBJECT (flacparse, "possible frame end at offset %d", i);
       suspect_end = FALSE;
       header_ret =
           gst_flac_parse_frame_header_is_valid (flacparse, map.data + i,
-          remaining, FALSE, NULL, &suspect_end);
+          map.size - i, FALSE, NULL, &suspect_end);
       if (header_ret == FRAME_HEADER_VALID) {
         if (flacparse->check_frame_checksums || suspect_start || suspect_end) {
           guint16 actual_crc = gst_flac_calculate_crc16 (map.data, i - 2);
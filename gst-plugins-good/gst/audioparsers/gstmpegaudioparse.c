@@ -219,6 +219,10 @@ gst_mpeg_audio_parse_reset (GstMpegAudioParse * mp3parse)
 
   mp3parse->encoder_delay = 0;
   mp3parse->encoder_padding = 0;
+
+  mp3parse->index_offset = GST_BUFFER_OFFSET_NONE;
+  mp3parse->index_time = 0;
+  mp3parse->upstream_size = -1;
 }
 
 static void
@@ -597,6 +601,89 @@ gst_mp3parse_find_freerate (GstMpegAudioParse * mp3parse, GstMapInfo * map,
   return TRUE;
 }
 
+/* Adds index entries for the frames following @frame that are already
+ * available in @map, so that seeking in VBR streams without a seek table is
+ * accurate for all data that has been seen and not only for the frames that
+ * were pushed. Frame times are counted up from the first frame the same way
+ * GstBaseParse interpolates them, so only one contiguous run of frames is
+ * indexed. Once that run reaches the end of the stream its time is the exact
+ * duration. */
+static void
+gst_mpeg_audio_parse_index_frames (GstMpegAudioParse * mp3parse,
+    GstBaseParseFrame * frame, GstMapInfo * map, guint32 header, guint bpf)
+{
+  GstBaseParse *parse = GST_BASE_PARSE (mp3parse);
+  GstClockTime frame_duration;
+  guint64 start, end;
+
+  frame_duration = gst_util_uint64_scale (GST_SECOND, mp3parse->spf,
+      mp3parse->rate);
+
+  /* GstBaseParse indexes the first frame itself */
+  if (mp3parse->index_offset == GST_BUFFER_OFFSET_NONE) {
+    if (!GST_BUFFER_DTS_IS_VALID (frame->buffer))
+      return;
+    mp3parse->index_offset = frame->offset + bpf;
+    mp3parse->index_time = GST_BUFFER_DTS (frame->buffer) + frame_duration;
+    return;
+  }
+
+  if (mp3parse->upstream_size == -1) {
+    if (!gst_pad_peer_query_duration (GST_BASE_PARSE_SINK_PAD (parse),
+            GST_FORMAT_BYTES, &mp3parse->upstream_size))
+      mp3parse->upstream_size = 0;
+    GST_DEBUG_OBJECT (mp3parse, "upstream size %" G_GINT64_FORMAT,
+        mp3parse->upstream_size);
+  }
+  if (mp3parse->upstream_size <= 0)
+    return;
+
+  /* not contiguous with the indexed run, e.g. after a seek */
+  if (frame->offset > mp3parse->index_offset)
+    return;
+
+  start = mp3parse->index_offset;
+  end = frame->offset + map->size;
+  while (mp3parse->index_offset + 4 <= end) {
+    guint32 next_header;
+    guint next_bpf;
+
+    next_header = GST_READ_UINT32_BE (map->data + (mp3parse->index_offset -
+            frame->offset));
+    if ((next_header & HDRMASK) != (header & HDRMASK) ||
+        ((next_header >> 12) & 0xf) == 0xf)
+      break;
+
+    next_bpf = mp3_type_frame_length_from_header (mp3parse, next_header,
+        NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    if (!next_bpf)
+      break;
+
+    gst_base_parse_add_index_entry (parse, mp3parse->index_offset,
+        mp3parse->index_time, TRUE, FALSE);
+    mp3parse->index_offset += next_bpf;
+    mp3parse->index_time += frame_duration;
+  }
+
+  if (mp3parse->index_offset == start)
+    return;
+
+  /* the run covers the whole stream, possibly followed by an ID3v1 tag */
+  if (mp3parse->index_offset == mp3parse->upstream_size ||
+      (mp3parse->index_offset + 128 == mp3parse->upstream_size &&
+          mp3parse->index_offset + 3 <= end &&
+          memcmp (map->data + (mp3parse->index_offset - frame->offset),
+              "TAG", 3) == 0)) {
+    /* seek tables are authoritative, they don't count the frame holding them */
+    if (!mp3parse->xing_total_time && !mp3parse->vbri_total_time) {
+      GST_DEBUG_OBJECT (mp3parse, "indexed all frames, duration %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (mp3parse->index_time));
+      gst_base_parse_set_duration (parse, GST_FORMAT_TIME,
+          mp3parse->index_time, 0);
+    }
+  }
+}
+
 static GstFlowReturn
 gst_mpeg_audio_parse_handle_frame (GstBaseParse * parse,
     GstBaseParseFrame * frame, gint * skipsize)
@@ -762,6 +849,9 @@ gst_mpeg_audio_parse_handle_frame (GstBaseParse * parse,
   mp3parse->last_mode = mode;
 
 cleanup:
+  if (res && bpf <= map.size)
+    gst_mpeg_audio_parse_index_frames (mp3parse, frame, &map, header, bpf);
+
   gst_buffer_unmap (buf, &map);
 
   if (res && bpf <= map.size) {
@@ -94,6 +94,12 @@ struct _GstMpegAudioParse {
   /* LAME info */
   guint32      encoder_delay;
   guint32      encoder_padding;
+
+  /* index of the run of consecutive frames seen so far;
+   * offset and time of the next frame to be indexed */
+  guint64      index_offset;
+  GstClockTime index_time;
+  gint64       upstream_size;
 };
 
 /**
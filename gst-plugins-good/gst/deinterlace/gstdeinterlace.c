@@ -46,6 +46,7 @@
 
 #include "gstdeinterlace.h"
 #include "tvtime/plugins.h"
+#include "yadif.h"
 
 #include <string.h>
 
@@ -65,6 +66,7 @@ GST_DEBUG_CATEGORY_STATIC (deinterlace_debug);
 #define DEFAULT_LOCKING         GST_DEINTERLACE_LOCKING_NONE
 #define DEFAULT_IGNORE_OBSCURE  TRUE
 #define DEFAULT_DROP_ORPHANS    TRUE
+#define DEFAULT_N_THREADS       1
 
 enum
 {
@@ -76,6 +78,7 @@ enum
   PROP_LOCKING,
   PROP_IGNORE_OBSCURE,
   PROP_DROP_ORPHANS,
+  PROP_N_THREADS,
   PROP_LAST
 };
 
@@ -164,6 +167,8 @@ static const GEnumValue methods_types[] = {
       "weavetff"},
   {GST_DEINTERLACE_WEAVE_BFF, "Progressive: Bottom Field First (Do Not Use)",
       "weavebff"},
+  {GST_DEINTERLACE_YADIF, "Motion Adaptive: Spatial and Temporal Check",
+      "yadif"},
   {0, NULL, NULL},
 };
 
@@ -365,7 +370,8 @@ static const struct
   gst_deinterlace_method_scaler_bob_get_type}, {
   gst_deinterlace_method_weave_get_type}, {
   gst_deinterlace_method_weave_tff_get_type}, {
-  gst_deinterlace_method_weave_bff_get_type}
+  gst_deinterlace_method_weave_bff_get_type}, {
+  gst_deinterlace_method_yadif_get_type}
 };
 
 static void
@@ -425,6 +431,7 @@ gst_deinterlace_set_method (GstDeinterlace * self, GstDeinterlaceMethods method)
 
   self->method = g_object_new (method_type, "name", "method", NULL);
   self->method_id = method;
+  gst_deinterlace_method_set_n_threads (self->method, self->n_threads);
 
   gst_object_set_parent (GST_OBJECT (self->method), GST_OBJECT (self));
 #if 0
@@ -588,6 +595,14 @@ gst_deinterlace_class_init (GstDeinterlaceClass * klass)
    * Progressive: Bottom Field First.  Bad quality, do not use.
    * </para>
    * </listitem>
+   * <listitem>
+   * <para>
+   * yadif
+   * Motion Adaptive: Spatial and Temporal Check.  Interpolates along edges
+   * where the picture is static and clamps to the neighbouring fields where
+   * it moves.
+   * </para>
+   * </listitem>
    * </itemizedlist>
    */
   g_object_class_install_property (gobject_class, PROP_METHOD,
@@ -672,6 +687,20 @@ gst_deinterlace_class_init (GstDeinterlaceClass * klass)
           "active locking mode.", DEFAULT_DROP_ORPHANS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDeinterlace:n-threads
+   *
+   * Maximum number of threads the simple methods (all except greedyh and
+   * tomsmocomp) use to process bands of lines of each frame. 0 uses one
+   * thread per CPU.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   element_class->change_state =
       GST_DEBUG_FUNCPTR (gst_deinterlace_change_state);
 }
@@ -727,6 +756,7 @@ gst_deinterlace_init (GstDeinterlace * self)
   gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
 
   self->mode = DEFAULT_MODE;
+  self->n_threads = DEFAULT_N_THREADS;
   self->user_set_method_id = DEFAULT_METHOD;
   gst_video_info_init (&self->vinfo);
   gst_deinterlace_set_method (self, self->user_set_method_id);
@@ -910,6 +940,13 @@ gst_deinterlace_set_property (GObject * object, guint prop_id,
     case PROP_DROP_ORPHANS:
       self->drop_orphans = g_value_get_boolean (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      self->n_threads = g_value_get_uint (value);
+      if (self->method)
+        gst_deinterlace_method_set_n_threads (self->method, self->n_threads);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
@@ -946,6 +983,11 @@ gst_deinterlace_get_property (GObject * object, guint prop_id,
     case PROP_DROP_ORPHANS:
       g_value_set_boolean (value, self->drop_orphans);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (self);
+      g_value_set_uint (value, self->n_threads);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
   }
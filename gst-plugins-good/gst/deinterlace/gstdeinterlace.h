@@ -56,7 +56,8 @@ typedef enum
   GST_DEINTERLACE_SCALER_BOB,
   GST_DEINTERLACE_WEAVE,
   GST_DEINTERLACE_WEAVE_TFF,
-  GST_DEINTERLACE_WEAVE_BFF
+  GST_DEINTERLACE_WEAVE_BFF,
+  GST_DEINTERLACE_YADIF
 } GstDeinterlaceMethods;
 
 typedef enum
@@ -175,6 +176,7 @@ struct _GstDeinterlace
   GstDeinterlaceLocking locking;
   gint low_latency;
   gboolean drop_orphans;
+  guint n_threads;
   gboolean ignore_obscure;
   gboolean pattern_lock;
   gboolean pattern_refresh;
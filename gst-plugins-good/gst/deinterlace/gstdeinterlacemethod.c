@@ -177,9 +177,24 @@ gst_deinterlace_method_setup_impl (GstDeinterlaceMethod * self,
   }
 }
 
+static void
+gst_deinterlace_method_finalize (GObject * object)
+{
+  GstDeinterlaceMethod *self = GST_DEINTERLACE_METHOD (object);
+
+  if (self->runner)
+    gst_video_slice_runner_free (self->runner);
+
+  G_OBJECT_CLASS (gst_deinterlace_method_parent_class)->finalize (object);
+}
+
 static void
 gst_deinterlace_method_class_init (GstDeinterlaceMethodClass * klass)
 {
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_deinterlace_method_finalize;
+
   klass->setup = gst_deinterlace_method_setup_impl;
   klass->supported = gst_deinterlace_method_supported_impl;
 }
@@ -188,6 +203,36 @@ static void
 gst_deinterlace_method_init (GstDeinterlaceMethod * self)
 {
   self->vinfo = NULL;
+  self->n_threads = 1;
+}
+
+void
+gst_deinterlace_method_set_n_threads (GstDeinterlaceMethod * self,
+    guint n_threads)
+{
+  GST_OBJECT_LOCK (self);
+  self->n_threads = n_threads;
+  GST_OBJECT_UNLOCK (self);
+}
+
+/* Returns the runner for processing bands of lines, only used from the
+ * streaming thread */
+static GstVideoSliceRunner *
+gst_deinterlace_method_get_runner (GstDeinterlaceMethod * self)
+{
+  guint n_threads;
+
+  GST_OBJECT_LOCK (self);
+  n_threads = self->n_threads;
+  GST_OBJECT_UNLOCK (self);
+
+  if (self->runner == NULL || self->runner_threads != n_threads) {
+    if (self->runner)
+      gst_video_slice_runner_free (self->runner);
+    self->runner = gst_video_slice_runner_new (n_threads);
+    self->runner_threads = n_threads;
+  }
+  return self->runner;
 }
 
 void
@@ -268,10 +313,14 @@ gst_deinterlace_simple_method_supported (GstDeinterlaceMethodClass * mklass,
           && klass->copy_scanline_ayuv != NULL);
     case GST_VIDEO_FORMAT_NV12:
       return (klass->interpolate_scanline_nv12 != NULL
-          && klass->copy_scanline_nv12 != NULL);
+          && klass->copy_scanline_nv12 != NULL
+          && klass->interpolate_scanline_planar_y != NULL
+          && klass->copy_scanline_planar_y != NULL);
     case GST_VIDEO_FORMAT_NV21:
       return (klass->interpolate_scanline_nv21 != NULL
-          && klass->copy_scanline_nv21 != NULL);
+          && klass->copy_scanline_nv21 != NULL
+          && klass->interpolate_scanline_planar_y != NULL
+          && klass->copy_scanline_planar_y != NULL);
     case GST_VIDEO_FORMAT_I420:
     case GST_VIDEO_FORMAT_YV12:
     case GST_VIDEO_FORMAT_Y444:
@@ -304,56 +353,39 @@ gst_deinterlace_simple_method_copy_scanline_packed (GstDeinterlaceSimpleMethod *
   memcpy (out, scanlines->m0, stride);
 }
 
-static void
-gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
-    method, const GstDeinterlaceField * history, guint history_count,
-    GstVideoFrame * outframe, gint cur_field_idx)
+/* One plane of a frame that is deinterlaced in bands of lines */
+typedef struct
 {
-  GstDeinterlaceSimpleMethod *self = GST_DEINTERLACE_SIMPLE_METHOD (method);
-  GstDeinterlaceMethodClass *dm_class = GST_DEINTERLACE_METHOD_GET_CLASS (self);
-  GstDeinterlaceScanlineData scanlines;
+  GstDeinterlaceSimpleMethod *self;
+  GstVideoFrame *dest;
+  const GstVideoFrame *frame0, *frame1, *frame2, *framep;
   guint cur_field_flags;
-  gint i;
+  gint plane;
   gint frame_height, frame_width;
-  GstVideoFrame *framep, *frame0, *frame1, *frame2;
-
-  g_assert (self->interpolate_scanline_packed != NULL);
-  g_assert (self->copy_scanline_packed != NULL);
-
-  frame_height = GST_VIDEO_FRAME_HEIGHT (outframe);
-  frame_width = GST_VIDEO_FRAME_PLANE_STRIDE (outframe, 0);
-
-  frame0 = history[cur_field_idx].frame;
-  frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame0, 0));
-  cur_field_flags = history[cur_field_idx].flags;
-
-  framep = (cur_field_idx > 0 ? history[cur_field_idx - 1].frame : NULL);
-  if (framep)
-    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (framep, 0));
-
-  g_assert (dm_class->fields_required <= 4);
-
-  frame1 =
-      (cur_field_idx + 1 <
-      history_count ? history[cur_field_idx + 1].frame : NULL);
-  if (frame1)
-    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame1, 0));
+  GstDeinterlaceSimpleMethodFunction copy_scanline;
+  GstDeinterlaceSimpleMethodFunction interpolate_scanline;
+} GstDeinterlaceSimpleMethodPlane;
 
-  frame2 =
-      (cur_field_idx + 2 <
-      history_count ? history[cur_field_idx + 2].frame : NULL);
-  if (frame2)
-    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame2, 0));
+static void
+gst_deinterlace_simple_method_plane_lines (GstDeinterlaceSimpleMethodPlane *
+    p, gint start, gint end)
+{
+  GstDeinterlaceScanlineData scanlines;
+  const GstVideoFrame *frame0 = p->frame0, *frame1 = p->frame1;
+  const GstVideoFrame *frame2 = p->frame2, *framep = p->framep;
+  gint plane = p->plane;
+  gint frame_height = p->frame_height;
+  gint i;
 
 #define CLAMP_LOW(i) (((i)<0) ? (i+2) : (i))
 #define CLAMP_HI(i) (((i)>=(frame_height)) ? (i-2) : (i))
-#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),0)) + CLAMP_HI(CLAMP_LOW(i)) * \
-    GST_VIDEO_FRAME_PLANE_STRIDE((x),0))
+#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),plane)) + CLAMP_HI(CLAMP_LOW(i)) * \
+    GST_VIDEO_FRAME_PLANE_STRIDE((x),plane))
 #define LINE2(x,i) ((x) ? LINE(x,i) : NULL)
 
-  for (i = 0; i < frame_height; i++) {
+  for (i = start; i < end; i++) {
     memset (&scanlines, 0, sizeof (scanlines));
-    scanlines.bottom_field = (cur_field_flags == PICTURE_INTERLACED_BOTTOM);
+    scanlines.bottom_field = (p->cur_field_flags == PICTURE_INTERLACED_BOTTOM);
 
     if (!((i & 1) ^ scanlines.bottom_field)) {
       /* copying */
@@ -371,8 +403,8 @@ gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
       scanlines.m2 = LINE2 (frame2, i);
       scanlines.bb2 = LINE2 (frame2, (i + 2 < frame_height ? i + 2 : i));
 
-      self->copy_scanline_packed (self, LINE (outframe, i), &scanlines,
-          frame_width);
+      p->copy_scanline (p->self, LINE (p->dest, i), &scanlines,
+          p->frame_width);
     } else {
       /* interpolating */
       scanlines.ttp = LINE2 (framep, (i - 2 >= 0) ? i - 2 : i);
@@ -389,12 +421,98 @@ gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
       scanlines.t2 = LINE2 (frame2, i - 1);
       scanlines.b2 = LINE2 (frame2, i + 1);
 
-      self->interpolate_scanline_packed (self, LINE (outframe, i), &scanlines,
-          frame_width);
+      p->interpolate_scanline (p->self, LINE (p->dest, i), &scanlines,
+          p->frame_width);
     }
+  }
+
+#undef CLAMP_LOW
+#undef CLAMP_HI
 #undef LINE
 #undef LINE2
-  }
+}
+
+static void
+gst_deinterlace_simple_method_plane_slice (gpointer user_data, guint slice,
+    guint n_slices)
+{
+  GstDeinterlaceSimpleMethodPlane *p = user_data;
+
+  gst_deinterlace_simple_method_plane_lines (p,
+      p->frame_height * slice / n_slices,
+      p->frame_height * (slice + 1) / n_slices);
+}
+
+/* Deinterlaces one plane, split into bands of lines that are processed on
+ * the threads of the method's runner. The scanline functions only read the
+ * input frames and write their own output line, so the bands are
+ * independent. */
+static void
+gst_deinterlace_simple_method_deinterlace_plane (GstDeinterlaceSimpleMethod *
+    self, GstDeinterlaceSimpleMethodPlane * p)
+{
+  GstVideoSliceRunner *runner;
+  guint n_slices;
+
+  runner = gst_deinterlace_method_get_runner (GST_DEINTERLACE_METHOD (self));
+  n_slices = MIN (gst_video_slice_runner_get_n_threads (runner),
+      MAX (p->frame_height / 16, 1));
+
+  gst_video_slice_runner_run (runner, n_slices,
+      gst_deinterlace_simple_method_plane_slice, p);
+}
+
+static void
+gst_deinterlace_simple_method_deinterlace_frame_packed (GstDeinterlaceMethod *
+    method, const GstDeinterlaceField * history, guint history_count,
+    GstVideoFrame * outframe, gint cur_field_idx)
+{
+  GstDeinterlaceSimpleMethod *self = GST_DEINTERLACE_SIMPLE_METHOD (method);
+  GstDeinterlaceMethodClass *dm_class = GST_DEINTERLACE_METHOD_GET_CLASS (self);
+  GstDeinterlaceSimpleMethodPlane p;
+  gint frame_width;
+  GstVideoFrame *framep, *frame0, *frame1, *frame2;
+
+  g_assert (self->interpolate_scanline_packed != NULL);
+  g_assert (self->copy_scanline_packed != NULL);
+
+  frame_width = GST_VIDEO_FRAME_PLANE_STRIDE (outframe, 0);
+
+  frame0 = history[cur_field_idx].frame;
+  frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame0, 0));
+
+  framep = (cur_field_idx > 0 ? history[cur_field_idx - 1].frame : NULL);
+  if (framep)
+    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (framep, 0));
+
+  g_assert (dm_class->fields_required <= 4);
+
+  frame1 =
+      (cur_field_idx + 1 <
+      history_count ? history[cur_field_idx + 1].frame : NULL);
+  if (frame1)
+    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame1, 0));
+
+  frame2 =
+      (cur_field_idx + 2 <
+      history_count ? history[cur_field_idx + 2].frame : NULL);
+  if (frame2)
+    frame_width = MIN (frame_width, GST_VIDEO_FRAME_PLANE_STRIDE (frame2, 0));
+
+  p.self = self;
+  p.dest = outframe;
+  p.frame0 = frame0;
+  p.frame1 = frame1;
+  p.frame2 = frame2;
+  p.framep = framep;
+  p.cur_field_flags = history[cur_field_idx].flags;
+  p.plane = 0;
+  p.frame_height = GST_VIDEO_FRAME_HEIGHT (outframe);
+  p.frame_width = frame_width;
+  p.copy_scanline = self->copy_scanline_packed;
+  p.interpolate_scanline = self->interpolate_scanline_packed;
+
+  gst_deinterlace_simple_method_deinterlace_plane (self, &p);
 }
 
 static void
@@ -454,63 +572,26 @@ static void
     GstDeinterlaceSimpleMethodFunction copy_scanline,
     GstDeinterlaceSimpleMethodFunction interpolate_scanline)
 {
-  GstDeinterlaceScanlineData scanlines;
-  gint i;
-  gint frame_height, frame_width;
-
-  frame_height = GST_VIDEO_FRAME_COMP_HEIGHT (dest, plane);
-  frame_width = GST_VIDEO_FRAME_COMP_WIDTH (dest, plane) *
-      GST_VIDEO_FRAME_COMP_PSTRIDE (dest, plane);
+  GstDeinterlaceSimpleMethodPlane p;
 
   g_assert (interpolate_scanline != NULL);
   g_assert (copy_scanline != NULL);
 
-#define LINE(x,i) (((guint8*)GST_VIDEO_FRAME_PLANE_DATA((x),plane)) + CLAMP_HI(CLAMP_LOW(i)) * \
-    GST_VIDEO_FRAME_PLANE_STRIDE((x),plane))
-#define LINE2(x,i) ((x) ? LINE(x,i) : NULL)
-
-  for (i = 0; i < frame_height; i++) {
-    memset (&scanlines, 0, sizeof (scanlines));
-    scanlines.bottom_field = (cur_field_flags == PICTURE_INTERLACED_BOTTOM);
-
-    if (!((i & 1) ^ scanlines.bottom_field)) {
-      /* copying */
-      scanlines.tp = LINE2 (framep, i - 1);
-      scanlines.bp = LINE2 (framep, i + 1);
-
-      scanlines.tt0 = LINE2 (frame0, (i - 2 >= 0) ? i - 2 : i);
-      scanlines.m0 = LINE2 (frame0, i);
-      scanlines.bb0 = LINE2 (frame0, (i + 2 < frame_height ? i + 2 : i));
-
-      scanlines.t1 = LINE2 (frame1, i - 1);
-      scanlines.b1 = LINE2 (frame1, i + 1);
-
-      scanlines.tt2 = LINE2 (frame2, (i - 2 >= 0) ? i - 2 : i);
-      scanlines.m2 = LINE2 (frame2, i);
-      scanlines.bb2 = LINE2 (frame2, (i + 2 < frame_height ? i + 2 : i));
-
-      copy_scanline (self, LINE (dest, i), &scanlines, frame_width);
-    } else {
-      /* interpolating */
-      scanlines.ttp = LINE2 (framep, (i - 2 >= 0) ? i - 2 : i);
-      scanlines.mp = LINE2 (framep, i);
-      scanlines.bbp = LINE2 (framep, (i + 2 < frame_height ? i + 2 : i));
-
-      scanlines.t0 = LINE2 (frame0, i - 1);
-      scanlines.b0 = LINE2 (frame0, i + 1);
-
-      scanlines.tt1 = LINE2 (frame1, (i - 2 >= 0) ? i - 2 : i);
-      scanlines.m1 = LINE2 (frame1, i);
-      scanlines.bb1 = LINE2 (frame1, (i + 2 < frame_height ? i + 2 : i));
-
-      scanlines.t2 = LINE2 (frame2, i - 1);
-      scanlines.b2 = LINE2 (frame2, i + 1);
+  p.self = self;
+  p.dest = dest;
+  p.frame0 = frame0;
+  p.frame1 = frame1;
+  p.frame2 = frame2;
+  p.framep = framep;
+  p.cur_field_flags = cur_field_flags;
+  p.plane = plane;
+  p.frame_height = GST_VIDEO_FRAME_COMP_HEIGHT (dest, plane);
+  p.frame_width = GST_VIDEO_FRAME_COMP_WIDTH (dest, plane) *
+      GST_VIDEO_FRAME_COMP_PSTRIDE (dest, plane);
+  p.copy_scanline = copy_scanline;
+  p.interpolate_scanline = interpolate_scanline;
 
-      interpolate_scanline (self, LINE (dest, i), &scanlines, frame_width);
-    }
-#undef LINE
-#undef LINE2
-  }
+  gst_deinterlace_simple_method_deinterlace_plane (self, &p);
 }
 
 static void
@@ -566,11 +647,24 @@ gst_deinterlace_simple_method_deinterlace_frame_nv12 (GstDeinterlaceMethod *
   const GstVideoFrame *frame0, *frame1, *frame2, *framep;
   guint cur_field_flags = history[cur_field_idx].flags;
   gint i;
+  GstDeinterlaceSimpleMethodFunction copy_scanline;
+  GstDeinterlaceSimpleMethodFunction interpolate_scanline;
 
   g_assert (self->interpolate_scanline_packed != NULL);
   g_assert (self->copy_scanline_packed != NULL);
+  g_assert (self->interpolate_scanline_planar[0] != NULL);
+  g_assert (self->copy_scanline_planar[0] != NULL);
 
   for (i = 0; i < 2; i++) {
+    /* only the chroma is interleaved, the luma is an ordinary plane */
+    if (i == 0) {
+      copy_scanline = self->copy_scanline_planar[0];
+      interpolate_scanline = self->interpolate_scanline_planar[0];
+    } else {
+      copy_scanline = self->copy_scanline_packed;
+      interpolate_scanline = self->interpolate_scanline_packed;
+    }
+
     framep = (cur_field_idx > 0 ? history[cur_field_idx - 1].frame : NULL);
 
     frame0 = history[cur_field_idx].frame;
@@ -586,7 +680,7 @@ gst_deinterlace_simple_method_deinterlace_frame_nv12 (GstDeinterlaceMethod *
 
     gst_deinterlace_simple_method_deinterlace_frame_planar_plane (self,
         outframe, frame0, frame1, frame2, framep, cur_field_flags, i,
-        self->copy_scanline_packed, self->interpolate_scanline_packed);
+        copy_scanline, interpolate_scanline);
   }
 }
 
@@ -662,10 +756,16 @@ gst_deinterlace_simple_method_setup (GstDeinterlaceMethod * method,
     case GST_VIDEO_FORMAT_NV12:
       self->interpolate_scanline_packed = klass->interpolate_scanline_nv12;
       self->copy_scanline_packed = klass->copy_scanline_nv12;
+      self->interpolate_scanline_planar[0] =
+          klass->interpolate_scanline_planar_y;
+      self->copy_scanline_planar[0] = klass->copy_scanline_planar_y;
       break;
     case GST_VIDEO_FORMAT_NV21:
       self->interpolate_scanline_packed = klass->interpolate_scanline_nv21;
       self->copy_scanline_packed = klass->copy_scanline_nv21;
+      self->interpolate_scanline_planar[0] =
+          klass->interpolate_scanline_planar_y;
+      self->copy_scanline_planar[0] = klass->copy_scanline_planar_y;
       break;
     case GST_VIDEO_FORMAT_I420:
     case GST_VIDEO_FORMAT_YV12:
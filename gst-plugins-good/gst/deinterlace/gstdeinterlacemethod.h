@@ -70,6 +70,12 @@ struct _GstDeinterlaceMethod {
   GstVideoInfo *vinfo;
 
   GstDeinterlaceMethodDeinterlaceFunction deinterlace_frame;
+
+  /* methods that support it process bands of lines on up to n_threads
+   * threads, protected by the object lock */
+  guint n_threads;
+  GstVideoSliceRunner *runner;
+  guint runner_threads;
 };
 
 struct _GstDeinterlaceMethodClass {
@@ -111,6 +117,7 @@ void gst_deinterlace_method_deinterlace_frame (GstDeinterlaceMethod * self, cons
     int cur_field_idx);
 gint gst_deinterlace_method_get_fields_required (GstDeinterlaceMethod * self);
 gint gst_deinterlace_method_get_latency (GstDeinterlaceMethod * self);
+void gst_deinterlace_method_set_n_threads (GstDeinterlaceMethod * self, guint n_threads);
 
 #define GST_TYPE_DEINTERLACE_SIMPLE_METHOD		(gst_deinterlace_simple_method_get_type ())
 #define GST_IS_DEINTERLACE_SIMPLE_METHOD(obj)		(G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_DEINTERLACE_SIMPLE_METHOD))
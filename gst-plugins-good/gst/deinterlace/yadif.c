@@ -0,0 +1,114 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Motion adaptive deinterlacing following the spatial and temporal checks of
+ * the yadif ("yet another deinterlacing filter") algorithm.
+ *
+ * A missing pixel is first predicted spatially by averaging the lines above
+ * and below along the direction (vertical or up to two samples diagonally)
+ * in which they match best. The prediction is then clamped to the range
+ * spanned by the temporal neighbours: where the opposite field is the same
+ * in the previous and next field the picture is static and the pixel of
+ * those fields is used, where it changes the spatial prediction is kept.
+ *
+ * The next field of the same parity is not available with a latency of one
+ * field, so only the previous one contributes to the temporal difference.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "gstdeinterlacemethod.h"
+#include "yadif.h"
+
+typedef GstDeinterlaceSimpleMethod GstDeinterlaceMethodYadif;
+typedef GstDeinterlaceSimpleMethodClass GstDeinterlaceMethodYadifClass;
+
+#include "yadifline.inc"
+
+static void
+deinterlace_scanline_yadif_planar (GstDeinterlaceSimpleMethod * self,
+    guint8 * out, const GstDeinterlaceScanlineData * scanlines, guint size)
+{
+  yadif_filter_line (out, scanlines, size, 1);
+}
+
+/* the interleaved chroma of NV12/NV21, the luma plane is filtered by the
+ * planar function */
+static void
+deinterlace_scanline_yadif_packed_2 (GstDeinterlaceSimpleMethod * self,
+    guint8 * out, const GstDeinterlaceScanlineData * scanlines, guint size)
+{
+  yadif_filter_line (out, scanlines, size, 2);
+}
+
+static void
+deinterlace_scanline_yadif_packed_3 (GstDeinterlaceSimpleMethod * self,
+    guint8 * out, const GstDeinterlaceScanlineData * scanlines, guint size)
+{
+  yadif_filter_line (out, scanlines, size, 3);
+}
+
+/* 4:2:2 packed and 32 bit formats repeat every 4 bytes */
+static void
+deinterlace_scanline_yadif_packed_4 (GstDeinterlaceSimpleMethod * self,
+    guint8 * out, const GstDeinterlaceScanlineData * scanlines, guint size)
+{
+  yadif_filter_line (out, scanlines, size, 4);
+}
+
+G_DEFINE_TYPE (GstDeinterlaceMethodYadif, gst_deinterlace_method_yadif,
+    GST_TYPE_DEINTERLACE_SIMPLE_METHOD);
+
+static void
+gst_deinterlace_method_yadif_class_init (GstDeinterlaceMethodYadifClass *
+    klass)
+{
+  GstDeinterlaceMethodClass *dim_class = (GstDeinterlaceMethodClass *) klass;
+  GstDeinterlaceSimpleMethodClass *dism_class =
+      (GstDeinterlaceSimpleMethodClass *) klass;
+
+  dim_class->fields_required = 4;
+  dim_class->name = "Motion Adaptive: Spatial and Temporal Check";
+  dim_class->nick = "yadif";
+  dim_class->latency = 1;
+
+  dism_class->interpolate_scanline_yuy2 = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_yvyu = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_uyvy = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_ayuv = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_argb = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_abgr = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_rgba = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_bgra = deinterlace_scanline_yadif_packed_4;
+  dism_class->interpolate_scanline_rgb = deinterlace_scanline_yadif_packed_3;
+  dism_class->interpolate_scanline_bgr = deinterlace_scanline_yadif_packed_3;
+  dism_class->interpolate_scanline_nv12 = deinterlace_scanline_yadif_packed_2;
+  dism_class->interpolate_scanline_nv21 = deinterlace_scanline_yadif_packed_2;
+  dism_class->interpolate_scanline_planar_y = deinterlace_scanline_yadif_planar;
+  dism_class->interpolate_scanline_planar_u = deinterlace_scanline_yadif_planar;
+  dism_class->interpolate_scanline_planar_v = deinterlace_scanline_yadif_planar;
+}
+
+static void
+gst_deinterlace_method_yadif_init (GstDeinterlaceMethodYadif * self)
+{
+}
@@ -34,16 +34,17 @@ extern GstStaticPadTemplate alaw_dec_sink_factory;
 GST_DEBUG_CATEGORY_STATIC (alaw_dec_debug);
 #define GST_CAT_DEFAULT alaw_dec_debug
 
-static GstStateChangeReturn
-gst_alaw_dec_change_state (GstElement * element, GstStateChange transition);
-
-static gboolean gst_alaw_dec_event (GstPad * pad, GstObject * parent,
-    GstEvent * event);
-static GstFlowReturn gst_alaw_dec_chain (GstPad * pad, GstObject * parent,
+static gboolean gst_alaw_dec_set_format (GstAudioDecoder * dec,
+    GstCaps * caps);
+static GstFlowReturn gst_alaw_dec_handle_frame (GstAudioDecoder * dec,
     GstBuffer * buffer);
+static GstFlowReturn gst_alaw_dec_decode_frame (GstAudioDecoder * dec,
+    GstBuffer * buffer, GstBuffer * outbuf);
+static gboolean gst_alaw_dec_query (GstPad * pad, GstObject * parent,
+    GstQuery * query);
 
 #define gst_alaw_dec_parent_class parent_class
-G_DEFINE_TYPE (GstALawDec, gst_alaw_dec, GST_TYPE_ELEMENT);
+G_DEFINE_TYPE (GstALawDec, gst_alaw_dec, GST_TYPE_AUDIO_DECODER);
 
 /* some day we might have defines in gstconfig.h that tell us about the
  * desired cpu/memory/binary size trade-offs */
@@ -115,12 +116,12 @@ alaw_to_s16 (guint8 a_val)
 #endif /* GST_ALAW_DEC_USE_TABLE */
 
 static gboolean
-gst_alaw_dec_setcaps (GstALawDec * alawdec, GstCaps * caps)
+gst_alaw_dec_set_format (GstAudioDecoder * dec, GstCaps * caps)
 {
+  GstALawDec *alawdec = GST_ALAW_DEC (dec);
   GstStructure *structure;
   int rate, channels;
   gboolean ret;
-  GstCaps *outcaps;
   GstAudioInfo info;
 
   structure = gst_caps_get_structure (caps, 0);
@@ -133,36 +134,27 @@ gst_alaw_dec_setcaps (GstALawDec * alawdec, GstCaps * caps)
   gst_audio_info_init (&info);
   gst_audio_info_set_format (&info, GST_AUDIO_FORMAT_S16, rate, channels, NULL);
 
-  outcaps = gst_audio_info_to_caps (&info);
-  ret = gst_pad_set_caps (alawdec->srcpad, outcaps);
-  gst_caps_unref (outcaps);
+  GST_DEBUG_OBJECT (alawdec, "rate=%d, channels=%d", rate, channels);
 
-  if (ret) {
-    GST_DEBUG_OBJECT (alawdec, "rate=%d, channels=%d", rate, channels);
-    alawdec->info = info;
-  }
-  return ret;
+  return gst_audio_decoder_set_output_format (dec, &info);
 }
 
 static GstCaps *
-gst_alaw_dec_getcaps (GstPad * pad, GstCaps * filter)
+gst_alaw_dec_getcaps (GstALawDec * alawdec, GstPad * pad, GstCaps * filter)
 {
-  GstALawDec *alawdec;
   GstPad *otherpad;
   GstCaps *othercaps, *result;
   GstCaps *templ;
   const gchar *name;
   gint i;
 
-  alawdec = GST_ALAW_DEC (GST_PAD_PARENT (pad));
-
   /* figure out the name of the caps we are going to return */
-  if (pad == alawdec->srcpad) {
+  if (pad == GST_AUDIO_DECODER_SRC_PAD (alawdec)) {
     name = "audio/x-raw";
-    otherpad = alawdec->sinkpad;
+    otherpad = GST_AUDIO_DECODER_SINK_PAD (alawdec);
   } else {
     name = "audio/x-alaw";
-    otherpad = alawdec->srcpad;
+    otherpad = GST_AUDIO_DECODER_SRC_PAD (alawdec);
   }
   /* get caps from the peer, this can return NULL when there is no peer */
   othercaps = gst_pad_peer_query_caps (otherpad, NULL);
@@ -183,7 +175,7 @@ gst_alaw_dec_getcaps (GstPad * pad, GstCaps * filter)
       /* adjust the name */
       gst_structure_set_name (structure, name);
 
-      if (pad == alawdec->sinkpad) {
+      if (pad == GST_AUDIO_DECODER_SINK_PAD (alawdec)) {
         /* remove the fields we don't want */
         gst_structure_remove_fields (structure, "format", "layout", NULL);
       } else {
@@ -213,6 +205,7 @@ gst_alaw_dec_getcaps (GstPad * pad, GstCaps * filter)
 static gboolean
 gst_alaw_dec_query (GstPad * pad, GstObject * parent, GstQuery * query)
 {
+  GstALawDec *alawdec = GST_ALAW_DEC (parent);
   gboolean res;
 
   switch (GST_QUERY_TYPE (query)) {
@@ -221,7 +214,7 @@ gst_alaw_dec_query (GstPad * pad, GstObject * parent, GstQuery * query)
       GstCaps *filter, *caps;
 
       gst_query_parse_caps (query, &filter);
-      caps = gst_alaw_dec_getcaps (pad, filter);
+      caps = gst_alaw_dec_getcaps (alawdec, pad, filter);
       gst_query_set_caps_result (query, caps);
       gst_caps_unref (caps);
 
@@ -229,165 +222,95 @@ gst_alaw_dec_query (GstPad * pad, GstObject * parent, GstQuery * query)
       break;
     }
     default:
-      res = gst_pad_query_default (pad, parent, query);
+      if (pad == GST_AUDIO_DECODER_SRC_PAD (alawdec))
+        res = alawdec->src_query (pad, parent, query);
+      else
+        res = alawdec->sink_query (pad, parent, query);
       break;
   }
   return res;
 }
 
-static void
-gst_alaw_dec_class_init (GstALawDecClass * klass)
-{
-  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
-
-  gst_element_class_add_pad_template (element_class,
-      gst_static_pad_template_get (&alaw_dec_src_factory));
-  gst_element_class_add_pad_template (element_class,
-      gst_static_pad_template_get (&alaw_dec_sink_factory));
-
-  gst_element_class_set_static_metadata (element_class, "A Law audio decoder",
-      "Codec/Decoder/Audio", "Convert 8bit A law to 16bit PCM",
-      "Zaheer Abbas Merali <zaheerabbas at merali dot org>");
-
-  element_class->change_state = GST_DEBUG_FUNCPTR (gst_alaw_dec_change_state);
-
-  GST_DEBUG_CATEGORY_INIT (alaw_dec_debug, "alawdec", 0, "A Law audio decoder");
-}
-
-static void
-gst_alaw_dec_init (GstALawDec * alawdec)
-{
-  alawdec->sinkpad =
-      gst_pad_new_from_static_template (&alaw_dec_sink_factory, "sink");
-  gst_pad_set_query_function (alawdec->sinkpad,
-      GST_DEBUG_FUNCPTR (gst_alaw_dec_query));
-  gst_pad_set_event_function (alawdec->sinkpad,
-      GST_DEBUG_FUNCPTR (gst_alaw_dec_event));
-  gst_pad_set_chain_function (alawdec->sinkpad,
-      GST_DEBUG_FUNCPTR (gst_alaw_dec_chain));
-  gst_element_add_pad (GST_ELEMENT (alawdec), alawdec->sinkpad);
-
-  alawdec->srcpad =
-      gst_pad_new_from_static_template (&alaw_dec_src_factory, "src");
-  gst_pad_use_fixed_caps (alawdec->srcpad);
-  gst_pad_set_query_function (alawdec->srcpad,
-      GST_DEBUG_FUNCPTR (gst_alaw_dec_query));
-  gst_element_add_pad (GST_ELEMENT (alawdec), alawdec->srcpad);
-}
-
-static gboolean
-gst_alaw_dec_event (GstPad * pad, GstObject * parent, GstEvent * event)
+static GstFlowReturn
+gst_alaw_dec_handle_frame (GstAudioDecoder * dec, GstBuffer * buffer)
 {
-  GstALawDec *alawdec;
-  gboolean res;
+  GstBuffer *outbuf;
 
-  alawdec = GST_ALAW_DEC (parent);
+  if (!buffer)
+    return GST_FLOW_OK;
 
-  switch (GST_EVENT_TYPE (event)) {
-    case GST_EVENT_CAPS:
-    {
-      GstCaps *caps;
+  GST_LOG_OBJECT (dec, "buffer with ts=%" GST_TIME_FORMAT,
+      GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buffer)));
 
-      gst_event_parse_caps (event, &caps);
-      gst_alaw_dec_setcaps (alawdec, caps);
-      gst_event_unref (event);
+  /* every sample is decoded independently, so the frames can be decoded in
+   * parallel */
+  outbuf = gst_audio_decoder_allocate_output_buffer (dec,
+      gst_buffer_get_size (buffer) * 2);
 
-      res = TRUE;
-      break;
-    }
-    default:
-      res = gst_pad_event_default (pad, parent, event);
-      break;
-  }
-  return res;
+  return gst_audio_decoder_submit_frame (dec, buffer, outbuf);
 }
 
 static GstFlowReturn
-gst_alaw_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+gst_alaw_dec_decode_frame (GstAudioDecoder * dec, GstBuffer * buffer,
+    GstBuffer * outbuf)
 {
-  GstALawDec *alawdec;
   GstMapInfo inmap, outmap;
   gint16 *linear_data;
   guint8 *alaw_data;
-  gsize alaw_size, linear_size;
-  GstBuffer *outbuf;
-  gint i;
-  GstFlowReturn ret;
-
-  alawdec = GST_ALAW_DEC (parent);
+  gsize i;
 
-  if (G_UNLIKELY (!GST_AUDIO_INFO_IS_VALID (&alawdec->info)))
-    goto not_negotiated;
-
-  GST_LOG_OBJECT (alawdec, "buffer with ts=%" GST_TIME_FORMAT,
-      GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buffer)));
+  if (!gst_buffer_map (buffer, &inmap, GST_MAP_READ))
+    return GST_FLOW_ERROR;
+  if (!gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE)) {
+    gst_buffer_unmap (buffer, &inmap);
+    return GST_FLOW_ERROR;
+  }
 
-  gst_buffer_map (buffer, &inmap, GST_MAP_READ);
   alaw_data = inmap.data;
-  alaw_size = inmap.size;
-
-  linear_size = alaw_size * 2;
-
-  outbuf = gst_buffer_new_allocate (NULL, linear_size, NULL);
-
-  gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE);
   linear_data = (gint16 *) outmap.data;
 
-  /* copy discont flag */
-  if (GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_DISCONT))
-    GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_DISCONT);
-
-  GST_BUFFER_TIMESTAMP (outbuf) = GST_BUFFER_TIMESTAMP (buffer);
-  if (GST_BUFFER_DURATION_IS_VALID (buffer)) {
-    GST_BUFFER_DURATION (outbuf) = GST_BUFFER_DURATION (buffer);
-  } else {
-    GST_BUFFER_DURATION (outbuf) = gst_util_uint64_scale_int (GST_SECOND,
-        linear_size, GST_AUDIO_INFO_RATE (&alawdec->info) *
-        GST_AUDIO_INFO_BPF (&alawdec->info));
-  }
-
-  for (i = 0; i < alaw_size; i++) {
+  for (i = 0; i < inmap.size; i++) {
     linear_data[i] = alaw_to_s16 (alaw_data[i]);
   }
 
   gst_buffer_unmap (outbuf, &outmap);
   gst_buffer_unmap (buffer, &inmap);
-  gst_buffer_unref (buffer);
-
-  ret = gst_pad_push (alawdec->srcpad, outbuf);
-
-  return ret;
 
-not_negotiated:
-  {
-    gst_buffer_unref (buffer);
-    GST_WARNING_OBJECT (alawdec, "no input format set: not-negotiated");
-    return GST_FLOW_NOT_NEGOTIATED;
-  }
+  return GST_FLOW_OK;
 }
 
-static GstStateChangeReturn
-gst_alaw_dec_change_state (GstElement * element, GstStateChange transition)
+static void
+gst_alaw_dec_class_init (GstALawDecClass * klass)
 {
-  GstStateChangeReturn ret;
-  GstALawDec *dec = GST_ALAW_DEC (element);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstAudioDecoderClass *audiodec_class = GST_AUDIO_DECODER_CLASS (klass);
 
-  switch (transition) {
-    default:
-      break;
-  }
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&alaw_dec_src_factory));
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&alaw_dec_sink_factory));
 
-  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
-  if (ret != GST_STATE_CHANGE_SUCCESS)
-    return ret;
+  gst_element_class_set_static_metadata (element_class, "A Law audio decoder",
+      "Codec/Decoder/Audio", "Convert 8bit A law to 16bit PCM",
+      "Zaheer Abbas Merali <zaheerabbas at merali dot org>");
 
-  switch (transition) {
-    case GST_STATE_CHANGE_PAUSED_TO_READY:
-      gst_audio_info_init (&dec->info);
-      break;
-    default:
-      break;
-  }
+  audiodec_class->set_format = GST_DEBUG_FUNCPTR (gst_alaw_dec_set_format);
+  audiodec_class->handle_frame = GST_DEBUG_FUNCPTR (gst_alaw_dec_handle_frame);
+  audiodec_class->decode_frame = GST_DEBUG_FUNCPTR (gst_alaw_dec_decode_frame);
 
-  return ret;
+  GST_DEBUG_CATEGORY_INIT (alaw_dec_debug, "alawdec", 0, "A Law audio decoder");
+}
+
+static void
+gst_alaw_dec_init (GstALawDec * alawdec)
+{
+  GstPad *sinkpad = GST_AUDIO_DECODER_SINK_PAD (alawdec);
+  GstPad *srcpad = GST_AUDIO_DECODER_SRC_PAD (alawdec);
+
+  /* answer caps queries like before, everything else is handled by the
+   * base class */
+  alawdec->sink_query = GST_PAD_QUERYFUNC (sinkpad);
+  gst_pad_set_query_function (sinkpad, GST_DEBUG_FUNCPTR (gst_alaw_dec_query));
+  alawdec->src_query = GST_PAD_QUERYFUNC (srcpad);
+  gst_pad_set_query_function (srcpad, GST_DEBUG_FUNCPTR (gst_alaw_dec_query));
 }
@@ -36,6 +36,8 @@ extern GstStaticPadTemplate mulaw_dec_sink_factory;
 static gboolean gst_mulawdec_set_format (GstAudioDecoder * dec, GstCaps * caps);
 static GstFlowReturn gst_mulawdec_handle_frame (GstAudioDecoder * dec,
     GstBuffer * buffer);
+static GstFlowReturn gst_mulawdec_decode_frame (GstAudioDecoder * dec,
+    GstBuffer * buffer, GstBuffer * outbuf);
 
 
 /* Stereo signals and args */
@@ -93,43 +95,45 @@ error_failed_get_structure:
 static GstFlowReturn
 gst_mulawdec_handle_frame (GstAudioDecoder * dec, GstBuffer * buffer)
 {
-  GstMapInfo inmap, outmap;
-  gint16 *linear_data;
-  guint8 *mulaw_data;
-  gsize mulaw_size, linear_size;
   GstBuffer *outbuf;
 
   if (!buffer) {
     return GST_FLOW_OK;
   }
 
+  /* every sample is decoded independently, so the frames can be decoded in
+   * parallel */
+  outbuf = gst_audio_decoder_allocate_output_buffer (dec,
+      gst_buffer_get_size (buffer) * 2);
+
+  return gst_audio_decoder_submit_frame (dec, buffer, outbuf);
+}
+
+static GstFlowReturn
+gst_mulawdec_decode_frame (GstAudioDecoder * dec, GstBuffer * buffer,
+    GstBuffer * outbuf)
+{
+  GstMapInfo inmap, outmap;
+
   if (!gst_buffer_map (buffer, &inmap, GST_MAP_READ)) {
     GST_ERROR ("failed to map input buffer");
     goto error_failed_map_input_buffer;
   }
 
-  mulaw_data = inmap.data;
-  mulaw_size = inmap.size;
-
-  linear_size = mulaw_size * 2;
-
-  outbuf = gst_audio_decoder_allocate_output_buffer (dec, linear_size);
   if (!gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE)) {
-    GST_ERROR ("failed to map input buffer");
+    GST_ERROR ("failed to map output buffer");
     goto error_failed_map_output_buffer;
   }
 
-  linear_data = (gint16 *) outmap.data;
-
-  mulaw_decode (mulaw_data, linear_data, mulaw_size);
+  mulaw_decode (inmap.data, (gint16 *) outmap.data, inmap.size);
 
   gst_buffer_unmap (outbuf, &outmap);
   gst_buffer_unmap (buffer, &inmap);
 
-  return gst_audio_decoder_finish_frame (dec, outbuf, -1);
+  return GST_FLOW_OK;
 
 error_failed_map_output_buffer:
-  gst_buffer_unref (outbuf);
+  gst_buffer_unmap (buffer, &inmap);
 
 error_failed_map_input_buffer:
   return GST_FLOW_ERROR;
@@ -149,6 +153,7 @@ gst_mulawdec_class_init (GstMuLawDecClass * klass)
 
   audiodec_class->set_format = GST_DEBUG_FUNCPTR (gst_mulawdec_set_format);
   audiodec_class->handle_frame = GST_DEBUG_FUNCPTR (gst_mulawdec_handle_frame);
+  audiodec_class->decode_frame = GST_DEBUG_FUNCPTR (gst_mulawdec_decode_frame);
 
   gst_element_class_set_static_metadata (element_class, "Mu Law audio decoder",
       "Codec/Decoder/Audio",
@@ -93,6 +93,25 @@
  * </listitem>
  * </itemizedlist>
  *
+ * Posting messages can be limited to every n-th interval with the
+ * #GstLevel:message-decimation property. The values of the last interval
+ * are also kept in a pre-allocated binary record that applications can copy
+ * with the #GstLevel::read-record action signal at any time, for example
+ * into shared memory for a metering process. The record starts with
+ * <programlisting>
+ * struct {
+ *   guint32 seqnum;
+ *   guint32 channels;
+ *   GstClockTime timestamp;
+ *   GstClockTime stream_time;
+ *   GstClockTime running_time;
+ *   GstClockTime duration;
+ * };
+ * </programlisting>
+ * in native byte order. The seqnum is incremented for every interval and 0
+ * before the first one. It is followed by three #gdouble per channel: the
+ * rms, peak and decaying peak level in dB.
+ *
  * <refsect2>
  * <title>Example application</title>
  * |[
@@ -150,9 +169,22 @@ enum
   PROP_MESSAGE,
   PROP_INTERVAL,
   PROP_PEAK_TTL,
-  PROP_PEAK_FALLOFF
+  PROP_PEAK_FALLOFF,
+  PROP_MESSAGE_DECIMATION
+};
+
+enum
+{
+  SIGNAL_READ_RECORD,
+  LAST_SIGNAL
 };
 
+/* minimum number of accumulators per block, enough to fill a few vector
+ * registers for mono and stereo */
+#define LEVEL_MIN_LANES 16
+
+static guint gst_level_signals[LAST_SIGNAL] = { 0 };
+
 #define gst_level_parent_class parent_class
 G_DEFINE_TYPE (GstLevel, gst_level, GST_TYPE_BASE_TRANSFORM);
 
@@ -170,6 +202,8 @@ static GstFlowReturn gst_level_transform_ip (GstBaseTransform * trans,
 static void gst_level_post_message (GstLevel * filter);
 static gboolean gst_level_sink_event (GstBaseTransform * trans,
     GstEvent * event);
+static guint gst_level_read_record (GstLevel * filter, gpointer data,
+    guint size);
 
 
 static void
@@ -220,6 +254,40 @@ gst_level_class_init (GstLevelClass * klass)
       g_param_spec_double ("peak-falloff", "Peak Falloff",
           "Decay rate of decay peak after TTL (in dB/sec)",
           0.0, G_MAXDOUBLE, 10.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstLevel:message-decimation
+   *
+   * Only post a message for every n-th interval. The record read with
+   * #GstLevel::read-record is still updated for every interval.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_MESSAGE_DECIMATION,
+      g_param_spec_uint ("message-decimation", "Message Decimation",
+          "Post a message for every n-th interval", 1, G_MAXUINT, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstLevel::read-record:
+   * @level: the level element
+   * @data: memory to copy the record to, or %NULL
+   * @size: the size of @data in bytes
+   *
+   * Copies the binary record with the levels of the last interval to @data
+   * if it has at least the size of the record. This does not allocate, so
+   * it can be called often, and @data can be shared memory.
+   *
+   * Returns: the size of the record in bytes
+   *
+   * Since: 1.2
+   */
+  gst_level_signals[SIGNAL_READ_RECORD] =
+      g_signal_new ("read-record", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstLevelClass, read_record), NULL, NULL,
+      g_cclosure_marshal_generic, G_TYPE_UINT, 2, G_TYPE_POINTER, G_TYPE_UINT);
+
+  klass->read_record = gst_level_read_record;
 
   GST_DEBUG_CATEGORY_INIT (level_debug, "level", 0, "Level calculation");
 
@@ -248,6 +316,12 @@ gst_level_init (GstLevel * filter)
   filter->decay_peak = NULL;
   filter->decay_peak_base = NULL;
   filter->decay_peak_age = NULL;
+  filter->lane_CS = NULL;
+  filter->lane_peak = NULL;
+
+  /* a record without channels until the format is known */
+  filter->record_size = sizeof (GstLevelRecord);
+  filter->record = g_malloc0 (filter->record_size);
 
   gst_audio_info_init (&filter->info);
 
@@ -256,6 +330,7 @@ gst_level_init (GstLevel * filter)
   filter->decay_peak_falloff = 10.0;    /* dB falloff (/sec) */
 
   filter->post_messages = TRUE;
+  filter->message_decimation = 1;
 
   filter->process = NULL;
 
@@ -273,6 +348,9 @@ gst_level_finalize (GObject * obj)
   g_free (filter->decay_peak);
   g_free (filter->decay_peak_base);
   g_free (filter->decay_peak_age);
+  g_free (filter->lane_CS);
+  g_free (filter->lane_peak);
+  g_free (filter->record);
 
   filter->CS = NULL;
   filter->peak = NULL;
@@ -280,6 +358,9 @@ gst_level_finalize (GObject * obj)
   filter->decay_peak = NULL;
   filter->decay_peak_base = NULL;
   filter->decay_peak_age = NULL;
+  filter->lane_CS = NULL;
+  filter->lane_peak = NULL;
+  filter->record = NULL;
 
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
@@ -311,6 +392,9 @@ gst_level_set_property (GObject * object, guint prop_id,
     case PROP_PEAK_FALLOFF:
       filter->decay_peak_falloff = g_value_get_double (value);
       break;
+    case PROP_MESSAGE_DECIMATION:
+      filter->message_decimation = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -338,6 +422,9 @@ gst_level_get_property (GObject * object, guint prop_id,
     case PROP_PEAK_FALLOFF:
       g_value_set_double (value, filter->decay_peak_falloff);
       break;
+    case PROP_MESSAGE_DECIMATION:
+      g_value_set_uint (value, filter->message_decimation);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -345,18 +432,20 @@ gst_level_get_property (GObject * object, guint prop_id,
 }
 
 
-/* process one (interleaved) channel of incoming samples
- * calculate square sum of samples
- * normalize and average over number of samples
- * returns a normalized cumulative square value, which can be averaged
+/* process a block of interleaved samples
+ * calculate square sum of samples for each of the @channels interleaved
+ * channels (or lanes) in one pass
+ * returns normalized cumulative square values, which can be averaged
  * to return the average power as a double between 0 and 1
- * also returns the normalized peak power (square of the highest amplitude)
+ * also returns the normalized peak powers (square of the highest amplitude)
  *
  * caller must assure num is a multiple of channels
- * samples for multiple channels are interleaved
  * input sample data enters in *in_data and is not modified
  * this filter only accepts signed audio data, so mid level is always 0
  *
+ * the inner loop over the channels has no dependencies between iterations
+ * so the compiler can vectorize it
+ *
  * for integers, this code considers the non-existant positive max value to be
  * full-scale; so max-1 will not map to 1.0
  */
@@ -367,69 +456,97 @@ gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
                             gdouble *NCS, gdouble *NPS)                       \
 {                                                                             \
   TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
+  guint i, j;                                                                 \
   gdouble normalizer;                /* divisor to get a [-1.0, 1.0] range */ \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
+  for (i = 0; i < channels; i++)                                              \
+    NCS[i] = NPS[i] = 0.0;                                                    \
                                                                               \
   for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
+    for (i = 0; i < channels; i++) {                                          \
+      gdouble square = ((gdouble) in[j + i]) * in[j + i];                     \
+                                                                              \
+      NPS[i] = square > NPS[i] ? square : NPS[i];                             \
+      NCS[i] += square;                                                       \
+    }                                                                         \
   }                                                                           \
                                                                               \
   normalizer = (gdouble) (G_GINT64_CONSTANT(1) << (RESOLUTION * 2));          \
-  *NCS = squaresum / normalizer;                                              \
-  *NPS = peaksquare / normalizer;                                             \
+  for (i = 0; i < channels; i++) {                                            \
+    NCS[i] /= normalizer;                                                     \
+    NPS[i] /= normalizer;                                                     \
+  }                                                                           \
 }
 
 DEFINE_INT_LEVEL_CALCULATOR (gint32, 31);
 DEFINE_INT_LEVEL_CALCULATOR (gint16, 15);
 DEFINE_INT_LEVEL_CALCULATOR (gint8, 7);
 
-/* FIXME: use orc to calculate squaresums? */
 #define DEFINE_FLOAT_LEVEL_CALCULATOR(TYPE)                                   \
 static void inline                                                            \
 gst_level_calculate_##TYPE (gpointer data, guint num, guint channels,         \
                             gdouble *NCS, gdouble *NPS)                       \
 {                                                                             \
   TYPE * in = (TYPE *)data;                                                   \
-  register guint j;                                                           \
-  gdouble squaresum = 0.0;           /* square sum of the input samples */    \
-  register gdouble square = 0.0;     /* Square */                             \
-  register gdouble peaksquare = 0.0; /* Peak Square Sample */                 \
+  guint i, j;                                                                 \
                                                                               \
-  /* *NCS = 0.0; Normalized Cumulative Square */                              \
-  /* *NPS = 0.0; Normalized Peak Square */                                    \
+  for (i = 0; i < channels; i++)                                              \
+    NCS[i] = NPS[i] = 0.0;                                                    \
                                                                               \
-  /* orc_level_squaresum_f64(&squaresum,in,num); */                           \
   for (j = 0; j < num; j += channels) {                                       \
-    square = ((gdouble) in[j]) * in[j];                                       \
-    if (square > peaksquare) peaksquare = square;                             \
-    squaresum += square;                                                      \
-  }                                                                           \
+    for (i = 0; i < channels; i++) {                                          \
+      gdouble square = ((gdouble) in[j + i]) * in[j + i];                     \
                                                                               \
-  *NCS = squaresum;                                                           \
-  *NPS = peaksquare;                                                          \
+      NPS[i] = square > NPS[i] ? square : NPS[i];                             \
+      NCS[i] += square;                                                       \
+    }                                                                         \
+  }                                                                           \
 }
 
 DEFINE_FLOAT_LEVEL_CALCULATOR (gfloat);
 DEFINE_FLOAT_LEVEL_CALCULATOR (gdouble);
 
-/* we would need stride to deinterleave also
-static void inline
-gst_level_calculate_gdouble (gpointer data, guint num, guint channels,
-                            gdouble *NCS, gdouble *NPS)
+/* adds the square sums and peaks of @lanes lanes to their channels */
+static void
+gst_level_fold_lanes (GstLevel * filter, guint lanes)
 {
-  orc_level_squaresum_f64(NCS,(gdouble *)data,num);
-  *NPS = 0.0;
+  guint i, channels = GST_AUDIO_INFO_CHANNELS (&filter->info);
+
+  for (i = 0; i < lanes; i++) {
+    guint c = i % channels;
+
+    filter->CS[c] += filter->lane_CS[i];
+    if (filter->lane_peak[i] > filter->peak[c])
+      filter->peak[c] = filter->lane_peak[i];
+  }
 }
-*/
 
+/* adds the square sums of @num interleaved samples to filter->CS and sets
+ * filter->peak to their peaks */
+static void
+gst_level_calculate_block (GstLevel * filter, guint8 * data, guint num)
+{
+  guint i, channels, bps, lanes_num;
+
+  channels = GST_AUDIO_INFO_CHANNELS (&filter->info);
+  bps = GST_AUDIO_INFO_BPS (&filter->info);
+
+  for (i = 0; i < channels; i++)
+    filter->peak[i] = 0.0;
+
+  lanes_num = num - num % filter->lanes;
+  if (lanes_num > 0) {
+    filter->process (data, lanes_num, filter->lanes, filter->lane_CS,
+        filter->lane_peak);
+    gst_level_fold_lanes (filter, filter->lanes);
+  }
+  /* the remaining frames are less than one set of lanes */
+  if (num > lanes_num) {
+    filter->process (data + lanes_num * bps, num - lanes_num, channels,
+        filter->lane_CS, filter->lane_peak);
+    gst_level_fold_lanes (filter, channels);
+  }
+}
 
 static gboolean
 gst_level_set_caps (GstBaseTransform * trans, GstCaps * in, GstCaps * out)
@@ -482,6 +599,20 @@ gst_level_set_caps (GstBaseTransform * trans, GstCaps * in, GstCaps * out)
 
   filter->decay_peak_age = g_new (GstClockTime, channels);
 
+  filter->lanes = channels * MAX (1, LEVEL_MIN_LANES / channels);
+  g_free (filter->lane_CS);
+  g_free (filter->lane_peak);
+  filter->lane_CS = g_new (gdouble, filter->lanes);
+  filter->lane_peak = g_new (gdouble, filter->lanes);
+
+  GST_OBJECT_LOCK (filter);
+  g_free (filter->record);
+  filter->record_size = sizeof (GstLevelRecord) +
+      channels * sizeof (GstLevelChannelRecord);
+  filter->record = g_malloc0 (filter->record_size);
+  filter->record->channels = channels;
+  GST_OBJECT_UNLOCK (filter);
+
   for (i = 0; i < channels; ++i) {
     filter->CS[i] = filter->peak[i] = filter->last_peak[i] =
         filter->decay_peak[i] = filter->decay_peak_base[i] = 0.0;
@@ -500,79 +631,61 @@ gst_level_start (GstBaseTransform * trans)
 
   filter->num_frames = 0;
   filter->message_ts = GST_CLOCK_TIME_NONE;
+  filter->intervals = 0;
 
   return TRUE;
 }
 
 static GstMessage *
-gst_level_message_new (GstLevel * level, GstClockTime timestamp,
-    GstClockTime duration)
+gst_level_message_new (GstLevel * level, const GstLevelRecord * record)
 {
-  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (level);
+  const GstLevelChannelRecord *channel = GST_LEVEL_RECORD_CHANNELS (record);
   GstStructure *s;
+  GValueArray *rms, *peak, *decay;
   GValue v = { 0, };
-  GstClockTime endtime, running_time, stream_time;
+  GstClockTime endtime;
+  guint i;
 
-  running_time = gst_segment_to_running_time (&trans->segment, GST_FORMAT_TIME,
-      timestamp);
-  stream_time = gst_segment_to_stream_time (&trans->segment, GST_FORMAT_TIME,
-      timestamp);
   /* endtime is for backwards compatibility */
-  endtime = stream_time + duration;
+  endtime = record->stream_time + record->duration;
 
   s = gst_structure_new ("level",
       "endtime", GST_TYPE_CLOCK_TIME, endtime,
-      "timestamp", G_TYPE_UINT64, timestamp,
-      "stream-time", G_TYPE_UINT64, stream_time,
-      "running-time", G_TYPE_UINT64, running_time,
-      "duration", G_TYPE_UINT64, duration, NULL);
+      "timestamp", G_TYPE_UINT64, record->timestamp,
+      "stream-time", G_TYPE_UINT64, record->stream_time,
+      "running-time", G_TYPE_UINT64, record->running_time,
+      "duration", G_TYPE_UINT64, record->duration, NULL);
+
+  rms = g_value_array_new (record->channels);
+  peak = g_value_array_new (record->channels);
+  decay = g_value_array_new (record->channels);
+
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < record->channels; i++) {
+    g_value_set_double (&v, channel[i].rms);
+    g_value_array_append (rms, &v);     /* copies by value */
+    g_value_set_double (&v, channel[i].peak);
+    g_value_array_append (peak, &v);
+    g_value_set_double (&v, channel[i].decay);
+    g_value_array_append (decay, &v);
+  }
+  g_value_unset (&v);
 
   g_value_init (&v, G_TYPE_VALUE_ARRAY);
-  g_value_take_boxed (&v, g_value_array_new (0));
+  g_value_take_boxed (&v, rms);
   gst_structure_take_value (s, "rms", &v);
 
   g_value_init (&v, G_TYPE_VALUE_ARRAY);
-  g_value_take_boxed (&v, g_value_array_new (0));
+  g_value_take_boxed (&v, peak);
   gst_structure_take_value (s, "peak", &v);
 
   g_value_init (&v, G_TYPE_VALUE_ARRAY);
-  g_value_take_boxed (&v, g_value_array_new (0));
+  g_value_take_boxed (&v, decay);
   gst_structure_take_value (s, "decay", &v);
 
   return gst_message_new_element (GST_OBJECT (level), s);
 }
 
-static void
-gst_level_message_append_channel (GstMessage * m, gdouble rms, gdouble peak,
-    gdouble decay)
-{
-  const GValue *array_val;
-  GstStructure *s;
-  GValueArray *arr;
-  GValue v = { 0, };
-
-  g_value_init (&v, G_TYPE_DOUBLE);
-
-  s = (GstStructure *) gst_message_get_structure (m);
-
-  array_val = gst_structure_get_value (s, "rms");
-  arr = (GValueArray *) g_value_get_boxed (array_val);
-  g_value_set_double (&v, rms);
-  g_value_array_append (arr, &v);       /* copies by value */
-
-  array_val = gst_structure_get_value (s, "peak");
-  arr = (GValueArray *) g_value_get_boxed (array_val);
-  g_value_set_double (&v, peak);
-  g_value_array_append (arr, &v);       /* copies by value */
-
-  array_val = gst_structure_get_value (s, "decay");
-  arr = (GValueArray *) g_value_get_boxed (array_val);
-  g_value_set_double (&v, decay);
-  g_value_array_append (arr, &v);       /* copies by value */
-
-  g_value_unset (&v);
-}
-
 static GstFlowReturn
 gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
 {
@@ -580,7 +693,6 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
   GstMapInfo map;
   guint8 *in_data;
   gsize in_size;
-  gdouble CS;
   guint i;
   guint num_frames;
   guint num_int_samples = 0;    /* number of interleaved samples
@@ -621,18 +733,18 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
     block_size = MIN (block_size, num_frames);
     block_int_size = block_size * channels;
 
-    for (i = 0; i < channels; ++i) {
-      if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
-        filter->process (in_data, block_int_size, channels, &CS,
-            &filter->peak[i]);
-        GST_LOG_OBJECT (filter,
-            "[%d]: cumulative squares %lf, over %d samples/%d channels",
-            i, CS, block_int_size, channels);
-        filter->CS[i] += CS;
-      } else {
+    if (!GST_BUFFER_FLAG_IS_SET (in, GST_BUFFER_FLAG_GAP)) {
+      gst_level_calculate_block (filter, in_data, block_int_size);
+    } else {
+      for (i = 0; i < channels; ++i)
         filter->peak[i] = 0.0;
-      }
-      in_data += bps;
+    }
+    in_data += block_int_size * bps;
+
+    for (i = 0; i < channels; ++i) {
+      GST_LOG_OBJECT (filter,
+          "[%d]: cumulative squares %lf, over %d samples/%d channels",
+          i, filter->CS[i], block_int_size, channels);
 
       filter->decay_peak_age[i] += GST_FRAMES_TO_CLOCK_TIME (num_frames, rate);
       GST_LOG_OBJECT (filter,
@@ -679,7 +791,6 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
         filter->decay_peak_age[i] = G_GINT64_CONSTANT (0);
       }
     }
-    in_data += ((block_int_size * bps) - bps);
 
     filter->num_frames += block_size;
     num_frames -= block_size;
@@ -698,6 +809,9 @@ gst_level_transform_ip (GstBaseTransform * trans, GstBuffer * in)
 static void
 gst_level_post_message (GstLevel * filter)
 {
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (filter);
+  GstLevelRecord *record;
+  GstLevelChannelRecord *channel;
   guint i;
   gint channels, rate, frames = filter->num_frames;
   GstClockTime duration;
@@ -706,57 +820,87 @@ gst_level_post_message (GstLevel * filter)
   rate = GST_AUDIO_INFO_RATE (&filter->info);
   duration = GST_FRAMES_TO_CLOCK_TIME (frames, rate);
 
-  if (filter->post_messages) {
-    GstMessage *m =
-        gst_level_message_new (filter, filter->message_ts, duration);
-
-    GST_LOG_OBJECT (filter,
-        "message: ts %" GST_TIME_FORMAT ", duration %" GST_TIME_FORMAT
-        ", num_frames %d", GST_TIME_ARGS (filter->message_ts),
-        GST_TIME_ARGS (duration), frames);
-
-    for (i = 0; i < channels; ++i) {
-      gdouble RMS;
-      gdouble RMSdB, peakdB, decaydB;
-
-      RMS = sqrt (filter->CS[i] / frames);
-      GST_LOG_OBJECT (filter,
-          "message: channel %d, CS %f, RMS %f", i, filter->CS[i], RMS);
-      GST_LOG_OBJECT (filter,
-          "message: last_peak: %f, decay_peak: %f",
-          filter->last_peak[i], filter->decay_peak[i]);
-      /* RMS values are calculated in amplitude, so 20 * log 10 */
-      RMSdB = 20 * log10 (RMS + EPSILON);
-      /* peak values are square sums, ie. power, so 10 * log 10 */
-      peakdB = 10 * log10 (filter->last_peak[i] + EPSILON);
-      decaydB = 10 * log10 (filter->decay_peak[i] + EPSILON);
-
-      if (filter->decay_peak[i] < filter->last_peak[i]) {
-        /* this can happen in certain cases, for example when
-         * the last peak is between decay_peak and decay_peak_base */
-        GST_DEBUG_OBJECT (filter,
-            "message: decay peak dB %f smaller than last peak dB %f, copying",
-            decaydB, peakdB);
-        filter->decay_peak[i] = filter->last_peak[i];
-      }
-      GST_LOG_OBJECT (filter,
-          "message: RMS %f dB, peak %f dB, decay %f dB",
-          RMSdB, peakdB, decaydB);
+  GST_LOG_OBJECT (filter,
+      "record: ts %" GST_TIME_FORMAT ", duration %" GST_TIME_FORMAT
+      ", num_frames %d", GST_TIME_ARGS (filter->message_ts),
+      GST_TIME_ARGS (duration), frames);
+
+  /* only this thread writes the record, the lock is for readers */
+  GST_OBJECT_LOCK (filter);
+  record = filter->record;
+  channel = GST_LEVEL_RECORD_CHANNELS (record);
+
+  if (++record->seqnum == 0)
+    record->seqnum = 1;
+  record->timestamp = filter->message_ts;
+  record->running_time = gst_segment_to_running_time (&trans->segment,
+      GST_FORMAT_TIME, filter->message_ts);
+  record->stream_time = gst_segment_to_stream_time (&trans->segment,
+      GST_FORMAT_TIME, filter->message_ts);
+  record->duration = duration;
 
-      gst_level_message_append_channel (m, RMSdB, peakdB, decaydB);
+  for (i = 0; i < channels; ++i) {
+    gdouble RMS;
+    gdouble RMSdB, peakdB, decaydB;
 
-      /* reset cumulative and normal peak */
-      filter->CS[i] = 0.0;
-      filter->last_peak[i] = 0.0;
+    RMS = sqrt (filter->CS[i] / frames);
+    GST_LOG_OBJECT (filter,
+        "message: channel %d, CS %f, RMS %f", i, filter->CS[i], RMS);
+    GST_LOG_OBJECT (filter,
+        "message: last_peak: %f, decay_peak: %f",
+        filter->last_peak[i], filter->decay_peak[i]);
+    /* RMS values are calculated in amplitude, so 20 * log 10 */
+    RMSdB = 20 * log10 (RMS + EPSILON);
+    /* peak values are square sums, ie. power, so 10 * log 10 */
+    peakdB = 10 * log10 (filter->last_peak[i] + EPSILON);
+    decaydB = 10 * log10 (filter->decay_peak[i] + EPSILON);
+
+    if (filter->decay_peak[i] < filter->last_peak[i]) {
+      /* this can happen in certain cases, for example when
+       * the last peak is between decay_peak and decay_peak_base */
+      GST_DEBUG_OBJECT (filter,
+          "message: decay peak dB %f smaller than last peak dB %f, copying",
+          decaydB, peakdB);
+      filter->decay_peak[i] = filter->last_peak[i];
     }
+    GST_LOG_OBJECT (filter,
+        "message: RMS %f dB, peak %f dB, decay %f dB",
+        RMSdB, peakdB, decaydB);
+
+    channel[i].rms = RMSdB;
+    channel[i].peak = peakdB;
+    channel[i].decay = decaydB;
 
-    gst_element_post_message (GST_ELEMENT (filter), m);
+    /* reset cumulative and normal peak */
+    filter->CS[i] = 0.0;
+    filter->last_peak[i] = 0.0;
+  }
+  GST_OBJECT_UNLOCK (filter);
 
+  if (filter->post_messages &&
+      ++filter->intervals >= filter->message_decimation) {
+    filter->intervals = 0;
+    gst_element_post_message (GST_ELEMENT (filter),
+        gst_level_message_new (filter, record));
   }
+
   filter->num_frames -= frames;
   filter->message_ts += duration;
 }
 
+static guint
+gst_level_read_record (GstLevel * filter, gpointer data, guint size)
+{
+  guint record_size;
+
+  GST_OBJECT_LOCK (filter);
+  record_size = filter->record_size;
+  if (data && size >= record_size)
+    memcpy (data, filter->record, record_size);
+  GST_OBJECT_UNLOCK (filter);
+
+  return record_size;
+}
 
 static gboolean
 gst_level_sink_event (GstBaseTransform * trans, GstEvent * event)
@@ -47,6 +47,30 @@ G_BEGIN_DECLS
 
 typedef struct _GstLevel GstLevel;
 typedef struct _GstLevelClass GstLevelClass;
+typedef struct _GstLevelRecord GstLevelRecord;
+typedef struct _GstLevelChannelRecord GstLevelChannelRecord;
+
+/* binary metering record as copied by the read-record signal, all fields
+ * are in native byte order. The header is followed by @channels
+ * GstLevelChannelRecords */
+struct _GstLevelRecord {
+  guint32 seqnum;               /* incremented for every interval, 0 while
+                                 * no interval completed */
+  guint32 channels;
+  GstClockTime timestamp;
+  GstClockTime stream_time;
+  GstClockTime running_time;
+  GstClockTime duration;
+};
+
+struct _GstLevelChannelRecord {
+  gdouble rms;                  /* in dB */
+  gdouble peak;                 /* in dB */
+  gdouble decay;                /* in dB */
+};
+
+#define GST_LEVEL_RECORD_CHANNELS(record) \
+  ((GstLevelChannelRecord *) ((GstLevelRecord *) (record) + 1))
 
 /**
  * GstLevel:
@@ -58,6 +82,7 @@ struct _GstLevel {
 
   /* properties */
   gboolean post_messages;       /* whether or not to post messages */
+  guint message_decimation;     /* post a message every this many intervals */
   guint64 interval;             /* how many nanoseconds between emits */
   gdouble decay_peak_ttl;       /* time to live for peak in nanoseconds */
   gdouble decay_peak_falloff;   /* falloff in dB/sec */
@@ -67,6 +92,7 @@ struct _GstLevel {
                                  * since last emit */
   gint interval_frames;         /* after how many frame to sent a message */
   GstClockTime message_ts;      /* starttime for next message */
+  guint intervals;              /* intervals since last message */
 
   /* per-channel arrays for intermediate values */
   gdouble *CS;                  /* normalized Cumulative Square */
@@ -76,11 +102,25 @@ struct _GstLevel {
   gdouble *decay_peak_base;     /* value of last peak we are decaying from */
   GstClockTime *decay_peak_age; /* age of last peak */
 
+  /* the interleaved samples are processed as lanes = n * channels
+   * independent accumulators, so that the loop over the lanes vectorizes
+   * also for few channels */
+  guint lanes;
+  gdouble *lane_CS;
+  gdouble *lane_peak;
+
+  /* record of the last interval, OBJECT_LOCK */
+  GstLevelRecord *record;
+  guint record_size;
+
   void (*process)(gpointer, guint, guint, gdouble*, gdouble*);
 };
 
 struct _GstLevelClass {
   GstBaseTransformClass parent_class;
+
+  /* actions */
+  guint (*read_record) (GstLevel * level, gpointer data, guint size);
 };
 
 GType gst_level_get_type (void);
@@ -96,8 +96,8 @@ static void gst_gamma_get_property (GObject * object, guint prop_id,
 
 static gboolean gst_gamma_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
     GstVideoInfo * in_info, GstCaps * outcaps, GstVideoInfo * out_info);
-static GstFlowReturn gst_gamma_transform_frame_ip (GstVideoFilter * vfilter,
-    GstVideoFrame * frame);
+static GstFlowReturn gst_gamma_transform_frame_ip_slice (GstVideoFilter *
+    vfilter, GstVideoFrame * frame, guint y, guint height);
 static void gst_gamma_before_transform (GstBaseTransform * transform,
     GstBuffer * buf);
 
@@ -137,8 +137,8 @@ gst_gamma_class_init (GstGammaClass * g_class)
   trans_class->transform_ip_on_passthrough = FALSE;
 
   vfilter_class->set_info = GST_DEBUG_FUNCPTR (gst_gamma_set_info);
-  vfilter_class->transform_frame_ip =
-      GST_DEBUG_FUNCPTR (gst_gamma_transform_frame_ip);
+  vfilter_class->transform_frame_ip_slice =
+      GST_DEBUG_FUNCPTR (gst_gamma_transform_frame_ip_slice);
 }
 
 static void
@@ -163,8 +163,12 @@ gst_gamma_set_property (GObject * object, guint prop_id, const GValue * value,
           val);
       GST_OBJECT_LOCK (gamma);
       gamma->gamma = val;
+      /* the tables are recalculated from the streaming thread, slices of
+       * the current frame might still be using them */
+      gamma->tables_dirty = TRUE;
       GST_OBJECT_UNLOCK (gamma);
-      gst_gamma_calculate_tables (gamma);
+      gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (gamma),
+          val == 1.0);
       break;
     }
     default:
@@ -198,6 +202,7 @@ gst_gamma_calculate_tables (GstGamma * gamma)
   gboolean passthrough = FALSE;
 
   GST_OBJECT_LOCK (gamma);
+  gamma->tables_dirty = FALSE;
   if (gamma->gamma == 1.0) {
     passthrough = TRUE;
   } else {
@@ -215,17 +220,18 @@ gst_gamma_calculate_tables (GstGamma * gamma)
 }
 
 static void
-gst_gamma_planar_yuv_ip (GstGamma * gamma, GstVideoFrame * frame)
+gst_gamma_planar_yuv_ip (GstGamma * gamma, GstVideoFrame * frame, guint y,
+    guint height)
 {
-  gint i, j, height;
+  gint i, j;
   gint width, stride, row_wrap;
   const guint8 *table = gamma->gamma_table;
   guint8 *data;
 
-  data = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
   stride = GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
+  data = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
+  data += y * stride;
   width = GST_VIDEO_FRAME_COMP_WIDTH (frame, 0);
-  height = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 0);
   row_wrap = stride - width;
 
   for (i = 0; i < height; i++) {
@@ -238,18 +244,19 @@ gst_gamma_planar_yuv_ip (GstGamma * gamma, GstVideoFrame * frame)
 }
 
 static void
-gst_gamma_packed_yuv_ip (GstGamma * gamma, GstVideoFrame * frame)
+gst_gamma_packed_yuv_ip (GstGamma * gamma, GstVideoFrame * frame, guint y,
+    guint height)
 {
-  gint i, j, height;
+  gint i, j;
   gint width, stride, row_wrap;
   gint pixel_stride;
   const guint8 *table = gamma->gamma_table;
   guint8 *data;
 
-  data = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
   stride = GST_VIDEO_FRAME_COMP_STRIDE (frame, 0);
+  data = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
+  data += y * stride;
   width = GST_VIDEO_FRAME_COMP_WIDTH (frame, 0);
-  height = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 0);
   pixel_stride = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0);
   row_wrap = stride - pixel_stride * width;
 
@@ -277,9 +284,10 @@ static const gint cog_rgb_to_ycbcr_matrix_8bit_sdtv[] = {
 #define APPLY_MATRIX(m,o,v1,v2,v3) ((m[o*4] * v1 + m[o*4+1] * v2 + m[o*4+2] * v3 + m[o*4+3]) >> 8)
 
 static void
-gst_gamma_packed_rgb_ip (GstGamma * gamma, GstVideoFrame * frame)
+gst_gamma_packed_rgb_ip (GstGamma * gamma, GstVideoFrame * frame, guint line,
+    guint height)
 {
-  gint i, j, height;
+  gint i, j;
   gint width, stride, row_wrap;
   gint pixel_stride;
   const guint8 *table = gamma->gamma_table;
@@ -288,10 +296,10 @@ gst_gamma_packed_rgb_ip (GstGamma * gamma, GstVideoFrame * frame)
   gint y, u, v;
   guint8 *data;
 
-  data = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
   stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+  data = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  data += line * stride;
   width = GST_VIDEO_FRAME_COMP_WIDTH (frame, 0);
-  height = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 0);
 
   offsets[0] = GST_VIDEO_FRAME_COMP_OFFSET (frame, 0);
   offsets[1] = GST_VIDEO_FRAME_COMP_OFFSET (frame, 1);
@@ -391,19 +399,23 @@ gst_gamma_before_transform (GstBaseTransform * base, GstBuffer * outbuf)
 
   if (GST_CLOCK_TIME_IS_VALID (stream_time))
     gst_object_sync_values (GST_OBJECT (gamma), stream_time);
+
+  /* no slice of a frame is being processed here */
+  if (gamma->tables_dirty)
+    gst_gamma_calculate_tables (gamma);
 }
 
+/* called concurrently for different lines, without holding any locks */
 static GstFlowReturn
-gst_gamma_transform_frame_ip (GstVideoFilter * vfilter, GstVideoFrame * frame)
+gst_gamma_transform_frame_ip_slice (GstVideoFilter * vfilter,
+    GstVideoFrame * frame, guint y, guint height)
 {
   GstGamma *gamma = GST_GAMMA (vfilter);
 
   if (!gamma->process)
     goto not_negotiated;
 
-  GST_OBJECT_LOCK (gamma);
-  gamma->process (gamma, frame);
-  GST_OBJECT_UNLOCK (gamma);
+  gamma->process (gamma, frame, y, height);
 
   return GST_FLOW_OK;
 
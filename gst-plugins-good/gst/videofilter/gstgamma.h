@@ -57,10 +57,12 @@ struct _GstGamma
   /* properties */
   gdouble gamma;
 
-  /* tables */
+  /* tables, only modified from the streaming thread */
   guint8 gamma_table[256];
+  gboolean tables_dirty;
 
-  void (*process) (GstGamma *gamma, GstVideoFrame *frame);
+  void (*process) (GstGamma *gamma, GstVideoFrame *frame, guint y,
+      guint height);
 };
 
 struct _GstGammaClass
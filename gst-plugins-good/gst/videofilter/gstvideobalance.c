@@ -161,8 +161,10 @@ gst_video_balance_update_properties (GstVideoBalance * videobalance)
 
   GST_OBJECT_LOCK (videobalance);
   passthrough = gst_video_balance_is_passthrough (videobalance);
+  /* the tables are updated from the streaming thread, slices of the
+   * current frame might still be using them */
   if (!passthrough)
-    gst_video_balance_update_tables (videobalance);
+    videobalance->tables_dirty = TRUE;
   GST_OBJECT_UNLOCK (videobalance);
 
   gst_base_transform_set_passthrough (base, passthrough);
@@ -170,25 +172,24 @@ gst_video_balance_update_properties (GstVideoBalance * videobalance)
 
 static void
 gst_video_balance_planar_yuv (GstVideoBalance * videobalance,
-    GstVideoFrame * frame)
+    GstVideoFrame * frame, guint line, guint height)
 {
   gint x, y;
   guint8 *ydata;
   guint8 *udata, *vdata;
   gint ystride, ustride, vstride;
-  gint width, height;
-  gint width2, height2;
+  gint width;
+  gint width2, line2, height2;
   guint8 *tabley = videobalance->tabley;
   guint8 **tableu = videobalance->tableu;
   guint8 **tablev = videobalance->tablev;
 
   width = GST_VIDEO_FRAME_WIDTH (frame);
-  height = GST_VIDEO_FRAME_HEIGHT (frame);
 
   ydata = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
   ystride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
 
-  for (y = 0; y < height; y++) {
+  for (y = line; y < line + height; y++) {
     guint8 *yptr;
 
     yptr = ydata + y * ystride;
@@ -198,15 +199,19 @@ gst_video_balance_planar_yuv (GstVideoBalance * videobalance,
     }
   }
 
+  /* the chroma lines of our luma lines */
   width2 = GST_VIDEO_FRAME_COMP_WIDTH (frame, 1);
-  height2 = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 1);
+  line2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line);
+  height2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line + height) - line2;
 
   udata = GST_VIDEO_FRAME_PLANE_DATA (frame, 1);
   vdata = GST_VIDEO_FRAME_PLANE_DATA (frame, 2);
   ustride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 1);
   vstride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 2);
 
-  for (y = 0; y < height2; y++) {
+  for (y = line2; y < line2 + height2; y++) {
     guint8 *uptr, *vptr;
     guint8 u1, v1;
 
@@ -225,26 +230,25 @@ gst_video_balance_planar_yuv (GstVideoBalance * videobalance,
 
 static void
 gst_video_balance_semiplanar_yuv (GstVideoBalance * videobalance,
-    GstVideoFrame * frame)
+    GstVideoFrame * frame, guint line, guint height)
 {
   gint x, y;
   guint8 *ydata;
   guint8 *uvdata;
   gint ystride, uvstride;
-  gint width, height;
-  gint width2, height2;
+  gint width;
+  gint width2, line2, height2;
   guint8 *tabley = videobalance->tabley;
   guint8 **tableu = videobalance->tableu;
   guint8 **tablev = videobalance->tablev;
   gint upos, vpos;
 
   width = GST_VIDEO_FRAME_WIDTH (frame);
-  height = GST_VIDEO_FRAME_HEIGHT (frame);
 
   ydata = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
   ystride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
 
-  for (y = 0; y < height; y++) {
+  for (y = line; y < line + height; y++) {
     guint8 *yptr;
 
     yptr = ydata + y * ystride;
@@ -254,8 +258,12 @@ gst_video_balance_semiplanar_yuv (GstVideoBalance * videobalance,
     }
   }
 
+  /* the chroma lines of our luma lines */
   width2 = GST_VIDEO_FRAME_COMP_WIDTH (frame, 1);
-  height2 = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 1);
+  line2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line);
+  height2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line + height) - line2;
 
   uvdata = GST_VIDEO_FRAME_PLANE_DATA (frame, 1);
   uvstride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 1);
@@ -263,7 +271,7 @@ gst_video_balance_semiplanar_yuv (GstVideoBalance * videobalance,
   upos = GST_VIDEO_INFO_FORMAT (&frame->info) == GST_VIDEO_FORMAT_NV12 ? 0 : 1;
   vpos = GST_VIDEO_INFO_FORMAT (&frame->info) == GST_VIDEO_FORMAT_NV12 ? 1 : 0;
 
-  for (y = 0; y < height2; y++) {
+  for (y = line2; y < line2 + height2; y++) {
     guint8 *uvptr;
     guint8 u1, v1;
 
@@ -282,25 +290,24 @@ gst_video_balance_semiplanar_yuv (GstVideoBalance * videobalance,
 
 static void
 gst_video_balance_packed_yuv (GstVideoBalance * videobalance,
-    GstVideoFrame * frame)
+    GstVideoFrame * frame, guint line, guint height)
 {
   gint x, y, stride;
   guint8 *ydata, *udata, *vdata;
   gint yoff, uoff, voff;
-  gint width, height;
-  gint width2, height2;
+  gint width;
+  gint width2, line2, height2;
   guint8 *tabley = videobalance->tabley;
   guint8 **tableu = videobalance->tableu;
   guint8 **tablev = videobalance->tablev;
 
   width = GST_VIDEO_FRAME_WIDTH (frame);
-  height = GST_VIDEO_FRAME_HEIGHT (frame);
 
   stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
   ydata = GST_VIDEO_FRAME_COMP_DATA (frame, 0);
   yoff = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0);
 
-  for (y = 0; y < height; y++) {
+  for (y = line; y < line + height; y++) {
     guint8 *yptr;
 
     yptr = ydata + y * stride;
@@ -310,15 +317,19 @@ gst_video_balance_packed_yuv (GstVideoBalance * videobalance,
     }
   }
 
+  /* the chroma lines of our luma lines */
   width2 = GST_VIDEO_FRAME_COMP_WIDTH (frame, 1);
-  height2 = GST_VIDEO_FRAME_COMP_HEIGHT (frame, 1);
+  line2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line);
+  height2 = GST_VIDEO_SUB_SCALE (GST_VIDEO_FORMAT_INFO_H_SUB (frame->info.finfo,
+          1), line + height) - line2;
 
   udata = GST_VIDEO_FRAME_COMP_DATA (frame, 1);
   vdata = GST_VIDEO_FRAME_COMP_DATA (frame, 2);
   uoff = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 1);
   voff = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 2);
 
-  for (y = 0; y < height2; y++) {
+  for (y = line2; y < line2 + height2; y++) {
     guint8 *uptr, *vptr;
     guint8 u1, v1;
 
@@ -354,9 +365,9 @@ static const gint cog_rgb_to_ycbcr_matrix_8bit_sdtv[] = {
 
 static void
 gst_video_balance_packed_rgb (GstVideoBalance * videobalance,
-    GstVideoFrame * frame)
+    GstVideoFrame * frame, guint line, guint height)
 {
-  gint i, j, height;
+  gint i, j;
   gint width, stride, row_wrap;
   gint pixel_stride;
   guint8 *data;
@@ -369,14 +380,14 @@ gst_video_balance_packed_rgb (GstVideoBalance * videobalance,
   guint8 **tablev = videobalance->tablev;
 
   width = GST_VIDEO_FRAME_WIDTH (frame);
-  height = GST_VIDEO_FRAME_HEIGHT (frame);
 
   offsets[0] = GST_VIDEO_FRAME_COMP_OFFSET (frame, 0);
   offsets[1] = GST_VIDEO_FRAME_COMP_OFFSET (frame, 1);
   offsets[2] = GST_VIDEO_FRAME_COMP_OFFSET (frame, 2);
 
-  data = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
   stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0);
+  data = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  data += line * stride;
 
   pixel_stride = GST_VIDEO_FRAME_COMP_PSTRIDE (frame, 0);
   row_wrap = stride - pixel_stride * width;
@@ -484,20 +495,27 @@ gst_video_balance_before_transform (GstBaseTransform * base, GstBuffer * buf)
 
   if (GST_CLOCK_TIME_IS_VALID (stream_time))
     gst_object_sync_values (GST_OBJECT (balance), stream_time);
+
+  /* no slice of a frame is being processed here */
+  GST_OBJECT_LOCK (balance);
+  if (balance->tables_dirty) {
+    gst_video_balance_update_tables (balance);
+    balance->tables_dirty = FALSE;
+  }
+  GST_OBJECT_UNLOCK (balance);
 }
 
+/* called concurrently for different lines, without holding any locks */
 static GstFlowReturn
-gst_video_balance_transform_frame_ip (GstVideoFilter * vfilter,
-    GstVideoFrame * frame)
+gst_video_balance_transform_frame_ip_slice (GstVideoFilter * vfilter,
+    GstVideoFrame * frame, guint y, guint height)
 {
   GstVideoBalance *videobalance = GST_VIDEO_BALANCE (vfilter);
 
   if (!videobalance->process)
     goto not_negotiated;
 
-  GST_OBJECT_LOCK (videobalance);
-  videobalance->process (videobalance, frame);
-  GST_OBJECT_UNLOCK (videobalance);
+  videobalance->process (videobalance, frame, y, height);
 
   return GST_FLOW_OK;
 
@@ -578,8 +596,8 @@ gst_video_balance_class_init (GstVideoBalanceClass * klass)
   trans_class->transform_ip_on_passthrough = FALSE;
 
   vfilter_class->set_info = GST_DEBUG_FUNCPTR (gst_video_balance_set_info);
-  vfilter_class->transform_frame_ip =
-      GST_DEBUG_FUNCPTR (gst_video_balance_transform_frame_ip);
+  vfilter_class->transform_frame_ip_slice =
+      GST_DEBUG_FUNCPTR (gst_video_balance_transform_frame_ip_slice);
 }
 
 static void
@@ -60,12 +60,14 @@ struct _GstVideoBalance {
   gdouble hue;
   gdouble saturation;
 
-  /* tables */
+  /* tables, only modified from the streaming thread */
   guint8 tabley[256];
   guint8 *tableu[256];
   guint8 *tablev[256];
+  gboolean tables_dirty;
 
-  void (*process) (GstVideoBalance *balance, GstVideoFrame *frame);
+  void (*process) (GstVideoBalance *balance, GstVideoFrame *frame, guint y,
+      guint height);
 };
 
 struct _GstVideoBalanceClass {
@@ -542,10 +542,12 @@ gst_videomixer2_pad_init (GstVideoMixer2Pad * mixerpad)
 
 /* GstVideoMixer2 */
 #define DEFAULT_BACKGROUND VIDEO_MIXER2_BACKGROUND_CHECKER
+#define DEFAULT_N_THREADS 1
 enum
 {
   PROP_0,
-  PROP_BACKGROUND
+  PROP_BACKGROUND,
+  PROP_N_THREADS
 };
 
 #define GST_TYPE_VIDEO_MIXER2_BACKGROUND (gst_videomixer2_background_get_type())
@@ -814,72 +816,310 @@ gst_videomixer2_fill_queues (GstVideoMixer2 * mix,
   return 1;
 }
 
-static GstFlowReturn
-gst_videomixer2_blend_buffers (GstVideoMixer2 * mix,
-    GstClockTime output_start_time, GstClockTime output_end_time,
-    GstBuffer ** outbuf)
+/* An input frame that is blended into the output frame */
+typedef struct
 {
-  GSList *l;
-  guint outsize;
+  GstVideoFrame frame;
+  gint xpos, ypos;
+  gdouble alpha;
+
+  /* the output pixels written by the layer */
+  gint x0, y0, x1, y1;
+  /* the layer replaces everything below it */
+  gboolean opaque;
+} GstVideoMixer2Layer;
+
+/* A range of pixels of a line that are covered by opaque layers */
+typedef struct
+{
+  gint x0, x1;
+} GstVideoMixer2Span;
+
+typedef struct
+{
+  GstVideoMixer2 *mix;
+  GstVideoFrame *outframe;
   BlendFunction composite;
-  GstVideoFrame outframe;
-  static GstAllocationParams params = { 0, 15, 0, 0, };
+  GstVideoMixer2Layer *layers;
+  guint n_layers;
+  gint valign;
+} GstVideoMixer2Blend;
 
-  outsize = GST_VIDEO_INFO_SIZE (&mix->info);
+/* Checks if the sorted, non overlapping @spans cover @x0 to @x1 */
+static gboolean
+gst_videomixer2_spans_cover (const GstVideoMixer2Span * spans, guint n_spans,
+    gint x0, gint x1)
+{
+  guint i;
 
-  *outbuf = gst_buffer_new_allocate (NULL, outsize, &params);
-  GST_BUFFER_TIMESTAMP (*outbuf) = output_start_time;
-  GST_BUFFER_DURATION (*outbuf) = output_end_time - output_start_time;
+  for (i = 0; i < n_spans && spans[i].x0 <= x0; i++) {
+    if (spans[i].x1 >= x1)
+      return TRUE;
+  }
+  return FALSE;
+}
 
-  gst_video_frame_map (&outframe, &mix->info, *outbuf, GST_MAP_READWRITE);
+/* Adds @x0 to @x1 to @spans, merging it with the spans it touches. @spans
+ * must have room for one more span. Returns the new number of spans. */
+static guint
+gst_videomixer2_spans_add (GstVideoMixer2Span * spans, guint n_spans,
+    gint x0, gint x1)
+{
+  guint i, j;
+
+  for (i = 0; i < n_spans && spans[i].x1 < x0; i++);
+  for (j = i; j < n_spans && spans[j].x0 <= x1; j++) {
+    x0 = MIN (x0, spans[j].x0);
+    x1 = MAX (x1, spans[j].x1);
+  }
+
+  if (j != i + 1) {
+    memmove (&spans[i + 1], &spans[j], (n_spans - j) * sizeof (spans[0]));
+    n_spans = n_spans + i + 1 - j;
+  }
+  spans[i].x0 = x0;
+  spans[i].x1 = x1;
 
-  /* default to blending */
-  composite = mix->blend;
+  return n_spans;
+}
+
+/* Makes @sub a frame for the @height lines of @frame starting at @y, which
+ * must be a multiple of the vertical subsampling. @sub must not be unmapped. */
+static void
+gst_videomixer2_sub_frame (GstVideoFrame * frame, gint y, gint height,
+    GstVideoFrame * sub)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint i;
+
+  *sub = *frame;
+  GST_VIDEO_INFO_HEIGHT (&sub->info) = height;
+  for (i = 0; i < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); i++) {
+    guint plane = GST_VIDEO_FORMAT_INFO_PLANE (finfo, i);
+
+    sub->data[plane] = (guint8 *) frame->data[plane] +
+        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, i, y) *
+        GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+  }
+}
+
+static void
+gst_videomixer2_fill_background (GstVideoMixer2 * mix, GstVideoFrame * frame)
+{
   switch (mix->background) {
     case VIDEO_MIXER2_BACKGROUND_CHECKER:
-      mix->fill_checker (&outframe);
+      mix->fill_checker (frame);
       break;
     case VIDEO_MIXER2_BACKGROUND_BLACK:
-      mix->fill_color (&outframe, 16, 128, 128);
+      mix->fill_color (frame, 16, 128, 128);
       break;
     case VIDEO_MIXER2_BACKGROUND_WHITE:
-      mix->fill_color (&outframe, 240, 128, 128);
+      mix->fill_color (frame, 240, 128, 128);
       break;
     case VIDEO_MIXER2_BACKGROUND_TRANSPARENT:
     {
       guint i, plane, num_planes, height;
 
-      num_planes = GST_VIDEO_FRAME_N_PLANES (&outframe);
+      num_planes = GST_VIDEO_FRAME_N_PLANES (frame);
       for (plane = 0; plane < num_planes; ++plane) {
         guint8 *pdata;
         gsize rowsize, plane_stride;
 
-        pdata = GST_VIDEO_FRAME_PLANE_DATA (&outframe, plane);
-        plane_stride = GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, plane);
-        rowsize = GST_VIDEO_FRAME_COMP_WIDTH (&outframe, plane)
-            * GST_VIDEO_FRAME_COMP_PSTRIDE (&outframe, plane);
-        height = GST_VIDEO_FRAME_COMP_HEIGHT (&outframe, plane);
+        pdata = GST_VIDEO_FRAME_PLANE_DATA (frame, plane);
+        plane_stride = GST_VIDEO_FRAME_PLANE_STRIDE (frame, plane);
+        rowsize = GST_VIDEO_FRAME_COMP_WIDTH (frame, plane)
+            * GST_VIDEO_FRAME_COMP_PSTRIDE (frame, plane);
+        height = GST_VIDEO_FRAME_COMP_HEIGHT (frame, plane);
         for (i = 0; i < height; ++i) {
           memset (pdata, 0, rowsize);
           pdata += plane_stride;
         }
       }
-
-      /* use overlay to keep background transparent */
-      composite = mix->overlay;
       break;
     }
   }
+}
+
+/* Blends one band of the output frame. The band is split into slabs at the
+ * top and bottom edges of the layers so that per slab we know which layers
+ * are hidden by opaque layers above them and if the background is visible
+ * at all. Only the visible parts are filled and blended. */
+static void
+gst_videomixer2_blend_slice (gpointer user_data, guint slice, guint n_slices)
+{
+  GstVideoMixer2Blend *blend = user_data;
+  GstVideoMixer2Layer *layers = blend->layers;
+  guint n_layers = blend->n_layers;
+  gint width = GST_VIDEO_FRAME_WIDTH (blend->outframe);
+  gint height = GST_VIDEO_FRAME_HEIGHT (blend->outframe);
+  gint band_y0, band_y1, units;
+  gint *edges;
+  guint n_edges, n_slabs, i, j, s;
+  guint8 *visible;
+  gboolean *fill;
+  GstVideoMixer2Span *spans;
+  GstVideoFrame sub;
+
+  /* bands start at multiples of 16 lines to keep the checker pattern in
+   * phase, which also keeps them aligned to the chroma subsampling */
+  units = (height + 15) / 16;
+  band_y0 = MIN (height, (units * slice / n_slices) * 16);
+  band_y1 = MIN (height, (units * (slice + 1) / n_slices) * 16);
+  if (band_y0 >= band_y1)
+    return;
+
+  edges = g_newa (gint, 2 * n_layers + 2);
+  n_edges = 0;
+  edges[n_edges++] = band_y0;
+  edges[n_edges++] = band_y1;
+  for (i = 0; i < n_layers; i++) {
+    gint y[2] = { layers[i].y0, layers[i].y1 };
+
+    for (j = 0; j < 2; j++) {
+      gint e = y[j] & ~(blend->valign - 1);
+
+      if (e > band_y0 && e < band_y1)
+        edges[n_edges++] = e;
+    }
+  }
+
+  /* sort and remove duplicates, there are only a few edges */
+  for (i = 1; i < n_edges; i++) {
+    gint e = edges[i];
+
+    for (j = i; j > 0 && edges[j - 1] > e; j--)
+      edges[j] = edges[j - 1];
+    edges[j] = e;
+  }
+  for (i = 1, j = 1; i < n_edges; i++) {
+    if (edges[i] != edges[j - 1])
+      edges[j++] = edges[i];
+  }
+  n_edges = j;
+  n_slabs = n_edges - 1;
+
+  visible = g_newa (guint8, n_slabs * n_layers + 1);
+  fill = g_newa (gboolean, n_slabs);
+  spans = g_newa (GstVideoMixer2Span, n_layers + 1);
+
+  /* walk the layers from the top down, a layer is hidden in a slab when the
+   * opaque layers above it cover its whole width there */
+  for (s = 0; s < n_slabs; s++) {
+    gint s0 = edges[s], s1 = edges[s + 1];
+    guint n_spans = 0;
+
+    for (i = n_layers; i > 0; i--) {
+      GstVideoMixer2Layer *layer = &layers[i - 1];
+      gboolean vis;
+
+      vis = layer->y0 < s1 && layer->y1 > s0 &&
+          !gst_videomixer2_spans_cover (spans, n_spans, layer->x0, layer->x1);
+      visible[s * n_layers + i - 1] = vis;
+
+      if (vis && layer->opaque && layer->y0 <= s0 && layer->y1 >= s1)
+        n_spans =
+            gst_videomixer2_spans_add (spans, n_spans, layer->x0, layer->x1);
+    }
+    fill[s] = !gst_videomixer2_spans_cover (spans, n_spans, 0, width);
+  }
+
+  /* fill the background of all slabs before blending, in whole blocks of 16
+   * lines as the checker pattern is relative to the start of the frame */
+  for (s = 0; s < n_slabs; s = j) {
+    gint y0, y1;
+
+    for (j = s; j < n_slabs && fill[j]; j++);
+    if (j == s) {
+      j++;
+      continue;
+    }
+
+    y0 = edges[s] & ~15;
+    y1 = MIN (band_y1, GST_ROUND_UP_16 (edges[j]));
+    gst_videomixer2_sub_frame (blend->outframe, y0, y1 - y0, &sub);
+    gst_videomixer2_fill_background (blend->mix, &sub);
+  }
+
+  for (s = 0; s < n_slabs; s++) {
+    gint s0 = edges[s], s1 = edges[s + 1];
+
+    gst_videomixer2_sub_frame (blend->outframe, s0, s1 - s0, &sub);
+    for (i = 0; i < n_layers; i++) {
+      GstVideoMixer2Layer *layer = &layers[i];
+
+      if (visible[s * n_layers + i])
+        blend->composite (&layer->frame, layer->xpos, layer->ypos - s0,
+            layer->alpha, &sub);
+    }
+  }
+}
+
+static GstVideoSliceRunner *
+gst_videomixer2_get_runner (GstVideoMixer2 * mix)
+{
+  guint n_threads;
+
+  GST_OBJECT_LOCK (mix);
+  n_threads = mix->n_threads;
+  GST_OBJECT_UNLOCK (mix);
+
+  if (mix->runner == NULL || mix->runner_threads != n_threads) {
+    if (mix->runner)
+      gst_video_slice_runner_free (mix->runner);
+    mix->runner = gst_video_slice_runner_new (n_threads);
+    mix->runner_threads = n_threads;
+
+    GST_DEBUG_OBJECT (mix, "blending with %u threads",
+        gst_video_slice_runner_get_n_threads (mix->runner));
+  }
+  return mix->runner;
+}
+
+static GstFlowReturn
+gst_videomixer2_blend_buffers (GstVideoMixer2 * mix,
+    GstClockTime output_start_time, GstClockTime output_end_time,
+    GstBuffer ** outbuf)
+{
+  const GstVideoFormatInfo *finfo = mix->info.finfo;
+  GSList *l;
+  guint outsize, n_layers, i;
+  gint width, height, halign, valign;
+  GstVideoFrame outframe;
+  GstVideoMixer2Layer *layers;
+  GstVideoMixer2Blend blend;
+  GstVideoSliceRunner *runner;
+  static GstAllocationParams params = { 0, 15, 0, 0, };
+
+  outsize = GST_VIDEO_INFO_SIZE (&mix->info);
+  width = GST_VIDEO_INFO_WIDTH (&mix->info);
+  height = GST_VIDEO_INFO_HEIGHT (&mix->info);
+
+  *outbuf = gst_buffer_new_allocate (NULL, outsize, &params);
+  GST_BUFFER_TIMESTAMP (*outbuf) = output_start_time;
+  GST_BUFFER_DURATION (*outbuf) = output_end_time - output_start_time;
+
+  gst_video_frame_map (&outframe, &mix->info, *outbuf, GST_MAP_READWRITE);
+
+  /* the blend functions round the position of a layer up to the chroma
+   * subsampling */
+  halign = valign = 1;
+  for (i = 0; i < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); i++) {
+    halign = MAX (halign, 1 << GST_VIDEO_FORMAT_INFO_W_SUB (finfo, i));
+    valign = MAX (valign, 1 << GST_VIDEO_FORMAT_INFO_H_SUB (finfo, i));
+  }
+
+  layers = g_newa (GstVideoMixer2Layer, g_slist_length (mix->sinkpads) + 1);
+  n_layers = 0;
 
   for (l = mix->sinkpads; l; l = l->next) {
     GstVideoMixer2Pad *pad = l->data;
     GstVideoMixer2Collect *mixcol = pad->mixcol;
+    GstVideoMixer2Layer *layer = &layers[n_layers];
 
     if (mixcol->buffer != NULL) {
       GstClockTime timestamp;
       gint64 stream_time;
       GstSegment *seg;
-      GstVideoFrame frame;
 
       seg = &mixcol->collect.segment;
 
@@ -892,13 +1132,54 @@ gst_videomixer2_blend_buffers (GstVideoMixer2 * mix,
       if (GST_CLOCK_TIME_IS_VALID (stream_time))
         gst_object_sync_values (GST_OBJECT (pad), stream_time);
 
-      gst_video_frame_map (&frame, &pad->info, mixcol->buffer, GST_MAP_READ);
+      layer->xpos = pad->xpos;
+      layer->ypos = pad->ypos;
+      layer->alpha = pad->alpha;
+
+      /* fully transparent, the blend functions would not touch anything */
+      if (layer->alpha <= 0.0)
+        continue;
+
+      layer->x0 = (layer->xpos + halign - 1) & ~(halign - 1);
+      layer->y0 = (layer->ypos + valign - 1) & ~(valign - 1);
+      layer->x1 = MIN (width, layer->x0 + GST_VIDEO_INFO_WIDTH (&pad->info));
+      layer->y1 =
+          MIN (height, layer->y0 + GST_VIDEO_INFO_HEIGHT (&pad->info));
+      layer->x0 = MAX (layer->x0, 0);
+      layer->y0 = MAX (layer->y0, 0);
+      if (layer->x0 >= layer->x1 || layer->y0 >= layer->y1)
+        continue;
+
+      /* without alpha channel and at full alpha the input is copied */
+      layer->opaque = layer->alpha == 1.0
+          && !GST_VIDEO_INFO_HAS_ALPHA (&pad->info);
 
-      composite (&frame, pad->xpos, pad->ypos, pad->alpha, &outframe);
+      if (!gst_video_frame_map (&layer->frame, &pad->info, mixcol->buffer,
+              GST_MAP_READ))
+        continue;
 
-      gst_video_frame_unmap (&frame);
+      n_layers++;
     }
   }
+
+  blend.mix = mix;
+  blend.outframe = &outframe;
+  /* use overlay to keep a transparent background transparent */
+  if (mix->background == VIDEO_MIXER2_BACKGROUND_TRANSPARENT)
+    blend.composite = mix->overlay;
+  else
+    blend.composite = mix->blend;
+  blend.layers = layers;
+  blend.n_layers = n_layers;
+  blend.valign = valign;
+
+  runner = gst_videomixer2_get_runner (mix);
+  gst_video_slice_runner_run (runner,
+      gst_video_slice_runner_get_n_threads (runner),
+      gst_videomixer2_blend_slice, &blend);
+
+  for (i = 0; i < n_layers; i++)
+    gst_video_frame_unmap (&layers[i].frame);
   gst_video_frame_unmap (&outframe);
 
   return GST_FLOW_OK;
@@ -1949,6 +2230,8 @@ gst_videomixer2_finalize (GObject * o)
   GstVideoMixer2 *mix = GST_VIDEO_MIXER2 (o);
 
   gst_object_unref (mix->collect);
+  if (mix->runner)
+    gst_video_slice_runner_free (mix->runner);
   g_mutex_clear (&mix->lock);
   g_mutex_clear (&mix->setcaps_lock);
 
@@ -1973,6 +2256,11 @@ gst_videomixer2_get_property (GObject * object,
     case PROP_BACKGROUND:
       g_value_set_enum (value, mix->background);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (mix);
+      g_value_set_uint (value, mix->n_threads);
+      GST_OBJECT_UNLOCK (mix);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1989,6 +2277,11 @@ gst_videomixer2_set_property (GObject * object,
     case PROP_BACKGROUND:
       mix->background = g_value_get_enum (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (mix);
+      mix->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (mix);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2051,6 +2344,19 @@ gst_videomixer2_class_init (GstVideoMixer2Class * klass)
           GST_TYPE_VIDEO_MIXER2_BACKGROUND,
           DEFAULT_BACKGROUND, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstVideoMixer2:n-threads:
+   *
+   * The maximum number of threads used to blend an output frame, 0 uses one
+   * thread per CPU. Each thread blends a horizontal band of the frame.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = one per CPU)", 0, G_MAXINT,
+          DEFAULT_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_videomixer2_request_new_pad);
   gstelement_class->release_pad =
@@ -2088,6 +2394,7 @@ gst_videomixer2_init (GstVideoMixer2 * mix)
 
   mix->collect = gst_collect_pads_new ();
   mix->background = DEFAULT_BACKGROUND;
+  mix->n_threads = DEFAULT_N_THREADS;
   mix->current_caps = NULL;
 
   gst_collect_pads_set_function (mix->collect,
@@ -115,6 +115,12 @@ struct _GstVideoMixer2
   FillCheckerFunction fill_checker;
   FillColorFunction fill_color;
 
+  /* Bands of the output frame are blended on up to n_threads threads,
+   * protected by the object lock */
+  guint n_threads;
+  GstVideoSliceRunner *runner;
+  guint runner_threads;
+
   gboolean send_stream_start;
 };
 
@@ -186,6 +186,99 @@ GST_START_TEST (test_parse_handle_codec_data)
 GST_END_TEST;
 
 
+static gint64 adts_stream_size;
+
+static gboolean
+adts_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  GstFormat format;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_DURATION:
+      gst_query_parse_duration (query, &format, NULL);
+      if (format != GST_FORMAT_BYTES)
+        return FALSE;
+      gst_query_set_duration (query, format, adts_stream_size);
+      return TRUE;
+    default:
+      return gst_pad_query_default (pad, parent, query);
+  }
+}
+
+/*
+ * Test if the ADTS frames that are available ahead of the current one are
+ * indexed and give the exact duration once the end of the stream is seen,
+ * also when that run continues in the next buffer.
+ */
+GST_START_TEST (test_parse_adts_index_duration)
+{
+  GstElement *aacparse;
+  GstPad *srcpad, *sinkpad;
+  GstBuffer *buf;
+  GstMapInfo map;
+  GstClockTime frame_duration;
+  gint64 duration;
+  guint i, offset, framesize, split;
+
+  /* 50 frames of 15 and 23 bytes, 48000 Hz, 1024 samples per frame */
+  adts_stream_size = 25 * 15 + 25 * 23;
+  buf = gst_buffer_new_and_alloc (adts_stream_size);
+  gst_buffer_memset (buf, 0, 0, adts_stream_size);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (i = 0, offset = 0; i < 50; i++) {
+    framesize = (i % 2) ? 23 : 15;
+    memcpy (map.data + offset, adts_frame_mpeg4, 7);
+    map.data[offset + 3] = (map.data[offset + 3] & 0xfc) | (framesize >> 11);
+    map.data[offset + 4] = (framesize >> 3) & 0xff;
+    map.data[offset + 5] = ((framesize & 0x07) << 5) |
+        (map.data[offset + 5] & 0x1f);
+    offset += framesize;
+  }
+  gst_buffer_unmap (buf, &map);
+
+  aacparse = gst_check_setup_element ("aacparse");
+  srcpad = gst_check_setup_src_pad (aacparse, &srctemplate);
+  gst_pad_set_query_function (srcpad, adts_src_query);
+  sinkpad = gst_check_setup_sink_pad (aacparse, &sinktemplate);
+  gst_pad_set_active (srcpad, TRUE);
+  gst_check_setup_events (srcpad, aacparse, NULL, GST_FORMAT_BYTES);
+  gst_pad_set_active (sinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (aacparse,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE,
+      "could not set to playing");
+
+  /* split in the middle of frame 20, so the run continues with the headers
+   * of the second buffer */
+  split = 10 * 15 + 10 * 23 + 4;
+  fail_unless_equals_int (gst_pad_push (srcpad,
+          gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, 0, split)),
+      GST_FLOW_OK);
+  fail_unless_equals_int (gst_pad_push (srcpad,
+          gst_buffer_copy_region (buf, GST_BUFFER_COPY_ALL, split,
+              adts_stream_size - split)), GST_FLOW_OK);
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_eos ()));
+  fail_unless_equals_int (g_list_length (buffers), 50);
+
+  /* frame times are counted up the same way GstBaseParse interpolates them */
+  frame_duration = gst_util_uint64_scale (GST_SECOND, 1024, 48000);
+  fail_unless (gst_element_query_duration (aacparse, GST_FORMAT_TIME,
+          &duration));
+  fail_unless_equals_uint64 (duration, 50 * frame_duration);
+
+  gst_buffer_unref (buf);
+  gst_check_drop_buffers ();
+  gst_element_set_state (aacparse, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_pad_set_active (sinkpad, FALSE);
+  gst_check_teardown_src_pad (aacparse);
+  gst_check_teardown_sink_pad (aacparse);
+  gst_check_teardown_element (aacparse);
+}
+
+GST_END_TEST;
+
+
 static Suite *
 aacparse_suite (void)
 {
@@ -203,6 +296,7 @@ aacparse_suite (void)
   tcase_add_test (tc_chain, test_parse_adts_split);
   tcase_add_test (tc_chain, test_parse_adts_skip_garbage);
   tcase_add_test (tc_chain, test_parse_adts_detect_mpeg_version);
+  tcase_add_test (tc_chain, test_parse_adts_index_duration);
 
   /* Other tests */
   tcase_add_test (tc_chain, test_parse_handle_codec_data);
@@ -22,6 +22,9 @@
  * with newer GLib versions (>= 2.31.0) */
 #define GLIB_DISABLE_DEPRECATION_WARNINGS
 
+#include <math.h>
+#include <string.h>
+
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
 
@@ -177,6 +180,404 @@ GST_START_TEST (test_pipeline)
 
 GST_END_TEST;
 
+static void
+on_rate_changed_long (GstElement * element, gint rate, gpointer user_data)
+{
+  GValueArray *va;
+  GValue v = { 0, };
+  gint i;
+
+  fail_unless (rate > 0);
+
+  /* long enough to use FFT convolution with two partitions */
+  va = g_value_array_new (64);
+
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < 64; i++) {
+    g_value_set_double (&v, (i == 5) ? 1.0 : 0.0);
+    g_value_array_append (va, &v);
+    g_value_reset (&v);
+  }
+
+  g_object_set (G_OBJECT (element), "kernel", va, NULL);
+
+  g_value_array_free (va);
+}
+
+static void
+on_handoff_partitioned (GstElement * object, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  if (!have_data) {
+    GstMapInfo map;
+    gdouble *data;
+    gint i;
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    data = (gdouble *) map.data;
+
+    fail_unless (map.size > 5 * sizeof (gdouble));
+    for (i = 0; i < 5; i++)
+      fail_unless (fabs (data[i]) < 1e-10);
+    fail_unless (fabs (data[5]) > 0.1);
+
+    gst_buffer_unmap (buffer, &map);
+    have_data = TRUE;
+  }
+}
+
+GST_START_TEST (test_partitioned)
+{
+  GstElement *pipeline, *src, *cfilter, *filter, *sink;
+  GstCaps *caps;
+  GstBus *bus;
+  GstPad *pad;
+  GstQuery *query;
+  GstClockTime min, max;
+  gboolean live;
+  guint partition_length;
+  GMainLoop *loop;
+
+  have_data = FALSE;
+  have_eos = FALSE;
+
+  pipeline = gst_element_factory_make ("pipeline", NULL);
+  fail_unless (pipeline != NULL);
+
+  src = gst_element_factory_make ("audiotestsrc", NULL);
+  fail_unless (src != NULL);
+  g_object_set (G_OBJECT (src), "num-buffers", 100, NULL);
+  gst_util_set_object_arg (G_OBJECT (src), "wave", "square");
+
+  cfilter = gst_element_factory_make ("capsfilter", NULL);
+  fail_unless (cfilter != NULL);
+#if G_BYTE_ORDER == G_BIG_ENDIAN
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, "F64BE", "rate", G_TYPE_INT, 48000, NULL);
+#else
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, "F64LE", "rate", G_TYPE_INT, 48000, NULL);
+#endif
+  g_object_set (G_OBJECT (cfilter), "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  filter = gst_element_factory_make ("audiofirfilter", NULL);
+  fail_unless (filter != NULL);
+  g_object_set (G_OBJECT (filter), "partition-length", 32, NULL);
+  g_object_get (G_OBJECT (filter), "partition-length", &partition_length,
+      NULL);
+  fail_unless_equals_int (partition_length, 32);
+  g_signal_connect (G_OBJECT (filter), "rate-changed",
+      G_CALLBACK (on_rate_changed_long), NULL);
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  fail_unless (sink != NULL);
+  g_object_set (G_OBJECT (sink), "signal-handoffs", TRUE, NULL);
+  g_signal_connect (G_OBJECT (sink), "handoff",
+      G_CALLBACK (on_handoff_partitioned), NULL);
+
+  gst_bin_add_many (GST_BIN (pipeline), src, cfilter, filter, sink, NULL);
+  fail_unless (gst_element_link_many (src, cfilter, filter, sink, NULL));
+
+  loop = g_main_loop_new (NULL, FALSE);
+
+  bus = gst_pipeline_get_bus (GST_PIPELINE (pipeline));
+  gst_bus_add_signal_watch (bus);
+  g_signal_connect (G_OBJECT (bus), "message", G_CALLBACK (on_message), loop);
+  gst_object_unref (GST_OBJECT (bus));
+
+  fail_if (gst_element_set_state (pipeline,
+          GST_STATE_PAUSED) == GST_STATE_CHANGE_FAILURE);
+  fail_unless (gst_element_get_state (pipeline, NULL, NULL,
+          GST_CLOCK_TIME_NONE) == GST_STATE_CHANGE_SUCCESS);
+
+  /* the latency is one partition instead of three times the kernel */
+  pad = gst_element_get_static_pad (filter, "src");
+  query = gst_query_new_latency ();
+  fail_unless (gst_pad_query (pad, query));
+  gst_query_parse_latency (query, &live, &min, &max);
+  fail_unless_equals_uint64 (min, gst_util_uint64_scale_round (32,
+          GST_SECOND, 48000));
+  gst_query_unref (query);
+  gst_object_unref (pad);
+
+  fail_if (gst_element_set_state (pipeline,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE);
+
+  g_main_loop_run (loop);
+
+  fail_unless (have_data);
+  fail_unless (have_eos);
+
+  fail_unless (gst_element_set_state (pipeline,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS);
+
+  g_main_loop_unref (loop);
+  gst_object_unref (pipeline);
+}
+
+GST_END_TEST;
+
+#define FIR_RATE 48000
+
+static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS ("audio/x-raw"));
+static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS ("audio/x-raw"));
+
+static GstPad *mysrcpad, *mysinkpad;
+
+static void
+set_kernel (GstElement * filter, const gdouble * kernel, guint length)
+{
+  GValueArray *va;
+  GValue v = { 0, };
+  guint i;
+
+  va = g_value_array_new (length);
+
+  g_value_init (&v, G_TYPE_DOUBLE);
+  for (i = 0; i < length; i++) {
+    g_value_set_double (&v, kernel[i]);
+    g_value_array_append (va, &v);
+    g_value_reset (&v);
+  }
+  g_value_unset (&v);
+
+  g_object_set (G_OBJECT (filter), "kernel", va, NULL);
+
+  g_value_array_free (va);
+}
+
+static gdouble *
+random_samples (GRand * rand, guint n)
+{
+  gdouble *samples = g_new (gdouble, n);
+  guint i;
+
+  for (i = 0; i < n; i++)
+    samples[i] = g_rand_double_range (rand, -0.5, 0.5);
+
+  return samples;
+}
+
+/* direct convolution of the interleaved @input with @kernel */
+static gdouble *
+convolve (const gdouble * input, guint n_frames, gint channels,
+    const gdouble * kernel, guint kernel_length)
+{
+  gdouble *output = g_new0 (gdouble, n_frames * channels);
+  guint i, k;
+  gint j;
+
+  for (i = 0; i < n_frames; i++) {
+    for (j = 0; j < channels; j++) {
+      for (k = 0; k < kernel_length && k <= i; k++)
+        output[i * channels + j] += kernel[k] * input[(i - k) * channels + j];
+    }
+  }
+
+  return output;
+}
+
+static GstElement *
+setup_fir_filter (guint partition_length, gint channels,
+    const gdouble * kernel, guint kernel_length)
+{
+  GstElement *filter;
+  GstCaps *caps;
+
+  filter = gst_check_setup_element ("audiofirfilter");
+  g_object_set (G_OBJECT (filter), "partition-length", partition_length,
+      NULL);
+  set_kernel (filter, kernel, kernel_length);
+
+  mysrcpad = gst_check_setup_src_pad (filter, &srctemplate);
+  mysinkpad = gst_check_setup_sink_pad (filter, &sinktemplate);
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (filter,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+#if G_BYTE_ORDER == G_BIG_ENDIAN
+      "format", G_TYPE_STRING, "F64BE",
+#else
+      "format", G_TYPE_STRING, "F64LE",
+#endif
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, FIR_RATE, "channels", G_TYPE_INT, channels,
+      "channel-mask", GST_TYPE_BITMASK, G_GUINT64_CONSTANT (0), NULL);
+  gst_check_setup_events (mysrcpad, filter, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  return filter;
+}
+
+/* pushes the frames @offset to @offset + @n_frames of @input in buffers of
+ * different sizes that don't match the block length */
+static void
+push_frames (const gdouble * input, gint channels, guint offset,
+    guint n_frames)
+{
+  static const guint sizes[] = { 100, 37, 256, 1, 64 };
+  guint i = 0;
+
+  while (n_frames > 0) {
+    guint n = MIN (sizes[i++ % G_N_ELEMENTS (sizes)], n_frames);
+    gsize size = n * channels * sizeof (gdouble);
+    GstBuffer *buffer;
+
+    buffer = gst_buffer_new_wrapped (g_memdup (input + offset * channels,
+            size), size);
+    GST_BUFFER_TIMESTAMP (buffer) =
+        gst_util_uint64_scale_int (offset, GST_SECOND, FIR_RATE);
+    GST_BUFFER_DURATION (buffer) =
+        gst_util_uint64_scale_int (n, GST_SECOND, FIR_RATE);
+    GST_BUFFER_OFFSET (buffer) = offset;
+    GST_BUFFER_OFFSET_END (buffer) = offset + n;
+
+    fail_unless_equals_int (gst_pad_push (mysrcpad, buffer), GST_FLOW_OK);
+    offset += n;
+    n_frames -= n;
+  }
+}
+
+/* drains the filter and returns all its output, which must be as long as the
+ * input */
+static gdouble *
+finish_fir_filter (GstElement * filter, gint channels, guint n_frames)
+{
+  gdouble *output = g_new (gdouble, n_frames * channels);
+  gsize size = 0;
+  GList *l;
+
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  for (l = buffers; l; l = l->next) {
+    GstBuffer *buffer = l->data;
+    gsize buffer_size = gst_buffer_get_size (buffer);
+
+    fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buffer),
+        size / (channels * sizeof (gdouble)));
+    fail_unless (size + buffer_size <= n_frames * channels * sizeof (gdouble));
+    gst_buffer_extract (buffer, 0, (guint8 *) output + size, buffer_size);
+    size += buffer_size;
+  }
+  fail_unless_equals_int (size, n_frames * channels * sizeof (gdouble));
+  gst_check_drop_buffers ();
+
+  fail_unless (gst_element_set_state (filter,
+          GST_STATE_NULL) == GST_STATE_CHANGE_SUCCESS);
+  gst_pad_set_active (mysrcpad, FALSE);
+  gst_pad_set_active (mysinkpad, FALSE);
+  gst_check_teardown_src_pad (filter);
+  gst_check_teardown_sink_pad (filter);
+  gst_check_teardown_element (filter);
+
+  return output;
+}
+
+static void
+check_samples (const gdouble * output, const gdouble * expected, guint n)
+{
+  guint i;
+
+  for (i = 0; i < n; i++)
+    fail_unless (fabs (output[i] - expected[i]) < 1e-9,
+        "sample %u is %f instead of %f", i, output[i], expected[i]);
+}
+
+/* The partitioned convolution must give the same output as the single block
+ * and the direct convolution. This includes the residue drained at EOS,
+ * which is a partial block here, for the fixed and generic channel counts */
+GST_START_TEST (test_partitioned_output)
+{
+  static const guint partition_lengths[] = { 32, 100 };
+  GRand *rand = g_rand_new_with_seed (2013);
+  gdouble *kernel, *input, *expected, *single, *output;
+  GstElement *filter;
+  gint channels;
+  guint i;
+
+  kernel = random_samples (rand, 64);
+
+  for (channels = 1; channels <= 3; channels++) {
+    input = random_samples (rand, 1000 * channels);
+    expected = convolve (input, 1000, channels, kernel, 64);
+
+    filter = setup_fir_filter (0, channels, kernel, 64);
+    push_frames (input, channels, 0, 1000);
+    single = finish_fir_filter (filter, channels, 1000);
+    check_samples (single, expected, 1000 * channels);
+
+    for (i = 0; i < G_N_ELEMENTS (partition_lengths); i++) {
+      filter = setup_fir_filter (partition_lengths[i], channels, kernel, 64);
+      push_frames (input, channels, 0, 1000);
+      output = finish_fir_filter (filter, channels, 1000);
+      check_samples (output, single, 1000 * channels);
+      g_free (output);
+    }
+
+    g_free (single);
+    g_free (expected);
+    g_free (input);
+  }
+
+  g_free (kernel);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+/* Replacing the kernel while running continues with the history of the
+ * input and crossfades from the old to the new kernel over one block, so
+ * that no samples are lost or repeated and there is no jump */
+GST_START_TEST (test_partitioned_kernel_change)
+{
+  GRand *rand = g_rand_new_with_seed (2013);
+  gdouble *kernel1, *kernel2, *input, *expected1, *expected2, *output;
+  GstElement *filter;
+  guint i;
+  gint j;
+
+  /* two partitions of 32 samples before and three after the change */
+  kernel1 = random_samples (rand, 64);
+  kernel2 = random_samples (rand, 96);
+  input = random_samples (rand, 1000 * 2);
+  expected1 = convolve (input, 1000, 2, kernel1, 64);
+  expected2 = convolve (input, 1000, 2, kernel2, 96);
+
+  filter = setup_fir_filter (32, 2, kernel1, 64);
+  push_frames (input, 2, 0, 320);
+  set_kernel (filter, kernel2, 96);
+  push_frames (input, 2, 320, 680);
+  output = finish_fir_filter (filter, 2, 1000);
+
+  check_samples (output, expected1, 320 * 2);
+  for (i = 320; i < 352; i++) {
+    gdouble w = (gdouble) (i - 320 + 1) / 33;
+
+    for (j = 0; j < 2; j++) {
+      fail_unless (fabs (output[i * 2 + j] - (w * expected2[i * 2 + j] +
+                  (1.0 - w) * expected1[i * 2 + j])) < 1e-9,
+          "sample %u of channel %d is not crossfaded", i, j);
+    }
+  }
+  check_samples (output + 352 * 2, expected2 + 352 * 2, (1000 - 352) * 2);
+
+  g_free (output);
+  g_free (expected2);
+  g_free (expected1);
+  g_free (input);
+  g_free (kernel2);
+  g_free (kernel1);
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 static Suite *
 audiofirfilter_suite (void)
 {
@@ -185,6 +586,9 @@ audiofirfilter_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_pipeline);
+  tcase_add_test (tc_chain, test_partitioned);
+  tcase_add_test (tc_chain, test_partitioned_output);
+  tcase_add_test (tc_chain, test_partitioned_kernel_change);
 
   return s;
 }
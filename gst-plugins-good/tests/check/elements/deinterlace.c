@@ -22,9 +22,14 @@
 #endif
 
 #include <stdio.h>
+#include <string.h>
 #include <gst/check/gstcheck.h>
 #include <gst/video/video.h>
 
+/* for testing the yadif line filters directly */
+#include "../../gst/deinterlace/gstdeinterlacemethod.h"
+#include "../../gst/deinterlace/yadifline.inc"
+
 static gboolean
 gst_caps_is_interlaced (GstCaps * caps)
 {
@@ -435,6 +440,311 @@ GST_START_TEST (test_mode_auto_deinterlaced_passthrough)
 
 GST_END_TEST;
 
+static GstStaticPadTemplate rawsrctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS ("video/x-raw"));
+static GstStaticPadTemplate rawsinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS ("video/x-raw"));
+
+/* creates @n_frames frames described by @info, every component sample is
+ * set to func (component, x, y, frame number) */
+static GList *
+create_frames (GstVideoInfo * info, guint n_frames,
+    guint8 (*func) (gint c, gint x, gint y, guint n, GstVideoInfo * info))
+{
+  GList *frames = NULL;
+  guint n;
+  gint c, x, y;
+
+  for (n = 0; n < n_frames; n++) {
+    GstBuffer *buf;
+    GstVideoFrame frame;
+
+    buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info), NULL);
+    GST_BUFFER_PTS (buf) = gst_util_uint64_scale (n, GST_SECOND *
+        GST_VIDEO_INFO_FPS_D (info), GST_VIDEO_INFO_FPS_N (info));
+    GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (GST_SECOND,
+        GST_VIDEO_INFO_FPS_D (info), GST_VIDEO_INFO_FPS_N (info));
+
+    fail_unless (gst_video_frame_map (&frame, info, buf, GST_MAP_WRITE));
+    for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (&frame); c++) {
+      guint8 *data = GST_VIDEO_FRAME_COMP_DATA (&frame, c);
+      gint stride = GST_VIDEO_FRAME_COMP_STRIDE (&frame, c);
+      gint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (&frame, c);
+
+      for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&frame, c); y++)
+        for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&frame, c); x++)
+          data[y * stride + x * pstride] = func (c, x, y, n, info);
+    }
+    gst_video_frame_unmap (&frame);
+
+    frames = g_list_append (frames, buf);
+  }
+
+  return frames;
+}
+
+/* pushes @frames through deinterlace with the given method and number of
+ * threads and returns the output buffers */
+static GList *
+deinterlace_frames (const gchar * method, guint n_threads,
+    GstVideoInfo * info, GList * frames)
+{
+  GstElement *element;
+  GstPad *mysrcpad, *mysinkpad;
+  GstCaps *caps;
+  GList *l, *out;
+
+  element = gst_check_setup_element ("deinterlace");
+  gst_util_set_object_arg (G_OBJECT (element), "mode", "interlaced");
+  gst_util_set_object_arg (G_OBJECT (element), "method", method);
+  g_object_set (element, "n-threads", n_threads, NULL);
+
+  mysrcpad = gst_check_setup_src_pad (element, &rawsrctemplate);
+  mysinkpad = gst_check_setup_sink_pad (element, &rawsinktemplate);
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_pad_set_active (mysinkpad, TRUE);
+  fail_unless (gst_element_set_state (element, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_video_info_to_caps (info);
+  gst_check_setup_events (mysrcpad, element, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  for (l = frames; l; l = l->next)
+    fail_unless_equals_int (gst_pad_push (mysrcpad, gst_buffer_ref (l->data)),
+        GST_FLOW_OK);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  out = buffers;
+  buffers = NULL;
+
+  fail_unless (gst_element_set_state (element, GST_STATE_NULL) ==
+      GST_STATE_CHANGE_SUCCESS);
+  gst_pad_set_active (mysrcpad, FALSE);
+  gst_pad_set_active (mysinkpad, FALSE);
+  gst_check_teardown_src_pad (element);
+  gst_check_teardown_sink_pad (element);
+  gst_check_teardown_element (element);
+
+  return out;
+}
+
+/* detailed content with sharp edges that moves differently in every
+ * component */
+static guint8
+moving_pattern (gint c, gint x, gint y, guint n, GstVideoInfo * info)
+{
+  return (x * 7 + y * y + n * 13 * (c + 1)) & 0xff;
+}
+
+static void
+check_n_threads (const gchar * method, GstVideoFormat format)
+{
+  GstVideoInfo info;
+  GList *frames, *ref, *out, *l, *r;
+
+  gst_video_info_set_format (&info, format, 96, 72);
+  GST_VIDEO_INFO_FPS_N (&info) = 25;
+  GST_VIDEO_INFO_FPS_D (&info) = 1;
+  frames = create_frames (&info, 10, moving_pattern);
+
+  ref = deinterlace_frames (method, 1, &info, frames);
+  out = deinterlace_frames (method, 4, &info, frames);
+
+  fail_unless (ref != NULL);
+  fail_unless_equals_int (g_list_length (out), g_list_length (ref));
+  for (l = out, r = ref; l && r; l = l->next, r = r->next)
+    fail_unless (test_buffer_equals (l->data, r->data));
+
+  g_list_free_full (out, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (ref, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (frames, (GDestroyNotify) gst_buffer_unref);
+}
+
+/* Verify that processing bands of lines on multiple threads outputs the same
+ * frames as processing them on one thread */
+GST_START_TEST (test_n_threads)
+{
+  check_n_threads ("linear", GST_VIDEO_FORMAT_I420);
+  check_n_threads ("yadif", GST_VIDEO_FORMAT_I420);
+  check_n_threads ("yadif", GST_VIDEO_FORMAT_YUY2);
+  check_n_threads ("yadif", GST_VIDEO_FORMAT_NV12);
+}
+
+GST_END_TEST;
+
+/* static content that changes non-linearly from line to line, so that
+ * interpolating the missing lines spatially does not reproduce them. The
+ * lines close to the top and bottom edge are flat. */
+static guint8
+static_pattern (gint c, gint x, gint y, guint n, GstVideoInfo * info)
+{
+  gint height = GST_VIDEO_INFO_COMP_HEIGHT (info, c);
+  gint range = height - 9;
+  gint l = CLAMP (y, 4, height - 5) - 4;
+
+  return l * l * 255 / (range * range);
+}
+
+/* Verify that yadif takes the missing lines of static content from the
+ * neighbouring fields */
+GST_START_TEST (test_yadif_static)
+{
+  GstVideoFormat formats[] = { GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_YUY2 };
+  GstVideoInfo info;
+  GList *frames, *out, *l;
+  guint i, n;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    gst_video_info_set_format (&info, formats[i], 96, 72);
+    GST_VIDEO_INFO_FPS_N (&info) = 25;
+    GST_VIDEO_INFO_FPS_D (&info) = 1;
+    frames = create_frames (&info, 6, static_pattern);
+
+    out = deinterlace_frames ("yadif", 1, &info, frames);
+    fail_unless (g_list_length (out) >= 8);
+
+    /* the first and last fields miss the temporal neighbours */
+    for (l = g_list_nth (out, 2), n = 2; n < g_list_length (out) - 2;
+        l = l->next, n++)
+      fail_unless (test_buffer_equals (l->data, frames->data),
+          "field %u differs from the input", n);
+
+    g_list_free_full (out, (GDestroyNotify) gst_buffer_unref);
+    g_list_free_full (frames, (GDestroyNotify) gst_buffer_unref);
+  }
+}
+
+GST_END_TEST;
+
+/* returns TRUE if all components of the frames in @a and @b, which have
+ * different formats with the same subsampling, are equal */
+static gboolean
+components_equal (GstBuffer * a, GstVideoInfo * a_info, GstBuffer * b,
+    GstVideoInfo * b_info)
+{
+  GstVideoFrame fa, fb;
+  gboolean equal = TRUE;
+  gint c, x, y;
+
+  fail_unless (gst_video_frame_map (&fa, a_info, a, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&fb, b_info, b, GST_MAP_READ));
+  for (c = 0; c < GST_VIDEO_FRAME_N_COMPONENTS (&fa); c++) {
+    const guint8 *da = GST_VIDEO_FRAME_COMP_DATA (&fa, c);
+    const guint8 *db = GST_VIDEO_FRAME_COMP_DATA (&fb, c);
+
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&fa, c); y++)
+      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&fa, c); x++)
+        if (da[y * GST_VIDEO_FRAME_COMP_STRIDE (&fa, c) +
+                x * GST_VIDEO_FRAME_COMP_PSTRIDE (&fa, c)] !=
+            db[y * GST_VIDEO_FRAME_COMP_STRIDE (&fb, c) +
+                x * GST_VIDEO_FRAME_COMP_PSTRIDE (&fb, c)])
+          equal = FALSE;
+  }
+  gst_video_frame_unmap (&fa);
+  gst_video_frame_unmap (&fb);
+
+  return equal;
+}
+
+/* points @s to the lines used by the yadif test in @mode, starting at
+ * @offset */
+static void
+setup_yadif_lines (GstDeinterlaceScanlineData * s, guint8 lines[][720],
+    gint offset, gint mode)
+{
+  memset (s, 0, sizeof (GstDeinterlaceScanlineData));
+  s->t0 = lines[0] + offset;
+  s->b0 = lines[1] + offset;
+  s->m1 = mode > 0 ? lines[2] + offset : NULL;
+  s->mp = mode > 0 ? lines[3] + offset : NULL;
+  s->tt1 = lines[4] + offset;
+  s->ttp = lines[5] + offset;
+  s->bb1 = lines[6] + offset;
+  s->bbp = lines[7] + offset;
+  s->t2 = mode > 1 ? lines[8] + offset : NULL;
+  s->b2 = mode > 1 ? lines[9] + offset : NULL;
+}
+
+/* Verify that the SIMD version of the yadif line filter outputs the same
+ * pixels as the C version, and that NV12 is filtered like I420 */
+GST_START_TEST (test_yadif_filter_line)
+{
+  static const gint sizes[] = { 7, 8, 26, 29, 64, 133, 720 };
+  GstDeinterlaceScanlineData s, suv;
+  guint8 lines[10][720], uv[10][720], out[720], ref[720];
+  GstVideoInfo i420_info, nv12_info;
+  GList *i420_frames, *nv12_frames, *i420_out, *nv12_out, *l, *r;
+  GRand *rand;
+  gint step, i, j, mode;
+
+  rand = g_rand_new_with_seed (2013);
+  for (i = 0; i < 10; i++)
+    for (j = 0; j < 720; j++)
+      lines[i][j] = g_rand_int (rand) >> 24;
+  g_rand_free (rand);
+
+  /* spatial only, with the previous field, with both previous fields */
+  for (mode = 0; mode < 3; mode++) {
+    setup_yadif_lines (&s, lines, 0, mode);
+
+    for (step = 1; step <= 4; step++) {
+      for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+        yadif_filter_line (out, &s, sizes[i], step);
+        yadif_filter_line_c (ref, &s, 0, sizes[i], sizes[i], step);
+        fail_unless (memcmp (out, ref, sizes[i]) == 0,
+            "size %d step %d mode %d differs", sizes[i], step, mode);
+      }
+    }
+
+    /* the interleaved chroma of NV12 with step 2 is filtered like the
+     * chroma planes of I420 with step 1, here U is the first and V the
+     * second half of the lines */
+    for (i = 0; i < 10; i++) {
+      for (j = 0; j < 360; j++) {
+        uv[i][2 * j] = lines[i][j];
+        uv[i][2 * j + 1] = lines[i][360 + j];
+      }
+    }
+    setup_yadif_lines (&suv, uv, 0, mode);
+    yadif_filter_line (out, &suv, 720, 2);
+    setup_yadif_lines (&suv, lines, 0, mode);
+    yadif_filter_line (ref, &suv, 360, 1);
+    setup_yadif_lines (&suv, lines, 360, mode);
+    yadif_filter_line (ref + 360, &suv, 360, 1);
+    for (j = 0; j < 360; j++) {
+      fail_unless_equals_int (out[2 * j], ref[j]);
+      fail_unless_equals_int (out[2 * j + 1], ref[360 + j]);
+    }
+  }
+
+  /* and whole frames, where the luma of NV12 is an ordinary plane */
+  gst_video_info_set_format (&i420_info, GST_VIDEO_FORMAT_I420, 96, 72);
+  gst_video_info_set_format (&nv12_info, GST_VIDEO_FORMAT_NV12, 96, 72);
+  GST_VIDEO_INFO_FPS_N (&i420_info) = GST_VIDEO_INFO_FPS_N (&nv12_info) = 25;
+  GST_VIDEO_INFO_FPS_D (&i420_info) = GST_VIDEO_INFO_FPS_D (&nv12_info) = 1;
+  i420_frames = create_frames (&i420_info, 6, moving_pattern);
+  nv12_frames = create_frames (&nv12_info, 6, moving_pattern);
+
+  i420_out = deinterlace_frames ("yadif", 1, &i420_info, i420_frames);
+  nv12_out = deinterlace_frames ("yadif", 1, &nv12_info, nv12_frames);
+
+  fail_unless (i420_out != NULL);
+  fail_unless_equals_int (g_list_length (nv12_out),
+      g_list_length (i420_out));
+  for (l = nv12_out, r = i420_out, i = 0; l && r; l = l->next, r = r->next,
+      i++)
+    fail_unless (components_equal (l->data, &nv12_info, r->data, &i420_info),
+        "NV12 field %d differs from I420", i);
+
+  g_list_free_full (nv12_out, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (i420_out, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (nv12_frames, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (i420_frames, (GDestroyNotify) gst_buffer_unref);
+}
+
+GST_END_TEST;
+
 static Suite *
 deinterlace_suite (void)
 {
@@ -456,6 +766,9 @@ deinterlace_suite (void)
   tcase_add_test (tc_chain, test_mode_disabled_accept_caps);
   tcase_add_test (tc_chain, test_mode_disabled_passthrough);
   tcase_add_test (tc_chain, test_mode_auto_deinterlaced_passthrough);
+  tcase_add_test (tc_chain, test_n_threads);
+  tcase_add_test (tc_chain, test_yadif_static);
+  tcase_add_test (tc_chain, test_yadif_filter_line);
 
   return s;
 }
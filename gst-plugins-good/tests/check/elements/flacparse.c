@@ -189,6 +189,77 @@ GST_START_TEST (test_parse_flac_skip_garbage)
 GST_END_TEST;
 
 
+/*
+ * Test if the frame ends are found when the sync code of the next frame is
+ * split across buffers, i.e. when only its first bytes are available at the
+ * end of the data that is searched.
+ */
+GST_START_TEST (test_parse_flac_split_sync)
+{
+  GstElement *flacparse;
+  GstPad *srcpad, *sinkpad;
+  GstBuffer *buf;
+  GList *l;
+  guint8 *data;
+  guint i, k, size, offset, end;
+
+  size = 4 * sizeof (flac_frame);
+  data = g_malloc (size);
+  for (i = 0; i < 4; i++)
+    memcpy (data + i * sizeof (flac_frame), flac_frame, sizeof (flac_frame));
+
+  /* each buffer ends k bytes into the next frame, which covers the positions
+   * found by the masked scan as well as the ones checked directly */
+  for (k = 1; k <= 16; k++) {
+    flacparse = gst_check_setup_element ("flacparse");
+    srcpad = gst_check_setup_src_pad (flacparse, &srctemplate);
+    sinkpad = gst_check_setup_sink_pad (flacparse, &sinktemplate);
+    gst_pad_set_active (srcpad, TRUE);
+    gst_check_setup_events (srcpad, flacparse, NULL, GST_FORMAT_BYTES);
+    gst_pad_set_active (sinkpad, TRUE);
+
+    fail_unless (gst_element_set_state (flacparse,
+            GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE,
+        "could not set to playing");
+
+    buf = gst_buffer_new_and_alloc (sizeof (streaminfo_header));
+    gst_buffer_fill (buf, 0, streaminfo_header, sizeof (streaminfo_header));
+    fail_unless_equals_int (gst_pad_push (srcpad, buf), GST_FLOW_OK);
+    buf = gst_buffer_new_and_alloc (sizeof (comment_header));
+    gst_buffer_fill (buf, 0, comment_header, sizeof (comment_header));
+    fail_unless_equals_int (gst_pad_push (srcpad, buf), GST_FLOW_OK);
+
+    for (i = 1, offset = 0; i <= 4; i++, offset = end) {
+      end = MIN (i * sizeof (flac_frame) + k, size);
+      buf = gst_buffer_new_and_alloc (end - offset);
+      gst_buffer_fill (buf, 0, data + offset, end - offset);
+      fail_unless_equals_int (gst_pad_push (srcpad, buf), GST_FLOW_OK);
+    }
+    fail_unless (gst_pad_push_event (srcpad, gst_event_new_eos ()));
+
+    fail_unless_equals_int (g_list_length (buffers), ctx_discard + 4);
+    for (l = g_list_nth (buffers, ctx_discard); l; l = l->next) {
+      fail_unless_equals_int (gst_buffer_get_size (l->data),
+          sizeof (flac_frame));
+      fail_unless (gst_buffer_memcmp (l->data, 0, flac_frame,
+              sizeof (flac_frame)) == 0);
+    }
+
+    gst_check_drop_buffers ();
+    gst_element_set_state (flacparse, GST_STATE_NULL);
+    gst_pad_set_active (srcpad, FALSE);
+    gst_pad_set_active (sinkpad, FALSE);
+    gst_check_teardown_src_pad (flacparse);
+    gst_check_teardown_sink_pad (flacparse);
+    gst_check_teardown_element (flacparse);
+  }
+
+  g_free (data);
+}
+
+GST_END_TEST;
+
+
 #define structure_get_int(s,f) \
     (g_value_get_int(gst_structure_get_value(s,f)))
 #define fail_unless_structure_field_int_equals(s,field,num) \
@@ -256,6 +327,7 @@ flacparse_suite (void)
   tcase_add_test (tc_chain, test_parse_flac_drain_garbage);
   tcase_add_test (tc_chain, test_parse_flac_split);
   tcase_add_test (tc_chain, test_parse_flac_skip_garbage);
+  tcase_add_test (tc_chain, test_parse_flac_split_sync);
 
   /* Other tests */
   tcase_add_test (tc_chain, test_parse_flac_detect_stream);
@@ -20,6 +20,7 @@
  */
 
 #include <unistd.h>
+#include <string.h>
 
 #include <gio/gio.h>
 #include <gst/check/gstcheck.h>
@@ -125,6 +126,73 @@ GST_START_TEST (test_jpegdec_discover)
 
 GST_END_TEST;
 
+/* decodes a moving pattern with the given number of threads and returns the
+ * decoded buffers in output order */
+static GList *
+decode_moving_pattern (guint n_threads)
+{
+  GstElement *pipeline, *sink;
+  GstSample *sample;
+  GList *buffers = NULL;
+  gchar *desc;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=20 pattern=ball ! "
+      "video/x-raw,format=I420,width=64,height=48,framerate=25/1 ! jpegenc ! "
+      "jpegdec n-threads=%u ! appsink name=sink sync=false", n_threads);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  while ((sample = gst_app_sink_pull_sample (GST_APP_SINK (sink)))) {
+    buffers = g_list_append (buffers,
+        gst_buffer_ref (gst_sample_get_buffer (sample)));
+    gst_sample_unref (sample);
+  }
+  fail_unless (gst_app_sink_is_eos (GST_APP_SINK (sink)));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return buffers;
+}
+
+/* Verify that decoding on multiple threads outputs the same frames in the
+ * same order as decoding on one thread */
+GST_START_TEST (test_jpegdec_n_threads)
+{
+  GList *ref, *buffers, *l, *r;
+
+  ref = decode_moving_pattern (1);
+  buffers = decode_moving_pattern (4);
+
+  fail_unless_equals_int (g_list_length (ref), 20);
+  fail_unless_equals_int (g_list_length (buffers), 20);
+
+  for (l = buffers, r = ref; l && r; l = l->next, r = r->next) {
+    GstBuffer *buf = l->data, *ref_buf = r->data;
+    GstMapInfo map, ref_map;
+
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (buf),
+        GST_BUFFER_TIMESTAMP (ref_buf));
+
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    gst_buffer_map (ref_buf, &ref_map, GST_MAP_READ);
+    fail_unless_equals_int (map.size, ref_map.size);
+    fail_unless (memcmp (map.data, ref_map.data, map.size) == 0);
+    gst_buffer_unmap (ref_buf, &ref_map);
+    gst_buffer_unmap (buf, &map);
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (ref, (GDestroyNotify) gst_buffer_unref);
+}
+
+GST_END_TEST;
+
 static Suite *
 jpegdec_suite (void)
 {
@@ -134,6 +202,7 @@ jpegdec_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_jpegdec_explicit);
   tcase_add_test (tc_chain, test_jpegdec_discover);
+  tcase_add_test (tc_chain, test_jpegdec_n_threads);
 
   return s;
 }
@@ -21,9 +21,11 @@
  */
 
 #include <unistd.h>
+#include <string.h>
 
 #include <gst/check/gstcheck.h>
 #include <gst/app/gstappsink.h>
+#include <gst/video/gstvideometa.h>
 
 /* For ease of programming we use globals to keep refs for our floating
  * sink pads we create; otherwise we always have to do get_pad,
@@ -223,6 +225,145 @@ GST_START_TEST (test_jpegenc_different_caps)
 
 GST_END_TEST;
 
+/* encodes a moving pattern with the given number of threads and returns the
+ * encoded buffers in output order */
+static GList *
+encode_moving_pattern (guint n_threads)
+{
+  GstElement *pipeline, *sink;
+  GstSample *sample;
+  GList *buffers = NULL;
+  gchar *desc;
+
+  desc = g_strdup_printf ("videotestsrc num-buffers=20 pattern=ball ! "
+      "video/x-raw,format=I420,width=64,height=48,framerate=25/1 ! "
+      "jpegenc n-threads=%u ! appsink name=sink sync=false", n_threads);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  while ((sample = gst_app_sink_pull_sample (GST_APP_SINK (sink)))) {
+    buffers = g_list_append (buffers,
+        gst_buffer_ref (gst_sample_get_buffer (sample)));
+    gst_sample_unref (sample);
+  }
+  fail_unless (gst_app_sink_is_eos (GST_APP_SINK (sink)));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return buffers;
+}
+
+/* Verify that encoding on multiple threads outputs the same images in the
+ * same order as encoding on one thread */
+GST_START_TEST (test_jpegenc_n_threads)
+{
+  GList *ref, *buffers, *l, *r;
+
+  ref = encode_moving_pattern (1);
+  buffers = encode_moving_pattern (4);
+
+  fail_unless_equals_int (g_list_length (ref), 20);
+  fail_unless_equals_int (g_list_length (buffers), 20);
+
+  for (l = buffers, r = ref; l && r; l = l->next, r = r->next) {
+    GstBuffer *buf = l->data, *ref_buf = r->data;
+    GstMapInfo map, ref_map;
+
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (buf),
+        GST_BUFFER_TIMESTAMP (ref_buf));
+
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    gst_buffer_map (ref_buf, &ref_map, GST_MAP_READ);
+    fail_unless_equals_int (map.size, ref_map.size);
+    fail_unless (memcmp (map.data, ref_map.data, map.size) == 0);
+    gst_buffer_unmap (ref_buf, &ref_map);
+    gst_buffer_unmap (buf, &map);
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (ref, (GDestroyNotify) gst_buffer_unref);
+}
+
+GST_END_TEST;
+
+/* Verify that a frame marked as a repeat is not compressed but gets the
+ * image of the previous frame, with its own timestamps */
+GST_START_TEST (test_jpegenc_repeat)
+{
+  GstElement *jpegenc;
+  GstBuffer *buffer, *repeat;
+  GstMapInfo map;
+  GstCaps *caps;
+  GList *l;
+  guint i;
+
+  jpegenc = setup_jpegenc (&jpeg_sinktemplate);
+  g_object_set (jpegenc, "n-threads", 2, NULL);
+  gst_element_set_state (jpegenc, GST_STATE_PLAYING);
+
+  caps = gst_caps_new_simple ("video/x-raw", "width", G_TYPE_INT,
+      64, "height", G_TYPE_INT, 48, "framerate",
+      GST_TYPE_FRACTION, 25, 1, "format", G_TYPE_STRING, "I420", NULL);
+  gst_check_setup_events (mysrcpad, jpegenc, caps, GST_FORMAT_TIME);
+  fail_unless ((buffer = create_video_buffer (caps)) != NULL);
+  gst_caps_unref (caps);
+
+  /* image, repeat, repeat, image. The repeats have other pixels, which
+   * would give another image if they were compressed */
+  for (i = 0; i < 4; i++) {
+    GstBuffer *inbuf;
+
+    if (i == 1 || i == 2) {
+      inbuf = gst_buffer_new_and_alloc (gst_buffer_get_size (buffer));
+      gst_buffer_memset (inbuf, 0, 0, gst_buffer_get_size (inbuf));
+      gst_buffer_add_video_repeat_meta (inbuf, 0, i);
+    } else {
+      inbuf = gst_buffer_copy (buffer);
+    }
+    GST_BUFFER_TIMESTAMP (inbuf) = i * GST_SECOND / 25;
+    GST_BUFFER_DURATION (inbuf) = GST_SECOND / 25;
+    fail_unless (gst_pad_push (mysrcpad, inbuf) == GST_FLOW_OK);
+  }
+  gst_buffer_unref (buffer);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  fail_unless_equals_int (g_list_length (buffers), 4);
+  for (l = buffers, i = 0; l; l = l->next, i++) {
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (l->data),
+        i * GST_SECOND / 25);
+    fail_unless_equals_uint64 (GST_BUFFER_DURATION (l->data),
+        GST_SECOND / 25);
+    fail_unless_equals_int (gst_buffer_n_memory (l->data), 1);
+  }
+
+  /* the repeats share the memory of the first image */
+  buffer = g_list_nth_data (buffers, 0);
+  for (i = 1; i < 3; i++) {
+    repeat = g_list_nth_data (buffers, i);
+    fail_unless (gst_buffer_peek_memory (repeat, 0) ==
+        gst_buffer_peek_memory (buffer, 0));
+  }
+  /* and the next image is compressed again, to the same data */
+  repeat = g_list_nth_data (buffers, 3);
+  fail_if (gst_buffer_peek_memory (repeat, 0) ==
+      gst_buffer_peek_memory (buffer, 0));
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  fail_unless_equals_int (gst_buffer_get_size (repeat), map.size);
+  fail_unless (gst_buffer_memcmp (repeat, 0, map.data, map.size) == 0);
+  gst_buffer_unmap (buffer, &map);
+
+  gst_check_drop_buffers ();
+  cleanup_jpegenc (jpegenc);
+}
+
+GST_END_TEST;
+
 static Suite *
 jpegenc_suite (void)
 {
@@ -232,6 +373,8 @@ jpegenc_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_jpegenc_getcaps);
   tcase_add_test (tc_chain, test_jpegenc_different_caps);
+  tcase_add_test (tc_chain, test_jpegenc_n_threads);
+  tcase_add_test (tc_chain, test_jpegenc_repeat);
 
   return s;
 }
@@ -582,6 +582,83 @@ GST_START_TEST (test_message_timestamps)
 
 GST_END_TEST;
 
+/* layout of the record copied by the read-record signal */
+typedef struct
+{
+  guint32 seqnum;
+  guint32 channels;
+  GstClockTime timestamp;
+  GstClockTime stream_time;
+  GstClockTime running_time;
+  GstClockTime duration;
+  gdouble levels[2][3];
+} LevelRecord;
+
+GST_START_TEST (test_read_record)
+{
+  GstElement *level;
+  GstBuffer *inbuffer, *outbuffer;
+  GstBus *bus;
+  GstMessage *message;
+  LevelRecord record;
+  guint size;
+  gint i, j;
+
+  level = setup_level (LEVEL_S16_CAPS_STRING);
+  g_object_set (level, "message", TRUE, "interval", GST_SECOND / 20,
+      "message-decimation", 2, NULL);
+  gst_element_set_state (level, GST_STATE_PLAYING);
+  /* create a bus to get the level message on */
+  bus = gst_bus_new ();
+  gst_element_set_bus (level, bus);
+
+  /* no interval completed yet */
+  g_signal_emit_by_name (level, "read-record", &record, sizeof (record),
+      &size);
+  fail_unless_equals_int (size, sizeof (record));
+  fail_unless_equals_int (record.seqnum, 0);
+
+  /* create a fake 0.1 sec buffer with a half-amplitude block signal */
+  inbuffer = create_s16_buffer (16536, 16536);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  fail_if ((outbuffer = (GstBuffer *) buffers->data) == NULL);
+  fail_unless (inbuffer == outbuffer);
+
+  /* two intervals passed, but only the second one is posted */
+  message = gst_bus_poll (bus, GST_MESSAGE_ELEMENT, 0);
+  fail_unless (message != NULL);
+  gst_message_unref (message);
+  message = gst_bus_poll (bus, GST_MESSAGE_ELEMENT, 0);
+  fail_unless (message == NULL);
+
+  g_signal_emit_by_name (level, "read-record", &record, sizeof (record),
+      &size);
+  fail_unless_equals_int (size, sizeof (record));
+  fail_unless_equals_int (record.seqnum, 2);
+  fail_unless_equals_int (record.channels, 2);
+  fail_unless_equals_uint64 (record.timestamp, GST_SECOND / 20);
+  fail_unless_equals_uint64 (record.duration, GST_SECOND / 20);
+
+  /* block wave of half amplitude has -5.94 dB for rms, peak and decay */
+  for (i = 0; i < 2; ++i) {
+    for (j = 0; j < 3; ++j) {
+      GST_DEBUG ("channel %d level %d is %lf", i, j, record.levels[i][j]);
+      fail_if (record.levels[i][j] < -6.1);
+      fail_if (record.levels[i][j] > -5.9);
+    }
+  }
+
+  gst_element_set_bus (level, NULL);
+  gst_object_unref (bus);
+  gst_buffer_unref (outbuffer);
+  gst_element_set_state (level, GST_STATE_NULL);
+  cleanup_level (level);
+}
+
+GST_END_TEST;
+
 static Suite *
 level_suite (void)
 {
@@ -597,6 +674,7 @@ level_suite (void)
   tcase_add_test (tc_chain, test_message_on_eos);
   tcase_add_test (tc_chain, test_message_count);
   tcase_add_test (tc_chain, test_message_timestamps);
+  tcase_add_test (tc_chain, test_read_record);
 
   return s;
 }
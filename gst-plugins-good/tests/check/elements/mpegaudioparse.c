@@ -123,6 +123,85 @@ GST_START_TEST (test_parse_detect_stream)
 GST_END_TEST;
 
 
+static gint64 vbr_stream_size;
+
+static gboolean
+vbr_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
+{
+  GstFormat format;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_SEEKING:
+      gst_query_parse_seeking (query, &format, NULL, NULL, NULL);
+      if (format != GST_FORMAT_BYTES)
+        return FALSE;
+      gst_query_set_seeking (query, format, TRUE, 0, vbr_stream_size);
+      return TRUE;
+    case GST_QUERY_DURATION:
+      gst_query_parse_duration (query, &format, NULL);
+      if (format != GST_FORMAT_BYTES)
+        return FALSE;
+      gst_query_set_duration (query, format, vbr_stream_size);
+      return TRUE;
+    default:
+      return gst_pad_query_default (pad, parent, query);
+  }
+}
+
+GST_START_TEST (test_parse_vbr_duration)
+{
+  GstElement *mpegaudioparse;
+  GstPad *srcpad, *sinkpad;
+  GstBuffer *buf;
+  GstMapInfo map;
+  gint64 duration;
+  guint i, offset;
+
+  /* 4 frames at 128 kbps followed by 36 frames at 160 kbps */
+  vbr_stream_size = 4 * 384 + 36 * 480;
+  buf = gst_buffer_new_and_alloc (vbr_stream_size);
+  gst_buffer_memset (buf, 0, 0, vbr_stream_size);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (i = 0, offset = 0; i < 40; i++) {
+    GST_WRITE_UINT32_BE (map.data + offset, i < 4 ? 0xfffb94c4 : 0xfffba4c4);
+    offset += i < 4 ? 384 : 480;
+  }
+  gst_buffer_unmap (buf, &map);
+  GST_BUFFER_OFFSET (buf) = 0;
+
+  mpegaudioparse = gst_check_setup_element ("mpegaudioparse");
+  srcpad = gst_check_setup_src_pad (mpegaudioparse, &srctemplate);
+  gst_pad_set_query_function (srcpad, vbr_src_query);
+  sinkpad = gst_check_setup_sink_pad (mpegaudioparse, &sinktemplate);
+  gst_pad_set_active (srcpad, TRUE);
+  gst_check_setup_events (srcpad, mpegaudioparse, NULL, GST_FORMAT_BYTES);
+  gst_pad_set_active (sinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (mpegaudioparse,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE,
+      "could not set to playing");
+
+  fail_unless_equals_int (gst_pad_push (srcpad, buf), GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 40);
+
+  /* all frames were seen, so the duration is exact and not estimated from
+   * the bitrate of the first frames */
+  fail_unless (gst_element_query_duration (mpegaudioparse, GST_FORMAT_TIME,
+          &duration));
+  fail_unless_equals_uint64 (duration, 40 * 24 * GST_MSECOND);
+
+  gst_check_drop_buffers ();
+  gst_element_set_state (mpegaudioparse, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_pad_set_active (sinkpad, FALSE);
+  gst_check_teardown_src_pad (mpegaudioparse);
+  gst_check_teardown_sink_pad (mpegaudioparse);
+  gst_check_teardown_element (mpegaudioparse);
+}
+
+GST_END_TEST;
+
+
 static Suite *
 mpegaudioparse_suite (void)
 {
@@ -136,6 +215,7 @@ mpegaudioparse_suite (void)
   tcase_add_test (tc_chain, test_parse_split);
   tcase_add_test (tc_chain, test_parse_skip_garbage);
   tcase_add_test (tc_chain, test_parse_detect_stream);
+  tcase_add_test (tc_chain, test_parse_vbr_duration);
 
   return s;
 }
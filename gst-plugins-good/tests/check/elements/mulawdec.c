@@ -109,6 +109,49 @@ GST_START_TEST (test_one_buffer)
 
 GST_END_TEST;
 
+GST_START_TEST (test_n_threads)
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  GList *l;
+  gint16 last = G_MININT16;
+  gint i, j;
+
+  g_object_set (mulawdec, "n-threads", 4, NULL);
+
+  fail_unless (gst_element_set_state (mulawdec, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_SUCCESS, "could not change state to playing");
+
+  /* mu law codes 0 to 127 decode to increasing negative values, so the
+   * order of the output shows whether the frames were reordered */
+  for (i = 0; i < 32; i++) {
+    buffer = gst_buffer_new_allocate (NULL, 80, NULL);
+    gst_buffer_memset (buffer, 0, i, 80);
+    GST_BUFFER_TIMESTAMP (buffer) = i * 10 * GST_MSECOND;
+    GST_BUFFER_DURATION (buffer) = 10 * GST_MSECOND;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  fail_unless_equals_int (g_list_length (buffers), 32);
+  for (l = buffers, i = 0; l; l = l->next, i++) {
+    buffer = GST_BUFFER (l->data);
+
+    fail_unless_equals_uint64 (GST_BUFFER_TIMESTAMP (buffer),
+        i * 10 * GST_MSECOND);
+    fail_unless (gst_buffer_map (buffer, &map, GST_MAP_READ));
+    fail_unless_equals_int (map.size, 160);
+    for (j = 0; j < 80; j++)
+      fail_unless_equals_int (((gint16 *) map.data)[j],
+          ((gint16 *) map.data)[0]);
+    fail_unless (((gint16 *) map.data)[0] > last);
+    last = ((gint16 *) map.data)[0];
+    gst_buffer_unmap (buffer, &map);
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 mulawdec_suite (void)
 {
@@ -119,6 +162,7 @@ mulawdec_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_one_buffer);
+  tcase_add_test (tc_chain, test_n_threads);
   return s;
 }
 
@@ -30,6 +30,7 @@
 #endif
 
 #include <unistd.h>
+#include <string.h>
 
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstconsistencychecker.h>
@@ -1023,6 +1024,232 @@ GST_START_TEST (test_flush_start_flush_stop)
 GST_END_TEST;
 
 
+static void
+handoff_collect_cb (GstElement * fakesink, GstBuffer * buffer, GstPad * pad,
+    GList ** buffers)
+{
+  *buffers = g_list_append (*buffers, gst_buffer_ref (buffer));
+}
+
+/* mixes overlapping, partly opaque and partly transparent inputs with the
+ * given number of threads and returns the output buffers */
+static GList *
+mix_overlapping_inputs (guint n_threads)
+{
+  GstElement *pipeline, *sink;
+  GstBus *bus;
+  GstMessage *msg;
+  GList *buffers = NULL;
+  gchar *desc;
+
+  desc = g_strdup_printf ("videomixer name=mix n-threads=%u "
+      "sink_1::xpos=37 sink_1::ypos=19 sink_1::alpha=0.5 "
+      "sink_2::xpos=-10 sink_2::ypos=50 "
+      "sink_3::xpos=0 sink_3::ypos=0 ! "
+      "video/x-raw,format=I420,width=160,height=120 ! "
+      "fakesink name=sink signal-handoffs=true sync=false "
+      "videotestsrc num-buffers=5 pattern=snow ! "
+      "video/x-raw,format=I420,width=160,height=120 ! mix.sink_0 "
+      "videotestsrc num-buffers=5 pattern=smpte ! "
+      "video/x-raw,format=I420,width=81,height=45 ! mix.sink_1 "
+      "videotestsrc num-buffers=5 pattern=ball ! "
+      "video/x-raw,format=I420,width=100,height=90 ! mix.sink_2 "
+      "videotestsrc num-buffers=5 pattern=blue ! "
+      "video/x-raw,format=I420,width=160,height=33 ! mix.sink_3", n_threads);
+  pipeline = gst_parse_launch (desc, NULL);
+  g_free (desc);
+  fail_unless (pipeline != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_signal_connect (sink, "handoff", (GCallback) handoff_collect_cb, &buffers);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return buffers;
+}
+
+/* check that blending in bands on multiple threads gives the same output as
+ * blending on one thread */
+GST_START_TEST (test_n_threads)
+{
+  GList *ref, *buffers, *l, *r;
+
+  ref = mix_overlapping_inputs (1);
+  buffers = mix_overlapping_inputs (4);
+
+  fail_unless_equals_int (g_list_length (ref), 5);
+  fail_unless_equals_int (g_list_length (buffers), 5);
+
+  for (l = buffers, r = ref; l && r; l = l->next, r = r->next) {
+    GstBuffer *buf = l->data, *ref_buf = r->data;
+    GstMapInfo map, ref_map;
+
+    gst_buffer_map (buf, &map, GST_MAP_READ);
+    gst_buffer_map (ref_buf, &ref_map, GST_MAP_READ);
+    fail_unless_equals_int (map.size, ref_map.size);
+    fail_unless (memcmp (map.data, ref_map.data, map.size) == 0);
+    gst_buffer_unmap (ref_buf, &ref_map);
+    gst_buffer_unmap (buf, &map);
+  }
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  g_list_free_full (ref, (GDestroyNotify) gst_buffer_unref);
+}
+
+GST_END_TEST;
+
+#define SOLID_WIDTH 64
+#define SOLID_HEIGHT 96
+
+typedef struct
+{
+  const gchar *pattern;
+  gint xpos, ypos, width, height;
+  gdouble alpha;
+  guint8 y, u, v;
+} SolidLayer;
+
+/* solid color inputs from bottom to top: a black background, red at half
+ * alpha partly below opaque blue, white completely hidden below the blue and
+ * an opaque white strip that is clipped by the output. The colors are the
+ * BT.601 values of videotestsrc. */
+static const SolidLayer solid_layers[] = {
+  {"black", 0, 0, SOLID_WIDTH, SOLID_HEIGHT, 1.0, 16, 128, 128},
+  {"red", 8, 8, 40, 40, 0.5, 81, 90, 240},
+  {"white", 24, 24, 8, 8, 1.0, 235, 128, 128},
+  {"blue", 20, 20, 36, 36, 1.0, 41, 240, 110},
+  {"white", -8, 80, 80, 24, 1.0, 235, 128, 128}
+};
+
+/* mixes the solid layers with the given number of threads */
+static GList *
+mix_solid_inputs (guint n_threads)
+{
+  GstElement *pipeline, *sink;
+  GstBus *bus;
+  GstMessage *msg;
+  GList *buffers = NULL;
+  GString *desc;
+  guint i;
+
+  desc = g_string_new (NULL);
+  g_string_append_printf (desc, "videomixer name=mix n-threads=%u ",
+      n_threads);
+  for (i = 0; i < G_N_ELEMENTS (solid_layers); i++) {
+    g_string_append_printf (desc, "sink_%u::zorder=%u sink_%u::xpos=%d "
+        "sink_%u::ypos=%d sink_%u::alpha=%s ", i, i, i, solid_layers[i].xpos,
+        i, solid_layers[i].ypos, i,
+        solid_layers[i].alpha == 1.0 ? "1.0" : "0.5");
+  }
+  g_string_append_printf (desc, "! video/x-raw,format=Y444,width=%d,height=%d "
+      "! fakesink name=sink signal-handoffs=true sync=false ", SOLID_WIDTH,
+      SOLID_HEIGHT);
+  for (i = 0; i < G_N_ELEMENTS (solid_layers); i++) {
+    g_string_append_printf (desc, "videotestsrc num-buffers=3 pattern=%s ! "
+        "video/x-raw,format=Y444,width=%d,height=%d ! mix.sink_%u ",
+        solid_layers[i].pattern, solid_layers[i].width,
+        solid_layers[i].height, i);
+  }
+  pipeline = gst_parse_launch (desc->str, NULL);
+  g_string_free (desc, TRUE);
+  fail_unless (pipeline != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_signal_connect (sink, "handoff", (GCallback) handoff_collect_cb, &buffers);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+
+  return buffers;
+}
+
+/* compares a mixed Y444 frame with the solid layers blended bottom to top the
+ * way the blend functions do it */
+static void
+check_solid_frame (GstBuffer * buf)
+{
+  GstMapInfo map;
+  gint x, y, c;
+  guint i;
+
+  gst_buffer_map (buf, &map, GST_MAP_READ);
+  fail_unless_equals_int (map.size, 3 * SOLID_WIDTH * SOLID_HEIGHT);
+
+  for (y = 0; y < SOLID_HEIGHT; y++) {
+    for (x = 0; x < SOLID_WIDTH; x++) {
+      gint expected[3] = { 0, 0, 0 };
+
+      for (i = 0; i < G_N_ELEMENTS (solid_layers); i++) {
+        const SolidLayer *l = &solid_layers[i];
+        gint color[3] = { l->y, l->u, l->v };
+        gint a = l->alpha * 256;
+
+        if (x < l->xpos || x >= l->xpos + l->width ||
+            y < l->ypos || y >= l->ypos + l->height)
+          continue;
+
+        for (c = 0; c < 3; c++)
+          expected[c] =
+              (expected[c] * 256 + (color[c] - expected[c]) * a) >> 8;
+      }
+
+      for (c = 0; c < 3; c++) {
+        guint8 val = map.data[c * SOLID_WIDTH * SOLID_HEIGHT +
+            y * SOLID_WIDTH + x];
+
+        fail_unless (val == expected[c],
+            "component %d at %d,%d is %u, expected %d", c, x, y, val,
+            expected[c]);
+      }
+    }
+  }
+
+  gst_buffer_unmap (buf, &map);
+}
+
+/* check that skipping the occluded layers and blending in bands gives the
+ * pixels of blending every layer in order, serially and on multiple
+ * threads */
+GST_START_TEST (test_n_threads_solid)
+{
+  guint n_threads[] = { 1, 4 };
+  GList *buffers, *l;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (n_threads); i++) {
+    buffers = mix_solid_inputs (n_threads[i]);
+    fail_unless_equals_int (g_list_length (buffers), 3);
+
+    for (l = buffers; l; l = l->next)
+      check_solid_frame (l->data);
+
+    g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 videomixer_suite (void)
 {
@@ -1041,6 +1268,8 @@ videomixer_suite (void)
   tcase_add_test (tc_chain, test_duration_unknown_overrides);
   tcase_add_test (tc_chain, test_loop);
   tcase_add_test (tc_chain, test_flush_start_flush_stop);
+  tcase_add_test (tc_chain, test_n_threads);
+  tcase_add_test (tc_chain, test_n_threads_solid);
 
   /* Use a longer timeout */
 #ifdef HAVE_VALGRIND
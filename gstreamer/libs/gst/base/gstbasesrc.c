@@ -102,6 +102,15 @@
  * into the current running_time. The base source will then wait for the
  * calculated running_time before pushing out the buffer.
  *
+ * Sources that produce many small buffers per wakeup, such as network
+ * sources, can implement the #GstBaseSrcClass.create_list() or
+ * #GstBaseSrcClass.fill_list() methods instead. When operating in push mode,
+ * the base class will then push a #GstBufferList downstream with
+ * gst_pad_push_list() instead of one buffer per iteration. Synchronisation,
+ * timestamping and segment tracking are still performed for every buffer in
+ * the list. Pull mode and reverse playback always use
+ * #GstBaseSrcClass.create().
+ *
  * For live sources, the base class will by default report a latency of 0.
  * For pseudo live sources, the base class will by default measure the difference
  * between the first buffer timestamp and the start time of get_times and will
@@ -200,6 +209,7 @@ enum
 #define DEFAULT_NUM_BUFFERS     -1
 #define DEFAULT_TYPEFIND        FALSE
 #define DEFAULT_DO_TIMESTAMP    FALSE
+#define DEFAULT_BUFFER_LIST_LENGTH 16
 
 enum
 {
@@ -241,6 +251,11 @@ struct _GstBaseSrcPrivate
   gboolean do_timestamp;
   volatile gint dynamic_size;
 
+  /* if the subclass produces buffer lists in push mode */
+  gboolean use_buffer_list;
+  /* number of buffers allocated for the default create_list */
+  guint buffer_list_length;
+
   /* stream sequence number */
   guint32 seqnum;
 
@@ -324,6 +339,8 @@ static gboolean gst_base_src_default_prepare_seek_segment (GstBaseSrc * src,
     GstEvent * event, GstSegment * segment);
 static GstFlowReturn gst_base_src_default_create (GstBaseSrc * basesrc,
     guint64 offset, guint size, GstBuffer ** buf);
+static GstFlowReturn gst_base_src_default_create_list (GstBaseSrc * basesrc,
+    guint64 offset, guint size, GstBufferList ** list);
 static GstFlowReturn gst_base_src_default_alloc (GstBaseSrc * basesrc,
     guint64 offset, guint size, GstBuffer ** buf);
 static gboolean gst_base_src_decide_allocation_default (GstBaseSrc * basesrc,
@@ -415,6 +432,7 @@ gst_base_src_init (GstBaseSrc * basesrc, gpointer g_class)
 {
   GstPad *pad;
   GstPadTemplate *pad_template;
+  GstBaseSrcClass *bclass = GST_BASE_SRC_CLASS (g_class);
 
   basesrc->priv = GST_BASE_SRC_GET_PRIVATE (basesrc);
 
@@ -452,6 +470,12 @@ gst_base_src_init (GstBaseSrc * basesrc, gpointer g_class)
   basesrc->priv->do_timestamp = DEFAULT_DO_TIMESTAMP;
   g_atomic_int_set (&basesrc->priv->have_events, FALSE);
 
+  /* subclasses that implement one of the list functions produce buffer lists
+   * when operating in push mode */
+  basesrc->priv->use_buffer_list = (bclass->create_list != NULL
+      || bclass->fill_list != NULL);
+  basesrc->priv->buffer_list_length = DEFAULT_BUFFER_LIST_LENGTH;
+
   g_cond_init (&basesrc->priv->async_cond);
   basesrc->priv->start_result = GST_FLOW_FLUSHING;
   GST_OBJECT_FLAG_UNSET (basesrc, GST_BASE_SRC_FLAG_STARTED);
@@ -744,6 +768,52 @@ gst_base_src_get_blocksize (GstBaseSrc * src)
   return res;
 }
 
+/**
+ * gst_base_src_set_buffer_list_length:
+ * @src: the source
+ * @length: the number of buffers to allocate
+ *
+ * Set the number of buffers that the default #GstBaseSrcClass.create_list()
+ * implementation allocates before calling #GstBaseSrcClass.fill_list(). This
+ * is the maximum number of buffers @src will push out with each buffer list.
+ *
+ * Since: 1.2
+ */
+void
+gst_base_src_set_buffer_list_length (GstBaseSrc * src, guint length)
+{
+  g_return_if_fail (GST_IS_BASE_SRC (src));
+  g_return_if_fail (length > 0);
+
+  GST_OBJECT_LOCK (src);
+  src->priv->buffer_list_length = length;
+  GST_OBJECT_UNLOCK (src);
+}
+
+/**
+ * gst_base_src_get_buffer_list_length:
+ * @src: the source
+ *
+ * Get the number of buffers that the default #GstBaseSrcClass.create_list()
+ * implementation allocates before calling #GstBaseSrcClass.fill_list().
+ *
+ * Returns: the number of buffers allocated for each buffer list.
+ *
+ * Since: 1.2
+ */
+guint
+gst_base_src_get_buffer_list_length (GstBaseSrc * src)
+{
+  guint res;
+
+  g_return_val_if_fail (GST_IS_BASE_SRC (src), 0);
+
+  GST_OBJECT_LOCK (src);
+  res = src->priv->buffer_list_length;
+  GST_OBJECT_UNLOCK (src);
+
+  return res;
+}
 
 /**
  * gst_base_src_set_do_timestamp:
@@ -1461,6 +1531,75 @@ not_ok:
   }
 }
 
+static GstFlowReturn
+gst_base_src_default_create_list (GstBaseSrc * src, guint64 offset,
+    guint size, GstBufferList ** list)
+{
+  GstBaseSrcClass *bclass;
+  GstFlowReturn ret;
+  GstBufferList *res_list;
+  GstBuffer *buf;
+  guint64 buf_offset;
+  gboolean bytes;
+  guint i, length;
+
+  bclass = GST_BASE_SRC_GET_CLASS (src);
+
+  if (G_UNLIKELY (!bclass->alloc))
+    goto no_function;
+  if (G_UNLIKELY (!bclass->fill_list))
+    goto no_function;
+
+  GST_OBJECT_LOCK (src);
+  length = src->priv->buffer_list_length;
+  bytes = (src->segment.format == GST_FORMAT_BYTES);
+  GST_OBJECT_UNLOCK (src);
+
+  /* in BYTES format each buffer continues where the previous one ended */
+  buf_offset = offset;
+  res_list = gst_buffer_list_new_sized (length);
+  for (i = 0; i < length; i++) {
+    ret = bclass->alloc (src, buf_offset, size, &buf);
+    if (G_UNLIKELY (ret != GST_FLOW_OK))
+      goto alloc_failed;
+    if (bytes) {
+      GST_BUFFER_OFFSET (buf) = buf_offset;
+      buf_offset += gst_buffer_get_size (buf);
+      GST_BUFFER_OFFSET_END (buf) = buf_offset;
+    }
+    gst_buffer_list_add (res_list, buf);
+  }
+
+  ret = bclass->fill_list (src, offset, size, res_list);
+  if (G_UNLIKELY (ret != GST_FLOW_OK))
+    goto not_ok;
+
+  *list = res_list;
+
+  return GST_FLOW_OK;
+
+  /* ERRORS */
+no_function:
+  {
+    GST_DEBUG_OBJECT (src, "no fill_list or alloc function");
+    return GST_FLOW_NOT_SUPPORTED;
+  }
+alloc_failed:
+  {
+    GST_DEBUG_OBJECT (src, "Failed to allocate buffer %u of %u bytes", i,
+        size);
+    gst_buffer_list_unref (res_list);
+    return ret;
+  }
+not_ok:
+  {
+    GST_DEBUG_OBJECT (src, "fill_list returned %d (%s)", ret,
+        gst_flow_get_name (ret));
+    gst_buffer_list_unref (res_list);
+    return ret;
+  }
+}
+
 /* this code implements the seeking. It is a good example
  * handling all cases.
  *
@@ -2506,6 +2645,213 @@ eos:
   }
 }
 
+/* make the buffer at @idx in the writable @list writable */
+static GstBuffer *
+gst_base_src_buffer_list_get_writable (GstBufferList * list, guint idx)
+{
+  GstBuffer *buf;
+
+  buf = gst_buffer_list_get (list, idx);
+  if (G_UNLIKELY (!gst_buffer_is_writable (buf))) {
+    buf = gst_buffer_copy (buf);
+    gst_buffer_list_remove (list, idx, 1);
+    gst_buffer_list_insert (list, idx, buf);
+  }
+  return buf;
+}
+
+/* must be called with LIVE_LOCK */
+static GstFlowReturn
+gst_base_src_get_range_list (GstBaseSrc * src, guint64 offset, guint length,
+    GstBufferList ** list)
+{
+  GstFlowReturn ret;
+  GstBaseSrcClass *bclass;
+  GstClockReturn status;
+  GstBufferList *res_list;
+  GstBuffer *buf;
+  guint i, len;
+
+  bclass = GST_BASE_SRC_GET_CLASS (src);
+
+again:
+  if (src->is_live) {
+    if (G_UNLIKELY (!src->live_running)) {
+      ret = gst_base_src_wait_playing (src);
+      if (ret != GST_FLOW_OK)
+        goto stopped;
+    }
+  }
+
+  if (G_UNLIKELY (!GST_BASE_SRC_IS_STARTED (src)
+          && !GST_BASE_SRC_IS_STARTING (src)))
+    goto not_started;
+
+  if (G_UNLIKELY (!gst_base_src_update_length (src, offset, &length, FALSE)))
+    goto unexpected_length;
+
+  /* track position */
+  GST_OBJECT_LOCK (src);
+  if (src->segment.format == GST_FORMAT_BYTES)
+    src->segment.position = offset;
+  GST_OBJECT_UNLOCK (src);
+
+  if (G_UNLIKELY (src->num_buffers_left == 0))
+    goto reached_num_buffers;
+
+  /* don't enter the create function if a pending EOS event was set. For the
+   * logic of the pending_eos, check the event function of this class. */
+  if (G_UNLIKELY (g_atomic_int_get (&src->priv->pending_eos)))
+    goto eos;
+
+  GST_DEBUG_OBJECT (src,
+      "calling create_list offset %" G_GUINT64_FORMAT " length %u, time %"
+      G_GINT64_FORMAT, offset, length, src->segment.time);
+
+  res_list = NULL;
+  if (bclass->create_list)
+    ret = bclass->create_list (src, offset, length, &res_list);
+  else
+    ret = gst_base_src_default_create_list (src, offset, length, &res_list);
+
+  /* The create function could be unlocked because we have a pending EOS. It's
+   * possible that we have a valid list from create that we need to discard
+   * when the create function returned _OK. */
+  if (G_UNLIKELY (g_atomic_int_get (&src->priv->pending_eos))) {
+    if (ret == GST_FLOW_OK && res_list)
+      gst_buffer_list_unref (res_list);
+    goto eos;
+  }
+
+  if (G_UNLIKELY (ret != GST_FLOW_OK))
+    goto not_ok;
+
+  /* fill_list may remove all buffers, e.g. at the end of the data */
+  if (G_UNLIKELY (res_list == NULL || gst_buffer_list_length (res_list) == 0))
+    goto empty_list;
+
+  res_list = gst_buffer_list_make_writable (res_list);
+  len = gst_buffer_list_length (res_list);
+
+  /* normally we don't count buffers, when we do, every buffer in the list
+   * counts and we only keep the ones we still need */
+  if (G_UNLIKELY (src->num_buffers_left >= 0)) {
+    if (len > (guint) src->num_buffers_left) {
+      gst_buffer_list_remove (res_list, src->num_buffers_left,
+          len - src->num_buffers_left);
+      len = src->num_buffers_left;
+    }
+    src->num_buffers_left -= len;
+  }
+
+  /* no timestamp set and we are at offset 0, we can timestamp with 0 */
+  if (offset == 0 && src->segment.time == 0
+      && GST_BUFFER_DTS (gst_buffer_list_get (res_list, 0)) == -1
+      && !src->is_live) {
+    GST_DEBUG_OBJECT (src, "setting first timestamp to 0");
+    buf = gst_base_src_buffer_list_get_writable (res_list, 0);
+    GST_BUFFER_DTS (buf) = 0;
+  }
+
+  /* now sync every buffer before pushing the list */
+  for (i = 0; i < len; i++) {
+    buf = gst_base_src_buffer_list_get_writable (res_list, i);
+
+    status = gst_base_src_do_sync (src, buf);
+
+    /* waiting for the clock could have made us flushing */
+    if (G_UNLIKELY (src->priv->flushing))
+      goto flushing;
+
+    switch (status) {
+      case GST_CLOCK_EARLY:
+        /* the buffer is too late. We currently don't drop the buffer. */
+        GST_DEBUG_OBJECT (src, "buffer %u too late!, returning anyway", i);
+        break;
+      case GST_CLOCK_OK:
+        /* buffer synchronised properly */
+        GST_LOG_OBJECT (src, "buffer %u ok", i);
+        break;
+      case GST_CLOCK_UNSCHEDULED:
+        /* this case is triggered when we were waiting for the clock and
+         * it got unlocked because we did a state change. In any case, get rid
+         * of the list. */
+        gst_buffer_list_unref (res_list);
+
+        if (!src->live_running) {
+          /* We return FLUSHING when we are not running to stop the
+           * dataflow */
+          GST_DEBUG_OBJECT (src,
+              "clock was unscheduled (%d), returning FLUSHING", status);
+          return GST_FLOW_FLUSHING;
+        }
+        /* If we are running when this happens, we quickly switched between
+         * pause and playing. We try to produce a new list */
+        GST_DEBUG_OBJECT (src,
+            "clock was unscheduled (%d), but we are running", status);
+        goto again;
+      default:
+        /* all other result values are unexpected and errors */
+        GST_ELEMENT_ERROR (src, CORE, CLOCK,
+            (_("Internal clock error.")),
+            ("clock returned unexpected return value %d", status));
+        gst_buffer_list_unref (res_list);
+        return GST_FLOW_ERROR;
+    }
+  }
+  *list = res_list;
+
+  return GST_FLOW_OK;
+
+  /* ERROR */
+stopped:
+  {
+    GST_DEBUG_OBJECT (src, "wait_playing returned %d (%s)", ret,
+        gst_flow_get_name (ret));
+    return ret;
+  }
+not_ok:
+  {
+    GST_DEBUG_OBJECT (src, "create_list returned %d (%s)", ret,
+        gst_flow_get_name (ret));
+    return ret;
+  }
+empty_list:
+  {
+    GST_DEBUG_OBJECT (src, "create_list returned an empty list, EOS");
+    if (res_list)
+      gst_buffer_list_unref (res_list);
+    return GST_FLOW_EOS;
+  }
+not_started:
+  {
+    GST_DEBUG_OBJECT (src, "getrange but not started");
+    return GST_FLOW_FLUSHING;
+  }
+unexpected_length:
+  {
+    GST_DEBUG_OBJECT (src, "unexpected length %u (offset=%" G_GUINT64_FORMAT
+        ", size=%" G_GINT64_FORMAT ")", length, offset, src->segment.duration);
+    return GST_FLOW_EOS;
+  }
+reached_num_buffers:
+  {
+    GST_DEBUG_OBJECT (src, "sent all buffers");
+    return GST_FLOW_EOS;
+  }
+flushing:
+  {
+    GST_DEBUG_OBJECT (src, "we are flushing");
+    gst_buffer_list_unref (res_list);
+    return GST_FLOW_FLUSHING;
+  }
+eos:
+  {
+    GST_DEBUG_OBJECT (src, "we are EOS");
+    return GST_FLOW_EOS;
+  }
+}
+
 static GstFlowReturn
 gst_base_src_getrange (GstPad * pad, GstObject * parent, guint64 offset,
     guint length, GstBuffer ** buf)
@@ -2558,11 +2904,90 @@ start_failed:
   }
 }
 
+/* figure out the new position after pushing @buf and update the segment.
+ * Returns %TRUE when the end of the segment was reached.
+ * must be called with LIVE_LOCK */
+static gboolean
+gst_base_src_update_position (GstBaseSrc * src, GstBuffer * buf,
+    gint64 * position)
+{
+  gboolean eos = FALSE;
+
+  switch (src->segment.format) {
+    case GST_FORMAT_BYTES:
+    {
+      guint bufsize = gst_buffer_get_size (buf);
+
+      /* the loop function subtracted the blocksize for negative rates */
+      if (src->segment.rate >= 0.0)
+        *position += bufsize;
+      break;
+    }
+    case GST_FORMAT_TIME:
+    {
+      GstClockTime start, duration;
+
+      start = GST_BUFFER_TIMESTAMP (buf);
+      duration = GST_BUFFER_DURATION (buf);
+
+      if (GST_CLOCK_TIME_IS_VALID (start))
+        *position = start;
+      else
+        *position = src->segment.position;
+
+      if (GST_CLOCK_TIME_IS_VALID (duration)) {
+        if (src->segment.rate >= 0.0)
+          *position += duration;
+        else if (*position > duration)
+          *position -= duration;
+        else
+          *position = 0;
+      }
+      break;
+    }
+    case GST_FORMAT_DEFAULT:
+      if (src->segment.rate >= 0.0)
+        *position = GST_BUFFER_OFFSET_END (buf);
+      else
+        *position = GST_BUFFER_OFFSET (buf);
+      break;
+    default:
+      *position = -1;
+      break;
+  }
+  if (*position != -1) {
+    if (src->segment.rate >= 0.0) {
+      /* positive rate, check if we reached the stop */
+      if (src->segment.stop != -1) {
+        if (*position >= src->segment.stop) {
+          eos = TRUE;
+          *position = src->segment.stop;
+        }
+      }
+    } else {
+      /* negative rate, check if we reached the start. start is always set to
+       * something different from -1 */
+      if (*position <= src->segment.start) {
+        eos = TRUE;
+        *position = src->segment.start;
+      }
+      /* when going reverse, all buffers are DISCONT */
+      src->priv->discont = TRUE;
+    }
+    GST_OBJECT_LOCK (src);
+    src->segment.position = *position;
+    GST_OBJECT_UNLOCK (src);
+  }
+
+  return eos;
+}
+
 static void
 gst_base_src_loop (GstPad * pad)
 {
   GstBaseSrc *src;
   GstBuffer *buf = NULL;
+  GstBufferList *list = NULL;
   GstFlowReturn ret;
   gint64 position;
   gboolean eos;
@@ -2613,16 +3038,31 @@ gst_base_src_loop (GstPad * pad)
   GST_LOG_OBJECT (src, "next_ts %" GST_TIME_FORMAT " size %u",
       GST_TIME_ARGS (position), blocksize);
 
-  ret = gst_base_src_get_range (src, position, blocksize, &buf);
-  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
-    GST_INFO_OBJECT (src, "pausing after gst_base_src_get_range() = %s",
-        gst_flow_get_name (ret));
-    GST_LIVE_UNLOCK (src);
-    goto pause;
+  /* buffer lists are only produced when going forward, reverse playback
+   * produces one buffer at a time */
+  if (src->priv->use_buffer_list && src->segment.rate >= 0.0) {
+    ret = gst_base_src_get_range_list (src, position, blocksize, &list);
+    if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+      GST_INFO_OBJECT (src, "pausing after gst_base_src_get_range_list() = %s",
+          gst_flow_get_name (ret));
+      GST_LIVE_UNLOCK (src);
+      goto pause;
+    }
+    /* this should not happen */
+    if (G_UNLIKELY (list == NULL))
+      goto null_buffer;
+  } else {
+    ret = gst_base_src_get_range (src, position, blocksize, &buf);
+    if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+      GST_INFO_OBJECT (src, "pausing after gst_base_src_get_range() = %s",
+          gst_flow_get_name (ret));
+      GST_LIVE_UNLOCK (src);
+      goto pause;
+    }
+    /* this should not happen */
+    if (G_UNLIKELY (buf == NULL))
+      goto null_buffer;
   }
-  /* this should not happen */
-  if (G_UNLIKELY (buf == NULL))
-    goto null_buffer;
 
   /* push events to close/start our segment before we push the buffer. */
   if (G_UNLIKELY (src->priv->segment_pending)) {
@@ -2649,86 +3089,59 @@ gst_base_src_loop (GstPad * pad)
   }
 
   /* figure out the new position */
-  switch (src->segment.format) {
-    case GST_FORMAT_BYTES:
-    {
-      guint bufsize = gst_buffer_get_size (buf);
-
-      /* we subtracted above for negative rates */
-      if (src->segment.rate >= 0.0)
-        position += bufsize;
-      break;
-    }
-    case GST_FORMAT_TIME:
-    {
-      GstClockTime start, duration;
-
-      start = GST_BUFFER_TIMESTAMP (buf);
-      duration = GST_BUFFER_DURATION (buf);
-
-      if (GST_CLOCK_TIME_IS_VALID (start))
-        position = start;
-      else
-        position = src->segment.position;
-
-      if (GST_CLOCK_TIME_IS_VALID (duration)) {
-        if (src->segment.rate >= 0.0)
-          position += duration;
-        else if (position > duration)
-          position -= duration;
-        else
-          position = 0;
-      }
-      break;
-    }
-    case GST_FORMAT_DEFAULT:
-      if (src->segment.rate >= 0.0)
-        position = GST_BUFFER_OFFSET_END (buf);
-      else
-        position = GST_BUFFER_OFFSET (buf);
-      break;
-    default:
-      position = -1;
-      break;
-  }
-  if (position != -1) {
-    if (src->segment.rate >= 0.0) {
-      /* positive rate, check if we reached the stop */
-      if (src->segment.stop != -1) {
-        if (position >= src->segment.stop) {
-          eos = TRUE;
-          position = src->segment.stop;
+  if (list) {
+    guint i, len;
+    gint64 start;
+
+    len = gst_buffer_list_length (list);
+    for (i = 0; i < len; i++) {
+      start = position;
+      eos = gst_base_src_update_position (src, gst_buffer_list_get (list, i),
+          &position);
+      if (G_UNLIKELY (eos)) {
+        GstBuffer *last = gst_buffer_list_get (list, i);
+
+        /* drop the buffers after the end of the segment */
+        if (i + 1 < len)
+          gst_buffer_list_remove (list, i + 1, len - i - 1);
+        /* only the length of the first buffer was limited to the segment
+         * stop, clip the buffer that crosses it the same way */
+        if (src->segment.format == GST_FORMAT_BYTES
+            && start + gst_buffer_get_size (last) > src->segment.stop) {
+          GST_DEBUG_OBJECT (src, "clipping buffer %u to segment stop %"
+              G_GINT64_FORMAT, i, src->segment.stop);
+          last = gst_base_src_buffer_list_get_writable (list, i);
+          gst_buffer_resize (last, 0, src->segment.stop - start);
+          if (GST_BUFFER_OFFSET_END_IS_VALID (last))
+            GST_BUFFER_OFFSET_END (last) = src->segment.stop;
         }
+        break;
       }
-    } else {
-      /* negative rate, check if we reached the start. start is always set to
-       * something different from -1 */
-      if (position <= src->segment.start) {
-        eos = TRUE;
-        position = src->segment.start;
-      }
-      /* when going reverse, all buffers are DISCONT */
-      src->priv->discont = TRUE;
     }
-    GST_OBJECT_LOCK (src);
-    src->segment.position = position;
-    GST_OBJECT_UNLOCK (src);
+  } else {
+    eos = gst_base_src_update_position (src, buf, &position);
   }
 
   if (G_UNLIKELY (src->priv->discont)) {
     GST_INFO_OBJECT (src, "marking pending DISCONT");
-    buf = gst_buffer_make_writable (buf);
+    if (list)
+      buf = gst_base_src_buffer_list_get_writable (list, 0);
+    else
+      buf = gst_buffer_make_writable (buf);
     GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_DISCONT);
     src->priv->discont = FALSE;
   }
   GST_LIVE_UNLOCK (src);
 
-  ret = gst_pad_push (pad, buf);
+  if (list)
+    ret = gst_pad_push_list (pad, list);
+  else
+    ret = gst_pad_push (pad, buf);
   if (G_UNLIKELY (ret != GST_FLOW_OK)) {
     if (ret == GST_FLOW_NOT_NEGOTIATED) {
       goto not_negotiated;
     }
-    GST_INFO_OBJECT (src, "pausing after gst_pad_push() = %s",
+    GST_INFO_OBJECT (src, "pausing after pushing data = %s",
         gst_flow_get_name (ret));
     goto pause;
   }
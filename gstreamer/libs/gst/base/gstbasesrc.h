@@ -155,6 +155,19 @@ struct _GstBaseSrc {
  *   default implementation will create a new buffer from the negotiated allocator.
  * @fill: Ask the subclass to fill the buffer with data for offset and size. The
  *   passed buffer is guaranteed to hold the requested amount of bytes.
+ * @create_list: Ask the subclass to create a list of buffers starting at
+ *   offset, with at most size bytes per buffer. When implemented, the base
+ *   class will call this function instead of @create when operating in push
+ *   mode and push the result downstream with gst_pad_push_list(). An empty
+ *   list on GST_FLOW_OK is handled as end-of-stream. Synchronisation,
+ *   timestamping and segment tracking are performed for every buffer in the
+ *   list. Since 1.2
+ * @fill_list: Ask the subclass to fill the buffers in the list with data
+ *   starting from offset, with size bytes per buffer. The default @create_list
+ *   implementation allocates gst_base_src_get_buffer_list_length() buffers
+ *   with @alloc and then calls this function. The subclass should remove the
+ *   buffers it did not fill from the tail of the list, removing all of them
+ *   means end-of-stream. Since 1.2
  *
  * Subclasses can override any of the available virtual methods or not, as
  * needed. At the minimum, the @create method should be overridden to produce
@@ -224,8 +237,16 @@ struct _GstBaseSrcClass {
   GstFlowReturn (*fill)         (GstBaseSrc *src, guint64 offset, guint size,
                                  GstBuffer *buf);
 
+  /* ask the subclass to create a list of buffers, used instead of create
+   * when operating in push mode */
+  GstFlowReturn (*create_list)  (GstBaseSrc *src, guint64 offset, guint size,
+                                 GstBufferList **list);
+  /* ask the subclass to fill a list of allocated buffers */
+  GstFlowReturn (*fill_list)    (GstBaseSrc *src, guint64 offset, guint size,
+                                 GstBufferList *list);
+
   /*< private >*/
-  gpointer       _gst_reserved[GST_PADDING_LARGE];
+  gpointer       _gst_reserved[GST_PADDING_LARGE - 2];
 };
 
 GType gst_base_src_get_type (void);
@@ -252,6 +273,9 @@ gboolean        gst_base_src_query_latency    (GstBaseSrc *src, gboolean * live,
 void            gst_base_src_set_blocksize    (GstBaseSrc *src, guint blocksize);
 guint           gst_base_src_get_blocksize    (GstBaseSrc *src);
 
+void            gst_base_src_set_buffer_list_length (GstBaseSrc *src, guint length);
+guint           gst_base_src_get_buffer_list_length (GstBaseSrc *src);
+
 void            gst_base_src_set_do_timestamp (GstBaseSrc *src, gboolean timestamp);
 gboolean        gst_base_src_get_do_timestamp (GstBaseSrc *src);
 
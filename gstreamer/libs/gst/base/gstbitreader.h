@@ -118,6 +118,13 @@ gst_bit_reader_peek_bits_uint##bits##_unchecked (const GstBitReader *reader, gui
   byte = reader->byte; \
   bit = reader->bit; \
   \
+  /* fast path: all bits are in the next 8 bytes, load them at once */ \
+  if (G_LIKELY (nbits > 0 && bit + nbits <= 64 && byte + 8 <= reader->size)) { \
+    guint64 word = GST_READ_UINT64_BE (data + byte); \
+    \
+    return (guint##bits) ((word << bit) >> (64 - nbits)); \
+  } \
+  \
   while (nbits > 0) { \
     guint toread = MIN (nbits, 8 - bit); \
     \
@@ -28,6 +28,11 @@
 
 #include <string.h>
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
 /**
  * SECTION:gstbytereader
  * @short_description: Reads different integer, string and floating point
@@ -813,23 +818,96 @@ gst_byte_reader_dup_data (GstByteReader * reader, guint size, guint8 ** val)
  * // -> returns -1
  * </programlisting>
  */
-guint
-gst_byte_reader_masked_scan_uint32 (const GstByteReader * reader, guint32 mask,
-    guint32 pattern, guint offset, guint size)
+#define SCAN_BYTE(val,i) (((val) >> (24 - 8 * (i))) & 0xff)
+#define SCAN_MATCHES(data,mask,pattern) \
+    ((GST_READ_UINT32_BE (data) & (mask)) == (pattern))
+
+/* get the index of a byte in the pattern that is completely covered by the
+ * mask, other than @skip, or -1 when there is no such byte. Zero bytes are
+ * very common in bitstreams so we prefer any other value. */
+static gint
+scan_pick_key (guint32 mask, guint32 pattern, gint skip)
 {
-  const guint8 *data;
-  guint32 state;
-  guint i;
+  gint i, key = -1;
+
+  for (i = 0; i < 4; i++) {
+    if (i == skip || SCAN_BYTE (mask, i) != 0xff)
+      continue;
+    if (key == -1 || (SCAN_BYTE (pattern, key) == 0
+            && SCAN_BYTE (pattern, i) != 0))
+      key = i;
+  }
+  return key;
+}
 
-  g_return_val_if_fail (size > 0, -1);
-  g_return_val_if_fail ((guint64) offset + size <= reader->size - reader->byte,
-      -1);
+#ifdef HAVE_SCAN_SSE2
+/* compare 16 windows at a time against the two key bytes and only check
+ * the complete pattern where both of them match. Returns the first
+ * match or -1 and the first window that was not checked yet in @next. */
+static guint
+scan_key_bytes_sse2 (const guint8 * data, guint size, guint32 mask,
+    guint32 pattern, gint k1, gint k2, guint * next)
+{
+  __m128i v1, v2;
+  guint i, bits;
 
-  /* we can't find the pattern with less than 4 bytes */
-  if (G_UNLIKELY (size < 4))
-    return -1;
+  v1 = _mm_set1_epi8 ((gchar) SCAN_BYTE (pattern, k1));
+  v2 = _mm_set1_epi8 ((gchar) SCAN_BYTE (pattern, k2));
 
-  data = reader->data + reader->byte + offset;
+  /* the last window starts at size - 4 */
+  for (i = 0; i + 16 + 3 <= size; i += 16) {
+    __m128i a, b;
+
+    a = _mm_loadu_si128 ((const __m128i *) (data + i + k1));
+    b = _mm_loadu_si128 ((const __m128i *) (data + i + k2));
+    bits = _mm_movemask_epi8 (_mm_and_si128 (_mm_cmpeq_epi8 (a, v1),
+            _mm_cmpeq_epi8 (b, v2)));
+
+    while (G_UNLIKELY (bits)) {
+      guint j = g_bit_nth_lsf (bits, -1);
+
+      if (SCAN_MATCHES (data + i + j, mask, pattern))
+        return i + j;
+      bits &= bits - 1;
+    }
+  }
+  *next = i;
+
+  return -1;
+}
+#else
+/* let memchr() skip to the windows where the key byte matches and only
+ * check the complete pattern there. Returns the first match or -1. */
+static guint
+scan_key_byte_memchr (const guint8 * data, guint size, guint32 mask,
+    guint32 pattern, gint k1)
+{
+  const guint8 *hit;
+  guint i, last;
+  guint8 key;
+
+  key = SCAN_BYTE (pattern, k1);
+  last = size - 4;
+
+  for (i = 0; i <= last; i++) {
+    hit = memchr (data + i + k1, key, last - i + 1);
+    if (hit == NULL)
+      break;
+
+    i = hit - data - k1;
+    if (SCAN_MATCHES (data + i, mask, pattern))
+      return i;
+  }
+  return -1;
+}
+#endif
+
+static guint
+scan_masked_uint32_c (const guint8 * data, guint size, guint32 mask,
+    guint32 pattern)
+{
+  guint32 state;
+  guint i;
 
   /* set the state to something that does not match */
   state = ~pattern;
@@ -842,7 +920,7 @@ gst_byte_reader_masked_scan_uint32 (const GstByteReader * reader, guint32 mask,
       /* we have a match but we need to have skipped at
        * least 4 bytes to fill the state. */
       if (G_LIKELY (i >= 3))
-        return offset + i - 3;
+        return i - 3;
     }
   }
 
@@ -850,6 +928,55 @@ gst_byte_reader_masked_scan_uint32 (const GstByteReader * reader, guint32 mask,
   return -1;
 }
 
+guint
+gst_byte_reader_masked_scan_uint32 (const GstByteReader * reader, guint32 mask,
+    guint32 pattern, guint offset, guint size)
+{
+  const guint8 *data;
+  guint res;
+  gint k1;
+
+  g_return_val_if_fail (size > 0, -1);
+  g_return_val_if_fail ((guint64) offset + size <= reader->size - reader->byte,
+      -1);
+
+  /* we can't find the pattern with less than 4 bytes */
+  if (G_UNLIKELY (size < 4))
+    return -1;
+
+  data = reader->data + reader->byte + offset;
+
+  /* the fast paths need at least one byte that is completely covered by the
+   * mask to search for, like the 0x01 of the 00 00 01 start codes */
+  k1 = scan_pick_key (mask, pattern, -1);
+  if (k1 == -1) {
+    res = scan_masked_uint32_c (data, size, mask, pattern);
+  } else {
+#ifdef HAVE_SCAN_SSE2
+    guint next = 0;
+    gint k2;
+
+    k2 = scan_pick_key (mask, pattern, k1);
+    if (k2 == -1)
+      k2 = k1;
+
+    res = scan_key_bytes_sse2 (data, size, mask, pattern, k1, k2, &next);
+    /* check the remaining windows one by one */
+    for (; res == -1 && next + 4 <= size; next++) {
+      if (SCAN_MATCHES (data + next, mask, pattern))
+        res = next;
+    }
+#else
+    res = scan_key_byte_memchr (data, size, mask, pattern, k1);
+#endif
+  }
+
+  if (res == -1)
+    return -1;
+
+  return offset + res;
+}
+
 #define GST_BYTE_READER_SCAN_STRING(bits) \
 static guint \
 gst_byte_reader_scan_string_utf##bits (const GstByteReader * reader) \
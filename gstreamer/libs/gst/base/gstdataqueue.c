@@ -26,6 +26,14 @@
  * #GstDataQueue is an object that handles threadsafe queueing of objects. It
  * also provides size-related functionality. This object should be used for
  * any #GstElement that wishes to provide some sort of queueing functionality.
+ *
+ * When it is known that only one thread pushes items and only one other thread
+ * pops them, the queue can be created with gst_data_queue_new_full() and the
+ * #GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER flag. Items are then passed
+ * between the threads without taking a lock and a waiting thread first spins
+ * for a short while before it goes to sleep. In this mode gst_data_queue_flush()
+ * must be called from the consumer side, i.e. while no other thread pops
+ * items, and gst_data_queue_drop_head() is not available.
  */
 
 #include <gst/gst.h>
@@ -56,6 +64,31 @@ enum
       /* FILL ME */
 };
 
+/* number of items in a block of the single producer/consumer queue */
+#define SPSC_BLOCK_SIZE 64
+
+/* limits for the adaptive spinning before waiting on the condition */
+#define SPSC_MIN_SPINS 16
+#define SPSC_MAX_SPINS 4096
+
+typedef struct _GstDataQueueBlock GstDataQueueBlock;
+
+struct _GstDataQueueBlock
+{
+  GstDataQueueItem *items[SPSC_BLOCK_SIZE];
+  GstDataQueueBlock *next;
+};
+
+/* the total size of the items that went through one side of the queue,
+ * written by one thread and read by any thread with the sequence count */
+typedef struct
+{
+  volatile gint seq;
+  volatile gint visible;
+  volatile gint bytes;
+  guint64 time;
+} GstDataQueueCounter;
+
 struct _GstDataQueuePrivate
 {
   /* the array of data we're keeping our grubby hands on */
@@ -74,6 +107,25 @@ struct _GstDataQueuePrivate
                                  * of external flushing */
   GstDataQueueFullCallback fullcallback;
   GstDataQueueEmptyCallback emptycallback;
+
+  /* single producer/consumer mode. The producer owns the tail and the
+   * pushed counter, the consumer owns the head and the popped counter.
+   * waiting_add and waiting_del are then only modified atomically. */
+  gboolean spsc;
+  volatile gint n_items;
+
+  GstDataQueueBlock *tail;
+  guint tail_idx;
+  GstDataQueueCounter pushed;
+  guint push_spins;
+
+  GstDataQueueBlock *head;
+  guint head_idx;
+  GstDataQueueCounter popped;
+  guint pop_spins;
+
+  /* freed by the consumer, reused by the producer */
+  volatile gpointer spare;
 };
 
 #define GST_DATA_QUEUE_MUTEX_LOCK(q) G_STMT_START {                     \
@@ -242,11 +294,305 @@ gst_data_queue_new (GstDataQueueCheckFullFunction checkfull,
   return ret;
 }
 
+/**
+ * gst_data_queue_new_full:
+ * @checkfull: the callback used to tell if the element considers the queue full
+ * or not.
+ * @fullcallback: the callback which will be called when the queue is considered full.
+ * @emptycallback: the callback which will be called when the queue is considered empty.
+ * @checkdata: a #gpointer that will be given in the @checkfull callback.
+ * @flags: #GstDataQueueFlags for the new queue
+ *
+ * Creates a new #GstDataQueue like gst_data_queue_new() with the extra
+ * behaviour configured in @flags.
+ *
+ * With #GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER, the caller guarantees
+ * that gst_data_queue_push() is never called from two threads at the same
+ * time and that the same holds for gst_data_queue_pop(),
+ * gst_data_queue_peek() and gst_data_queue_flush().
+ *
+ * Returns: a new #GstDataQueue.
+ *
+ * Since: 1.2
+ */
+GstDataQueue *
+gst_data_queue_new_full (GstDataQueueCheckFullFunction checkfull,
+    GstDataQueueFullCallback fullcallback,
+    GstDataQueueEmptyCallback emptycallback, gpointer checkdata,
+    GstDataQueueFlags flags)
+{
+  GstDataQueue *ret;
+  GstDataQueuePrivate *priv;
+
+  ret = gst_data_queue_new (checkfull, fullcallback, emptycallback, checkdata);
+  if (ret == NULL)
+    return NULL;
+
+  priv = ret->priv;
+  if (flags & GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER) {
+    priv->spsc = TRUE;
+    priv->head = priv->tail = g_slice_new0 (GstDataQueueBlock);
+    priv->push_spins = priv->pop_spins = SPSC_MIN_SPINS;
+  }
+
+  return ret;
+}
+
+static void
+gst_data_queue_counter_add (GstDataQueueCounter * counter,
+    GstDataQueueItem * item)
+{
+  /* odd while updating */
+  g_atomic_int_inc (&counter->seq);
+  if (item->visible)
+    g_atomic_int_inc (&counter->visible);
+  g_atomic_int_add (&counter->bytes, item->size);
+  counter->time += item->duration;
+  g_atomic_int_inc (&counter->seq);
+}
+
+static void
+gst_data_queue_counter_get (GstDataQueueCounter * counter,
+    GstDataQueueSize * size)
+{
+  gint seq;
+
+  /* every atomic operation is a barrier, the fields are read in between
+   * two reads of the sequence count */
+  do {
+    seq = g_atomic_int_get (&counter->seq);
+    size->visible = g_atomic_int_get (&counter->visible);
+    size->bytes = g_atomic_int_get (&counter->bytes);
+    size->time = counter->time;
+  } while ((seq & 1) || g_atomic_int_get (&counter->seq) != seq);
+}
+
+static void
+gst_data_queue_spsc_get_level (GstDataQueue * queue, GstDataQueueSize * level)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+  GstDataQueueSize popped, pushed;
+
+  /* popped first so that we never see more popped than pushed items */
+  gst_data_queue_counter_get (&priv->popped, &popped);
+  gst_data_queue_counter_get (&priv->pushed, &pushed);
+
+  level->visible = pushed.visible - popped.visible;
+  level->bytes = pushed.bytes - popped.bytes;
+  level->time = pushed.time - popped.time;
+}
+
+static inline gboolean
+gst_data_queue_spsc_is_empty (GstDataQueue * queue)
+{
+  return g_atomic_int_get (&queue->priv->n_items) == 0;
+}
+
+static gboolean
+gst_data_queue_spsc_is_full (GstDataQueue * queue)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+  GstDataQueueSize level;
+
+  gst_data_queue_spsc_get_level (queue, &level);
+
+  return priv->checkfull (queue, level.visible, level.bytes, level.time,
+      priv->checkdata);
+}
+
+/* Wait until there is space in the queue or until there is an item, the
+ * other thread usually makes progress very soon so we first spin for a
+ * while. The amount of spinning adapts to how often that was enough before
+ * we park the thread on the condition. Returns FALSE when flushing. */
+static gboolean
+gst_data_queue_spsc_wait (GstDataQueue * queue, gboolean for_space)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+  guint i, *spins;
+  gboolean res;
+
+  spins = for_space ? &priv->push_spins : &priv->pop_spins;
+
+  for (i = 0; i < *spins; i++) {
+    if (g_atomic_int_get (&priv->flushing))
+      return FALSE;
+    if (for_space ? !gst_data_queue_spsc_is_full (queue) :
+        !gst_data_queue_spsc_is_empty (queue)) {
+      *spins = MIN (*spins * 2, SPSC_MAX_SPINS);
+      return TRUE;
+    }
+  }
+  *spins = MAX (*spins / 2, SPSC_MIN_SPINS);
+
+  /* announce that we are waiting before checking again, the other side
+   * checks the flag after it changed the queue. Both are full barriers. */
+  GST_DATA_QUEUE_MUTEX_LOCK (queue);
+  if (for_space) {
+    g_atomic_int_inc (&priv->waiting_del);
+    while (!priv->flushing && gst_data_queue_spsc_is_full (queue))
+      g_cond_wait (&priv->item_del, &priv->qlock);
+    g_atomic_int_add (&priv->waiting_del, -1);
+  } else {
+    g_atomic_int_inc (&priv->waiting_add);
+    while (!priv->flushing && gst_data_queue_spsc_is_empty (queue))
+      g_cond_wait (&priv->item_add, &priv->qlock);
+    g_atomic_int_add (&priv->waiting_add, -1);
+  }
+  res = !priv->flushing;
+  GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
+
+  return res;
+}
+
+/* called by the producer */
+static void
+gst_data_queue_spsc_push_tail (GstDataQueue * queue, GstDataQueueItem * item)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+
+  if (priv->tail_idx == SPSC_BLOCK_SIZE) {
+    GstDataQueueBlock *block;
+
+    block = g_atomic_pointer_get (&priv->spare);
+    if (block == NULL
+        || !g_atomic_pointer_compare_and_exchange (&priv->spare, block, NULL))
+      block = g_slice_new (GstDataQueueBlock);
+    block->next = NULL;
+
+    priv->tail->next = block;
+    priv->tail = block;
+    priv->tail_idx = 0;
+  }
+  priv->tail->items[priv->tail_idx++] = item;
+  gst_data_queue_counter_add (&priv->pushed, item);
+
+  /* make the item available to the consumer */
+  g_atomic_int_inc (&priv->n_items);
+
+  if (g_atomic_int_get (&priv->waiting_add)) {
+    GST_DATA_QUEUE_MUTEX_LOCK (queue);
+    g_cond_signal (&priv->item_add);
+    GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
+  }
+}
+
+/* called by the consumer when the queue is not empty */
+static GstDataQueueItem *
+gst_data_queue_spsc_get_head (GstDataQueue * queue, gboolean remove)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+  GstDataQueueItem *item;
+
+  if (priv->head_idx == SPSC_BLOCK_SIZE) {
+    GstDataQueueBlock *block = priv->head;
+
+    /* the producer is done with this block when it stored items in the
+     * next one */
+    priv->head = block->next;
+    priv->head_idx = 0;
+
+    if (!g_atomic_pointer_compare_and_exchange (&priv->spare, NULL, block))
+      g_slice_free (GstDataQueueBlock, block);
+  }
+  item = priv->head->items[priv->head_idx];
+
+  if (remove) {
+    priv->head_idx++;
+    gst_data_queue_counter_add (&priv->popped, item);
+    g_atomic_int_add (&priv->n_items, -1);
+
+    if (g_atomic_int_get (&priv->waiting_del)) {
+      GST_DATA_QUEUE_MUTEX_LOCK (queue);
+      g_cond_signal (&priv->item_del);
+      GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
+    }
+  }
+  return item;
+}
+
+static void
+gst_data_queue_spsc_cleanup (GstDataQueue * queue)
+{
+  while (!gst_data_queue_spsc_is_empty (queue)) {
+    GstDataQueueItem *item = gst_data_queue_spsc_get_head (queue, TRUE);
+
+    /* Just call the destroy notify on the item */
+    item->destroy (item);
+  }
+}
+
+static gboolean
+gst_data_queue_spsc_push (GstDataQueue * queue, GstDataQueueItem * item)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+
+  if (g_atomic_int_get (&priv->flushing))
+    goto flushing;
+
+  /* We ALWAYS need to check for queue fillness */
+  if (gst_data_queue_spsc_is_full (queue)) {
+    if (G_LIKELY (priv->fullcallback))
+      priv->fullcallback (queue, priv->checkdata);
+    else
+      g_signal_emit (queue, gst_data_queue_signals[SIGNAL_FULL], 0);
+
+    if (!gst_data_queue_spsc_wait (queue, TRUE))
+      goto flushing;
+  }
+
+  gst_data_queue_spsc_push_tail (queue, item);
+
+  return TRUE;
+
+  /* ERRORS */
+flushing:
+  {
+    GST_DEBUG ("queue:%p, we are flushing", queue);
+    return FALSE;
+  }
+}
+
+static gboolean
+gst_data_queue_spsc_pop (GstDataQueue * queue, GstDataQueueItem ** item,
+    gboolean remove)
+{
+  GstDataQueuePrivate *priv = queue->priv;
+
+  if (g_atomic_int_get (&priv->flushing))
+    goto flushing;
+
+  if (gst_data_queue_spsc_is_empty (queue)) {
+    if (G_LIKELY (priv->emptycallback))
+      priv->emptycallback (queue, priv->checkdata);
+    else
+      g_signal_emit (queue, gst_data_queue_signals[SIGNAL_EMPTY], 0);
+
+    if (!gst_data_queue_spsc_wait (queue, FALSE))
+      goto flushing;
+  }
+
+  *item = gst_data_queue_spsc_get_head (queue, remove);
+
+  return TRUE;
+
+  /* ERRORS */
+flushing:
+  {
+    GST_DEBUG ("queue:%p, we are flushing", queue);
+    return FALSE;
+  }
+}
+
 static void
 gst_data_queue_cleanup (GstDataQueue * queue)
 {
   GstDataQueuePrivate *priv = queue->priv;
 
+  if (priv->spsc) {
+    gst_data_queue_spsc_cleanup (queue);
+    return;
+  }
+
   while (!gst_queue_array_is_empty (priv->queue)) {
     GstDataQueueItem *item = gst_queue_array_pop_head (priv->queue);
 
@@ -270,6 +616,13 @@ gst_data_queue_finalize (GObject * object)
   gst_data_queue_cleanup (queue);
   gst_queue_array_free (priv->queue);
 
+  if (priv->spsc) {
+    /* the cleanup consumed all items, only the head block is left */
+    g_slice_free (GstDataQueueBlock, priv->head);
+    if (priv->spare)
+      g_slice_free (GstDataQueueBlock, priv->spare);
+  }
+
   GST_DEBUG ("free mutex");
   g_mutex_clear (&priv->qlock);
   GST_DEBUG ("done free mutex");
@@ -324,6 +677,12 @@ void
 gst_data_queue_flush (GstDataQueue * queue)
 {
   GST_DEBUG ("queue:%p", queue);
+
+  if (queue->priv->spsc) {
+    gst_data_queue_spsc_cleanup (queue);
+    return;
+  }
+
   GST_DATA_QUEUE_MUTEX_LOCK (queue);
   gst_data_queue_locked_flush (queue);
   GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
@@ -345,6 +704,9 @@ gst_data_queue_is_empty (GstDataQueue * queue)
 {
   gboolean res;
 
+  if (queue->priv->spsc)
+    return gst_data_queue_spsc_is_empty (queue);
+
   GST_DATA_QUEUE_MUTEX_LOCK (queue);
   res = gst_data_queue_locked_is_empty (queue);
   GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
@@ -369,6 +731,9 @@ gst_data_queue_is_full (GstDataQueue * queue)
 {
   gboolean res;
 
+  if (queue->priv->spsc)
+    return gst_data_queue_spsc_is_full (queue);
+
   GST_DATA_QUEUE_MUTEX_LOCK (queue);
   res = gst_data_queue_locked_is_full (queue);
   GST_DATA_QUEUE_MUTEX_UNLOCK (queue);
@@ -437,6 +802,9 @@ gst_data_queue_push (GstDataQueue * queue, GstDataQueueItem * item)
   g_return_val_if_fail (GST_IS_DATA_QUEUE (queue), FALSE);
   g_return_val_if_fail (item != NULL, FALSE);
 
+  if (priv->spsc)
+    return gst_data_queue_spsc_push (queue, item);
+
   GST_DATA_QUEUE_MUTEX_LOCK_CHECK (queue, flushing);
 
   STATUS (queue, "before pushing");
@@ -521,6 +889,9 @@ gst_data_queue_pop (GstDataQueue * queue, GstDataQueueItem ** item)
   g_return_val_if_fail (GST_IS_DATA_QUEUE (queue), FALSE);
   g_return_val_if_fail (item != NULL, FALSE);
 
+  if (priv->spsc)
+    return gst_data_queue_spsc_pop (queue, item, TRUE);
+
   GST_DATA_QUEUE_MUTEX_LOCK_CHECK (queue, flushing);
 
   STATUS (queue, "before popping");
@@ -591,6 +962,9 @@ gst_data_queue_peek (GstDataQueue * queue, GstDataQueueItem ** item)
   g_return_val_if_fail (GST_IS_DATA_QUEUE (queue), FALSE);
   g_return_val_if_fail (item != NULL, FALSE);
 
+  if (priv->spsc)
+    return gst_data_queue_spsc_pop (queue, item, FALSE);
+
   GST_DATA_QUEUE_MUTEX_LOCK_CHECK (queue, flushing);
 
   STATUS (queue, "before peeking");
@@ -631,6 +1005,9 @@ flushing:
  *
  * Pop and unref the head-most #GstMiniObject with the given #GType.
  *
+ * This is not supported for queues created with
+ * #GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER.
+ *
  * Returns: TRUE if an element was removed.
  *
  * Since: 1.2.0
@@ -644,6 +1021,7 @@ gst_data_queue_drop_head (GstDataQueue * queue, GType type)
   GstDataQueuePrivate *priv = queue->priv;
 
   g_return_val_if_fail (GST_IS_DATA_QUEUE (queue), FALSE);
+  g_return_val_if_fail (!priv->spsc, FALSE);
 
   GST_DEBUG ("queue:%p", queue);
 
@@ -710,6 +1088,11 @@ gst_data_queue_get_level (GstDataQueue * queue, GstDataQueueSize * level)
 {
   GstDataQueuePrivate *priv = queue->priv;
 
+  if (priv->spsc) {
+    gst_data_queue_spsc_get_level (queue, level);
+    return;
+  }
+
   memcpy (level, (&priv->cur_level), sizeof (GstDataQueueSize));
 }
 
@@ -730,18 +1113,24 @@ gst_data_queue_get_property (GObject * object,
 {
   GstDataQueue *queue = GST_DATA_QUEUE (object);
   GstDataQueuePrivate *priv = queue->priv;
+  GstDataQueueSize level;
 
   GST_DATA_QUEUE_MUTEX_LOCK (queue);
 
+  if (priv->spsc)
+    gst_data_queue_spsc_get_level (queue, &level);
+  else
+    level = priv->cur_level;
+
   switch (prop_id) {
     case PROP_CUR_LEVEL_BYTES:
-      g_value_set_uint (value, priv->cur_level.bytes);
+      g_value_set_uint (value, level.bytes);
       break;
     case PROP_CUR_LEVEL_VISIBLE:
-      g_value_set_uint (value, priv->cur_level.visible);
+      g_value_set_uint (value, level.visible);
       break;
     case PROP_CUR_LEVEL_TIME:
-      g_value_set_uint64 (value, priv->cur_level.time);
+      g_value_set_uint64 (value, level.time);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
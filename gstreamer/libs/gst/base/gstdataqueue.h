@@ -105,6 +105,22 @@ typedef gboolean (*GstDataQueueCheckFullFunction) (GstDataQueue * queue,
 typedef void (*GstDataQueueFullCallback) (GstDataQueue * queue, gpointer checkdata);
 typedef void (*GstDataQueueEmptyCallback) (GstDataQueue * queue, gpointer checkdata);
 
+/**
+ * GstDataQueueFlags:
+ * @GST_DATA_QUEUE_FLAG_NONE: No flag
+ * @GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER: Items are pushed by a single
+ *     producer and popped by a single consumer at any time, which allows the
+ *     queue to pass items without taking a lock.
+ *
+ * Flags to configure a #GstDataQueue.
+ *
+ * Since: 1.2
+ */
+typedef enum {
+  GST_DATA_QUEUE_FLAG_NONE                     = 0,
+  GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER = (1 << 0)
+} GstDataQueueFlags;
+
 /**
  * GstDataQueue:
  * @object: the parent structure
@@ -138,6 +154,12 @@ GstDataQueue * gst_data_queue_new            (GstDataQueueCheckFullFunction chec
 					      GstDataQueueEmptyCallback emptycallback,
 					      gpointer checkdata) G_GNUC_MALLOC;
 
+GstDataQueue * gst_data_queue_new_full       (GstDataQueueCheckFullFunction checkfull,
+					      GstDataQueueFullCallback fullcallback,
+					      GstDataQueueEmptyCallback emptycallback,
+					      gpointer checkdata,
+					      GstDataQueueFlags flags) G_GNUC_MALLOC;
+
 gboolean       gst_data_queue_push           (GstDataQueue * queue, GstDataQueueItem * item);
 
 gboolean       gst_data_queue_pop            (GstDataQueue * queue, GstDataQueueItem ** item);
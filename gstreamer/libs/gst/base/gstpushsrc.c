@@ -42,6 +42,12 @@
  * The subclass should extend the methods from the baseclass in
  * addition to the ::create method.
  *
+ * Subclasses that produce many buffers per wakeup can implement the
+ * #GstBaseSrcClass.create_list() or #GstBaseSrcClass.fill_list() methods of
+ * the parent class, the offset and size arguments should be ignored then.
+ * The default #GstBaseSrcClass.create_list() implementation allocates the
+ * buffers with the ::alloc method of this class.
+ *
  * Seeking, flushing, scheduling and sync is all handled by this
  * base class.
  *
@@ -243,6 +243,7 @@ enum
 #define DEFAULT_LOW_PERCENT   10
 #define DEFAULT_HIGH_PERCENT  99
 #define DEFAULT_SYNC_BY_RUNNING_TIME FALSE
+#define DEFAULT_LOCK_FREE FALSE
 
 enum
 {
@@ -257,6 +258,7 @@ enum
   PROP_LOW_PERCENT,
   PROP_HIGH_PERCENT,
   PROP_SYNC_BY_RUNNING_TIME,
+  PROP_LOCK_FREE,
   PROP_LAST
 };
 
@@ -411,6 +413,21 @@ gst_multi_queue_class_init (GstMultiQueueClass * klass)
           DEFAULT_SYNC_BY_RUNNING_TIME,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMultiQueue:lock-free
+   *
+   * If enabled, the queues of new pads pass data from the upstream
+   * thread to the streaming thread of the source pad without taking a lock,
+   * which reduces the overhead per buffer for high packet rates. This only
+   * affects pads that are requested after the property was changed.
+   *
+   * Since: 1.2
+   */
+  g_object_class_install_property (gobject_class, PROP_LOCK_FREE,
+      g_param_spec_boolean ("lock-free", "Lock Free",
+          "Use lock-free single producer/consumer queues for new pads",
+          DEFAULT_LOCK_FREE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gobject_class->finalize = gst_multi_queue_finalize;
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -448,6 +465,7 @@ gst_multi_queue_init (GstMultiQueue * mqueue)
   mqueue->high_percent = DEFAULT_HIGH_PERCENT;
 
   mqueue->sync_by_running_time = DEFAULT_SYNC_BY_RUNNING_TIME;
+  mqueue->lock_free = DEFAULT_LOCK_FREE;
 
   mqueue->counter = 1;
   mqueue->highid = -1;
@@ -527,6 +545,11 @@ gst_multi_queue_set_property (GObject * object, guint prop_id,
     case PROP_SYNC_BY_RUNNING_TIME:
       mq->sync_by_running_time = g_value_get_boolean (value);
       break;
+    case PROP_LOCK_FREE:
+      GST_MULTI_QUEUE_MUTEX_LOCK (mq);
+      mq->lock_free = g_value_get_boolean (value);
+      GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -572,6 +595,9 @@ gst_multi_queue_get_property (GObject * object, guint prop_id,
     case PROP_SYNC_BY_RUNNING_TIME:
       g_value_set_boolean (value, mq->sync_by_running_time);
       break;
+    case PROP_LOCK_FREE:
+      g_value_set_boolean (value, mq->lock_free);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1473,7 +1499,17 @@ gst_multi_queue_sink_activate_mode (GstPad * pad, GstObject * parent,
         sq->srcresult = GST_FLOW_FLUSHING;
         sq->last_query = FALSE;
         g_cond_signal (&sq->query_handled);
+        g_cond_signal (&sq->turn);
         gst_data_queue_set_flushing (sq->queue, TRUE);
+
+        /* the srcpad task is the only consumer of the queue, it has to be
+         * paused before the queue is drained from this thread. It would
+         * pause itself anyway once it sees the queue flushing. */
+        if (mq)
+          GST_MULTI_QUEUE_MUTEX_UNLOCK (mq);
+        gst_pad_pause_task (sq->srcpad);
+        if (mq)
+          GST_MULTI_QUEUE_MUTEX_LOCK (mq);
         gst_data_queue_flush (sq->queue);
       }
       res = TRUE;
@@ -2061,10 +2097,15 @@ gst_single_queue_new (GstMultiQueue * mqueue, guint id)
   sq->mqueue = mqueue;
   sq->srcresult = GST_FLOW_FLUSHING;
   sq->pushed = FALSE;
-  sq->queue = gst_data_queue_new ((GstDataQueueCheckFullFunction)
+  /* the sinkpad pushes and the srcpad task pops. The queue is only drained
+   * from other threads after the task was paused, see
+   * gst_single_queue_flush() and gst_multi_queue_sink_activate_mode() */
+  sq->queue = gst_data_queue_new_full ((GstDataQueueCheckFullFunction)
       single_queue_check_full,
       (GstDataQueueFullCallback) single_queue_overrun_cb,
-      (GstDataQueueEmptyCallback) single_queue_underrun_cb, sq);
+      (GstDataQueueEmptyCallback) single_queue_underrun_cb, sq,
+      mqueue->lock_free ? GST_DATA_QUEUE_FLAG_SINGLE_PRODUCER_CONSUMER :
+      GST_DATA_QUEUE_FLAG_NONE);
   sq->is_eos = FALSE;
   sq->flushing = FALSE;
   gst_segment_init (&sq->sink_segment, GST_FORMAT_TIME);
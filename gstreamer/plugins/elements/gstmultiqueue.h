@@ -51,6 +51,7 @@ struct _GstMultiQueue {
   GstElement element;
 
   gboolean sync_by_running_time;
+  gboolean lock_free;
 
   /* number of queues */
   guint	nbqueues;
@@ -0,0 +1,189 @@
+/* GStreamer
+ * Copyright (C) 2013 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures the speed of gst_byte_reader_masked_scan_uint32() when searching
+ * for all 00 00 01 start codes, like the video parsers do, and compares the
+ * results with a plain byte-by-byte scan.
+ *
+ * usage: bytereaderscan [size in MB] [bitstream files...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gst/gst.h>
+#include <gst/base/gstbytereader.h>
+
+#define DEFAULT_SIZE_MB 16
+#define N_RUNS 10
+
+/* random data, start codes are rare */
+static guint8 *
+make_random (gsize size)
+{
+  guint8 *data;
+  gsize i;
+
+  data = g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = g_random_int_range (0, 256);
+
+  return data;
+}
+
+/* NAL units of random size with emulation prevention bytes, the payload
+ * is biased towards zero like in real entropy coded data */
+static guint8 *
+make_nal_units (gsize size)
+{
+  guint8 *data;
+  gsize i, end;
+  guint zeros;
+
+  data = g_malloc (size);
+  i = 0;
+  while (i < size) {
+    end = MIN (size, i + 4 + g_random_int_range (16, 32 * 1024));
+
+    if (i + 4 <= end) {
+      data[i++] = 0x00;
+      data[i++] = 0x00;
+      data[i++] = 0x01;
+      data[i++] = g_random_int_range (0, 256);
+    }
+    zeros = 0;
+    while (i < end) {
+      guint8 b;
+
+      b = g_random_int_range (0, 4) == 0 ? 0 : g_random_int_range (0, 256);
+      if (zeros == 2 && b <= 3) {
+        b = 0x03;
+        zeros = 0;
+      } else if (b == 0) {
+        zeros++;
+      } else {
+        zeros = 0;
+      }
+      data[i++] = b;
+    }
+  }
+  return data;
+}
+
+static guint
+count_start_codes (const guint8 * data, gsize size)
+{
+  GstByteReader reader;
+  guint offset, count = 0;
+
+  gst_byte_reader_init (&reader, data, size);
+  offset = 0;
+  while (offset + 4 <= size) {
+    offset = gst_byte_reader_masked_scan_uint32 (&reader, 0xffffff00,
+        0x00000100, offset, size - offset);
+    if (offset == -1)
+      break;
+    count++;
+    offset++;
+  }
+  return count;
+}
+
+static guint
+count_start_codes_bytewise (const guint8 * data, gsize size)
+{
+  guint count = 0;
+  gsize i;
+
+  for (i = 0; i + 4 <= size; i++) {
+    if (data[i] == 0x00 && data[i + 1] == 0x00 && data[i + 2] == 0x01)
+      count++;
+  }
+  return count;
+}
+
+static void
+run_benchmark (const gchar * name, const guint8 * data, gsize size)
+{
+  GstClockTime start, scan_time, ref_time;
+  guint i, count = 0, ref_count = 0;
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < N_RUNS; i++)
+    count = count_start_codes (data, size);
+  scan_time = (gst_util_get_timestamp () - start) / N_RUNS;
+
+  start = gst_util_get_timestamp ();
+  for (i = 0; i < N_RUNS; i++)
+    ref_count = count_start_codes_bytewise (data, size);
+  ref_time = (gst_util_get_timestamp () - start) / N_RUNS;
+
+  g_print ("%-16s %8" G_GSIZE_FORMAT " kB, %6u start codes: "
+      "scan %" GST_TIME_FORMAT " (%.1f MB/s), bytewise %" GST_TIME_FORMAT
+      " (%.1f MB/s)%s\n", name, size / 1024, count,
+      GST_TIME_ARGS (scan_time),
+      (gdouble) size / MAX (scan_time, 1) * GST_SECOND / (1024 * 1024),
+      GST_TIME_ARGS (ref_time),
+      (gdouble) size / MAX (ref_time, 1) * GST_SECOND / (1024 * 1024),
+      count != ref_count ? " MISMATCH" : "");
+
+  if (count != ref_count)
+    exit (-1);
+}
+
+gint
+main (gint argc, gchar * argv[])
+{
+  guint8 *data;
+  gsize size;
+  gint i, size_mb;
+
+  gst_init (&argc, &argv);
+
+  size_mb = DEFAULT_SIZE_MB;
+  if (argc > 1)
+    size_mb = atoi (argv[1]);
+  if (size_mb <= 0) {
+    g_print ("usage: %s [size in MB] [bitstream files...]\n", argv[0]);
+    exit (-1);
+  }
+  size = (gsize) size_mb * 1024 * 1024;
+
+  data = make_random (size);
+  run_benchmark ("random", data, size);
+  g_free (data);
+
+  data = make_nal_units (size);
+  run_benchmark ("nal units", data, size);
+  g_free (data);
+
+  for (i = 2; i < argc; i++) {
+    gchar *contents;
+    GError *err = NULL;
+
+    if (!g_file_get_contents (argv[i], &contents, &size, &err)) {
+      g_print ("could not read %s: %s\n", argv[i], err->message);
+      g_clear_error (&err);
+      continue;
+    }
+    run_benchmark (argv[i], (const guint8 *) contents, size);
+    g_free (contents);
+  }
+
+  return 0;
+}
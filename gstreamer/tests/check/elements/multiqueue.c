@@ -126,6 +126,60 @@ GST_START_TEST (test_simple_pipeline)
 
 GST_END_TEST;
 
+static void
+count_handoff (GstElement * sink, GstBuffer * buf, GstPad * pad,
+    gint * count)
+{
+  g_atomic_int_inc (count);
+}
+
+GST_START_TEST (test_lock_free)
+{
+  GstElement *pipe, *src, *mq, *sink;
+  GstMessage *msg;
+  gboolean lock_free;
+  gint count = 0;
+
+  pipe = gst_pipeline_new ("pipeline");
+
+  src = gst_element_factory_make ("fakesrc", NULL);
+  fail_unless (src != NULL, "failed to create 'fakesrc' element");
+  g_object_set (src, "num-buffers", 5000, "sizetype", 2, "sizemax", 16, NULL);
+
+  mq = gst_element_factory_make ("multiqueue", NULL);
+  fail_unless (mq != NULL, "failed to create 'multiqueue' element");
+  /* a small queue so that both sides have to wait for each other */
+  g_object_set (mq, "lock-free", TRUE, "max-size-buffers", 3,
+      "max-size-bytes", 0, "max-size-time", (guint64) 0, NULL);
+  g_object_get (mq, "lock-free", &lock_free, NULL);
+  fail_unless (lock_free);
+
+  sink = gst_element_factory_make ("fakesink", NULL);
+  fail_unless (sink != NULL, "failed to create 'fakesink' element");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", G_CALLBACK (count_handoff), &count);
+
+  gst_bin_add_many (GST_BIN (pipe), src, mq, sink, NULL);
+  fail_unless (gst_element_link_pads (src, "src", mq, "sink_%u"));
+  fail_unless (gst_element_link_pads (mq, "src_0", sink, "sink"));
+
+  gst_element_set_state (pipe, GST_STATE_PLAYING);
+
+  msg = gst_bus_poll (GST_ELEMENT_BUS (pipe),
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+
+  fail_if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR,
+      "Expected EOS message, got ERROR message");
+  gst_message_unref (msg);
+
+  fail_unless_equals_int (g_atomic_int_get (&count), 5000);
+
+  gst_element_set_state (pipe, GST_STATE_NULL);
+  gst_object_unref (pipe);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_simple_shutdown_while_running)
 {
   GstElement *pipe;
@@ -734,6 +788,7 @@ multiqueue_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_simple_create_destroy);
   tcase_add_test (tc_chain, test_simple_pipeline);
+  tcase_add_test (tc_chain, test_lock_free);
   tcase_add_test (tc_chain, test_simple_shutdown_while_running);
 
   tcase_add_test (tc_chain, test_request_pads);
@@ -27,6 +27,7 @@
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstconsistencychecker.h>
 #include <gst/base/gstbasesrc.h>
+#include <gst/base/gstpushsrc.h>
 
 static GstPadProbeReturn
 eos_event_counter (GstObject * pad, GstPadProbeInfo * info, guint * p_num_eos)
@@ -602,6 +603,201 @@ GST_START_TEST (basesrc_seek_events_rate_update)
 
 GST_END_TEST;
 
+/* like fakesrc, but fills lists of buffers */
+typedef GstPushSrc ListSource;
+typedef GstPushSrcClass ListSourceClass;
+
+GType list_source_get_type (void);
+G_DEFINE_TYPE (ListSource, list_source, GST_TYPE_PUSH_SRC);
+
+/* offset from which fill_list has no more data, or -1 */
+static gint64 list_source_end = -1;
+
+static GstFlowReturn
+list_source_fill_list (GstBaseSrc * src, guint64 offset, guint size,
+    GstBufferList * list)
+{
+  guint i, len;
+
+  len = gst_buffer_list_length (list);
+  fail_unless_equals_int (len, 4);
+
+  /* remove all buffers at the end of the data */
+  if (list_source_end != -1 && offset >= list_source_end) {
+    gst_buffer_list_remove (list, 0, len);
+    return GST_FLOW_OK;
+  }
+
+  for (i = 0; i < len; i++) {
+    GstBuffer *buf = gst_buffer_list_get (list, i);
+
+    fail_unless (gst_buffer_get_size (buf) == size);
+    /* the default create_list allocates consecutive byte ranges */
+    fail_unless_equals_uint64 (GST_BUFFER_OFFSET (buf), offset + i * size);
+    gst_buffer_memset (buf, 0, i, size);
+  }
+  return GST_FLOW_OK;
+}
+
+static gboolean
+list_source_is_seekable (GstBaseSrc * src)
+{
+  return TRUE;
+}
+
+static void
+list_source_class_init (ListSourceClass * klass)
+{
+  static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+      GST_PAD_SRC, GST_PAD_ALWAYS, GST_STATIC_CAPS_ANY);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&srctemplate));
+
+  basesrc_class->fill_list = GST_DEBUG_FUNCPTR (list_source_fill_list);
+  basesrc_class->is_seekable = GST_DEBUG_FUNCPTR (list_source_is_seekable);
+}
+
+static void
+list_source_init (ListSource * src)
+{
+  gst_base_src_set_blocksize (GST_BASE_SRC (src), 16);
+  gst_base_src_set_buffer_list_length (GST_BASE_SRC (src), 4);
+}
+
+static GstPadProbeReturn
+buffer_list_counter (GstObject * pad, GstPadProbeInfo * info, guint * counts)
+{
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+
+    guint i, len = gst_buffer_list_length (list);
+
+    counts[0] += 1;
+    counts[1] += len;
+    for (i = 0; i < len; i++)
+      counts[3] += gst_buffer_get_size (gst_buffer_list_get (list, i));
+    counts[4] = gst_buffer_get_size (gst_buffer_list_get (list, len - 1));
+    /* the discont flag is only set on the first buffer */
+    if (counts[0] == 1) {
+      fail_unless (GST_BUFFER_FLAG_IS_SET (gst_buffer_list_get (list, 0),
+              GST_BUFFER_FLAG_DISCONT));
+    }
+  } else if (info->type & GST_PAD_PROBE_TYPE_BUFFER) {
+    counts[2] += 1;
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+/* basesrc_buffer_lists:
+ *  - make sure a source implementing fill_list pushes buffer lists and
+ *    that num-buffers is applied per buffer in the lists
+ *  - make sure a segment stop in the middle of a list drops the buffers
+ *    after it and clips the buffer that crosses it
+ *  - make sure fill_list removing all buffers results in EOS
+ */
+GST_START_TEST (basesrc_buffer_lists)
+{
+  GstElement *src, *sink, *pipe;
+  GstMessage *msg;
+  GstBus *bus;
+  GstPad *srcpad;
+  GstEvent *seek;
+  guint probe, counts[5] = { 0, 0, 0, 0, 0 };
+
+  pipe = gst_pipeline_new ("pipeline");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  src = g_object_new (list_source_get_type (), NULL);
+
+  g_assert (pipe != NULL);
+  g_assert (sink != NULL);
+  g_assert (src != NULL);
+
+  fail_unless (gst_bin_add (GST_BIN (pipe), src) == TRUE);
+  fail_unless (gst_bin_add (GST_BIN (pipe), sink) == TRUE);
+
+  fail_unless (gst_element_link (src, sink) == TRUE);
+
+  g_object_set (src, "num-buffers", 10, NULL);
+
+  srcpad = gst_element_get_static_pad (src, "src");
+  fail_unless (srcpad != NULL);
+
+  probe = gst_pad_add_probe (srcpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) buffer_list_counter, counts, NULL);
+
+  bus = gst_element_get_bus (pipe);
+
+  gst_element_set_state (pipe, GST_STATE_PLAYING);
+
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless (msg != NULL);
+  fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+
+  /* 4 + 4 + 2 buffers and no single buffers */
+  fail_unless_equals_int (counts[0], 3);
+  fail_unless_equals_int (counts[1], 10);
+  fail_unless_equals_int (counts[2], 0);
+  fail_unless_equals_int (counts[3], 10 * 16);
+  gst_message_unref (msg);
+
+  gst_element_set_state (pipe, GST_STATE_NULL);
+  gst_element_get_state (pipe, NULL, NULL, -1);
+
+  /* stop at byte 100, in the middle of the 3rd buffer of the 2nd list */
+  g_object_set (src, "num-buffers", -1, NULL);
+  memset (counts, 0, sizeof (counts));
+  gst_element_set_state (pipe, GST_STATE_READY);
+  seek = gst_event_new_seek (1.0, GST_FORMAT_BYTES, GST_SEEK_FLAG_FLUSH,
+      GST_SEEK_TYPE_SET, 0, GST_SEEK_TYPE_SET, 100);
+  fail_unless (gst_element_send_event (src, seek));
+  gst_element_set_state (pipe, GST_STATE_PLAYING);
+
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless (msg != NULL);
+  fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+
+  /* 4 + 3 buffers, the last one clipped to 4 bytes */
+  fail_unless_equals_int (counts[0], 2);
+  fail_unless_equals_int (counts[1], 7);
+  fail_unless_equals_int (counts[2], 0);
+  fail_unless_equals_int (counts[3], 100);
+  fail_unless_equals_int (counts[4], 4);
+  gst_message_unref (msg);
+
+  gst_element_set_state (pipe, GST_STATE_NULL);
+  gst_element_get_state (pipe, NULL, NULL, -1);
+
+  /* no more data after the 2nd list */
+  list_source_end = 8 * 16;
+  memset (counts, 0, sizeof (counts));
+  gst_element_set_state (pipe, GST_STATE_PLAYING);
+
+  msg = gst_bus_poll (bus, GST_MESSAGE_EOS | GST_MESSAGE_ERROR, -1);
+  fail_unless (msg != NULL);
+  fail_unless (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+
+  fail_unless_equals_int (counts[0], 2);
+  fail_unless_equals_int (counts[1], 8);
+  fail_unless_equals_int (counts[2], 0);
+  list_source_end = -1;
+
+  gst_element_set_state (pipe, GST_STATE_NULL);
+  gst_element_get_state (pipe, NULL, NULL, -1);
+
+  gst_pad_remove_probe (srcpad, probe);
+  gst_object_unref (srcpad);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+  gst_object_unref (pipe);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 gst_basesrc_suite (void)
@@ -617,6 +813,7 @@ gst_basesrc_suite (void)
   tcase_add_test (tc, basesrc_eos_events_push_live_eos);
   tcase_add_test (tc, basesrc_eos_events_pull_live_eos);
   tcase_add_test (tc, basesrc_seek_events_rate_update);
+  tcase_add_test (tc, basesrc_buffer_lists);
 
   return s;
 }
@@ -235,6 +235,39 @@ GST_START_TEST (test_position_tracking)
 
 GST_END_TEST;
 
+/* reads that are done with a whole word load and reads close to the end of
+ * the data must give the same results */
+GST_START_TEST (test_get_bits_all_positions)
+{
+  guint8 data[24];
+  GstBitReader reader;
+  guint pos, nbits, i;
+
+  for (i = 0; i < sizeof (data); i++)
+    data[i] = g_random_int_range (0, 256);
+
+  for (pos = 0; pos < sizeof (data) * 8; pos++) {
+    for (nbits = 1; nbits <= 64 && pos + nbits <= sizeof (data) * 8; nbits++) {
+      guint64 val = 0, expected = 0;
+
+      gst_bit_reader_init (&reader, data, sizeof (data));
+      fail_unless (gst_bit_reader_set_pos (&reader, pos));
+
+      for (i = 0; i < nbits; i++)
+        expected = (expected << 1) |
+            ((data[(pos + i) / 8] >> (7 - (pos + i) % 8)) & 1);
+
+      fail_unless (gst_bit_reader_peek_bits_uint64 (&reader, &val, nbits));
+      fail_unless_equals_uint64 (val, expected);
+      fail_unless (gst_bit_reader_get_bits_uint64 (&reader, &val, nbits));
+      fail_unless_equals_uint64 (val, expected);
+      fail_unless_equals_int (gst_bit_reader_get_pos (&reader), pos + nbits);
+    }
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 gst_bit_reader_suite (void)
 {
@@ -246,6 +279,7 @@ gst_bit_reader_suite (void)
   tcase_add_test (tc_chain, test_initialization);
   tcase_add_test (tc_chain, test_get_bits);
   tcase_add_test (tc_chain, test_position_tracking);
+  tcase_add_test (tc_chain, test_get_bits_all_positions);
 
   return s;
 }
@@ -557,6 +557,71 @@ GST_START_TEST (test_scan)
 
 GST_END_TEST;
 
+/* straightforward implementation to compare the optimized scanning with */
+static guint
+scan_reference (const guint8 * data, guint size, guint32 mask,
+    guint32 pattern, guint offset, guint scan_size)
+{
+  guint i;
+
+  for (i = offset; i + 4 <= offset + scan_size; i++) {
+    if ((GST_READ_UINT32_BE (data + i) & mask) == pattern)
+      return i;
+  }
+  return -1;
+}
+
+GST_START_TEST (test_scan_random)
+{
+  static const guint32 masks[] = { 0xffffffff, 0xffffff00, 0x00ffffff,
+    0xff00ff00, 0x0000ff00, 0x000000ff, 0xfffffff0, 0x00ff00ff, 0
+  };
+  GstByteReader reader;
+  guint8 data[512];
+  guint32 mask, pattern;
+  guint i, j, size, offset;
+  GRand *rand;
+
+  rand = g_rand_new_with_seed (0x12345678);
+
+  for (i = 0; i < 20000; i++) {
+    size = g_rand_int_range (rand, 4, sizeof (data));
+
+    /* mostly zeroes to get many (partial) start codes */
+    for (j = 0; j < size; j++) {
+      if (i % 2)
+        data[j] = g_rand_int_range (rand, 0, 256);
+      else
+        data[j] = g_rand_int_range (rand, 0, 8) == 0 ?
+            g_rand_int_range (rand, 0, 4) : 0;
+    }
+
+    mask = masks[g_rand_int_range (rand, 0, G_N_ELEMENTS (masks))];
+    switch (i % 3) {
+      case 0:
+        pattern = 0x00000100 & mask;
+        break;
+      case 1:
+        pattern = GST_READ_UINT32_BE (data + g_rand_int_range (rand, 0,
+                size - 3)) & mask;
+        break;
+      default:
+        pattern = g_rand_int (rand) & mask;
+        break;
+    }
+    offset = g_rand_int_range (rand, 0, size);
+
+    gst_byte_reader_init (&reader, data, size);
+    fail_unless_equals_int (gst_byte_reader_masked_scan_uint32 (&reader, mask,
+            pattern, offset, size - offset),
+        scan_reference (data, size, mask, pattern, offset, size - offset));
+  }
+
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_string_funcs)
 {
   GstByteReader reader, backup;
@@ -703,6 +768,7 @@ gst_byte_reader_suite (void)
   tcase_add_test (tc_chain, test_get_float_be);
   tcase_add_test (tc_chain, test_position_tracking);
   tcase_add_test (tc_chain, test_scan);
+  tcase_add_test (tc_chain, test_scan_random);
   tcase_add_test (tc_chain, test_string_funcs);
   tcase_add_test (tc_chain, test_dup_string);
 